@@ -15,6 +15,7 @@ HDF5_SETUP_FILTERS (SHUFFLE)
 HDF5_SETUP_FILTERS (FLETCHER32)
 HDF5_SETUP_FILTERS (NBIT)
 HDF5_SETUP_FILTERS (SCALEOFFSET)
+HDF5_SETUP_FILTERS (LZ4)
 
 include (ExternalProject)
 #option (HDF5_ALLOW_EXTERNAL_SUPPORT "Allow External Library Building (NO SVN TGZ)" "NO")
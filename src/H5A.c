@@ -559,6 +559,98 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* H5Aopen_by_idx() */
 
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5Aopen_all
+ PURPOSE
+    Opens all the attributes of an object at once
+ USAGE
+    ssize_t H5Aopen_all(loc_id, idx_type, order, max_attrs, attr_ids, aapl_id)
+        hid_t loc_id;           IN: Object that attributes are attached to
+        H5_index_t idx_type;    IN: Type of index to use
+        H5_iter_order_t order;  IN: Order to open attributes in
+        size_t max_attrs;       IN: Number of IDs that ATTR_IDS can hold
+        hid_t attr_ids[];       OUT: Array for the IDs of the attributes
+        hid_t aapl_id;          IN: Attribute access property list
+ RETURNS
+    Number of attributes opened on success, negative on failure
+
+ DESCRIPTION
+        This function opens up to MAX_ATTRS attributes of an object, in the
+    order given by IDX_TYPE and ORDER, and stores their IDs in ATTR_IDS.  The
+    attribute messages (and their data) are read in a single pass over the
+    object's attribute storage, which is faster than opening each attribute
+    separately.  The attribute IDs returned must be released with H5Aclose
+    or resource leaks will develop.
+--------------------------------------------------------------------------*/
+ssize_t
+H5Aopen_all(hid_t loc_id, H5_index_t idx_type, H5_iter_order_t order,
+    size_t max_attrs, hid_t attr_ids[], hid_t UNUSED aapl_id)
+{
+    H5G_loc_t	loc;	        /* Object location */
+    H5A_t       **attrs = NULL; /* Attributes opened */
+    ssize_t     nattrs = 0;     /* Number of attributes opened */
+    size_t      nreg = 0;       /* Number of attributes registered */
+    size_t      u;              /* Local index variable */
+    ssize_t	ret_value;      /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE6("Zs", "iIiIoz*ii", loc_id, idx_type, order, max_attrs, attr_ids,
+             aapl_id);
+
+    /* check arguments */
+    if(H5I_ATTR == H5I_get_type(loc_id))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "location is not valid for an attribute")
+    if(H5G_loc(loc_id, &loc) < 0)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a location")
+    if(idx_type <= H5_INDEX_UNKNOWN || idx_type >= H5_INDEX_N)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid index type specified")
+    if(order <= H5_ITER_UNKNOWN || order >= H5_ITER_N)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid iteration order specified")
+    if(max_attrs > 0 && !attr_ids)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no attribute ID array")
+
+    if(max_attrs > 0) {
+        /* Allocate space for the attributes */
+        if(NULL == (attrs = (H5A_t **)H5MM_calloc(max_attrs * sizeof(H5A_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+
+        /* Read in the attributes from the object header */
+        if((nattrs = H5O_attr_open_all(loc.oloc, idx_type, order, max_attrs, attrs, H5AC_ind_dxpl_id)) < 0)
+            HGOTO_ERROR(H5E_ATTR, H5E_CANTINIT, FAIL, "unable to load attributes from object header")
+
+        for(u = 0; u < (size_t)nattrs; u++) {
+            /* Finish initializing attribute */
+            if(H5A_open_common(&loc, attrs[u]) < 0)
+                HGOTO_ERROR(H5E_ATTR, H5E_CANTINIT, FAIL, "unable to initialize attribute")
+
+            /* Register the attribute and get an ID for it */
+            if((attr_ids[u] = H5I_register(H5I_ATTR, attrs[u], TRUE)) < 0)
+                HGOTO_ERROR(H5E_ATOM, H5E_CANTREGISTER, FAIL, "unable to register attribute for ID")
+            attrs[u] = NULL;
+            nreg++;
+        } /* end for */
+    } /* end if */
+
+    /* Set return value */
+    ret_value = nattrs;
+
+done:
+    /* Cleanup on failure */
+    if(ret_value < 0) {
+        for(u = 0; u < nreg; u++)
+            if(H5I_dec_app_ref(attr_ids[u]) < 0)
+                HDONE_ERROR(H5E_ATTR, H5E_CANTFREE, FAIL, "can't close attribute")
+        for(u = nreg; nattrs > 0 && u < (size_t)nattrs; u++)
+            if(H5A_close(attrs[u]) < 0)
+                HDONE_ERROR(H5E_ATTR, H5E_CANTFREE, FAIL, "can't close attribute")
+    } /* end if */
+    H5MM_xfree(attrs);
+
+    FUNC_LEAVE_API(ret_value)
+} /* H5Aopen_all() */
+
 
 /*--------------------------------------------------------------------------
  NAME
@@ -50,6 +50,12 @@
 #include "H5MMprivate.h"        /* Memory management                    */
 #include "H5Pprivate.h"         /* Property lists                       */
 
+/* Background flush passes are run by a background thread when the library
+ * can share its global lock with one */
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5_HAVE_WIN_THREADS)
+#define H5AC_BG_FLUSH_THREAD
+#endif /* H5_HAVE_THREADSAFE && !H5_HAVE_WIN_THREADS */
+
 
 #ifdef H5_HAVE_PARALLEL
 
@@ -96,6 +102,43 @@ H5FL_DEFINE_STATIC(H5AC_slist_entry_t);
 
 #endif /* H5_HAVE_PARALLEL */
 
+/****************************************************************************
+ *
+ * structure H5AC_bg_flush_t
+ *
+ * Files whose cache has a background flush pass due are queued for the
+ * background thread in a list of these structures.  A shared file is queued
+ * at most once at a time, and is removed from the queue when any of its
+ * file handles is closed.
+ *
+ * f:		The file whose cache is to be flushed.
+ *
+ * next:	The next file in the queue.
+ *
+ ****************************************************************************/
+
+#ifdef H5AC_BG_FLUSH_THREAD
+
+typedef struct H5AC_bg_flush_t
+{
+    H5F_t *                     f;
+    struct H5AC_bg_flush_t *    next;
+} H5AC_bg_flush_t;
+
+/* Declare a free list to manage the H5AC_bg_flush_t struct */
+H5FL_DEFINE_STATIC(H5AC_bg_flush_t);
+
+/* The queue, shared with the background thread.  The queue lock is
+ * always taken after the library's global lock, never before it. */
+static pthread_mutex_t H5AC_bg_flush_lock_g = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t H5AC_bg_flush_cond_g = PTHREAD_COND_INITIALIZER;
+static H5AC_bg_flush_t *H5AC_bg_flush_head_g = NULL;
+static H5AC_bg_flush_t *H5AC_bg_flush_tail_g = NULL;
+static hbool_t H5AC_bg_flush_worker_g = FALSE;   /* Whether the thread is running */
+static hbool_t H5AC_bg_flush_shutdown_g = FALSE; /* Whether the thread should exit */
+
+#endif /* H5AC_BG_FLUSH_THREAD */
+
 
 /*
  * Private file-scope variables.
@@ -106,6 +149,11 @@ H5FL_DEFINE_STATIC(H5AC_slist_entry_t);
 /* (Global variable definition, declaration is in H5ACprivate.h also) */
 hid_t H5AC_dxpl_id=(-1);
 
+/* Dataset transfer property list for metadata I/O in collective opens */
+/* (Same as H5AC_dxpl_id, plus "collective metadata read" set) */
+/* (Global variable definition, declaration is in H5ACprivate.h also) */
+hid_t H5AC_coll_read_dxpl_id=(-1);
+
 /* Private dataset transfer property list for metadata I/O calls */
 /* (Collective set and "library internal" set) */
 /* (Static variable definition) */
@@ -129,6 +177,12 @@ static herr_t H5AC_check_if_write_permitted(const H5F_t *f,
 static herr_t H5AC_ext_config_2_int_config(H5AC_cache_config_t * ext_conf_ptr,
                                            H5C_auto_size_ctl_t * int_conf_ptr);
 
+static herr_t H5AC_bg_flush_request(H5F_t *f);
+
+#ifdef H5AC_BG_FLUSH_THREAD
+static void * H5AC_bg_flush_worker(void * arg);
+#endif /* H5AC_BG_FLUSH_THREAD */
+
 #ifdef H5_HAVE_PARALLEL
 static herr_t H5AC_broadcast_candidate_list(H5AC_t * cache_ptr,
                                             int * num_entries_ptr,
@@ -136,6 +190,10 @@ static herr_t H5AC_broadcast_candidate_list(H5AC_t * cache_ptr,
 
 static herr_t H5AC_broadcast_clean_list(H5AC_t * cache_ptr);
 
+static herr_t H5AC_check_coll_read(const H5F_t * f,
+                                   haddr_t addr,
+                                   hbool_t * all_miss_ptr);
+
 static herr_t H5AC_construct_candidate_list(H5AC_t * cache_ptr,
                                             H5AC_aux_t * aux_ptr,
                                             int sync_point_op);
@@ -259,6 +317,7 @@ H5AC_init_interface(void)
     H5P_genplist_t  *xfer_plist;    /* Dataset transfer property list object */
     unsigned block_before_meta_write; /* "block before meta write" property value */
     unsigned coll_meta_write;       /* "collective metadata write" property value */
+    unsigned coll_meta_read;        /* "collective metadata read" property value */
     unsigned library_internal = 1;  /* "library internal" property value */
 #endif /* H5_HAVE_PARALLEL */
     herr_t ret_value = SUCCEED;     /* Return value */
@@ -295,6 +354,21 @@ H5AC_init_interface(void)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't insert metadata cache dxpl property")
 
 
+    /* Get an ID for the blocking, collective H5AC dxpl used for opens */
+    if((H5AC_coll_read_dxpl_id = H5P_copy_plist(xfer_plist, FALSE)) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTCOPY, FAIL, "unable to copy property list")
+
+    /* Get the property list object */
+    if(NULL == (xfer_plist = (H5P_genplist_t *)H5I_object(H5AC_coll_read_dxpl_id)))
+        HGOTO_ERROR(H5E_CACHE, H5E_BADATOM, FAIL, "can't get new property list object")
+
+    /* Insert 'collective metadata read' property */
+    coll_meta_read = 1;
+    if(H5P_insert(xfer_plist, H5AC_COLLECTIVE_META_READ_NAME, H5AC_COLLECTIVE_META_READ_SIZE, &coll_meta_read,
+                  NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't insert metadata cache dxpl property")
+
+
     /* Get an ID for the non-blocking, collective H5AC dxpl */
     if((H5AC_noblock_dxpl_id = H5P_create_id(H5P_CLS_DATASET_XFER_g, FALSE)) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_CANTCREATE, FAIL, "unable to register property list")
@@ -351,6 +425,7 @@ H5AC_init_interface(void)
     HDassert(H5P_LST_DATASET_XFER_ID_g!=(-1));
 
     H5AC_dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    H5AC_coll_read_dxpl_id = H5P_DATASET_XFER_DEFAULT;
     H5AC_noblock_dxpl_id = H5P_DATASET_XFER_DEFAULT;
     H5AC_ind_dxpl_id = H5P_DATASET_XFER_DEFAULT;
 
@@ -387,19 +462,30 @@ H5AC_term_interface(void)
     FUNC_ENTER_NOAPI_NOINIT_NOERR
 
     if (H5_interface_initialize_g) {
+#ifdef H5AC_BG_FLUSH_THREAD
+        /* Tell the background thread, if there is one, to exit.  All
+         * files are closed by now, so the queue is empty. */
+        pthread_mutex_lock(&H5AC_bg_flush_lock_g);
+        H5AC_bg_flush_shutdown_g = TRUE;
+        pthread_cond_broadcast(&H5AC_bg_flush_cond_g);
+        pthread_mutex_unlock(&H5AC_bg_flush_lock_g);
+#endif /* H5AC_BG_FLUSH_THREAD */
+
 #ifdef H5_HAVE_PARALLEL
-        if(H5AC_dxpl_id > 0 || H5AC_noblock_dxpl_id > 0 || H5AC_ind_dxpl_id > 0) {
+        if(H5AC_dxpl_id > 0 || H5AC_coll_read_dxpl_id > 0 || H5AC_noblock_dxpl_id > 0 || H5AC_ind_dxpl_id > 0) {
             /* Indicate more work to do */
             n = 1; /* H5I */
 
             /* Close H5AC dxpl */
             if(H5I_dec_ref(H5AC_dxpl_id) < 0 ||
+                    H5I_dec_ref(H5AC_coll_read_dxpl_id) < 0 ||
                     H5I_dec_ref(H5AC_noblock_dxpl_id) < 0 ||
                     H5I_dec_ref(H5AC_ind_dxpl_id) < 0)
                 H5E_clear_stack(NULL); /*ignore error*/
             else {
                 /* Reset static IDs */
                 H5AC_dxpl_id = (-1);
+                H5AC_coll_read_dxpl_id = (-1);
                 H5AC_noblock_dxpl_id = (-1);
                 H5AC_ind_dxpl_id = (-1);
 
@@ -411,6 +497,7 @@ H5AC_term_interface(void)
 #else /* H5_HAVE_PARALLEL */
             /* Reset static IDs */
             H5AC_dxpl_id=(-1);
+            H5AC_coll_read_dxpl_id=(-1);
             H5AC_noblock_dxpl_id=(-1);
             H5AC_ind_dxpl_id=(-1);
 #endif /* H5_HAVE_PARALLEL */
@@ -1019,6 +1106,10 @@ H5AC_insert_entry(H5F_t *f, hid_t dxpl_id, const H5AC_class_t *type, haddr_t add
 }
 #endif /* H5_HAVE_PARALLEL */
 
+    /* Write dirty entries ahead of need, if a pass is due */
+    if(H5AC_bg_flush_request(f) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't request background flush")
+
 done:
 #if H5AC__TRACE_FILE_ENABLED
     if(trace_file_ptr != NULL) {
@@ -1315,6 +1406,9 @@ H5AC_protect(H5F_t *f,
 {
     unsigned		protect_flags = H5C__NO_FLAGS_SET;
     void *		thing = (void *)NULL;
+#ifdef H5_HAVE_PARALLEL
+    hbool_t		coll_md_read_off = FALSE;
+#endif /* H5_HAVE_PARALLEL */
 #if H5AC__TRACE_FILE_ENABLED
     char                trace[128] = "";
     size_t		trace_entry_size = 0;
@@ -1376,6 +1470,30 @@ H5AC_protect(H5F_t *f,
 	protect_flags |= H5C__READ_ONLY_FLAG;
     }
 
+#ifdef H5_HAVE_PARALLEL
+    /* Only read the entry on process 0 and broadcast it if every
+     * process is going to load it.  Otherwise, turn collective reads
+     * off for the file while the entry is protected, so that the
+     * processes which miss read it themselves.
+     */
+    if ( ( dxpl_id == H5AC_coll_read_dxpl_id ) &&
+         ( f->shared->coll_md_read ) ) {
+
+        hbool_t all_miss = FALSE;
+
+        if ( H5AC_check_coll_read(f, addr, &all_miss) < 0 )
+
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTPROTECT, NULL, \
+                        "can't check for collective metadata read")
+
+        if ( ! all_miss ) {
+
+            f->shared->coll_md_read = FALSE;
+            coll_md_read_off = TRUE;
+        }
+    }
+#endif /* H5_HAVE_PARALLEL */
+
     thing = H5C_protect(f,
 		        dxpl_id,
                         H5AC_noblock_dxpl_id,
@@ -1402,6 +1520,13 @@ H5AC_protect(H5F_t *f,
 
 done:
 
+#ifdef H5_HAVE_PARALLEL
+    if ( coll_md_read_off ) {
+
+        f->shared->coll_md_read = TRUE;
+    }
+#endif /* H5_HAVE_PARALLEL */
+
 #if H5AC__TRACE_FILE_ENABLED
     if ( trace_file_ptr != NULL ) {
 
@@ -1707,6 +1832,11 @@ H5AC_unprotect(H5F_t *f, hid_t dxpl_id, const H5AC_class_t *type, haddr_t addr,
     } /* end if */
 #endif /* H5_HAVE_PARALLEL */
 
+    /* Write dirty entries ahead of need, if a pass is due */
+    if(dirtied && !deleted)
+        if(H5AC_bg_flush_request(f) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't request background flush")
+
 done:
 #if H5AC__TRACE_FILE_ENABLED
     if(trace_file_ptr != NULL)
@@ -1915,6 +2045,9 @@ H5AC_get_cache_auto_resize_config(const H5AC_t * cache_ptr,
     if(H5C_get_evictions_enabled((const H5C_t *)cache_ptr, &evictions_enabled) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_get_resize_enabled() failed.")
 
+    if(H5C_get_rp_policy((const H5C_t *)cache_ptr, &(config_ptr->replacement_policy)) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_get_rp_policy() failed.")
+
     if ( internal_config.rpt_fcn == NULL ) {
 
         config_ptr->rpt_fcn_enabled = FALSE;
@@ -2083,6 +2216,83 @@ done:
 
 } /* H5AC_reset_cache_hit_rate_stats() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_set_bg_flush_threshold
+ *
+ * Purpose:     Set the fraction of the cache which may be dirty before
+ *		dirty entries are written ahead of need.  A threshold of
+ *		zero disables background flushing.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5AC_set_bg_flush_threshold(H5AC_t *cache_ptr, double threshold)
+{
+    herr_t ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if(H5C_set_bg_flush_threshold((H5C_t *)cache_ptr, threshold) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTSET, FAIL, "can't set background flush threshold")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_set_bg_flush_threshold() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_bg_flush_cancel
+ *
+ * Purpose:     Removes a file which is being closed from the background
+ *		flush queue, so that the background thread doesn't touch
+ *		it afterwards.  A shared file is queued once, through
+ *		whichever of its handles asked first, so its request is
+ *		dropped when any of its handles is closed.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5AC_bg_flush_cancel(const H5F_t *f)
+{
+#ifdef H5AC_BG_FLUSH_THREAD
+    H5AC_bg_flush_t *item;              /* Current queue item */
+    H5AC_bg_flush_t *prev = NULL;       /* Previous queue item kept */
+#endif /* H5AC_BG_FLUSH_THREAD */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+
+#ifdef H5AC_BG_FLUSH_THREAD
+    pthread_mutex_lock(&H5AC_bg_flush_lock_g);
+    item = H5AC_bg_flush_head_g;
+    while(item) {
+        H5AC_bg_flush_t *next = item->next;
+
+        if(item->f->shared == f->shared) {
+            if(prev)
+                prev->next = next;
+            else
+                H5AC_bg_flush_head_g = next;
+            if(H5AC_bg_flush_tail_g == item)
+                H5AC_bg_flush_tail_g = prev;
+            item = H5FL_FREE(H5AC_bg_flush_t, item);
+        } /* end if */
+        else
+            prev = item;
+        item = next;
+    } /* end while */
+    pthread_mutex_unlock(&H5AC_bg_flush_lock_g);
+#endif /* H5AC_BG_FLUSH_THREAD */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5AC_bg_flush_cancel() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5AC_set_cache_auto_resize_config
@@ -2193,6 +2403,9 @@ H5AC_set_cache_auto_resize_config(H5AC_t *cache_ptr,
     if(H5C_set_evictions_enabled(cache_ptr, config_ptr->evictions_enabled) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_set_evictions_enabled() failed.")
 
+    if(H5C_set_rp_policy(cache_ptr, config_ptr->replacement_policy) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_set_rp_policy() failed.")
+
 #ifdef H5_HAVE_PARALLEL
     if ( cache_ptr->aux_ptr != NULL ) {
 
@@ -2216,7 +2429,7 @@ done:
          ( trace_file_ptr != NULL ) ) {
 
 	HDfprintf(trace_file_ptr,
-                  "%s %d %d %d %d \"%s\" %d %d %d %f %d %d %ld %d %f %f %d %f %f %d %d %d %f %f %d %d %d %d %f %d %d %d\n",
+                  "%s %d %d %d %d \"%s\" %d %d %d %f %d %d %ld %d %f %f %d %f %f %d %d %d %f %f %d %d %d %d %f %d %d %d %d\n",
 		  "H5AC_set_cache_auto_resize_config",
 		  trace_config.version,
 		  (int)(trace_config.rpt_fcn_enabled),
@@ -2248,6 +2461,7 @@ done:
 		  trace_config.empty_reserve,
 		  trace_config.dirty_bytes_threshold,
 		  trace_config.metadata_write_strategy,
+		  (int)(trace_config.replacement_policy),
 		  (int)ret_value);
     }
 #endif /* H5AC__TRACE_FILE_ENABLED */
@@ -2256,6 +2470,83 @@ done:
 
 } /* H5AC_set_cache_auto_resize_config() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_config_to_current()
+ *
+ * Purpose:     Copy an instance of H5AC_cache_config_t supplied by the
+ *		application, of any known version, into an instance of
+ *		the current version.  Version 1 instances have no
+ *		replacement_policy field, so their policy is LRU.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5AC_config_to_current(const H5AC_cache_config_t * ext_config_ptr,
+                       H5AC_cache_config_t * config_ptr)
+{
+    herr_t              ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(ext_config_ptr);
+    HDassert(config_ptr);
+
+    if(ext_config_ptr->version == H5AC__CURR_CACHE_CONFIG_VERSION)
+        HDmemcpy(config_ptr, ext_config_ptr, sizeof(H5AC_cache_config_t));
+    else if(ext_config_ptr->version == H5AC__CACHE_CONFIG_VERSION_1) {
+        HDmemcpy(config_ptr, ext_config_ptr, H5AC__CACHE_CONFIG_VERSION_1_SIZE);
+        config_ptr->version = H5AC__CURR_CACHE_CONFIG_VERSION;
+        config_ptr->replacement_policy = H5C_rp__lru;
+    } /* end if */
+    else
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Unknown config version.")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_config_to_current() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_config_from_current()
+ *
+ * Purpose:     Copy an instance of the current version of
+ *		H5AC_cache_config_t into one supplied by the application,
+ *		translating it to the version given by
+ *		ext_config_ptr->version.  Fields which the application's
+ *		version doesn't have are not written.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5AC_config_from_current(const H5AC_cache_config_t * config_ptr,
+                         H5AC_cache_config_t * ext_config_ptr)
+{
+    herr_t              ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(config_ptr);
+    HDassert(config_ptr->version == H5AC__CURR_CACHE_CONFIG_VERSION);
+    HDassert(ext_config_ptr);
+
+    if(ext_config_ptr->version == H5AC__CURR_CACHE_CONFIG_VERSION)
+        HDmemcpy(ext_config_ptr, config_ptr, sizeof(H5AC_cache_config_t));
+    else if(ext_config_ptr->version == H5AC__CACHE_CONFIG_VERSION_1) {
+        HDmemcpy(ext_config_ptr, config_ptr, H5AC__CACHE_CONFIG_VERSION_1_SIZE);
+        ext_config_ptr->version = H5AC__CACHE_CONFIG_VERSION_1;
+    } /* end if */
+    else
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Unknown config version.")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_config_from_current() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5AC_validate_config()
@@ -2345,6 +2636,10 @@ H5AC_validate_config(H5AC_cache_config_t * config_ptr)
          (config_ptr->metadata_write_strategy != H5AC_METADATA_WRITE_STRATEGY__DISTRIBUTED))
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "config_ptr->metadata_write_strategy out of range.")
 
+    if((config_ptr->replacement_policy != H5C_rp__lru) &&
+         (config_ptr->replacement_policy != H5C_rp__2q))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "config_ptr->replacement_policy out of range.")
+
     if(H5AC_ext_config_2_int_config(config_ptr, &internal_config) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5AC_ext_config_2_int_config() failed.")
 
@@ -3029,6 +3324,228 @@ done:
 } /* H5AC_broadcast_clean_list() */
 #endif /* H5_HAVE_PARALLEL */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_check_coll_read
+ *
+ * Purpose:     Decides, together with the other processes, whether an
+ *		entry protected during a collective open is read by
+ *		process 0 and broadcast to the others.
+ *
+ *		The processes' caches may hold different clean entries,
+ *		so the entry may be a miss on some processes and a hit
+ *		on others.  Only when it is a miss everywhere does every
+ *		process load it, and so post the matching broadcasts.
+ *		*all_miss_ptr is set to TRUE in that case only.
+ *
+ *		Must be called by every process in the file's
+ *		communicator.  This holds for the protects made by a
+ *		collective open, since every process traverses the same
+ *		metadata in the same order.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifdef H5_HAVE_PARALLEL
+static herr_t
+H5AC_check_coll_read(const H5F_t * f,
+                     haddr_t addr,
+                     hbool_t * all_miss_ptr)
+{
+    hbool_t		in_cache = FALSE;
+    int			hit;
+    int			nhits;
+    MPI_Comm		mpi_comm;
+    int			mpi_code;
+    herr_t		ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert( f != NULL );
+    HDassert( f->shared != NULL );
+    HDassert( all_miss_ptr != NULL );
+
+    *all_miss_ptr = FALSE;
+
+    if ( ! H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI) ) {
+
+        HGOTO_DONE(SUCCEED)
+    }
+
+    if ( H5C_get_entry_status(f, addr, NULL, &in_cache, NULL, NULL,
+                              NULL, NULL, NULL) < 0 ) {
+
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTGET, FAIL, \
+                    "can't get entry status")
+    }
+
+    if ( MPI_COMM_NULL == (mpi_comm = H5F_mpi_get_comm(f)) ) {
+
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTGET, FAIL, \
+                    "can't get MPI communicator")
+    }
+
+    hit = in_cache ? 1 : 0;
+
+    if ( MPI_SUCCESS !=
+         (mpi_code = MPI_Allreduce(&hit, &nhits, 1, MPI_INT, MPI_SUM,
+                                   mpi_comm)) ) {
+
+        HMPI_GOTO_ERROR(FAIL, "MPI_Allreduce failed", mpi_code)
+    }
+
+    *all_miss_ptr = ( nhits == 0 );
+
+done:
+
+    FUNC_LEAVE_NOAPI(ret_value)
+
+} /* H5AC_check_coll_read() */
+#endif /* H5_HAVE_PARALLEL */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_bg_flush_request
+ *
+ * Purpose:     Arranges for dirty entries to be written ahead of need
+ *		when more of the cache is dirty than the file's background
+ *		flush threshold allows.
+ *
+ *		In a thread-safe library built with pthreads, the file is
+ *		queued for a background thread, which runs the pass when
+ *		it next gets the library's global lock.  Otherwise, the
+ *		pass is run before returning.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5AC_bg_flush_request(H5F_t *f)
+{
+#ifdef H5AC_BG_FLUSH_THREAD
+    H5AC_bg_flush_t *item;              /* Current queue item */
+    H5AC_bg_flush_t *new_item = NULL;   /* New queue item */
+#endif /* H5AC_BG_FLUSH_THREAD */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(f->shared->cache);
+
+    if(!H5C_bg_flush_needed(f->shared->cache))
+        HGOTO_DONE(SUCCEED)
+
+#ifdef H5AC_BG_FLUSH_THREAD
+    if(NULL == (new_item = H5FL_MALLOC(H5AC_bg_flush_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for background flush request")
+    new_item->f = f;
+    new_item->next = NULL;
+
+    /* Queue the file unless its cache is already queued, starting the
+     * background thread if necessary */
+    pthread_mutex_lock(&H5AC_bg_flush_lock_g);
+    for(item = H5AC_bg_flush_head_g; item; item = item->next)
+        if(item->f->shared == f->shared)
+            break;
+    if(NULL == item) {
+        H5AC_bg_flush_shutdown_g = FALSE;
+        if(!H5AC_bg_flush_worker_g) {
+            pthread_t worker;
+
+            if(pthread_create(&worker, NULL, H5AC_bg_flush_worker, NULL)) {
+                pthread_mutex_unlock(&H5AC_bg_flush_lock_g);
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTCREATE, FAIL, "can't create background flush thread")
+            } /* end if */
+            pthread_detach(worker);
+            H5AC_bg_flush_worker_g = TRUE;
+        } /* end if */
+        if(H5AC_bg_flush_tail_g)
+            H5AC_bg_flush_tail_g->next = new_item;
+        else
+            H5AC_bg_flush_head_g = new_item;
+        H5AC_bg_flush_tail_g = new_item;
+        new_item = NULL;
+        pthread_cond_broadcast(&H5AC_bg_flush_cond_g);
+    } /* end if */
+    pthread_mutex_unlock(&H5AC_bg_flush_lock_g);
+#else /* H5AC_BG_FLUSH_THREAD */
+    if(H5C_bg_flush(f, H5AC_dxpl_id, H5AC_noblock_dxpl_id) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't write dirty entries ahead of need")
+#endif /* H5AC_BG_FLUSH_THREAD */
+
+done:
+#ifdef H5AC_BG_FLUSH_THREAD
+    if(new_item)
+        new_item = H5FL_FREE(H5AC_bg_flush_t, new_item);
+#endif /* H5AC_BG_FLUSH_THREAD */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_bg_flush_request() */
+
+#ifdef H5AC_BG_FLUSH_THREAD
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_bg_flush_worker
+ *
+ * Purpose:     Main routine of the background flush thread.  Runs a
+ *		background flush pass for each queued file, with the
+ *		library's global lock held.  Exits when the library shuts
+ *		down.
+ *
+ *		Nobody waits for a pass, so errors are dropped: entries
+ *		which couldn't be written stay dirty, and are written
+ *		when the cache is next flushed or evicts them.
+ *
+ * Return:      NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5AC_bg_flush_worker(void UNUSED * arg)
+{
+    for(;;) {
+        H5AC_bg_flush_t *item;          /* File to flush */
+
+        /* Wait for work */
+        pthread_mutex_lock(&H5AC_bg_flush_lock_g);
+        while(NULL == H5AC_bg_flush_head_g) {
+            if(H5AC_bg_flush_shutdown_g) {
+                H5AC_bg_flush_worker_g = FALSE;
+                pthread_mutex_unlock(&H5AC_bg_flush_lock_g);
+                return NULL;
+            } /* end if */
+            pthread_cond_wait(&H5AC_bg_flush_cond_g, &H5AC_bg_flush_lock_g);
+        } /* end while */
+        pthread_mutex_unlock(&H5AC_bg_flush_lock_g);
+
+        /* Take the global lock first, then the next file, which may
+         * have been closed in the meantime */
+        H5TS_mutex_lock(&H5_g.init_lock);
+        pthread_mutex_lock(&H5AC_bg_flush_lock_g);
+        if(NULL != (item = H5AC_bg_flush_head_g)) {
+            H5AC_bg_flush_head_g = item->next;
+            if(NULL == H5AC_bg_flush_head_g)
+                H5AC_bg_flush_tail_g = NULL;
+        } /* end if */
+        pthread_mutex_unlock(&H5AC_bg_flush_lock_g);
+
+        if(item) {
+            H5E_clear_stack(NULL);
+            (void)H5C_bg_flush(item->f, H5AC_dxpl_id, H5AC_noblock_dxpl_id);
+            H5E_clear_stack(NULL);
+            item = H5FL_FREE(H5AC_bg_flush_t, item);
+        } /* end if */
+        H5TS_mutex_unlock(&H5_g.init_lock);
+    } /* end for */
+} /* H5AC_bg_flush_worker() */
+#endif /* H5AC_BG_FLUSH_THREAD */
+
 
 /*-------------------------------------------------------------------------
  *
@@ -205,6 +205,11 @@ typedef H5C_t	H5AC_t;
 #define H5AC_COLLECTIVE_META_WRITE_SIZE         sizeof(unsigned)
 #define H5AC_COLLECTIVE_META_WRITE_DEF          0
 
+/* Definitions for "collective metadata read" property */
+#define H5AC_COLLECTIVE_META_READ_NAME          "H5AC_collective_metadata_read"
+#define H5AC_COLLECTIVE_META_READ_SIZE          sizeof(unsigned)
+#define H5AC_COLLECTIVE_META_READ_DEF           0
+
 /* Definitions for "library internal" property */
 #define H5AC_LIBRARY_INTERNAL_NAME       "H5AC_library_internal"
 #define H5AC_LIBRARY_INTERNAL_SIZE       sizeof(unsigned)
@@ -220,6 +225,11 @@ typedef H5C_t	H5AC_t;
 /* (Global variable declaration, definition is in H5AC.c) */
 extern hid_t H5AC_dxpl_id;
 
+/* Dataset transfer property list for collective object open calls */
+/* (Same as H5AC_dxpl_id, plus "collective metadata read" set) */
+/* (Global variable declaration, definition is in H5AC.c) */
+extern hid_t H5AC_coll_read_dxpl_id;
+
 /* Dataset transfer property list for independent metadata I/O calls */
 /* (just "library internal" set - i.e. independent transfer mode) */
 /* (Global variable declaration, definition is in H5AC.c) */
@@ -227,6 +237,13 @@ H5_DLLVAR H5P_genplist_t *H5AC_ind_dxpl_g;
 H5_DLLVAR hid_t H5AC_ind_dxpl_id;
 
 
+/* Version 1 of H5AC_cache_config_t, which ends before the replacement
+ * policy field
+ */
+#define H5AC__CACHE_CONFIG_VERSION_1            1
+#define H5AC__CACHE_CONFIG_VERSION_1_SIZE       \
+                        offsetof(H5AC_cache_config_t, replacement_policy)
+
 /* Default cache configuration. */
 
 #define H5AC__DEFAULT_METADATA_WRITE_STRATEGY   \
@@ -266,12 +283,14 @@ H5_DLLVAR hid_t H5AC_ind_dxpl_id;
   /* double      empty_reserve          = */ 0.1f,                            \
   /* int	 dirty_bytes_threshold  = */ (256 * 1024),                    \
   /* int	metadata_write_strategy = */                                  \
-				       H5AC__DEFAULT_METADATA_WRITE_STRATEGY  \
+				       H5AC__DEFAULT_METADATA_WRITE_STRATEGY, \
+  /* enum H5C_cache_rp_policy             */                                  \
+  /*                 replacement_policy = */ H5C_rp__lru                      \
 }
 #else /* H5_HAVE_PARALLEL */
 #define H5AC__DEFAULT_CACHE_CONFIG                                            \
 {                                                                             \
-  /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,     \
+  /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION, \
   /* hbool_t     rpt_fcn_enabled        = */ FALSE,                           \
   /* hbool_t     open_trace_file        = */ FALSE,                           \
   /* hbool_t     close_trace_file       = */ FALSE,                           \
@@ -302,7 +321,9 @@ H5_DLLVAR hid_t H5AC_ind_dxpl_id;
   /* double      empty_reserve          = */ 0.1f,                            \
   /* int	 dirty_bytes_threshold  = */ (256 * 1024),                    \
   /* int	metadata_write_strategy = */                                  \
-				       H5AC__DEFAULT_METADATA_WRITE_STRATEGY  \
+				       H5AC__DEFAULT_METADATA_WRITE_STRATEGY, \
+  /* enum H5C_cache_rp_policy             */                                  \
+  /*                 replacement_policy = */ H5C_rp__lru                      \
 }
 #endif /* H5_HAVE_PARALLEL */
 
@@ -396,11 +417,22 @@ H5_DLL herr_t H5AC_get_cache_hit_rate(H5AC_t * cache_ptr,
 
 H5_DLL herr_t H5AC_reset_cache_hit_rate_stats(H5AC_t * cache_ptr);
 
+H5_DLL herr_t H5AC_set_bg_flush_threshold(H5AC_t *cache_ptr,
+                                          double threshold);
+
+H5_DLL herr_t H5AC_bg_flush_cancel(const H5F_t *f);
+
 H5_DLL herr_t H5AC_set_cache_auto_resize_config(H5AC_t *cache_ptr,
                                                H5AC_cache_config_t *config_ptr);
 
 H5_DLL herr_t H5AC_validate_config(H5AC_cache_config_t * config_ptr);
 
+H5_DLL herr_t H5AC_config_to_current(const H5AC_cache_config_t * ext_config_ptr,
+                                     H5AC_cache_config_t * config_ptr);
+
+H5_DLL herr_t H5AC_config_from_current(const H5AC_cache_config_t * config_ptr,
+                                       H5AC_cache_config_t * ext_config_ptr);
+
 H5_DLL herr_t H5AC_close_trace_file( H5AC_t * cache_ptr);
 
 H5_DLL herr_t H5AC_open_trace_file(H5AC_t * cache_ptr,
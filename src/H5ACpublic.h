@@ -69,6 +69,11 @@ extern "C" {
  *      H5AC_cache_config_t passed to the cache must have a known
  *      version number, or an error will be flagged.
  *
+ *      Version 1 of the structure ends with the metadata_write_strategy
+ *      field.  Version 2 adds the replacement_policy field.  Version 1
+ *      structures are still accepted: the cache uses the LRU policy
+ *      for them, and never reads or writes their replacement_policy.
+ *
  * rpt_fcn_enabled: Boolean field used to enable and disable the default
  *	reporting function.  This function is invoked every time the
  *	automatic cache resize code is run, and reports on its activities.
@@ -431,10 +436,28 @@ extern "C" {
  *
  *	To avoid possible messages from the past/future, all caches must
  *	wait until all caches are done before leaving the sync point.
+ *
+ *
+ * Replacement Policy Configuration Field:
+ *
+ * replacement_policy: Enumerated type indicating the policy used to
+ *	choose the entries to be evicted when space must be made in the
+ *	cache.  The valid values of this field are:
+ *
+ *	H5C_rp__lru:  The cache evicts the least recently used entries
+ *	first.  This is the default.
+ *
+ *	H5C_rp__2q:  Entries which have been accessed only once since
+ *	they were loaded are evicted before entries which have been
+ *	accessed repeatedly.  This keeps scans over many objects which
+ *	are touched once (for example, iterating over a large group)
+ *	from evicting the frequently used metadata.  Up to one quarter
+ *	of the maximum cache size is reserved for the entries accessed
+ *	only once.
  *      
  ****************************************************************************/
 
-#define H5AC__CURR_CACHE_CONFIG_VERSION 	1
+#define H5AC__CURR_CACHE_CONFIG_VERSION 	2
 #define H5AC__MAX_TRACE_FILE_NAME_LEN		1024
 
 #define H5AC_METADATA_WRITE_STRATEGY__PROCESS_0_ONLY    0
@@ -499,6 +522,10 @@ typedef struct H5AC_cache_config_t
     int                      dirty_bytes_threshold;
     int                      metadata_write_strategy;
 
+
+    /* replacement policy configuration field: */
+    enum H5C_cache_rp_policy replacement_policy;
+
 } H5AC_cache_config_t;
 
 
@@ -324,11 +324,37 @@ H5A__dense_fnd_cb(const H5A_t *attr, hbool_t *took_ownership, void *_user_attr)
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* end H5A__dense_fnd_cb() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5A__dense_copy_rec_cb
+ *
+ * Purpose:	Callback when an attribute is located in the name index,
+ *              to copy its record
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5A__dense_copy_rec_cb(const void *_record, void *_user_record)
+{
+    const H5A_dense_bt2_name_rec_t *record = (const H5A_dense_bt2_name_rec_t *)_record; /* Record from B-tree */
+    H5A_dense_bt2_name_rec_t *user_record = (H5A_dense_bt2_name_rec_t *)_user_record;   /* Copy of record for caller */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    *user_record = *record;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5A__dense_copy_rec_cb() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5A_dense_open
  *
- * Purpose:	Open an attribute in dense storage structures for an object
+ * Purpose:	Open an attribute in dense storage structures for an object.
+ *              If RECORD is non-NULL, the attribute's record in the name
+ *              index is copied to RECORD.
  *
  * Return:	Non-negative on success/Negative on failure
  *
@@ -339,7 +365,8 @@ H5A__dense_fnd_cb(const H5A_t *attr, hbool_t *took_ownership, void *_user_attr)
  *-------------------------------------------------------------------------
  */
 H5A_t *
-H5A_dense_open(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo, const char *name)
+H5A_dense_open(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo, const char *name,
+    H5A_dense_bt2_name_rec_t *record)
 {
     H5A_bt2_ud_common_t udata;          /* User data for v2 B-tree modify */
     H5HF_t *fheap = NULL;               /* Fractal heap handle */
@@ -399,7 +426,7 @@ H5A_dense_open(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo, const char *na
     udata.found_op_data = &ret_value;
 
     /* Find & copy the attribute in the 'name' index */
-    if((attr_exists = H5B2_find(bt2_name, dxpl_id, &udata, NULL, NULL)) < 0)
+    if((attr_exists = H5B2_find(bt2_name, dxpl_id, &udata, (record ? H5A__dense_copy_rec_cb : NULL), record)) < 0)
         HGOTO_ERROR(H5E_ATTR, H5E_NOTFOUND, NULL, "can't search for attribute in name index")
     else if(attr_exists == FALSE)
         HGOTO_ERROR(H5E_ATTR, H5E_NOTFOUND, NULL, "can't locate attribute in name index")
@@ -1681,7 +1708,8 @@ done:
  * Function:	H5A_dense_exists
  *
  * Purpose:	Check if an attribute exists in dense storage structures for
- *              an object
+ *              an object.  If RECORD is non-NULL and the attribute exists,
+ *              its record in the name index is copied to RECORD.
  *
  * Return:	Non-negative on success/Negative on failure
  *
@@ -1692,7 +1720,8 @@ done:
  *-------------------------------------------------------------------------
  */
 htri_t
-H5A_dense_exists(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo, const char *name)
+H5A_dense_exists(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo, const char *name,
+    H5A_dense_bt2_name_rec_t *record)
 {
     H5A_bt2_ud_common_t udata;          /* User data for v2 B-tree modify */
     H5HF_t *fheap = NULL;               /* Fractal heap handle */
@@ -1751,7 +1780,7 @@ H5A_dense_exists(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo, const char *
     udata.found_op_data = NULL;
 
     /* Find the attribute in the 'name' index */
-    if((ret_value = H5B2_find(bt2_name, dxpl_id, &udata, NULL, NULL)) < 0)
+    if((ret_value = H5B2_find(bt2_name, dxpl_id, &udata, (record ? H5A__dense_copy_rec_cb : NULL), record)) < 0)
         HGOTO_ERROR(H5E_ATTR, H5E_NOTFOUND, FAIL, "can't search for attribute in name index")
 
 done:
@@ -1766,6 +1795,70 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5A_dense_exists() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5A_dense_open_rec
+ *
+ * Purpose:	Open an attribute in dense storage structures for an object,
+ *              given its record in the name index.  This avoids searching
+ *              the name index when the record is already known.
+ *
+ * Return:	Success:	Pointer to the attribute
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+H5A_t *
+H5A_dense_open_rec(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo,
+    const H5A_dense_bt2_name_rec_t *record)
+{
+    H5A_fh_ud_cp_t fh_udata;            /* User data for fractal heap 'op' callback */
+    H5HF_t *fheap = NULL;               /* Fractal heap handle */
+    haddr_t fheap_addr;                 /* Address of fractal heap to use */
+    H5A_t *ret_value = NULL;            /* Return value */
+
+    FUNC_ENTER_NOAPI(NULL)
+
+    /*
+     * Check arguments.
+     */
+    HDassert(f);
+    HDassert(ainfo);
+    HDassert(record);
+
+    /* Get the address of the heap the attribute is stored in */
+    if(record->flags & H5O_MSG_FLAG_SHARED) {
+        if(H5SM_get_fheap_addr(f, dxpl_id, H5O_ATTR_ID, &fheap_addr) < 0)
+            HGOTO_ERROR(H5E_ATTR, H5E_CANTGET, NULL, "can't get shared message heap address")
+    } /* end if */
+    else
+        fheap_addr = ainfo->fheap_addr;
+
+    /* Open the fractal heap */
+    if(NULL == (fheap = H5HF_open(f, dxpl_id, fheap_addr)))
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTOPENOBJ, NULL, "unable to open fractal heap")
+
+    /* Prepare user data for callback */
+    fh_udata.f = f;
+    fh_udata.dxpl_id = dxpl_id;
+    fh_udata.record = record;
+    fh_udata.attr = NULL;
+
+    /* Decode the attribute */
+    if(H5HF_op(fheap, dxpl_id, &record->id, H5A__dense_copy_fh_cb, &fh_udata) < 0)
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTOPERATE, NULL, "heap op callback failed")
+
+    /* Set return value */
+    ret_value = fh_udata.attr;
+
+done:
+    /* Release resources */
+    if(fheap && H5HF_close(fheap, dxpl_id) < 0)
+        HDONE_ERROR(H5E_ATTR, H5E_CLOSEERROR, NULL, "can't close fractal heap")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5A_dense_open_rec() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5A__dense_delete_bt2_cb
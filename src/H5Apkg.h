@@ -213,7 +213,7 @@ H5_DLL htri_t H5A_exists_by_name(H5G_loc_t loc, const char *obj_name, const char
 /* Attribute "dense" storage routines */
 H5_DLL herr_t H5A_dense_create(H5F_t *f, hid_t dxpl_id, H5O_ainfo_t *ainfo);
 H5_DLL H5A_t *H5A_dense_open(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo,
-    const char *name);
+    const char *name, H5A_dense_bt2_name_rec_t *record);
 H5_DLL herr_t H5A_dense_insert(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo,
     H5A_t *attr);
 H5_DLL herr_t H5A_dense_write(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo,
@@ -229,8 +229,10 @@ H5_DLL herr_t H5A_dense_remove(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo
 H5_DLL herr_t H5A_dense_remove_by_idx(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo,
     H5_index_t idx_type, H5_iter_order_t order, hsize_t n);
 H5_DLL htri_t H5A_dense_exists(H5F_t *f, hid_t dxpl_id, const H5O_ainfo_t *ainfo,
-    const char *name);
+    const char *name, H5A_dense_bt2_name_rec_t *record);
 H5_DLL herr_t H5A_dense_delete(H5F_t *f, hid_t dxpl_id, H5O_ainfo_t *ainfo);
+H5_DLL H5A_t *H5A_dense_open_rec(H5F_t *f, hid_t dxpl_id,
+    const H5O_ainfo_t *ainfo, const H5A_dense_bt2_name_rec_t *record);
 
 
 /* Attribute table operations */
@@ -250,6 +252,8 @@ H5_DLL H5A_t *H5O_attr_open_by_name(const H5O_loc_t *loc, const char *name,
     hid_t dxpl_id);
 H5_DLL H5A_t *H5O_attr_open_by_idx(const H5O_loc_t *loc, H5_index_t idx_type,
     H5_iter_order_t order, hsize_t n, hid_t dxpl_id);
+H5_DLL ssize_t H5O_attr_open_all(const H5O_loc_t *loc, H5_index_t idx_type,
+    H5_iter_order_t order, size_t max_attrs, H5A_t *attrs[], hid_t dxpl_id);
 H5_DLL herr_t H5O_attr_update_shared(H5F_t *f, hid_t dxpl_id, H5O_t *oh,
         H5A_t *attr, H5O_shared_t *sh_mesg);
 H5_DLL herr_t H5O_attr_write(const H5O_loc_t *loc, hid_t dxpl_id,
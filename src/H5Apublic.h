@@ -51,6 +51,9 @@ H5_DLL hid_t   H5Aopen_by_name(hid_t loc_id, const char *obj_name,
 H5_DLL hid_t   H5Aopen_by_idx(hid_t loc_id, const char *obj_name,
     H5_index_t idx_type, H5_iter_order_t order, hsize_t n, hid_t aapl_id,
     hid_t lapl_id);
+H5_DLL ssize_t H5Aopen_all(hid_t obj_id, H5_index_t idx_type,
+    H5_iter_order_t order, size_t max_attrs, hid_t attr_ids[]/*out*/,
+    hid_t aapl_id);
 H5_DLL herr_t  H5Awrite(hid_t attr_id, hid_t type_id, const void *buf);
 H5_DLL herr_t  H5Aread(hid_t attr_id, hid_t type_id, void *buf);
 H5_DLL herr_t  H5Aclose(hid_t attr_id);
@@ -454,6 +454,7 @@ H5C_apply_candidate_list(H5F_t * f,
     H5C_cache_entry_t *	entry_ptr = NULL;
     H5C_cache_entry_t *	flush_ptr = NULL;
     H5C_cache_entry_t * delayed_ptr = NULL;
+    hbool_t             collecting_writes = FALSE;
 #if H5C_DO_SANITY_CHECKS
     haddr_t		last_addr;
 #endif /* H5C_DO_SANITY_CHECKS */
@@ -626,8 +627,16 @@ H5C_apply_candidate_list(H5F_t * f,
      * to account for this one case where they come into play. If these flags
      * are ever expanded upon, this function and the following flushing steps
      * should be reworked to account for additional cases.
+     *
+     * The writes made by the flushes below are held back and issued as a
+     * single collective write once all the entries have been flushed, so
+     * every process must get to that point.
      * ====================================================================== */
 
+    if(H5F_coll_md_write_begin(f) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTINIT, FAIL, "can't start collecting metadata writes")
+    collecting_writes = TRUE;
+
     entries_examined = 0;
     initial_list_len = cache_ptr->LRU_list_len;
     entry_ptr = cache_ptr->LRU_tail_ptr;
@@ -817,6 +826,11 @@ H5C_apply_candidate_list(H5F_t * f,
     HDfsync(stdout);
 #endif /* H5C_APPLY_CANDIDATE_LIST__DEBUG */
 
+    /* Write out the metadata flushed above, all at once */
+    collecting_writes = FALSE;
+    if(H5F_coll_md_write_end(f, primary_dxpl_id, TRUE) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_WRITEERROR, FAIL, "can't write collected metadata")
+
     /* ====================================================================== *
      * Now, handle all delayed entries.                                       *
      *                                                                        *
@@ -867,6 +881,8 @@ H5C_apply_candidate_list(H5F_t * f,
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "entry count mismatch.")
 
 done:
+    if(collecting_writes && H5F_coll_md_write_end(f, primary_dxpl_id, FALSE) < 0)
+        HDONE_ERROR(H5E_CACHE, H5E_CANTRELEASE, FAIL, "can't stop collecting metadata writes")
     if(candidate_assignment_table != NULL)
         candidate_assignment_table = (int *)H5MM_xfree((void *)candidate_assignment_table);
 
@@ -1076,6 +1092,208 @@ done:
 } /* H5C_construct_candidate_list__min_clean() */
 #endif /* H5_HAVE_PARALLEL */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_bg_flush
+ *
+ * Purpose:     Writes dirty entries ahead of need, so that entries the
+ *		cache later has to evict to make space are usually clean
+ *		already.
+ *
+ *		Dirty entries are written from the tail of the LRU list
+ *		forward, and stay in the cache, until no more than half of
+ *		bg_flush_threshold of the cache is dirty.  Protected and
+ *		pinned entries are never on the LRU list, and so are
+ *		skipped.  This includes every flush dependency parent, as
+ *		H5C_create_flush_dependency() pins the parent: entries
+ *		written here have no flush dependency children, and a
+ *		child may always be written before its parent.
+ *
+ *		The function does nothing if these passes are disabled,
+ *		evictions are disabled or writes aren't permitted.
+ *
+ * Return:      Non-negative on success/Negative on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_bg_flush(H5F_t * f,
+             hid_t   primary_dxpl_id,
+             hid_t   secondary_dxpl_id)
+{
+    H5C_t *		cache_ptr = f->shared->cache;
+    hbool_t		write_permitted;
+    hbool_t		first_flush = TRUE;
+    hbool_t		flushed;
+    hbool_t		prev_is_dirty = FALSE;
+    int32_t		entries_examined = 0;
+    int32_t		initial_list_len;
+    size_t		target;
+    H5C_cache_entry_t *	entry_ptr;
+    H5C_cache_entry_t *	prev_ptr;
+    H5C_cache_entry_t *	next_ptr;
+    herr_t		ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert( f );
+    HDassert( cache_ptr );
+    HDassert( cache_ptr->magic == H5C__H5C_T_MAGIC );
+
+    if ( ( cache_ptr->bg_flush_threshold <= 0.0f ) ||
+         ( ! cache_ptr->evictions_enabled ) ||
+         ( cache_ptr->flush_in_progress ) ) {
+
+        HGOTO_DONE(SUCCEED)
+    }
+
+    if ( cache_ptr->check_write_permitted != NULL ) {
+
+        if ( (cache_ptr->check_write_permitted)(f, primary_dxpl_id,
+                                                &write_permitted) < 0 ) {
+
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, \
+                        "Can't get write_permitted")
+        }
+    } else {
+
+        write_permitted = cache_ptr->write_permitted;
+    }
+
+    if ( ! write_permitted ) {
+
+        HGOTO_DONE(SUCCEED)
+    }
+
+    target = (size_t)(((double)(cache_ptr->max_cache_size)) *
+                      cache_ptr->bg_flush_threshold / 2.0f);
+
+    initial_list_len = cache_ptr->LRU_list_len;
+    entry_ptr = cache_ptr->LRU_tail_ptr;
+
+    while ( ( cache_ptr->dirty_index_size > target ) &&
+            ( entries_examined <= (2 * initial_list_len) ) &&
+            ( entry_ptr != NULL ) )
+    {
+        HDassert( ! (entry_ptr->is_protected) );
+        HDassert( ! (entry_ptr->is_pinned) );
+
+        next_ptr = entry_ptr->next;
+        prev_ptr = entry_ptr->prev;
+
+        if ( prev_ptr != NULL ) {
+
+            prev_is_dirty = prev_ptr->is_dirty;
+        }
+
+        flushed = FALSE;
+
+        if ( ( (entry_ptr->type)->id != H5C__EPOCH_MARKER_TYPE ) &&
+             ( entry_ptr->is_dirty ) &&
+             ( ! entry_ptr->flush_me_last ) &&
+             ( entry_ptr->flush_dep_height == 0 ) ) {
+
+            if ( H5C_flush_single_entry(f,
+                                        primary_dxpl_id,
+                                        secondary_dxpl_id,
+                                        entry_ptr->type,
+                                        entry_ptr->addr,
+                                        H5C__NO_FLAGS_SET,
+                                        &first_flush,
+                                        FALSE) < 0 ) {
+
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, \
+                            "unable to flush entry")
+            }
+
+            cache_ptr->bg_flushes++;
+            flushed = TRUE;
+        }
+
+        if ( prev_ptr == NULL ) {
+
+            entry_ptr = NULL;
+
+        } else if ( ( flushed ) &&
+                    ( ( prev_ptr->is_dirty != prev_is_dirty ) ||
+                      ( prev_ptr->next != next_ptr ) ||
+                      ( prev_ptr->is_protected ) ||
+                      ( prev_ptr->is_pinned ) ) ) {
+
+            /* something has happened to the LRU -- start over
+             * from the tail.
+             */
+            entry_ptr = cache_ptr->LRU_tail_ptr;
+
+        } else {
+
+            entry_ptr = prev_ptr;
+        }
+
+        entries_examined++;
+    }
+
+    /* If the target couldn't be reached, don't try again until more
+     * entries have been dirtied.
+     */
+    if ( cache_ptr->dirty_index_size > target ) {
+
+        cache_ptr->bg_flush_floor = cache_ptr->dirty_index_size;
+
+    } else {
+
+        cache_ptr->bg_flush_floor = (size_t)0;
+    }
+
+done:
+
+    FUNC_LEAVE_NOAPI(ret_value)
+
+} /* H5C_bg_flush() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_bg_flush_needed
+ *
+ * Purpose:     Checks whether more than bg_flush_threshold of the cache
+ *		is dirty, so that H5C_bg_flush() should be called.  After
+ *		a pass which couldn't get under its target, no pass is
+ *		due until half the threshold again has been dirtied.
+ *
+ * Return:      TRUE if a pass is due, FALSE otherwise.
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5C_bg_flush_needed(const H5C_t * cache_ptr)
+{
+    size_t		trigger;
+    hbool_t		ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert( cache_ptr );
+    HDassert( cache_ptr->magic == H5C__H5C_T_MAGIC );
+
+    if ( cache_ptr->bg_flush_threshold > 0.0f ) {
+
+        trigger = (size_t)(((double)(cache_ptr->max_cache_size)) *
+                           cache_ptr->bg_flush_threshold);
+
+        if ( ( cache_ptr->dirty_index_size > trigger ) &&
+             ( cache_ptr->dirty_index_size >=
+               cache_ptr->bg_flush_floor + (trigger / 2) ) ) {
+
+            ret_value = TRUE;
+        }
+    }
+
+    FUNC_LEAVE_NOAPI(ret_value)
+
+} /* H5C_bg_flush_needed() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5C_create
@@ -1170,6 +1388,10 @@ H5C_create(size_t		      max_cache_size,
 
     cache_ptr->evictions_enabled		= TRUE;
 
+    cache_ptr->bg_flush_threshold		= 0.0f;
+    cache_ptr->bg_flush_floor			= (size_t)0;
+    cache_ptr->bg_flushes			= 0;
+
     cache_ptr->index_len			= 0;
     cache_ptr->index_size			= (size_t)0;
     cache_ptr->clean_index_size			= (size_t)0;
@@ -1216,6 +1438,11 @@ H5C_create(size_t		      max_cache_size,
     cache_ptr->dLRU_head_ptr			= NULL;
     cache_ptr->dLRU_tail_ptr			= NULL;
 
+    cache_ptr->rp_policy			= H5C_rp__lru;
+    cache_ptr->rp_cold_len			= 0;
+    cache_ptr->rp_cold_size			= (size_t)0;
+    cache_ptr->rp_cold_head_ptr			= NULL;
+
     cache_ptr->size_increase_possible		= FALSE;
     cache_ptr->flash_size_increase_possible     = FALSE;
     cache_ptr->flash_size_increase_threshold    = 0;
@@ -2582,6 +2809,43 @@ done:
 
 } /* H5C_get_evictions_enabled() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_get_rp_policy()
+ *
+ * Purpose:     Copy the current value of cache_ptr->rp_policy into
+ *              *policy_ptr.
+ *
+ * Return:      SUCCEED on success, and FAIL on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_get_rp_policy(const H5C_t *cache_ptr,
+                  enum H5C_cache_rp_policy * policy_ptr)
+{
+    herr_t ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if ( ( cache_ptr == NULL ) || ( cache_ptr->magic != H5C__H5C_T_MAGIC ) ) {
+
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad cache_ptr on entry.")
+    }
+
+    if ( policy_ptr == NULL ) {
+
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad policy_ptr on entry.")
+    }
+
+    *policy_ptr = cache_ptr->rp_policy;
+
+done:
+
+    FUNC_LEAVE_NOAPI(ret_value)
+
+} /* H5C_get_rp_policy() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5C_get_trace_file_ptr
@@ -2815,6 +3079,9 @@ H5C_insert_entry(H5F_t *             f,
     entry_ptr->aux_next = NULL;
     entry_ptr->aux_prev = NULL;
 
+    entry_ptr->rp_hot = FALSE;
+    entry_ptr->rp_cold = FALSE;
+
     H5C__RESET_CACHE_ENTRY_STATS(entry_ptr)
 
     if ( ( cache_ptr->flash_size_increase_possible ) &&
@@ -3923,6 +4190,11 @@ H5C_protect(H5F_t *		f,
         hit = TRUE;
         thing = (void *)entry_ptr;
 
+        /* a second access promotes the entry out of the cold segment
+         * of the LRU list under the 2Q replacement policy.
+         */
+        entry_ptr->rp_hot = TRUE;
+
     } else {
 
         /* must try to load the entry from disk. */
@@ -4617,6 +4889,108 @@ done:
 
 } /* H5C_set_evictions_enabled() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_set_bg_flush_threshold()
+ *
+ * Purpose:     Set the fraction of the cache which may be dirty before
+ *		H5C_bg_flush_needed() reports that dirty entries should be
+ *		written ahead of need.  A threshold of zero disables this.
+ *
+ * Return:      SUCCEED on success, and FAIL on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_set_bg_flush_threshold(H5C_t *cache_ptr,
+                           double threshold)
+{
+    herr_t ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if ( ( cache_ptr == NULL ) || ( cache_ptr->magic != H5C__H5C_T_MAGIC ) ) {
+
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad cache_ptr on entry.")
+    }
+
+    if ( ( threshold < 0.0f ) || ( threshold > 1.0f ) ) {
+
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, \
+                    "threshold must be in the interval [0.0, 1.0]")
+    }
+
+    cache_ptr->bg_flush_threshold = threshold;
+    cache_ptr->bg_flush_floor = (size_t)0;
+
+done:
+
+    FUNC_LEAVE_NOAPI(ret_value)
+
+} /* H5C_set_bg_flush_threshold() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_set_rp_policy()
+ *
+ * Purpose:     Select the replacement policy used by the cache.
+ *
+ *		Switching to the 2Q policy takes effect gradually, as
+ *		entries are inserted into or return to the LRU list.
+ *		Switching back to the modified LRU policy discards the
+ *		cold segment of the LRU list, leaving the order of the
+ *		entries on it unchanged.
+ *
+ * Return:      SUCCEED on success, and FAIL on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_set_rp_policy(H5C_t *cache_ptr,
+                  enum H5C_cache_rp_policy policy)
+{
+    H5C_cache_entry_t * entry_ptr;
+    herr_t ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if ( ( cache_ptr == NULL ) || ( cache_ptr->magic != H5C__H5C_T_MAGIC ) ) {
+
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad cache_ptr on entry.")
+    }
+
+    if ( ( policy != H5C_rp__lru ) && ( policy != H5C_rp__2q ) ) {
+
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, \
+                    "Unknown replacement policy.")
+    }
+
+    if ( policy == H5C_rp__lru ) {
+
+        entry_ptr = cache_ptr->rp_cold_head_ptr;
+
+        while ( entry_ptr != NULL ) {
+
+            HDassert( entry_ptr->rp_cold );
+
+            entry_ptr->rp_cold = FALSE;
+            entry_ptr = entry_ptr->next;
+        }
+
+        cache_ptr->rp_cold_len = 0;
+        cache_ptr->rp_cold_size = (size_t)0;
+        cache_ptr->rp_cold_head_ptr = NULL;
+    }
+
+    cache_ptr->rp_policy = policy;
+
+done:
+
+    FUNC_LEAVE_NOAPI(ret_value)
+
+} /* H5C_set_rp_policy() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5C_set_prefix
@@ -7013,12 +7387,8 @@ H5C__autoadjust__ageout__cycle_epoch_marker(H5C_t * cache_ptr)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "unused marker in LRU?!?")
     }
 
-    H5C__DLL_REMOVE((&((cache_ptr->epoch_markers)[i])), \
-                    (cache_ptr)->LRU_head_ptr, \
-                    (cache_ptr)->LRU_tail_ptr, \
-                    (cache_ptr)->LRU_list_len, \
-                    (cache_ptr)->LRU_list_size, \
-                    (FAIL))
+    H5C__RP_LRU_REMOVE(cache_ptr, (&((cache_ptr->epoch_markers)[i])), \
+                       FAIL)
 
     /* now, re-insert it at the head of the LRU list, and at the tail of
      * the ring buffer.
@@ -7436,12 +7806,8 @@ H5C__autoadjust__ageout__remove_all_markers(H5C_t * cache_ptr)
         }
 
         /* remove the epoch marker from the LRU list */
-        H5C__DLL_REMOVE((&((cache_ptr->epoch_markers)[i])), \
-                        (cache_ptr)->LRU_head_ptr, \
-                        (cache_ptr)->LRU_tail_ptr, \
-                        (cache_ptr)->LRU_list_len, \
-                        (cache_ptr)->LRU_list_size, \
-                        (FAIL))
+        H5C__RP_LRU_REMOVE(cache_ptr, (&((cache_ptr->epoch_markers)[i])), \
+                           FAIL)
 
         /* mark the epoch marker as unused. */
         (cache_ptr->epoch_marker_active)[i] = FALSE;
@@ -7524,12 +7890,8 @@ H5C__autoadjust__ageout__remove_excess_markers(H5C_t * cache_ptr)
         }
 
         /* remove the epoch marker from the LRU list */
-        H5C__DLL_REMOVE((&((cache_ptr->epoch_markers)[i])), \
-                        (cache_ptr)->LRU_head_ptr, \
-                        (cache_ptr)->LRU_tail_ptr, \
-                        (cache_ptr)->LRU_list_len, \
-                        (cache_ptr)->LRU_list_size, \
-                        (FAIL))
+        H5C__RP_LRU_REMOVE(cache_ptr, (&((cache_ptr->epoch_markers)[i])), \
+                           FAIL)
 
         /* mark the epoch marker as unused. */
         (cache_ptr->epoch_marker_active)[i] = FALSE;
@@ -8838,6 +9200,9 @@ H5C_load_entry(H5F_t *             f,
     entry->aux_next             = NULL;
     entry->aux_prev             = NULL;
 
+    entry->rp_hot               = FALSE;
+    entry->rp_cold              = FALSE;
+
     H5C__RESET_CACHE_ENTRY_STATS(entry);
 
     ret_value = thing;
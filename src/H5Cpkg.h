@@ -189,6 +189,23 @@
  * 		Needless to say, this feature must be used with care.
  *
  *
+ * Dirty entries can also be written ahead of need, so that entries have
+ * usually been cleaned by the time they must be evicted to make space.
+ * The following fields support this.
+ *
+ * bg_flush_threshold: Fraction of max_cache_size which may be dirty
+ *		before H5C_bg_flush_needed() reports that a flush pass is
+ *		due.  Zero (the default) disables these passes.
+ *
+ * bg_flush_floor: dirty_index_size at the end of the last flush pass,
+ *		if that pass could not get under its target (most of the
+ *		dirty data being pinned or protected), and zero otherwise.
+ *		No new pass is due until more data has been dirtied, so
+ *		that the LRU list isn't scanned on every call.
+ *
+ * bg_flushes:	Number of entries written by flush passes.
+ *
+ *
  * The cache requires an index to facilitate searching for entries.  The
  * following fields support that index.
  *
@@ -492,6 +509,42 @@
  *              This field is NULL if the list is empty.
  *
  *
+ * Fields supporting the 2Q replacement policy:
+ *
+ * The replacement policy is selected by the rp_policy field.  Under the
+ * 2Q policy, the LRU list is split in two: a "hot" segment at its head,
+ * holding entries which have been accessed more than once while in the
+ * cache, and a "cold" segment at its tail.  Entries which have only been
+ * accessed once since they were loaded or inserted are placed at the head
+ * of the cold segment instead of the head of the list, and are promoted
+ * to the head of the list if they are accessed again before they reach
+ * its tail.  As entries are only evicted from the tail of the list, a
+ * scan which touches many entries once displaces other cold entries, but
+ * not the hot ones.
+ *
+ * When the cold segment holds less than H5C__2Q_COLD_FRACTION of
+ * max_cache_size, entries at the tail of the hot segment are moved into
+ * it, so that hot entries which stop being accessed are evicted in turn.
+ *
+ * All other code which walks the LRU list is unaware of the segments, and
+ * so works unchanged under either policy.
+ *
+ * rp_policy:	Replacement policy in use, either H5C_rp__lru (the modified
+ *		LRU policy described above, the default) or H5C_rp__2q.
+ *
+ * rp_cold_len: Number of cache entries currently in the cold segment of the
+ *		LRU list.  This field is zero unless rp_policy is H5C_rp__2q.
+ *
+ * rp_cold_size: Number of bytes of cache entries currently in the cold
+ *		segment of the LRU list.
+ *
+ * rp_cold_head_ptr: Pointer to the first entry of the cold segment of the
+ *		LRU list.  The cold segment runs from this entry to the tail
+ *		of the list.
+ *
+ *		This field is NULL if the cold segment is empty.
+ *
+ *
  * Automatic cache size adjustment:
  *
  * While the default cache size is adequate for most cases, we can run into
@@ -855,6 +908,8 @@
 
 #define H5C__HASH_TABLE_LEN     (64 * 1024) /* must be a power of 2 */
 
+#define H5C__2Q_COLD_FRACTION   0.25f      /* of max_cache_size */
+
 #define H5C__H5C_T_MAGIC	0x005CAC0E
 #define H5C__MAX_NUM_TYPE_IDS	27
 #define H5C__PREFIX_LEN		32
@@ -882,6 +937,10 @@ struct H5C_t
 
     hbool_t			evictions_enabled;
 
+    double			bg_flush_threshold;
+    size_t			bg_flush_floor;
+    int64_t			bg_flushes;
+
     int32_t                     index_len;
     size_t                      index_size;
     size_t 			clean_index_size;
@@ -924,6 +983,11 @@ struct H5C_t
     H5C_cache_entry_t *		dLRU_head_ptr;
     H5C_cache_entry_t *	        dLRU_tail_ptr;
 
+    enum H5C_cache_rp_policy	rp_policy;
+    int32_t			rp_cold_len;
+    size_t			rp_cold_size;
+    H5C_cache_entry_t *		rp_cold_head_ptr;
+
     hbool_t			size_increase_possible;
     hbool_t			flash_size_increase_possible;
     size_t			flash_size_increase_threshold;
@@ -2385,6 +2449,129 @@ if ( (cache_ptr)->index_size !=                                             \
  *
  **************************************************************************/
 
+/*-------------------------------------------------------------------------
+ *
+ * Macro:	H5C__RP_LRU_REMOVE
+ *
+ * Purpose:     Remove the specified entry from the LRU list, updating
+ *		the cold segment maintained under the 2Q replacement
+ *		policy if the entry is in it.
+ *
+ * Return:      N/A
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#define H5C__RP_LRU_REMOVE(cache_ptr, entry_ptr, fail_val)                  \
+{                                                                           \
+    if ( (entry_ptr)->rp_cold ) {                                           \
+                                                                            \
+        HDassert( (cache_ptr)->rp_cold_len > 0 );                           \
+        HDassert( (cache_ptr)->rp_cold_size >= (entry_ptr)->size );         \
+                                                                            \
+        if ( (cache_ptr)->rp_cold_head_ptr == (entry_ptr) )                 \
+            (cache_ptr)->rp_cold_head_ptr = (entry_ptr)->next;              \
+        (cache_ptr)->rp_cold_len--;                                         \
+        (cache_ptr)->rp_cold_size -= (entry_ptr)->size;                     \
+        (entry_ptr)->rp_cold = FALSE;                                       \
+    }                                                                       \
+                                                                            \
+    H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,                 \
+                    (cache_ptr)->LRU_tail_ptr,                              \
+                    (cache_ptr)->LRU_list_len,                              \
+                    (cache_ptr)->LRU_list_size, (fail_val))                 \
+} /* H5C__RP_LRU_REMOVE */
+
+
+/*-------------------------------------------------------------------------
+ *
+ * Macro:	H5C__RP_LRU_INSERT
+ *
+ * Purpose:     Insert the specified entry in the LRU list as directed by
+ *		the current replacement policy.
+ *
+ *		Under the modified LRU policy, the entry is simply
+ *		inserted at the head of the list.
+ *
+ *		Under the 2Q policy, entries which have not been accessed
+ *		since they were loaded or inserted are placed at the head
+ *		of the cold segment instead.  Then, if the cold segment
+ *		has fallen below its target size, entries are moved into
+ *		it from the tail of the hot segment.
+ *
+ * Return:      N/A
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#define H5C__RP_LRU_INSERT(cache_ptr, entry_ptr, fail_val)                  \
+{                                                                           \
+    HDassert( !((entry_ptr)->rp_cold) );                                    \
+                                                                            \
+    if ( ( (cache_ptr)->rp_policy == H5C_rp__2q ) &&                        \
+         ( ! ((entry_ptr)->rp_hot) ) ) {                                    \
+                                                                            \
+        if ( (cache_ptr)->rp_cold_head_ptr == NULL ) {                      \
+                                                                            \
+            H5C__DLL_APPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,         \
+                            (cache_ptr)->LRU_tail_ptr,                      \
+                            (cache_ptr)->LRU_list_len,                      \
+                            (cache_ptr)->LRU_list_size, (fail_val))         \
+                                                                            \
+        } else {                                                            \
+                                                                            \
+            (entry_ptr)->next = (cache_ptr)->rp_cold_head_ptr;              \
+            (entry_ptr)->prev = (cache_ptr)->rp_cold_head_ptr->prev;        \
+            if ( (entry_ptr)->prev != NULL )                                \
+                (entry_ptr)->prev->next = (entry_ptr);                      \
+            else                                                            \
+                (cache_ptr)->LRU_head_ptr = (entry_ptr);                    \
+            (cache_ptr)->rp_cold_head_ptr->prev = (entry_ptr);              \
+            (cache_ptr)->LRU_list_len++;                                    \
+            (cache_ptr)->LRU_list_size += (entry_ptr)->size;                \
+        }                                                                   \
+                                                                            \
+        (cache_ptr)->rp_cold_head_ptr = (entry_ptr);                        \
+        (entry_ptr)->rp_cold = TRUE;                                        \
+        (cache_ptr)->rp_cold_len++;                                         \
+        (cache_ptr)->rp_cold_size += (entry_ptr)->size;                     \
+                                                                            \
+    } else {                                                                \
+                                                                            \
+        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,            \
+                         (cache_ptr)->LRU_tail_ptr,                         \
+                         (cache_ptr)->LRU_list_len,                         \
+                         (cache_ptr)->LRU_list_size, (fail_val))            \
+    }                                                                       \
+                                                                            \
+    if ( (cache_ptr)->rp_policy == H5C_rp__2q ) {                           \
+                                                                            \
+        H5C_cache_entry_t * rp_demote_ptr;                                  \
+        size_t rp_cold_target;                                              \
+                                                                            \
+        rp_cold_target = (size_t)(((float)((cache_ptr)->max_cache_size)) *  \
+                                  H5C__2Q_COLD_FRACTION);                   \
+                                                                            \
+        while ( (cache_ptr)->rp_cold_size < rp_cold_target ) {              \
+                                                                            \
+            if ( (cache_ptr)->rp_cold_head_ptr != NULL )                    \
+                rp_demote_ptr = (cache_ptr)->rp_cold_head_ptr->prev;        \
+            else                                                            \
+                rp_demote_ptr = (cache_ptr)->LRU_tail_ptr;                  \
+                                                                            \
+            if ( rp_demote_ptr == NULL )                                    \
+                break;                                                      \
+                                                                            \
+            rp_demote_ptr->rp_hot = FALSE;                                  \
+            rp_demote_ptr->rp_cold = TRUE;                                  \
+            (cache_ptr)->rp_cold_head_ptr = rp_demote_ptr;                  \
+            (cache_ptr)->rp_cold_len++;                                     \
+            (cache_ptr)->rp_cold_size += rp_demote_ptr->size;               \
+        }                                                                   \
+    }                                                                       \
+} /* H5C__RP_LRU_INSERT */
+
+
 /*-------------------------------------------------------------------------
  *
  * Macro:	H5C__FAKE_RP_FOR_MOST_RECENT_ACCESS
@@ -2395,10 +2582,9 @@ if ( (cache_ptr)->index_size !=                                             \
  *		most recently touched so we can repair any such
  *		confusion.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the macro
- *		should switch on the current policy and act accordingly.
+ *		The LRU list is maintained via H5C__RP_LRU_REMOVE and
+ *		H5C__RP_LRU_INSERT, which switch on the current
+ *		replacement policy (modified LRU or 2Q) as required.
  *
  * Return:      N/A
  *
@@ -2438,15 +2624,9 @@ if ( (cache_ptr)->index_size !=                                             \
         /* remove the entry from the LRU list, and re-insert it at the head.\
 	 */                                                                 \
                                                                             \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,             \
-                        (cache_ptr)->LRU_tail_ptr,                          \
-			(cache_ptr)->LRU_list_len,                          \
-                        (cache_ptr)->LRU_list_size, (fail_val))             \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,            \
-                         (cache_ptr)->LRU_tail_ptr,                         \
-			 (cache_ptr)->LRU_list_len,                         \
-                         (cache_ptr)->LRU_list_size, (fail_val))            \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
         /* Use the dirty flag to infer whether the entry is on the clean or \
          * dirty LRU list, and remove it.  Then insert it at the head of    \
@@ -2501,15 +2681,9 @@ if ( (cache_ptr)->index_size !=                                             \
         /* remove the entry from the LRU list, and re-insert it at the head \
 	 */                                                                 \
                                                                             \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,             \
-                        (cache_ptr)->LRU_tail_ptr,                          \
-			(cache_ptr)->LRU_list_len,                          \
-                        (cache_ptr)->LRU_list_size, (fail_val))             \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,            \
-                         (cache_ptr)->LRU_tail_ptr,                         \
-			 (cache_ptr)->LRU_list_len,                         \
-                         (cache_ptr)->LRU_list_size, (fail_val))            \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
         /* End modified LRU specific code. */                               \
     }                                                                       \
@@ -2525,10 +2699,9 @@ if ( (cache_ptr)->index_size !=                                             \
  * Purpose:     Update the replacement policy data structures for an
  *		eviction of the specified cache entry.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The LRU list is maintained via H5C__RP_LRU_REMOVE and
+ *		H5C__RP_LRU_INSERT, which switch on the current
+ *		replacement policy (modified LRU or 2Q) as required.
  *
  * Return:      Non-negative on success/Negative on failure.
  *
@@ -2578,9 +2751,7 @@ if ( (cache_ptr)->index_size !=                                             \
                                                                              \
     /* remove the entry from the LRU list. */                                \
                                                                              \
-    H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,                  \
-                    (cache_ptr)->LRU_tail_ptr, (cache_ptr)->LRU_list_len,    \
-                    (cache_ptr)->LRU_list_size, (fail_val))                  \
+    H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))                 \
                                                                              \
     /* If the entry is clean when it is evicted, it should be on the         \
      * clean LRU list, if it was dirty, it should be on the dirty LRU list.  \
@@ -2620,9 +2791,7 @@ if ( (cache_ptr)->index_size !=                                             \
                                                                              \
     /* remove the entry from the LRU list. */                                \
                                                                              \
-    H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,                  \
-                    (cache_ptr)->LRU_tail_ptr, (cache_ptr)->LRU_list_len,    \
-                    (cache_ptr)->LRU_list_size, (fail_val))                  \
+    H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))                 \
                                                                              \
 } /* H5C__UPDATE_RP_FOR_EVICTION */
 
@@ -2636,10 +2805,9 @@ if ( (cache_ptr)->index_size !=                                             \
  * Purpose:     Update the replacement policy data structures for a flush
  *		of the specified cache entry.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The LRU list is maintained via H5C__RP_LRU_REMOVE and
+ *		H5C__RP_LRU_INSERT, which switch on the current
+ *		replacement policy (modified LRU or 2Q) as required.
  *
  * Return:      N/A
  *
@@ -2694,15 +2862,9 @@ if ( (cache_ptr)->index_size !=                                             \
 	 * head.                                                            \
 	 */                                                                 \
                                                                             \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,             \
-                        (cache_ptr)->LRU_tail_ptr,                          \
-			(cache_ptr)->LRU_list_len,                          \
-                        (cache_ptr)->LRU_list_size, (fail_val))             \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,            \
-                         (cache_ptr)->LRU_tail_ptr,                         \
-			 (cache_ptr)->LRU_list_len,                         \
-                         (cache_ptr)->LRU_list_size, (fail_val))            \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
         /* since the entry is being flushed or cleared, one would think     \
 	 * that it must be dirty -- but that need not be the case.  Use the \
@@ -2756,15 +2918,9 @@ if ( (cache_ptr)->index_size !=                                             \
 	 * head.                                                            \
 	 */                                                                 \
                                                                             \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,             \
-                        (cache_ptr)->LRU_tail_ptr,                          \
-			(cache_ptr)->LRU_list_len,                          \
-                        (cache_ptr)->LRU_list_size, (fail_val))             \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,            \
-                         (cache_ptr)->LRU_tail_ptr,                         \
-			 (cache_ptr)->LRU_list_len,                         \
-                         (cache_ptr)->LRU_list_size, (fail_val))            \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))            \
                                                                             \
         /* End modified LRU specific code. */                               \
     }                                                                       \
@@ -2780,10 +2936,9 @@ if ( (cache_ptr)->index_size !=                                             \
  * Purpose:     Update the replacement policy data structures for an
  *		insertion of the specified cache entry.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The LRU list is maintained via H5C__RP_LRU_REMOVE and
+ *		H5C__RP_LRU_INSERT, which switch on the current
+ *		replacement policy (modified LRU or 2Q) as required.
  *
  * Return:      N/A
  *
@@ -2845,10 +3000,7 @@ if ( (cache_ptr)->index_size !=                                             \
                                                                            \
         /* insert the entry at the head of the LRU list. */                \
                                                                            \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                         (cache_ptr)->LRU_tail_ptr,                        \
-			 (cache_ptr)->LRU_list_len,                        \
-                         (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))           \
                                                                            \
         /* insert the entry at the head of the clean or dirty LRU list as  \
          * appropriate.                                                    \
@@ -2895,10 +3047,7 @@ if ( (cache_ptr)->index_size !=                                             \
                                                                            \
         /* insert the entry at the head of the LRU list. */                \
                                                                            \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                         (cache_ptr)->LRU_tail_ptr,                        \
-			 (cache_ptr)->LRU_list_len,                        \
-                         (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))           \
                                                                            \
         /* End modified LRU specific code. */                              \
     }                                                                      \
@@ -2918,10 +3067,9 @@ if ( (cache_ptr)->index_size !=                                             \
  *		structures used by the replacement policy, and add the
  *		entry to the protected list.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The LRU list is maintained via H5C__RP_LRU_REMOVE and
+ *		H5C__RP_LRU_INSERT, which switch on the current
+ *		replacement policy (modified LRU or 2Q) as required.
  *
  * Return:      N/A
  *
@@ -2981,10 +3129,7 @@ if ( (cache_ptr)->index_size !=                                             \
                                                                           \
         /* remove the entry from the LRU list. */                         \
                                                                           \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                        (cache_ptr)->LRU_tail_ptr,                        \
-			(cache_ptr)->LRU_list_len,                        \
-                        (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))          \
                                                                           \
         /* Similarly, remove the entry from the clean or dirty LRU list   \
          * as appropriate.                                                \
@@ -3044,10 +3189,7 @@ if ( (cache_ptr)->index_size !=                                             \
                                                                           \
         /* remove the entry from the LRU list. */                         \
                                                                           \
-        H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                        (cache_ptr)->LRU_tail_ptr,                        \
-			(cache_ptr)->LRU_list_len,                        \
-                        (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))          \
                                                                           \
         /* End modified LRU specific code. */                             \
     }                                                                     \
@@ -3072,10 +3214,9 @@ if ( (cache_ptr)->index_size !=                                             \
  * Purpose:     Update the replacement policy data structures for a
  *		move of the specified cache entry.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The LRU list is maintained via H5C__RP_LRU_REMOVE and
+ *		H5C__RP_LRU_INSERT, which switch on the current
+ *		replacement policy (modified LRU or 2Q) as required.
  *
  * Return:      N/A
  *
@@ -3103,15 +3244,9 @@ if ( (cache_ptr)->index_size !=                                             \
         /* remove the entry from the LRU list, and re-insert it at the head. \
 	 */                                                                  \
                                                                              \
-            H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,          \
-                             (cache_ptr)->LRU_tail_ptr,                      \
-			     (cache_ptr)->LRU_list_len,                      \
-                             (cache_ptr)->LRU_list_size, (fail_val))         \
+            H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))         \
                                                                              \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,             \
-                         (cache_ptr)->LRU_tail_ptr,                          \
-			 (cache_ptr)->LRU_list_len,                          \
-                         (cache_ptr)->LRU_list_size, (fail_val))             \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))             \
                                                                              \
             /* remove the entry from either the clean or dirty LUR list as   \
              * indicated by the was_dirty parameter                          \
@@ -3181,15 +3316,9 @@ if ( (cache_ptr)->index_size !=                                             \
         /* remove the entry from the LRU list, and re-insert it at the head. \
 	 */                                                                  \
                                                                              \
-            H5C__DLL_REMOVE((entry_ptr), (cache_ptr)->LRU_head_ptr,          \
-                             (cache_ptr)->LRU_tail_ptr,                      \
-			     (cache_ptr)->LRU_list_len,                      \
-                             (cache_ptr)->LRU_list_size, (fail_val))         \
+            H5C__RP_LRU_REMOVE((cache_ptr), (entry_ptr), (fail_val))         \
                                                                              \
-            H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,         \
-                              (cache_ptr)->LRU_tail_ptr,                     \
-			      (cache_ptr)->LRU_list_len,                     \
-                              (cache_ptr)->LRU_list_size, (fail_val))        \
+            H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))         \
                                                                              \
             /* End modified LRU specific code. */                            \
         }                                                                    \
@@ -3212,10 +3341,9 @@ if ( (cache_ptr)->index_size !=                                             \
  *		replacement policy.  Update the appropriate replacement
  *		policy data structures.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The LRU list is maintained via H5C__RP_LRU_REMOVE and
+ *		H5C__RP_LRU_INSERT, which switch on the current
+ *		replacement policy (modified LRU or 2Q) as required.
  *
  * Return:      N/A
  *
@@ -3261,6 +3389,12 @@ if ( (cache_ptr)->index_size !=                                             \
 			                (entry_ptr)->size,                \
 					(new_size));                      \
                                                                           \
+        if ( (entry_ptr)->rp_cold ) {                                     \
+                                                                          \
+            (cache_ptr)->rp_cold_size -= (entry_ptr)->size;               \
+            (cache_ptr)->rp_cold_size += (new_size);                      \
+        }                                                                 \
+                                                                          \
         /* Similarly, update the size of the clean or dirty LRU list as   \
 	 * appropriate.  At present, the entry must be clean, but that    \
 	 * could change.                                                  \
@@ -3317,6 +3451,12 @@ if ( (cache_ptr)->index_size !=                                             \
 			                (entry_ptr)->size,                \
 					(new_size));                      \
                                                                           \
+        if ( (entry_ptr)->rp_cold ) {                                     \
+                                                                          \
+            (cache_ptr)->rp_cold_size -= (entry_ptr)->size;               \
+            (cache_ptr)->rp_cold_size += (new_size);                      \
+        }                                                                 \
+                                                                          \
         /* End modified LRU specific code. */                             \
     }                                                                     \
                                                                           \
@@ -3336,10 +3476,9 @@ if ( (cache_ptr)->index_size !=                                             \
  *		entry list, and re-insert it in the data structures used
  *		by the current replacement policy.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the macro
- *		should switch on the current policy and act accordingly.
+ *		The LRU list is maintained via H5C__RP_LRU_REMOVE and
+ *		H5C__RP_LRU_INSERT, which switch on the current
+ *		replacement policy (modified LRU or 2Q) as required.
  *
  * Return:      N/A
  *
@@ -3379,10 +3518,7 @@ if ( (cache_ptr)->index_size !=                                             \
                                                                        \
         /* insert the entry at the head of the LRU list. */            \
                                                                        \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,       \
-                         (cache_ptr)->LRU_tail_ptr,                    \
-                         (cache_ptr)->LRU_list_len,                    \
-                         (cache_ptr)->LRU_list_size, (fail_val))       \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))       \
                                                                        \
         /* Similarly, insert the entry at the head of either the clean \
          * or dirty LRU list as appropriate.                           \
@@ -3436,10 +3572,7 @@ if ( (cache_ptr)->index_size !=                                             \
                                                                        \
         /* insert the entry at the head of the LRU list. */            \
                                                                        \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,       \
-                         (cache_ptr)->LRU_tail_ptr,                    \
-                         (cache_ptr)->LRU_list_len,                    \
-                         (cache_ptr)->LRU_list_size, (fail_val))       \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))       \
                                                                        \
         /* End modified LRU specific code. */                          \
                                                                        \
@@ -3459,10 +3592,9 @@ if ( (cache_ptr)->index_size !=                                             \
  *		list, and re-insert it in the data structures used by the
  *		current replacement policy.
  *
- *		At present, we only support the modified LRU policy, so
- *		this function deals with that case unconditionally.  If
- *		we ever support other replacement policies, the function
- *		should switch on the current policy and act accordingly.
+ *		The LRU list is maintained via H5C__RP_LRU_REMOVE and
+ *		H5C__RP_LRU_INSERT, which switch on the current
+ *		replacement policy (modified LRU or 2Q) as required.
  *
  * Return:      N/A
  *
@@ -3522,10 +3654,7 @@ if ( (cache_ptr)->index_size !=                                             \
                                                                            \
         /* insert the entry at the head of the LRU list. */                \
                                                                            \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                         (cache_ptr)->LRU_tail_ptr,                        \
-                         (cache_ptr)->LRU_list_len,                        \
-                         (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))           \
                                                                            \
         /* Similarly, insert the entry at the head of either the clean or  \
          * dirty LRU list as appropriate.                                  \
@@ -3581,10 +3710,7 @@ if ( (cache_ptr)->index_size !=                                             \
                                                                            \
         /* insert the entry at the head of the LRU list. */                \
                                                                            \
-        H5C__DLL_PREPEND((entry_ptr), (cache_ptr)->LRU_head_ptr,           \
-                         (cache_ptr)->LRU_tail_ptr,                        \
-                         (cache_ptr)->LRU_list_len,                        \
-                         (cache_ptr)->LRU_list_size, (fail_val))           \
+        H5C__RP_LRU_INSERT((cache_ptr), (entry_ptr), (fail_val))           \
                                                                            \
         /* End modified LRU specific code. */                              \
     }                                                                      \
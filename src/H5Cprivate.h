@@ -529,6 +529,20 @@ typedef herr_t (*H5C_log_flush_func_t)(H5C_t * cache_ptr,
  *		previous item on the clean LRU list.  In either case, when
  *		there is no previous item, it should be NULL.
  *
+ * 2Q:
+ *
+ * Under the 2Q policy, the next and prev fields are used as under the
+ * modified LRU policy.  In addition:
+ *
+ * rp_hot:	Boolean flag indicating that the entry has been accessed
+ *		again after it was loaded or inserted.  Entries without
+ *		this flag re-enter the LRU list at the head of its cold
+ *		segment instead of at its head.
+ *
+ * rp_cold:	Boolean flag indicating that the entry is in the cold
+ *		segment of the LRU list.  This field must be FALSE when the
+ *		entry isn't on the LRU list.
+ *
  *
  * Fields supporting metadata journaling:
  *
@@ -633,6 +647,8 @@ typedef struct H5C_cache_entry_t
     struct H5C_cache_entry_t *	prev;
     struct H5C_cache_entry_t *	aux_next;
     struct H5C_cache_entry_t *	aux_prev;
+    hbool_t			rp_hot;
+    hbool_t			rp_cold;
 
 #if H5C_COLLECT_CACHE_ENTRY_STATS
 
@@ -1079,6 +1095,12 @@ H5_DLL herr_t H5C_construct_candidate_list__clean_cache(H5C_t * cache_ptr);
 H5_DLL herr_t H5C_construct_candidate_list__min_clean(H5C_t * cache_ptr);
 #endif /* H5_HAVE_PARALLEL */
 
+H5_DLL herr_t H5C_bg_flush(H5F_t * f,
+                           hid_t primary_dxpl_id,
+                           hid_t secondary_dxpl_id);
+
+H5_DLL hbool_t H5C_bg_flush_needed(const H5C_t * cache_ptr);
+
 H5_DLL H5C_t * H5C_create(size_t                     max_cache_size,
                           size_t                     min_clean_size,
                           int                        max_type_id,
@@ -1142,6 +1164,9 @@ H5_DLL herr_t H5C_get_entry_status(const H5F_t *f,
 H5_DLL herr_t H5C_get_evictions_enabled(const H5C_t * cache_ptr,
                                         hbool_t * evictions_enabled_ptr);
 
+H5_DLL herr_t H5C_get_rp_policy(const H5C_t * cache_ptr,
+                                enum H5C_cache_rp_policy * policy_ptr);
+
 H5_DLL herr_t H5C_get_trace_file_ptr(const H5C_t *cache_ptr,
     FILE **trace_file_ptr_ptr);
 H5_DLL herr_t H5C_get_trace_file_ptr_from_entry(const H5C_cache_entry_t *entry_ptr,
@@ -1187,6 +1212,12 @@ H5_DLL herr_t H5C_resize_entry(void *thing, size_t new_size);
 H5_DLL herr_t H5C_set_cache_auto_resize_config(H5C_t *cache_ptr,
                                                H5C_auto_size_ctl_t *config_ptr);
 
+H5_DLL herr_t H5C_set_bg_flush_threshold(H5C_t *cache_ptr,
+                                         double threshold);
+
+H5_DLL herr_t H5C_set_rp_policy(H5C_t *cache_ptr,
+                                enum H5C_cache_rp_policy policy);
+
 H5_DLL herr_t H5C_set_evictions_enabled(H5C_t *cache_ptr,
                                         hbool_t evictions_enabled);
 
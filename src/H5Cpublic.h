@@ -55,6 +55,12 @@ enum H5C_cache_decr_mode
     H5C_decr__age_out_with_threshold
 };
 
+enum H5C_cache_rp_policy
+{
+    H5C_rp__lru,
+    H5C_rp__2q
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,6 +31,7 @@
 #include "H5Eprivate.h"		/* Error handling		  	*/
 #include "H5FLprivate.h"	/* Free lists                           */
 #include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
 
 
 /****************/
@@ -203,6 +204,122 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Dcreate2() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dcreate_multi
+ *
+ * Purpose:	Creates COUNT new datasets at LOC_ID, named by the NAME
+ *		array, which all have the same datatype (TYPE_ID),
+ *		dataspace (SPACE_ID) and creation properties (DCPL_ID).
+ *		This is equivalent to calling H5Dcreate2 for each name,
+ *		but the object headers of the datasets are built from a
+ *		single template, allocated together in the file, and the
+ *		links to the datasets are added to their group together.
+ *
+ *		If DSET_ID is not NULL, the new datasets are opened and
+ *		their IDs are returned in DSET_ID, in the same order as
+ *		NAME; each should be closed when the caller is no longer
+ *		interested in it.  If DSET_ID is NULL, the datasets are
+ *		not left open.
+ *
+ *		The names must be distinct.  If a name with no path
+ *		components is already taken in LOC_ID's group, no dataset
+ *		is created.  If another error occurs, datasets created
+ *		before the error remain in the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dcreate_multi(hid_t loc_id, size_t count, const char *name[], hid_t type_id,
+    hid_t space_id, hid_t lcpl_id, hid_t dcpl_id, hid_t dapl_id,
+    hid_t dset_id[]/*out*/)
+{
+    H5G_loc_t	   loc;                 /* Object location to insert datasets into */
+    H5D_t	   **dset = NULL;       /* New datasets' info */
+    const H5S_t    *space;              /* Dataspace for datasets */
+    size_t          u;                  /* Local index variable */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE9("e", "iz**siiiiix", loc_id, count, name, type_id, space_id, lcpl_id,
+             dcpl_id, dapl_id, dset_id);
+
+    /* Check arguments */
+    if(H5G_loc(loc_id, &loc) < 0)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a location ID")
+    if(0 == count)
+        HGOTO_DONE(SUCCEED)
+    if(!name)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no names given")
+    for(u = 0; u < count; u++)
+        if(!name[u] || !*name[u])
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no name")
+    if(H5I_DATATYPE != H5I_get_type(type_id))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype ID")
+    if(NULL == (space = (const H5S_t *)H5I_object_verify(space_id, H5I_DATASPACE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace ID")
+
+    /* Get correct property list */
+    if(H5P_DEFAULT == lcpl_id)
+        lcpl_id = H5P_LINK_CREATE_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(lcpl_id, H5P_LINK_CREATE))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not link creation property list")
+
+    /* Get correct property list */
+    if(H5P_DEFAULT == dcpl_id)
+        dcpl_id = H5P_DATASET_CREATE_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dcpl_id, H5P_DATASET_CREATE))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not dataset create property list ID")
+
+    /* Get correct property list */
+    if(H5P_DEFAULT == dapl_id)
+        dapl_id = H5P_DATASET_ACCESS_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dapl_id, H5P_DATASET_ACCESS))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not dataset access property list")
+
+    /* Allocate space for the new datasets' info, if they are to be opened */
+    if(dset_id) {
+        if(NULL == (dset = (H5D_t **)H5MM_calloc(count * sizeof(H5D_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for datasets")
+        for(u = 0; u < count; u++)
+            dset_id[u] = FAIL;
+    } /* end if */
+
+    /* Create the new datasets */
+    if(H5D__create_multi(&loc, count, name, type_id, space, lcpl_id, dcpl_id, dapl_id, H5AC_dxpl_id, dset) < 0)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to create datasets")
+
+    /* Get IDs for the new datasets */
+    if(dset_id)
+        for(u = 0; u < count; u++) {
+            if((dset_id[u] = H5I_register(H5I_DATASET, dset[u], TRUE)) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTREGISTER, FAIL, "unable to register dataset")
+            dset[u] = NULL;
+        } /* end for */
+
+done:
+    if(dset) {
+        if(ret_value < 0)
+            for(u = 0; u < count; u++) {
+                if(dset[u] && H5D_close(dset[u]) < 0)
+                    HDONE_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "unable to release dataset")
+                if(dset_id[u] >= 0) {
+                    if(H5I_dec_app_ref(dset_id[u]) < 0)
+                        HDONE_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "unable to release dataset ID")
+                    dset_id[u] = FAIL;
+                } /* end if */
+            } /* end for */
+        H5MM_xfree(dset);
+    } /* end if */
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dcreate_multi() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Dcreate_anon
@@ -329,7 +446,7 @@ H5Dopen2(hid_t loc_id, const char *name, hid_t dapl_id)
     H5O_loc_t    oloc;            	/* Dataset object location */
     H5O_type_t   obj_type;              /* Type of object at location */
     hbool_t      loc_found = FALSE;     /* Location at 'name' found */
-    hid_t        dxpl_id = H5AC_dxpl_id;    /* dxpl to use to open datset */
+    hid_t        dxpl_id = H5AC_coll_read_dxpl_id;    /* dxpl to use to open datset */
     hid_t        ret_value;
 
     FUNC_ENTER_API(FAIL)
@@ -978,6 +1095,10 @@ H5Dset_extent(hid_t dset_id, const hsize_t size[])
     if(!size)
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no size specified")
 
+    /* Complete the asynchronous requests made on the file before the change */
+    if(H5D_request_drain(dset->oloc.file) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't complete asynchronous requests")
+
     /* Private function */
     if(H5D__set_extent(dset, size, H5AC_dxpl_id) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set extend dataset")
@@ -0,0 +1,878 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Asynchronous dataset I/O requests.
+ *
+ *		H5Dread_async() and H5Dwrite_async() return a request ID
+ *		which is tested, waited for, canceled and closed with the
+ *		H5Drequest_* routines.
+ *
+ *		In a thread-safe library built with pthreads, requests are
+ *		queued and executed in submission order by a single
+ *		background thread, which takes the library's global lock for
+ *		each request.  Requests on the same dataset or file therefore
+ *		complete in the order they were made, and the application
+ *		keeps running while a request waits for, or holds, the lock.
+ *		Synchronous reads, writes, extent changes, flushes and closes
+ *		first complete the requests queued on their file, so they
+ *		see the effects of the requests made before them.
+ *		In other builds the request is executed before
+ *		H5D*_async() returns and is complete when it is tested.
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#define H5D_PACKAGE		/*suppress error about including H5Dpkg	  */
+
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Dpkg.h"		/* Dataset functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5FLprivate.h"	/* Free Lists                           */
+#include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5Pprivate.h"		/* Property lists			*/
+#include "H5Sprivate.h"		/* Dataspace			  	*/
+
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Requests are executed by a background thread when the library can
+ * share its global lock with one */
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5_HAVE_WIN_THREADS)
+#define H5D_ASYNC_THREAD
+#endif /* H5_HAVE_THREADSAFE && !H5_HAVE_WIN_THREADS */
+
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+/* An asynchronous read or write request */
+struct H5D_request_t {
+    hbool_t     is_write;       /* Whether the request is a write       */
+    hid_t       dset_id;        /* Held reference to the dataset        */
+    hid_t       mem_type_id;    /* Held reference to the memory type    */
+    H5S_t      *mem_space;      /* Copy of the memory dataspace (NULL for H5S_ALL) */
+    H5S_t      *file_space;     /* Copy of the file dataspace (NULL for H5S_ALL) */
+    hid_t       dxpl_id;        /* Copy of the transfer property list   */
+    union {
+        void       *rbuf;       /* Application buffer to read into      */
+        const void *wbuf;       /* Application buffer to write from     */
+    } u;
+    hbool_t     started;        /* Whether execution has started        */
+    H5D_request_status_t status; /* Status of the request               */
+    struct H5D_request_t *next; /* Next request in the queue            */
+};
+
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hid_t H5D__request_submit(hbool_t is_write, hid_t dset_id,
+    hid_t mem_type_id, hid_t mem_space_id, hid_t file_space_id, hid_t dxpl_id,
+    void *rbuf, const void *wbuf);
+static herr_t H5D__request_exec(H5D_request_t *req);
+static herr_t H5D__request_release(H5D_request_t *req);
+static hbool_t H5D__request_dequeue(H5D_request_t *req);
+#ifdef H5D_ASYNC_THREAD
+static void H5D__request_run(H5D_request_t *req);
+static void *H5D__request_worker(void *arg);
+#endif /* H5D_ASYNC_THREAD */
+
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Declare a free list to manage the H5D_request_t struct */
+H5FL_DEFINE_STATIC(H5D_request_t);
+
+#ifdef H5D_ASYNC_THREAD
+/* The request queue, shared with the background thread.  The queue lock
+ * is always taken after the library's global lock, never before it. */
+static pthread_mutex_t H5D_request_lock_g = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t H5D_request_cond_g = PTHREAD_COND_INITIALIZER;
+static H5D_request_t *H5D_request_head_g = NULL;
+static H5D_request_t *H5D_request_tail_g = NULL;
+static hbool_t H5D_request_worker_g = FALSE;    /* Whether the thread is running */
+static hbool_t H5D_request_shutdown_g = FALSE;  /* Whether the thread should exit */
+#endif /* H5D_ASYNC_THREAD */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dread_async
+ *
+ * Purpose:	Starts reading (part of) a dataset into application memory
+ *		BUF, as H5Dread() does, without waiting for the read to
+ *		finish.  The dataspaces and transfer property list are
+ *		copied, so they can be changed or closed right away; BUF
+ *		must not be used until the request completes.
+ *
+ * Return:	Success:	The ID of the request, which must be closed
+ *				with H5Drequest_close()
+ *
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+hid_t
+H5Dread_async(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
+    hid_t file_space_id, hid_t plist_id, void *buf/*out*/)
+{
+    hid_t ret_value;            /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE6("i", "iiiiix", dset_id, mem_type_id, mem_space_id, file_space_id,
+             plist_id, buf);
+
+    if((ret_value = H5D__request_submit(FALSE, dset_id, mem_type_id, mem_space_id, file_space_id, plist_id, buf, NULL)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't start asynchronous read")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dread_async() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dwrite_async
+ *
+ * Purpose:	Starts writing (part of) a dataset from application memory
+ *		BUF, as H5Dwrite() does, without waiting for the write to
+ *		finish.  The dataspaces and transfer property list are
+ *		copied, so they can be changed or closed right away; BUF
+ *		must not be modified until the request completes.
+ *
+ * Return:	Success:	The ID of the request, which must be closed
+ *				with H5Drequest_close()
+ *
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+hid_t
+H5Dwrite_async(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
+    hid_t file_space_id, hid_t plist_id, const void *buf)
+{
+    hid_t ret_value;            /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE6("i", "iiiii*x", dset_id, mem_type_id, mem_space_id, file_space_id,
+             plist_id, buf);
+
+    if((ret_value = H5D__request_submit(TRUE, dset_id, mem_type_id, mem_space_id, file_space_id, plist_id, NULL, buf)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't start asynchronous write")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dwrite_async() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Drequest_test
+ *
+ * Purpose:	Retrieves the status of an asynchronous request without
+ *		waiting for it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Drequest_test(hid_t req_id, H5D_request_status_t *status/*out*/)
+{
+    H5D_request_t *req;                 /* Request */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", req_id, status);
+
+    /* Check arguments */
+    if(NULL == (req = (H5D_request_t *)H5I_object_verify(req_id, H5I_REQUEST)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an asynchronous request")
+    if(NULL == status)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no status pointer")
+
+#ifdef H5D_ASYNC_THREAD
+    pthread_mutex_lock(&H5D_request_lock_g);
+#endif /* H5D_ASYNC_THREAD */
+    *status = req->status;
+#ifdef H5D_ASYNC_THREAD
+    pthread_mutex_unlock(&H5D_request_lock_g);
+#endif /* H5D_ASYNC_THREAD */
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Drequest_test() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Drequest_wait
+ *
+ * Purpose:	Waits for an asynchronous request to complete and
+ *		retrieves its final status.  The library's global lock is
+ *		released while waiting, so this must not be called from a
+ *		callback made by the library.  A reference to the request
+ *		is held during the wait, so that the request isn't freed
+ *		if another thread closes its ID.
+ *
+ * Return:	Non-negative if the request succeeded or was canceled,
+ *		negative if the request or the wait failed
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Drequest_wait(hid_t req_id, H5D_request_status_t *status/*out*/)
+{
+    H5D_request_t *req;                 /* Request */
+    H5D_request_status_t req_status;    /* Status of the request */
+    hbool_t is_write;                   /* Whether the request is a write */
+#ifdef H5D_ASYNC_THREAD
+    hbool_t req_ref = FALSE;            /* Whether a reference to the request is held */
+#endif /* H5D_ASYNC_THREAD */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", req_id, status);
+
+    /* Check arguments */
+    if(NULL == (req = (H5D_request_t *)H5I_object_verify(req_id, H5I_REQUEST)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an asynchronous request")
+    is_write = req->is_write;
+
+#ifdef H5D_ASYNC_THREAD
+    pthread_mutex_lock(&H5D_request_lock_g);
+    if(H5D_REQUEST_IN_PROGRESS == req->status) {
+        /* The background thread needs the global lock to make progress */
+        if(H5_g.init_lock.lock_count != 1) {
+            pthread_mutex_unlock(&H5D_request_lock_g);
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTLOCK, FAIL, "can't wait for a request inside a library callback")
+        } /* end if */
+
+        /* Keep the request from being freed while the global lock is
+         * released */
+        if(H5I_inc_ref(req_id, FALSE) < 0) {
+            pthread_mutex_unlock(&H5D_request_lock_g);
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINC, FAIL, "can't increment count on request ID")
+        } /* end if */
+        req_ref = TRUE;
+        H5TS_mutex_unlock(&H5_g.init_lock);
+
+        while(H5D_REQUEST_IN_PROGRESS == req->status)
+            pthread_cond_wait(&H5D_request_cond_g, &H5D_request_lock_g);
+
+        /* Retake the global lock in the usual order */
+        pthread_mutex_unlock(&H5D_request_lock_g);
+        H5TS_mutex_lock(&H5_g.init_lock);
+        pthread_mutex_lock(&H5D_request_lock_g);
+    } /* end if */
+    req_status = req->status;
+    pthread_mutex_unlock(&H5D_request_lock_g);
+#else /* H5D_ASYNC_THREAD */
+    req_status = req->status;
+#endif /* H5D_ASYNC_THREAD */
+
+    if(status)
+        *status = req_status;
+    if(H5D_REQUEST_FAILED == req_status)
+        HGOTO_ERROR(H5E_DATASET, (is_write ? H5E_WRITEERROR : H5E_READERROR), FAIL, "asynchronous request failed")
+
+done:
+#ifdef H5D_ASYNC_THREAD
+    /* Drop the reference held during the wait, which frees the request
+     * if its ID was closed in the meantime */
+    if(req_ref && H5I_dec_ref(req_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't decrement count on request ID")
+#endif /* H5D_ASYNC_THREAD */
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Drequest_wait() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Drequest_cancel
+ *
+ * Purpose:	Cancels an asynchronous request if it has not started yet.
+ *		A request which has already started runs to completion.
+ *		The resulting status is returned in STATUS, if it is
+ *		non-NULL.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Drequest_cancel(hid_t req_id, H5D_request_status_t *status/*out*/)
+{
+    H5D_request_t *req;                 /* Request */
+    H5D_request_status_t req_status;    /* Status of the request */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", req_id, status);
+
+    /* Check arguments */
+    if(NULL == (req = (H5D_request_t *)H5I_object_verify(req_id, H5I_REQUEST)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an asynchronous request")
+
+    /* Take the request off the queue if it's still waiting there */
+    if(H5D__request_dequeue(req))
+        if(H5D__request_release(req) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't release canceled request")
+
+#ifdef H5D_ASYNC_THREAD
+    pthread_mutex_lock(&H5D_request_lock_g);
+#endif /* H5D_ASYNC_THREAD */
+    req_status = req->status;
+#ifdef H5D_ASYNC_THREAD
+    pthread_mutex_unlock(&H5D_request_lock_g);
+#endif /* H5D_ASYNC_THREAD */
+
+    if(status)
+        *status = req_status;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Drequest_cancel() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Drequest_close
+ *
+ * Purpose:	Closes a request ID.  Requests still in progress must be
+ *		waited for or canceled first.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Drequest_close(hid_t req_id)
+{
+    H5D_request_t *req;                 /* Request */
+    H5D_request_status_t req_status;    /* Status of the request */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", req_id);
+
+    /* Check arguments */
+    if(NULL == (req = (H5D_request_t *)H5I_object_verify(req_id, H5I_REQUEST)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not an asynchronous request")
+
+#ifdef H5D_ASYNC_THREAD
+    pthread_mutex_lock(&H5D_request_lock_g);
+#endif /* H5D_ASYNC_THREAD */
+    req_status = req->status;
+#ifdef H5D_ASYNC_THREAD
+    pthread_mutex_unlock(&H5D_request_lock_g);
+#endif /* H5D_ASYNC_THREAD */
+    if(H5D_REQUEST_IN_PROGRESS == req_status)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "request still in progress")
+
+    /* Decrement the reference count, freeing the request */
+    if(H5I_dec_app_ref(req_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't decrement count on request ID")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Drequest_close() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__request_submit
+ *
+ * Purpose:	Checks the arguments of an asynchronous read or write,
+ *		builds the request and queues it for the background thread,
+ *		or executes it right away when there isn't one.
+ *
+ * Return:	Success:	The ID of the request
+ *
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static hid_t
+H5D__request_submit(hbool_t is_write, hid_t dset_id, hid_t mem_type_id,
+    hid_t mem_space_id, hid_t file_space_id, hid_t dxpl_id, void *rbuf,
+    const void *wbuf)
+{
+    H5D_t *dset;                        /* Dataset */
+    H5P_genplist_t *plist;              /* Transfer property list */
+    const H5S_t *mem_space = NULL;      /* Memory dataspace */
+    const H5S_t *file_space = NULL;     /* File dataspace */
+    hbool_t direct_write = FALSE;       /* Whether this is a direct chunk write */
+    H5D_request_t *req = NULL;          /* New request */
+    hid_t req_id;                       /* ID of the new request */
+    hid_t ret_value;                    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check arguments */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(NULL == dset->oloc.file)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file")
+    if(NULL == H5I_object_verify(mem_type_id, H5I_DATATYPE))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
+    if(is_write)
+        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &direct_write) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting flag for direct chunk write")
+
+    /* Check dataspace selections if this is not a direct write */
+    if(!direct_write) {
+        if(mem_space_id < 0 || file_space_id < 0)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+        if(H5S_ALL != mem_space_id) {
+            if(NULL == (mem_space = (const H5S_t *)H5I_object_verify(mem_space_id, H5I_DATASPACE)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+            if(H5S_SELECT_VALID(mem_space) != TRUE)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "memory selection+offset not within extent")
+        } /* end if */
+        if(H5S_ALL != file_space_id) {
+            if(NULL == (file_space = (const H5S_t *)H5I_object_verify(file_space_id, H5I_DATASPACE)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+            if(H5S_SELECT_VALID(file_space) != TRUE)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "file selection+offset not within extent")
+        } /* end if */
+    } /* end if */
+
+    /* Build the request, holding on to everything it needs */
+    if(NULL == (req = H5FL_CALLOC(H5D_request_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for request")
+    req->is_write = is_write;
+    req->dset_id = FAIL;
+    req->mem_type_id = FAIL;
+    req->dxpl_id = FAIL;
+    if(is_write)
+        req->u.wbuf = wbuf;
+    else
+        req->u.rbuf = rbuf;
+    req->status = H5D_REQUEST_IN_PROGRESS;
+    if(H5I_inc_ref(dset_id, FALSE) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINC, FAIL, "can't increment count on dataset ID")
+    req->dset_id = dset_id;
+    if(H5I_inc_ref(mem_type_id, FALSE) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINC, FAIL, "can't increment count on datatype ID")
+    req->mem_type_id = mem_type_id;
+    if(mem_space && NULL == (req->mem_space = H5S_copy(mem_space, FALSE, TRUE)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't copy memory dataspace")
+    if(file_space && NULL == (req->file_space = H5S_copy(file_space, FALSE, TRUE)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't copy file dataspace")
+    if((req->dxpl_id = H5P_copy_plist(plist, FALSE)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't copy transfer property list")
+
+    /* Register the request before queuing it, so that a failure here
+     * leaves nothing for the background thread to run */
+    if((req_id = H5I_register(H5I_REQUEST, req, TRUE)) < 0)
+        HGOTO_ERROR(H5E_ATOM, H5E_CANTREGISTER, FAIL, "unable to register request")
+
+#ifdef H5D_ASYNC_THREAD
+    /* Queue the request, starting the background thread if necessary */
+    pthread_mutex_lock(&H5D_request_lock_g);
+    H5D_request_shutdown_g = FALSE;
+    if(!H5D_request_worker_g) {
+        pthread_t worker;
+
+        if(pthread_create(&worker, NULL, H5D__request_worker, NULL)) {
+            pthread_mutex_unlock(&H5D_request_lock_g);
+            if(NULL == H5I_remove(req_id))
+                HDONE_ERROR(H5E_ATOM, H5E_CANTRELEASE, FAIL, "unable to remove request ID")
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't create request thread")
+        } /* end if */
+        pthread_detach(worker);
+        H5D_request_worker_g = TRUE;
+    } /* end if */
+    if(H5D_request_tail_g)
+        H5D_request_tail_g->next = req;
+    else
+        H5D_request_head_g = req;
+    H5D_request_tail_g = req;
+    pthread_cond_broadcast(&H5D_request_cond_g);
+    pthread_mutex_unlock(&H5D_request_lock_g);
+#else /* H5D_ASYNC_THREAD */
+    /* Without a background thread, the request completes right away.
+     * Errors are reported through the request's status, as they are by
+     * the background thread. */
+    req->started = TRUE;
+    H5E_clear_stack(NULL);
+    req->status = (H5D__request_exec(req) < 0) ? H5D_REQUEST_FAILED : H5D_REQUEST_SUCCEEDED;
+    if(H5D__request_release(req) < 0)
+        req->status = H5D_REQUEST_FAILED;
+    H5E_clear_stack(NULL);
+#endif /* H5D_ASYNC_THREAD */
+
+    /* The request now belongs to its ID */
+    ret_value = req_id;
+    req = NULL;
+
+done:
+    if(req) {
+        if(ret_value < 0 && H5D_REQUEST_IN_PROGRESS == req->status)
+            if(H5D__request_release(req) < 0)
+                HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't release request resources")
+        req = H5FL_FREE(H5D_request_t, req);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__request_submit() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__request_exec
+ *
+ * Purpose:	Performs the read or write of a request.  The caller holds
+ *		the library's global lock.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__request_exec(H5D_request_t *req)
+{
+    H5D_t *dset;                        /* Dataset */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(req);
+
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(req->dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+
+    if(req->is_write) {
+        H5P_genplist_t *plist;          /* Transfer property list */
+        hbool_t direct_write = FALSE;   /* Whether this is a direct chunk write */
+
+        if(NULL == (plist = (H5P_genplist_t *)H5I_object(req->dxpl_id)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
+        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &direct_write) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting flag for direct chunk write")
+
+        if(H5D__pre_write(dset, direct_write, req->mem_type_id, req->mem_space, req->file_space, req->dxpl_id, req->u.wbuf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write data")
+    } /* end if */
+    else
+        if(H5D__read(dset, req->mem_type_id, req->mem_space, req->file_space, req->dxpl_id, req->u.rbuf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__request_exec() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__request_release
+ *
+ * Purpose:	Drops the references a request holds on the dataset,
+ *		datatype, dataspaces and property list.  The caller holds
+ *		the library's global lock.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__request_release(H5D_request_t *req)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(req);
+
+    if(req->dset_id >= 0 && H5I_dec_ref(req->dset_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't decrement count on dataset ID")
+    req->dset_id = FAIL;
+    if(req->mem_type_id >= 0 && H5I_dec_ref(req->mem_type_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't decrement count on datatype ID")
+    req->mem_type_id = FAIL;
+    if(req->mem_space && H5S_close(req->mem_space) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't close memory dataspace")
+    req->mem_space = NULL;
+    if(req->file_space && H5S_close(req->file_space) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't close file dataspace")
+    req->file_space = NULL;
+    if(req->dxpl_id >= 0 && H5I_dec_ref(req->dxpl_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't decrement count on property list ID")
+    req->dxpl_id = FAIL;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__request_release() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__request_dequeue
+ *
+ * Purpose:	Takes a request which has not started yet off the queue and
+ *		marks it canceled.  The caller holds the library's global
+ *		lock, so a request that has started has also finished.
+ *
+ * Return:	TRUE if the request was canceled, FALSE otherwise
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__request_dequeue(H5D_request_t *req)
+{
+    hbool_t ret_value = FALSE;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(req);
+
+#ifdef H5D_ASYNC_THREAD
+    pthread_mutex_lock(&H5D_request_lock_g);
+    if(!req->started && H5D_REQUEST_IN_PROGRESS == req->status) {
+        H5D_request_t *prev = NULL;     /* Request before REQ in the queue */
+        H5D_request_t *curr;            /* Current request in the queue */
+
+        for(curr = H5D_request_head_g; curr && curr != req; curr = curr->next)
+            prev = curr;
+        HDassert(curr == req);
+        if(prev)
+            prev->next = req->next;
+        else
+            H5D_request_head_g = req->next;
+        if(H5D_request_tail_g == req)
+            H5D_request_tail_g = prev;
+        req->next = NULL;
+
+        req->status = H5D_REQUEST_CANCELED;
+        pthread_cond_broadcast(&H5D_request_cond_g);
+        ret_value = TRUE;
+    } /* end if */
+    pthread_mutex_unlock(&H5D_request_lock_g);
+#endif /* H5D_ASYNC_THREAD */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__request_dequeue() */
+
+#ifdef H5D_ASYNC_THREAD
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__request_run
+ *
+ * Purpose:	Executes a request taken off the queue, releases what it
+ *		holds and publishes its final status.  The caller holds the
+ *		library's global lock.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__request_run(H5D_request_t *req)
+{
+    H5D_request_status_t status;        /* Status of the request */
+
+    /* Errors are reported through the request's status */
+    H5E_clear_stack(NULL);
+    status = (H5D__request_exec(req) < 0) ? H5D_REQUEST_FAILED : H5D_REQUEST_SUCCEEDED;
+    if(H5D__request_release(req) < 0)
+        status = H5D_REQUEST_FAILED;
+    H5E_clear_stack(NULL);
+
+    pthread_mutex_lock(&H5D_request_lock_g);
+    req->status = status;
+    pthread_cond_broadcast(&H5D_request_cond_g);
+    pthread_mutex_unlock(&H5D_request_lock_g);
+} /* end H5D__request_run() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__request_worker
+ *
+ * Purpose:	Main routine of the background thread.  Executes queued
+ *		requests one at a time, in submission order, each with the
+ *		library's global lock held.  Exits when the library shuts
+ *		down and the queue is empty.
+ *
+ * Return:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5D__request_worker(void UNUSED *arg)
+{
+    for(;;) {
+        H5D_request_t *req;             /* Request to execute */
+
+        /* Wait for work */
+        pthread_mutex_lock(&H5D_request_lock_g);
+        while(NULL == H5D_request_head_g) {
+            if(H5D_request_shutdown_g) {
+                H5D_request_worker_g = FALSE;
+                pthread_mutex_unlock(&H5D_request_lock_g);
+                return NULL;
+            } /* end if */
+            pthread_cond_wait(&H5D_request_cond_g, &H5D_request_lock_g);
+        } /* end while */
+        pthread_mutex_unlock(&H5D_request_lock_g);
+
+        /* Take the global lock first, then the next request, which may
+         * have been canceled in the meantime */
+        H5TS_mutex_lock(&H5_g.init_lock);
+        pthread_mutex_lock(&H5D_request_lock_g);
+        if(NULL != (req = H5D_request_head_g)) {
+            H5D_request_head_g = req->next;
+            if(NULL == H5D_request_head_g)
+                H5D_request_tail_g = NULL;
+            req->next = NULL;
+            req->started = TRUE;
+        } /* end if */
+        pthread_mutex_unlock(&H5D_request_lock_g);
+
+        if(req)
+            H5D__request_run(req);
+        H5TS_mutex_unlock(&H5_g.init_lock);
+    } /* end for */
+} /* end H5D__request_worker() */
+#endif /* H5D_ASYNC_THREAD */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__request_free
+ *
+ * Purpose:	Frees a request when its ID is released.  A request still
+ *		waiting in the queue (when the library shuts down) is
+ *		canceled.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__request_free(H5D_request_t *req)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(req);
+
+    if(H5D__request_dequeue(req))
+        if(H5D__request_release(req) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't release canceled request")
+
+    req = H5FL_FREE(H5D_request_t, req);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__request_free() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D_request_drain
+ *
+ * Purpose:	Completes the queued requests on datasets in file F, so
+ *		that a synchronous operation on the file sees their
+ *		effects.  The requests are executed by the calling thread,
+ *		which holds the library's global lock, along with any
+ *		requests queued before them, so that all requests still
+ *		complete in submission order.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D_request_drain(const H5F_t *f)
+{
+    FUNC_ENTER_NOAPI_NOERR
+
+    HDassert(f);
+
+#ifdef H5D_ASYNC_THREAD
+    for(;;) {
+        H5D_request_t *req = NULL;      /* Request to execute */
+        H5D_request_t *curr;            /* Current request in the queue */
+
+        /* Take the head of the queue while a request on the file waits
+         * in it */
+        pthread_mutex_lock(&H5D_request_lock_g);
+        for(curr = H5D_request_head_g; curr; curr = curr->next) {
+            const H5D_t *dset = (const H5D_t *)H5I_object(curr->dset_id);
+
+            if(dset && H5F_SAME_SHARED(dset->oloc.file, f))
+                break;
+        } /* end for */
+        if(curr) {
+            req = H5D_request_head_g;
+            H5D_request_head_g = req->next;
+            if(NULL == H5D_request_head_g)
+                H5D_request_tail_g = NULL;
+            req->next = NULL;
+            req->started = TRUE;
+        } /* end if */
+        pthread_mutex_unlock(&H5D_request_lock_g);
+
+        if(NULL == req)
+            break;
+        H5D__request_run(req);
+    } /* end for */
+#endif /* H5D_ASYNC_THREAD */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D_request_drain() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__request_term
+ *
+ * Purpose:	Tells the background thread, if there is one, to exit once
+ *		the queue is empty.  Called when the library shuts down,
+ *		after all request IDs have been released.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__request_term(void)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+#ifdef H5D_ASYNC_THREAD
+    pthread_mutex_lock(&H5D_request_lock_g);
+    H5D_request_shutdown_g = TRUE;
+    pthread_cond_broadcast(&H5D_request_cond_g);
+    pthread_mutex_unlock(&H5D_request_lock_g);
+#endif /* H5D_ASYNC_THREAD */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__request_term() */
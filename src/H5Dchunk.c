@@ -71,6 +71,10 @@
 #define H5D_CHUNK_GET_NODE_INFO(map, node)  (map->use_single ? map->single_chunk_info : (H5D_chunk_info_t *)H5SL_item(node))
 #define H5D_CHUNK_GET_NEXT_NODE(map, node)  (map->use_single ? (H5SL_node_t *)NULL : H5SL_next(node))
 
+/* Limits on the raw chunks gathered before a batched copy is flushed */
+#define H5D_CHUNK_COPY_BATCH_SIZE       (1024 * 1024)
+#define H5D_CHUNK_COPY_BATCH_NCHUNKS    512
+
 /*
  * Feature: If this constant is defined then every cache preemption and load
  *	    causes a character to be printed on the standard error stream:
@@ -125,6 +129,16 @@ typedef struct H5D_chunk_it_ud2_t {
     haddr_t             *chunk_addr;            /* Array of chunk addresses to fill in */
 } H5D_chunk_it_ud2_t;
 
+/* Information about a raw chunk waiting to be copied in a batch */
+typedef struct H5D_chunk_copy_rec_t {
+    hsize_t     offset[H5O_LAYOUT_NDIMS];       /* Logical offset of chunk */
+    uint32_t    nbytes;                         /* Size of stored data */
+    unsigned    filter_mask;                    /* Excluded filters */
+    haddr_t     src_addr;                       /* Address of chunk in source file */
+    haddr_t     dst_addr;                       /* Address of chunk in dest. file */
+    size_t      buf_off;                        /* Offset of chunk in batch buffer */
+} H5D_chunk_copy_rec_t;
+
 /* Callback info for iteration to copy data */
 typedef struct H5D_chunk_it_ud3_t {
     H5D_chunk_common_ud_t common;           /* Common info for B-tree user data (must be first) */
@@ -152,6 +166,11 @@ typedef struct H5D_chunk_it_ud3_t {
 
     /* needed for copy object pointed by refs */
     H5O_copy_t          *cpy_info;              /* Copy options */
+
+    /* needed for batching raw chunk copies */
+    H5D_chunk_copy_rec_t *batch;                /* Chunks waiting to be copied */
+    size_t              batch_nused;            /* Number of chunks in batch */
+    size_t              batch_nbytes;           /* Total size of chunks in batch */
 } H5D_chunk_it_ud3_t;
 
 /* Callback info for iteration to dump index */
@@ -237,6 +256,8 @@ static herr_t H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id,
 static herr_t H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, size_t size);
 static herr_t H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata);
+static int H5D__chunk_copy_cmp_addr(const void *rec1, const void *rec2);
+static herr_t H5D__chunk_copy_flush_batch(H5D_chunk_it_ud3_t *udata);
 #ifdef H5_HAVE_PARALLEL
 static herr_t H5D__chunk_collective_fill(const H5D_t *dset, hid_t dxpl_id,
     H5D_chunk_coll_info_t *chunk_info, size_t chunk_size, const void *fill_buf);
@@ -3750,6 +3771,112 @@ done:
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_collective_fill() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_lookup_uncached
+ *
+ * Purpose:	Discards any copy of a chunk held in the raw data chunk cache
+ *              and looks up the chunk's information in the chunk index.
+ *
+ *              Used by the collective filtered write path, where the chunk
+ *              in the file is updated behind the back of the chunk cache.
+ *              Chunks of filtered datasets are never dirtied in the cache
+ *              when they are written in parallel, so the cached copy is
+ *              dropped without flushing it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_lookup_uncached(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, const hsize_t *chunk_offset,
+    hsize_t chunk_idx, H5D_chunk_ud_t *udata)
+{
+    herr_t	ret_value = SUCCEED;	/* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(dset);
+    HDassert(dxpl_cache);
+    HDassert(chunk_offset);
+    HDassert(udata);
+
+    /* Find the chunk, possibly in the cache */
+    if(H5D__chunk_lookup(dset, dxpl_id, chunk_offset, chunk_idx, udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+    /* Evict the entry from the cache if present, but do not flush it */
+    if(UINT_MAX != udata->idx_hint) {
+        HDassert(!dset->shared->cache.chunk.slot[udata->idx_hint]->dirty);
+        if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, dset->shared->cache.chunk.slot[udata->idx_hint], FALSE) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
+
+        /* Look the chunk up again, in the index this time */
+        if(H5D__chunk_lookup(dset, dxpl_id, chunk_offset, chunk_idx, udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        HDassert(UINT_MAX == udata->idx_hint);
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_lookup_uncached() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_reinsert
+ *
+ * Purpose:	Records a new size and filter mask for a chunk that has been
+ *              looked up with H5D__chunk_lookup_uncached(), reallocating
+ *              its space in the file if the size changed.  The (possibly
+ *              new) address of the chunk is returned in UDATA.
+ *
+ *              Must be called by all processes with the same arguments,
+ *              in the same order, since it modifies the chunk index.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_reinsert(const H5D_t *dset, hid_t dxpl_id, H5D_chunk_ud_t *udata,
+    uint32_t nbytes, unsigned filter_mask)
+{
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    herr_t	ret_value = SUCCEED;	/* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    HDassert(dset);
+    HDassert(udata);
+    HDassert(UINT_MAX == udata->idx_hint);
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = dxpl_id;
+    idx_info.pline = &(dset->shared->dcpl_cache.pline);
+    idx_info.layout = &(dset->shared->layout.u.chunk);
+    idx_info.storage = &(dset->shared->layout.storage.u.chunk);
+
+    /* Set up the new size of the chunk */
+    udata->nbytes = nbytes;
+    udata->filter_mask = filter_mask;
+
+    /* Create the chunk if it doesn't exist, or reallocate the chunk if its
+     *  size changed.
+     */
+    if((dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk")
+    if(!H5F_addr_defined(udata->addr))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "chunk address isn't defined")
+
+    /* The cached chunk information may describe the old location */
+    H5D__chunk_cinfo_cache_reset(&dset->shared->cache.chunk.last);
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_reinsert() */
 #endif /* H5_HAVE_PARALLEL */
 
 
@@ -4537,6 +4664,144 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_update_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_copy_cmp_addr
+ *
+ * Purpose:     Compare the source addresses of two chunks waiting to be
+ *              copied
+ *
+ * Description: Callback for qsort() to put a batch of chunks in the order
+ *              they are stored in the source file
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_copy_cmp_addr(const void *rec1, const void *rec2)
+{
+    haddr_t addr1, addr2;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    addr1 = ((const H5D_chunk_copy_rec_t *)rec1)->src_addr;
+    addr2 = ((const H5D_chunk_copy_rec_t *)rec2)->src_addr;
+
+    FUNC_LEAVE_NOAPI(H5F_addr_cmp(addr1, addr2))
+} /* end H5D__chunk_copy_cmp_addr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_copy_flush_batch
+ *
+ * Purpose:     Copy a batch of raw chunks, which need neither filtering
+ *              nor datatype conversion, to the destination file.
+ *
+ *              The chunks are sorted by their source address and read
+ *              into one buffer, with adjacent chunks coalesced into a
+ *              single read.  Each chunk is then inserted into the
+ *              destination index and the buffer is written out, again
+ *              coalescing chunks that were allocated next to each other.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_copy_flush_batch(H5D_chunk_it_ud3_t *udata)
+{
+    H5D_chunk_copy_rec_t *batch = udata->batch; /* Chunks waiting to be copied */
+    size_t      nused = udata->batch_nused;     /* Number of chunks in batch */
+    hid_t       dxpl_id = udata->idx_info_dst->dxpl_id; /* DXPL for operation */
+    size_t      buf_off;                        /* Offset in batch buffer */
+    size_t      u, v;                           /* Local index variables */
+    herr_t      ret_value = SUCCEED;            /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check for empty batch */
+    if(0 == nused)
+        HGOTO_DONE(SUCCEED)
+
+    /* Make certain the buffer can hold all the chunks in the batch */
+    if(udata->batch_nbytes > udata->buf_size) {
+        void *new_buf;          /* New buffer for data */
+
+        if(NULL == (new_buf = H5MM_realloc(udata->buf, udata->batch_nbytes)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunks")
+        udata->buf = new_buf;
+        udata->buf_size = udata->batch_nbytes;
+    } /* end if */
+
+    /* Put the chunks in source file order */
+    if(nused > 1)
+        HDqsort(batch, nused, sizeof(batch[0]), H5D__chunk_copy_cmp_addr);
+
+    /* Read the chunks, coalescing chunks that are adjacent in the source file */
+    buf_off = 0;
+    for(u = 0; u < nused; u = v) {
+        size_t len = batch[u].nbytes;   /* Length of read */
+
+        batch[u].buf_off = buf_off;
+        for(v = u + 1; v < nused; v++) {
+            if(!H5F_addr_eq(batch[v - 1].src_addr + batch[v - 1].nbytes, batch[v].src_addr))
+                break;
+            batch[v].buf_off = buf_off + len;
+            len += batch[v].nbytes;
+        } /* end for */
+
+        if(H5F_block_read(udata->file_src, H5FD_MEM_DRAW, batch[u].src_addr, len, dxpl_id, (uint8_t *)udata->buf + buf_off) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunks")
+        buf_off += len;
+    } /* end for */
+
+    /* Set metadata tag in dxpl_id */
+    H5_BEGIN_TAG(dxpl_id, H5AC__COPIED_TAG, FAIL);
+
+    /* Insert the chunks into the destination index */
+    for(u = 0; u < nused; u++) {
+        H5D_chunk_ud_t udata_dst;       /* User data about new destination chunk */
+
+        udata_dst.common.layout = udata->idx_info_dst->layout;
+        udata_dst.common.storage = udata->idx_info_dst->storage;
+        udata_dst.common.offset = batch[u].offset;
+        udata_dst.common.rdcc = NULL;
+        udata_dst.nbytes = batch[u].nbytes;
+        udata_dst.filter_mask = batch[u].filter_mask;
+        udata_dst.addr = HADDR_UNDEF;
+
+        if((udata->idx_info_dst->storage->ops->insert)(udata->idx_info_dst, &udata_dst) < 0)
+            HGOTO_ERROR_TAG(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk into index")
+        HDassert(H5F_addr_defined(udata_dst.addr));
+        batch[u].dst_addr = udata_dst.addr;
+    } /* end for */
+
+    /* Reset metadata tag in dxpl_id */
+    H5_END_TAG(FAIL);
+
+    /* Write the chunks, coalescing chunks that are adjacent in the dest. file */
+    for(u = 0; u < nused; u = v) {
+        size_t len = batch[u].nbytes;   /* Length of write */
+
+        for(v = u + 1; v < nused; v++) {
+            if(!H5F_addr_eq(batch[v - 1].dst_addr + batch[v - 1].nbytes, batch[v].dst_addr))
+                break;
+            len += batch[v].nbytes;
+        } /* end for */
+
+        if(H5F_block_write(udata->idx_info_dst->f, H5FD_MEM_DRAW, batch[u].dst_addr, len, dxpl_id, (uint8_t *)udata->buf + batch[u].buf_off) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+    } /* end for */
+
+done:
+    /* Start a new batch */
+    udata->batch_nused = 0;
+    udata->batch_nbytes = 0;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_copy_flush_batch() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_copy_cb
@@ -4577,6 +4842,29 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
     /* Get 'size_t' local value for number of bytes in chunk */
     H5_ASSIGN_OVERFLOW(nbytes, chunk_rec->nbytes, uint32_t, size_t);
 
+    /* Raw chunks are gathered and copied in batches */
+    if(!udata->do_convert) {
+        H5D_chunk_copy_rec_t *rec;      /* Batch entry for chunk */
+
+        /* Flush the batch if this chunk won't fit */
+        if(udata->batch_nused == H5D_CHUNK_COPY_BATCH_NCHUNKS ||
+                (udata->batch_nused > 0 && (udata->batch_nbytes + nbytes) > H5D_CHUNK_COPY_BATCH_SIZE))
+            if(H5D__chunk_copy_flush_batch(udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, H5_ITER_ERROR, "unable to copy batch of raw data chunks")
+
+        /* Add the chunk to the batch */
+        rec = &udata->batch[udata->batch_nused++];
+        HDmemcpy(rec->offset, chunk_rec->offset, sizeof(rec->offset));
+        rec->nbytes = chunk_rec->nbytes;
+        rec->filter_mask = chunk_rec->filter_mask;
+        rec->src_addr = chunk_rec->chunk_addr;
+        rec->dst_addr = HADDR_UNDEF;
+        rec->buf_off = 0;
+        udata->batch_nbytes += nbytes;
+
+        HGOTO_DONE(H5_ITER_CONT)
+    } /* end if */
+
     /* Check parameter for type conversion */
     if(udata->do_convert) {
         if(H5T_detect_class(udata->dt_src, H5T_VLEN, FALSE) > 0)
@@ -4751,6 +5039,7 @@ H5D__chunk_copy(H5F_t *f_src, H5O_storage_chunk_t *storage_src,
     void       *buf = NULL;             /* Buffer for copying data */
     void       *bkg = NULL;             /* Buffer for background during type conversion */
     void       *reclaim_buf = NULL;     /* Buffer for reclaiming data */
+    H5D_chunk_copy_rec_t *batch = NULL; /* Raw chunks waiting to be copied */
     H5S_t      *buf_space = NULL;       /* Dataspace describing buffer */
     hid_t       sid_buf = -1;           /* ID for buffer dataspace */
     uint32_t    nelmts = 0;             /* Number of elements in buffer */
@@ -4914,6 +5203,14 @@ H5D__chunk_copy(H5F_t *f_src, H5O_storage_chunk_t *storage_src,
             /* Reset value to zero */
             HDmemset(bkg, 0, buf_size);
     } /* end if */
+    else {
+        /* Raw chunks are copied in batches, through a larger buffer */
+        buf_size = MAX(buf_size, H5D_CHUNK_COPY_BATCH_SIZE);
+
+        /* Allocate the list of chunks in a batch */
+        if(NULL == (batch = (H5D_chunk_copy_rec_t *)H5MM_malloc(H5D_CHUNK_COPY_BATCH_NCHUNKS * sizeof(H5D_chunk_copy_rec_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk copy batch")
+    } /* end else */
 
     /* Allocate memory for copying the chunk */
     if(NULL == (buf = H5MM_malloc(buf_size)))
@@ -4942,10 +5239,22 @@ H5D__chunk_copy(H5F_t *f_src, H5O_storage_chunk_t *storage_src,
     udata.nelmts = nelmts;
     udata.pline = pline;
     udata.cpy_info = cpy_info;
+    udata.batch = batch;
+    udata.batch_nused = 0;
+    udata.batch_nbytes = 0;
 
     /* Iterate over chunks to copy data */
-    if((storage_src->ops->iterate)(&idx_info_src, H5D__chunk_copy_cb, &udata) < 0)
+    if((storage_src->ops->iterate)(&idx_info_src, H5D__chunk_copy_cb, &udata) < 0) {
+        buf = udata.buf;
+        bkg = udata.bkg;
         HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "unable to iterate over chunk index to copy data")
+    } /* end if */
+
+    /* Copy any raw chunks left in the last batch */
+    if(H5D__chunk_copy_flush_batch(&udata) < 0) {
+        buf = udata.buf;
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "unable to copy batch of raw data chunks")
+    } /* end if */
 
     /* I/O buffers may have been re-allocated */
     buf = udata.buf;
@@ -4966,6 +5275,8 @@ done:
         H5MM_xfree(bkg);
     if(reclaim_buf)
         H5MM_xfree(reclaim_buf);
+    if(batch)
+        H5MM_xfree(batch);
 
     /* Clean up any index information */
     if(copy_setup_done)
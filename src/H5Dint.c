@@ -40,6 +40,15 @@
 /* Local Macros */
 /****************/
 
+/* Max. # of datasets whose object headers are created together by H5D__create_multi() */
+#define H5D_CREATE_MULTI_BATCH          256
+
+/* # of kinds of object header messages copied from a template dataset */
+#define H5D_CREATE_MULTI_NMESGS         6
+
+/* Whether a dataset name given to H5D__create_multi() is a link in the group itself */
+#define H5D_CREATE_MULTI_LOCAL_NAME(N)  (NULL == HDstrchr((N), '/') && HDstrcmp((N), "."))
+
 
 /******************/
 /* Local Typedefs */
@@ -51,6 +60,28 @@ typedef struct {
     hid_t dxpl_id;              /* DXPL for I/O operations */
 } H5D_flush_ud_t;
 
+/* Kind of object header message copied from a template dataset */
+typedef struct {
+    unsigned type_id;           /* Message type ID */
+    unsigned flags;             /* Flags for the message */
+    hbool_t sharable;           /* Whether the message is sharable */
+    hbool_t optional;           /* Whether the message may be missing */
+} H5D_multi_mesg_class_t;
+
+/* Object header messages of a template dataset, for H5D__create_multi() */
+typedef struct {
+    H5D_t *dset;                /* Template dataset */
+    void *mesg[H5D_CREATE_MULTI_NMESGS];        /* The template's messages */
+    hbool_t copied[H5D_CREATE_MULTI_NMESGS];    /* Whether a message was copied from the template's header */
+    hbool_t reshare[H5D_CREATE_MULTI_NMESGS];   /* Whether to share a message again for each dataset */
+} H5D_multi_tmpl_t;
+
+/* Name of a dataset to create with H5D__create_multi() */
+typedef struct {
+    const char *name;           /* Name of the dataset */
+    size_t idx;                 /* Position of the name in the application's list */
+} H5D_multi_name_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -68,6 +99,13 @@ static herr_t H5D__update_oh_info(H5F_t *file, hid_t dxpl_id, H5D_t *dset,
 static herr_t H5D__open_oid(H5D_t *dataset, hid_t dapl_id, hid_t dxpl_id);
 static herr_t H5D__init_storage(const H5D_t *dataset, hbool_t full_overwrite,
     hsize_t old_dim[], hid_t dxpl_id);
+static int H5D__multi_name_cmp(const void *_name1, const void *_name2);
+static htri_t H5D__multi_tmpl_init(H5D_multi_tmpl_t *tmpl, H5D_t *dset,
+    hid_t dxpl_id);
+static herr_t H5D__multi_tmpl_reset(H5D_multi_tmpl_t *tmpl);
+static herr_t H5D__create_clones(const H5G_loc_t *loc, H5D_multi_tmpl_t *tmpl,
+    const H5D_multi_name_t names[], size_t count, H5T_cset_t cset,
+    hid_t dapl_id, hid_t dxpl_id, H5D_t *dset[]);
 
 
 /*********************/
@@ -109,6 +147,18 @@ H5FL_BLK_EXTERN(type_conv);
 /* Define a static "default" dataset structure to use to initialize new datasets */
 static H5D_shared_t H5D_def_dset;
 
+/* Object header messages copied from a template dataset by H5D__create_multi(),
+ * in the order that H5D__update_oh_info() adds them to a new dataset
+ */
+static const H5D_multi_mesg_class_t H5D_multi_mesg_g[H5D_CREATE_MULTI_NMESGS] = {
+    {H5O_SDSPACE_ID,    0,                      TRUE,   FALSE},
+    {H5O_DTYPE_ID,      H5O_MSG_FLAG_CONSTANT,  TRUE,   FALSE},
+    {H5O_FILL_NEW_ID,   H5O_MSG_FLAG_CONSTANT,  TRUE,   FALSE},
+    {H5O_FILL_ID,       H5O_MSG_FLAG_CONSTANT,  TRUE,   TRUE},
+    {H5O_PLINE_ID,      H5O_MSG_FLAG_CONSTANT,  TRUE,   TRUE},
+    {H5O_LAYOUT_ID,     0,                      FALSE,  FALSE}
+};
+
 /* Dataset ID class */
 static const H5I_class_t H5I_DATASET_CLS[1] = {{
     H5I_DATASET,		/* ID class value */
@@ -117,6 +167,14 @@ static const H5I_class_t H5I_DATASET_CLS[1] = {{
     (H5I_free_t)H5D_close       /* Callback routine for closing objects of this class */
 }};
 
+/* Asynchronous I/O request ID class */
+static const H5I_class_t H5I_REQUEST_CLS[1] = {{
+    H5I_REQUEST,		/* ID class value */
+    0,				/* Class flags */
+    0,				/* # of reserved IDs for class */
+    (H5I_free_t)H5D__request_free /* Callback routine for closing objects of this class */
+}};
+
 
 
 /*-------------------------------------------------------------------------
@@ -173,6 +231,10 @@ H5D__init_interface(void)
     if(H5I_register_type(H5I_DATASET_CLS) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize interface")
 
+    /* Initialize the atom group for the asynchronous I/O request IDs */
+    if(H5I_register_type(H5I_REQUEST_CLS) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize interface")
+
     /* Reset the "default dataset" information */
     HDmemset(&H5D_def_dset, 0, sizeof(H5D_shared_t));
 
@@ -229,7 +291,12 @@ H5D_term_interface(void)
     FUNC_ENTER_NOAPI_NOINIT_NOERR
 
     if(H5_interface_initialize_g) {
-	if(H5I_nmembers(H5I_DATASET) > 0) {
+        /* Release (and cancel) asynchronous requests before their datasets */
+	if(H5I_nmembers(H5I_REQUEST) > 0) {
+	    (void)H5I_clear_type(H5I_REQUEST, FALSE, FALSE);
+            n++; /*H5I*/
+	} /* end if */
+	else if(H5I_nmembers(H5I_DATASET) > 0) {
             /* The dataset API uses the "force" flag set to true because it
              * is using the "file objects" (H5FO) API functions to track open
              * objects in the file.  Using the H5FO code means that dataset
@@ -262,8 +329,12 @@ H5D_term_interface(void)
             /* Close deprecated interface */
             n += H5D__term_deprec_interface();
 
-	    /* Destroy the dataset object id group */
+            /* Stop the background request thread */
+            (void)H5D__request_term();
+
+	    /* Destroy the dataset and request id groups */
 	    (void)H5I_dec_type_ref(H5I_DATASET);
+	    (void)H5I_dec_type_ref(H5I_REQUEST);
             n++; /*H5I*/
 
 	    /* Mark closed */
@@ -460,6 +531,458 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__create_named() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_name_cmp
+ *
+ * Purpose:	Compare the names of two datasets to create with
+ *              H5D__create_multi(), for sorting them.
+ *
+ * Return:	An integer less than, equal to, or greater than zero if the
+ *              first name is less than, equal to, or greater than the
+ *              second name.
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__multi_name_cmp(const void *_name1, const void *_name2)
+{
+    const H5D_multi_name_t *name1 = (const H5D_multi_name_t *)_name1;
+    const H5D_multi_name_t *name2 = (const H5D_multi_name_t *)_name2;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    FUNC_LEAVE_NOAPI(HDstrcmp(name1->name, name2->name))
+} /* end H5D__multi_name_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_tmpl_init
+ *
+ * Purpose:	Set up a template for the object headers of datasets
+ *              created like DSET, by copying the messages from DSET's
+ *              object header.
+ *
+ *              Datasets whose creation does more than add these messages
+ *              (datasets with compact or external storage, or whose
+ *              storage is allocated early) can't be used as a template.
+ *
+ * Return:	Success:	TRUE if DSET can be used as a template,
+ *                              FALSE if not
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__multi_tmpl_init(H5D_multi_tmpl_t *tmpl, H5D_t *dset, hid_t dxpl_id)
+{
+    const H5D_shared_t *shared = dset->shared;  /* Dataset's shared information */
+    H5O_t *oh = NULL;                   /* Dataset's object header */
+    unsigned u;                         /* Local index variable */
+    htri_t ret_value = TRUE;            /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checking */
+    HDassert(tmpl);
+    HDassert(dset);
+
+    tmpl->dset = dset;
+
+    /* Check for datasets that need more than their messages copied */
+    if(shared->layout.type == H5D_COMPACT || shared->dcpl_cache.efl.nused > 0
+            || shared->dcpl_cache.fill.alloc_time == H5D_ALLOC_TIME_EARLY)
+        HGOTO_DONE(FALSE)
+#ifdef H5O_ENABLE_BOGUS
+{
+    H5P_genplist_t *dc_plist;           /* Dataset's creation property list */
+
+    /* Get dataset's property list object */
+    if(NULL == (dc_plist = (H5P_genplist_t *)H5I_object(shared->dcpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get dataset creation property list")
+
+    /* Don't copy "bogus" messages */
+    if(H5P_exist_plist(dc_plist, H5O_BOGUS_MSG_FLAGS_NAME) > 0)
+        HGOTO_DONE(FALSE)
+}
+#endif /* H5O_ENABLE_BOGUS */
+
+    /* Get the dataset's object header */
+    if(NULL == (oh = H5O_protect(&dset->oloc, dxpl_id, H5AC_READ)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTPROTECT, FAIL, "unable to protect dataset object header")
+
+    /* Copy the messages */
+    for(u = 0; u < H5D_CREATE_MULTI_NMESGS; u++) {
+        const H5D_multi_mesg_class_t *mesg_class = &H5D_multi_mesg_g[u];
+        htri_t exists;                  /* Whether the message exists */
+
+        if((exists = H5O_msg_exists_oh(oh, mesg_class->type_id)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to check for message")
+        if(!exists) {
+            if(!mesg_class->optional)
+                HGOTO_ERROR(H5E_DATASET, H5E_NOTFOUND, FAIL, "dataset message not found")
+            continue;
+        } /* end if */
+
+        /* Use an immutable datatype directly, as H5D__init_type() does */
+        /* (so that it isn't shared) */
+        if(H5O_DTYPE_ID == mesg_class->type_id) {
+            htri_t immutable;           /* Whether the datatype is immutable */
+
+            if((immutable = H5T_is_immutable(shared->type)) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "can't check datatype")
+            if(immutable) {
+                tmpl->mesg[u] = shared->type;
+                continue;
+            } /* end if */
+        } /* end if */
+
+        if(NULL == (tmpl->mesg[u] = H5O_msg_read_oh(dset->oloc.file, dxpl_id, oh, mesg_class->type_id, NULL)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to read dataset message")
+        tmpl->copied[u] = TRUE;
+
+        /* Messages shared in the file's shared message table are shared
+         *      again for each new dataset (which also updates the table's
+         *      reference counts), while a committed datatype is linked to
+         *      directly.
+         */
+        if(mesg_class->sharable && H5O_SHARE_TYPE_COMMITTED != ((const H5O_shared_t *)tmpl->mesg[u])->type) {
+            tmpl->reshare[u] = TRUE;
+            H5O_msg_reset_share(mesg_class->type_id, tmpl->mesg[u]);
+        } /* end if */
+    } /* end for */
+
+done:
+    if(oh && H5O_unprotect(&dset->oloc, dxpl_id, oh, H5AC__NO_FLAGS_SET) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTUNPROTECT, FAIL, "unable to release dataset object header")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_tmpl_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_tmpl_reset
+ *
+ * Purpose:	Release the messages copied into a template for the object
+ *              headers of datasets.  The template dataset itself is not
+ *              closed.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__multi_tmpl_reset(H5D_multi_tmpl_t *tmpl)
+{
+    unsigned u;                         /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checking */
+    HDassert(tmpl);
+
+    for(u = 0; u < H5D_CREATE_MULTI_NMESGS; u++) {
+        if(tmpl->copied[u])
+            H5O_msg_free(H5D_multi_mesg_g[u].type_id, tmpl->mesg[u]);
+        tmpl->mesg[u] = NULL;
+        tmpl->copied[u] = FALSE;
+        tmpl->reshare[u] = FALSE;
+    } /* end for */
+    tmpl->dset = NULL;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__multi_tmpl_reset() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__create_clones
+ *
+ * Purpose:	Create datasets named NAMES in the group at LOC, from the
+ *              messages of the template dataset TMPL.  The object
+ *              headers for the datasets are allocated together, and the
+ *              links to them are inserted into the group together.
+ *
+ *              If DSET is not NULL, each new dataset is opened and stored
+ *              in DSET, at the position given with its name.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__create_clones(const H5G_loc_t *loc, H5D_multi_tmpl_t *tmpl,
+    const H5D_multi_name_t names[], size_t count, H5T_cset_t cset,
+    hid_t dapl_id, hid_t dxpl_id, H5D_t *dset[])
+{
+    H5F_t *file = loc->oloc->file;      /* File to create datasets in */
+    H5O_loc_t *oloc = NULL;             /* New datasets' object locations */
+    H5O_link_t *lnk = NULL;             /* Links to new datasets */
+    H5O_t *oh = NULL;                   /* New dataset's object header */
+    hbool_t use_latest_format;          /* Flag indicating the newest file format should be used */
+    size_t ncreated = 0;                /* # of object headers created */
+    size_t nlinked = 0;                 /* # of datasets linked into the group */
+    size_t nreleased = 0;               /* # of object headers released */
+    size_t u;                           /* Local index variable */
+    unsigned v;                         /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checking */
+    HDassert(loc);
+    HDassert(tmpl && tmpl->dset);
+    HDassert(names);
+    HDassert(count > 0 && count <= H5D_CREATE_MULTI_BATCH);
+
+    /* Get the file's 'use the latest version of the format' flag */
+    use_latest_format = H5F_USE_LATEST_FORMAT(file);
+
+    /* Allocate the object locations & links */
+    if(NULL == (oloc = (H5O_loc_t *)H5MM_malloc(count * sizeof(H5O_loc_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for object locations")
+    if(NULL == (lnk = (H5O_link_t *)H5MM_calloc(count * sizeof(H5O_link_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for links")
+    for(u = 0; u < count; u++)
+        H5O_loc_reset(&oloc[u]);
+
+    /* Create the object headers, in one block */
+    if(H5O_create_multi(file, dxpl_id, H5D_MINHDR_SIZE, (size_t)1, tmpl->dset->shared->dcpl_id, count, oloc/*out*/) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to create dataset object headers")
+    ncreated = count;
+
+    for(u = 0; u < count; u++) {
+        /* Pin the object header */
+        if(NULL == (oh = H5O_pin(&oloc[u], dxpl_id)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTPIN, FAIL, "unable to pin dataset object header")
+
+        /* Add the template's messages */
+        for(v = 0; v < H5D_CREATE_MULTI_NMESGS; v++)
+            if(tmpl->mesg[v]) {
+                if(tmpl->reshare[v])
+                    H5O_msg_reset_share(H5D_multi_mesg_g[v].type_id, tmpl->mesg[v]);
+                if(H5O_msg_append_oh(file, dxpl_id, oh, H5D_multi_mesg_g[v].type_id, H5D_multi_mesg_g[v].flags, 0, tmpl->mesg[v]) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to add dataset header message")
+            } /* end if */
+
+        /* Add a modification time message, if using older format. */
+        if(!use_latest_format)
+            if(H5O_touch_oh(file, dxpl_id, oh, TRUE) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to update modification time message")
+
+        /* Release pointer to object header */
+        if(H5O_unpin(oh) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTUNPIN, FAIL, "unable to unpin dataset object header")
+        oh = NULL;
+
+        /* Set up the link to the dataset */
+        lnk[u].type = H5L_TYPE_HARD;
+        lnk[u].corder = 0;      /* Will be reset if the group is tracking creation order */
+        lnk[u].corder_valid = FALSE;    /* Indicate that the creation order isn't valid (yet) */
+        lnk[u].cset = cset;
+        /* The link messages are only read from while inserting, so
+         * casting away const is OK */
+H5_GCC_DIAG_OFF(cast-qual)
+        lnk[u].name = (char *)names[u].name;
+H5_GCC_DIAG_ON(cast-qual)
+        lnk[u].u.hard.addr = oloc[u].addr;
+    } /* end for */
+
+    /* Insert the links into the group */
+    if(H5G_obj_insert_multi(loc->oloc, count, lnk, TRUE, H5O_TYPE_DATASET, &nlinked, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert links to datasets")
+
+    for(u = 0; u < count; u++) {
+        /* Drop the initial reference on the object header & close it */
+        /* (the link to the dataset keeps it alive now) */
+        nreleased = u + 1;
+        if(H5O_dec_rc_by_loc(&oloc[u], dxpl_id) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "unable to decrement refcount on newly created object")
+        if(H5O_close(&oloc[u]) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "unable to release object header")
+
+        /* Open the new dataset, if requested */
+        if(dset) {
+            H5G_loc_t dset_loc;         /* Location of new dataset */
+            H5O_loc_t dset_oloc;        /* Object location of new dataset */
+            H5G_name_t dset_path;       /* Path of new dataset */
+
+            dset_loc.oloc = &dset_oloc;
+            dset_loc.path = &dset_path;
+            H5G_loc_reset(&dset_loc);
+            dset_oloc.file = file;
+            dset_oloc.addr = oloc[u].addr;
+            if(H5G_name_set(loc->path, &dset_path, names[u].name) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "cannot set name")
+
+            if(NULL == (dset[names[u].idx] = H5D_open(&dset_loc, dapl_id, dxpl_id)))
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTOPENOBJ, FAIL, "unable to open dataset")
+        } /* end if */
+    } /* end for */
+
+done:
+    if(oh && H5O_unpin(oh) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTUNPIN, FAIL, "unable to unpin dataset object header")
+
+    /* Release the object headers still held, deleting those not linked */
+    for(u = nreleased; u < ncreated; u++) {
+        if(H5O_dec_rc_by_loc(&oloc[u], dxpl_id) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "unable to decrement refcount on newly created object")
+        if(H5O_close(&oloc[u]) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "unable to release object header")
+        if(u >= nlinked && H5O_delete(file, dxpl_id, oloc[u].addr) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTDELETE, FAIL, "unable to delete object header")
+    } /* end for */
+
+    H5MM_xfree(oloc);
+    H5MM_xfree(lnk);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__create_clones() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__create_multi
+ *
+ * Purpose:	Internal routine to create COUNT new datasets, named NAME,
+ *              with the same datatype, dataspace and creation properties.
+ *
+ *              The names are processed in sorted order.  The first
+ *              dataset created directly in the group at LOC is created
+ *              normally and used as a template for the rest: their object
+ *              headers are copies of its header, allocated in batches
+ *              from one block of file space, and their links are inserted
+ *              into the group in batches.  Datasets named with a path, and
+ *              datasets whose template can't be copied, are created one at
+ *              a time, as with H5D__create_named().
+ *
+ *              If DSET is not NULL, the new datasets are left open and
+ *              returned in it, in the order of NAME.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__create_multi(const H5G_loc_t *loc, size_t count, const char *name[],
+    hid_t type_id, const H5S_t *space, hid_t lcpl_id, hid_t dcpl_id,
+    hid_t dapl_id, hid_t dxpl_id, H5D_t *dset[]/*out*/)
+{
+    H5D_multi_name_t *names = NULL;     /* Sorted dataset names */
+    H5D_multi_tmpl_t tmpl;              /* Template for dataset object headers */
+    htri_t use_tmpl = FALSE;            /* Whether the template can be used */
+    H5P_genplist_t *lc_plist;           /* Link creation property list */
+    H5T_cset_t cset;                    /* Character encoding for links */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check arguments */
+    HDassert(loc);
+    HDassert(count > 0);
+    HDassert(name);
+    HDassert(type_id != H5P_DEFAULT);
+    HDassert(space);
+    HDassert(lcpl_id != H5P_DEFAULT);
+    HDassert(dcpl_id != H5P_DEFAULT);
+    HDassert(dapl_id != H5P_DEFAULT);
+    HDassert(dxpl_id != H5P_DEFAULT);
+
+    HDmemset(&tmpl, 0, sizeof(tmpl));
+    if(dset)
+        for(u = 0; u < count; u++)
+            dset[u] = NULL;
+
+    /* Get the character encoding for the links */
+    if(NULL == (lc_plist = (H5P_genplist_t *)H5I_object(lcpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a link creation property list")
+    if(H5P_get(lc_plist, H5P_STRCRT_CHAR_ENCODING_NAME, &cset) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get character encoding value")
+
+    /* Sort the names */
+    if(NULL == (names = (H5D_multi_name_t *)H5MM_malloc(count * sizeof(H5D_multi_name_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for dataset names")
+    for(u = 0; u < count; u++) {
+        HDassert(name[u] && *name[u]);
+        names[u].name = name[u];
+        names[u].idx = u;
+    } /* end for */
+    HDqsort(names, count, sizeof(H5D_multi_name_t), H5D__multi_name_cmp);
+
+    /* Check for duplicate names */
+    for(u = 1; u < count; u++)
+        if(0 == HDstrcmp(names[u - 1].name, names[u].name))
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "duplicate dataset name")
+
+    /* Check that none of the names in the group is taken, before creating
+     * anything
+     */
+    for(u = 0; u < count; u++)
+        if(H5D_CREATE_MULTI_LOCAL_NAME(names[u].name)) {
+            htri_t exists;              /* Whether the name is taken */
+
+            if((exists = H5G_obj_link_exists(loc->oloc, names[u].name, dxpl_id)) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check if name exists")
+            if(exists)
+                HGOTO_ERROR(H5E_DATASET, H5E_EXISTS, FAIL, "name already exists")
+        } /* end if */
+
+    u = 0;
+    while(u < count) {
+        if(use_tmpl && H5D_CREATE_MULTI_LOCAL_NAME(names[u].name)) {
+            size_t nclones = 1;         /* # of datasets to create from the template */
+
+            /* Gather a batch of datasets in the group */
+            while(nclones < H5D_CREATE_MULTI_BATCH && (u + nclones) < count
+                    && H5D_CREATE_MULTI_LOCAL_NAME(names[u + nclones].name))
+                nclones++;
+
+            /* Create the datasets from the template */
+            if(H5D__create_clones(loc, &tmpl, &names[u], nclones, cset, dapl_id, dxpl_id, dset) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to create datasets")
+            u += nclones;
+        } /* end if */
+        else {
+            H5D_t *new_dset;            /* New dataset */
+
+            /* Create the dataset */
+            if(NULL == (new_dset = H5D__create_named(loc, names[u].name, type_id, space, lcpl_id, dcpl_id, dapl_id, dxpl_id)))
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to create dataset")
+            if(dset)
+                dset[names[u].idx] = new_dset;
+
+            /* Use the first dataset in the group as the template for the rest */
+            if(NULL == tmpl.dset && H5D_CREATE_MULTI_LOCAL_NAME(names[u].name)) {
+                if((use_tmpl = H5D__multi_tmpl_init(&tmpl, new_dset, dxpl_id)) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up template from dataset")
+            } /* end if */
+            else if(NULL == dset && H5D_close(new_dset) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "unable to release dataset")
+            u++;
+        } /* end else */
+    } /* end while */
+
+done:
+    /* Release the template */
+    if(tmpl.dset && NULL == dset && H5D_close(tmpl.dset) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "unable to release dataset")
+    H5D__multi_tmpl_reset(&tmpl);
+
+    /* Close the datasets opened, on failure */
+    if(ret_value < 0 && dset)
+        for(u = 0; u < count; u++)
+            if(dset[u]) {
+                if(H5D_close(dset[u]) < 0)
+                    HDONE_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "unable to release dataset")
+                dset[u] = NULL;
+            } /* end if */
+
+    H5MM_xfree(names);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__create_multi() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__get_space_status
@@ -1025,10 +1548,6 @@ H5D__create(H5F_t *file, hid_t type_id, const H5S_t *space, hid_t dcpl_id,
         if(layout->type == H5D_COMPACT && fill->alloc_time != H5D_ALLOC_TIME_EARLY)
             HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, NULL, "compact dataset must have early space allocation")
 
-        /* If MPI VFD is used, no filter support yet. */
-        if(H5F_HAS_FEATURE(file, H5FD_FEAT_HAS_MPI) && pline->nused > 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, NULL, "Parallel I/O does not support filters yet")
-
         /* Get the dataset's external file list information */
         if(H5P_get(dc_plist, H5D_CRT_EXT_FILE_LIST_NAME, &new_dset->shared->dcpl_cache.efl) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't retrieve external file list")
@@ -1958,6 +2477,10 @@ H5D__iterate(void *buf, hid_t type_id, const H5S_t *space, H5D_operator_t op,
  *      dataspace.  The dataset transfer property list is required to find the
  *      correct allocation/free methods for the VL data in the buffer.
  *
+ *      If the property list has a VL data arena, all the VL data allocated
+ *      from the arena is freed at once instead, without iterating over the
+ *      buffer.
+ *
  * Return:	Non-negative on success, negative on failure
  *
  * Programmer:	Quincey Koziol
@@ -1984,8 +2507,12 @@ H5D_vlen_reclaim(hid_t type_id, H5S_t *space, hid_t plist_id, void *buf)
     if(H5T_vlen_get_alloc_info(plist_id,&vl_alloc_info) < 0)
         HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to retrieve VL allocation info")
 
-    /* Call H5D__iterate with args, etc. */
-    ret_value = H5D__iterate(buf, type_id, space ,H5T_vlen_reclaim, vl_alloc_info);
+    /* Release the whole arena, if the VL data was allocated from one */
+    if(vl_alloc_info->arena)
+        ret_value = H5T_vlen_arena_reset(vl_alloc_info->arena);
+    else
+        /* Call H5D__iterate with args, etc. */
+        ret_value = H5D__iterate(buf, type_id, space ,H5T_vlen_reclaim, vl_alloc_info);
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -26,6 +26,7 @@
 #include "H5private.h"		/* Generic Functions			*/
 #include "H5Dpkg.h"		/* Dataset functions			*/
 #include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5FDprivate.h"	/* File drivers				*/
 #include "H5FLprivate.h"	/* Free Lists                           */
 #include "H5Iprivate.h"		/* IDs			  		*/
 #include "H5MMprivate.h"        /* Memory management                    */
@@ -46,6 +47,22 @@
 /* Local Typedefs */
 /******************/
 
+/* A piece of a multi-dataset transfer: one range in the file, and the
+ * memory it is transferred to or from */
+typedef struct H5D_multi_piece_t {
+    haddr_t     addr;           /* File address of the piece */
+    size_t      len;            /* Length of the piece, in bytes */
+    uint8_t     *buf;           /* Memory for the piece */
+    size_t      order;          /* Order the piece was added in */
+} H5D_multi_piece_t;
+
+/* The pieces of a multi-dataset transfer */
+typedef struct H5D_multi_list_t {
+    size_t      npieces;        /* Number of pieces */
+    size_t      nalloc;         /* Number of pieces allocated */
+    H5D_multi_piece_t *pieces;  /* Array of pieces */
+} H5D_multi_list_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -55,8 +72,31 @@
 static herr_t H5D__write(H5D_t *dataset, hid_t mem_type_id,
     const H5S_t *mem_space, const H5S_t *file_space, hid_t dset_xfer_plist,
     const void *buf);
-static herr_t H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id, 
-    const H5S_t *mem_space, const H5S_t *file_space, hid_t dxpl_id, const void *buf);
+static herr_t H5D__write_alloc(H5D_t *dataset, hsize_t nelmts,
+    const H5S_t *file_space, hid_t dxpl_id);
+
+/* Multi-dataset I/O routines */
+static herr_t H5D__multi_args(size_t count, const hid_t dset_id[],
+    const hid_t mem_space_id[], const hid_t file_space_id[], H5D_t ***dsets,
+    const H5S_t ***mem_spaces, const H5S_t ***file_spaces);
+static herr_t H5D__multi_io(size_t count, H5D_t *dsets[],
+    const hid_t mem_type_id[], const H5S_t *mem_spaces[],
+    const H5S_t *file_spaces[], hid_t dxpl_id, void *bufs[], hbool_t do_write);
+static htri_t H5D__multi_can_merge(H5D_t *dset, hid_t mem_type_id,
+    const H5S_t *mem_space, const H5S_t *file_space, const void *buf,
+    const H5D_dxpl_cache_t *dxpl_cache, hid_t dxpl_id, hbool_t do_write,
+    size_t *elmt_size);
+static herr_t H5D__multi_add_pieces(H5D_t *dset, const H5S_t *mem_space,
+    const H5S_t *file_space, size_t elmt_size, void *buf, hid_t dxpl_id,
+    hbool_t do_write, H5D_multi_list_t *list);
+static herr_t H5D__multi_piece_io(H5F_t *f, H5D_multi_list_t *list,
+    const H5D_dxpl_cache_t *dxpl_cache, hid_t dxpl_id, hbool_t do_write);
+static int H5D__multi_cmp_addr(const void *_p1, const void *_p2);
+static int H5D__multi_cmp_order(const void *_p1, const void *_p2);
+#ifdef H5_HAVE_PARALLEL
+static herr_t H5D__multi_coll_io(H5F_t *f, const H5D_multi_list_t *list,
+    hid_t dxpl_id, hbool_t do_write);
+#endif /* H5_HAVE_PARALLEL */
 
 /* Setup/teardown routines */
 static herr_t H5D__ioinfo_init(H5D_t *dset,
@@ -168,6 +208,10 @@ H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
         if(TRUE != H5P_isa_class(plist_id, H5P_DATASET_XFER))
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
 
+    /* Complete the asynchronous requests made on the file before this read */
+    if(H5D_request_drain(dset->oloc.file) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't complete asynchronous requests")
+
     /* read raw data */
     if(H5D__read(dset, mem_type_id, mem_space, file_space, plist_id, buf/*out*/) < 0)
 	HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
@@ -267,6 +311,10 @@ H5Dwrite(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 	} /* end if */
     }
 
+    /* Complete the asynchronous requests made on the file before this write */
+    if(H5D_request_drain(dset->oloc.file) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't complete asynchronous requests")
+
     if(H5D__pre_write(dset, direct_write, mem_type_id, mem_space, file_space, dxpl_id, buf) < 0) 
 	HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't prepare for writing data")
 
@@ -274,6 +322,164 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Dwrite() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dread_multi
+ *
+ * Purpose:	Reads (part of) COUNT datasets into application memory with
+ *		one call.  Element I of the DSET_ID, MEM_TYPE_ID,
+ *		MEM_SPACE_ID, FILE_SPACE_ID and BUF arrays describe one read,
+ *		with the same meaning as the arguments of H5Dread().  All
+ *		the reads use the transfer properties in PLIST_ID.
+ *
+ *		Reads from contiguous datasets in the file of the first
+ *		dataset which need no datatype conversion or data transform
+ *		are combined: their pieces are sorted by file address and
+ *		adjacent pieces are read together.  With the MPI-IO driver
+ *		and collective transfers, they are all read with a single
+ *		collective operation, so every process must pass the same
+ *		datasets in the same order.  The other datasets are read one
+ *		at a time, as H5Dread() does.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dread_multi(size_t count, const hid_t dset_id[], const hid_t mem_type_id[],
+    const hid_t mem_space_id[], const hid_t file_space_id[], hid_t plist_id,
+    void *buf[]/*out*/)
+{
+    H5D_t **dsets = NULL;               /* Datasets */
+    const H5S_t **mem_spaces = NULL;    /* Memory dataspaces */
+    const H5S_t **file_spaces = NULL;   /* File dataspaces */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "z*i*i*i*iix", count, dset_id, mem_type_id, mem_space_id,
+             file_space_id, plist_id, buf);
+
+    /* check arguments */
+    if(count == 0)
+        HGOTO_DONE(SUCCEED)
+    if(!dset_id || !mem_type_id || !mem_space_id || !file_space_id)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no ID array")
+    if(!buf)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no buffer array")
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == plist_id)
+        plist_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(plist_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
+
+    /* Look up the datasets and dataspaces */
+    if(H5D__multi_args(count, dset_id, mem_space_id, file_space_id, &dsets, &mem_spaces, &file_spaces) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid dataset or dataspace")
+
+    /* Complete the asynchronous requests made on the files before this read */
+    for(u = 0; u < count; u++)
+        if(H5D_request_drain(dsets[u]->oloc.file) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't complete asynchronous requests")
+
+    /* read raw data */
+    if(H5D__multi_io(count, dsets, mem_type_id, mem_spaces, file_spaces, plist_id, buf, FALSE) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+
+done:
+    H5MM_xfree(dsets);
+    H5MM_xfree(mem_spaces);
+    H5MM_xfree(file_spaces);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dread_multi() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dwrite_multi
+ *
+ * Purpose:	Writes (part of) COUNT datasets from application memory
+ *		with one call.  Element I of the DSET_ID, MEM_TYPE_ID,
+ *		MEM_SPACE_ID, FILE_SPACE_ID and BUF arrays describe one
+ *		write, with the same meaning as the arguments of H5Dwrite().
+ *		All the writes use the transfer properties in DXPL_ID, which
+ *		can't request direct chunk writes.
+ *
+ *		Writes are combined as H5Dread_multi() combines reads.  When
+ *		the same dataset elements are written more than once in a
+ *		call, the writes take effect in array order, so the last
+ *		one wins.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dwrite_multi(size_t count, const hid_t dset_id[], const hid_t mem_type_id[],
+    const hid_t mem_space_id[], const hid_t file_space_id[], hid_t dxpl_id,
+    const void *buf[])
+{
+    H5D_t **dsets = NULL;               /* Datasets */
+    const H5S_t **mem_spaces = NULL;    /* Memory dataspaces */
+    const H5S_t **file_spaces = NULL;   /* File dataspaces */
+    H5P_genplist_t *plist;              /* Property list pointer */
+    hbool_t direct_write = FALSE;       /* Whether direct chunk writes were requested */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "z*i*i*i*ii**x", count, dset_id, mem_type_id, mem_space_id,
+             file_space_id, dxpl_id, buf);
+
+    /* check arguments */
+    if(count == 0)
+        HGOTO_DONE(SUCCEED)
+    if(!dset_id || !mem_type_id || !mem_space_id || !file_space_id)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no ID array")
+    if(!buf)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no buffer array")
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
+
+    /* Direct chunk writes name a single chunk, so they can't be combined */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
+    if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &direct_write) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting flag for direct chunk write")
+    if(direct_write)
+        HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "direct chunk writes not supported for multiple datasets")
+
+    /* Look up the datasets and dataspaces */
+    if(H5D__multi_args(count, dset_id, mem_space_id, file_space_id, &dsets, &mem_spaces, &file_spaces) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid dataset or dataspace")
+
+    /* Complete the asynchronous requests made on the files before this write */
+    for(u = 0; u < count; u++)
+        if(H5D_request_drain(dsets[u]->oloc.file) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't complete asynchronous requests")
+
+    /* write raw data; the buffers are only read from, so casting away
+     * const is OK */
+H5_GCC_DIAG_OFF(cast-qual)
+    if(H5D__multi_io(count, dsets, mem_type_id, mem_spaces, file_spaces, dxpl_id, (void **)buf, TRUE) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write data")
+H5_GCC_DIAG_ON(cast-qual)
+
+done:
+    H5MM_xfree(dsets);
+    H5MM_xfree(mem_spaces);
+    H5MM_xfree(file_spaces);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dwrite_multi() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__pre_write
@@ -287,14 +493,14 @@ done:
  *
  *-------------------------------------------------------------------------
  */
-static herr_t
+herr_t
 H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id, 
          const H5S_t *mem_space, const H5S_t *file_space, 
          hid_t dxpl_id, const void *buf)
 {
     herr_t                  ret_value = SUCCEED;  /* Return value */
 
-    FUNC_ENTER_STATIC
+    FUNC_ENTER_PACKAGE
 
     /* Direct chunk write */
     if(direct_write) {
@@ -664,10 +870,11 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
                 H5T_get_ref_type(type_info.mem_type) == H5R_DATASET_REGION)
             HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "Parallel IO does not support writing region reference datatypes yet")
 
-        /* Can't write to chunked datasets with filters, in parallel */
+        /* Chunked datasets with filters can only be written collectively, in parallel */
         if(dataset->shared->layout.type == H5D_CHUNKED &&
-                dataset->shared->dcpl_cache.pline.nused > 0)
-            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot write to chunked storage with filters in parallel")
+                dataset->shared->dcpl_cache.pline.nused > 0 &&
+                dxpl_cache->xfer_mode != H5FD_MPIO_COLLECTIVE)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot write to chunked storage with filters in parallel without collective I/O")
     } /* end if */
     else {
         /* Collective access is not permissible without a MPI based VFD */
@@ -743,25 +950,8 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
     /* <none needed currently> */
 
     /* Allocate data space and initialize it if it hasn't been. */
-    if(nelmts > 0 && dataset->shared->dcpl_cache.efl.nused == 0 &&
-            !(*dataset->shared->layout.ops->is_space_alloc)(&dataset->shared->layout.storage)) {
-        hssize_t file_nelmts;   /* Number of elements in file dataset's dataspace */
-        hbool_t full_overwrite; /* Whether we are over-writing all the elements */
-
-        /* Get the number of elements in file dataset's dataspace */
-        if((file_nelmts = H5S_GET_EXTENT_NPOINTS(file_space)) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "can't retrieve number of elements in file dataset")
-
-        /* Always allow fill values to be written if the dataset has a VL datatype */
-        if(H5T_detect_class(dataset->shared->type, H5T_VLEN, FALSE))
-            full_overwrite = FALSE;
-        else
-            full_overwrite = (hbool_t)((hsize_t)file_nelmts == nelmts ? TRUE : FALSE);
-
- 	/* Allocate storage */
-        if(H5D__alloc_storage(dataset, dxpl_id, H5D_ALLOC_WRITE, full_overwrite, NULL) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize storage")
-    } /* end if */
+    if(H5D__write_alloc(dataset, nelmts, file_space, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize storage")
 
     /* Set up I/O operation */
     io_info.op_type = H5D_IO_OP_WRITE;
@@ -827,6 +1017,769 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
 } /* end H5D__write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__write_alloc
+ *
+ * Purpose:	Allocates and initializes the storage of a dataset about to
+ *		have NELMTS elements of FILE_SPACE written, if it hasn't been
+ *		allocated yet.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__write_alloc(H5D_t *dataset, hsize_t nelmts, const H5S_t *file_space,
+    hid_t dxpl_id)
+{
+    herr_t	ret_value = SUCCEED;	/* Return value	*/
+
+    FUNC_ENTER_STATIC_TAG(dxpl_id, dataset->oloc.addr, FAIL)
+
+    if(nelmts > 0 && dataset->shared->dcpl_cache.efl.nused == 0 &&
+            !(*dataset->shared->layout.ops->is_space_alloc)(&dataset->shared->layout.storage)) {
+        hssize_t file_nelmts;   /* Number of elements in file dataset's dataspace */
+        hbool_t full_overwrite; /* Whether we are over-writing all the elements */
+
+        /* Get the number of elements in file dataset's dataspace */
+        if((file_nelmts = H5S_GET_EXTENT_NPOINTS(file_space)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "can't retrieve number of elements in file dataset")
+
+        /* Always allow fill values to be written if the dataset has a VL datatype */
+        if(H5T_detect_class(dataset->shared->type, H5T_VLEN, FALSE))
+            full_overwrite = FALSE;
+        else
+            full_overwrite = (hbool_t)((hsize_t)file_nelmts == nelmts ? TRUE : FALSE);
+
+ 	/* Allocate storage */
+        if(H5D__alloc_storage(dataset, dxpl_id, H5D_ALLOC_WRITE, full_overwrite, NULL) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize storage")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__write_alloc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_args
+ *
+ * Purpose:	Looks up and checks the datasets and dataspaces of a
+ *		multi-dataset transfer.  The arrays returned in DSETS,
+ *		MEM_SPACES and FILE_SPACES must be freed by the caller;
+ *		dataspaces given as H5S_ALL are returned as NULL.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__multi_args(size_t count, const hid_t dset_id[], const hid_t mem_space_id[],
+    const hid_t file_space_id[], H5D_t ***dsets, const H5S_t ***mem_spaces,
+    const H5S_t ***file_spaces)
+{
+    size_t      u;                      /* Local index variable */
+    herr_t	ret_value = SUCCEED;	/* Return value	*/
+
+    FUNC_ENTER_STATIC
+
+    if(NULL == (*dsets = (H5D_t **)H5MM_calloc(count * sizeof(H5D_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate dataset array")
+    if(NULL == (*mem_spaces = (const H5S_t **)H5MM_calloc(count * sizeof(H5S_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate dataspace array")
+    if(NULL == (*file_spaces = (const H5S_t **)H5MM_calloc(count * sizeof(H5S_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate dataspace array")
+
+    for(u = 0; u < count; u++) {
+        if(NULL == ((*dsets)[u] = (H5D_t *)H5I_object_verify(dset_id[u], H5I_DATASET)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+        if(NULL == (*dsets)[u]->oloc.file)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+
+        if(mem_space_id[u] < 0 || file_space_id[u] < 0)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+        if(H5S_ALL != mem_space_id[u]) {
+            if(NULL == ((*mem_spaces)[u] = (const H5S_t *)H5I_object_verify(mem_space_id[u], H5I_DATASPACE)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+            /* Check for valid selection */
+            if(H5S_SELECT_VALID((*mem_spaces)[u]) != TRUE)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "memory selection+offset not within extent")
+        } /* end if */
+        if(H5S_ALL != file_space_id[u]) {
+            if(NULL == ((*file_spaces)[u] = (const H5S_t *)H5I_object_verify(file_space_id[u], H5I_DATASPACE)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+            /* Check for valid selection */
+            if(H5S_SELECT_VALID((*file_spaces)[u]) != TRUE)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "file selection+offset not within extent")
+        } /* end if */
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_args() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_io
+ *
+ * Purpose:	Reads or writes several datasets.  Datasets which
+ *		H5D__multi_can_merge() accepts are transferred together by
+ *		H5D__multi_piece_io(); the others go through H5D__read() or
+ *		H5D__write() one at a time.
+ *
+ *		For collective transfers with the MPI-IO driver, the
+ *		processes agree on which datasets are combined, so they all
+ *		make the same collective calls.
+ *
+ *		The transfers of a dataset are either all combined or all
+ *		done one at a time, so that writes to the same elements
+ *		take effect in array order.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__multi_io(size_t count, H5D_t *dsets[], const hid_t mem_type_id[],
+    const H5S_t *mem_spaces[], const H5S_t *file_spaces[], hid_t dxpl_id,
+    void *bufs[], hbool_t do_write)
+{
+    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    H5F_t       *f;                     /* File of the combined transfer */
+    int         *merge = NULL;          /* Whether each dataset is combined */
+    size_t      *elmt_sizes = NULL;     /* Element size of each combined dataset */
+    hbool_t     any_merged = FALSE;     /* Whether any dataset is combined */
+    H5D_multi_list_t list;              /* Pieces of the combined transfer */
+    size_t      u;                      /* Local index variable */
+    herr_t	ret_value = SUCCEED;	/* Return value	*/
+
+    FUNC_ENTER_STATIC
+
+    HDassert(count > 0);
+    HDmemset(&list, 0, sizeof(list));
+
+    /* Fill the DXPL cache values for later use */
+    if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+
+    if(NULL == (merge = (int *)H5MM_calloc(count * sizeof(int))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate dataset flags")
+    if(NULL == (elmt_sizes = (size_t *)H5MM_calloc(count * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate element sizes")
+
+    /* Only datasets in the first dataset's file are combined */
+    f = dsets[0]->oloc.file;
+    for(u = 0; u < count; u++)
+        if(H5F_SAME_SHARED(dsets[u]->oloc.file, f)) {
+            htri_t can_merge;           /* Whether the dataset can be combined */
+
+            if((can_merge = H5D__multi_can_merge(dsets[u], mem_type_id[u], mem_spaces[u], file_spaces[u], bufs[u], dxpl_cache, dxpl_id, do_write, &elmt_sizes[u])) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't check dataset")
+            merge[u] = (int)can_merge;
+        } /* end if */
+
+#ifdef H5_HAVE_PARALLEL
+    /* Combine a dataset only if every process can */
+    if(dxpl_cache->xfer_mode == H5FD_MPIO_COLLECTIVE && IS_H5FD_MPIO(f)) {
+        MPI_Comm comm;                  /* File's communicator */
+        int mpi_code;                   /* MPI return code */
+
+        if(MPI_COMM_NULL == (comm = H5F_mpi_get_comm(f)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't retrieve MPI communicator")
+        H5_CHECK_OVERFLOW(count, size_t, int);
+        if(MPI_SUCCESS != (mpi_code = MPI_Allreduce(MPI_IN_PLACE, merge, (int)count, MPI_INT, MPI_LAND, comm)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Allreduce failed", mpi_code)
+    } /* end if */
+#endif /* H5_HAVE_PARALLEL */
+
+    /* Combine a dataset named more than once only if all its transfers
+     * can be combined.  The combined transfer keeps the order of its
+     * pieces where they overlap, and the other transfers are done in
+     * array order, so overlapping writes to a dataset then always take
+     * effect in array order.
+     */
+    for(u = 0; u < count; u++)
+        if(!merge[u]) {
+            size_t v;                   /* Local index variable */
+
+            for(v = 0; v < count; v++)
+                if(merge[v] && dsets[v]->shared == dsets[u]->shared)
+                    merge[v] = 0;
+        } /* end if */
+
+    /* Collect the pieces of the combined transfer */
+    for(u = 0; u < count; u++)
+        if(merge[u]) {
+            if(H5D__multi_add_pieces(dsets[u], mem_spaces[u], file_spaces[u], elmt_sizes[u], bufs[u], dxpl_id, do_write, &list) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't set up combined transfer")
+            any_merged = TRUE;
+        } /* end if */
+
+    /* Transfer them */
+    if(any_merged)
+        if(H5D__multi_piece_io(f, &list, dxpl_cache, dxpl_id, do_write) < 0)
+            HGOTO_ERROR(H5E_DATASET, (do_write ? H5E_WRITEERROR : H5E_READERROR), FAIL, "combined transfer failed")
+
+    /* Transfer the other datasets one at a time */
+    for(u = 0; u < count; u++)
+        if(!merge[u]) {
+            if(do_write) {
+                if(H5D__write(dsets[u], mem_type_id[u], mem_spaces[u], file_spaces[u], dxpl_id, bufs[u]) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write data")
+            } /* end if */
+            else {
+                if(H5D__read(dsets[u], mem_type_id[u], mem_spaces[u], file_spaces[u], dxpl_id, bufs[u]) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+            } /* end else */
+        } /* end if */
+
+done:
+    H5MM_xfree(merge);
+    H5MM_xfree(elmt_sizes);
+    H5MM_xfree(list.pieces);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_can_merge
+ *
+ * Purpose:	Checks whether the transfer for one dataset can be part of
+ *		a combined transfer: the dataset must be stored contiguously
+ *		in the file, no datatype conversion or data transform may be
+ *		needed and neither selection may be a point selection, whose
+ *		elements can repeat.  Data is only read from storage which
+ *		has been allocated, as unallocated storage reads as fill
+ *		values.  Transfers which would fail are left to H5D__read()
+ *		and H5D__write(), to report the error.
+ *
+ *		The size of the dataset's elements is returned in ELMT_SIZE.
+ *
+ * Return:	TRUE/FALSE/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__multi_can_merge(H5D_t *dset, hid_t mem_type_id, const H5S_t *mem_space,
+    const H5S_t *file_space, const void *buf, const H5D_dxpl_cache_t *dxpl_cache,
+    hid_t dxpl_id, hbool_t do_write, size_t *elmt_size)
+{
+    H5D_type_info_t type_info;          /* Datatype info for operation */
+    hbool_t type_info_init = FALSE;     /* Whether the datatype info has been initialized */
+    hssize_t snelmts;                   /* Number of elements selected */
+    htri_t ret_value = FALSE;           /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check the storage */
+    if(dset->shared->layout.type != H5D_CONTIGUOUS || dset->shared->dcpl_cache.efl.nused > 0)
+        HGOTO_DONE(FALSE)
+    if(!do_write && !(*dset->shared->layout.ops->is_space_alloc)(&dset->shared->layout.storage))
+        HGOTO_DONE(FALSE)
+    if(do_write && 0 == (H5F_INTENT(dset->oloc.file) & H5F_ACC_RDWR))
+        HGOTO_DONE(FALSE)
+
+    /* Check the selections */
+    if(!file_space)
+        file_space = dset->shared->space;
+    if(!mem_space)
+        mem_space = file_space;
+    if(!H5S_has_extent(file_space) || !H5S_has_extent(mem_space))
+        HGOTO_DONE(FALSE)
+    if(H5S_GET_SELECT_TYPE(file_space) == H5S_SEL_POINTS || H5S_GET_SELECT_TYPE(mem_space) == H5S_SEL_POINTS)
+        HGOTO_DONE(FALSE)
+    if((snelmts = H5S_GET_SELECT_NPOINTS(mem_space)) < 0 || snelmts != H5S_GET_SELECT_NPOINTS(file_space))
+        HGOTO_DONE(FALSE)
+    if(NULL == buf && snelmts > 0)
+        HGOTO_DONE(FALSE)
+
+    /* Check the datatypes */
+    if(H5D__typeinfo_init(dset, dxpl_cache, dxpl_id, mem_type_id, do_write, &type_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up type info")
+    type_info_init = TRUE;
+    if(!type_info.is_conv_noop || !type_info.is_xform_noop)
+        HGOTO_DONE(FALSE)
+    *elmt_size = type_info.src_type_size;
+
+    ret_value = TRUE;
+
+done:
+    if(type_info_init && H5D__typeinfo_term(&type_info) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "unable to shut down type info")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_can_merge() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_add_pieces
+ *
+ * Purpose:	Adds the file ranges and matching memory of one dataset's
+ *		transfer to LIST.  Storage is allocated first for writes,
+ *		and the dataset's sieve buffer is flushed (and, for writes,
+ *		emptied) since the transfer bypasses it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__multi_add_pieces(H5D_t *dset, const H5S_t *mem_space,
+    const H5S_t *file_space, size_t elmt_size, void *buf, hid_t dxpl_id,
+    hbool_t do_write, H5D_multi_list_t *list)
+{
+    H5O_storage_contig_t *contig = &dset->shared->layout.storage.u.contig;  /* Contiguous storage */
+    H5S_sel_iter_t mem_iter;            /* Memory selection iteration info */
+    hbool_t mem_iter_init = FALSE;      /* Memory selection iteration info has been initialized */
+    H5S_sel_iter_t file_iter;           /* File selection iteration info */
+    hbool_t file_iter_init = FALSE;     /* File selection iteration info has been initialized */
+    hsize_t mem_off[H5D_IO_VECTOR_SIZE];        /* Sequence offsets in memory */
+    size_t mem_len[H5D_IO_VECTOR_SIZE];         /* Sequence lengths in memory */
+    hsize_t file_off[H5D_IO_VECTOR_SIZE];       /* Sequence offsets in the file */
+    size_t file_len[H5D_IO_VECTOR_SIZE];        /* Sequence lengths in the file */
+    size_t mem_nseq = 0, file_nseq = 0;         /* Number of sequences */
+    size_t curr_mem_seq = 0, curr_file_seq = 0; /* Current sequences */
+    size_t nelem;                       /* Number of elements in sequences */
+    hsize_t nelmts;                     /* Number of elements selected */
+    hssize_t snelmts;                   /* Number of elements selected (signed) */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(!file_space)
+        file_space = dset->shared->space;
+    if(!mem_space)
+        mem_space = file_space;
+    if((snelmts = H5S_GET_SELECT_NPOINTS(mem_space)) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "dataspace has invalid selection")
+    H5_ASSIGN_OVERFLOW(nelmts, snelmts, hssize_t, hsize_t);
+
+    /* Make the dataset's storage ready */
+    if(do_write && H5D__write_alloc(dset, nelmts, file_space, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize storage")
+    if(H5D__flush_sieve_buf(dset, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush sieve buffer")
+    if(do_write) {
+        dset->shared->cache.contig.sieve_loc = HADDR_UNDEF;
+        dset->shared->cache.contig.sieve_size = 0;
+    } /* end if */
+
+    if(nelmts == 0)
+        HGOTO_DONE(SUCCEED)
+
+    /* Initialize the selection iterators */
+    if(H5S_select_iter_init(&file_iter, file_space, elmt_size) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    file_iter_init = TRUE;
+    if(H5S_select_iter_init(&mem_iter, mem_space, elmt_size) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    mem_iter_init = TRUE;
+
+    /* Match up the file and memory sequences */
+    while(curr_file_seq < file_nseq || nelmts > 0) {
+        size_t len;                     /* Length of the next piece */
+
+        /* Get more sequences as needed */
+        if(curr_file_seq >= file_nseq) {
+            if(H5S_SELECT_GET_SEQ_LIST(file_space, H5S_GET_SEQ_LIST_SORTED, &file_iter, (size_t)H5D_IO_VECTOR_SIZE, (size_t)nelmts, &file_nseq, &nelem, file_off, file_len) < 0)
+                HGOTO_ERROR(H5E_INTERNAL, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+            curr_file_seq = 0;
+            nelmts -= nelem;
+        } /* end if */
+        if(curr_mem_seq >= mem_nseq) {
+            if(H5S_SELECT_GET_SEQ_LIST(mem_space, 0, &mem_iter, (size_t)H5D_IO_VECTOR_SIZE, (size_t)-1, &mem_nseq, &nelem, mem_off, mem_len) < 0)
+                HGOTO_ERROR(H5E_INTERNAL, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+            curr_mem_seq = 0;
+        } /* end if */
+        HDassert(curr_file_seq < file_nseq && curr_mem_seq < mem_nseq);
+
+        /* Add a piece for the overlap of the current sequences */
+        len = MIN(file_len[curr_file_seq], mem_len[curr_mem_seq]);
+        if(list->npieces > 0 &&
+                H5F_addr_eq(list->pieces[list->npieces - 1].addr + list->pieces[list->npieces - 1].len, contig->addr + file_off[curr_file_seq]) &&
+                list->pieces[list->npieces - 1].buf + list->pieces[list->npieces - 1].len == (uint8_t *)buf + mem_off[curr_mem_seq])
+            /* Extend the last piece */
+            list->pieces[list->npieces - 1].len += len;
+        else {
+            H5D_multi_piece_t *piece;   /* New piece */
+
+            if(list->npieces == list->nalloc) {
+                size_t new_alloc = MAX(2 * list->nalloc, H5D_IO_VECTOR_SIZE);
+                H5D_multi_piece_t *new_pieces;
+
+                if(NULL == (new_pieces = (H5D_multi_piece_t *)H5MM_realloc(list->pieces, new_alloc * sizeof(H5D_multi_piece_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate transfer pieces")
+                list->pieces = new_pieces;
+                list->nalloc = new_alloc;
+            } /* end if */
+            piece = &list->pieces[list->npieces];
+            piece->addr = contig->addr + file_off[curr_file_seq];
+            piece->len = len;
+            piece->buf = (uint8_t *)buf + mem_off[curr_mem_seq];
+            piece->order = list->npieces;
+            list->npieces++;
+        } /* end else */
+
+        /* Advance through the sequences */
+        file_off[curr_file_seq] += len;
+        if(0 == (file_len[curr_file_seq] -= len))
+            curr_file_seq++;
+        mem_off[curr_mem_seq] += len;
+        if(0 == (mem_len[curr_mem_seq] -= len))
+            curr_mem_seq++;
+    } /* end while */
+
+done:
+    if(file_iter_init && H5S_SELECT_ITER_RELEASE(&file_iter) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "unable to release selection iterator")
+    if(mem_iter_init && H5S_SELECT_ITER_RELEASE(&mem_iter) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "unable to release selection iterator")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_add_pieces() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_cmp_addr
+ *
+ * Purpose:	Compares the file addresses of two transfer pieces, for
+ *		sorting with HDqsort().  Pieces at the same address are
+ *		kept in the order they were added.
+ *
+ * Return:	-1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__multi_cmp_addr(const void *_p1, const void *_p2)
+{
+    const H5D_multi_piece_t *p1 = (const H5D_multi_piece_t *)_p1;
+    const H5D_multi_piece_t *p2 = (const H5D_multi_piece_t *)_p2;
+    int ret_value;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(0 == (ret_value = H5F_addr_cmp(p1->addr, p2->addr)))
+        ret_value = (p1->order > p2->order) - (p1->order < p2->order);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_cmp_addr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_cmp_order
+ *
+ * Purpose:	Compares the order two transfer pieces were added in, for
+ *		sorting with HDqsort().
+ *
+ * Return:	-1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__multi_cmp_order(const void *_p1, const void *_p2)
+{
+    const H5D_multi_piece_t *p1 = (const H5D_multi_piece_t *)_p1;
+    const H5D_multi_piece_t *p2 = (const H5D_multi_piece_t *)_p2;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    FUNC_LEAVE_NOAPI((p1->order > p2->order) - (p1->order < p2->order))
+} /* end H5D__multi_cmp_order() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_piece_io
+ *
+ * Purpose:	Transfers the pieces of a combined transfer, in file
+ *		address order.
+ *
+ *		Runs of pieces adjacent in the file are transferred with a
+ *		single I/O call, staged through a buffer of up to the
+ *		transfer's maximum temporary buffer size.  With collective
+ *		MPI-IO transfers, all the pieces are transferred with one
+ *		collective call instead.
+ *
+ *		If the same file range appears more than once, the pieces
+ *		are transferred one at a time, in the order they were added,
+ *		so that the last write wins.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__multi_piece_io(H5F_t *f, H5D_multi_list_t *list,
+    const H5D_dxpl_cache_t *dxpl_cache, hid_t dxpl_id, hbool_t do_write)
+{
+    H5D_multi_piece_t *pieces = list->pieces;   /* Pieces to transfer */
+    uint8_t *tbuf = NULL;               /* Staging buffer */
+    size_t tbuf_size;                   /* Size of staging buffer */
+    hbool_t overlap = FALSE;            /* Whether any pieces overlap */
+#ifdef H5_HAVE_PARALLEL
+    H5P_genplist_t *dx_plist = NULL;    /* Data transfer property list */
+    H5FD_mpio_xfer_t xfer_mode = H5FD_MPIO_COLLECTIVE;  /* Original transfer mode */
+    H5FD_mpio_xfer_t indep_mode = H5FD_MPIO_INDEPENDENT; /* Transfer mode for overlapping pieces */
+    hbool_t xfer_mode_set = FALSE;      /* Whether the transfer mode was changed */
+    hbool_t coll = FALSE;               /* Whether to use one collective transfer */
+#endif /* H5_HAVE_PARALLEL */
+    size_t u, v;                        /* Local index variables */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(f);
+    HDassert(list);
+
+    /* Sort the pieces by file address and check for overlaps */
+    if(list->npieces > 1) {
+        HDqsort(pieces, list->npieces, sizeof(H5D_multi_piece_t), H5D__multi_cmp_addr);
+        for(u = 1; u < list->npieces; u++)
+            if(H5F_addr_lt(pieces[u].addr, pieces[u - 1].addr + pieces[u - 1].len)) {
+                overlap = TRUE;
+                break;
+            } /* end if */
+    } /* end if */
+
+#ifdef H5_HAVE_PARALLEL
+    coll = (hbool_t)(dxpl_cache->xfer_mode == H5FD_MPIO_COLLECTIVE && IS_H5FD_MPIO(f));
+#endif /* H5_HAVE_PARALLEL */
+
+    if(overlap) {
+        /* Transfer the pieces in the order they were added */
+        HDqsort(pieces, list->npieces, sizeof(H5D_multi_piece_t), H5D__multi_cmp_order);
+
+#ifdef H5_HAVE_PARALLEL
+        /* Without joining in any other process's collective calls */
+        if(coll) {
+            if(NULL == (dx_plist = (H5P_genplist_t *)H5I_object(dxpl_id)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data transfer property list")
+            if(H5P_set(dx_plist, H5D_XFER_IO_XFER_MODE_NAME, &indep_mode) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set transfer mode")
+            xfer_mode_set = TRUE;
+        } /* end if */
+#endif /* H5_HAVE_PARALLEL */
+
+        for(u = 0; u < list->npieces; u++) {
+            if(do_write) {
+                if(H5F_block_write(f, H5FD_MEM_DRAW, pieces[u].addr, pieces[u].len, dxpl_id, pieces[u].buf) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "block write failed")
+            } /* end if */
+            else {
+                if(H5F_block_read(f, H5FD_MEM_DRAW, pieces[u].addr, pieces[u].len, dxpl_id, pieces[u].buf) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "block read failed")
+            } /* end else */
+        } /* end for */
+
+#ifdef H5_HAVE_PARALLEL
+        /* Still take part in the collective transfer, with nothing */
+        if(coll) {
+            H5D_multi_list_t empty_list;        /* No pieces */
+
+            if(H5P_set(dx_plist, H5D_XFER_IO_XFER_MODE_NAME, &xfer_mode) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't restore transfer mode")
+            xfer_mode_set = FALSE;
+
+            HDmemset(&empty_list, 0, sizeof(empty_list));
+            if(H5D__multi_coll_io(f, &empty_list, dxpl_id, do_write) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "collective transfer failed")
+        } /* end if */
+#endif /* H5_HAVE_PARALLEL */
+
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+#ifdef H5_HAVE_PARALLEL
+    if(coll) {
+        if(H5D__multi_coll_io(f, list, dxpl_id, do_write) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "collective transfer failed")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+#endif /* H5_HAVE_PARALLEL */
+
+    /* Transfer runs of adjacent pieces */
+    tbuf_size = dxpl_cache->max_temp_buf;
+    for(u = 0; u < list->npieces; u = v) {
+        size_t run_len = pieces[u].len; /* Length of the run */
+
+        /* Find the end of the run */
+        for(v = u + 1; v < list->npieces; v++)
+            if(!H5F_addr_eq(pieces[v].addr, pieces[v - 1].addr + pieces[v - 1].len) ||
+                    run_len + pieces[v].len > tbuf_size)
+                break;
+            else
+                run_len += pieces[v].len;
+
+        if(v == u + 1) {
+            /* A single piece goes straight to or from its memory */
+            if(do_write) {
+                if(H5F_block_write(f, H5FD_MEM_DRAW, pieces[u].addr, pieces[u].len, dxpl_id, pieces[u].buf) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "block write failed")
+            } /* end if */
+            else {
+                if(H5F_block_read(f, H5FD_MEM_DRAW, pieces[u].addr, pieces[u].len, dxpl_id, pieces[u].buf) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "block read failed")
+            } /* end else */
+        } /* end if */
+        else {
+            size_t w;                   /* Local index variable */
+            uint8_t *p;                 /* Position in staging buffer */
+
+            if(NULL == tbuf && NULL == (tbuf = (uint8_t *)H5MM_malloc(tbuf_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate staging buffer")
+
+            if(do_write) {
+                for(w = u, p = tbuf; w < v; p += pieces[w].len, w++)
+                    HDmemcpy(p, pieces[w].buf, pieces[w].len);
+                if(H5F_block_write(f, H5FD_MEM_DRAW, pieces[u].addr, run_len, dxpl_id, tbuf) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "block write failed")
+            } /* end if */
+            else {
+                if(H5F_block_read(f, H5FD_MEM_DRAW, pieces[u].addr, run_len, dxpl_id, tbuf) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "block read failed")
+                for(w = u, p = tbuf; w < v; p += pieces[w].len, w++)
+                    HDmemcpy(pieces[w].buf, p, pieces[w].len);
+            } /* end else */
+        } /* end else */
+    } /* end for */
+
+done:
+#ifdef H5_HAVE_PARALLEL
+    if(xfer_mode_set && H5P_set(dx_plist, H5D_XFER_IO_XFER_MODE_NAME, &xfer_mode) < 0)
+        HDONE_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't restore transfer mode")
+#endif /* H5_HAVE_PARALLEL */
+    H5MM_xfree(tbuf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_piece_io() */
+
+#ifdef H5_HAVE_PARALLEL
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_coll_io
+ *
+ * Purpose:	Transfers the pieces of a combined transfer, sorted by file
+ *		address and not overlapping, with a single collective MPI-IO
+ *		call.  The file view and the memory type are hindexed types
+ *		describing the pieces, so no data is copied.  Processes
+ *		with no pieces take part with zero bytes.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__multi_coll_io(H5F_t *f, const H5D_multi_list_t *list, hid_t dxpl_id,
+    hbool_t do_write)
+{
+    const H5D_multi_piece_t *pieces = list->pieces;     /* Pieces to transfer */
+    int         *block_lens = NULL;     /* Lengths of the blocks */
+    MPI_Aint    *file_disps = NULL;     /* File displacements of the blocks */
+    MPI_Aint    *mem_disps = NULL;      /* Memory displacements of the blocks */
+    MPI_Datatype file_type = MPI_BYTE;  /* File view for the transfer */
+    MPI_Datatype mem_type = MPI_BYTE;   /* Memory type for the transfer */
+    hbool_t     types_created = FALSE;  /* Whether the MPI types must be freed */
+    haddr_t     base_addr = 0;          /* Address of the first piece */
+    uint8_t     *base_buf = NULL;       /* Memory of the first piece */
+    size_t      io_count = 0;           /* Number of MPI types to transfer */
+    uint8_t     dummy = 0;              /* Buffer for processes with nothing to transfer */
+    int         mpi_code;               /* MPI return code */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(list->npieces > 0) {
+        MPI_Aint base_mem_addr;         /* MPI address of the first piece's memory */
+        size_t  nblocks = 0;            /* Number of blocks */
+        size_t  u;                      /* Local index variable */
+
+        if(NULL == (block_lens = (int *)H5MM_malloc(list->npieces * sizeof(int))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate block lengths")
+        if(NULL == (file_disps = (MPI_Aint *)H5MM_malloc(list->npieces * sizeof(MPI_Aint))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate file displacements")
+        if(NULL == (mem_disps = (MPI_Aint *)H5MM_malloc(list->npieces * sizeof(MPI_Aint))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate memory displacements")
+
+        base_addr = pieces[0].addr;
+        base_buf = pieces[0].buf;
+        if(MPI_SUCCESS != (mpi_code = MPI_Get_address(base_buf, &base_mem_addr)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Get_address failed", mpi_code)
+
+        /* Describe the pieces, merging those adjacent both in the file and
+         * in memory into one block */
+        for(u = 0; u < list->npieces; u++) {
+            H5_CHECK_OVERFLOW(pieces[u].len, size_t, int);
+            if(nblocks > 0 &&
+                    H5F_addr_eq(pieces[u].addr, pieces[u - 1].addr + pieces[u - 1].len) &&
+                    pieces[u].buf == pieces[u - 1].buf + pieces[u - 1].len &&
+                    (size_t)block_lens[nblocks - 1] + pieces[u].len <= (size_t)INT_MAX)
+                block_lens[nblocks - 1] += (int)pieces[u].len;
+            else {
+                MPI_Aint mem_addr;      /* MPI address of the piece's memory */
+
+                if(MPI_SUCCESS != (mpi_code = MPI_Get_address(pieces[u].buf, &mem_addr)))
+                    HMPI_GOTO_ERROR(FAIL, "MPI_Get_address failed", mpi_code)
+                block_lens[nblocks] = (int)pieces[u].len;
+                file_disps[nblocks] = (MPI_Aint)(pieces[u].addr - base_addr);
+                mem_disps[nblocks] = mem_addr - base_mem_addr;
+                nblocks++;
+            } /* end else */
+        } /* end for */
+
+        if(nblocks == 1)
+            /* A single block is transferred as bytes */
+            io_count = (size_t)block_lens[0];
+        else {
+            H5_CHECK_OVERFLOW(nblocks, size_t, int);
+            if(MPI_SUCCESS != (mpi_code = MPI_Type_create_hindexed((int)nblocks, block_lens, file_disps, MPI_BYTE, &file_type)))
+                HMPI_GOTO_ERROR(FAIL, "MPI_Type_create_hindexed failed", mpi_code)
+            if(MPI_SUCCESS != (mpi_code = MPI_Type_create_hindexed((int)nblocks, block_lens, mem_disps, MPI_BYTE, &mem_type))) {
+                MPI_Type_free(&file_type);
+                HMPI_GOTO_ERROR(FAIL, "MPI_Type_create_hindexed failed", mpi_code)
+            } /* end if */
+            types_created = TRUE;
+            if(MPI_SUCCESS != (mpi_code = MPI_Type_commit(&file_type)))
+                HMPI_GOTO_ERROR(FAIL, "MPI_Type_commit failed", mpi_code)
+            if(MPI_SUCCESS != (mpi_code = MPI_Type_commit(&mem_type)))
+                HMPI_GOTO_ERROR(FAIL, "MPI_Type_commit failed", mpi_code)
+            io_count = 1;
+        } /* end else */
+    } /* end if */
+
+    /* Pass the types to the file driver */
+    if(H5FD_mpi_setup_collective(dxpl_id, &mem_type, &file_type) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set MPI-I/O properties")
+
+    if(do_write) {
+        if(H5F_block_write(f, H5FD_MEM_DRAW, base_addr, io_count, dxpl_id, (base_buf ? base_buf : &dummy)) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "collective write failed")
+    } /* end if */
+    else {
+        if(H5F_block_read(f, H5FD_MEM_DRAW, base_addr, io_count, dxpl_id, (base_buf ? base_buf : &dummy)) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "collective read failed")
+    } /* end else */
+
+done:
+    if(types_created) {
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_free(&file_type)))
+            HMPI_DONE_ERROR(FAIL, "MPI_Type_free failed", mpi_code)
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_free(&mem_type)))
+            HMPI_DONE_ERROR(FAIL, "MPI_Type_free failed", mpi_code)
+    } /* end if */
+    H5MM_xfree(block_lens);
+    H5MM_xfree(file_disps);
+    H5MM_xfree(mem_disps);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_coll_io() */
+#endif /* H5_HAVE_PARALLEL */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__ioinfo_init
@@ -1128,6 +2081,12 @@ H5D__ioinfo_adjust(H5D_io_info_t *io_info, const H5D_t *dset, hid_t dxpl_id,
             io_info->io_ops.single_write = H5D__mpio_select_write;
         } /* end if */
         else {
+            /* Filtered chunks can only be written with collective I/O */
+            if(io_info->op_type == H5D_IO_OP_WRITE &&
+                    dset->shared->layout.type == H5D_CHUNKED &&
+                    dset->shared->dcpl_cache.pline.nused > 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot write to chunked storage with filters in parallel without collective I/O")
+
             /* If we won't be doing collective I/O, but the user asked for
              * collective I/O, change the request to use independent I/O, but
              * mark it so that we remember to revert the change.
@@ -44,6 +44,7 @@
 #include "H5Pprivate.h"       /* Property lists    */
 #include "H5Sprivate.h"       /* Dataspaces        */
 #include "H5VMprivate.h"       /* Vector            */
+#include "H5Zprivate.h"       /* Data filters      */
 
 #ifdef H5_HAVE_PARALLEL
 
@@ -86,6 +87,9 @@
 #define H5D_CHUNK_SELECT_IRREG        2
 #define H5D_CHUNK_SELECT_NONE         0
 
+/* MPI message tag for the pieces of chunks sent to their owners */
+#define H5D_CHUNK_PIECE_TAG           0x4844
+
 
 /******************/
 /* Local Typedefs */
@@ -96,6 +100,40 @@ typedef struct H5D_chunk_addr_info_t {
   H5D_chunk_info_t chunk_info;
 } H5D_chunk_addr_info_t;
 
+/* Information about a chunk in a collective write that assigns each chunk
+ * to one owning process, exchanged between processes as raw bytes.
+ */
+typedef struct H5D_chunk_owner_rec_t {
+    hsize_t index;                      /* "Index" of chunk in dataset */
+    hsize_t coords[H5O_LAYOUT_NDIMS];   /* Coordinates of chunk in file dataset's dataspace */
+    hsize_t npoints;                    /* Number of elements selected in chunk */
+    hsize_t nbytes;                     /* Size of chunk after filtering */
+    unsigned filter_mask;               /* Excluded filters */
+    int rank;                           /* Process the record came from */
+} H5D_chunk_owner_rec_t;
+
+/* A sequence of bytes within a chunk */
+typedef struct H5D_chunk_seq_t {
+    hsize_t off;                        /* Offset of sequence in chunk */
+    hsize_t len;                        /* Length of sequence */
+} H5D_chunk_seq_t;
+
+/* Growable list of sequences within a chunk */
+typedef struct H5D_chunk_seq_list_t {
+    size_t nseq;                        /* # of sequences in list */
+    size_t nalloc;                      /* # of sequences allocated */
+    H5D_chunk_seq_t *seq;               /* Sequences */
+} H5D_chunk_seq_list_t;
+
+/* A chunk assembled by its owner in an unfiltered owner-based write */
+typedef struct H5D_chunk_owned_t {
+    hsize_t index;                      /* "Index" of chunk in dataset */
+    hsize_t coords[H5O_LAYOUT_NDIMS];   /* Coordinates of chunk in file dataset's dataspace */
+    haddr_t addr;                       /* Address of chunk in file */
+    uint8_t *buf;                       /* Chunk data assembled from all processes */
+    H5D_chunk_seq_list_t cover;         /* Parts of chunk selected by any process */
+} H5D_chunk_owned_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -108,6 +146,33 @@ static herr_t H5D__multi_chunk_collective_io(H5D_io_info_t *io_info,
 static herr_t H5D__link_chunk_collective_io(H5D_io_info_t *io_info,
     const H5D_type_info_t *type_info, H5D_chunk_map_t *fm, int sum_chunk,
     H5P_genplist_t *dx_plist);
+static herr_t H5D__filtered_collective_chunk_write(H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_chunk_map_t *fm);
+static herr_t H5D__owner_chunk_collective_write(H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_chunk_map_t *fm,
+    H5P_genplist_t *dx_plist);
+static int H5D__chunk_owner_rec_cmp(const void *rec1, const void *rec2);
+static herr_t H5D__chunk_owner_local(const H5D_chunk_map_t *fm, int mpi_rank,
+    H5D_chunk_owner_rec_t **local, size_t *nlocal);
+static herr_t H5D__chunk_owner_exchange(MPI_Comm comm, int mpi_size,
+    H5D_chunk_owner_rec_t *local, size_t nlocal,
+    H5D_chunk_owner_rec_t **all, size_t *nall);
+static herr_t H5D__chunk_seq_list_add(H5D_chunk_seq_list_t *list, hsize_t off,
+    hsize_t len);
+static int H5D__chunk_seq_cmp(const void *seq1, const void *seq2);
+static void H5D__chunk_seq_list_merge(H5D_chunk_seq_list_t *list);
+static herr_t H5D__chunk_piece_seqs(const H5S_t *space, size_t elmt_size,
+    size_t nelmts, H5D_chunk_seq_list_t *list);
+static herr_t H5D__chunk_piece_copy(const H5D_io_info_t *io_info,
+    const H5D_chunk_info_t *chunk_info, size_t elmt_size, uint8_t **gath_buf,
+    size_t *gath_buf_size, uint8_t *chunk_buf);
+static herr_t H5D__chunk_piece_send(const H5D_io_info_t *io_info,
+    const H5D_chunk_info_t *chunk_info, size_t elmt_size, int owner,
+    H5D_chunk_seq_list_t *seqs, uint8_t **msg, MPI_Request *req);
+static herr_t H5D__chunk_piece_recv(MPI_Comm comm, int src, uint8_t **recv_buf,
+    size_t *recv_buf_size, uint8_t *chunk_buf, size_t chunk_size,
+    H5D_chunk_seq_list_t *cover);
+static int H5D__chunk_owned_addr_cmp(const void *chunk1, const void *chunk2);
 static herr_t H5D__inter_collective_io(H5D_io_info_t *io_info,
     const H5D_type_info_t *type_info, const H5S_t *file_space,
     const H5S_t *mem_space);
@@ -208,8 +273,11 @@ H5D__mpio_opt_possible(const H5D_io_info_t *io_info, const H5S_t *file_space,
      *  use collective IO will defer until each chunk IO is reached.
      */
 
-    /* Don't allow collective operations if filters need to be applied */
-    if(io_info->dset->shared->layout.type == H5D_CHUNKED &&
+    /* Don't allow collective reads if filters need to be applied (collective
+     *  writes to filtered chunks are handled by H5D__chunk_collective_write)
+     */
+    if(io_info->op_type == H5D_IO_OP_READ &&
+            io_info->dset->shared->layout.type == H5D_CHUNKED &&
             io_info->dset->shared->dcpl_cache.pline.nused > 0)
         local_cause |= H5D_MPIO_FILTERS;
 
@@ -752,14 +820,1056 @@ H5D__chunk_collective_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_
 
     FUNC_ENTER_PACKAGE
 
-    /* Call generic selection operation */
-    if(H5D__chunk_collective_io(io_info, type_info, fm) < 0)
-        HGOTO_ERROR(H5E_DATASPACE, H5E_WRITEERROR, FAIL, "write error")
+    /* Filtered chunks can't be written in place, so they are assembled on
+     *  a single process, filtered there and re-allocated collectively.
+     */
+    if(io_info->dset->shared->dcpl_cache.pline.nused > 0) {
+        if(H5D__filtered_collective_chunk_write(io_info, type_info, fm) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_WRITEERROR, FAIL, "filtered write error")
+    } /* end if */
+    else {
+        H5P_genplist_t *dx_plist;       /* DXPL for the write */
+
+        if(NULL == (dx_plist = (H5P_genplist_t *)H5I_object(io_info->dxpl_id)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
+
+        /* Each chunk is written by a single process, when requested */
+        if(H5FD_MPIO_CHUNK_OWNER_IO == (H5FD_mpio_chunk_opt_t)H5P_peek_unsigned(dx_plist, H5D_XFER_MPIO_CHUNK_OPT_HARD_NAME)) {
+            if(H5D__owner_chunk_collective_write(io_info, type_info, fm, dx_plist) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_WRITEERROR, FAIL, "owner-based write error")
+        } /* end if */
+        /* Call generic selection operation */
+        else if(H5D__chunk_collective_io(io_info, type_info, fm) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_WRITEERROR, FAIL, "write error")
+    } /* end else */
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_collective_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_owner_rec_cmp
+ *
+ * Purpose:     Callback for qsort() to sort chunk owner records by chunk
+ *              index, then by the rank of the process they came from.
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_owner_rec_cmp(const void *rec1, const void *rec2)
+{
+    const H5D_chunk_owner_rec_t *r1 = (const H5D_chunk_owner_rec_t *)rec1;
+    const H5D_chunk_owner_rec_t *r2 = (const H5D_chunk_owner_rec_t *)rec2;
+    int ret_value;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(r1->index != r2->index)
+        ret_value = r1->index < r2->index ? -1 : 1;
+    else
+        ret_value = r1->rank < r2->rank ? -1 : (r1->rank > r2->rank ? 1 : 0);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_owner_rec_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_owner_local
+ *
+ * Purpose:     Builds the chunk owner records describing the chunks
+ *              selected by this process.  The array returned in LOCAL
+ *              must be freed by the caller.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_owner_local(const H5D_chunk_map_t *fm, int mpi_rank,
+    H5D_chunk_owner_rec_t **local, size_t *nlocal)
+{
+    H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    *nlocal = H5SL_count(fm->sel_chunks);
+    if(NULL == (*local = (H5D_chunk_owner_rec_t *)H5MM_calloc((*nlocal + 1) * sizeof(H5D_chunk_owner_rec_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate chunk records")
+
+    for(u = 0, chunk_node = H5SL_first(fm->sel_chunks); chunk_node; u++, chunk_node = H5SL_next(chunk_node)) {
+        H5D_chunk_info_t *chunk_info = (H5D_chunk_info_t *)H5SL_item(chunk_node);
+
+        (*local)[u].index = chunk_info->index;
+        HDmemcpy((*local)[u].coords, chunk_info->coords, sizeof((*local)[u].coords));
+        (*local)[u].npoints = chunk_info->chunk_points;
+        (*local)[u].rank = mpi_rank;
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_owner_local() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_owner_exchange
+ *
+ * Purpose:     Gathers the chunk owner records of all processes onto
+ *              all processes, sorted by chunk index and rank.  The array
+ *              returned in ALL must be freed by the caller.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_owner_exchange(MPI_Comm comm, int mpi_size,
+    H5D_chunk_owner_rec_t *local, size_t nlocal,
+    H5D_chunk_owner_rec_t **all, size_t *nall)
+{
+    int        *recv_counts = NULL;     /* Bytes received from each process */
+    int        *displs = NULL;          /* Displacement of each process's records */
+    int         send_count;             /* Bytes sent by this process */
+    size_t      total = 0;              /* Total # of records */
+    int         mpi_code;               /* MPI return code */
+    int         i;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    *all = NULL;
+    *nall = 0;
+
+    H5_ASSIGN_OVERFLOW(send_count, nlocal * sizeof(H5D_chunk_owner_rec_t), size_t, int);
+    if(NULL == (recv_counts = (int *)H5MM_malloc((size_t)mpi_size * sizeof(int))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate receive counts")
+    if(NULL == (displs = (int *)H5MM_malloc((size_t)mpi_size * sizeof(int))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate displacements")
+
+    if(MPI_SUCCESS != (mpi_code = MPI_Allgather(&send_count, 1, MPI_INT, recv_counts, 1, MPI_INT, comm)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Allgather failed", mpi_code)
+
+    for(i = 0; i < mpi_size; i++) {
+        H5_ASSIGN_OVERFLOW(displs[i], total * sizeof(H5D_chunk_owner_rec_t), size_t, int);
+        total += (size_t)recv_counts[i] / sizeof(H5D_chunk_owner_rec_t);
+    } /* end for */
+
+    if(NULL == (*all = (H5D_chunk_owner_rec_t *)H5MM_malloc((total + 1) * sizeof(H5D_chunk_owner_rec_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate chunk records")
+
+    if(MPI_SUCCESS != (mpi_code = MPI_Allgatherv(local, send_count, MPI_BYTE, *all, recv_counts, displs, MPI_BYTE, comm)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Allgatherv failed", mpi_code)
+
+    /* Put the records in the same order on all processes */
+    HDqsort(*all, total, sizeof(H5D_chunk_owner_rec_t), H5D__chunk_owner_rec_cmp);
+    *nall = total;
+
+done:
+    H5MM_xfree(recv_counts);
+    H5MM_xfree(displs);
+    if(ret_value < 0)
+        *all = (H5D_chunk_owner_rec_t *)H5MM_xfree(*all);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_owner_exchange() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_seq_list_add
+ *
+ * Purpose:     Appends a sequence of bytes within a chunk to a sequence
+ *              list, extending the last sequence when the new one follows
+ *              on from it.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_seq_list_add(H5D_chunk_seq_list_t *list, hsize_t off, hsize_t len)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(list->nseq > 0 && list->seq[list->nseq - 1].off + list->seq[list->nseq - 1].len == off)
+        list->seq[list->nseq - 1].len += len;
+    else {
+        if(list->nseq == list->nalloc) {
+            size_t new_alloc = MAX(2 * list->nalloc, H5D_IO_VECTOR_SIZE);
+            H5D_chunk_seq_t *new_seq;
+
+            if(NULL == (new_seq = (H5D_chunk_seq_t *)H5MM_realloc(list->seq, new_alloc * sizeof(H5D_chunk_seq_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate sequence list")
+            list->seq = new_seq;
+            list->nalloc = new_alloc;
+        } /* end if */
+        list->seq[list->nseq].off = off;
+        list->seq[list->nseq].len = len;
+        list->nseq++;
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_seq_list_add() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_seq_cmp
+ *
+ * Purpose:     Callback for qsort() to sort sequences within a chunk by
+ *              offset.
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_seq_cmp(const void *seq1, const void *seq2)
+{
+    const H5D_chunk_seq_t *s1 = (const H5D_chunk_seq_t *)seq1;
+    const H5D_chunk_seq_t *s2 = (const H5D_chunk_seq_t *)seq2;
+    int ret_value;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    ret_value = s1->off < s2->off ? -1 : (s1->off > s2->off ? 1 : 0);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_seq_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_seq_list_merge
+ *
+ * Purpose:     Sorts a sequence list by offset and merges overlapping and
+ *              adjacent sequences, leaving disjoint runs in increasing
+ *              order.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_seq_list_merge(H5D_chunk_seq_list_t *list)
+{
+    size_t      last = 0;               /* Last run kept */
+    size_t      u;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(list->nseq > 1) {
+        HDqsort(list->seq, list->nseq, sizeof(H5D_chunk_seq_t), H5D__chunk_seq_cmp);
+
+        for(u = 1; u < list->nseq; u++) {
+            hsize_t last_end = list->seq[last].off + list->seq[last].len;
+
+            if(list->seq[u].off <= last_end) {
+                if(list->seq[u].off + list->seq[u].len > last_end)
+                    list->seq[last].len = (list->seq[u].off + list->seq[u].len) - list->seq[last].off;
+            } /* end if */
+            else
+                list->seq[++last] = list->seq[u];
+        } /* end for */
+        list->nseq = last + 1;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_seq_list_merge() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_piece_seqs
+ *
+ * Purpose:     Appends the byte sequences within a chunk covered by the
+ *              selection in the chunk's file dataspace to a sequence list.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_piece_seqs(const H5S_t *space, size_t elmt_size, size_t nelmts,
+    H5D_chunk_seq_list_t *list)
+{
+    H5S_sel_iter_t iter;                /* Selection iterator */
+    hbool_t     iter_init = FALSE;      /* Whether the iterator is initialized */
+    hsize_t     _off[H5D_IO_VECTOR_SIZE];   /* Sequence offsets from selection */
+    size_t      _len[H5D_IO_VECTOR_SIZE];   /* Sequence lengths from selection */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(H5S_select_iter_init(&iter, space, elmt_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    iter_init = TRUE;
+
+    while(nelmts > 0) {
+        size_t curr_nseq, curr_nelmts, u;
+
+        if(H5S_SELECT_GET_SEQ_LIST(space, 0, &iter, (size_t)H5D_IO_VECTOR_SIZE, nelmts, &curr_nseq, &curr_nelmts, _off, _len) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+        for(u = 0; u < curr_nseq; u++)
+            if(H5D__chunk_seq_list_add(list, _off[u], (hsize_t)_len[u]) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to add sequence to list")
+        nelmts -= curr_nelmts;
+    } /* end while */
+
+done:
+    if(iter_init && H5S_SELECT_ITER_RELEASE(&iter) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "couldn't release selection iterator")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_piece_seqs() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_piece_copy
+ *
+ * Purpose:     Copies the elements this process selected in a chunk from
+ *              the application's buffer into a buffer holding the whole
+ *              chunk.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_piece_copy(const H5D_io_info_t *io_info,
+    const H5D_chunk_info_t *chunk_info, size_t elmt_size, uint8_t **gath_buf,
+    size_t *gath_buf_size, uint8_t *chunk_buf)
+{
+    H5S_sel_iter_t iter;                /* Selection iterator */
+    hbool_t     iter_init = FALSE;      /* Whether the iterator is initialized */
+    size_t      nelmts = (size_t)chunk_info->chunk_points;  /* # of elements selected */
+    size_t      n;                      /* # of elements gathered */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(nelmts * elmt_size > *gath_buf_size) {
+        *gath_buf_size = nelmts * elmt_size;
+        if(NULL == (*gath_buf = (uint8_t *)H5MM_realloc(*gath_buf, *gath_buf_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate gather buffer")
+    } /* end if */
+
+    if(H5S_select_iter_init(&iter, chunk_info->mspace, elmt_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    n = H5D__gather_mem(io_info->u.wbuf, chunk_info->mspace, &iter, nelmts, io_info->dxpl_cache, *gath_buf);
+    if(H5S_SELECT_ITER_RELEASE(&iter) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "couldn't release selection iterator")
+    if(n != nelmts)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "mem gather failed")
+
+    if(H5S_select_iter_init(&iter, chunk_info->fspace, elmt_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    iter_init = TRUE;
+    if(H5D__scatter_mem(*gath_buf, chunk_info->fspace, &iter, nelmts, io_info->dxpl_cache, chunk_buf) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "scatter failed")
+
+done:
+    if(iter_init && H5S_SELECT_ITER_RELEASE(&iter) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "couldn't release selection iterator")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_piece_copy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_piece_send
+ *
+ * Purpose:     Sends the elements this process selected in a chunk to the
+ *              chunk's owner.  The message holds the number of sequences,
+ *              the (offset, length) pair of each sequence within the
+ *              chunk, then the data.  The message buffer is returned in
+ *              MSG and must be kept until the send completes.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_piece_send(const H5D_io_info_t *io_info,
+    const H5D_chunk_info_t *chunk_info, size_t elmt_size, int owner,
+    H5D_chunk_seq_list_t *seqs, uint8_t **msg, MPI_Request *req)
+{
+    H5S_sel_iter_t iter;                /* Selection iterator */
+    size_t      nelmts = (size_t)chunk_info->chunk_points;  /* # of elements selected */
+    size_t      msg_size;               /* Size of message */
+    int         msg_count;              /* Message size, for MPI */
+    hsize_t    *hdr;                    /* Message header */
+    uint8_t    *data;                   /* Data in message */
+    size_t      n;                      /* # of elements gathered */
+    int         mpi_code;               /* MPI return code */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    *msg = NULL;
+
+    /* Describe where the elements go in the chunk */
+    seqs->nseq = 0;
+    if(H5D__chunk_piece_seqs(chunk_info->fspace, elmt_size, nelmts, seqs) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to describe selection in chunk")
+
+    /* Build the message */
+    msg_size = sizeof(hsize_t) + seqs->nseq * sizeof(H5D_chunk_seq_t) + nelmts * elmt_size;
+    if(NULL == (*msg = (uint8_t *)H5MM_malloc(msg_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate message buffer")
+    hdr = (hsize_t *)*msg;
+    hdr[0] = (hsize_t)seqs->nseq;
+    HDmemcpy(hdr + 1, seqs->seq, seqs->nseq * sizeof(H5D_chunk_seq_t));
+    data = (uint8_t *)(hdr + 1) + seqs->nseq * sizeof(H5D_chunk_seq_t);
+
+    if(H5S_select_iter_init(&iter, chunk_info->mspace, elmt_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    n = H5D__gather_mem(io_info->u.wbuf, chunk_info->mspace, &iter, nelmts, io_info->dxpl_cache, data);
+    if(H5S_SELECT_ITER_RELEASE(&iter) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "couldn't release selection iterator")
+    if(n != nelmts)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "mem gather failed")
+
+    H5_ASSIGN_OVERFLOW(msg_count, msg_size, size_t, int);
+    if(MPI_SUCCESS != (mpi_code = MPI_Isend(*msg, msg_count, MPI_BYTE, owner, H5D_CHUNK_PIECE_TAG, io_info->comm, req)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Isend failed", mpi_code)
+
+done:
+    if(ret_value < 0)
+        *msg = (uint8_t *)H5MM_xfree(*msg);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_piece_send() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_piece_recv
+ *
+ * Purpose:     Receives the next piece of a chunk sent by process SRC and
+ *              copies it into CHUNK_BUF.  When COVER is non-NULL, the
+ *              sequences written are appended to it.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_piece_recv(MPI_Comm comm, int src, uint8_t **recv_buf,
+    size_t *recv_buf_size, uint8_t *chunk_buf, size_t chunk_size,
+    H5D_chunk_seq_list_t *cover)
+{
+    MPI_Status  status;                 /* Status of message */
+    int         msg_count;              /* Size of message */
+    const hsize_t *hdr;                 /* Message header */
+    const H5D_chunk_seq_t *seq;         /* Sequences in message */
+    const uint8_t *data;                /* Data in message */
+    hsize_t     nseq, u;                /* # of sequences & index */
+    int         mpi_code;               /* MPI return code */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(MPI_SUCCESS != (mpi_code = MPI_Probe(src, H5D_CHUNK_PIECE_TAG, comm, &status)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Probe failed", mpi_code)
+    if(MPI_SUCCESS != (mpi_code = MPI_Get_count(&status, MPI_BYTE, &msg_count)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Get_count failed", mpi_code)
+    if((size_t)msg_count > *recv_buf_size) {
+        *recv_buf_size = (size_t)msg_count;
+        if(NULL == (*recv_buf = (uint8_t *)H5MM_realloc(*recv_buf, *recv_buf_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate receive buffer")
+    } /* end if */
+    if(MPI_SUCCESS != (mpi_code = MPI_Recv(*recv_buf, msg_count, MPI_BYTE, src, H5D_CHUNK_PIECE_TAG, comm, &status)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Recv failed", mpi_code)
+
+    hdr = (const hsize_t *)*recv_buf;
+    nseq = hdr[0];
+    seq = (const H5D_chunk_seq_t *)(hdr + 1);
+    data = (const uint8_t *)(seq + nseq);
+    for(u = 0; u < nseq; u++) {
+        HDassert(seq[u].off + seq[u].len <= chunk_size);
+        HDmemcpy(chunk_buf + seq[u].off, data, (size_t)seq[u].len);
+        data += seq[u].len;
+        if(cover && H5D__chunk_seq_list_add(cover, seq[u].off, seq[u].len) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to add sequence to list")
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_piece_recv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_collective_chunk_write
+ *
+ * Purpose:     Collectively writes to a chunked dataset with I/O filters.
+ *
+ *              Every chunk touched by the write is given to a single
+ *              owner, the process that selected the most elements in it.
+ *              The other processes send their pieces of the chunk to the
+ *              owner, which fills the parts no process selected from the
+ *              existing chunk (if there are any), runs the filter
+ *              pipeline and keeps the result.  The new chunk sizes are
+ *              then exchanged so that every process re-allocates the
+ *              chunks in the chunk index identically, after which the
+ *              owners write their chunks to the new locations.
+ *
+ *              Datatype conversions and data transforms are not handled
+ *              here, since collective I/O is not attempted when they are
+ *              needed.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_collective_chunk_write(H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_chunk_map_t *fm)
+{
+    const H5D_t *dset = io_info->dset;  /* Dataset to write to */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    H5P_genplist_t *dx_plist;           /* DXPL for the write */
+    MPI_Comm    comm = io_info->comm;   /* MPI communicator for file */
+    int         mpi_rank, mpi_size;     /* This process's rank & # of processes */
+    size_t      elmt_size = type_info->dst_type_size;   /* Size of each element */
+    size_t      chunk_size;             /* Size of unfiltered chunk in bytes */
+    H5D_chunk_owner_rec_t *local = NULL;        /* Records for chunks selected locally */
+    H5D_chunk_owner_rec_t *all = NULL;          /* Records for chunks selected anywhere */
+    H5D_chunk_owner_rec_t *owned = NULL;        /* Records for chunks owned locally */
+    H5D_chunk_owner_rec_t *written = NULL;      /* Records for chunks owned anywhere */
+    uint8_t   **owned_buf = NULL;       /* Filtered data for chunks owned locally */
+    uint8_t   **send_buf = NULL;        /* Messages for chunks owned elsewhere */
+    MPI_Request *send_req = NULL;       /* Requests for messages sent */
+    uint8_t    *recv_buf = NULL;        /* Buffer for messages received */
+    size_t      recv_buf_size = 0;      /* Size of receive buffer */
+    uint8_t    *gath_buf = NULL;        /* Buffer for elements gathered from memory */
+    size_t      gath_buf_size = 0;      /* Size of gather buffer */
+    uint8_t    *old_buf = NULL;         /* Buffer for existing chunk data */
+    size_t      old_buf_size = 0;       /* Size of existing chunk buffer */
+    H5D_chunk_seq_list_t seqs = {0, 0, NULL};   /* Sequences of a piece sent */
+    H5D_chunk_seq_list_t cover = {0, 0, NULL};  /* Parts of an owned chunk selected by any process */
+    size_t      nlocal = 0, nall = 0, nowned = 0, nwritten = 0, nsent = 0;
+    size_t      u, v, w;                /* Local index variables */
+    hbool_t     xfer_mode_changed = FALSE;  /* Whether the transfer mode was switched */
+    H5D_mpio_actual_chunk_opt_mode_t actual_chunk_opt_mode = H5D_MPIO_MULTI_CHUNK;  /* Actual chunk optimization mode */
+    H5D_mpio_actual_io_mode_t actual_io_mode = H5D_MPIO_NO_COLLECTIVE; /* Actual I/O mode */
+    int         mpi_code;               /* MPI return code */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(io_info);
+    HDassert(type_info);
+    HDassert(fm);
+    HDassert(type_info->is_conv_noop && type_info->is_xform_noop);
+
+    /* Obtain the data transfer properties */
+    if(NULL == (dx_plist = (H5P_genplist_t *)H5I_object(io_info->dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
+
+    if((mpi_rank = H5F_mpi_get_rank(dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi rank")
+    if((mpi_size = H5F_mpi_get_size(dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi size")
+
+    H5_ASSIGN_OVERFLOW(chunk_size, dset->shared->layout.u.chunk.size, uint32_t, size_t);
+
+    /* Find out which processes selected which chunks */
+    if(H5D__chunk_owner_local(fm, mpi_rank, &local, &nlocal) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to describe chunk selections")
+    if(H5D__chunk_owner_exchange(comm, mpi_size, local, nlocal, &all, &nall) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTRECV, FAIL, "unable to exchange chunk selections")
+
+    /* Allocate space for the chunks this process may own and the messages
+     *  it may send; neither can outnumber the chunks it selected.
+     */
+    if(NULL == (owned = (H5D_chunk_owner_rec_t *)H5MM_calloc((nlocal + 1) * sizeof(H5D_chunk_owner_rec_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate chunk records")
+    if(NULL == (owned_buf = (uint8_t **)H5MM_calloc((nlocal + 1) * sizeof(uint8_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate chunk buffers")
+    if(NULL == (send_buf = (uint8_t **)H5MM_calloc((nlocal + 1) * sizeof(uint8_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate message buffers")
+    if(NULL == (send_req = (MPI_Request *)H5MM_malloc((nlocal + 1) * sizeof(MPI_Request))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate message requests")
+
+    /* Send the pieces of chunks owned by other processes to their owners,
+     *  in chunk index order.
+     */
+    for(u = 0; u < nall; u = v) {
+        size_t owner = u;               /* Record of the owning process */
+        size_t mine = nall;             /* Record for this process */
+
+        /* Find the owner & this process's part of the chunk */
+        for(v = u; v < nall && all[v].index == all[u].index; v++) {
+            if(all[v].npoints > all[owner].npoints)
+                owner = v;
+            if(all[v].rank == mpi_rank)
+                mine = v;
+        } /* end for */
+
+        if(mine == owner) {
+            /* Remember the chunk, for processing below */
+            owned[nowned++] = all[owner];
+        } /* end if */
+        else if(mine < nall) {
+            H5D_chunk_info_t *chunk_info;   /* Chunk info for the chunk */
+
+            if(NULL == (chunk_info = (H5D_chunk_info_t *)H5SL_search(fm->sel_chunks, &all[mine].index)))
+                HGOTO_ERROR(H5E_DATASET, H5E_NOTFOUND, FAIL, "can't locate chunk in skip list")
+            if(H5D__chunk_piece_send(io_info, chunk_info, elmt_size, all[owner].rank, &seqs, &send_buf[nsent], &send_req[nsent]) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_MPI, FAIL, "unable to send piece of chunk to its owner")
+            nsent++;
+        } /* end if */
+    } /* end for */
+
+    /* Switch to independent I/O, for the owners to read and write their
+     *  chunks.
+     */
+    if(H5D__ioinfo_xfer_mode(io_info, dx_plist, H5FD_MPIO_INDEPENDENT) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't switch to independent I/O")
+    xfer_mode_changed = TRUE;
+
+    /* Assemble and filter the chunks owned by this process */
+    for(u = 0, v = 0; u < nowned; u++) {
+        H5D_chunk_info_t *chunk_info;   /* Chunk info for the chunk */
+        H5D_chunk_ud_t udata;           /* Chunk index info */
+        size_t buf_alloc;               /* Size of chunk buffer */
+        size_t nbytes;                  /* Size of chunk data */
+        unsigned filter_mask = 0;       /* Excluded filters */
+
+        /* Look up the chunk in the file */
+        if(H5D__chunk_lookup_uncached(dset, io_info->dxpl_id, io_info->dxpl_cache, owned[u].coords, owned[u].index, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        if(!H5F_addr_defined(udata.addr))
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "chunk storage not allocated")
+
+        buf_alloc = MAX(chunk_size, (size_t)udata.nbytes);
+        if(NULL == (owned_buf[u] = (uint8_t *)H5MM_malloc(buf_alloc)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+
+        /* Copy in the elements selected by this process */
+        if(NULL == (chunk_info = (H5D_chunk_info_t *)H5SL_search(fm->sel_chunks, &owned[u].index)))
+            HGOTO_ERROR(H5E_DATASET, H5E_NOTFOUND, FAIL, "can't locate chunk in skip list")
+        if(H5D__chunk_piece_copy(io_info, chunk_info, elmt_size, &gath_buf, &gath_buf_size, owned_buf[u]) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "unable to copy elements into chunk")
+        cover.nseq = 0;
+        if(H5D__chunk_piece_seqs(chunk_info->fspace, elmt_size, (size_t)chunk_info->chunk_points, &cover) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to describe selection in chunk")
+
+        /* Apply the pieces sent by the other processes that selected the chunk */
+        while(v < nall && all[v].index < owned[u].index)
+            v++;
+        for(; v < nall && all[v].index == owned[u].index; v++)
+            if(all[v].rank != mpi_rank)
+                if(H5D__chunk_piece_recv(comm, all[v].rank, &recv_buf, &recv_buf_size, owned_buf[u], chunk_size, &cover) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTRECV, FAIL, "unable to receive piece of chunk")
+
+        /* Fill the parts of the chunk no process selected from the existing
+         *  chunk.  The element counts of the processes can't be used to
+         *  skip this, since their selections may overlap.
+         */
+        H5D__chunk_seq_list_merge(&cover);
+        if(!(cover.nseq == 1 && cover.seq[0].off == 0 && cover.seq[0].len == (hsize_t)chunk_size)) {
+            size_t pos = 0;             /* Offset of next unselected part */
+
+            if(udata.nbytes > old_buf_size) {
+                old_buf_size = udata.nbytes;
+                if(NULL == (old_buf = (uint8_t *)H5MM_realloc(old_buf, old_buf_size)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+            } /* end if */
+            nbytes = udata.nbytes;
+            if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, udata.addr, nbytes, io_info->dxpl_id, old_buf) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+            if(H5Z_pipeline(pline, H5Z_FLAG_REVERSE, &udata.filter_mask, io_info->dxpl_cache->err_detect,
+                    io_info->dxpl_cache->filter_cb, &nbytes, &old_buf_size, (void **)&old_buf) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+            if(nbytes != chunk_size)
+                HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "unfiltered chunk has wrong size")
+
+            for(w = 0; w < cover.nseq; w++) {
+                if((size_t)cover.seq[w].off > pos)
+                    HDmemcpy(owned_buf[u] + pos, old_buf + pos, (size_t)cover.seq[w].off - pos);
+                pos = (size_t)(cover.seq[w].off + cover.seq[w].len);
+            } /* end for */
+            if(pos < chunk_size)
+                HDmemcpy(owned_buf[u] + pos, old_buf + pos, chunk_size - pos);
+        } /* end if */
+
+        /* Push the chunk through the filters */
+        nbytes = chunk_size;
+        if(H5Z_pipeline(pline, 0, &filter_mask, io_info->dxpl_cache->err_detect, io_info->dxpl_cache->filter_cb,
+                &nbytes, &buf_alloc, (void **)&owned_buf[u]) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
+#if H5_SIZEOF_SIZE_T > 4
+        /* Check for the chunk expanding too much to encode in a 32-bit value */
+        if(nbytes > ((size_t)0xffffffff))
+            HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+        owned[u].nbytes = (hsize_t)nbytes;
+        owned[u].filter_mask = filter_mask;
+    } /* end for */
+
+    /* Tell every process the new size of every chunk written */
+    if(H5D__chunk_owner_exchange(comm, mpi_size, owned, nowned, &written, &nwritten) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTRECV, FAIL, "unable to exchange chunk sizes")
+
+    /* Re-allocate the chunks in the index, identically on all processes,
+     *  and write the chunks owned by this process.
+     */
+    for(u = 0, v = 0; u < nwritten; u++) {
+        H5D_chunk_ud_t udata;           /* Chunk index info */
+        uint32_t nbytes;                /* New size of chunk */
+
+        if(H5D__chunk_lookup_uncached(dset, io_info->dxpl_id, io_info->dxpl_cache, written[u].coords, written[u].index, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        H5_ASSIGN_OVERFLOW(nbytes, written[u].nbytes, hsize_t, uint32_t);
+        if(H5D__chunk_reinsert(dset, io_info->dxpl_id, &udata, nbytes, written[u].filter_mask) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to re-allocate chunk")
+
+        if(written[u].rank == mpi_rank) {
+            HDassert(v < nowned && owned[v].index == written[u].index);
+            if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.addr, (size_t)nbytes, io_info->dxpl_id, owned_buf[v]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write raw data chunk")
+            actual_io_mode = H5D_MPIO_CHUNK_INDEPENDENT;
+            v++;
+        } /* end if */
+    } /* end for */
+
+    /* Make sure the pieces sent have been received */
+    if(nsent > 0)
+        if(MPI_SUCCESS != (mpi_code = MPI_Waitall((int)nsent, send_req, MPI_STATUSES_IGNORE)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Waitall failed", mpi_code)
+
+    /* Set the actual chunk opt mode & io mode properties */
+    if(H5P_set(dx_plist, H5D_MPIO_ACTUAL_CHUNK_OPT_MODE_NAME, &actual_chunk_opt_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "couldn't set actual chunk opt mode property")
+    if(H5P_set(dx_plist, H5D_MPIO_ACTUAL_IO_MODE_NAME, &actual_io_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "couldn't set actual io mode property")
+
+done:
+    /* Switch back to collective I/O */
+    if(xfer_mode_changed && H5D__ioinfo_xfer_mode(io_info, dx_plist, H5FD_MPIO_COLLECTIVE) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't switch to collective I/O")
+
+    if(owned_buf) {
+        for(u = 0; u < nowned; u++)
+            H5MM_xfree(owned_buf[u]);
+        H5MM_xfree(owned_buf);
+    } /* end if */
+    if(send_buf) {
+        for(u = 0; u < nsent; u++)
+            H5MM_xfree(send_buf[u]);
+        H5MM_xfree(send_buf);
+    } /* end if */
+    H5MM_xfree(send_req);
+    H5MM_xfree(recv_buf);
+    H5MM_xfree(gath_buf);
+    H5MM_xfree(old_buf);
+    H5MM_xfree(seqs.seq);
+    H5MM_xfree(cover.seq);
+    H5MM_xfree(local);
+    H5MM_xfree(all);
+    H5MM_xfree(owned);
+    H5MM_xfree(written);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_collective_chunk_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_owned_addr_cmp
+ *
+ * Purpose:     Callback for qsort() to sort the chunks owned by a process
+ *              by address in the file.
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_owned_addr_cmp(const void *chunk1, const void *chunk2)
+{
+    const H5D_chunk_owned_t *c1 = (const H5D_chunk_owned_t *)chunk1;
+    const H5D_chunk_owned_t *c2 = (const H5D_chunk_owned_t *)chunk2;
+    int ret_value;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    ret_value = H5F_addr_cmp(c1->addr, c2->addr);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_owned_addr_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__owner_chunk_collective_write
+ *
+ * Purpose:     Collectively writes to a chunked dataset, with each chunk
+ *              written by a single process.
+ *
+ *              Every chunk touched by the write is given to a single
+ *              owner, the process that selected the most elements in it.
+ *              The other processes send their pieces of the chunk to the
+ *              owner with point-to-point messages, and the owner merges
+ *              all the pieces into one buffer for the chunk.  Every
+ *              process then writes the parts of its chunks that were
+ *              selected anywhere in a single collective operation, so
+ *              each chunk is written by one process in large, contiguous
+ *              runs instead of by every process that selected part of it.
+ *
+ *              Used when the application asks for it with
+ *              H5Pset_dxpl_mpio_chunk_opt(H5FD_MPIO_CHUNK_OWNER_IO).
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__owner_chunk_collective_write(H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_chunk_map_t *fm,
+    H5P_genplist_t *dx_plist)
+{
+    const H5D_t *dset = io_info->dset;  /* Dataset to write to */
+    MPI_Comm    comm = io_info->comm;   /* MPI communicator for file */
+    int         mpi_rank, mpi_size;     /* This process's rank & # of processes */
+    size_t      elmt_size = type_info->dst_type_size;   /* Size of each element */
+    size_t      chunk_size;             /* Size of chunk in bytes */
+    H5D_chunk_owner_rec_t *local = NULL;        /* Records for chunks selected locally */
+    H5D_chunk_owner_rec_t *all = NULL;          /* Records for chunks selected anywhere */
+    H5D_chunk_owned_t *owned = NULL;    /* Chunks owned locally */
+    uint8_t   **send_buf = NULL;        /* Messages for chunks owned elsewhere */
+    MPI_Request *send_req = NULL;       /* Requests for messages sent */
+    uint8_t    *recv_buf = NULL;        /* Buffer for messages received */
+    size_t      recv_buf_size = 0;      /* Size of receive buffer */
+    uint8_t    *gath_buf = NULL;        /* Buffer for elements gathered from memory */
+    size_t      gath_buf_size = 0;      /* Size of gather buffer */
+    H5D_chunk_seq_list_t seqs = {0, 0, NULL};   /* Sequences of a piece sent */
+    uint8_t    *wbuf = NULL;            /* Runs of the owned chunks, packed */
+    int        *run_lens = NULL;        /* Length of each run */
+    MPI_Aint   *run_disps = NULL;       /* Displacement of each run in the file */
+    size_t      nruns = 0;              /* # of runs written */
+    size_t      total = 0;              /* # of bytes written */
+    MPI_Datatype file_type = MPI_BYTE;  /* MPI description of the runs in the file */
+    MPI_Datatype buf_type = MPI_BYTE;   /* MPI description of the packed runs */
+    hbool_t     file_type_created = FALSE;  /* Whether file_type must be freed */
+    H5D_storage_t ctg_store;            /* Storage info for "fake" contiguous dataset */
+    H5D_storage_t *app_store = io_info->store;  /* Storage info from the caller */
+    const void *app_wbuf = io_info->u.wbuf;     /* Application's buffer */
+    uint8_t     dummy = 0;              /* Buffer for processes with nothing to write */
+    size_t      nlocal = 0, nall = 0, nowned = 0, nsent = 0;
+    size_t      u, v, w;                /* Local index variables */
+    H5D_mpio_actual_chunk_opt_mode_t actual_chunk_opt_mode = H5D_MPIO_LINK_CHUNK;  /* Actual chunk optimization mode */
+    H5D_mpio_actual_io_mode_t actual_io_mode = H5D_MPIO_CHUNK_COLLECTIVE; /* Actual I/O mode */
+    int         mpi_code;               /* MPI return code */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(io_info);
+    HDassert(type_info);
+    HDassert(fm);
+    HDassert(dx_plist);
+    HDassert(type_info->is_conv_noop && type_info->is_xform_noop);
+
+    if((mpi_rank = H5F_mpi_get_rank(dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi rank")
+    if((mpi_size = H5F_mpi_get_size(dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi size")
+
+    H5_ASSIGN_OVERFLOW(chunk_size, dset->shared->layout.u.chunk.size, uint32_t, size_t);
+
+    /* Find out which processes selected which chunks */
+    if(H5D__chunk_owner_local(fm, mpi_rank, &local, &nlocal) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to describe chunk selections")
+    if(H5D__chunk_owner_exchange(comm, mpi_size, local, nlocal, &all, &nall) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTRECV, FAIL, "unable to exchange chunk selections")
+
+    /* Allocate space for the chunks this process may own and the messages
+     *  it may send; neither can outnumber the chunks it selected.
+     */
+    if(NULL == (owned = (H5D_chunk_owned_t *)H5MM_calloc((nlocal + 1) * sizeof(H5D_chunk_owned_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate chunk records")
+    if(NULL == (send_buf = (uint8_t **)H5MM_calloc((nlocal + 1) * sizeof(uint8_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate message buffers")
+    if(NULL == (send_req = (MPI_Request *)H5MM_malloc((nlocal + 1) * sizeof(MPI_Request))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate message requests")
+
+    /* Send the pieces of chunks owned by other processes to their owners,
+     *  in chunk index order.
+     */
+    for(u = 0; u < nall; u = v) {
+        size_t owner = u;               /* Record of the owning process */
+        size_t mine = nall;             /* Record for this process */
+
+        /* Find the owner & this process's part of the chunk */
+        for(v = u; v < nall && all[v].index == all[u].index; v++) {
+            if(all[v].npoints > all[owner].npoints)
+                owner = v;
+            if(all[v].rank == mpi_rank)
+                mine = v;
+        } /* end for */
+
+        if(mine == owner) {
+            /* Remember the chunk, for assembly below */
+            owned[nowned].index = all[owner].index;
+            HDmemcpy(owned[nowned].coords, all[owner].coords, sizeof(owned[nowned].coords));
+            nowned++;
+        } /* end if */
+        else if(mine < nall) {
+            H5D_chunk_info_t *chunk_info;   /* Chunk info for the chunk */
+
+            if(NULL == (chunk_info = (H5D_chunk_info_t *)H5SL_search(fm->sel_chunks, &all[mine].index)))
+                HGOTO_ERROR(H5E_DATASET, H5E_NOTFOUND, FAIL, "can't locate chunk in skip list")
+            if(H5D__chunk_piece_send(io_info, chunk_info, elmt_size, all[owner].rank, &seqs, &send_buf[nsent], &send_req[nsent]) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_MPI, FAIL, "unable to send piece of chunk to its owner")
+            nsent++;
+        } /* end if */
+    } /* end for */
+
+    /* Assemble the chunks owned by this process, recording which parts of
+     *  each chunk were selected by any process.
+     */
+    for(u = 0, v = 0; u < nowned; u++) {
+        H5D_chunk_info_t *chunk_info;   /* Chunk info for the chunk */
+        H5D_chunk_ud_t udata;           /* Chunk index info */
+        H5D_chunk_seq_list_t *cover = &owned[u].cover;  /* Parts of chunk written */
+
+        /* Look up the chunk in the file */
+        if(H5D__chunk_lookup(dset, io_info->dxpl_id, owned[u].coords, owned[u].index, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        if(!H5F_addr_defined(udata.addr))
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "chunk storage not allocated")
+        owned[u].addr = udata.addr;
+
+        if(NULL == (owned[u].buf = (uint8_t *)H5MM_malloc(chunk_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+
+        /* Copy in the elements selected by this process */
+        if(NULL == (chunk_info = (H5D_chunk_info_t *)H5SL_search(fm->sel_chunks, &owned[u].index)))
+            HGOTO_ERROR(H5E_DATASET, H5E_NOTFOUND, FAIL, "can't locate chunk in skip list")
+        if(H5D__chunk_piece_copy(io_info, chunk_info, elmt_size, &gath_buf, &gath_buf_size, owned[u].buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "unable to copy elements into chunk")
+        if(H5D__chunk_piece_seqs(chunk_info->fspace, elmt_size, (size_t)chunk_info->chunk_points, cover) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to describe selection in chunk")
+
+        /* Apply the pieces sent by the other processes that selected the chunk */
+        while(v < nall && all[v].index < owned[u].index)
+            v++;
+        for(; v < nall && all[v].index == owned[u].index; v++)
+            if(all[v].rank != mpi_rank)
+                if(H5D__chunk_piece_recv(comm, all[v].rank, &recv_buf, &recv_buf_size, owned[u].buf, chunk_size, cover) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTRECV, FAIL, "unable to receive piece of chunk")
+
+        /* Merge the parts written into sorted, disjoint runs */
+        H5D__chunk_seq_list_merge(cover);
+        nruns += cover->nseq;
+    } /* end for */
+
+    /* Pack the runs of the owned chunks, in file order, and describe
+     *  where they go in the file.
+     */
+    if(nowned > 0) {
+        haddr_t base_addr;              /* Address of the first chunk */
+        size_t r = 0;                   /* Index of run */
+        uint8_t *p;                     /* Pointer into packed buffer */
+
+        HDqsort(owned, nowned, sizeof(H5D_chunk_owned_t), H5D__chunk_owned_addr_cmp);
+        base_addr = owned[0].addr;
+
+        for(u = 0; u < nowned; u++)
+            for(w = 0; w < owned[u].cover.nseq; w++)
+                total += (size_t)owned[u].cover.seq[w].len;
+
+        if(NULL == (wbuf = (uint8_t *)H5MM_malloc(total)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate write buffer")
+        if(NULL == (run_lens = (int *)H5MM_malloc(nruns * sizeof(int))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate run lengths")
+        if(NULL == (run_disps = (MPI_Aint *)H5MM_malloc(nruns * sizeof(MPI_Aint))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate run displacements")
+
+        for(u = 0, p = wbuf; u < nowned; u++) {
+            for(w = 0; w < owned[u].cover.nseq; w++, r++) {
+                const H5D_chunk_seq_t *seq = &owned[u].cover.seq[w];
+
+                HDmemcpy(p, owned[u].buf + seq->off, (size_t)seq->len);
+                p += seq->len;
+                H5_ASSIGN_OVERFLOW(run_lens[r], seq->len, hsize_t, int);
+                run_disps[r] = (MPI_Aint)((owned[u].addr - base_addr) + seq->off);
+            } /* end for */
+
+            /* The chunk's buffer is not needed once its runs are packed */
+            owned[u].buf = (uint8_t *)H5MM_xfree(owned[u].buf);
+        } /* end for */
+        HDassert(r == nruns);
+
+        H5_CHECK_OVERFLOW(nruns, size_t, int);
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_create_hindexed((int)nruns, run_lens, run_disps, MPI_BYTE, &file_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_create_hindexed failed", mpi_code)
+        file_type_created = TRUE;
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_commit(&file_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_commit failed", mpi_code)
+
+        ctg_store.contig.dset_addr = base_addr;
+    } /* end if */
+    else
+        /* No chunks owned by this process, but it still takes part in the
+         *  collective write.
+         */
+        ctg_store.contig.dset_addr = 0;
+
+    /* Write the owned chunks of all processes in one collective operation */
+    io_info->store = &ctg_store;
+    io_info->u.wbuf = (wbuf ? (const void *)wbuf : (const void *)&dummy);
+    if(H5D__final_collective_io(io_info, type_info, (hsize_t)total, &file_type, &buf_type) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "couldn't finish MPI-IO")
+
+    /* Make sure the pieces sent have been received */
+    if(nsent > 0)
+        if(MPI_SUCCESS != (mpi_code = MPI_Waitall((int)nsent, send_req, MPI_STATUSES_IGNORE)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Waitall failed", mpi_code)
+
+    /* Set the actual chunk opt mode & io mode properties */
+    if(H5P_set(dx_plist, H5D_MPIO_ACTUAL_CHUNK_OPT_MODE_NAME, &actual_chunk_opt_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "couldn't set actual chunk opt mode property")
+    if(H5P_set(dx_plist, H5D_MPIO_ACTUAL_IO_MODE_NAME, &actual_io_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "couldn't set actual io mode property")
+
+done:
+    /* Restore the caller's storage info & buffer */
+    io_info->store = app_store;
+    io_info->u.wbuf = app_wbuf;
+
+    if(file_type_created && MPI_SUCCESS != (mpi_code = MPI_Type_free(&file_type)))
+        HMPI_DONE_ERROR(FAIL, "MPI_Type_free failed", mpi_code)
+    if(owned) {
+        for(u = 0; u < nowned; u++) {
+            H5MM_xfree(owned[u].buf);
+            H5MM_xfree(owned[u].cover.seq);
+        } /* end for */
+        H5MM_xfree(owned);
+    } /* end if */
+    if(send_buf) {
+        for(u = 0; u < nsent; u++)
+            H5MM_xfree(send_buf[u]);
+        H5MM_xfree(send_buf);
+    } /* end if */
+    H5MM_xfree(send_req);
+    H5MM_xfree(recv_buf);
+    H5MM_xfree(gath_buf);
+    H5MM_xfree(seqs.seq);
+    H5MM_xfree(wbuf);
+    H5MM_xfree(run_lens);
+    H5MM_xfree(run_disps);
+    H5MM_xfree(local);
+    H5MM_xfree(all);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__owner_chunk_collective_write() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__link_chunk_collective_io
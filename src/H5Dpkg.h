@@ -504,6 +504,9 @@ typedef struct H5D_rdcc_ent_t {
 } H5D_rdcc_ent_t;
 typedef H5D_rdcc_ent_t *H5D_rdcc_ent_ptr_t; /* For free lists */
 
+/* Asynchronous I/O request (defined in H5Dasync.c) */
+typedef struct H5D_request_t H5D_request_t;
+
 
 /*****************************/
 /* Package Private Variables */
@@ -531,6 +534,9 @@ H5_DLL H5D_t *H5D__create(H5F_t *file, hid_t type_id, const H5S_t *space,
 H5_DLL H5D_t *H5D__create_named(const H5G_loc_t *loc, const char *name,
     hid_t type_id, const H5S_t *space, hid_t lcpl_id, hid_t dcpl_id,
     hid_t dapl_id, hid_t dxpl_id);
+H5_DLL herr_t H5D__create_multi(const H5G_loc_t *loc, size_t count,
+    const char *name[], hid_t type_id, const H5S_t *space, hid_t lcpl_id,
+    hid_t dcpl_id, hid_t dapl_id, hid_t dxpl_id, H5D_t *dset[]);
 H5_DLL herr_t H5D__get_space_status(H5D_t *dset, H5D_space_status_t *allocation,
     hid_t dxpl_id);
 H5_DLL herr_t H5D__alloc_storage(const H5D_t *dset, hid_t dxpl_id, H5D_time_alloc_t time_alloc,
@@ -553,6 +559,12 @@ H5_DLL herr_t H5D__flush_real(H5D_t *dataset, hid_t dxpl_id);
 H5_DLL herr_t H5D__read(H5D_t *dataset, hid_t mem_type_id,
     const H5S_t *mem_space, const H5S_t *file_space, hid_t dset_xfer_plist,
     void *buf/*out*/);
+H5_DLL herr_t H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id,
+    const H5S_t *mem_space, const H5S_t *file_space, hid_t dxpl_id, const void *buf);
+
+/* Asynchronous I/O request routines */
+H5_DLL herr_t H5D__request_free(H5D_request_t *req);
+H5_DLL herr_t H5D__request_term(void);
 
 /* Functions that perform direct serial I/O operations */
 H5_DLL herr_t H5D__select_read(const H5D_io_info_t *io_info,
@@ -566,6 +578,9 @@ H5_DLL herr_t H5D__select_write(const H5D_io_info_t *io_info,
 H5_DLL herr_t H5D__scatter_mem(const void *_tscat_buf,
     const H5S_t *space, H5S_sel_iter_t *iter, size_t nelmts,
     const H5D_dxpl_cache_t *dxpl_cache, void *_buf);
+H5_DLL size_t H5D__gather_mem(const void *_buf,
+    const H5S_t *space, H5S_sel_iter_t *iter, size_t nelmts,
+    const H5D_dxpl_cache_t *dxpl_cache, void *_tgath_buf);
 H5_DLL herr_t H5D__scatgath_read(const H5D_io_info_t *io_info,
     const H5D_type_info_t *type_info,
     hsize_t nelmts, const H5S_t *file_space, const H5S_t *mem_space);
@@ -697,6 +712,11 @@ H5_DLL herr_t H5D__chunk_collective_read(H5D_io_info_t *io_info,
 H5_DLL herr_t H5D__chunk_collective_write(H5D_io_info_t *io_info,
     const H5D_type_info_t *type_info, hsize_t nelmts, const H5S_t *file_space,
     const H5S_t *mem_space, H5D_chunk_map_t *fm);
+H5_DLL herr_t H5D__chunk_lookup_uncached(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, const hsize_t *chunk_offset,
+    hsize_t chunk_idx, H5D_chunk_ud_t *udata);
+H5_DLL herr_t H5D__chunk_reinsert(const H5D_t *dset, hid_t dxpl_id,
+    H5D_chunk_ud_t *udata, uint32_t nbytes, unsigned filter_mask);
 
 /* MPI-IO function to check if a direct I/O transfer is possible between
  * memory and the file */
@@ -92,6 +92,14 @@ typedef enum H5D_fill_value_t {
     H5D_FILL_VALUE_USER_DEFINED =2
 } H5D_fill_value_t;
 
+/* Values for the status of an asynchronous I/O request */
+typedef enum H5D_request_status_t {
+    H5D_REQUEST_IN_PROGRESS     =0,     /* Queued or executing          */
+    H5D_REQUEST_SUCCEEDED       =1,     /* Completed successfully       */
+    H5D_REQUEST_FAILED          =2,     /* Completed with an error      */
+    H5D_REQUEST_CANCELED        =3      /* Canceled before it started   */
+} H5D_request_status_t;
+
 /********************/
 /* Public Variables */
 /********************/
@@ -118,6 +126,9 @@ typedef herr_t (*H5D_gather_func_t)(const void *dst_buf,
 
 H5_DLL hid_t H5Dcreate2(hid_t loc_id, const char *name, hid_t type_id,
     hid_t space_id, hid_t lcpl_id, hid_t dcpl_id, hid_t dapl_id);
+H5_DLL herr_t H5Dcreate_multi(hid_t loc_id, size_t count, const char *name[],
+    hid_t type_id, hid_t space_id, hid_t lcpl_id, hid_t dcpl_id,
+    hid_t dapl_id, hid_t dset_id[]/*out*/);
 H5_DLL hid_t H5Dcreate_anon(hid_t file_id, hid_t type_id, hid_t space_id,
     hid_t plist_id, hid_t dapl_id);
 H5_DLL hid_t H5Dopen2(hid_t file_id, const char *name, hid_t dapl_id);
@@ -133,6 +144,20 @@ H5_DLL herr_t H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			hid_t file_space_id, hid_t plist_id, void *buf/*out*/);
 H5_DLL herr_t H5Dwrite(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			 hid_t file_space_id, hid_t plist_id, const void *buf);
+H5_DLL herr_t H5Dread_multi(size_t count, const hid_t dset_id[],
+    const hid_t mem_type_id[], const hid_t mem_space_id[],
+    const hid_t file_space_id[], hid_t plist_id, void *buf[]/*out*/);
+H5_DLL herr_t H5Dwrite_multi(size_t count, const hid_t dset_id[],
+    const hid_t mem_type_id[], const hid_t mem_space_id[],
+    const hid_t file_space_id[], hid_t plist_id, const void *buf[]);
+H5_DLL hid_t H5Dread_async(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
+    hid_t file_space_id, hid_t plist_id, void *buf/*out*/);
+H5_DLL hid_t H5Dwrite_async(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
+    hid_t file_space_id, hid_t plist_id, const void *buf);
+H5_DLL herr_t H5Drequest_test(hid_t req_id, H5D_request_status_t *status/*out*/);
+H5_DLL herr_t H5Drequest_wait(hid_t req_id, H5D_request_status_t *status/*out*/);
+H5_DLL herr_t H5Drequest_cancel(hid_t req_id, H5D_request_status_t *status/*out*/);
+H5_DLL herr_t H5Drequest_close(hid_t req_id);
 H5_DLL herr_t H5Diterate(void *buf, hid_t type_id, hid_t space_id,
             H5D_operator_t op, void *operator_data);
 H5_DLL herr_t H5Dvlen_reclaim(hid_t type_id, hid_t space_id, hid_t plist_id, void *buf);
@@ -602,7 +602,10 @@ H5Fopen(const char *filename, unsigned flags, hid_t fapl_id)
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not file access property list")
 
     /* Open the file */
-    if(NULL == (new_file = H5F_open(filename, flags, H5P_FILE_CREATE_DEFAULT, fapl_id, H5AC_dxpl_id)))
+    /* (Use the collective open dxpl, so metadata can be read by one process
+     *  and broadcast, if the FAPL requests it)
+     */
+    if(NULL == (new_file = H5F_open(filename, flags, H5P_FILE_CREATE_DEFAULT, fapl_id, H5AC_coll_read_dxpl_id)))
 	HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, FAIL, "unable to open file")
 
     /* Get an atom for the file */
@@ -700,6 +703,7 @@ H5Fflush(hid_t object_id, H5F_scope_t scope)
         case H5I_ERROR_CLASS:
         case H5I_ERROR_MSG:
         case H5I_ERROR_STACK:
+        case H5I_REQUEST:
         case H5I_NTYPES:
         default:
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file or file object")
@@ -713,6 +717,10 @@ H5Fflush(hid_t object_id, H5F_scope_t scope)
     if(!f)
 	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "object is not associated with a file")
 
+    /* Complete the asynchronous requests made on the file before the flush */
+    if(H5D_request_drain(f) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTOPERATE, FAIL, "can't complete asynchronous requests")
+
     /* Flush the file */
     /*
      * Nothing to do if the file is read only.	This determination is
@@ -781,6 +789,11 @@ H5Fclose(hid_t file_id)
      * disabled by an option/property to improve performance. */
     if(NULL == (f = (H5F_t *)H5I_object(file_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid file identifier")
+
+    /* Complete the asynchronous requests made on the file before closing it */
+    if(H5D_request_drain(f) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTOPERATE, FAIL, "can't complete asynchronous requests")
+
     if((f->shared->nrefs > 1) && (H5F_INTENT(f) & H5F_ACC_RDWR)) {
         if((nref = H5I_get_ref(file_id, FALSE)) < 0)
             HGOTO_ERROR(H5E_ATOM, H5E_CANTGET, FAIL, "can't get ID ref count")
@@ -1077,6 +1090,7 @@ herr_t
 H5Fget_mdc_config(hid_t file_id, H5AC_cache_config_t *config_ptr)
 {
     H5F_t      *file;                   /* File object for file ID */
+    H5AC_cache_config_t config;         /* Current version of configuration */
     herr_t     ret_value = SUCCEED;     /* Return value */
 
     FUNC_ENTER_API(FAIL)
@@ -1085,12 +1099,17 @@ H5Fget_mdc_config(hid_t file_id, H5AC_cache_config_t *config_ptr)
     /* Check args */
     if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a file ID")
-    if((NULL == config_ptr) || (config_ptr->version != H5AC__CURR_CACHE_CONFIG_VERSION))
+    if((NULL == config_ptr) || ((config_ptr->version != H5AC__CURR_CACHE_CONFIG_VERSION)
+            && (config_ptr->version != H5AC__CACHE_CONFIG_VERSION_1)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Bad config_ptr")
 
-    /* Go get the resize configuration */
-    if(H5AC_get_cache_auto_resize_config(file->shared->cache, config_ptr) < 0)
+    /* Go get the resize configuration, in the version of the caller's
+     * structure */
+    config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    if(H5AC_get_cache_auto_resize_config(file->shared->cache, &config) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5AC_get_cache_auto_resize_config() failed.")
+    if(H5AC_config_from_current(&config, config_ptr) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Bad config_ptr")
 
 done:
     FUNC_LEAVE_API(ret_value)
@@ -1116,6 +1135,7 @@ herr_t
 H5Fset_mdc_config(hid_t file_id, H5AC_cache_config_t *config_ptr)
 {
     H5F_t      *file;                   /* File object for file ID */
+    H5AC_cache_config_t config;         /* Current version of configuration */
     herr_t     ret_value = SUCCEED;     /* Return value */
 
     FUNC_ENTER_API(FAIL)
@@ -1124,9 +1144,13 @@ H5Fset_mdc_config(hid_t file_id, H5AC_cache_config_t *config_ptr)
     /* Check args */
     if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
          HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a file ID")
+    if(NULL == config_ptr)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "NULL config_ptr on entry.")
 
-    /* set the resize configuration  */
-    if(H5AC_set_cache_auto_resize_config(file->shared->cache, config_ptr) < 0)
+    /* set the resize configuration, translated to the current version */
+    if(H5AC_config_to_current(config_ptr, &config) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Unknown config version.")
+    if(H5AC_set_cache_auto_resize_config(file->shared->cache, &config) < 0)
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "H5AC_set_cache_auto_resize_config() failed.")
 
 done:
@@ -31,6 +31,7 @@
 
 
 #include "H5private.h"      /* Generic Functions    */
+#include "H5ACprivate.h"    /* Metadata cache       */
 #include "H5Eprivate.h"     /* Error handling       */
 #include "H5Fprivate.h"     /* File access          */
 #include "H5FDprivate.h"    /* File drivers         */
@@ -139,6 +140,10 @@ typedef struct H5FD_log_t {
     double              total_seek_time;        /* Total time spent in seek operations              */
     size_t              iosize;                 /* Size of I/O information buffers                  */
     FILE                *logfp;                 /* Log file pointer                                 */
+    FILE                *tracefp;               /* Binary trace file pointer                        */
+#ifdef H5_HAVE_GETTIMEOFDAY
+    struct timeval      trace_start;            /* Time the file was opened, for trace timestamps   */
+#endif /* H5_HAVE_GETTIMEOFDAY */
     H5FD_log_fapl_t     fa;                     /* Driver-specific file access properties           */
 } H5FD_log_t;
 
@@ -184,6 +189,10 @@ static herr_t H5FD_log_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr
 static herr_t H5FD_log_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
             size_t size, const void *buf);
 static herr_t H5FD_log_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
+static herr_t H5FD_log_trace_open(H5FD_log_t *file);
+static herr_t H5FD_log_trace(H5FD_log_t *file, H5FD_log_trace_op_t op,
+            H5FD_mem_t type, hid_t dxpl_id, haddr_t addr, hsize_t size,
+            double elapsed);
 
 static const H5FD_class_t H5FD_log_g = {
     "log",					/*name			*/
@@ -639,6 +648,10 @@ H5FD_log_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
             HDfprintf(file->logfp, "Stat took: (%f s)\n", (double)stat_timeval_diff.tv_sec + ((double)stat_timeval_diff.tv_usec / (double)1000000.0f));
 #endif /* H5_HAVE_GETTIMEOFDAY */
 
+        /* Create the binary trace file */
+        if(file->fa.flags & H5FD_LOG_TRACE)
+            if(H5FD_log_trace_open(file) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to create binary trace file")
     } /* end if */
 
     /* Check for non-default FAPL */
@@ -660,8 +673,18 @@ done:
     if(NULL == ret_value) {
         if(fd >= 0)
             HDclose(fd);
-        if(file)
+        if(file) {
+            if(file->tracefp)
+                HDfclose(file->tracefp);
+            if(file->logfp && file->logfp != stderr)
+                HDfclose(file->logfp);
+            H5MM_xfree(file->nread);
+            H5MM_xfree(file->nwrite);
+            H5MM_xfree(file->flavor);
+            if(file->fa.logfile)
+                HDfree(file->fa.logfile);
             file = H5FL_FREE(H5FD_log_t, file);
+        } /* end if */
     } /* end if */
 
     FUNC_LEAVE_NOAPI(ret_value)
@@ -806,6 +829,8 @@ H5FD_log_close(H5FD_t *_file)
             file->flavor = (unsigned char *)H5MM_xfree(file->flavor);
         if(file->logfp != stderr)
             HDfclose(file->logfp);
+        if(file->tracefp)
+            HDfclose(file->tracefp);
     } /* end if */
 
     if(file->fa.logfile) {
@@ -934,13 +959,13 @@ H5FD_log_query(const H5FD_t *_file, unsigned long *flags /* out */)
  *-------------------------------------------------------------------------
  */
 static haddr_t
-H5FD_log_alloc(H5FD_t *_file, H5FD_mem_t type, hid_t UNUSED dxpl_id, hsize_t size)
+H5FD_log_alloc(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, hsize_t size)
 {
     H5FD_log_t	*file = (H5FD_log_t *)_file;
     haddr_t addr;
-    haddr_t ret_value;          /* Return value */
+    haddr_t ret_value = HADDR_UNDEF;    /* Return value */
 
-    FUNC_ENTER_NOAPI_NOINIT_NOERR
+    FUNC_ENTER_NOAPI_NOINIT
 
     /* Compute the address for the block to allocate */
     addr = file->eoa;
@@ -964,11 +989,17 @@ H5FD_log_alloc(H5FD_t *_file, H5FD_mem_t type, hid_t UNUSED dxpl_id, hsize_t siz
 
         if(file->fa.flags & H5FD_LOG_ALLOC)
             HDfprintf(file->logfp, "%10a-%10a (%10Hu bytes) (%s) Allocated\n", addr, (addr + size) - 1, size, flavors[type]);
+
+        /* Record the new EOA in the binary trace */
+        if(file->fa.flags & H5FD_LOG_TRACE)
+            if(H5FD_log_trace(file, H5FD_LOG_TRACE_OP_EOA, type, dxpl_id, file->eoa, size, 0.0) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, HADDR_UNDEF, "unable to record allocation in binary trace")
     } /* end if */
 
     /* Set return value */
     ret_value = addr;
 
+done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_log_alloc() */
 
@@ -1006,7 +1037,7 @@ H5FD_log_get_eoa(const H5FD_t *_file, H5FD_mem_t UNUSED type)
  *              called shortly after an existing HDF5 file is opened in order
  *              to tell the driver where the end of the HDF5 data is located.
  *
- * Return:      SUCCEED (Can't fail)
+ * Return:      Non-negative on success/Negative on failure
  *
  * Programmer:  Robb Matzke
  *              Thursday, July 29, 1999
@@ -1017,8 +1048,9 @@ static herr_t
 H5FD_log_set_eoa(H5FD_t *_file, H5FD_mem_t type, haddr_t addr)
 {
     H5FD_log_t  *file = (H5FD_log_t *)_file;
+    herr_t      ret_value = SUCCEED;    /* Return value */
 
-    FUNC_ENTER_NOAPI_NOINIT_NOERR
+    FUNC_ENTER_NOAPI_NOINIT
 
     if(file->fa.flags != 0) {
         if(H5F_addr_gt(addr, file->eoa) && H5F_addr_gt(addr, 0)) {
@@ -1035,11 +1067,17 @@ H5FD_log_set_eoa(H5FD_t *_file, H5FD_mem_t type, haddr_t addr)
             if(file->fa.flags & H5FD_LOG_ALLOC)
                 HDfprintf(file->logfp, "%10a-%10a (%10Hu bytes) (%s) Allocated\n", file->eoa, addr, size, flavors[type]);
         } /* end if */
+
+        /* Record the new EOA in the binary trace */
+        if(file->fa.flags & H5FD_LOG_TRACE)
+            if(H5FD_log_trace(file, H5FD_LOG_TRACE_OP_EOA, type, H5P_DEFAULT, addr, (hsize_t)0, 0.0) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "unable to record new EOA in binary trace")
     } /* end if */
 
     file->eoa = addr;
 
-    FUNC_LEAVE_NOAPI(SUCCEED)
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_log_set_eoa() */
 
 
@@ -1118,7 +1156,7 @@ done:
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5FD_log_read(H5FD_t *_file, H5FD_mem_t type, hid_t UNUSED dxpl_id, haddr_t addr,
+H5FD_log_read(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, haddr_t addr,
             size_t size, void *buf/*out*/)
 {
     H5FD_log_t          *file = (H5FD_log_t *)_file;
@@ -1204,7 +1242,7 @@ H5FD_log_read(H5FD_t *_file, H5FD_mem_t type, hid_t UNUSED dxpl_id, haddr_t addr
      * and the end of the file.
      */
 #ifdef H5_HAVE_GETTIMEOFDAY
-    if(file->fa.flags & H5FD_LOG_TIME_READ)
+    if(file->fa.flags & (H5FD_LOG_TIME_READ | H5FD_LOG_TRACE))
         HDgettimeofday(&timeval_start, NULL);
 #endif /* H5_HAVE_GETTIMEOFDAY */
     while(size > 0) {
@@ -1250,7 +1288,7 @@ H5FD_log_read(H5FD_t *_file, H5FD_mem_t type, hid_t UNUSED dxpl_id, haddr_t addr
 
     } /* end while */
 #ifdef H5_HAVE_GETTIMEOFDAY
-    if(file->fa.flags & H5FD_LOG_TIME_READ)
+    if(file->fa.flags & (H5FD_LOG_TIME_READ | H5FD_LOG_TRACE))
         HDgettimeofday(&timeval_stop, NULL);
 #endif /* H5_HAVE_GETTIMEOFDAY */
 
@@ -1287,6 +1325,25 @@ H5FD_log_read(H5FD_t *_file, H5FD_mem_t type, hid_t UNUSED dxpl_id, haddr_t addr
 #endif /* H5_HAVE_GETTIMEOFDAY */
     } /* end if */
 
+    /* Record the read in the binary trace */
+    if(file->fa.flags & H5FD_LOG_TRACE) {
+        double time_diff = 0.0;
+#ifdef H5_HAVE_GETTIMEOFDAY
+        struct timeval timeval_diff;
+
+        /* Calculate the elapsed gettimeofday time */
+        timeval_diff.tv_usec = timeval_stop.tv_usec - timeval_start.tv_usec;
+        timeval_diff.tv_sec = timeval_stop.tv_sec - timeval_start.tv_sec;
+        if(timeval_diff.tv_usec < 0) {
+            timeval_diff.tv_usec += 1000000;
+            timeval_diff.tv_sec--;
+        } /* end if */
+        time_diff = (double)timeval_diff.tv_sec + ((double)timeval_diff.tv_usec / (double)1000000.0f);
+#endif /* H5_HAVE_GETTIMEOFDAY */
+        if(H5FD_log_trace(file, H5FD_LOG_TRACE_OP_READ, type, dxpl_id, orig_addr, (hsize_t)orig_size, time_diff) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "unable to record read in binary trace")
+    } /* end if */
+
     /* Update current position */
     file->pos = addr;
     file->op = OP_READ;
@@ -1317,7 +1374,7 @@ done:
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5FD_log_write(H5FD_t *_file, H5FD_mem_t type, hid_t UNUSED dxpl_id, haddr_t addr,
+H5FD_log_write(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, haddr_t addr,
             size_t size, const void *buf)
 {
     H5FD_log_t          *file = (H5FD_log_t *)_file;
@@ -1408,7 +1465,7 @@ H5FD_log_write(H5FD_t *_file, H5FD_mem_t type, hid_t UNUSED dxpl_id, haddr_t add
      * results
      */
 #ifdef H5_HAVE_GETTIMEOFDAY
-    if(file->fa.flags&H5FD_LOG_TIME_WRITE)
+    if(file->fa.flags & (H5FD_LOG_TIME_WRITE | H5FD_LOG_TRACE))
         HDgettimeofday(&timeval_start, NULL);
 #endif /* H5_HAVE_GETTIMEOFDAY */
     while(size > 0) {
@@ -1447,7 +1504,7 @@ H5FD_log_write(H5FD_t *_file, H5FD_mem_t type, hid_t UNUSED dxpl_id, haddr_t add
         buf = (const char *)buf + bytes_wrote;
     } /* end while */
 #ifdef H5_HAVE_GETTIMEOFDAY
-    if(file->fa.flags & H5FD_LOG_TIME_WRITE)
+    if(file->fa.flags & (H5FD_LOG_TIME_WRITE | H5FD_LOG_TRACE))
         HDgettimeofday(&timeval_stop, NULL);
 #endif /* H5_HAVE_GETTIMEOFDAY */
 
@@ -1488,6 +1545,25 @@ H5FD_log_write(H5FD_t *_file, H5FD_mem_t type, hid_t UNUSED dxpl_id, haddr_t add
 #endif /* H5_HAVE_GETTIMEOFDAY */
     } /* end if */
 
+    /* Record the write in the binary trace */
+    if(file->fa.flags & H5FD_LOG_TRACE) {
+        double time_diff = 0.0;
+#ifdef H5_HAVE_GETTIMEOFDAY
+        struct timeval timeval_diff;
+
+        /* Calculate the elapsed gettimeofday time */
+        timeval_diff.tv_usec = timeval_stop.tv_usec - timeval_start.tv_usec;
+        timeval_diff.tv_sec = timeval_stop.tv_sec - timeval_start.tv_sec;
+        if(timeval_diff.tv_usec < 0) {
+            timeval_diff.tv_usec += 1000000;
+            timeval_diff.tv_sec--;
+        } /* end if */
+        time_diff = (double)timeval_diff.tv_sec + ((double)timeval_diff.tv_usec / (double)1000000.0f);
+#endif /* H5_HAVE_GETTIMEOFDAY */
+        if(H5FD_log_trace(file, H5FD_LOG_TRACE_OP_WRITE, type, dxpl_id, orig_addr, (hsize_t)orig_size, time_diff) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "unable to record write in binary trace")
+    } /* end if */
+
     /* Update current position and eof */
     file->pos = addr;
     file->op = OP_WRITE;
@@ -1519,7 +1595,7 @@ done:
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5FD_log_truncate(H5FD_t *_file, hid_t UNUSED dxpl_id, hbool_t UNUSED closing)
+H5FD_log_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t UNUSED closing)
 {
     H5FD_log_t  *file = (H5FD_log_t *)_file;
     herr_t      ret_value = SUCCEED;                /* Return value */
@@ -1571,6 +1647,9 @@ H5FD_log_truncate(H5FD_t *_file, hid_t UNUSED dxpl_id, hbool_t UNUSED closing)
         /* Log information about the truncate */
         if(file->fa.flags & H5FD_LOG_NUM_TRUNCATE)
             file->total_truncate_ops++;
+        if(file->fa.flags & H5FD_LOG_TRACE)
+            if(H5FD_log_trace(file, H5FD_LOG_TRACE_OP_TRUNCATE, H5FD_MEM_DEFAULT, dxpl_id, file->eoa, (hsize_t)0, 0.0) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "unable to record truncate in binary trace")
 
         /* Update the eof value */
         file->eof = file->eoa;
@@ -1583,3 +1662,136 @@ H5FD_log_truncate(H5FD_t *_file, hid_t UNUSED dxpl_id, hbool_t UNUSED closing)
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_log_truncate() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_log_trace_open
+ *
+ * Purpose:     Creates the binary trace file for a file opened with the
+ *              H5FD_LOG_TRACE flag and writes its header.  The trace is
+ *              written to the log file name with H5FD_LOG_TRACE_SUFFIX
+ *              appended.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_log_trace_open(H5FD_log_t *file)
+{
+    char        *trace_name = NULL;     /* Name of the trace file */
+    size_t      name_len;               /* Length of the trace file name */
+    uint8_t     hdr[H5FD_LOG_TRACE_HDR_SIZE];   /* Encoded header */
+    uint8_t     *p;                     /* Pointer into header */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+    HDassert(NULL == file->tracefp);
+
+    /* The trace is binary, so it can't go to stderr along with the log */
+    if(NULL == file->fa.logfile)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "binary trace requires a log file name")
+
+    /* Build the name of the trace file */
+    name_len = HDstrlen(file->fa.logfile) + HDstrlen(H5FD_LOG_TRACE_SUFFIX) + 1;
+    if(NULL == (trace_name = (char *)H5MM_malloc(name_len)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate trace file name")
+    HDsnprintf(trace_name, name_len, "%s%s", file->fa.logfile, H5FD_LOG_TRACE_SUFFIX);
+
+    if(NULL == (file->tracefp = HDfopen(trace_name, "wb")))
+        HSYS_GOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, FAIL, "unable to create binary trace file")
+
+    /* Encode & write the header */
+    HDmemset(hdr, 0, sizeof(hdr));
+    p = hdr;
+    HDmemcpy(p, H5FD_LOG_TRACE_SIGNATURE, (size_t)H5FD_LOG_TRACE_SIGNATURE_LEN);
+    p += H5FD_LOG_TRACE_SIGNATURE_LEN;
+    *p++ = H5FD_LOG_TRACE_VERSION;
+    p += 3;     /* Reserved */
+    UINT32ENCODE(p, H5FD_LOG_TRACE_REC_SIZE);
+    if(HDfwrite(hdr, sizeof(hdr), (size_t)1, file->tracefp) != 1)
+        HSYS_GOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write binary trace header")
+
+#ifdef H5_HAVE_GETTIMEOFDAY
+    HDgettimeofday(&file->trace_start, NULL);
+#endif /* H5_HAVE_GETTIMEOFDAY */
+
+done:
+    H5MM_xfree(trace_name);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_log_trace_open() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_log_trace
+ *
+ * Purpose:     Appends a record for an operation to the binary trace.
+ *              The metadata cache tag (the address of the object header
+ *              that the I/O is on behalf of) is retrieved from DXPL_ID,
+ *              if it's a data transfer property list.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_log_trace(H5FD_log_t *file, H5FD_log_trace_op_t op, H5FD_mem_t type,
+    hid_t dxpl_id, haddr_t addr, hsize_t size, double elapsed)
+{
+    H5P_genplist_t *dxpl;                   /* Data transfer property list */
+    uint8_t     rec[H5FD_LOG_TRACE_REC_SIZE];   /* Encoded record */
+    uint8_t     *p;                         /* Pointer into record */
+    haddr_t     tag = H5AC__INVALID_TAG;    /* Metadata tag for the I/O */
+    uint64_t    start_us = 0;               /* Start of operation, in microseconds */
+    uint32_t    elapsed_us;                 /* Duration of operation, in microseconds */
+#ifdef H5_HAVE_GETTIMEOFDAY
+    struct timeval now;                     /* Current time */
+    double      since_open;                 /* Seconds since the file was opened */
+#endif /* H5_HAVE_GETTIMEOFDAY */
+    herr_t      ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+    HDassert(file->tracefp);
+
+    /* Retrieve the metadata tag, if there is one */
+    if(H5P_DEFAULT != dxpl_id && NULL != (dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        if(H5P_exist_plist(dxpl, H5AC_METADATA_TAG_NAME) > 0)
+            if(H5P_get(dxpl, H5AC_METADATA_TAG_NAME, &tag) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get metadata tag")
+
+    /* Compute the timestamps */
+    if(elapsed < 0.0)
+        elapsed = 0.0;
+    elapsed_us = (elapsed * 1000000.0) > (double)UINT_MAX ? UINT_MAX : (uint32_t)(elapsed * 1000000.0);
+#ifdef H5_HAVE_GETTIMEOFDAY
+    HDgettimeofday(&now, NULL);
+    since_open = (double)(now.tv_sec - file->trace_start.tv_sec) +
+            ((double)(now.tv_usec - file->trace_start.tv_usec) / (double)1000000.0f) - elapsed;
+    if(since_open > 0.0)
+        start_us = (uint64_t)(since_open * 1000000.0);
+#endif /* H5_HAVE_GETTIMEOFDAY */
+
+    /* Encode the record */
+    HDmemset(rec, 0, sizeof(rec));
+    p = rec;
+    *p++ = (uint8_t)op;
+    *p++ = (uint8_t)type;
+    p += 2;     /* Reserved */
+    UINT32ENCODE(p, elapsed_us);
+    UINT64ENCODE(p, addr);
+    UINT64ENCODE(p, size);
+    UINT64ENCODE(p, tag);
+    UINT64ENCODE(p, start_us);
+    HDassert((size_t)(p - rec) == sizeof(rec));
+
+    if(HDfwrite(rec, sizeof(rec), (size_t)1, file->tracefp) != 1)
+        HSYS_GOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write binary trace record")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_log_trace() */
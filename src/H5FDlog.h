@@ -53,6 +53,45 @@
 /* Flag for tracking allocation of space in file */
 #define H5FD_LOG_ALLOC      0x00010000
 #define H5FD_LOG_ALL        (H5FD_LOG_ALLOC|H5FD_LOG_TIME_IO|H5FD_LOG_NUM_IO|H5FD_LOG_FLAVOR|H5FD_LOG_FILE_IO|H5FD_LOG_LOC_IO)
+/* Flag for writing a binary trace of all I/O operations to "<logfile>.trace"
+ * (not part of H5FD_LOG_ALL, since it creates an additional file)
+ */
+#define H5FD_LOG_TRACE      0x00020000
+
+/* Binary trace file layout.  All values are encoded little-endian.
+ *
+ * Header (H5FD_LOG_TRACE_HDR_SIZE bytes):
+ *      4 bytes  - signature (H5FD_LOG_TRACE_SIGNATURE)
+ *      1 byte   - version (H5FD_LOG_TRACE_VERSION)
+ *      3 bytes  - reserved (zero)
+ *      4 bytes  - size of each record (H5FD_LOG_TRACE_REC_SIZE)
+ *      4 bytes  - reserved (zero)
+ *
+ * Each record (H5FD_LOG_TRACE_REC_SIZE bytes):
+ *      1 byte   - operation (H5FD_log_trace_op_t)
+ *      1 byte   - memory type of the I/O (H5FD_mem_t)
+ *      2 bytes  - reserved (zero)
+ *      4 bytes  - duration of the operation, in microseconds
+ *      8 bytes  - address of the I/O (new EOA for H5FD_LOG_TRACE_OP_EOA and
+ *                 H5FD_LOG_TRACE_OP_TRUNCATE records)
+ *      8 bytes  - size of the I/O
+ *      8 bytes  - metadata cache tag (object header address) in effect
+ *      8 bytes  - start of the operation, in microseconds since file open
+ */
+#define H5FD_LOG_TRACE_SIGNATURE    "H5TR"
+#define H5FD_LOG_TRACE_SIGNATURE_LEN 4
+#define H5FD_LOG_TRACE_VERSION      1
+#define H5FD_LOG_TRACE_HDR_SIZE     16
+#define H5FD_LOG_TRACE_REC_SIZE     40
+#define H5FD_LOG_TRACE_SUFFIX       ".trace"
+
+/* Operations recorded in the binary trace */
+typedef enum H5FD_log_trace_op_t {
+    H5FD_LOG_TRACE_OP_READ = 0,         /* Read from the file               */
+    H5FD_LOG_TRACE_OP_WRITE,            /* Write to the file                */
+    H5FD_LOG_TRACE_OP_EOA,              /* Change of end-of-allocated-space */
+    H5FD_LOG_TRACE_OP_TRUNCATE          /* Truncate/extend file to the EOA  */
+} H5FD_log_trace_op_t;
 
 #ifdef __cplusplus
 extern "C" {
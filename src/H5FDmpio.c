@@ -596,6 +596,12 @@ done:
  *		The library won't behave as it asks for only when we find
  *		that the low-level MPI-IO package doesn't support this.
  *
+ *		With H5FD_MPIO_CHUNK_OWNER_IO, collective writes give each
+ *		chunk to the process that selected most of it.  The other
+ *		processes send it their parts of the chunk, and the owners
+ *		then write all their chunks in one collective operation.
+ *		Reads are done as for H5FD_MPIO_CHUNK_DEFAULT.
+ *
  * Return:	Success:	Non-negative
  * 		Failure:	Negative
  *
@@ -467,6 +467,7 @@ H5F_get_objects_cb(void *obj_ptr, hid_t obj_id, void *key)
 	    case H5I_ERROR_CLASS:
 	    case H5I_ERROR_MSG:
 	    case H5I_ERROR_STACK:
+	    case H5I_REQUEST:
 	    case H5I_NTYPES:
             default:
                 HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, H5_ITER_ERROR, "unknown data object")
@@ -596,6 +597,7 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
     else {
         H5P_genplist_t *plist;          /* Property list */
         unsigned        efc_size;       /* External file cache size */
+        double          mdc_bg_flush;   /* Metadata cache background flush threshold */
         size_t u;                       /* Local index variable */
 
         HDassert(lf != NULL);
@@ -661,6 +663,12 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
         f->shared->sdata_aggr.feature_flag = H5FD_FEAT_AGGREGATE_SMALLDATA;
         if(H5P_get(plist, H5F_ACS_EFC_SIZE_NAME, &efc_size) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get elink file cache size")
+        if(H5P_get(plist, H5F_ACS_MDC_BG_FLUSH_NAME, &mdc_bg_flush) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata cache background flush threshold")
+#ifdef H5_HAVE_PARALLEL
+        if(H5P_get(plist, H5F_ACS_COLL_MD_READ_NAME, &(f->shared->coll_md_read)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get collective metadata read flag")
+#endif /* H5_HAVE_PARALLEL */
         if(efc_size > 0)
             if(NULL == (f->shared->efc = H5F_efc_create(efc_size)))
                 HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "can't create external file cache")
@@ -695,6 +703,13 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
 	if(H5AC_create(f, &(f->shared->mdc_initCacheCfg)) < 0)
 	    HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "unable to create metadata cache")
 
+        /* Set up writing dirty metadata ahead of need.  (Not for parallel
+         *      I/O, where the cache is only flushed collectively)
+         */
+        if(mdc_bg_flush > 0.0f && !H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+            if(H5AC_set_bg_flush_threshold(f->shared->cache, mdc_bg_flush) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "unable to set metadata cache background flush threshold")
+
         /* Create the file's "open object" information */
         if(H5FO_create(f) < 0)
 	    HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "unable to create open object data structure")
@@ -760,6 +775,12 @@ H5F_dest(H5F_t *f, hid_t dxpl_id, hbool_t flush)
     HDassert(f);
     HDassert(f->shared);
 
+    /* Make sure no background flush pass runs on the file after this */
+    if(f->shared->cache)
+        if(H5AC_bg_flush_cancel(f) < 0)
+            /* Push error, but keep going*/
+            HDONE_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't cancel background flush")
+
     if(1 == f->shared->nrefs) {
         H5F_io_info_t fio_info;             /* I/O info for operation */
 
@@ -874,6 +895,12 @@ H5F_dest(H5F_t *f, hid_t dxpl_id, hbool_t flush)
         f->shared->mtab.child = (H5F_mount_t *)H5MM_xfree(f->shared->mtab.child);
         f->shared->mtab.nalloc = 0;
 
+#ifdef H5_HAVE_PARALLEL
+        /* Release buffers for collected metadata writes */
+        f->shared->md_coll.writes = (H5F_md_write_t *)H5MM_xfree(f->shared->md_coll.writes);
+        f->shared->md_coll.buf = (uint8_t *)H5MM_xfree(f->shared->md_coll.buf);
+#endif /* H5_HAVE_PARALLEL */
+
         /* Destroy shared file struct */
         f->shared = (H5F_file_t *)H5FL_FREE(H5F_file_t, f->shared);
 
@@ -97,6 +97,9 @@ H5F_block_read(const H5F_t *f, H5FD_mem_t type, haddr_t addr, size_t size,
     hid_t dxpl_id, void *buf/*out*/)
 {
     H5F_io_info_t fio_info;             /* I/O info for operation */
+#ifdef H5_HAVE_PARALLEL
+    htri_t      coll_read;              /* Whether to read on process 0 and broadcast */
+#endif /* H5_HAVE_PARALLEL */
     herr_t      ret_value = SUCCEED;    /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
@@ -115,10 +118,31 @@ H5F_block_read(const H5F_t *f, H5FD_mem_t type, haddr_t addr, size_t size,
     if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
 
+#ifdef H5_HAVE_PARALLEL
+    /* Check for metadata that all processes are reading collectively */
+    if((coll_read = H5F__coll_md_read_check(f, type, fio_info.dxpl)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "can't check for collective metadata read")
+    if(coll_read) {
+        herr_t read_status = SUCCEED;   /* Outcome of process 0's read */
+
+        /* Read on process 0 only and share the result */
+        if(0 == H5F_mpi_get_rank(f))
+            read_status = H5F__accum_read(&fio_info, type, addr, size, buf);
+        if(H5F__coll_md_read_bcast(f, read_status, buf, size) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "collective metadata read failed")
+    } /* end if */
+    else
+#endif /* H5_HAVE_PARALLEL */
     /* Pass through metadata accumulator layer */
     if(H5F__accum_read(&fio_info, type, addr, size, buf) < 0)
         HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through metadata accumulator failed")
 
+#ifdef H5_HAVE_PARALLEL
+    /* Pick up metadata written during a sync point but not yet in the file */
+    if(f->shared->md_coll.active && H5FD_MEM_DRAW != type)
+        H5F__coll_md_write_overlay(f, addr, size, buf);
+#endif /* H5_HAVE_PARALLEL */
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F_block_read() */
@@ -166,6 +190,15 @@ HDfprintf(stderr, "%s: write to addr = %a, size = %Zu\n", FUNC, addr, size);
     if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
 
+#ifdef H5_HAVE_PARALLEL
+    /* Hold metadata writes made during a sync point, to be written together */
+    if(f->shared->md_coll.active && H5FD_MEM_DRAW != type) {
+        if(H5F__coll_md_write_add(f, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "can't collect metadata write")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+#endif /* H5_HAVE_PARALLEL */
+
     /* Pass through metadata accumulator layer */
     if(H5F__accum_write(&fio_info, type, addr, size, buf) < 0)
         HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through metadata accumulator failed")
@@ -35,16 +35,25 @@
 /* Headers */
 /***********/
 #include "H5private.h"		/* Generic Functions			*/
+#include "H5Dprivate.h"		/* Datasets				*/
 #include "H5Eprivate.h"		/* Error handling		  	*/
 #include "H5Fpkg.h"             /* File access				*/
 #include "H5FDprivate.h"	/* File drivers				*/
 #include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5Pprivate.h"		/* Property lists			*/
 
 
 /****************/
 /* Local Macros */
 /****************/
 
+/* Initial number of collected metadata writes to allocate room for */
+#define H5F_MD_COLL_WRITES_INIT         64
+
+/* Initial size of the buffer for collected metadata write images */
+#define H5F_MD_COLL_BUF_INIT            (64 * 1024)
+
 
 /******************/
 /* Local Typedefs */
@@ -60,6 +69,11 @@
 /* Local Prototypes */
 /********************/
 
+#ifdef H5_HAVE_PARALLEL
+static int H5F_md_write_cmp_addr(const void *_w1, const void *_w2);
+static int H5F_md_write_cmp_issue(const void *_w1, const void *_w2);
+#endif /* H5_HAVE_PARALLEL */
+
 
 /*********************/
 /* Package Variables */
@@ -258,5 +272,432 @@ H5Fget_mpi_atomicity(hid_t file_id, hbool_t *flag)
 done:
     FUNC_LEAVE_API(ret_value)
 }
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__coll_md_read_check
+ *
+ * Purpose:	Determines whether a metadata read should be performed by
+ *		process 0 and broadcast to the other processes.  This is
+ *		only the case when the file was opened with collective
+ *		metadata reads enabled and the read is made on behalf of
+ *		a collective open (i.e. with H5AC_coll_read_dxpl_id).
+ *		H5AC_protect() turns the file's flag off while an entry
+ *		is loaded unless the entry is missing from every
+ *		process's cache, so that every process makes the read.
+ *
+ * Return:	Success:	TRUE/FALSE
+ *
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+htri_t
+H5F__coll_md_read_check(const H5F_t *f, H5FD_mem_t type, const H5P_genplist_t *dxpl)
+{
+    unsigned    coll_meta_read = 0;     /* "collective metadata read" property value */
+    htri_t      prop_exists;            /* Whether the property is in the dxpl */
+    htri_t      ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(dxpl);
+
+    /* Raw data is never read this way */
+    if(!f->shared->coll_md_read || H5FD_MEM_DRAW == type || !H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+        HGOTO_DONE(FALSE)
+
+    /* Only the library's collective open dxpl carries the property */
+    if((prop_exists = H5P_exist_plist(dxpl, H5AC_COLLECTIVE_META_READ_NAME)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't check for collective metadata read property")
+    if(prop_exists) {
+        if(H5P_get(dxpl, H5AC_COLLECTIVE_META_READ_NAME, &coll_meta_read) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get collective metadata read property")
+        ret_value = (htri_t)(coll_meta_read > 0);
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__coll_md_read_check() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__coll_md_read_bcast
+ *
+ * Purpose:	Completes a collective metadata read: broadcasts the
+ *		outcome of process 0's read, then the data itself, to all
+ *		processes in the file's communicator.  Must be called by
+ *		every process; READ_STATUS is only used on process 0.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__coll_md_read_bcast(const H5F_t *f, herr_t read_status, void *buf,
+    size_t size)
+{
+    MPI_Comm    comm;                   /* File's communicator */
+    int         mpi_rank;               /* This process's rank */
+    int         read_failed;            /* Whether process 0's read failed */
+    int         mpi_code;               /* MPI return code */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(f);
+    HDassert(buf);
+
+    if(MPI_COMM_NULL == (comm = H5F_mpi_get_comm(f)))
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "can't get MPI communicator")
+    if((mpi_rank = H5F_mpi_get_rank(f)) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "can't get MPI rank")
+
+    /* Let the other processes fail along with process 0, rather than
+     * decoding a buffer that was never filled in.
+     */
+    read_failed = (0 == mpi_rank && read_status < 0);
+    if(MPI_SUCCESS != (mpi_code = MPI_Bcast(&read_failed, 1, MPI_INT, 0, comm)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Bcast failed", mpi_code)
+    if(read_failed)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "metadata read on process 0 failed")
+
+    /* Distribute the data */
+    H5_CHECK_OVERFLOW(size, size_t, int);
+    if(MPI_SUCCESS != (mpi_code = MPI_Bcast(buf, (int)size, MPI_BYTE, 0, comm)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Bcast failed", mpi_code)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__coll_md_read_bcast() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_coll_md_write_begin
+ *
+ * Purpose:	Starts collecting metadata writes for the file.  Until
+ *		H5F_coll_md_write_end() is called, metadata written with
+ *		H5F_block_write() is copied aside instead of being written
+ *		to the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_coll_md_write_begin(H5F_t *f)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(!f->shared->md_coll.active);
+
+    f->shared->md_coll.active = TRUE;
+    f->shared->md_coll.nwrites = 0;
+    f->shared->md_coll.buf_used = 0;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5F_coll_md_write_begin() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__coll_md_write_add
+ *
+ * Purpose:	Copies a metadata write aside, to be issued by
+ *		H5F_coll_md_write_end().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__coll_md_write_add(const H5F_t *f, haddr_t addr, size_t size,
+    const void *buf)
+{
+    H5F_md_coll_t *md_coll;             /* Collected metadata writes */
+    H5F_md_write_t *w;                  /* New write */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(buf);
+
+    md_coll = &f->shared->md_coll;
+    HDassert(md_coll->active);
+
+    /* Make room for the write's description */
+    if(md_coll->nwrites == md_coll->max_writes) {
+        size_t new_max = MAX(H5F_MD_COLL_WRITES_INIT, 2 * md_coll->max_writes);
+        H5F_md_write_t *new_writes;
+
+        if(NULL == (new_writes = (H5F_md_write_t *)H5MM_realloc(md_coll->writes, new_max * sizeof(H5F_md_write_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate collected metadata writes")
+        md_coll->writes = new_writes;
+        md_coll->max_writes = new_max;
+    } /* end if */
+
+    /* Make room for the image */
+    if(md_coll->buf_used + size > md_coll->buf_size) {
+        size_t new_size = MAX(H5F_MD_COLL_BUF_INIT, md_coll->buf_size);
+        uint8_t *new_buf;
+
+        while(md_coll->buf_used + size > new_size)
+            new_size *= 2;
+        if(NULL == (new_buf = (uint8_t *)H5MM_realloc(md_coll->buf, new_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate collected metadata buffer")
+        md_coll->buf = new_buf;
+        md_coll->buf_size = new_size;
+    } /* end if */
+
+    /* Record the write */
+    w = &md_coll->writes[md_coll->nwrites++];
+    w->addr = addr;
+    w->size = size;
+    w->buf_off = md_coll->buf_used;
+    w->mem_off = 0;
+    HDmemcpy(md_coll->buf + md_coll->buf_used, buf, size);
+    md_coll->buf_used += size;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__coll_md_write_add() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__coll_md_write_overlay
+ *
+ * Purpose:	Copies any collected metadata writes that overlap a read
+ *		into the read's buffer, so that reads made while writes
+ *		are being collected see the data not yet in the file.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5F__coll_md_write_overlay(const H5F_t *f, haddr_t addr, size_t size,
+    void *buf)
+{
+    const H5F_md_coll_t *md_coll;       /* Collected metadata writes */
+    size_t      u;                      /* Local index variable */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(buf);
+
+    /* Apply writes in the order issued, so later writes win */
+    md_coll = &f->shared->md_coll;
+    for(u = 0; u < md_coll->nwrites; u++) {
+        const H5F_md_write_t *w = &md_coll->writes[u];
+        haddr_t start = MAX(addr, w->addr);
+        haddr_t end = MIN(addr + size, w->addr + w->size);
+
+        if(H5F_addr_lt(start, end))
+            HDmemcpy((uint8_t *)buf + (start - addr), md_coll->buf + w->buf_off + (start - w->addr), (size_t)(end - start));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5F__coll_md_write_overlay() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_md_write_cmp_addr
+ *
+ * Purpose:	Compares collected metadata writes by address, breaking
+ *		ties by the order the writes were issued in.
+ *
+ * Return:	-1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5F_md_write_cmp_addr(const void *_w1, const void *_w2)
+{
+    const H5F_md_write_t *w1 = (const H5F_md_write_t *)_w1;
+    const H5F_md_write_t *w2 = (const H5F_md_write_t *)_w2;
+    int ret_value;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(0 == (ret_value = H5F_addr_cmp(w1->addr, w2->addr)))
+        ret_value = (w1->buf_off > w2->buf_off) - (w1->buf_off < w2->buf_off);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_md_write_cmp_addr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_md_write_cmp_issue
+ *
+ * Purpose:	Compares collected metadata writes by the order they were
+ *		issued in.
+ *
+ * Return:	-1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5F_md_write_cmp_issue(const void *_w1, const void *_w2)
+{
+    const H5F_md_write_t *w1 = (const H5F_md_write_t *)_w1;
+    const H5F_md_write_t *w2 = (const H5F_md_write_t *)_w2;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI((w1->buf_off > w2->buf_off) - (w1->buf_off < w2->buf_off))
+} /* end H5F_md_write_cmp_issue() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_coll_md_write_end
+ *
+ * Purpose:	Stops collecting metadata writes and, if DO_WRITE is set,
+ *		issues them.  The writes are sorted by address and
+ *		coalesced into contiguous runs, packed into one buffer and
+ *		written with a single collective MPI-IO call, using a file
+ *		view that describes all the runs.
+ *
+ *		Must be called by all processes that share the file when
+ *		DO_WRITE is set, even those with nothing to write.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_coll_md_write_end(H5F_t *f, hid_t dxpl_id, hbool_t do_write)
+{
+    H5F_md_coll_t *md_coll;             /* Collected metadata writes */
+    H5P_genplist_t *dx_plist = NULL;    /* Data transfer property list */
+    H5FD_mpio_xfer_t xfer_mode = H5FD_MPIO_INDEPENDENT; /* Original transfer mode */
+    H5FD_mpio_xfer_t coll_mode = H5FD_MPIO_COLLECTIVE;  /* Transfer mode for the write */
+    hbool_t     xfer_mode_set = FALSE;  /* Whether the transfer mode was changed */
+    uint8_t     *wbuf = NULL;           /* Aggregated buffer */
+    int         *run_lens = NULL;       /* Lengths of contiguous runs */
+    MPI_Aint    *run_disps = NULL;      /* Displacements of contiguous runs */
+    MPI_Datatype file_type = MPI_BYTE;  /* File view for the write */
+    MPI_Datatype buf_type = MPI_BYTE;   /* Memory type for the write */
+    hbool_t     file_type_created = FALSE; /* Whether 'file_type' must be freed */
+    haddr_t     base_addr = 0;          /* Address of the first run */
+    size_t      total = 0;              /* Total number of bytes to write */
+    uint8_t     dummy = 0;              /* Buffer for processes with nothing to write */
+    int         mpi_code;               /* MPI return code */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    md_coll = &f->shared->md_coll;
+    HDassert(md_coll->active);
+
+    /* Stop collecting, so the aggregated write goes to the file */
+    md_coll->active = FALSE;
+
+    if(!do_write)
+        HGOTO_DONE(SUCCEED)
+
+    if(md_coll->nwrites > 0) {
+        haddr_t run_start, run_end;     /* Extent of the current run */
+        size_t  nruns = 0;              /* Number of contiguous runs */
+        hbool_t overlap = FALSE;        /* Whether any writes overlap */
+        size_t  u;                      /* Local index variable */
+
+        /* Sort the writes by address */
+        HDqsort(md_coll->writes, md_coll->nwrites, sizeof(H5F_md_write_t), H5F_md_write_cmp_addr);
+
+        if(NULL == (run_lens = (int *)H5MM_malloc(md_coll->nwrites * sizeof(int))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate run lengths")
+        if(NULL == (run_disps = (MPI_Aint *)H5MM_malloc(md_coll->nwrites * sizeof(MPI_Aint))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate run displacements")
+
+        /* Coalesce adjacent and overlapping writes into runs, and work out
+         * where each write lands in the aggregated buffer.
+         */
+        base_addr = run_start = md_coll->writes[0].addr;
+        run_end = run_start + md_coll->writes[0].size;
+        md_coll->writes[0].mem_off = 0;
+        for(u = 1; u < md_coll->nwrites; u++) {
+            H5F_md_write_t *w = &md_coll->writes[u];
+
+            if(H5F_addr_le(w->addr, run_end)) {
+                if(H5F_addr_lt(w->addr, run_end))
+                    overlap = TRUE;
+                run_end = MAX(run_end, w->addr + w->size);
+            } /* end if */
+            else {
+                H5_CHECK_OVERFLOW(run_end - run_start, hsize_t, int);
+                run_lens[nruns] = (int)(run_end - run_start);
+                run_disps[nruns] = (MPI_Aint)(run_start - base_addr);
+                total += (size_t)(run_end - run_start);
+                nruns++;
+                run_start = w->addr;
+                run_end = w->addr + w->size;
+            } /* end else */
+            w->mem_off = total + (size_t)(w->addr - run_start);
+        } /* end for */
+        H5_CHECK_OVERFLOW(run_end - run_start, hsize_t, int);
+        run_lens[nruns] = (int)(run_end - run_start);
+        run_disps[nruns] = (MPI_Aint)(run_start - base_addr);
+        total += (size_t)(run_end - run_start);
+        nruns++;
+
+        /* Pack the images, in the order issued when writes overlap */
+        if(overlap)
+            HDqsort(md_coll->writes, md_coll->nwrites, sizeof(H5F_md_write_t), H5F_md_write_cmp_issue);
+        if(NULL == (wbuf = (uint8_t *)H5MM_malloc(total)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate aggregated metadata buffer")
+        for(u = 0; u < md_coll->nwrites; u++)
+            HDmemcpy(wbuf + md_coll->writes[u].mem_off, md_coll->buf + md_coll->writes[u].buf_off, md_coll->writes[u].size);
+
+        /* Describe the runs in the file */
+        if(nruns > 1) {
+            H5_CHECK_OVERFLOW(nruns, size_t, int);
+            if(MPI_SUCCESS != (mpi_code = MPI_Type_create_hindexed((int)nruns, run_lens, run_disps, MPI_BYTE, &file_type)))
+                HMPI_GOTO_ERROR(FAIL, "MPI_Type_create_hindexed failed", mpi_code)
+            file_type_created = TRUE;
+            if(MPI_SUCCESS != (mpi_code = MPI_Type_commit(&file_type)))
+                HMPI_GOTO_ERROR(FAIL, "MPI_Type_commit failed", mpi_code)
+        } /* end if */
+    } /* end if */
+
+    /* Switch the transfer to collective I/O through the file view */
+    if(NULL == (dx_plist = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data transfer property list")
+    if(H5P_get(dx_plist, H5D_XFER_IO_XFER_MODE_NAME, &xfer_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get transfer mode")
+    if(H5P_set(dx_plist, H5D_XFER_IO_XFER_MODE_NAME, &coll_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set transfer mode")
+    xfer_mode_set = TRUE;
+    if(H5FD_mpi_setup_collective(dxpl_id, &buf_type, &file_type) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set MPI-I/O properties")
+
+    /* Write all the metadata at once */
+    if(H5F_block_write(f, H5FD_MEM_DRAW, base_addr, total, dxpl_id, (wbuf ? wbuf : &dummy)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "collective metadata write failed")
+
+done:
+    if(xfer_mode_set && H5P_set(dx_plist, H5D_XFER_IO_XFER_MODE_NAME, &xfer_mode) < 0)
+        HDONE_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't restore transfer mode")
+    if(file_type_created && MPI_SUCCESS != (mpi_code = MPI_Type_free(&file_type)))
+        HMPI_DONE_ERROR(FAIL, "MPI_Type_free failed", mpi_code)
+    H5MM_xfree(wbuf);
+    H5MM_xfree(run_lens);
+    H5MM_xfree(run_disps);
+
+    /* Keep the collection buffers for the next sync point */
+    md_coll->nwrites = 0;
+    md_coll->buf_used = 0;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_coll_md_write_end() */
 #endif /* H5_HAVE_PARALLEL */
 
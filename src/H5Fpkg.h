@@ -187,6 +187,27 @@ typedef struct H5F_super_t {
     H5G_entry_t *root_ent;      /* Root group symbol table entry              */
 } H5F_super_t;
 
+#ifdef H5_HAVE_PARALLEL
+/* A metadata write deferred to the end of a sync point */
+typedef struct H5F_md_write_t {
+    haddr_t     addr;           /* File address of the write                  */
+    size_t      size;           /* Size of the write                          */
+    size_t      buf_off;        /* Offset of the image in the collection buffer */
+    size_t      mem_off;        /* Offset of the image in the aggregated buffer */
+} H5F_md_write_t;
+
+/* Metadata writes collected during a sync point, to be issued together */
+typedef struct H5F_md_coll_t {
+    hbool_t     active;         /* Whether metadata writes are being collected */
+    size_t      nwrites;        /* Number of writes collected                 */
+    size_t      max_writes;     /* Number of entries allocated in 'writes'    */
+    H5F_md_write_t *writes;     /* Collected writes, in the order issued      */
+    size_t      buf_used;       /* Bytes used in 'buf'                        */
+    size_t      buf_size;       /* Bytes allocated for 'buf'                  */
+    uint8_t     *buf;           /* Images of the collected writes             */
+} H5F_md_coll_t;
+#endif /* H5_HAVE_PARALLEL */
+
 /*
  * Define the structure to store the file information for HDF5 files. One of
  * these structures is allocated per file, not per H5Fopen(). That is, set of
@@ -228,6 +249,9 @@ struct H5F_file_t {
     unsigned	gc_ref;		/* Garbage-collect references?		*/
     hbool_t	latest_format;	/* Always use the latest format?	*/
     hbool_t	store_msg_crt_idx;  /* Store creation index for object header messages?	*/
+#ifdef H5_HAVE_PARALLEL
+    hbool_t	coll_md_read;	/* Read metadata on one process and broadcast during collective opens? */
+#endif /* H5_HAVE_PARALLEL */
     unsigned	ncwfs;		/* Num entries on cwfs list		*/
     struct H5HG_heap_t **cwfs;	/* Global heap cache			*/
     struct H5G_t *root_grp;	/* Open root group			*/
@@ -251,6 +275,11 @@ struct H5F_file_t {
 
     /* Metadata accumulator information */
     H5F_meta_accum_t accum;     /* Metadata accumulator info           	*/
+
+#ifdef H5_HAVE_PARALLEL
+    /* Metadata writes deferred during a sync point */
+    H5F_md_coll_t md_coll;      /* Collected metadata writes		*/
+#endif /* H5_HAVE_PARALLEL */
 };
 
 /*
@@ -328,6 +357,18 @@ H5_DLL herr_t H5F__accum_free(const H5F_io_info_t *fio_info, H5FD_mem_t type,
 H5_DLL herr_t H5F__accum_flush(const H5F_io_info_t *fio_info);
 H5_DLL herr_t H5F__accum_reset(const H5F_io_info_t *fio_info, hbool_t flush);
 
+/* Collective metadata read routines */
+#ifdef H5_HAVE_PARALLEL
+H5_DLL htri_t H5F__coll_md_read_check(const H5F_t *f, H5FD_mem_t type,
+    const H5P_genplist_t *dxpl);
+H5_DLL herr_t H5F__coll_md_read_bcast(const H5F_t *f, herr_t read_status,
+    void *buf, size_t size);
+H5_DLL herr_t H5F__coll_md_write_add(const H5F_t *f, haddr_t addr, size_t size,
+    const void *buf);
+H5_DLL void H5F__coll_md_write_overlay(const H5F_t *f, haddr_t addr,
+    size_t size, void *buf);
+#endif /* H5_HAVE_PARALLEL */
+
 /* Shared file list related routines */
 H5_DLL herr_t H5F_sfile_add(H5F_file_t *shared);
 H5_DLL H5F_file_t * H5F_sfile_search(H5FD_t *lf);
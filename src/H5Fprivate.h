@@ -456,6 +456,10 @@
 #define H5F_ACS_FILE_IMAGE_INFO_NAME            "file_image_info" /* struct containing initial file image and callback info */
 #define H5F_ACS_CORE_WRITE_TRACKING_FLAG_NAME       "core_write_tracking_flag" /* Whether or not core VFD backing store write tracking is enabled */
 #define H5F_ACS_CORE_WRITE_TRACKING_PAGE_SIZE_NAME  "core_write_tracking_page_size" /* The page size in kiB when core VFD write tracking is enabled */
+#define H5F_ACS_MDC_BG_FLUSH_NAME               "mdc_bg_flush"  /* Fraction of the metadata cache which may be dirty before entries are written ahead of need */
+#ifdef H5_HAVE_PARALLEL
+#define H5F_ACS_COLL_MD_READ_NAME               "coll_md_read"  /* Whether metadata reads in collective opens are done by one process and broadcast */
+#endif /* H5_HAVE_PARALLEL */
 
 /* ======================== File Mount properties ====================*/
 #define H5F_MNT_SYM_LOCAL_NAME 		"local"                 /* Whether absolute symlinks local to file. */
@@ -678,6 +682,8 @@ H5_DLL herr_t H5F_super_dirty(H5F_t *f);
 H5_DLL int H5F_mpi_get_rank(const H5F_t *f);
 H5_DLL MPI_Comm H5F_mpi_get_comm(const H5F_t *f);
 H5_DLL int H5F_mpi_get_size(const H5F_t *f);
+H5_DLL herr_t H5F_coll_md_write_begin(H5F_t *f);
+H5_DLL herr_t H5F_coll_md_write_end(H5F_t *f, hid_t dxpl_id, hbool_t do_write);
 #endif /* H5_HAVE_PARALLEL */
 
 /* External file cache routines */
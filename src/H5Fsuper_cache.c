@@ -58,6 +58,10 @@
 /* Local Prototypes */
 /********************/
 
+/* Superblock I/O */
+static herr_t H5F_sblock_read(const H5F_t *f, const H5P_genplist_t *dxpl,
+    haddr_t addr, size_t size, void *buf);
+
 /* Metadata cache (H5AC) callbacks */
 static H5F_super_t *H5F_sblock_load(H5F_t *f, hid_t dxpl_id, haddr_t addr, void *udata);
 static herr_t H5F_sblock_flush(H5F_t *f, hid_t dxpl_id, hbool_t destroy, haddr_t addr, H5F_super_t *sblock);
@@ -94,6 +98,50 @@ H5FL_EXTERN(H5F_super_t);
 /*******************/
 
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F_sblock_read
+ *
+ * Purpose:     Reads part of the superblock or driver info block directly
+ *              from the file driver.  When collective metadata reads are
+ *              enabled for a collective open, only process 0 reads and
+ *              the bytes are broadcast to the other processes.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F_sblock_read(const H5F_t *f, const H5P_genplist_t *dxpl, haddr_t addr,
+    size_t size, void *buf)
+{
+#ifdef H5_HAVE_PARALLEL
+    htri_t      coll_read;              /* Whether to read on process 0 and broadcast */
+#endif /* H5_HAVE_PARALLEL */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+#ifdef H5_HAVE_PARALLEL
+    if((coll_read = H5F__coll_md_read_check(f, H5FD_MEM_SUPER, dxpl)) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "can't check for collective metadata read")
+    if(coll_read) {
+        herr_t read_status = SUCCEED;   /* Outcome of process 0's read */
+
+        if(0 == H5F_mpi_get_rank(f))
+            read_status = H5FD_read(f->shared->lf, dxpl, H5FD_MEM_SUPER, addr, size, buf);
+        if(H5F__coll_md_read_bcast(f, read_status, buf, size) < 0)
+            HGOTO_ERROR(H5E_FILE, H5E_READERROR, FAIL, "collective superblock read failed")
+    } /* end if */
+    else
+#endif /* H5_HAVE_PARALLEL */
+    if(H5FD_read(f->shared->lf, dxpl, H5FD_MEM_SUPER, addr, size, buf) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_READERROR, FAIL, "file read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_sblock_read() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5F_sblock_load
@@ -169,7 +217,7 @@ H5F_sblock_load(H5F_t *f, hid_t dxpl_id, haddr_t UNUSED addr, void *_udata)
     H5_CHECK_OVERFLOW(fixed_size, size_t, haddr_t);
     if(H5FD_set_eoa(lf, H5FD_MEM_SUPER, (haddr_t)fixed_size) < 0)
         HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "set end of space allocation request failed")
-    if(H5FD_read(lf, dxpl, H5FD_MEM_SUPER, (haddr_t)0, fixed_size, p) < 0)
+    if(H5F_sblock_read(f, dxpl, (haddr_t)0, fixed_size, p) < 0)
         HGOTO_ERROR(H5E_FILE, H5E_READERROR, NULL, "unable to read superblock")
 
     /* Skip over signature (already checked when locating the superblock) */
@@ -196,7 +244,7 @@ H5F_sblock_load(H5F_t *f, hid_t dxpl_id, haddr_t UNUSED addr, void *_udata)
     /* Read in variable-sized portion of superblock */
     if(H5FD_set_eoa(lf, H5FD_MEM_SUPER, (haddr_t)(fixed_size + variable_size)) < 0)
         HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "set end of space allocation request failed")
-    if(H5FD_read(lf, dxpl, H5FD_MEM_SUPER, (haddr_t)fixed_size, variable_size, p) < 0)
+    if(H5F_sblock_read(f, dxpl, (haddr_t)fixed_size, variable_size, p) < 0)
         HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to read superblock")
 
     /* Check for older version of superblock format */
@@ -350,7 +398,7 @@ H5F_sblock_load(H5F_t *f, hid_t dxpl_id, haddr_t UNUSED addr, void *_udata)
             p = dbuf;
             if(H5FD_set_eoa(lf, H5FD_MEM_SUPER, sblock->driver_addr + H5F_DRVINFOBLOCK_HDR_SIZE) < 0)
                 HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "set end of space allocation request failed")
-            if(H5FD_read(lf, dxpl, H5FD_MEM_SUPER, sblock->driver_addr, (size_t)H5F_DRVINFOBLOCK_HDR_SIZE, p) < 0)
+            if(H5F_sblock_read(f, dxpl, sblock->driver_addr, (size_t)H5F_DRVINFOBLOCK_HDR_SIZE, p) < 0)
                 HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to read driver information block")
 
             /* Version number */
@@ -382,7 +430,7 @@ H5F_sblock_load(H5F_t *f, hid_t dxpl_id, haddr_t UNUSED addr, void *_udata)
             /* Read in variable-sized portion of driver info block */
             if(H5FD_set_eoa(lf, H5FD_MEM_SUPER, sblock->driver_addr + H5F_DRVINFOBLOCK_HDR_SIZE + drv_variable_size) < 0)
                 HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "set end of space allocation request failed")
-            if(H5FD_read(lf, dxpl, H5FD_MEM_SUPER, sblock->driver_addr + H5F_DRVINFOBLOCK_HDR_SIZE, drv_variable_size, p) < 0)
+            if(H5F_sblock_read(f, dxpl, sblock->driver_addr + H5F_DRVINFOBLOCK_HDR_SIZE, drv_variable_size, p) < 0)
                 HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to read file driver information")
 
             /* Decode driver information */
@@ -643,6 +643,98 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
 } /* end H5G_obj_insert() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5G_obj_insert_multi
+ *
+ * Purpose:	Insert NLINKS new links into the group described by
+ *              GRP_OLOC, as a single batch.  The names of the links must
+ *              be distinct; none of them may already exist in the group,
+ *              which is checked for all the links before any of them are
+ *              inserted.  Callers should pass the links sorted by name, so
+ *              that consecutive insertions touch the same parts of the
+ *              group's name index.
+ *
+ *              The number of links actually inserted is returned in
+ *              NINSERTED, so that the caller can tell which objects are
+ *              linked into the file if an insertion fails part way.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5G_obj_insert_multi(const H5O_loc_t *grp_oloc, size_t nlinks,
+    H5O_link_t *obj_lnk, hbool_t adj_link, H5O_type_t obj_type,
+    size_t *ninserted, hid_t dxpl_id)
+{
+    size_t u;                   /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI_TAG(dxpl_id, grp_oloc->addr, FAIL)
+
+    /* check arguments */
+    HDassert(grp_oloc && grp_oloc->file);
+    HDassert(obj_lnk);
+    HDassert(ninserted);
+
+    *ninserted = 0;
+
+    /* Make certain that none of the links exist yet */
+    for(u = 0; u < nlinks; u++) {
+        htri_t exists;          /* Whether the link exists */
+
+        if((exists = H5G_obj_link_exists(grp_oloc, obj_lnk[u].name, dxpl_id)) < 0)
+            HGOTO_ERROR(H5E_SYM, H5E_CANTGET, FAIL, "can't check if link exists")
+        if(exists)
+            HGOTO_ERROR(H5E_SYM, H5E_EXISTS, FAIL, "name already exists")
+    } /* end for */
+
+    /* Insert the links */
+    for(u = 0; u < nlinks; u++) {
+        if(H5G_obj_insert(grp_oloc, obj_lnk[u].name, &obj_lnk[u], adj_link, obj_type, NULL, dxpl_id) < 0)
+            HGOTO_ERROR(H5E_SYM, H5E_CANTINSERT, FAIL, "unable to insert link")
+        (*ninserted)++;
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5G_obj_insert_multi() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5G_obj_link_exists
+ *
+ * Purpose:	Check whether a group has a link with a given name.
+ *              Unlike H5G_loc_exists, the link isn't followed, so a
+ *              dangling soft link counts as existing.
+ *
+ * Return:	Success:	TRUE/FALSE
+ * 		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+htri_t
+H5G_obj_link_exists(const H5O_loc_t *grp_oloc, const char *name, hid_t dxpl_id)
+{
+    H5O_link_t lnk;             /* Link with the name */
+    htri_t ret_value;           /* Return value */
+
+    FUNC_ENTER_NOAPI_TAG(dxpl_id, grp_oloc->addr, FAIL)
+
+    /* check arguments */
+    HDassert(grp_oloc && grp_oloc->file);
+    HDassert(name && *name);
+
+    if((ret_value = H5G__obj_lookup(grp_oloc, name, &lnk, dxpl_id)) < 0)
+        HGOTO_ERROR(H5E_SYM, H5E_CANTGET, FAIL, "can't check if link exists")
+    if(ret_value)
+        H5O_msg_reset(H5O_LINK_ID, &lnk);
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5G_obj_link_exists() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5G__obj_iterate
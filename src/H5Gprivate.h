@@ -235,6 +235,11 @@ H5_DLL herr_t H5G_link_to_info(const struct H5O_link_t *lnk, H5L_info_t *linfo);
 H5_DLL herr_t H5G_obj_insert(const struct H5O_loc_t *grp_oloc, const char *name,
     struct H5O_link_t *obj_lnk, hbool_t adj_link, H5O_type_t obj_type,
     const void *crt_info, hid_t dxpl_id);
+H5_DLL herr_t H5G_obj_insert_multi(const struct H5O_loc_t *grp_oloc,
+    size_t nlinks, struct H5O_link_t *obj_lnk, hbool_t adj_link,
+    H5O_type_t obj_type, size_t *ninserted, hid_t dxpl_id);
+H5_DLL htri_t H5G_obj_link_exists(const struct H5O_loc_t *grp_oloc,
+    const char *name, hid_t dxpl_id);
 H5_DLL ssize_t H5G_obj_get_name_by_idx(const struct H5O_loc_t *oloc, H5_index_t idx_type,
     H5_iter_order_t order, hsize_t n, char* name, size_t size, hid_t dxpl_id);
 H5_DLL herr_t H5G_obj_remove(const struct H5O_loc_t *oloc, H5RS_str_t *grp_full_path_r,
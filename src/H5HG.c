@@ -85,6 +85,7 @@
 /********************/
 
 static haddr_t H5HG_create(H5F_t *f, hid_t dxpl_id, size_t size);
+static int H5HG_cmp_addr(const void *hobj1, const void *hobj2);
 
 
 /*********************/
@@ -583,6 +584,128 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
 } /* H5HG_insert() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5HG_insert_multi
+ *
+ * Purpose:	Inserts several new objects into the global heap, as if by
+ *		calling H5HG_insert() for each of them in turn.
+ *
+ *		Each collection is protected once for as many of the
+ *		objects as it can hold, rather than once per object.  When
+ *		no collection on the CWFS list has room for the next object,
+ *		the new collection is sized to hold all the objects not yet
+ *		inserted (up to H5HG_MAXSIZE), so that objects written
+ *		together are stored next to each other and can be read back
+ *		together.
+ *
+ * Return:	Success:	Non-negative, and heap object handles returned
+ *				through the HOBJ array.
+ *
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5HG_insert_multi(H5F_t *f, hid_t dxpl_id, size_t nobjs, const size_t size[],
+    void *obj[], H5HG_t hobj[]/*out*/)
+{
+    size_t	remaining = 0;	/*total space needed for objects not yet inserted */
+    size_t	need;		/*space needed for the next object	*/
+    size_t	hdr_size;	/*size of a collection header		*/
+    size_t	obj_hdr_size;	/*size of an object header		*/
+    size_t	idx;
+    size_t	u, first;
+    haddr_t	addr;           /* Address of heap to add objects within */
+    H5HG_heap_t	*heap = NULL;
+    unsigned 	heap_flags = H5AC__NO_FLAGS_SET;
+    hbool_t	need_new = FALSE;	/* Whether a new collection must be created */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_TAG(dxpl_id, H5AC__GLOBALHEAP_TAG, FAIL)
+
+    /* Check args */
+    HDassert(f);
+    HDassert(0 == nobjs || (size && obj && hobj));
+
+    if(0 == (H5F_INTENT(f) & H5F_ACC_RDWR))
+	HGOTO_ERROR(H5E_HEAP, H5E_WRITEERROR, FAIL, "no write intent on file")
+
+    hdr_size = (size_t)H5HG_SIZEOF_HDR(f);
+    obj_hdr_size = (size_t)H5HG_SIZEOF_OBJHDR(f);
+
+    for(u = 0; u < nobjs; u++)
+        remaining += obj_hdr_size + H5HG_ALIGN(size[u]);
+
+    u = 0;
+    while(u < nobjs) {
+        need = obj_hdr_size + H5HG_ALIGN(size[u]);
+
+        /* Look for a heap in the file's CWFS that has enough space for the
+         * next object.
+         */
+        addr = HADDR_UNDEF;
+        if(!need_new)
+            if(H5F_cwfs_find_free_heap(f, dxpl_id, need, &addr) < 0)
+                HGOTO_ERROR(H5E_HEAP, H5E_NOTFOUND, FAIL, "error trying to locate heap")
+
+        /*
+         * If we didn't find any collection with enough free space then allocate
+         * a new collection large enough for the rest of the objects, within
+         * the usual limit on the size of a collection.
+         */
+        if(!H5F_addr_defined(addr)) {
+            size_t new_size = MIN(remaining, H5HG_MAXSIZE - hdr_size);
+
+            addr = H5HG_create(f, dxpl_id, MAX(new_size, need) + hdr_size);
+
+            if(!H5F_addr_defined(addr))
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTINIT, FAIL, "unable to allocate a global heap collection")
+        } /* end if */
+        HDassert(H5F_addr_defined(addr));
+        need_new = FALSE;
+
+        if(NULL == (heap = H5HG_protect(f, dxpl_id, addr, H5AC_WRITE)))
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTPROTECT, FAIL, "unable to protect global heap")
+
+        /* Insert objects until the collection runs out of space or IDs */
+        first = u;
+        while(u < nobjs && heap->nused <= H5HG_MAXIDX && heap->obj[0].size >= need) {
+            if(0 == (idx = H5HG_alloc(f, heap, size[u], &heap_flags)))
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTALLOC, FAIL, "unable to allocate global heap object")
+
+            if(size[u] > 0)
+                HDmemcpy(heap->obj[idx].begin + obj_hdr_size, obj[u], size[u]);
+
+            hobj[u].addr = heap->addr;
+            hobj[u].idx = idx;
+
+            remaining -= need;
+            if(++u < nobjs)
+                need = obj_hdr_size + H5HG_ALIGN(size[u]);
+        } /* end while */
+
+        /* A collection with free space but no free object IDs can't take
+         * the next object, so make a new one for it.
+         */
+        if(u == first)
+            need_new = TRUE;
+        else
+            heap_flags |= H5AC__DIRTIED_FLAG;
+
+        if(H5AC_unprotect(f, dxpl_id, H5AC_GHEAP, heap->addr, heap, heap_flags) < 0)
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to unprotect heap.")
+        heap = NULL;
+        heap_flags = H5AC__NO_FLAGS_SET;
+    } /* end while */
+
+done:
+    if(heap && H5AC_unprotect(f, dxpl_id, H5AC_GHEAP, heap->addr, heap, heap_flags) < 0)
+        HDONE_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to unprotect heap.")
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* H5HG_insert_multi() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5HG_read
@@ -657,6 +780,112 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, NULL)
 } /* end H5HG_read() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5HG_cmp_addr
+ *
+ * Purpose:	Compare the collection addresses of two global heap
+ *		objects.
+ *
+ * Description:	Callback for qsort() to group a list of pointers to heap
+ *		IDs by the collection that holds each object.
+ *
+ * Return:	-1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5HG_cmp_addr(const void *hobj1, const void *hobj2)
+{
+    haddr_t addr1, addr2;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    addr1 = (*(const H5HG_t * const *)hobj1)->addr;
+    addr2 = (*(const H5HG_t * const *)hobj2)->addr;
+
+    FUNC_LEAVE_NOAPI(H5F_addr_cmp(addr1, addr2))
+} /* end H5HG_cmp_addr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5HG_read_multi
+ *
+ * Purpose:	Reads NOBJS global heap objects into the buffers OBJ
+ *		supplied by the caller, which must be large enough to hold
+ *		the objects.
+ *
+ *		The objects are read in the order of the collections which
+ *		hold them, so that each collection is protected only once,
+ *		however the objects are scattered among the collections.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5HG_read_multi(H5F_t *f, hid_t dxpl_id, size_t nobjs, const H5HG_t hobj[],
+    void *obj[]/*out*/)
+{
+    const H5HG_t **sorted = NULL;       /* Heap IDs, grouped by collection */
+    H5HG_heap_t	*heap = NULL;           /* Pointer to global heap object */
+    haddr_t     addr = HADDR_UNDEF;     /* Address of current collection */
+    size_t      u;                      /* Local index variable */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_TAG(dxpl_id, H5AC__GLOBALHEAP_TAG, FAIL)
+
+    /* Check args */
+    HDassert(f);
+    HDassert(0 == nobjs || (hobj && obj));
+
+    if(0 == nobjs)
+        HGOTO_DONE(SUCCEED)
+
+    /* Group the objects by collection */
+    if(NULL == (sorted = (const H5HG_t **)H5MM_malloc(nobjs * sizeof(H5HG_t *))))
+	HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    for(u = 0; u < nobjs; u++)
+        sorted[u] = &hobj[u];
+    HDqsort(sorted, nobjs, sizeof(sorted[0]), H5HG_cmp_addr);
+
+    u = 0;
+    while(u < nobjs) {
+        addr = sorted[u]->addr;
+
+        /* Load the heap */
+        if(NULL == (heap = H5HG_protect(f, dxpl_id, addr, H5AC_READ)))
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTPROTECT, FAIL, "unable to protect global heap")
+
+        /* Copy out every object held in this collection */
+        do {
+            const H5HG_t *cur = sorted[u];
+
+            HDassert(cur->idx < heap->nused);
+            HDassert(heap->obj[cur->idx].begin);
+            HDmemcpy(obj[cur - hobj], heap->obj[cur->idx].begin + H5HG_SIZEOF_OBJHDR(f), heap->obj[cur->idx].size);
+            u++;
+        } while(u < nobjs && H5F_addr_eq(sorted[u]->addr, addr));
+
+        /* Advance the heap in the CWFS list */
+        if(heap->obj[0].begin)
+            if(H5F_cwfs_advance_heap(f, heap, FALSE) < 0)
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTMODIFY, FAIL, "can't adjust file's CWFS")
+
+        if(H5AC_unprotect(f, dxpl_id, H5AC_GHEAP, addr, heap, H5AC__NO_FLAGS_SET) < 0)
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to release global heap")
+        heap = NULL;
+    } /* end while */
+
+done:
+    if(heap && H5AC_unprotect(f, dxpl_id, H5AC_GHEAP, addr, heap, H5AC__NO_FLAGS_SET) < 0)
+        HDONE_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to release global heap")
+
+    H5MM_xfree(sorted);
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5HG_read_multi() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5HG_link
@@ -78,6 +78,10 @@ typedef struct {
 /* Local Prototypes */
 /********************/
 
+static H5O_t *H5O_create_ohdr(H5F_t *f, size_t size_hint,
+    H5P_genplist_t *oc_plist);
+static herr_t H5O_apply_ohdr(H5F_t *f, hid_t dxpl_id, H5O_t *oh,
+    haddr_t oh_addr, size_t size_hint, size_t initial_rc, H5O_loc_t *loc);
 static herr_t H5O_delete_oh(H5F_t *f, hid_t dxpl_id, H5O_t *oh);
 static herr_t H5O_obj_type_real(H5O_t *oh, H5O_type_t *obj_type);
 static herr_t H5O_visit(hid_t loc_id, const char *obj_name, H5_index_t idx_type,
@@ -1074,6 +1078,7 @@ H5Oclose(hid_t object_id)
         case H5I_ERROR_CLASS:
         case H5I_ERROR_MSG:
         case H5I_ERROR_STACK:
+        case H5I_REQUEST:
         case H5I_NTYPES:
         default:
             HGOTO_ERROR(H5E_ARGS, H5E_CANTRELEASE, FAIL, "not a valid file object ID (dataset, group, or datatype)")
@@ -1086,63 +1091,38 @@ done:
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5O_create
- *
- * Purpose:	Creates a new object header. Allocates space for it and
- *              then calls an initialization function. The object header
- *              is opened for write access and should eventually be
- *              closed by calling H5O_close().
+ * Function:	H5O_create_ohdr
  *
- * Return:	Success:	Non-negative, the ENT argument contains
- *				information about the object header,
- *				including its address.
+ * Purpose:	Allocates and initializes the in-memory portion of a new
+ *              object header, from the object creation property list.
+ *              No file space is allocated for the header.
  *
- *		Failure:	Negative
- *
- * Programmer:	Robb Matzke
- *		matzke@llnl.gov
- *		Aug  5 1997
+ * Return:	Success:	Pointer to the new object header
+ *		Failure:	NULL
  *
  *-------------------------------------------------------------------------
  */
-herr_t
-H5O_create(H5F_t *f, hid_t dxpl_id, size_t size_hint, size_t initial_rc,
-    hid_t ocpl_id, H5O_loc_t *loc/*out*/)
+static H5O_t *
+H5O_create_ohdr(H5F_t *f, size_t size_hint, H5P_genplist_t *oc_plist)
 {
-    H5P_genplist_t  *oc_plist;          /* Object creation property list */
     H5O_t      *oh = NULL;              /* Object header created */
-    haddr_t     oh_addr;                /* Address of initial object header */
-    size_t      oh_size;                /* Size of initial object header */
     uint8_t	oh_flags;		/* Object header's initial status flags */
-    unsigned    insert_flags = H5AC__NO_FLAGS_SET; /* Flags for inserting object header into cache */
     hbool_t     store_msg_crt_idx;      /* Whether to always store message creation indices for this file */
-    herr_t      ret_value = SUCCEED;    /* return value */
+    H5O_t      *ret_value;              /* Return value */
 
-    FUNC_ENTER_NOAPI(FAIL)
+    FUNC_ENTER_NOAPI_NOINIT
 
     /* check args */
     HDassert(f);
-    HDassert(loc);
-    HDassert(TRUE == H5P_isa_class(ocpl_id, H5P_OBJECT_CREATE));
-
-    /* Check for invalid access request */
-    if(0 == (H5F_INTENT(f) & H5F_ACC_RDWR))
-        HGOTO_ERROR(H5E_OHDR, H5E_BADVALUE, FAIL, "no write intent on file")
-
-    /* Make certain we allocate at least a reasonable size for the object header */
-    size_hint = H5O_ALIGN_F(f, MAX(H5O_MIN_SIZE, size_hint));
-
-    /* Get the property list */
-    if(NULL == (oc_plist = (H5P_genplist_t *)H5I_object(ocpl_id)))
-        HGOTO_ERROR(H5E_PLIST, H5E_BADTYPE, FAIL, "not a property list")
+    HDassert(oc_plist);
 
     /* Get any object header status flags set by properties */
     if(H5P_get(oc_plist, H5O_CRT_OHDR_FLAGS_NAME, &oh_flags) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get object header flags")
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get object header flags")
 
     /* Allocate the object header and zero out header fields */
     if(NULL == (oh = H5FL_CALLOC(H5O_t)))
-        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed")
 
     /* Initialize file-specific information for object header */
     store_msg_crt_idx = H5F_STORE_MSG_CRT_IDX(f);
@@ -1157,7 +1137,7 @@ H5O_create(H5F_t *f, hid_t dxpl_id, size_t size_hint, size_t initial_rc,
     if(H5P_exist_plist(oc_plist, H5O_BAD_MESG_COUNT_NAME) > 0) {
         /* Retrieve bad message count flag */
         if(H5P_get(oc_plist, H5O_BAD_MESG_COUNT_NAME, &oh->store_bad_mesg_count) < 0)
-            HGOTO_ERROR(H5E_OHDR, H5E_CANTGET, FAIL, "can't get bad message count flag")
+            HGOTO_ERROR(H5E_OHDR, H5E_CANTGET, NULL, "can't get bad message count flag")
     } /* end if */
 #endif /* H5O_ENABLE_BAD_MESG_COUNT */
 
@@ -1180,9 +1160,9 @@ H5O_create(H5F_t *f, hid_t dxpl_id, size_t size_hint, size_t initial_rc,
 
         /* Retrieve attribute storage phase change values from property list */
         if(H5P_get(oc_plist, H5O_CRT_ATTR_MAX_COMPACT_NAME, &oh->max_compact) < 0)
-            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get max. # of compact attributes")
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get max. # of compact attributes")
         if(H5P_get(oc_plist, H5O_CRT_ATTR_MIN_DENSE_NAME, &oh->min_dense) < 0)
-            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get min. # of dense attributes")
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get min. # of dense attributes")
 
         /* Check for non-default attribute storage phase change values */
         if(oh->max_compact != H5O_CRT_ATTR_MAX_COMPACT_DEF || oh->min_dense != H5O_CRT_ATTR_MIN_DENSE_DEF)
@@ -1205,14 +1185,50 @@ H5O_create(H5F_t *f, hid_t dxpl_id, size_t size_hint, size_t initial_rc,
         oh->atime = oh->mtime = oh->ctime = oh->btime = 0;
     } /* end else */
 
+    /* Set return value */
+    ret_value = oh;
+
+done:
+    if(!ret_value && oh)
+        if(H5O_free(oh) < 0)
+	    HDONE_ERROR(H5E_OHDR, H5E_CANTFREE, NULL, "unable to destroy object header data")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_create_ohdr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_apply_ohdr
+ *
+ * Purpose:	Sets up the first chunk of a new object header at OH_ADDR,
+ *              inserts the header into the metadata cache and opens it.
+ *              The object header is owned by the cache (or released, on
+ *              failure) after this call.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O_apply_ohdr(H5F_t *f, hid_t dxpl_id, H5O_t *oh, haddr_t oh_addr,
+    size_t size_hint, size_t initial_rc, H5O_loc_t *loc/*out*/)
+{
+    size_t      oh_size;                /* Size of initial object header */
+    unsigned    insert_flags = H5AC__NO_FLAGS_SET; /* Flags for inserting object header into cache */
+    herr_t      ret_value = SUCCEED;    /* return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* check args */
+    HDassert(f);
+    HDassert(oh);
+    HDassert(H5F_addr_defined(oh_addr));
+    HDassert(loc);
+
     /* Compute total size of initial object header */
     /* (i.e. object header prefix and first chunk) */
     oh_size = (size_t)H5O_SIZEOF_HDR(oh) + size_hint;
 
-    /* Allocate disk space for header and first chunk */
-    if(HADDR_UNDEF == (oh_addr = H5MF_alloc(f, H5FD_MEM_OHDR, dxpl_id, (hsize_t)oh_size)))
-        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "file allocation failed for object header")
-
     /* Create the chunk list */
     oh->nchunks = oh->alloc_nchunks = 1;
     if(NULL == (oh->chunk = H5FL_SEQ_MALLOC(H5O_chunk_t, (size_t)oh->alloc_nchunks)))
@@ -1272,6 +1288,82 @@ H5O_create(H5F_t *f, hid_t dxpl_id, size_t size_hint, size_t initial_rc,
     if(H5O_open(loc) < 0)
         HGOTO_ERROR(H5E_OHDR, H5E_CANTOPENOBJ, FAIL, "unable to open object header")
 
+done:
+    if(ret_value < 0 && oh)
+        if(H5O_free(oh) < 0)
+	    HDONE_ERROR(H5E_OHDR, H5E_CANTFREE, FAIL, "unable to destroy object header data")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_apply_ohdr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_create
+ *
+ * Purpose:	Creates a new object header. Allocates space for it and
+ *              then calls an initialization function. The object header
+ *              is opened for write access and should eventually be
+ *              closed by calling H5O_close().
+ *
+ * Return:	Success:	Non-negative, the ENT argument contains
+ *				information about the object header,
+ *				including its address.
+ *
+ *		Failure:	Negative
+ *
+ * Programmer:	Robb Matzke
+ *		matzke@llnl.gov
+ *		Aug  5 1997
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5O_create(H5F_t *f, hid_t dxpl_id, size_t size_hint, size_t initial_rc,
+    hid_t ocpl_id, H5O_loc_t *loc/*out*/)
+{
+    H5P_genplist_t  *oc_plist;          /* Object creation property list */
+    H5O_t      *oh = NULL;              /* Object header created */
+    haddr_t     oh_addr;                /* Address of initial object header */
+    size_t      oh_size;                /* Size of initial object header */
+    herr_t      ret_value = SUCCEED;    /* return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* check args */
+    HDassert(f);
+    HDassert(loc);
+    HDassert(TRUE == H5P_isa_class(ocpl_id, H5P_OBJECT_CREATE));
+
+    /* Check for invalid access request */
+    if(0 == (H5F_INTENT(f) & H5F_ACC_RDWR))
+        HGOTO_ERROR(H5E_OHDR, H5E_BADVALUE, FAIL, "no write intent on file")
+
+    /* Make certain we allocate at least a reasonable size for the object header */
+    size_hint = H5O_ALIGN_F(f, MAX(H5O_MIN_SIZE, size_hint));
+
+    /* Get the property list */
+    if(NULL == (oc_plist = (H5P_genplist_t *)H5I_object(ocpl_id)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADTYPE, FAIL, "not a property list")
+
+    /* Set up the object header */
+    if(NULL == (oh = H5O_create_ohdr(f, size_hint, oc_plist)))
+        HGOTO_ERROR(H5E_OHDR, H5E_CANTINIT, FAIL, "unable to initialize object header")
+
+    /* Compute total size of initial object header */
+    /* (i.e. object header prefix and first chunk) */
+    oh_size = (size_t)H5O_SIZEOF_HDR(oh) + size_hint;
+
+    /* Allocate disk space for header and first chunk */
+    if(HADDR_UNDEF == (oh_addr = H5MF_alloc(f, H5FD_MEM_OHDR, dxpl_id, (hsize_t)oh_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "file allocation failed for object header")
+
+    /* Cache & open the object header (which takes ownership of it) */
+    if(H5O_apply_ohdr(f, dxpl_id, oh, oh_addr, size_hint, initial_rc, loc) < 0) {
+        oh = NULL;
+        HGOTO_ERROR(H5E_OHDR, H5E_CANTINIT, FAIL, "unable to create object header")
+    } /* end if */
+    oh = NULL;
+
 done:
     if(ret_value < 0 && oh)
         if(H5O_free(oh) < 0)
@@ -1280,6 +1372,104 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5O_create() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_create_multi
+ *
+ * Purpose:	Creates COUNT new object headers from the same object
+ *              creation property list.  The space for all the headers is
+ *              allocated from the file as a single contiguous block, so
+ *              that headers for objects created together are stored
+ *              together.  Each object header is opened for write access,
+ *              as with H5O_create(), and should eventually be closed by
+ *              calling H5O_close().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5O_create_multi(H5F_t *f, hid_t dxpl_id, size_t size_hint, size_t initial_rc,
+    hid_t ocpl_id, size_t count, H5O_loc_t loc[]/*out*/)
+{
+    H5P_genplist_t  *oc_plist;          /* Object creation property list */
+    H5O_t      *oh = NULL;              /* Object header created */
+    haddr_t     block_addr = HADDR_UNDEF;       /* Address of block of object headers */
+    size_t      oh_size = 0;            /* Size of each initial object header */
+    size_t      nused = 0;              /* # of headers using space in the block */
+    size_t      ncreated = 0;           /* # of headers created */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* check args */
+    HDassert(f);
+    HDassert(count > 0);
+    HDassert(loc);
+    HDassert(TRUE == H5P_isa_class(ocpl_id, H5P_OBJECT_CREATE));
+
+    /* Check for invalid access request */
+    if(0 == (H5F_INTENT(f) & H5F_ACC_RDWR))
+        HGOTO_ERROR(H5E_OHDR, H5E_BADVALUE, FAIL, "no write intent on file")
+
+    /* Make certain we allocate at least a reasonable size for the object header */
+    size_hint = H5O_ALIGN_F(f, MAX(H5O_MIN_SIZE, size_hint));
+
+    /* Get the property list */
+    if(NULL == (oc_plist = (H5P_genplist_t *)H5I_object(ocpl_id)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADTYPE, FAIL, "not a property list")
+
+    for(u = 0; u < count; u++) {
+        /* Set up the object header */
+        if(NULL == (oh = H5O_create_ohdr(f, size_hint, oc_plist)))
+            HGOTO_ERROR(H5E_OHDR, H5E_CANTINIT, FAIL, "unable to initialize object header")
+
+        /* Allocate disk space for all the headers, once the size is known */
+        /* (All the headers have the same prefix, since they are created
+         *      from the same property list)
+         */
+        if(0 == u) {
+            oh_size = (size_t)H5O_SIZEOF_HDR(oh) + size_hint;
+            if(HADDR_UNDEF == (block_addr = H5MF_alloc(f, H5FD_MEM_OHDR, dxpl_id, (hsize_t)oh_size * count)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "file allocation failed for object headers")
+        } /* end if */
+        HDassert(oh_size == (size_t)H5O_SIZEOF_HDR(oh) + size_hint);
+
+        /* Cache & open the object header (which takes ownership of it) */
+        nused = u + 1;
+        if(H5O_apply_ohdr(f, dxpl_id, oh, block_addr + (haddr_t)(oh_size * u), size_hint, initial_rc, &loc[u]) < 0) {
+            oh = NULL;
+            HGOTO_ERROR(H5E_OHDR, H5E_CANTINIT, FAIL, "unable to create object header")
+        } /* end if */
+        oh = NULL;
+        ncreated = u + 1;
+    } /* end for */
+
+done:
+    if(ret_value < 0) {
+        if(oh && H5O_free(oh) < 0)
+	    HDONE_ERROR(H5E_OHDR, H5E_CANTFREE, FAIL, "unable to destroy object header data")
+
+        /* Delete the headers already created */
+        for(u = 0; u < ncreated; u++) {
+            if(initial_rc > 0 && H5O_dec_rc_by_loc(&loc[u], dxpl_id) < 0)
+                HDONE_ERROR(H5E_OHDR, H5E_CANTDEC, FAIL, "unable to decrement refcount on object header")
+            if(H5O_close(&loc[u]) < 0)
+                HDONE_ERROR(H5E_OHDR, H5E_CLOSEERROR, FAIL, "unable to release object header")
+            if(H5O_delete(f, dxpl_id, block_addr + (haddr_t)(oh_size * u)) < 0)
+                HDONE_ERROR(H5E_OHDR, H5E_CANTDELETE, FAIL, "unable to delete object header")
+        } /* end for */
+
+        /* Release the space for the headers that weren't created */
+        if(H5F_addr_defined(block_addr) && nused < count)
+            if(H5MF_xfree(f, H5FD_MEM_OHDR, dxpl_id, block_addr + (haddr_t)(oh_size * nused), (hsize_t)oh_size * (count - nused)) < 0)
+                HDONE_ERROR(H5E_OHDR, H5E_CANTFREE, FAIL, "unable to free object header space")
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_create_multi() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5O_open
@@ -2479,6 +2669,7 @@ H5O_get_loc(hid_t object_id)
         case H5I_ERROR_CLASS:
         case H5I_ERROR_MSG:
         case H5I_ERROR_STACK:
+        case H5I_REQUEST:
         case H5I_NTYPES:
         default:
             HGOTO_ERROR(H5E_OHDR, H5E_BADTYPE, NULL, "invalid object type")
@@ -3529,6 +3720,9 @@ H5O_free(H5O_t *oh)
         oh->mesg = (H5O_mesg_t *)H5FL_SEQ_FREE(H5O_mesg_t, oh->mesg);
     } /* end if */
 
+    /* Destroy the attribute name index */
+    H5O_attr_names_reset(oh);
+
     /* destroy object header */
     oh = H5FL_FREE(H5O_t, oh);
 
@@ -37,6 +37,7 @@
 #include "H5private.h"		/* Generic Functions			*/
 #include "H5Apkg.h"		/* Attributes	  			*/
 #include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5FLprivate.h"	/* Free lists                           */
 #include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Opkg.h"             /* Object headers			*/
 #include "H5SMprivate.h"	/* Shared Object Header Messages	*/
@@ -48,6 +49,8 @@
 /* Local Macros */
 /****************/
 
+#define H5O_ATTR_NAMES_MAX_NENTRIES     1024    /* Most attribute names indexed */
+
 
 /******************/
 /* Local Typedefs */
@@ -60,15 +63,6 @@ typedef struct {
     H5O_ainfo_t *ainfo;         /* Attribute info struct */
 } H5O_iter_cvt_t;
 
-/* User data for iteration when opening an attribute */
-typedef struct {
-    /* down */
-    const char *name;           /* Name of attribute to open */
-
-    /* up */
-    H5A_t *attr;                /* Attribute data to update object header with */
-} H5O_iter_opn_t;
-
 /* User data for iteration when updating an attribute */
 typedef struct {
     /* down */
@@ -117,14 +111,14 @@ typedef struct {
     hbool_t found;              /* Found attribute to delete */
 } H5O_iter_rm_t;
 
-/* User data for iteration when checking if an attribute exists */
+/* Entry in an object header's index of attribute names */
 typedef struct {
-    /* down */
-    const char *name;           /* Name of attribute to open */
-
-    /* up */
-    hbool_t found;              /* Found attribute */
-} H5O_iter_xst_t;
+    char *name;                 /* Name of attribute (key for the index) */
+    hbool_t located;            /* Whether the fields below are current */
+    hbool_t exists;             /* Whether the object has an attribute with the name */
+    size_t mesg_idx;            /* Index of attribute message, for compact storage */
+    H5A_dense_bt2_name_rec_t record;    /* Name index record, for dense storage */
+} H5O_attr_name_t;
 
 
 /********************/
@@ -137,6 +131,13 @@ typedef struct {
 /********************/
 static htri_t H5O_attr_find_opened_attr(const H5O_loc_t *loc, H5A_t **attr,
     const char* name_to_open);
+static herr_t H5O_attr_names_find(H5F_t *f, hid_t dxpl_id, H5O_t *oh,
+    const H5O_ainfo_t *ainfo, const char *name, hbool_t search,
+    H5O_attr_name_t **ent);
+static H5O_attr_name_t *H5O_attr_names_insert(H5O_t *oh, const char *name,
+    hbool_t exists);
+static herr_t H5O_attr_names_update(H5O_t *oh, const char *old_name,
+    const char *new_name);
 
 /*********************/
 /* Package Variables */
@@ -152,6 +153,9 @@ static htri_t H5O_attr_find_opened_attr(const H5O_loc_t *loc, H5A_t **attr,
 /* Local Variables */
 /*******************/
 
+/* Declare a free list to manage the H5O_attr_name_t struct */
+H5FL_DEFINE_STATIC(H5O_attr_name_t);
+
 
 
 /*-------------------------------------------------------------------------
@@ -279,6 +283,9 @@ H5O_attr_create(const H5O_loc_t *loc, hid_t dxpl_id, H5A_t *attr)
                 H5O_iter_cvt_t udata;           /* User data for callback */
                 H5O_mesg_operator_t op;         /* Wrapper for operator */
 
+                /* The attributes are about to move, drop the name index */
+                H5O_attr_names_reset(oh);
+
                 /* Create dense storage for attributes */
                 if(H5A_dense_create(loc->file, dxpl_id, &ainfo) < 0)
                     HGOTO_ERROR(H5E_OHDR, H5E_CANTINIT, FAIL, "unable to create dense storage for attributes")
@@ -388,66 +395,24 @@ H5O_attr_create(const H5O_loc_t *loc, hid_t dxpl_id, H5A_t *attr)
     else if(shared_mesg < 0)
 	HGOTO_ERROR(H5E_ATTR, H5E_WRITEERROR, FAIL, "error determining if message should be shared")
 
+    /* Add the new attribute to the name index */
+    if(H5O_attr_names_update(oh, NULL, attr->shared->name) < 0)
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTUPDATE, FAIL, "unable to update attribute name index")
+
     /* Update the modification time, if any */
     if(H5O_touch_oh(loc->file, dxpl_id, oh, FALSE) < 0)
         HGOTO_ERROR(H5E_ATTR, H5E_CANTUPDATE, FAIL, "unable to update time on object")
 
 done:
+    /* Don't trust the name index after a partial update */
+    if(ret_value < 0 && oh)
+        H5O_attr_names_reset(oh);
     if(oh && H5O_unpin(oh) < 0)
         HDONE_ERROR(H5E_ATTR, H5E_CANTUNPIN, FAIL, "unable to unpin object header")
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5O_attr_create() */
 
-
-/*-------------------------------------------------------------------------
- * Function:	H5O_attr_open_cb
- *
- * Purpose:	Object header iterator callback routine to open an
- *              attribute stored compactly.
- *
- * Return:	Non-negative on success/Negative on failure
- *
- * Programmer:	Quincey Koziol
- *		koziol@hdfgroup.org
- *		Dec 11 2006
- *
- *-------------------------------------------------------------------------
- */
-static herr_t
-H5O_attr_open_cb(H5O_t *oh, H5O_mesg_t *mesg/*in,out*/, unsigned sequence,
-    unsigned UNUSED *oh_modified, void *_udata/*in,out*/)
-{
-    H5O_iter_opn_t *udata = (H5O_iter_opn_t *)_udata;   /* Operator user data */
-    herr_t ret_value = H5_ITER_CONT;   /* Return value */
-
-    FUNC_ENTER_NOAPI_NOINIT
-
-    /* check args */
-    HDassert(oh);
-    HDassert(mesg);
-    HDassert(!udata->attr);
-
-    /* Check for correct attribute message to modify */
-    if(HDstrcmp(((H5A_t *)mesg->native)->shared->name, udata->name) == 0) {
-        /* Make a copy of the attribute to return */
-        if(NULL == (udata->attr = H5A_copy(NULL, (H5A_t *)mesg->native)))
-            HGOTO_ERROR(H5E_ATTR, H5E_CANTCOPY, H5_ITER_ERROR, "unable to copy attribute")
-
-        /* Assign [somewhat arbitrary] creation order value, for older versions
-         * of the format or if creation order is not tracked */
-        if(oh->version == H5O_VERSION_1
-                || !(oh->flags & H5O_HDR_ATTR_CRT_ORDER_TRACKED))
-            udata->attr->shared->crt_idx = sequence;
-
-        /* Stop iterating */
-        ret_value = H5_ITER_STOP;
-    } /* end if */
-
-done:
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5O_attr_open_cb() */
-
 
 /*-------------------------------------------------------------------------
  * Function:	H5O_attr_open_by_name
@@ -504,33 +469,61 @@ H5O_attr_open_by_name(const H5O_loc_t *loc, const char *name, hid_t dxpl_id)
             HGOTO_ERROR(H5E_ATTR, H5E_CANTCOPY, NULL, "can't copy existing attribute")
     } /* end else if */
     else {
+        H5O_attr_name_t *ent;           /* Name index entry for attribute */
+
+        hbool_t dense = H5F_addr_defined(ainfo.fheap_addr);    /* Whether attributes are stored densely */
+
+        /* Look the attribute up in the object header's name index.  Densely
+         * stored attributes that haven't been looked up yet are searched
+         * for when they're opened below, rather than searching twice.
+         */
+        if(H5O_attr_names_find(loc->file, dxpl_id, oh, &ainfo, name, !dense, &ent) < 0)
+            HGOTO_ERROR(H5E_ATTR, H5E_CANTGET, NULL, "can't search attribute name index")
+        if(ent && ent->located && !ent->exists)
+            HGOTO_ERROR(H5E_ATTR, H5E_NOTFOUND, NULL, "can't locate attribute: '%s'", name)
+
         /* Check for attributes in dense storage */
-        if(H5F_addr_defined(ainfo.fheap_addr)) {
-            /* Open attribute with dense storage */
-            if(NULL == (opened_attr = H5A_dense_open(loc->file, dxpl_id, &ainfo, name)))
-                HGOTO_ERROR(H5E_ATTR, H5E_CANTOPENOBJ, NULL, "can't open attribute")
+        if(dense) {
+            if(ent && ent->located) {
+                /* Open attribute with dense storage, from its name index record */
+                if(NULL == (opened_attr = H5A_dense_open_rec(loc->file, dxpl_id, &ainfo, &ent->record)))
+                    HGOTO_ERROR(H5E_ATTR, H5E_CANTOPENOBJ, NULL, "can't open attribute")
+            } /* end if */
+            else {
+                H5A_dense_bt2_name_rec_t record;        /* Name index record for attribute */
+
+                /* Open attribute with dense storage */
+                if(NULL == (opened_attr = H5A_dense_open(loc->file, dxpl_id, &ainfo, name, &record)))
+                    HGOTO_ERROR(H5E_ATTR, H5E_CANTOPENOBJ, NULL, "can't open attribute")
+
+                /* Remember where the attribute is */
+                if(NULL == ent)
+                    if(NULL == (ent = H5O_attr_names_insert(oh, name, TRUE)))
+                        HGOTO_ERROR(H5E_ATTR, H5E_CANTINSERT, NULL, "can't add attribute name to index")
+                ent->record = record;
+                ent->exists = TRUE;
+                ent->located = TRUE;
+            } /* end else */
         } /* end if */
         else {
-            H5O_iter_opn_t udata;           /* User data for callback */
-            H5O_mesg_operator_t op;         /* Wrapper for operator */
-
-            /* Set up user data for callback */
-            udata.name = name;
-            udata.attr = NULL;
-
-            /* Iterate over attributes, to locate correct one to open */
-            op.op_type = H5O_MESG_OP_LIB;
-            op.u.lib_op = H5O_attr_open_cb;
-            if(H5O_msg_iterate_real(loc->file, oh, H5O_MSG_ATTR, &op, &udata, dxpl_id) < 0)
-                HGOTO_ERROR(H5E_ATTR, H5E_CANTOPENOBJ, NULL, "error updating attribute")
-
-            /* Check that we found the attribute */
-            if(!udata.attr)
-                HGOTO_ERROR(H5E_ATTR, H5E_NOTFOUND, NULL, "can't locate attribute: '%s'", name)
-
-            /* Get attribute opened from object header */
-            HDassert(udata.attr);
-            opened_attr = udata.attr;
+            H5O_mesg_t *mesg = &oh->mesg[ent->mesg_idx];   /* Attribute message */
+
+            /* Make a copy of the attribute to return */
+            if(NULL == (opened_attr = H5A_copy(NULL, (H5A_t *)mesg->native)))
+                HGOTO_ERROR(H5E_ATTR, H5E_CANTCOPY, NULL, "unable to copy attribute")
+
+            /* Assign [somewhat arbitrary] creation order value, for older versions
+             * of the format or if creation order is not tracked */
+            if(oh->version == H5O_VERSION_1
+                    || !(oh->flags & H5O_HDR_ATTR_CRT_ORDER_TRACKED)) {
+                unsigned sequence = 0;  /* Position among the attribute messages */
+                size_t u;               /* Local index variable */
+
+                for(u = 0; u < ent->mesg_idx; u++)
+                    if(oh->mesg[u].type == H5O_MSG_ATTR)
+                        sequence++;
+                opened_attr->shared->crt_idx = sequence;
+            } /* end if */
         } /* end else */
 
         /* Mark datatype as being on disk now */
@@ -672,6 +665,108 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5O_attr_open_by_idx() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_attr_open_all
+ *
+ * Purpose:	Open up to MAX_ATTRS attributes of an object at once, in the
+ *              order given by an index.  The attribute messages (and their
+ *              data) are all read in a single pass over the object's
+ *              attribute storage.
+ *
+ * Return:	Success:	Number of attributes opened
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+ssize_t
+H5O_attr_open_all(const H5O_loc_t *loc, H5_index_t idx_type,
+    H5_iter_order_t order, size_t max_attrs, H5A_t *attrs[], hid_t dxpl_id)
+{
+    H5O_t *oh = NULL;                   /* Object header */
+    H5O_ainfo_t ainfo;                  /* Attribute information for object */
+    H5A_attr_table_t atable = {0, NULL};        /* Table of attributes */
+    size_t nopened = 0;                 /* Number of attributes opened */
+    size_t u;                           /* Local index variable */
+    ssize_t ret_value;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_TAG(dxpl_id, loc->addr, FAIL)
+
+    /* Check arguments */
+    HDassert(loc);
+    HDassert(attrs || max_attrs == 0);
+
+    /* Protect the object header to iterate over */
+    if(NULL == (oh = H5O_protect(loc, dxpl_id, H5AC_READ)))
+	HGOTO_ERROR(H5E_ATTR, H5E_CANTPROTECT, FAIL, "unable to load object header")
+
+    /* Check for attribute info stored */
+    ainfo.fheap_addr = HADDR_UNDEF;
+    if(oh->version > H5O_VERSION_1) {
+        /* Check for (& retrieve if available) attribute info */
+        if(H5A_get_ainfo(loc->file, dxpl_id, oh, &ainfo) < 0)
+            HGOTO_ERROR(H5E_ATTR, H5E_CANTGET, FAIL, "can't check for attribute info message")
+    } /* end if */
+
+    /* Build the table of attributes, in the order requested */
+    if(H5F_addr_defined(ainfo.fheap_addr)) {
+        if(H5A_dense_build_table(loc->file, dxpl_id, &ainfo, idx_type, order, &atable) < 0)
+            HGOTO_ERROR(H5E_ATTR, H5E_CANTINIT, FAIL, "error building attribute table")
+    } /* end if */
+    else {
+        if(H5A_compact_build_table(loc->file, dxpl_id, oh, idx_type, order, &atable) < 0)
+            HGOTO_ERROR(H5E_ATTR, H5E_CANTINIT, FAIL, "error building attribute table")
+    } /* end else */
+
+    /* Release the object header, it's not needed anymore */
+    if(H5O_unprotect(loc, dxpl_id, oh, H5AC__NO_FLAGS_SET) < 0)
+	HGOTO_ERROR(H5E_ATTR, H5E_CANTUNPROTECT, FAIL, "unable to release object header")
+    oh = NULL;
+
+    /* Hand out the attributes from the table */
+    for(u = 0; u < atable.nattrs && u < max_attrs; u++) {
+        H5A_t *exist_attr = NULL;       /* Existing opened attribute object */
+        htri_t found_open_attr;         /* Whether opened object is found */
+
+        /* If the attribute is already opened, make a copy of it to share the
+         * object information.  If not, take the attribute from the table.
+         */
+        if((found_open_attr = H5O_attr_find_opened_attr(loc, &exist_attr, atable.attrs[u]->shared->name)) < 0)
+            HGOTO_ERROR(H5E_ATTR, H5E_CANTGET, FAIL, "failed in finding opened attribute")
+        else if(found_open_attr == TRUE) {
+            if(NULL == (attrs[u] = H5A_copy(NULL, exist_attr)))
+                HGOTO_ERROR(H5E_ATTR, H5E_CANTCOPY, FAIL, "can't copy existing attribute")
+            nopened++;
+        } /* end else if */
+        else {
+            attrs[u] = atable.attrs[u];
+            atable.attrs[u] = NULL;
+            nopened++;
+
+            /* Mark datatype as being on disk now */
+            if(H5T_set_loc(attrs[u]->shared->dt, loc->file, H5T_LOC_DISK) < 0)
+                HGOTO_ERROR(H5E_ATTR, H5E_CANTINIT, FAIL, "invalid datatype location")
+        } /* end else */
+    } /* end for */
+
+    /* Set return value */
+    ret_value = (ssize_t)nopened;
+
+done:
+    if(oh && H5O_unprotect(loc, dxpl_id, oh, H5AC__NO_FLAGS_SET) < 0)
+	HDONE_ERROR(H5E_ATTR, H5E_CANTUNPROTECT, FAIL, "unable to release object header")
+    if(atable.attrs && H5A_attr_release_table(&atable) < 0)
+        HDONE_ERROR(H5E_ATTR, H5E_CANTFREE, FAIL, "unable to release attribute table")
+
+    /* Release any attributes opened, on error */
+    if(ret_value < 0)
+        for(u = 0; u < nopened; u++)
+            if(H5A_close(attrs[u]) < 0)
+                HDONE_ERROR(H5E_ATTR, H5E_CANTCLOSEOBJ, FAIL, "can't close attribute")
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5O_attr_open_all() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5O_attr_find_opened_attr
@@ -981,11 +1076,18 @@ H5O_attr_write(const H5O_loc_t *loc, hid_t dxpl_id, H5A_t *attr)
             HGOTO_ERROR(H5E_ATTR, H5E_NOTFOUND, FAIL, "can't locate open attribute?")
     } /* end else */
 
+    /* The attribute's location may have changed (if it's shared) */
+    if(H5O_attr_names_update(oh, attr->shared->name, attr->shared->name) < 0)
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTUPDATE, FAIL, "unable to update attribute name index")
+
     /* Update the modification time, if any */
     if(H5O_touch_oh(loc->file, dxpl_id, oh, FALSE) < 0)
         HGOTO_ERROR(H5E_ATTR, H5E_CANTUPDATE, FAIL, "unable to update time on object")
 
 done:
+    /* Don't trust the name index after a partial update */
+    if(ret_value < 0 && oh)
+        H5O_attr_names_reset(oh);
     if(oh && H5O_unpin(oh) < 0)
         HDONE_ERROR(H5E_ATTR, H5E_CANTUNPIN, FAIL, "unable to unpin object header")
 
@@ -1240,11 +1342,18 @@ H5O_attr_rename(const H5O_loc_t *loc, hid_t dxpl_id, const char *old_name,
             HGOTO_ERROR(H5E_ATTR, H5E_NOTFOUND, FAIL, "can't locate attribute with old name")
     } /* end else */
 
+    /* Move the attribute to its new name in the name index */
+    if(H5O_attr_names_update(oh, old_name, new_name) < 0)
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTUPDATE, FAIL, "unable to update attribute name index")
+
     /* Update the modification time, if any */
     if(H5O_touch_oh(loc->file, dxpl_id, oh, FALSE) < 0)
         HGOTO_ERROR(H5E_ATTR, H5E_CANTUPDATE, FAIL, "unable to update time on object")
 
 done:
+    /* Don't trust the name index after a partial update */
+    if(ret_value < 0 && oh)
+        H5O_attr_names_reset(oh);
     if(oh && H5O_unpin(oh) < 0)
         HDONE_ERROR(H5E_ATTR, H5E_CANTUNPIN, FAIL, "unable to unpin object header")
 
@@ -1438,6 +1547,9 @@ H5O_attr_remove_update(const H5O_loc_t *loc, H5O_t *oh, H5O_ainfo_t *ainfo,
             H5A_t *exist_attr = NULL;
             htri_t found_open_attr = FALSE;
 
+            /* The attributes are about to move, drop the name index */
+            H5O_attr_names_reset(oh);
+
             /* Iterate over attributes, to put them into header */
             for(u = 0; u < ainfo->nattrs; u++) {
                 htri_t shared_mesg;             /* Should this message be stored in the Shared Message table? */
@@ -1615,6 +1727,10 @@ H5O_attr_remove(const H5O_loc_t *loc, const char *name, hid_t dxpl_id)
             HGOTO_ERROR(H5E_ATTR, H5E_NOTFOUND, FAIL, "can't locate attribute")
     } /* end else */
 
+    /* Remove the attribute from the name index */
+    if(H5O_attr_names_update(oh, name, NULL) < 0)
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTUPDATE, FAIL, "unable to update attribute name index")
+
     /* Update the attribute information after removing an attribute */
     if(ainfo_exists)
         if(H5O_attr_remove_update(loc, oh, &ainfo, dxpl_id) < 0)
@@ -1625,6 +1741,9 @@ H5O_attr_remove(const H5O_loc_t *loc, const char *name, hid_t dxpl_id)
         HGOTO_ERROR(H5E_ATTR, H5E_CANTUPDATE, FAIL, "unable to update time on object")
 
 done:
+    /* Don't trust the name index after a partial update */
+    if(ret_value < 0 && oh)
+        H5O_attr_names_reset(oh);
     if(oh && H5O_unpin(oh) < 0)
         HDONE_ERROR(H5E_ATTR, H5E_CANTUNPIN, FAIL, "unable to unpin object header")
 
@@ -1672,6 +1791,9 @@ H5O_attr_remove_by_idx(const H5O_loc_t *loc, H5_index_t idx_type,
             HGOTO_ERROR(H5E_ATTR, H5E_CANTGET, FAIL, "can't check for attribute info message")
     } /* end if */
 
+    /* The name of the attribute removed isn't known here, drop the name index */
+    H5O_attr_names_reset(oh);
+
     /* Check for attributes stored densely */
     if(H5F_addr_defined(ainfo.fheap_addr)) {
         /* Delete attribute from dense storage */
@@ -1717,6 +1839,9 @@ H5O_attr_remove_by_idx(const H5O_loc_t *loc, H5_index_t idx_type,
         HGOTO_ERROR(H5E_ATTR, H5E_CANTUPDATE, FAIL, "unable to update time on object")
 
 done:
+    /* Don't trust the name index after a partial update */
+    if(ret_value < 0 && oh)
+        H5O_attr_names_reset(oh);
     if(oh && H5O_unpin(oh) < 0)
         HDONE_ERROR(H5E_ATTR, H5E_CANTUNPIN, FAIL, "unable to unpin object header")
     if(atable.attrs && H5A_attr_release_table(&atable) < 0)
@@ -1779,46 +1904,6 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
 } /* end H5O_attr_count_real */
 
-
-/*-------------------------------------------------------------------------
- * Function:	H5O_attr_exists_cb
- *
- * Purpose:	Object header iterator callback routine to check for an
- *              attribute stored compactly, by name.
- *
- * Return:	Non-negative on success/Negative on failure
- *
- * Programmer:	Quincey Koziol
- *		koziol@hdfgroup.org
- *		Dec 11 2006
- *
- *-------------------------------------------------------------------------
- */
-static herr_t
-H5O_attr_exists_cb(H5O_t UNUSED *oh, H5O_mesg_t *mesg/*in,out*/,
-    unsigned UNUSED sequence, unsigned UNUSED *oh_modified, void *_udata/*in,out*/)
-{
-    H5O_iter_rm_t *udata = (H5O_iter_rm_t *)_udata;   /* Operator user data */
-    herr_t ret_value = H5_ITER_CONT;    /* Return value */
-
-    FUNC_ENTER_NOAPI_NOINIT_NOERR
-
-    /* check args */
-    HDassert(mesg);
-    HDassert(!udata->found);
-
-    /* Check for correct attribute message */
-    if(HDstrcmp(((H5A_t *)mesg->native)->shared->name, udata->name) == 0) {
-        /* Indicate that this message is the attribute sought */
-        udata->found = TRUE;
-
-        /* Stop iterating */
-        ret_value = H5_ITER_STOP;
-    } /* end if */
-
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5O_attr_exists_cb() */
-
 
 /*-------------------------------------------------------------------------
  * Function:	H5O_attr_exists
@@ -1837,6 +1922,7 @@ H5O_attr_exists(const H5O_loc_t *loc, const char *name, hid_t dxpl_id)
 {
     H5O_t *oh = NULL;           /* Pointer to actual object header */
     H5O_ainfo_t ainfo;          /* Attribute information for object */
+    H5O_attr_name_t *ent;       /* Name index entry for attribute */
     htri_t ret_value;           /* Return value */
 
     FUNC_ENTER_NOAPI_NOINIT_TAG(dxpl_id, loc->addr, FAIL)
@@ -1857,31 +1943,10 @@ H5O_attr_exists(const H5O_loc_t *loc, const char *name, hid_t dxpl_id)
             HGOTO_ERROR(H5E_ATTR, H5E_CANTGET, FAIL, "can't check for attribute info message")
     } /* end if */
 
-    /* Check for attributes stored densely */
-    if(H5F_addr_defined(ainfo.fheap_addr)) {
-        /* Check if attribute exists in dense storage */
-        if((ret_value = H5A_dense_exists(loc->file, dxpl_id, &ainfo, name)) < 0)
-            HGOTO_ERROR(H5E_ATTR, H5E_BADITER, FAIL, "error checking for existence of attribute")
-    } /* end if */
-    else {
-        H5O_iter_rm_t udata;            /* User data for callback */
-        H5O_mesg_operator_t op;         /* Wrapper for operator */
-
-        /* Set up user data for callback */
-        udata.f = loc->file;
-        udata.dxpl_id = dxpl_id;
-        udata.name = name;
-        udata.found = FALSE;
-
-        /* Iterate over existing attributes, checking for attribute with same name */
-        op.op_type = H5O_MESG_OP_LIB;
-        op.u.lib_op = H5O_attr_exists_cb;
-        if(H5O_msg_iterate_real(loc->file, oh, H5O_MSG_ATTR, &op, &udata, dxpl_id) < 0)
-            HGOTO_ERROR(H5E_ATTR, H5E_BADITER, FAIL, "error checking for existence of attribute")
-
-        /* Check that we found the attribute */
-        ret_value = (htri_t)udata.found;
-    } /* end else */
+    /* Look the attribute up in the object header's name index */
+    if(H5O_attr_names_find(loc->file, dxpl_id, oh, &ainfo, name, TRUE, &ent) < 0)
+        HGOTO_ERROR(H5E_ATTR, H5E_BADITER, FAIL, "error checking for existence of attribute")
+    ret_value = (htri_t)ent->exists;
 
 done:
     if(oh && H5O_unprotect(loc, dxpl_id, oh, H5AC__NO_FLAGS_SET) < 0)
@@ -1973,6 +2038,247 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* H5O_attr_bh_info() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5O_attr_names_free_cb
+ *
+ * Purpose:	Release an entry in an attribute name index
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O_attr_names_free_cb(void *_ent, void UNUSED *key, void UNUSED *op_data)
+{
+    H5O_attr_name_t *ent = (H5O_attr_name_t *)_ent;     /* Entry to release */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(ent);
+
+    H5MM_xfree(ent->name);
+    ent = H5FL_FREE(H5O_attr_name_t, ent);
+
+    FUNC_LEAVE_NOAPI(0)
+} /* end H5O_attr_names_free_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_attr_names_insert
+ *
+ * Purpose:	Add an entry for an attribute name to an object header's
+ *              name index.  The name mustn't be in the index already.
+ *              The new entry isn't located yet.  A full index is emptied
+ *              first, so that looking up many different names (most of
+ *              which may not exist) doesn't grow it without bound.
+ *
+ * Return:	Success:	Pointer to the new entry
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5O_attr_name_t *
+H5O_attr_names_insert(H5O_t *oh, const char *name, hbool_t exists)
+{
+    H5O_attr_name_t *ent = NULL;        /* New entry */
+    H5O_attr_name_t *ret_value;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(oh);
+    HDassert(name);
+
+    /* Create the index on first use, or empty it when full */
+    if(NULL == oh->attr_names) {
+        if(NULL == (oh->attr_names = H5SL_create(H5SL_TYPE_STR, NULL)))
+            HGOTO_ERROR(H5E_ATTR, H5E_CANTCREATE, NULL, "can't create attribute name index")
+    } /* end if */
+    else if(H5SL_count(oh->attr_names) >= H5O_ATTR_NAMES_MAX_NENTRIES)
+        H5SL_free(oh->attr_names, H5O_attr_names_free_cb, NULL);
+
+    /* Create the entry */
+    if(NULL == (ent = H5FL_CALLOC(H5O_attr_name_t)))
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTALLOC, NULL, "memory allocation failed")
+    if(NULL == (ent->name = H5MM_xstrdup(name)))
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTALLOC, NULL, "memory allocation failed")
+    ent->located = FALSE;
+    ent->exists = exists;
+
+    /* Add it to the index */
+    if(H5SL_insert(oh->attr_names, ent, ent->name) < 0)
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTINSERT, NULL, "can't insert attribute name into index")
+
+    /* Set return value */
+    ret_value = ent;
+
+done:
+    if(NULL == ret_value && ent)
+        H5O_attr_names_free_cb(ent, NULL, NULL);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_attr_names_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_attr_names_find
+ *
+ * Purpose:	Look up an attribute name in an object header's name index.
+ *              Names not seen before are searched for in the attribute
+ *              storage once and the result remembered, so that repeated
+ *              lookups (i.e. H5Aexists followed by H5Aopen) don't search
+ *              the storage again.  *ENT is set to the name's entry, which
+ *              is always located on return.  If SEARCH is FALSE, the
+ *              storage isn't searched and *ENT is set to the name's entry
+ *              (which may not be located) or NULL if there isn't one.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O_attr_names_find(H5F_t *f, hid_t dxpl_id, H5O_t *oh,
+    const H5O_ainfo_t *ainfo, const char *name, hbool_t search,
+    H5O_attr_name_t **ent)
+{
+    hbool_t dense = H5F_addr_defined(ainfo->fheap_addr);   /* Whether attributes are stored densely */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(oh);
+    HDassert(ainfo);
+    HDassert(name);
+    HDassert(ent);
+
+    /* Check for an entry already */
+    *ent = oh->attr_names ? (H5O_attr_name_t *)H5SL_search(oh->attr_names, name) : NULL;
+
+    /* Compact attribute messages move around in the object header as it's
+     * condensed, so check that the message is still the attribute sought.
+     */
+    if(*ent && (*ent)->located && (*ent)->exists && !dense) {
+        hbool_t valid = FALSE;          /* Whether the entry is current */
+
+        if((*ent)->mesg_idx < oh->nmesgs && oh->mesg[(*ent)->mesg_idx].type == H5O_MSG_ATTR) {
+            H5O_mesg_t *mesg = &oh->mesg[(*ent)->mesg_idx];     /* Attribute message */
+
+            H5O_LOAD_NATIVE(f, dxpl_id, 0, oh, mesg, FAIL)
+            valid = (hbool_t)(0 == HDstrcmp(((H5A_t *)mesg->native)->shared->name, name));
+        } /* end if */
+        if(!valid)
+            (*ent)->located = FALSE;
+    } /* end if */
+
+    /* Search the attribute storage for the name, if needed */
+    if(search && (NULL == *ent || !(*ent)->located)) {
+        H5O_attr_name_t *new_ent = *ent;        /* Entry for name */
+
+        /* Reuse the name's entry, if there is one */
+        if(NULL == new_ent) {
+            if(NULL == (new_ent = H5O_attr_names_insert(oh, name, FALSE)))
+                HGOTO_ERROR(H5E_ATTR, H5E_CANTINSERT, FAIL, "can't add attribute name to index")
+            *ent = new_ent;
+        } /* end if */
+        new_ent->exists = FALSE;
+
+        if(dense) {
+            htri_t exists;              /* Whether the attribute exists */
+
+            if((exists = H5A_dense_exists(f, dxpl_id, ainfo, name, &new_ent->record)) < 0)
+                HGOTO_ERROR(H5E_ATTR, H5E_BADITER, FAIL, "error checking for existence of attribute")
+            new_ent->exists = (hbool_t)exists;
+        } /* end if */
+        else {
+            size_t u;                   /* Local index variable */
+
+            for(u = 0; u < oh->nmesgs; u++)
+                if(oh->mesg[u].type == H5O_MSG_ATTR) {
+                    H5O_mesg_t *mesg = &oh->mesg[u];    /* Attribute message */
+
+                    H5O_LOAD_NATIVE(f, dxpl_id, 0, oh, mesg, FAIL)
+                    if(0 == HDstrcmp(((H5A_t *)mesg->native)->shared->name, name)) {
+                        new_ent->mesg_idx = u;
+                        new_ent->exists = TRUE;
+                        break;
+                    } /* end if */
+                } /* end if */
+        } /* end else */
+        new_ent->located = TRUE;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_attr_names_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_attr_names_update
+ *
+ * Purpose:	Keep an object header's name index (if there is one) in
+ *              step with a change to its attributes: OLD_NAME no longer
+ *              exists and NEW_NAME does, either of which may be NULL.  The
+ *              location of NEW_NAME is found when it's next looked up.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O_attr_names_update(H5O_t *oh, const char *old_name, const char *new_name)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(oh);
+
+    if(oh->attr_names) {
+        H5O_attr_name_t *ent;           /* Entry for name */
+
+        if(old_name && (NULL == new_name || HDstrcmp(old_name, new_name)))
+            if(NULL != (ent = (H5O_attr_name_t *)H5SL_remove(oh->attr_names, old_name)))
+                H5O_attr_names_free_cb(ent, NULL, NULL);
+        if(new_name) {
+            /* Reuse the name's entry, if there is one */
+            if(NULL != (ent = (H5O_attr_name_t *)H5SL_search(oh->attr_names, new_name))) {
+                ent->located = FALSE;
+                ent->exists = TRUE;
+            } /* end if */
+            else if(NULL == H5O_attr_names_insert(oh, new_name, TRUE))
+                HGOTO_ERROR(H5E_ATTR, H5E_CANTINSERT, FAIL, "can't add attribute name to index")
+        } /* end if */
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_attr_names_update() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_attr_names_reset
+ *
+ * Purpose:	Discard an object header's index of attribute names.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5O_attr_names_reset(H5O_t *oh)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(oh);
+
+    if(oh->attr_names) {
+        H5SL_destroy(oh->attr_names, H5O_attr_names_free_cb, NULL);
+        oh->attr_names = NULL;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5O_attr_names_reset() */
+
+
 #ifndef H5_NO_DEPRECATED_SYMBOLS
 
 /*-------------------------------------------------------------------------
@@ -307,6 +307,7 @@ struct H5O_t {
     H5O_mesg_t	*mesg;			/*array of messages		     */
     size_t      link_msgs_seen;         /* # of link messages seen when loading header */
     size_t      attr_msgs_seen;         /* # of attribute messages seen when loading header */
+    H5SL_t      *attr_names;            /* Attribute names looked up, with their locations (not stored) */
 
     /* Chunk management (not stored) */
     size_t	nchunks;		/*number of chunks		     */
@@ -603,6 +604,7 @@ H5_DLL herr_t H5O_attr_delete(H5F_t *f, hid_t dxpl_id, H5O_t *open_oh, void *_me
 H5_DLL herr_t H5O_attr_link(H5F_t *f, hid_t dxpl_id, H5O_t *open_oh, void *_mesg);
 H5_DLL herr_t H5O_attr_count_real(H5F_t *f, hid_t dxpl_id, H5O_t *oh,
     hsize_t *nattrs);
+H5_DLL herr_t H5O_attr_names_reset(H5O_t *oh);
 
 
 /* These functions operate on object locations */
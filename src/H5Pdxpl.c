@@ -83,6 +83,13 @@
 /* Definitions for vlen free info property */
 #define H5D_XFER_VLEN_FREE_INFO_SIZE    sizeof(void *)
 #define H5D_XFER_VLEN_FREE_INFO_DEF     H5D_VLEN_FREE_INFO
+/* Definitions for vlen data arena property */
+#define H5D_XFER_VLEN_ARENA_SIZE        sizeof(H5T_vlen_arena_t *)
+#define H5D_XFER_VLEN_ARENA_DEF         NULL
+#define H5D_XFER_VLEN_ARENA_DEL         H5P__dxfr_vlen_arena_del
+#define H5D_XFER_VLEN_ARENA_COPY        H5P__dxfr_vlen_arena_copy
+#define H5D_XFER_VLEN_ARENA_CMP         H5P__dxfr_vlen_arena_cmp
+#define H5D_XFER_VLEN_ARENA_CLOSE       H5P__dxfr_vlen_arena_close
 /* Definitions for hyperslab vector size property */
 /* (Be cautious about increasing the default size, there are arrays allocated
  *      on the stack which depend on it - QAK)
@@ -204,6 +211,10 @@ static herr_t H5P__dxfr_xform_del(hid_t prop_id, const char* name, size_t size,
 static herr_t H5P__dxfr_xform_copy(const char* name, size_t size, void* value);
 static int H5P__dxfr_xform_cmp(const void *value1, const void *value2, size_t size);
 static herr_t H5P__dxfr_xform_close(const char* name, size_t size, void* value);
+static herr_t H5P__dxfr_vlen_arena_del(hid_t prop_id, const char* name, size_t size, void* value);
+static herr_t H5P__dxfr_vlen_arena_copy(const char* name, size_t size, void* value);
+static int H5P__dxfr_vlen_arena_cmp(const void *value1, const void *value2, size_t size);
+static herr_t H5P__dxfr_vlen_arena_close(const char* name, size_t size, void* value);
 
 
 /*********************/
@@ -249,6 +260,7 @@ static const H5MM_allocate_t H5D_def_vlen_alloc_g = H5D_XFER_VLEN_ALLOC_DEF;   /
 static const void *H5D_def_vlen_alloc_info_g = H5D_XFER_VLEN_ALLOC_INFO_DEF;   /* Default value for vlen allocation information */
 static const H5MM_free_t H5D_def_vlen_free_g = H5D_XFER_VLEN_FREE_DEF;         /* Default value for vlen free function */
 static const void *H5D_def_vlen_free_info_g = H5D_XFER_VLEN_FREE_INFO_DEF;     /* Default value for vlen free information */
+static const H5T_vlen_arena_t *H5D_def_vlen_arena_g = H5D_XFER_VLEN_ARENA_DEF; /* Default value for vlen data arena */
 static const size_t H5D_def_hyp_vec_size_g = H5D_XFER_HYPER_VECTOR_SIZE_DEF;   /* Default value for vector size */
 static const haddr_t H5D_def_metadata_tag_g = H5AC_METADATA_TAG_DEF;              /* Default value for metadata tag */
 static const H5FD_mpio_xfer_t H5D_def_io_xfer_mode_g = H5D_XFER_IO_XFER_MODE_DEF;      /* Default value for I/O transfer mode */
@@ -351,6 +363,13 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the vlen data arena property */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_VLEN_ARENA_NAME, H5D_XFER_VLEN_ARENA_SIZE, &H5D_def_vlen_arena_g,
+            NULL, NULL, NULL, NULL, NULL,
+            H5D_XFER_VLEN_ARENA_DEL, H5D_XFER_VLEN_ARENA_COPY, H5D_XFER_VLEN_ARENA_CMP, H5D_XFER_VLEN_ARENA_CLOSE) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the vector size property */
     if(H5P_register_real(pclass, H5D_XFER_HYPER_VECTOR_SIZE_NAME, H5D_XFER_HYPER_VECTOR_SIZE_SIZE, &H5D_def_hyp_vec_size_g, 
             NULL, NULL, NULL, H5D_XFER_HYPER_VECTOR_SIZE_ENC, H5D_XFER_HYPER_VECTOR_SIZE_DEC,
@@ -909,6 +928,133 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dxfr_xform_close() */
 
+
+/*-------------------------------------------------------------------------
+ * Function: H5P__dxfr_vlen_arena_del
+ *
+ * Purpose: Releases the property list's reference to its VL data arena
+ *              when the property is deleted.
+ *
+ * Return: Success: SUCCEED, Failure: FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+/* ARGSUSED */
+static herr_t
+H5P__dxfr_vlen_arena_del(hid_t UNUSED prop_id, const char UNUSED *name, size_t UNUSED size, void *value)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(value);
+
+    if(*(H5T_vlen_arena_t **)value && H5T_vlen_arena_close(*(H5T_vlen_arena_t **)value) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTCLOSEOBJ, FAIL, "error closing the VL data arena")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5P__dxfr_vlen_arena_del() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5P__dxfr_vlen_arena_copy
+ *
+ * Purpose: Shares the VL data arena with the copy of a property list, so
+ *              that VL data read with either list is released by
+ *              H5Dvlen_reclaim() with the other.
+ *
+ * Return: Success: SUCCEED, Failure: FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+/* ARGSUSED */
+static herr_t
+H5P__dxfr_vlen_arena_copy(const char UNUSED *name, size_t UNUSED size, void *value)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(value);
+
+    if(*(H5T_vlen_arena_t **)value && H5T_vlen_arena_incr_ref(*(H5T_vlen_arena_t **)value) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTCOPY, FAIL, "error sharing the VL data arena")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5P__dxfr_vlen_arena_copy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5P__dxfr_vlen_arena_cmp
+ *
+ * Purpose: Compare the VL data arena settings of two property lists.
+ *
+ * Return: positive if VALUE1 is greater than VALUE2, negative if VALUE2 is
+ *		greater than VALUE1 and zero if VALUE1 and VALUE2 are equal.
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5P__dxfr_vlen_arena_cmp(const void *_arena1, const void *_arena2, size_t UNUSED size)
+{
+    const H5T_vlen_arena_t * const *arena1 = (const H5T_vlen_arena_t * const *)_arena1; /* Create local aliases for values */
+    const H5T_vlen_arena_t * const *arena2 = (const H5T_vlen_arena_t * const *)_arena2; /* Create local aliases for values */
+    size_t block_size1, block_size2;    /* Arenas' block sizes */
+    int ret_value = 0;                  /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(arena1);
+    HDassert(arena2);
+    HDassert(size == sizeof(H5T_vlen_arena_t *));
+
+    /* Check for a property being set */
+    if(*arena1 == NULL && *arena2 != NULL) HGOTO_DONE(-1);
+    if(*arena1 != NULL && *arena2 == NULL) HGOTO_DONE(1);
+
+    if(*arena1) {
+        block_size1 = H5T_vlen_arena_get_block_size(*arena1);
+        block_size2 = H5T_vlen_arena_get_block_size(*arena2);
+        if(block_size1 < block_size2) HGOTO_DONE(-1);
+        if(block_size1 > block_size2) HGOTO_DONE(1);
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5P__dxfr_vlen_arena_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5P__dxfr_vlen_arena_close
+ *
+ * Purpose: Releases the property list's reference to its VL data arena
+ *              when the property list is closed.  The arena and the VL
+ *              data allocated from it are freed with the last reference.
+ *
+ * Return: Success: SUCCEED, Failure: FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+/* ARGSUSED */
+static herr_t
+H5P__dxfr_vlen_arena_close(const char UNUSED *name, size_t UNUSED size, void *value)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(value);
+
+    if(*(H5T_vlen_arena_t **)value && H5T_vlen_arena_close(*(H5T_vlen_arena_t **)value) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTCLOSEOBJ, FAIL, "error closing the VL data arena")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5P__dxfr_vlen_arena_close() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_data_transform
@@ -1649,6 +1795,96 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_vlen_mem_manager() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_vlen_mem_arena
+ *
+ * Purpose:	Makes reads using a dataset transfer property list allocate
+ *		the memory for VL data from an arena of blocks of at least
+ *		BLOCK_SIZE bytes, instead of with one call to the allocation
+ *		routine per VL sequence or string.  H5Dvlen_reclaim() called
+ *		with the property list, or a copy of it, frees all the VL
+ *		data in the arena at once, without iterating over the
+ *		buffer; so does closing the last property list using the
+ *		arena.  An arena takes precedence over the allocate/free
+ *		pair set with H5Pset_vlen_mem_manager.
+ *
+ *		Setting a new block size starts a new arena, releasing the
+ *		property list's reference to the old one.  A BLOCK_SIZE of
+ *		zero stops using an arena.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_vlen_mem_arena(hid_t plist_id, size_t block_size)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    H5T_vlen_arena_t *arena = NULL; /* VL data arena */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", plist_id, block_size);
+
+    /* Check arguments */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
+
+    /* Release the previous arena, if there is one */
+    if(H5P_get(plist, H5D_XFER_VLEN_ARENA_NAME, &arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+    if(arena && H5T_vlen_arena_close(arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CLOSEERROR, FAIL, "unable to release VL data arena")
+    arena = NULL;
+
+    /* Create the new arena */
+    if(block_size > 0)
+        if(NULL == (arena = H5T_vlen_arena_create(block_size)))
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTCREATE, FAIL, "unable to create VL data arena")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_VLEN_ARENA_NAME, &arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_vlen_mem_arena() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_vlen_mem_arena
+ *
+ * Purpose:	The inverse of H5Pset_vlen_mem_arena()
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_vlen_mem_arena(hid_t plist_id, size_t *block_size/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    H5T_vlen_arena_t *arena;    /* VL data arena */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, block_size);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    if(block_size) {
+        if(H5P_get(plist, H5D_XFER_VLEN_ARENA_NAME, &arena) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+        *block_size = arena ? H5T_vlen_arena_get_block_size(arena) : 0;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_vlen_mem_arena() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_hyper_vector_size
@@ -170,6 +170,18 @@
 #define H5F_ACS_CORE_WRITE_TRACKING_PAGE_SIZE_DEF       524288
 #define H5F_ACS_CORE_WRITE_TRACKING_PAGE_SIZE_ENC       H5P__encode_size_t
 #define H5F_ACS_CORE_WRITE_TRACKING_PAGE_SIZE_DEC       H5P__decode_size_t
+/* Definition of metadata cache background flush threshold */
+#define H5F_ACS_MDC_BG_FLUSH_SIZE               sizeof(double)
+#define H5F_ACS_MDC_BG_FLUSH_DEF                0.0f
+#define H5F_ACS_MDC_BG_FLUSH_ENC                H5P__encode_double
+#define H5F_ACS_MDC_BG_FLUSH_DEC                H5P__decode_double
+#ifdef H5_HAVE_PARALLEL
+/* Definition of collective metadata read flag */
+#define H5F_ACS_COLL_MD_READ_SIZE               sizeof(hbool_t)
+#define H5F_ACS_COLL_MD_READ_DEF                FALSE
+#define H5F_ACS_COLL_MD_READ_ENC                H5P__encode_hbool_t
+#define H5F_ACS_COLL_MD_READ_DEC                H5P__decode_hbool_t
+#endif /* H5_HAVE_PARALLEL */
 
 /******************/
 /* Local Typedefs */
@@ -261,6 +273,10 @@ static const unsigned H5F_def_efc_size_g = H5F_ACS_EFC_SIZE_DEF;
 static const H5FD_file_image_info_t H5F_def_file_image_info_g = H5F_ACS_FILE_IMAGE_INFO_DEF;                 /* Default file image info and callbacks */
 static const hbool_t H5F_def_core_write_tracking_flag_g = H5F_ACS_CORE_WRITE_TRACKING_FLAG_DEF;              /* Default setting for core VFD write tracking */
 static const size_t H5F_def_core_write_tracking_page_size_g = H5F_ACS_CORE_WRITE_TRACKING_PAGE_SIZE_DEF;     /* Default core VFD write tracking page size */
+static const double H5F_def_mdc_bg_flush_g = H5F_ACS_MDC_BG_FLUSH_DEF;              /* Default metadata cache background flush threshold */
+#ifdef H5_HAVE_PARALLEL
+static const hbool_t H5F_def_coll_md_read_g = H5F_ACS_COLL_MD_READ_DEF;            /* Default setting for collective metadata reads */
+#endif /* H5_HAVE_PARALLEL */
 
 
 /*-------------------------------------------------------------------------
@@ -422,6 +438,20 @@ H5P_facc_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the metadata cache background flush threshold */
+    if(H5P_register_real(pclass, H5F_ACS_MDC_BG_FLUSH_NAME, H5F_ACS_MDC_BG_FLUSH_SIZE, &H5F_def_mdc_bg_flush_g,
+            NULL, NULL, NULL, H5F_ACS_MDC_BG_FLUSH_ENC, H5F_ACS_MDC_BG_FLUSH_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+#ifdef H5_HAVE_PARALLEL
+    /* Register the collective metadata read flag */
+    if(H5P_register_real(pclass, H5F_ACS_COLL_MD_READ_NAME, H5F_ACS_COLL_MD_READ_SIZE, &H5F_def_coll_md_read_g,
+            NULL, NULL, NULL, H5F_ACS_COLL_MD_READ_ENC, H5F_ACS_COLL_MD_READ_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+#endif /* H5_HAVE_PARALLEL */
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P_facc_reg_prop() */
@@ -1216,6 +1246,7 @@ herr_t
 H5Pset_mdc_config(hid_t plist_id, H5AC_cache_config_t *config_ptr)
 {
     H5P_genplist_t *plist;      /* Property list pointer */
+    H5AC_cache_config_t config; /* Current version of configuration */
     herr_t ret_value = SUCCEED;   /* return value */
 
     FUNC_ENTER_API(FAIL)
@@ -1225,17 +1256,19 @@ H5Pset_mdc_config(hid_t plist_id, H5AC_cache_config_t *config_ptr)
     if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
         HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
 
+    /* Translate the new configuration to the current version of
+     * H5AC_cache_config_t, which is what the property holds */
+    if(config_ptr == NULL)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "NULL config_ptr on entry.")
+    if(H5AC_config_to_current(config_ptr, &config) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Unknown config version.")
+
     /* validate the new configuration */
-    if(H5AC_validate_config(config_ptr) < 0)
+    if(H5AC_validate_config(&config) < 0)
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid metadata cache configuration")
 
     /* set the modified config */
-
-    /* If we ever support multiple versions of H5AC_cache_config_t, we
-     * will have to test the version and do translation here.
-     */
-
-    if(H5P_set(plist, H5F_ACS_META_CACHE_INIT_CONFIG_NAME, config_ptr) < 0)
+    if(H5P_set(plist, H5F_ACS_META_CACHE_INIT_CONFIG_NAME, &config) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata cache initial config")
 
 done:
@@ -1264,6 +1297,7 @@ herr_t
 H5Pget_mdc_config(hid_t plist_id, H5AC_cache_config_t *config_ptr)
 {
     H5P_genplist_t *plist;      /* Property list pointer */
+    H5AC_cache_config_t config; /* Current version of configuration */
     herr_t ret_value = SUCCEED;   /* return value */
 
     FUNC_ENTER_API(FAIL)
@@ -1277,17 +1311,14 @@ H5Pget_mdc_config(hid_t plist_id, H5AC_cache_config_t *config_ptr)
     if(config_ptr == NULL)
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "NULL config_ptr on entry.")
 
-    if(config_ptr->version != H5AC__CURR_CACHE_CONFIG_VERSION)
-        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Unknown config version.")
-
-    /* If we ever support multiple versions of H5AC_cache_config_t, we
-     * will have to get the cannonical version here, and then translate
-     * to the version of the structure supplied.
+    /* Get the current initial metadata cache resize configuration, which
+     * is held in the current version of H5AC_cache_config_t, and translate
+     * it to the version of the structure supplied.
      */
-
-    /* Get the current initial metadata cache resize configuration */
-    if(H5P_get(plist, H5F_ACS_META_CACHE_INIT_CONFIG_NAME, config_ptr) < 0)
+    if(H5P_get(plist, H5F_ACS_META_CACHE_INIT_CONFIG_NAME, &config) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get metadata cache initial resize config")
+    if(H5AC_config_from_current(&config, config_ptr) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Unknown config version.")
 
 done:
     FUNC_LEAVE_API(ret_value)
@@ -2575,6 +2606,9 @@ H5P__facc_cache_config_cmp(const void *_config1, const void *_config2, size_t UN
     if(config1->metadata_write_strategy < config2->metadata_write_strategy) HGOTO_DONE(-1);
     if(config1->metadata_write_strategy > config2->metadata_write_strategy) HGOTO_DONE(1);
 
+    if(config1->replacement_policy < config2->replacement_policy) HGOTO_DONE(-1);
+    if(config1->replacement_policy > config2->replacement_policy) HGOTO_DONE(1);
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__facc_cache_config_cmp() */
@@ -2702,6 +2736,10 @@ H5P__facc_cache_config_enc(const void *value, void **_pp, size_t *size)
 
         /* int */
         INT32ENCODE(*pp, (int32_t)config->metadata_write_strategy);
+
+        /* (Not encoded in version 1) */
+        HDassert(config->version == H5AC__CURR_CACHE_CONFIG_VERSION);
+        *(*pp)++ = (uint8_t)config->replacement_policy;
     } /* end if */
 
     /* Compute encoded size of variably-encoded values */
@@ -2717,7 +2755,7 @@ H5P__facc_cache_config_enc(const void *value, void **_pp, size_t *size)
     *size += 1 + H5VM_limit_enc_size(enc_value);
 
     /* Compute encoded size of fixed-size values */
-    *size += (5 + (sizeof(unsigned) * 8) + (sizeof(double) * 8) +
+    *size += (6 + (sizeof(unsigned) * 8) + (sizeof(double) * 8) +
             (sizeof(int32_t) * 4) + sizeof(int64_t) +
             H5AC__MAX_TRACE_FILE_NAME_LEN + 1);
 
@@ -2855,6 +2893,15 @@ H5P__facc_cache_config_dec(const void **_pp, void *_value)
     /* int */
     INT32DECODE(*pp, config->metadata_write_strategy);
 
+    /* Version 1 configurations were encoded without a replacement policy */
+    if(config->version == H5AC__CACHE_CONFIG_VERSION_1)
+        config->replacement_policy = H5C_rp__lru;
+    else if(config->version == H5AC__CURR_CACHE_CONFIG_VERSION)
+        config->replacement_policy = (enum H5C_cache_rp_policy)*(*pp)++;
+    else
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "unknown metadata cache configuration version")
+    config->version = H5AC__CURR_CACHE_CONFIG_VERSION;
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__facc_cache_config_dec() */
@@ -3082,3 +3129,153 @@ done:
     FUNC_LEAVE_API(ret_value)
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_mdc_background_flush
+ *
+ * Purpose:	Sets the fraction of the metadata cache which may be dirty
+ *              before dirty entries are written ahead of need, so that
+ *              entries the cache later evicts are usually clean already.
+ *              Entries are written, and stay in the cache, until half
+ *              that fraction of the cache is dirty.  In a thread-safe
+ *              library, they are written by a background thread.
+ *              A threshold of zero (the default) disables this.
+ *
+ *              The setting is ignored for files opened with a parallel
+ *              file driver, whose cache is flushed collectively.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_mdc_background_flush(hid_t plist_id, double threshold)
+{
+    H5P_genplist_t *plist;        /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "id", plist_id, threshold);
+
+    /* Check argument */
+    if(threshold < 0.0f || threshold > 1.0f)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "threshold must be in the interval [0.0, 1.0]")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5F_ACS_MDC_BG_FLUSH_NAME, &threshold) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata cache background flush threshold")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_mdc_background_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_mdc_background_flush
+ *
+ * Purpose:	Gets the metadata cache background flush threshold.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_mdc_background_flush(hid_t plist_id, double *threshold)
+{
+    H5P_genplist_t *plist;        /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*d", plist_id, threshold);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value */
+    if(threshold) {
+        if(H5P_get(plist, H5F_ACS_MDC_BG_FLUSH_NAME, threshold) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get metadata cache background flush threshold")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_mdc_background_flush() */
+
+#ifdef H5_HAVE_PARALLEL
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_coll_metadata_read
+ *
+ * Purpose:	Enables/disables collective metadata reads.  When enabled,
+ *              metadata cache misses during collective object opens
+ *              (H5Fopen, H5Gopen2 and H5Dopen2) are read from the file by
+ *              process 0 only and broadcast to the other processes in
+ *              the file's communicator, instead of every process reading
+ *              the same metadata.  All processes must then make those
+ *              calls collectively.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_coll_metadata_read(hid_t plist_id, hbool_t is_collective)
+{
+    H5P_genplist_t *plist;        /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ib", plist_id, is_collective);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5F_ACS_COLL_MD_READ_NAME, &is_collective) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set collective metadata read flag")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_coll_metadata_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_coll_metadata_read
+ *
+ * Purpose:	Gets whether collective metadata reads are enabled.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_coll_metadata_read(hid_t plist_id, hbool_t *is_collective)
+{
+    H5P_genplist_t *plist;        /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*b", plist_id, is_collective);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value */
+    if(is_collective) {
+        if(H5P_get(plist, H5F_ACS_COLL_MD_READ_NAME, is_collective) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get collective metadata read flag")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_coll_metadata_read() */
+#endif /* H5_HAVE_PARALLEL */
+
@@ -1384,6 +1384,50 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pset_fletcher32() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_lz4
+ *
+ * Purpose:     Adds the LZ4 compression filter to the filter pipeline of
+ *              a dataset creation or group creation property list.  LZ4
+ *              compresses less than deflate but is much faster, and
+ *              needs no external library.  Like deflate, the filter is
+ *              optional, so chunks which don't shrink are stored as-is.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_lz4(hid_t plist_id)
+{
+    H5P_genplist_t  *plist;             /* Property list */
+    H5O_pline_t     pline;              /* Filter pipeline */
+    herr_t          ret_value=SUCCEED;  /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", plist_id);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_OBJECT_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get the pipeline property to append to */
+    if(H5P_get(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get pipeline")
+
+    /* Add the filter */
+    if(H5Z_append(&pline, H5Z_FILTER_LZ4, H5Z_FLAG_OPTIONAL, (size_t)0, NULL) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to add lz4 filter to pipeline")
+
+    /* Put the I/O pipeline information back into the property list */
+    if(H5P_set(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set pipeline")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_lz4() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5P_get_filter
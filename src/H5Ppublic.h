@@ -278,6 +278,7 @@ H5_DLL htri_t H5Pall_filters_avail(hid_t plist_id);
 H5_DLL herr_t H5Premove_filter(hid_t plist_id, H5Z_filter_t filter);
 H5_DLL herr_t H5Pset_deflate(hid_t plist_id, unsigned aggression);
 H5_DLL herr_t H5Pset_fletcher32(hid_t plist_id);
+H5_DLL herr_t H5Pset_lz4(hid_t plist_id);
 
 /* File creation property list (FCPL) routines */
 H5_DLL herr_t H5Pset_userblock(hid_t plist_id, hsize_t size);
@@ -348,6 +349,12 @@ H5_DLL herr_t H5Pget_file_image_callbacks(hid_t fapl_id,
 
 H5_DLL herr_t H5Pset_core_write_tracking(hid_t fapl_id, hbool_t is_enabled, size_t page_size);
 H5_DLL herr_t H5Pget_core_write_tracking(hid_t fapl_id, hbool_t *is_enabled, size_t *page_size);
+H5_DLL herr_t H5Pset_mdc_background_flush(hid_t fapl_id, double threshold);
+H5_DLL herr_t H5Pget_mdc_background_flush(hid_t fapl_id, double *threshold);
+#ifdef H5_HAVE_PARALLEL
+H5_DLL herr_t H5Pset_coll_metadata_read(hid_t fapl_id, hbool_t is_collective);
+H5_DLL herr_t H5Pget_coll_metadata_read(hid_t fapl_id, hbool_t *is_collective);
+#endif /* H5_HAVE_PARALLEL */
 
 /* Dataset creation property list (DCPL) routines */
 H5_DLL herr_t H5Pset_layout(hid_t plist_id, H5D_layout_t layout);
@@ -412,6 +419,8 @@ H5_DLL herr_t H5Pget_vlen_mem_manager(hid_t plist_id,
                                        void **alloc_info,
                                        H5MM_free_t *free_func,
                                        void **free_info);
+H5_DLL herr_t H5Pset_vlen_mem_arena(hid_t plist_id, size_t block_size);
+H5_DLL herr_t H5Pget_vlen_mem_arena(hid_t plist_id, size_t *block_size/*out*/);
 H5_DLL herr_t H5Pset_hyper_vector_size(hid_t fapl_id, size_t size);
 H5_DLL herr_t H5Pget_hyper_vector_size(hid_t fapl_id, size_t *size/*out*/);
 H5_DLL herr_t H5Pset_type_conv_cb(hid_t dxpl_id, H5T_conv_except_func_t op, void* operate_data);
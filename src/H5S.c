@@ -154,6 +154,11 @@ H5S_term_interface(void)
 	    (void)H5I_dec_type_ref(H5I_DATASPACE);
             n++; /*H5I*/
 
+#ifdef H5_HAVE_PARALLEL
+            /* Release the cached MPI datatypes */
+            (void)H5S_mpio_cache_term();
+#endif /* H5_HAVE_PARALLEL */
+
 	    /* Shut down interface */
 	    H5_interface_initialize_g = 0;
 	} /* end else */
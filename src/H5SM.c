@@ -37,6 +37,10 @@
 /* Local Macros */
 /****************/
 
+/* Limits on the heap IDs remembered for each index */
+#define H5SM_HEAP_IDS_MAX_NENTRIES      1024    /* Most messages remembered */
+#define H5SM_HEAP_IDS_MAX_MESG_SIZE     4096    /* Largest encoded message remembered */
+
 
 /******************/
 /* Local Typedefs */
@@ -50,6 +54,17 @@ typedef struct H5SM_read_udata_t {
     void *encoding_buf;             /* The encoded message (out) */
 } H5SM_read_udata_t;
 
+/* Heap ID of a message shared in an index's fractal heap, remembered in memory
+ * so that sharing the same message again needn't read the heap to find it.
+ */
+typedef struct H5SM_heap_id_t {
+    unsigned hash;                  /* Hash value for encoded message (key) */
+    unsigned msg_type_id;           /* Message's type ID */
+    H5O_fheap_id_t fheap_id;        /* ID of the message in the fractal heap */
+    size_t encoding_size;           /* Size of the encoded message */
+    void *encoding;                 /* The encoded message */
+} H5SM_heap_id_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -78,6 +93,15 @@ static herr_t H5SM_read_mesg_fh_cb(const void *obj, size_t obj_len, void *_udata
 static herr_t H5SM_read_mesg(H5F_t *f, const H5SM_sohm_t *mesg, H5HF_t *fheap,
                H5O_t * open_oh, hid_t dxpl_id, size_t *encoding_size /*out*/,
                void ** encoded_mesg /*out*/);
+static const H5SM_heap_id_t *H5SM_heap_ids_find(const H5SM_index_header_t *header,
+    unsigned type_id, uint32_t hash, const void *encoding, size_t encoding_size);
+static herr_t H5SM_heap_ids_insert(H5SM_index_header_t *header, unsigned type_id,
+    uint32_t hash, void **encoding, size_t encoding_size,
+    const H5O_fheap_id_t *fheap_id);
+static void H5SM_heap_ids_remove(H5SM_index_header_t *header, uint32_t hash,
+    const H5O_fheap_id_t *fheap_id);
+static herr_t H5SM_heap_ids_free_cb(void *item, void *key, void *op_data);
+static void H5SM_heap_ids_reset(H5SM_index_header_t *header);
 
 
 /*********************/
@@ -89,6 +113,9 @@ H5FL_ARR_DEFINE(H5SM_index_header_t, H5O_SHMESG_MAX_NINDEXES);
 H5FL_DEFINE(H5SM_list_t);
 H5FL_ARR_DEFINE(H5SM_sohm_t, H5O_SHMESG_MAX_LIST_SIZE);
 
+/* Declare a free list to manage H5SM_heap_id_t structs */
+H5FL_DEFINE_STATIC(H5SM_heap_id_t);
+
 
 /*****************************/
 /* Library Private Variables */
@@ -201,6 +228,7 @@ H5SM_init(H5F_t *f, H5P_genplist_t * fc_plist, const H5O_loc_t *ext_loc, hid_t d
 
         /* Compute the size of a list index for this SOHM index */
         table->indexes[x].list_size = H5SM_LIST_SIZE(f, list_max);
+        table->indexes[x].heap_ids = NULL;
     } /* end for */
 
     /* Allocate space for the table on disk */
@@ -591,6 +619,9 @@ H5SM_delete_index(H5F_t *f, H5SM_index_header_t *header, hid_t dxpl_id,
 
     /* Free the index's heap if requested. */
     if(delete_heap == TRUE) {
+        /* Forget the heap IDs of messages in the heap */
+        H5SM_heap_ids_reset(header);
+
         if(H5HF_delete(f, dxpl_id, header->heap_addr) < 0)
             HGOTO_ERROR(H5E_SOHM, H5E_CANTDELETE, FAIL, "unable to delete fractal heap")
         header->heap_addr = HADDR_UNDEF;
@@ -1227,6 +1258,7 @@ H5SM_write_mesg(H5F_t *f, hid_t dxpl_id, H5O_t *open_oh,
 {
     H5SM_list_t           *list = NULL;     /* List index */
     H5SM_mesg_key_t       key;              /* Key used to search the index */
+    const H5SM_heap_id_t  *heap_id;         /* Remembered heap ID for message */
     H5SM_list_cache_ud_t cache_udata;   /* User-data for metadata cache callback */
     H5O_shared_t          shared;           /* Shared H5O message */
     hbool_t               found = FALSE;    /* Was the message in the index? */
@@ -1252,24 +1284,44 @@ H5SM_write_mesg(H5F_t *f, hid_t dxpl_id, H5O_t *open_oh,
     if(H5O_msg_encode(f, type_id, TRUE, (unsigned char *)encoding_buf, mesg) < 0)
 	HGOTO_ERROR(H5E_SOHM, H5E_CANTENCODE, FAIL, "can't encode message to be shared")
 
-    /* Open the fractal heap for this index */
-    if(NULL == (fheap = H5HF_open(f, dxpl_id, header->heap_addr)))
-	HGOTO_ERROR(H5E_SOHM, H5E_CANTOPENOBJ, FAIL, "unable to open fractal heap")
-
     /* Set up a key for the message to be written */
     key.dxpl_id = dxpl_id;
     key.file = f;
-    key.fheap = fheap;
+    key.fheap = NULL;
     key.encoding = encoding_buf;
     key.encoding_size = buf_size;
     key.message.hash = H5_checksum_lookup3(encoding_buf, buf_size, type_id);
     key.message.location = H5SM_NO_LOC;
 
+    /* Check whether the message was shared in the heap before */
+    heap_id = H5SM_heap_ids_find(header, type_id, key.message.hash, encoding_buf, buf_size);
+
+    /* Open the fractal heap for this index, unless the message is known
+     * to be in the index already and the index won't be changed.
+     */
+    if(NULL == heap_id || !defer)
+        if(NULL == (fheap = H5HF_open(f, dxpl_id, header->heap_addr)))
+            HGOTO_ERROR(H5E_SOHM, H5E_CANTOPENOBJ, FAIL, "unable to open fractal heap")
+    key.fheap = fheap;
+
+    /* Look for the message by its heap ID, which avoids reading messages
+     * with the same hash value from the heap to compare them.
+     */
+    if(heap_id && !defer) {
+        key.message.location = H5SM_IN_HEAP;
+        key.message.u.heap_loc.fheap_id = heap_id->fheap_id;
+    } /* end if */
+
     /* Assume the message is already in the index and try to increment its
      * reference count.  If this fails, the message isn't in the index after
      * all and we'll need to add it.
      */
-    if(header->index_type == H5SM_LIST) {
+    if(heap_id && defer) {
+        /* The message is in the heap; there's nothing to check */
+        shared.u.heap_id = heap_id->fheap_id;
+        found = TRUE;
+    } /* end if */
+    else if(header->index_type == H5SM_LIST) {
         size_t list_pos;        /* Position in a list index */
 
         /* Set up user data for metadata cache callback */
@@ -1356,11 +1408,24 @@ H5SM_write_mesg(H5F_t *f, hid_t dxpl_id, H5O_t *open_oh,
         } /* end else */
     } /* end else */
 
-    if(found)
+    /* A remembered heap ID should always be found, but don't trust it again if not */
+    if(heap_id && !found) {
+        H5SM_heap_ids_remove(header, key.message.hash, &heap_id->fheap_id);
+        heap_id = NULL;
+        key.message.location = H5SM_NO_LOC;
+    } /* end if */
+
+    if(found) {
         /* If the message was found, it's shared in the heap (now).  Set up a
          * shared message so we can mark it as shared.
          */
         shared.type = H5O_SHARE_TYPE_SOHM;
+
+        /* Remember the message's heap ID for sharing it again */
+        if(!defer && NULL == heap_id)
+            if(H5SM_heap_ids_insert(header, type_id, key.message.hash, &encoding_buf, buf_size, &shared.u.heap_id) < 0)
+                HGOTO_ERROR(H5E_SOHM, H5E_CANTINSERT, FAIL, "can't remember heap ID for message")
+    } /* end if */
     else {
         htri_t share_in_ohdr;           /* Whether the new message can be shared in another object's header */
 
@@ -1458,6 +1523,11 @@ H5SM_write_mesg(H5F_t *f, hid_t dxpl_id, H5O_t *open_oh,
 
             ++(header->num_messages);
             (*cache_flags_ptr) |= H5AC__DIRTIED_FLAG;
+
+            /* Remember the heap ID of a message put in the heap */
+            if(key.message.location == H5SM_IN_HEAP)
+                if(H5SM_heap_ids_insert(header, type_id, key.message.hash, &encoding_buf, buf_size, &shared.u.heap_id) < 0)
+                    HGOTO_ERROR(H5E_SOHM, H5E_CANTINSERT, FAIL, "can't remember heap ID for message")
         } /* end if */
     } /* end else */
 
@@ -1856,9 +1926,13 @@ H5SM_delete_from_index(H5F_t *f, hid_t dxpl_id, H5O_t *open_oh,
         } /* end else */
 
         /* Remove the message from the heap if it was stored in the heap*/
-        if(old_loc == H5SM_IN_HEAP)
+        if(old_loc == H5SM_IN_HEAP) {
+            /* Forget its heap ID, which may be reused */
+            H5SM_heap_ids_remove(header, key.message.hash, &(message_ptr->u.heap_loc.fheap_id));
+
             if(H5HF_remove(fheap, dxpl_id, &(message_ptr->u.heap_loc.fheap_id)) < 0)
 	        HGOTO_ERROR(H5E_SOHM, H5E_CANTREMOVE, FAIL, "unable to remove message from heap")
+        } /* end if */
 
 
         /* Return the message's encoding so anything it references can be freed */
@@ -2417,6 +2491,188 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
 } /* end H5SM_read_mesg */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5SM_heap_ids_find
+ *
+ * Purpose:	Look for a message's heap ID among those remembered for an
+ *              index.  The message is identified by its type, hash value
+ *              and encoding.
+ *
+ * Return:	Pointer to the remembered heap ID, or NULL if there isn't one
+ *
+ *-------------------------------------------------------------------------
+ */
+static const H5SM_heap_id_t *
+H5SM_heap_ids_find(const H5SM_index_header_t *header, unsigned type_id,
+    uint32_t hash, const void *encoding, size_t encoding_size)
+{
+    const H5SM_heap_id_t *heap_id;      /* Remembered heap ID */
+    unsigned key = (unsigned)hash;      /* Key for skip list */
+    const H5SM_heap_id_t *ret_value = NULL;     /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(header);
+    HDassert(encoding);
+
+    if(header->heap_ids)
+        if(NULL != (heap_id = (const H5SM_heap_id_t *)H5SL_search(header->heap_ids, &key)))
+            if(heap_id->msg_type_id == type_id && heap_id->encoding_size == encoding_size
+                    && 0 == HDmemcmp(heap_id->encoding, encoding, encoding_size))
+                ret_value = heap_id;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5SM_heap_ids_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5SM_heap_ids_insert
+ *
+ * Purpose:	Remember the heap ID of a message shared in an index's heap.
+ *              The entry takes over the encoded message in *ENCODING (and
+ *              sets *ENCODING to NULL) when it's added.
+ *
+ *              Only one message is remembered for each hash value, and
+ *              only a limited number of messages are remembered; messages
+ *              past that just aren't added.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5SM_heap_ids_insert(H5SM_index_header_t *header, unsigned type_id,
+    uint32_t hash, void **encoding, size_t encoding_size,
+    const H5O_fheap_id_t *fheap_id)
+{
+    H5SM_heap_id_t *heap_id = NULL;     /* New heap ID entry */
+    unsigned key = (unsigned)hash;      /* Key for skip list */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(header);
+    HDassert(encoding && *encoding);
+    HDassert(fheap_id);
+
+    /* Check whether the message should be remembered */
+    if(encoding_size > H5SM_HEAP_IDS_MAX_MESG_SIZE)
+        HGOTO_DONE(SUCCEED)
+    if(header->heap_ids) {
+        if(H5SL_count(header->heap_ids) >= H5SM_HEAP_IDS_MAX_NENTRIES)
+            HGOTO_DONE(SUCCEED)
+        if(NULL != H5SL_search(header->heap_ids, &key))
+            HGOTO_DONE(SUCCEED)
+    } /* end if */
+    else if(NULL == (header->heap_ids = H5SL_create(H5SL_TYPE_UNSIGNED, NULL)))
+        HGOTO_ERROR(H5E_SOHM, H5E_CANTCREATE, FAIL, "can't create skip list for heap IDs")
+
+    /* Create the entry */
+    if(NULL == (heap_id = H5FL_MALLOC(H5SM_heap_id_t)))
+        HGOTO_ERROR(H5E_SOHM, H5E_CANTALLOC, FAIL, "memory allocation failed")
+    heap_id->hash = key;
+    heap_id->msg_type_id = type_id;
+    heap_id->fheap_id = *fheap_id;
+    heap_id->encoding_size = encoding_size;
+    heap_id->encoding = *encoding;
+
+    /* Add it to the skip list */
+    if(H5SL_insert(header->heap_ids, heap_id, &heap_id->hash) < 0) {
+        heap_id = H5FL_FREE(H5SM_heap_id_t, heap_id);
+        HGOTO_ERROR(H5E_SOHM, H5E_CANTINSERT, FAIL, "can't insert heap ID into skip list")
+    } /* end if */
+
+    /* The entry owns the encoding now */
+    *encoding = NULL;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5SM_heap_ids_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5SM_heap_ids_remove
+ *
+ * Purpose:	Forget the heap ID of a message that's being removed from an
+ *              index's heap, if it's remembered.
+ *
+ * Return:	None
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5SM_heap_ids_remove(H5SM_index_header_t *header, uint32_t hash,
+    const H5O_fheap_id_t *fheap_id)
+{
+    H5SM_heap_id_t *heap_id;            /* Remembered heap ID */
+    unsigned key = (unsigned)hash;      /* Key for skip list */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(header);
+    HDassert(fheap_id);
+
+    if(header->heap_ids)
+        if(NULL != (heap_id = (H5SM_heap_id_t *)H5SL_search(header->heap_ids, &key)))
+            if(heap_id->fheap_id.val == fheap_id->val) {
+                H5SL_remove(header->heap_ids, &key);
+                H5SM_heap_ids_free_cb(heap_id, NULL, NULL);
+            } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5SM_heap_ids_remove() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5SM_heap_ids_free_cb
+ *
+ * Purpose:	Skip list callback to free a remembered heap ID.
+ *
+ * Return:	Non-negative (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5SM_heap_ids_free_cb(void *item, void UNUSED *key, void UNUSED *op_data)
+{
+    H5SM_heap_id_t *heap_id = (H5SM_heap_id_t *)item;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(heap_id);
+
+    heap_id->encoding = H5MM_xfree(heap_id->encoding);
+    heap_id = H5FL_FREE(H5SM_heap_id_t, heap_id);
+
+    FUNC_LEAVE_NOAPI(0)
+} /* end H5SM_heap_ids_free_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5SM_heap_ids_reset
+ *
+ * Purpose:	Forget all the heap IDs remembered for an index.
+ *
+ * Return:	None
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5SM_heap_ids_reset(H5SM_index_header_t *header)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(header);
+
+    if(header->heap_ids) {
+        H5SL_destroy(header->heap_ids, H5SM_heap_ids_free_cb, NULL);
+        header->heap_ids = NULL;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5SM_heap_ids_reset() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5SM_table_free
@@ -2433,12 +2689,18 @@ done:
 herr_t
 H5SM_table_free(H5SM_master_table_t *table)
 {
+    unsigned u;                         /* Local index variable */
+
     FUNC_ENTER_NOAPI_NOINIT_NOERR
 
     /* Sanity check */
     HDassert(table);
     HDassert(table->indexes);
 
+    /* Release the heap IDs remembered for each index */
+    for(u = 0; u < table->num_indexes; u++)
+        H5SM_heap_ids_reset(&(table->indexes[u]));
+
     table->indexes = H5FL_ARR_FREE(H5SM_index_header_t, table->indexes);
 
     table = H5FL_FREE(H5SM_master_table_t, table);
@@ -170,8 +170,10 @@ H5SM_table_load(H5F_t *f, hid_t dxpl_id, haddr_t addr, void UNUSED *udata)
 	HGOTO_ERROR(H5E_SOHM, H5E_CANTLOAD, NULL, "bad SOHM table signature")
     p += H5_SIZEOF_MAGIC;
 
-    /* Allocate space for the index headers in memory*/
-    if(NULL == (table->indexes = (H5SM_index_header_t *)H5FL_ARR_MALLOC(H5SM_index_header_t, (size_t)table->num_indexes)))
+    /* Allocate space for the index headers in memory (zeroed, so that the
+     * heap ID caches are NULL if decoding fails part way through)
+     */
+    if(NULL == (table->indexes = (H5SM_index_header_t *)H5FL_ARR_CALLOC(H5SM_index_header_t, (size_t)table->num_indexes)))
 	HGOTO_ERROR(H5E_SOHM, H5E_NOSPACE, NULL, "memory allocation failed for SOHM indexes")
 
     /* Read in the index headers */
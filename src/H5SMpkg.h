@@ -35,6 +35,7 @@
 #include "H5ACprivate.h"        /* Metadata Cache		  	*/
 #include "H5B2private.h"        /* B-trees                              */
 #include "H5HFprivate.h"        /* Fractal heaps		  	*/
+#include "H5SLprivate.h"        /* Skip lists				*/
 
 
 /****************************/
@@ -177,6 +178,7 @@ typedef struct {
 
 /* Not stored */
     size_t list_size;           /* Size of list index on disk */
+    H5SL_t *heap_ids;           /* Heap IDs of messages shared in the heap, by hash */
 } H5SM_index_header_t;
 
 /* Typedef for a SOHM list */
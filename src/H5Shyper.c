@@ -33,9 +33,7 @@
 /* Local datatypes */
 
 /* Static function prototypes */
-static herr_t H5S_hyper_free_span_info(H5S_hyper_span_info_t *span_info);
 static herr_t H5S_hyper_free_span(H5S_hyper_span_t *span);
-static H5S_hyper_span_info_t *H5S_hyper_copy_span(H5S_hyper_span_info_t *spans);
 static void H5S_hyper_span_scratch(H5S_hyper_span_info_t *spans, void *scr_value);
 static herr_t H5S_hyper_span_precompute(H5S_hyper_span_info_t *spans, size_t elmt_size);
 static herr_t H5S_generate_hyperslab(H5S_t *space, H5S_seloper_t op,
@@ -1371,7 +1369,7 @@ done:
  EXAMPLES
  REVISION LOG
 --------------------------------------------------------------------------*/
-static H5S_hyper_span_info_t *
+H5S_hyper_span_info_t *
 H5S_hyper_copy_span(H5S_hyper_span_info_t *spans)
 {
     H5S_hyper_span_info_t *ret_value;
@@ -1411,8 +1409,8 @@ done:
  EXAMPLES
  REVISION LOG
 --------------------------------------------------------------------------*/
-static htri_t
-H5S_hyper_cmp_spans (H5S_hyper_span_info_t *span_info1, H5S_hyper_span_info_t *span_info2)
+htri_t
+H5S_hyper_cmp_spans(H5S_hyper_span_info_t *span_info1, H5S_hyper_span_info_t *span_info2)
 {
     H5S_hyper_span_t *span1;
     H5S_hyper_span_t *span2;
@@ -1514,8 +1512,8 @@ H5S_hyper_cmp_spans (H5S_hyper_span_info_t *span_info1, H5S_hyper_span_info_t *s
  EXAMPLES
  REVISION LOG
 --------------------------------------------------------------------------*/
-static herr_t
-H5S_hyper_free_span_info (H5S_hyper_span_info_t *span_info)
+herr_t
+H5S_hyper_free_span_info(H5S_hyper_span_info_t *span_info)
 {
     H5S_hyper_span_t *span, *next_span;
     herr_t      ret_value=SUCCEED;       /* Return value */
@@ -30,6 +30,7 @@
 #include "H5Eprivate.h"		/* Error handling		  	*/
 #include "H5Fprivate.h"		/* File access				*/
 #include "H5FDprivate.h"	/* File drivers				*/
+#include "H5FLprivate.h"	/* Free Lists				*/
 #include "H5Iprivate.h"		/* IDs			  		*/
 #include "H5MMprivate.h"        /* Memory management                    */
 #include "H5Oprivate.h"		/* Object headers		  	*/
@@ -58,8 +59,43 @@ static herr_t H5S_mpio_span_hyper_type(const H5S_t *space, size_t elmt_size,
 static herr_t H5S_obtain_datatype(const hsize_t down[], H5S_hyper_span_t* span,
     const MPI_Datatype *elmt_type, MPI_Datatype *span_type, size_t elmt_size);
 
+/* MPI datatype built for a hyperslab selection, kept for reuse by later
+ * collective I/O operations on the same selection.  The selection's shape
+ * is recorded alongside the datatype, so an entry is only handed out again
+ * for a dataspace with the same extent, offset, selection and element size.
+ */
+typedef struct H5S_mpio_cache_t {
+    size_t elmt_size;                   /* Element size the datatype was built for */
+    unsigned rank;                      /* Rank of the extent */
+    hsize_t size[H5S_MAX_RANK];         /* Current size of the extent */
+    hssize_t offset[H5S_MAX_RANK];      /* Selection offset within the extent */
+    hbool_t diminfo_valid;              /* Whether the selection was regular */
+    H5S_hyper_dim_t diminfo[H5S_MAX_RANK]; /* Regular selection information */
+    H5S_hyper_span_info_t *span_lst;    /* Copy of irregular selection's span tree */
+    MPI_Datatype type;                  /* Cached MPI datatype for the selection */
+    int count;                          /* Count of 'type' objects in selection */
+    hbool_t is_derived;                 /* Whether 'type' must be freed */
+} H5S_mpio_cache_t;
+
+static htri_t H5S_mpio_cache_match(const H5S_mpio_cache_t *cache,
+    const H5S_t *space, size_t elmt_size);
+static htri_t H5S_mpio_cache_get(const H5S_t *space, size_t elmt_size,
+    MPI_Datatype *new_type, int *count, hbool_t *is_derived_type);
+static herr_t H5S_mpio_cache_put(const H5S_t *space, size_t elmt_size,
+    MPI_Datatype type, int count, hbool_t is_derived_type);
+static herr_t H5S_mpio_cache_free(H5S_mpio_cache_t *cache);
+
 #define H5S_MPIO_INITIAL_ALLOC_COUNT    256
 
+/* Number of hyperslab selections whose MPI datatypes are cached */
+#define H5S_MPIO_CACHE_NSLOTS           8
+
+/* Declare a free list to manage the H5S_mpio_cache_t struct */
+H5FL_DEFINE_STATIC(H5S_mpio_cache_t);
+
+/* Cached MPI datatypes, most recently used first */
+static H5S_mpio_cache_t *H5S_mpio_cache_g[H5S_MPIO_CACHE_NSLOTS];
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5S_mpio_all_type
@@ -1065,14 +1101,33 @@ H5S_mpio_space_type(const H5S_t *space, size_t elmt_size, MPI_Datatype *new_type
                         break;
 
                     case H5S_SEL_HYPERSLABS:
-                        if((H5S_SELECT_IS_REGULAR(space) == TRUE)) {
-                            if(H5S_mpio_hyper_type(space, elmt_size, new_type, count, is_derived_type) < 0)
-                                HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL,"couldn't convert regular 'hyperslab' selection to MPI type")
-                        } /* end if */
-                        else {
-                            if(H5S_mpio_span_hyper_type(space, elmt_size, new_type, count, is_derived_type) < 0)
-                                HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL,"couldn't convert irregular 'hyperslab' selection to MPI type")
-                        } /* end else */
+                        {
+                            htri_t cache_hit;       /* Whether a cached datatype matches the selection */
+
+                            /* Check for a datatype built for this selection by an earlier I/O operation */
+                            if((cache_hit = H5S_mpio_cache_get(space, elmt_size, new_type, count, is_derived_type)) < 0)
+                                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "couldn't get cached MPI type for selection")
+                            if(cache_hit)
+                                break;
+
+                            if((H5S_SELECT_IS_REGULAR(space) == TRUE)) {
+                                if(H5S_mpio_hyper_type(space, elmt_size, new_type, count, is_derived_type) < 0)
+                                    HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL,"couldn't convert regular 'hyperslab' selection to MPI type")
+                            } /* end if */
+                            else {
+                                if(H5S_mpio_span_hyper_type(space, elmt_size, new_type, count, is_derived_type) < 0)
+                                    HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL,"couldn't convert irregular 'hyperslab' selection to MPI type")
+                            } /* end else */
+
+                            /* Keep a copy of the new datatype for reuse */
+                            if(H5S_mpio_cache_put(space, elmt_size, *new_type, *count, *is_derived_type) < 0) {
+                                if(*is_derived_type) {
+                                    MPI_Type_free(new_type);
+                                    *is_derived_type = FALSE;
+                                } /* end if */
+                                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "couldn't cache MPI type for selection")
+                            } /* end if */
+                        }
                         break;
 
                     case H5S_SEL_ERROR:
@@ -1093,5 +1148,244 @@ H5S_mpio_space_type(const H5S_t *space, size_t elmt_size, MPI_Datatype *new_type
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5S_mpio_space_type() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5S_mpio_cache_match
+ *
+ * Purpose:	Check whether a cached MPI type was built for a dataspace's
+ *		current hyperslab selection and the given element size.
+ *
+ * Return:	TRUE/FALSE on success, negative on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5S_mpio_cache_match(const H5S_mpio_cache_t *cache, const H5S_t *space,
+    size_t elmt_size)
+{
+    const H5S_hyper_sel_t *hslab = space->select.sel_info.hslab; /* Hyperslab selection info */
+    unsigned rank = space->extent.rank;                 /* Dataspace rank */
+    htri_t ret_value = FALSE;                           /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(cache);
+    HDassert(H5S_GET_SELECT_TYPE(space) == H5S_SEL_HYPERSLABS);
+    HDassert(hslab);
+
+    /* Check the element size and the dataspace's extent & offset */
+    if(cache->elmt_size != elmt_size || cache->rank != rank)
+        HGOTO_DONE(FALSE)
+    if(rank > 0 && (HDmemcmp(cache->size, space->extent.size, rank * sizeof(hsize_t))
+            || HDmemcmp(cache->offset, space->select.offset, rank * sizeof(hssize_t))))
+        HGOTO_DONE(FALSE)
+
+    /* Check the selection itself */
+    if(cache->diminfo_valid != hslab->diminfo_valid)
+        HGOTO_DONE(FALSE)
+    if(hslab->diminfo_valid)
+        ret_value = (rank == 0 || 0 == HDmemcmp(cache->diminfo, hslab->opt_diminfo, rank * sizeof(H5S_hyper_dim_t)));
+    else if((ret_value = H5S_hyper_cmp_spans(cache->span_lst, hslab->span_lst)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOMPARE, FAIL, "can't compare hyperslab span trees")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S_mpio_cache_match() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5S_mpio_cache_get
+ *
+ * Purpose:	Look for an MPI type cached for a dataspace's current
+ *		hyperslab selection and the given element size.  On a hit,
+ *		the caller gets its own duplicate of a derived type, which
+ *		it must free as usual.
+ *
+ * Return:	TRUE/FALSE on success, negative on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5S_mpio_cache_get(const H5S_t *space, size_t elmt_size, MPI_Datatype *new_type,
+    int *count, hbool_t *is_derived_type)
+{
+    H5S_mpio_cache_t *cache = NULL;     /* Matching cached datatype info */
+    unsigned u;                         /* Local index variable */
+    int mpi_code;                       /* MPI return code */
+    htri_t ret_value = FALSE;           /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Look for a match */
+    for(u = 0; u < H5S_MPIO_CACHE_NSLOTS && H5S_mpio_cache_g[u]; u++) {
+        htri_t match;                   /* Whether the entry matches */
+
+        if((match = H5S_mpio_cache_match(H5S_mpio_cache_g[u], space, elmt_size)) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOMPARE, FAIL, "couldn't compare selection with cached MPI type")
+        if(match) {
+            cache = H5S_mpio_cache_g[u];
+            break;
+        } /* end if */
+    } /* end for */
+    if(NULL == cache)
+        HGOTO_DONE(FALSE)
+
+    /* Move the entry to the front */
+    HDmemmove(&H5S_mpio_cache_g[1], &H5S_mpio_cache_g[0], u * sizeof(H5S_mpio_cache_t *));
+    H5S_mpio_cache_g[0] = cache;
+
+    /* Hand out the datatype */
+    if(cache->is_derived) {
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_dup(cache->type, new_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_dup failed", mpi_code)
+    } /* end if */
+    else
+        *new_type = cache->type;
+    *count = cache->count;
+    *is_derived_type = cache->is_derived;
+    ret_value = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S_mpio_cache_get() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5S_mpio_cache_put
+ *
+ * Purpose:	Cache a duplicate of the MPI type built for a dataspace's
+ *		current hyperslab selection, evicting the least recently
+ *		used entry if the cache is full.  The caller keeps ownership
+ *		of the type it passed in.
+ *
+ * Return:	non-negative on success, negative on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5S_mpio_cache_put(const H5S_t *space, size_t elmt_size, MPI_Datatype type,
+    int count, hbool_t is_derived_type)
+{
+    H5S_mpio_cache_t *cache = NULL;     /* New cached datatype info */
+    const H5S_hyper_sel_t *hslab = space->select.sel_info.hslab; /* Hyperslab selection info */
+    unsigned rank = space->extent.rank; /* Dataspace rank */
+    int mpi_code;                       /* MPI return code */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(H5S_GET_SELECT_TYPE(space) == H5S_SEL_HYPERSLABS);
+    HDassert(hslab);
+
+    /* Record the selection the datatype was built for */
+    if(NULL == (cache = H5FL_CALLOC(H5S_mpio_cache_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    cache->elmt_size = elmt_size;
+    cache->rank = rank;
+    if(rank > 0) {
+        HDmemcpy(cache->size, space->extent.size, rank * sizeof(hsize_t));
+        HDmemcpy(cache->offset, space->select.offset, rank * sizeof(hssize_t));
+    } /* end if */
+    cache->diminfo_valid = hslab->diminfo_valid;
+    if(hslab->diminfo_valid)
+        HDmemcpy(cache->diminfo, hslab->opt_diminfo, rank * sizeof(H5S_hyper_dim_t));
+    else if(hslab->span_lst)
+        if(NULL == (cache->span_lst = H5S_hyper_copy_span(hslab->span_lst)))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "can't copy hyperslab span tree")
+
+    /* Keep a datatype of our own */
+    if(is_derived_type) {
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_dup(type, &cache->type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_dup failed", mpi_code)
+        cache->is_derived = TRUE;
+    } /* end if */
+    else
+        cache->type = type;
+    cache->count = count;
+
+    /* Evict the least recently used entry, then insert the new one first */
+    if(H5S_mpio_cache_g[H5S_MPIO_CACHE_NSLOTS - 1]) {
+        if(H5S_mpio_cache_free(H5S_mpio_cache_g[H5S_MPIO_CACHE_NSLOTS - 1]) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTFREE, FAIL, "can't release cached MPI type")
+        H5S_mpio_cache_g[H5S_MPIO_CACHE_NSLOTS - 1] = NULL;
+    } /* end if */
+    HDmemmove(&H5S_mpio_cache_g[1], &H5S_mpio_cache_g[0], (H5S_MPIO_CACHE_NSLOTS - 1) * sizeof(H5S_mpio_cache_t *));
+    H5S_mpio_cache_g[0] = cache;
+    cache = NULL;
+
+done:
+    /* Release the partly built entry, including its span tree copy */
+    if(cache && H5S_mpio_cache_free(cache) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTFREE, FAIL, "can't release cached MPI type")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S_mpio_cache_put() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5S_mpio_cache_free
+ *
+ * Purpose:	Release a cached MPI type and the selection recorded for it.
+ *
+ * Return:	non-negative on success, negative on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5S_mpio_cache_free(H5S_mpio_cache_t *cache)
+{
+    int mpi_code;                       /* MPI return code */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(cache);
+
+    if(cache->is_derived) {
+        int mpi_finalized;              /* Whether MPI has been shut down */
+
+        /* The library may be shut down after the application finalized MPI */
+        if(MPI_SUCCESS != (mpi_code = MPI_Finalized(&mpi_finalized)))
+            HMPI_DONE_ERROR(FAIL, "MPI_Finalized failed", mpi_code)
+        else if(!mpi_finalized && MPI_SUCCESS != (mpi_code = MPI_Type_free(&cache->type)))
+            HMPI_DONE_ERROR(FAIL, "MPI_Type_free failed", mpi_code)
+    } /* end if */
+    if(cache->span_lst && H5S_hyper_free_span_info(cache->span_lst) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTFREE, FAIL, "can't release hyperslab span tree")
+
+    cache = H5FL_FREE(H5S_mpio_cache_t, cache);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S_mpio_cache_free() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5S_mpio_cache_term
+ *
+ * Purpose:	Release all cached MPI types, when the dataspace interface
+ *		is shut down.
+ *
+ * Return:	non-negative on success, negative on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5S_mpio_cache_term(void)
+{
+    unsigned u;                         /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    for(u = 0; u < H5S_MPIO_CACHE_NSLOTS && H5S_mpio_cache_g[u]; u++) {
+        if(H5S_mpio_cache_free(H5S_mpio_cache_g[u]) < 0)
+            HDONE_ERROR(H5E_DATASPACE, H5E_CANTFREE, FAIL, "can't release cached MPI type")
+        H5S_mpio_cache_g[u] = NULL;
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S_mpio_cache_term() */
 #endif  /* H5_HAVE_PARALLEL */
 
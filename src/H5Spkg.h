@@ -250,6 +250,17 @@ H5_DLL herr_t H5S_extent_copy(H5S_extent_t *dst, const H5S_extent_t *src,
 
 /* Operations on selections */
 
+/* Operations on hyperslab span trees */
+H5_DLL H5S_hyper_span_info_t *H5S_hyper_copy_span(H5S_hyper_span_info_t *spans);
+H5_DLL htri_t H5S_hyper_cmp_spans(H5S_hyper_span_info_t *span_info1,
+    H5S_hyper_span_info_t *span_info2);
+H5_DLL herr_t H5S_hyper_free_span_info(H5S_hyper_span_info_t *span_info);
+
+#ifdef H5_HAVE_PARALLEL
+/* Cached MPI datatype functions */
+H5_DLL herr_t H5S_mpio_cache_term(void);
+#endif /* H5_HAVE_PARALLEL */
+
 /* Testing functions */
 #ifdef H5S_TESTING
 H5_DLL htri_t H5S_select_shape_same_test(hid_t sid1, hid_t sid2);
@@ -905,6 +905,10 @@ done:                                                                         \
 /* Minimum size of variable-length conversion buffer */
 #define H5T_VLEN_MIN_CONF_BUF_SIZE      4096
 
+/* Size of the sequences read from a file together during variable-length
+ * conversion (in bytes) */
+#define H5T_VLEN_READ_MULTI_BUF_SIZE    (1024 * 1024)
+
 /******************/
 /* Local Typedefs */
 /******************/
@@ -942,6 +946,15 @@ typedef struct H5T_conv_hw_t {
 /********************/
 
 static herr_t H5T_reverse_order(uint8_t *rev, uint8_t *s, size_t size, H5T_order_t order);
+static herr_t H5T_conv_vlen_write_multi(const H5T_t *src, const H5T_t *dst,
+    hid_t dxpl_id, size_t nelmts, uint8_t *s, ssize_t s_stride, uint8_t *d,
+    ssize_t d_stride, size_t dst_base_size);
+static herr_t H5T_conv_vlen_read_multi(const H5T_t *src, const H5T_t *dst,
+    H5T_path_t *tpath, hid_t tsrc_id, hid_t tdst_id,
+    const H5T_vlen_alloc_info_t *vl_alloc_info, hid_t dxpl_id, size_t nelmts,
+    uint8_t *s, ssize_t s_stride, uint8_t *d, ssize_t d_stride,
+    size_t src_base_size, size_t dst_base_size, void **tmp_buf,
+    size_t *tmp_buf_size);
 
 
 /*********************/
@@ -3016,6 +3029,228 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__conv_enum_numeric() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_conv_vlen_write_multi
+ *
+ * Purpose:	Helper for H5T__conv_vlen.  Writes NELMTS memory VL
+ *		elements starting at S to the file as disk VL elements
+ *		starting at D, when the base type needs no conversion and
+ *		there is no background data.  All the sequences are stored
+ *		with a single call to the destination type's write_multi
+ *		callback, instead of one heap insertion per element.
+ *
+ *		All the source elements are examined before any destination
+ *		element is written, as the two may overlap in the buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T_conv_vlen_write_multi(const H5T_t *src, const H5T_t *dst, hid_t dxpl_id,
+    size_t nelmts, uint8_t *s, ssize_t s_stride, uint8_t *d, ssize_t d_stride,
+    size_t dst_base_size)
+{
+    void	**vl = NULL;		/*destination elements for sequences */
+    void	**seq_buf = NULL;	/*source sequences		*/
+    size_t	*seq_len = NULL;	/*lengths of source sequences	*/
+    void	**nil = NULL;		/*destination elements for "nil" sequences */
+    size_t	nseq = 0, nnil = 0;	/*number of sequences & "nil" elements */
+    size_t	elmtno;			/*element number counter	*/
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(NULL == (vl = (void **)H5MM_malloc(nelmts * sizeof(void *))) ||
+            NULL == (seq_buf = (void **)H5MM_malloc(nelmts * sizeof(void *))) ||
+            NULL == (seq_len = (size_t *)H5MM_malloc(nelmts * sizeof(size_t))) ||
+            NULL == (nil = (void **)H5MM_malloc(nelmts * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for type conversion")
+
+    for(elmtno = 0; elmtno < nelmts; elmtno++) {
+        /* Check for "nil" source sequence */
+        if((*(src->shared->u.vlen.isnull))(src->shared->u.vlen.f, s))
+            nil[nnil++] = d;
+        else {
+            ssize_t sseq_len;   /* (signed) The number of elements in the current sequence*/
+
+            /* Get length of element sequences */
+            if((sseq_len = (*(src->shared->u.vlen.getlen))(s)) < 0)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "incorrect length")
+
+            /* Get direct pointer to sequence */
+            if(NULL == (seq_buf[nseq] = (*(src->shared->u.vlen.getptr))(s)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid source pointer")
+
+            seq_len[nseq] = (size_t)sseq_len;
+            vl[nseq++] = d;
+        } /* end else */
+
+        /* Advance pointers */
+        s += s_stride;
+        d += d_stride;
+    } /* end for */
+
+    /* Write sequences to destination locations */
+    if((*(dst->shared->u.vlen.write_multi))(dst->shared->u.vlen.f, dxpl_id, nseq, vl, seq_buf, seq_len, dst_base_size) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
+
+    /* Write "nil" sequences to destination locations */
+    for(elmtno = 0; elmtno < nnil; elmtno++)
+        if((*(dst->shared->u.vlen.setnull))(dst->shared->u.vlen.f, dxpl_id, nil[elmtno], NULL) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't set VL data to 'nil'")
+
+done:
+    H5MM_xfree(vl);
+    H5MM_xfree(seq_buf);
+    H5MM_xfree(seq_len);
+    H5MM_xfree(nil);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_conv_vlen_write_multi() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_conv_vlen_read_multi
+ *
+ * Purpose:	Helper for H5T__conv_vlen.  Converts NELMTS disk VL
+ *		elements starting at S to memory VL elements starting at
+ *		D, when there is no background data.  The sequences are
+ *		read in batches of about H5T_VLEN_READ_MULTI_BUF_SIZE
+ *		bytes, each with a single call to the source type's
+ *		read_multi callback, so that a global heap collection
+ *		holding many of the sequences is only protected once per
+ *		batch instead of once per element.
+ *
+ *		The source elements of a batch are all examined and read
+ *		before any of its destination elements is written, as the
+ *		two may overlap in the buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T_conv_vlen_read_multi(const H5T_t *src, const H5T_t *dst, H5T_path_t *tpath,
+    hid_t tsrc_id, hid_t tdst_id, const H5T_vlen_alloc_info_t *vl_alloc_info,
+    hid_t dxpl_id, size_t nelmts, uint8_t *s, ssize_t s_stride, uint8_t *d,
+    ssize_t d_stride, size_t src_base_size, size_t dst_base_size,
+    void **tmp_buf, size_t *tmp_buf_size)
+{
+    hbool_t     noop_conv = H5T_path_noop(tpath); /* Whether the base type needs conversion */
+    uint8_t	**dvl = NULL;		/*destination elements of batch	*/
+    size_t	*seq_len = NULL;	/*lengths of sequences in batch	*/
+    hbool_t	*is_nil = NULL;		/*whether elements in batch are "nil" */
+    void	**rd_vl = NULL;		/*source elements to read	*/
+    void	**rd_buf = NULL;	/*buffers to read sequences into */
+    uint8_t	*seq_buf = NULL;	/*buffer for sequences of batch	*/
+    size_t	seq_buf_size = 0;	/*size of sequence buffer in bytes */
+    size_t	elmtno;			/*element number counter	*/
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(NULL == (dvl = (uint8_t **)H5MM_malloc(nelmts * sizeof(uint8_t *))) ||
+            NULL == (seq_len = (size_t *)H5MM_malloc(nelmts * sizeof(size_t))) ||
+            NULL == (is_nil = (hbool_t *)H5MM_malloc(nelmts * sizeof(hbool_t))) ||
+            NULL == (rd_vl = (void **)H5MM_malloc(nelmts * sizeof(void *))) ||
+            NULL == (rd_buf = (void **)H5MM_malloc(nelmts * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for type conversion")
+
+    elmtno = 0;
+    while(elmtno < nelmts) {
+        size_t	nbatch = 0, nread = 0;	/*number of elements in batch & to read */
+        size_t	batch_size = 0;		/*bytes needed for sequences of batch */
+        size_t	offset;			/*offset of sequence in buffer	*/
+        size_t	u;			/*local index variable		*/
+
+        /* Gather a batch of elements */
+        while(elmtno < nelmts && batch_size < H5T_VLEN_READ_MULTI_BUF_SIZE) {
+            /* Check for "nil" source sequence */
+            if((*(src->shared->u.vlen.isnull))(src->shared->u.vlen.f, s))
+                is_nil[nbatch] = TRUE;
+            else {
+                ssize_t sseq_len;   /* (signed) The number of elements in the current sequence*/
+
+                /* Get length of element sequences */
+                if((sseq_len = (*(src->shared->u.vlen.getlen))(s)) < 0)
+                    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "incorrect length")
+
+                is_nil[nbatch] = FALSE;
+                seq_len[nbatch] = (size_t)sseq_len;
+                rd_vl[nread++] = s;
+                batch_size += (size_t)sseq_len * MAX(src_base_size, dst_base_size);
+            } /* end else */
+            dvl[nbatch++] = d;
+
+            /* Advance pointers */
+            s += s_stride;
+            d += d_stride;
+            elmtno++;
+        } /* end while */
+
+        /* Check if the sequence buffer is large enough, resize if necessary */
+        if(seq_buf_size < MAX(batch_size, 1)) {
+            seq_buf_size = MAX(batch_size, 1);
+            if(NULL == (seq_buf = (uint8_t *)H5FL_BLK_REALLOC(vlen_seq, seq_buf, seq_buf_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for type conversion")
+        } /* end if */
+
+        /* Read in the batch's VL sequences */
+        for(u = 0, nread = 0, offset = 0; u < nbatch; u++)
+            if(!is_nil[u]) {
+                rd_buf[nread++] = seq_buf + offset;
+                offset += seq_len[u] * MAX(src_base_size, dst_base_size);
+            } /* end if */
+        if((*(src->shared->u.vlen.read_multi))(src->shared->u.vlen.f, dxpl_id, nread, rd_vl, rd_buf) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "can't read VL data")
+
+        /* Convert the sequences & write them to the destination locations */
+        for(u = 0, nread = 0; u < nbatch; u++) {
+            if(is_nil[u]) {
+                /* Write "nil" sequence to destination location */
+                if((*(dst->shared->u.vlen.setnull))(dst->shared->u.vlen.f, dxpl_id, dvl[u], NULL) < 0)
+                    HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't set VL data to 'nil'")
+            } /* end if */
+            else {
+                void *conv_buf = rd_buf[nread++];       /* Sequence to convert */
+
+                if(!noop_conv) {
+                    size_t size = seq_len[u] * MAX(src_base_size, dst_base_size); /* Size of sequence buffer */
+
+                    /* Check if temporary buffer is large enough, resize if necessary */
+                    if(*tmp_buf && *tmp_buf_size < size) {
+                        *tmp_buf_size = size;
+                        if(NULL == (*tmp_buf = H5FL_BLK_REALLOC(vlen_seq, *tmp_buf, *tmp_buf_size)))
+                            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for type conversion")
+                        HDmemset(*tmp_buf, 0, *tmp_buf_size);
+                    } /* end if */
+
+                    /* Convert VL sequence */
+                    if(H5T_convert(tpath, tsrc_id, tdst_id, seq_len[u], (size_t)0, (size_t)0, conv_buf, *tmp_buf, dxpl_id) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "datatype conversion failed")
+                } /* end if */
+
+                /* Write sequence to destination location */
+                if((*(dst->shared->u.vlen.write))(dst->shared->u.vlen.f, dxpl_id, vl_alloc_info, dvl[u], conv_buf, NULL, seq_len[u], dst_base_size) < 0)
+                    HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
+            } /* end else */
+        } /* end for */
+    } /* end while */
+
+done:
+    if(seq_buf)
+        seq_buf = (uint8_t *)H5FL_BLK_FREE(vlen_seq, seq_buf);
+    H5MM_xfree(dvl);
+    H5MM_xfree(seq_len);
+    H5MM_xfree(is_nil);
+    H5MM_xfree(rd_vl);
+    H5MM_xfree(rd_buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_conv_vlen_read_multi() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5T__conv_vlen
@@ -3066,6 +3301,8 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
     H5T_path_t	*tpath = NULL;		/* Type conversion path		     */
     hbool_t     noop_conv = FALSE;      /* Flag to indicate a noop conversion */
     hbool_t     write_to_file = FALSE;  /* Flag to indicate writing to file */
+    hbool_t     write_multi = FALSE;    /* Flag to indicate writing all sequences at once */
+    hbool_t     read_multi = FALSE;     /* Flag to indicate reading sequences in batches */
     htri_t      parent_is_vlen;         /* Flag to indicate parent is vlen datatyp */
     hid_t   	tsrc_id = -1, tdst_id = -1;/*temporary type atoms	     */
     H5T_t	*src = NULL;		/*source datatype		     */
@@ -3185,6 +3422,22 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
             if(write_to_file && parent_is_vlen && bkg != NULL)
                 nested = TRUE;
 
+            /* Store the sequences in the file together, if they need no
+             * conversion and there are no old sequences to free
+             */
+            if(write_to_file && noop_conv && NULL == bkg &&
+                    H5T_LOC_MEMORY == src->shared->u.vlen.loc &&
+                    NULL != dst->shared->u.vlen.write_multi)
+                write_multi = TRUE;
+
+            /* Read the sequences from the file in batches, if there is no
+             * background data
+             */
+            if(!write_to_file && NULL == bkg &&
+                    H5T_LOC_MEMORY == dst->shared->u.vlen.loc &&
+                    NULL != src->shared->u.vlen.read_multi)
+                read_multi = TRUE;
+
             /* The outer loop of the type conversion macro, controlling which */
             /* direction the buffer is walked */
             while(nelmts > 0) {
@@ -3225,6 +3478,23 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
                     safe = nelmts;
                 } /* end else */
 
+                if(write_multi) {
+                    if(H5T_conv_vlen_write_multi(src, dst, dxpl_id, safe, s, s_stride, d, d_stride, dst_base_size) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
+
+                    /* Decrement number of elements left to convert */
+                    nelmts -= safe;
+                    continue;
+                } /* end if */
+                if(read_multi) {
+                    if(H5T_conv_vlen_read_multi(src, dst, tpath, tsrc_id, tdst_id, vl_alloc_info, dxpl_id, safe, s, s_stride, d, d_stride, src_base_size, dst_base_size, &tmp_buf, &tmp_buf_size) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "can't read VL data")
+
+                    /* Decrement number of elements left to convert */
+                    nelmts -= safe;
+                    continue;
+                } /* end if */
+
                 for(elmtno = 0; elmtno < safe; elmtno++) {
                     /* Check for "nil" source sequence */
                     if((*(src->shared->u.vlen.isnull))(src->shared->u.vlen.f, s)) {
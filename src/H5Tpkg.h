@@ -323,6 +323,8 @@ typedef htri_t (*H5T_vlen_isnullfunc_t)(const H5F_t *f, void *vl_addr);
 typedef herr_t (*H5T_vlen_readfunc_t)(H5F_t *f, hid_t dxpl_id, void *_vl, void *buf, size_t len);
 typedef herr_t (*H5T_vlen_writefunc_t)(H5F_t *f, hid_t dxpl_id, const H5T_vlen_alloc_info_t *vl_alloc_info, void *_vl, void *buf, void *_bg, size_t seq_len, size_t base_size);
 typedef herr_t (*H5T_vlen_setnullfunc_t)(H5F_t *f, hid_t dxpl_id, void *_vl, void *_bg);
+typedef herr_t (*H5T_vlen_writemultifunc_t)(H5F_t *f, hid_t dxpl_id, size_t nelmts, void *_vl[], void *buf[], const size_t seq_len[], size_t base_size);
+typedef herr_t (*H5T_vlen_readmultifunc_t)(H5F_t *f, hid_t dxpl_id, size_t nelmts, void *_vl[], void *buf[]);
 
 /* VL types */
 typedef enum {
@@ -346,6 +348,8 @@ typedef struct H5T_vlen_t {
     H5T_vlen_readfunc_t read;   /* Function to read VL sequence into buffer */
     H5T_vlen_writefunc_t write; /* Function to write VL sequence from buffer */
     H5T_vlen_setnullfunc_t setnull; /* Function to set a VL value to NIL */
+    H5T_vlen_writemultifunc_t write_multi; /* Function to write several new VL sequences at once (NULL if not supported) */
+    H5T_vlen_readmultifunc_t read_multi; /* Function to read several non-"nil" VL sequences at once (NULL if not supported) */
 } H5T_vlen_t;
 
 /* An opaque datatype */
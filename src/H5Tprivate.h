@@ -51,6 +51,9 @@ typedef struct H5T_t H5T_t;
 typedef struct H5T_stats_t H5T_stats_t;
 typedef struct H5T_path_t H5T_path_t;
 
+/* Forward reference of VL data arena (declared in H5Tvlen.c) */
+typedef struct H5T_vlen_arena_t H5T_vlen_arena_t;
+
 /* How to copy a datatype */
 typedef enum H5T_copy_t {
     H5T_COPY_TRANSIENT,
@@ -72,6 +75,7 @@ typedef struct {
     void *alloc_info;           /* Allocation information */
     H5MM_free_t free_func;      /* Free function */
     void *free_info;            /* Free information */
+    H5T_vlen_arena_t *arena;    /* Arena the VL data is allocated from (NULL if none) */
 } H5T_vlen_alloc_info_t;
 
 /* Structure for conversion callback property */
@@ -133,6 +137,11 @@ H5_DLL herr_t H5T_convert(H5T_path_t *tpath, hid_t src_id, hid_t dst_id,
 H5_DLL herr_t H5T_vlen_reclaim(void *elem, hid_t type_id, unsigned ndim, const hsize_t *point, void *_op_data);
 H5_DLL herr_t H5T_vlen_reclaim_elmt(void *elem, H5T_t *dt, hid_t dxpl_id);
 H5_DLL herr_t H5T_vlen_get_alloc_info(hid_t dxpl_id, H5T_vlen_alloc_info_t **vl_alloc_info);
+H5_DLL H5T_vlen_arena_t *H5T_vlen_arena_create(size_t block_size);
+H5_DLL herr_t H5T_vlen_arena_incr_ref(H5T_vlen_arena_t *arena);
+H5_DLL herr_t H5T_vlen_arena_close(H5T_vlen_arena_t *arena);
+H5_DLL herr_t H5T_vlen_arena_reset(H5T_vlen_arena_t *arena);
+H5_DLL size_t H5T_vlen_arena_get_block_size(const H5T_vlen_arena_t *arena);
 H5_DLL htri_t H5T_set_loc(H5T_t *dt, H5F_t *f, H5T_loc_t loc);
 H5_DLL htri_t H5T_is_sensible(const H5T_t *dt);
 H5_DLL uint32_t H5T_hash(H5F_t * file, const H5T_t *dt);
@@ -27,12 +27,33 @@
 #include "H5private.h"		/* Generic Functions			*/
 #include "H5Dprivate.h"		/* Dataset functions			*/
 #include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5FLprivate.h"	/* Free Lists                           */
 #include "H5HGprivate.h"	/* Global Heaps				*/
 #include "H5Iprivate.h"		/* IDs			  		*/
 #include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Pprivate.h"		/* Property lists			*/
 #include "H5Tpkg.h"		/* Datatypes				*/
 
+/* Round a size up to the alignment of VL data allocated from an arena */
+#define H5T_VLEN_ARENA_ALIGN(X)         (16 * (((X) + 15) / 16))
+
+/* Size of the header at the start of each block of an arena */
+#define H5T_VLEN_ARENA_BLK_HDR_SIZE     H5T_VLEN_ARENA_ALIGN(sizeof(H5T_vlen_arena_blk_t))
+
+/* A block of memory in a VL data arena */
+typedef struct H5T_vlen_arena_blk_t {
+    struct H5T_vlen_arena_blk_t *next;  /* Next block in arena */
+    size_t size;                /* Size of the block's data (in bytes) */
+    size_t used;                /* Number of bytes of data allocated */
+} H5T_vlen_arena_blk_t;
+
+/* An arena VL data is allocated from, set with H5Pset_vlen_mem_arena() */
+struct H5T_vlen_arena_t {
+    size_t rc;                  /* Reference count (# of property lists using the arena) */
+    size_t block_size;          /* Minimum size of the arena's blocks */
+    H5T_vlen_arena_blk_t *head; /* Block allocated from, heading list of all blocks */
+};
+
 /* Local functions */
 static herr_t H5T_vlen_reclaim_recurse(void *elem, const H5T_t *dt, H5MM_free_t free_func, void *free_info);
 static ssize_t H5T_vlen_seq_mem_getlen(const void *_vl);
@@ -53,6 +74,13 @@ static htri_t H5T_vlen_disk_isnull(const H5F_t *f, void *_vl);
 static herr_t H5T_vlen_disk_read(H5F_t *f, hid_t dxpl_id, void *_vl, void *_buf, size_t len);
 static herr_t H5T_vlen_disk_write(H5F_t *f, hid_t dxpl_id, const H5T_vlen_alloc_info_t *vl_alloc_info, void *_vl, void *_buf, void *_bg, size_t seq_len, size_t base_size);
 static herr_t H5T_vlen_disk_setnull(H5F_t *f, hid_t dxpl_id, void *_vl, void *_bg);
+static herr_t H5T_vlen_disk_write_multi(H5F_t *f, hid_t dxpl_id, size_t nelmts, void *_vl[], void *buf[], const size_t seq_len[], size_t base_size);
+static herr_t H5T_vlen_disk_read_multi(H5F_t *f, hid_t dxpl_id, size_t nelmts, void *_vl[], void *buf[]);
+static void *H5T_vlen_arena_alloc(size_t size, void *info);
+static void H5T_vlen_arena_free(void *mem, void *info);
+
+/* Declare a free list to manage the H5T_vlen_arena_t struct */
+H5FL_DEFINE_STATIC(H5T_vlen_arena_t);
 
 /* Local variables */
 
@@ -61,7 +89,8 @@ static H5T_vlen_alloc_info_t H5T_vlen_def_vl_alloc_info ={
     H5D_VLEN_ALLOC,
     H5D_VLEN_ALLOC_INFO,
     H5D_VLEN_FREE,
-    H5D_VLEN_FREE_INFO
+    H5D_VLEN_FREE_INFO,
+    NULL
 };
 
 
@@ -237,6 +266,8 @@ H5T__vlen_set_loc(const H5T_t *dt, H5F_t *f, H5T_loc_t loc)
                     dt->shared->u.vlen.read = H5T_vlen_seq_mem_read;
                     dt->shared->u.vlen.write = H5T_vlen_seq_mem_write;
                     dt->shared->u.vlen.setnull = H5T_vlen_seq_mem_setnull;
+                    dt->shared->u.vlen.write_multi = NULL;
+                    dt->shared->u.vlen.read_multi = NULL;
                 } else if(dt->shared->u.vlen.type == H5T_VLEN_STRING) {
                     /* size in memory, disk size is different */
                     dt->shared->size = sizeof(char *);
@@ -248,6 +279,8 @@ H5T__vlen_set_loc(const H5T_t *dt, H5F_t *f, H5T_loc_t loc)
                     dt->shared->u.vlen.read = H5T_vlen_str_mem_read;
                     dt->shared->u.vlen.write = H5T_vlen_str_mem_write;
                     dt->shared->u.vlen.setnull = H5T_vlen_str_mem_setnull;
+                    dt->shared->u.vlen.write_multi = NULL;
+                    dt->shared->u.vlen.read_multi = NULL;
                 } else {
                     HDassert(0 && "Invalid VL type");
                 }
@@ -277,6 +310,8 @@ H5T__vlen_set_loc(const H5T_t *dt, H5F_t *f, H5T_loc_t loc)
                 dt->shared->u.vlen.read = H5T_vlen_disk_read;
                 dt->shared->u.vlen.write = H5T_vlen_disk_write;
                 dt->shared->u.vlen.setnull = H5T_vlen_disk_setnull;
+                dt->shared->u.vlen.write_multi = H5T_vlen_disk_write_multi;
+                dt->shared->u.vlen.read_multi = H5T_vlen_disk_read_multi;
 
                 /* Set file ID (since this VL is on disk) */
                 dt->shared->u.vlen.f = f;
@@ -1018,6 +1053,122 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* end H5T_vlen_disk_setnull() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_disk_write_multi
+ *
+ * Purpose:	Writes several new disk based VL elements from buffers,
+ *		storing their sequences in the global heap together with
+ *		one call to H5HG_insert_multi().  There is no background
+ *		data, so no heap objects for old data are freed.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T_vlen_disk_write_multi(H5F_t *f, hid_t dxpl_id, size_t nelmts, void *_vl[],
+    void *buf[], const size_t seq_len[], size_t base_size)
+{
+    size_t *len = NULL;         /* Sizes of new sequences on disk (in bytes) */
+    H5HG_t *hobjid = NULL;      /* New VL sequences' heap IDs */
+    size_t u;                   /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* check parameters */
+    HDassert(f);
+    HDassert(0 == nelmts || (_vl && buf && seq_len));
+
+    if(0 == nelmts)
+        HGOTO_DONE(SUCCEED)
+
+    if(NULL == (len = (size_t *)H5MM_malloc(nelmts * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for sequence sizes")
+    if(NULL == (hobjid = (H5HG_t *)H5MM_malloc(nelmts * sizeof(H5HG_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for heap IDs")
+
+    for(u = 0; u < nelmts; u++)
+        len[u] = seq_len[u] * base_size;
+
+    /* Write the VL information to disk (allocates space also) */
+    if(H5HG_insert_multi(f, dxpl_id, nelmts, len, buf, hobjid) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "Unable to write VL information")
+
+    for(u = 0; u < nelmts; u++) {
+        uint8_t *vl = (uint8_t *)_vl[u]; /* Pointer to the disk VL information */
+
+        /* Set the length of the sequence */
+        UINT32ENCODE(vl, seq_len[u]);
+
+        /* Encode the heap information */
+        H5F_addr_encode(f, &vl, hobjid[u].addr);
+        UINT32ENCODE(vl, hobjid[u].idx);
+    } /* end for */
+
+done:
+    H5MM_xfree(len);
+    H5MM_xfree(hobjid);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5T_vlen_disk_write_multi() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_disk_read_multi
+ *
+ * Purpose:	Reads several disk based VL elements, none of which may be
+ *		"nil", into buffers with one call to H5HG_read_multi(), so
+ *		that each global heap collection holding some of the
+ *		sequences is only protected once.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T_vlen_disk_read_multi(H5F_t *f, hid_t dxpl_id, size_t nelmts, void *_vl[],
+    void *buf[])
+{
+    H5HG_t *hobjid = NULL;      /* VL sequences' heap IDs */
+    size_t u;                   /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* check parameters */
+    HDassert(f);
+    HDassert(0 == nelmts || (_vl && buf));
+
+    if(0 == nelmts)
+        HGOTO_DONE(SUCCEED)
+
+    if(NULL == (hobjid = (H5HG_t *)H5MM_malloc(nelmts * sizeof(H5HG_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for heap IDs")
+
+    for(u = 0; u < nelmts; u++) {
+        const uint8_t *vl = (const uint8_t *)_vl[u]; /* Pointer to the disk VL information */
+
+        /* Skip the length of the sequence */
+        vl += 4;
+
+        /* Get the heap information */
+        H5F_addr_decode(f, &vl, &(hobjid[u].addr));
+        UINT32DECODE(vl, hobjid[u].idx);
+        HDassert(hobjid[u].addr > 0);
+    } /* end for */
+
+    /* Read the VL information from disk */
+    if(H5HG_read_multi(f, dxpl_id, nelmts, hobjid, buf) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "Unable to read VL information")
+
+done:
+    H5MM_xfree(hobjid);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5T_vlen_disk_read_multi() */
+
 
 /*--------------------------------------------------------------------------
  NAME
@@ -1193,7 +1344,8 @@ done:
     SUCCEED/FAIL
  DESCRIPTION
     Retrieve the VL allocation functions and information from a dataset
-    transfer property list.
+    transfer property list.  If the property list has a VL data arena, the
+    arena's allocation functions are returned instead.
  GLOBAL VARIABLES
  COMMENTS, BUGS, ASSUMPTIONS
     The VL_ALLOC_INFO pointer should point at already allocated memory to place
@@ -1230,6 +1382,16 @@ H5T_vlen_get_alloc_info(hid_t dxpl_id, H5T_vlen_alloc_info_t **vl_alloc_info)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
         if (H5P_get(plist,H5D_XFER_VLEN_FREE_INFO_NAME,&(*vl_alloc_info)->free_info) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+        if (H5P_get(plist,H5D_XFER_VLEN_ARENA_NAME,&(*vl_alloc_info)->arena) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+        /* Allocate VL data from the arena instead, if there is one */
+        if((*vl_alloc_info)->arena) {
+            (*vl_alloc_info)->alloc_func = H5T_vlen_arena_alloc;
+            (*vl_alloc_info)->alloc_info = (*vl_alloc_info)->arena;
+            (*vl_alloc_info)->free_func = H5T_vlen_arena_free;
+            (*vl_alloc_info)->free_info = NULL;
+        } /* end if */
     } /* end else */
 
 done:
@@ -1277,3 +1439,218 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5T_vlen_reclaim_elmt */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_create
+ *
+ * Purpose:	Create an arena for VL data read into memory.  VL data is
+ *		allocated from blocks of BLOCK_SIZE bytes (or larger, for
+ *		sequences which don't fit in a block), which are all freed
+ *		together by H5T_vlen_arena_reset().
+ *
+ * Return:	Success:	Pointer to the new arena
+ *
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+H5T_vlen_arena_t *
+H5T_vlen_arena_create(size_t block_size)
+{
+    H5T_vlen_arena_t *arena = NULL;     /* New arena */
+    H5T_vlen_arena_t *ret_value;        /* Return value */
+
+    FUNC_ENTER_NOAPI(NULL)
+
+    HDassert(block_size > 0);
+
+    if(NULL == (arena = H5FL_MALLOC(H5T_vlen_arena_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for VL data arena")
+    arena->rc = 1;
+    arena->block_size = block_size;
+    arena->head = NULL;
+
+    /* Set return value */
+    ret_value = arena;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_vlen_arena_create() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_incr_ref
+ *
+ * Purpose:	Add a reference to a VL data arena, e.g. when a property
+ *		list using it is copied.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T_vlen_arena_incr_ref(H5T_vlen_arena_t *arena)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+    HDassert(arena->rc > 0);
+
+    arena->rc++;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T_vlen_arena_incr_ref() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_close
+ *
+ * Purpose:	Remove a reference to a VL data arena, freeing the arena and
+ *		all the VL data allocated from it when the last reference
+ *		goes away.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T_vlen_arena_close(H5T_vlen_arena_t *arena)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+    HDassert(arena->rc > 0);
+
+    if(--arena->rc == 0) {
+        H5T_vlen_arena_reset(arena);
+        arena = H5FL_FREE(H5T_vlen_arena_t, arena);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T_vlen_arena_close() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_reset
+ *
+ * Purpose:	Free all the VL data allocated from an arena at once.  The
+ *		cost depends only on the number of blocks in the arena, not
+ *		on the number of VL sequences allocated from them.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T_vlen_arena_reset(H5T_vlen_arena_t *arena)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+
+    while(arena->head) {
+        H5T_vlen_arena_blk_t *next = arena->head->next;
+
+        H5MM_xfree(arena->head);
+        arena->head = next;
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T_vlen_arena_reset() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_get_block_size
+ *
+ * Purpose:	Retrieve the size of the blocks of a VL data arena.
+ *
+ * Return:	Size of the blocks, in bytes (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5T_vlen_arena_get_block_size(const H5T_vlen_arena_t *arena)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+
+    FUNC_LEAVE_NOAPI(arena->block_size)
+} /* end H5T_vlen_arena_get_block_size() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_alloc
+ *
+ * Purpose:	Allocation callback for VL data read into memory using an
+ *		arena: carves SIZE bytes out of the arena's current block,
+ *		adding a new block when it is full.  A request larger than
+ *		the arena's block size gets a block of its own, placed
+ *		behind the current block so that the current block's free
+ *		space isn't lost.
+ *
+ * Return:	Success:	Pointer to the memory allocated
+ *
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5T_vlen_arena_alloc(size_t size, void *info)
+{
+    H5T_vlen_arena_t *arena = (H5T_vlen_arena_t *)info;
+    H5T_vlen_arena_blk_t *blk;          /* Block to allocate from */
+    size_t      need = H5T_VLEN_ARENA_ALIGN(size); /* Space needed in block */
+    void        *ret_value;             /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+
+    blk = arena->head;
+    if(NULL == blk || blk->size - blk->used < need) {
+        size_t blk_size = MAX(need, arena->block_size);
+
+        if(NULL == (blk = (H5T_vlen_arena_blk_t *)H5MM_malloc(H5T_VLEN_ARENA_BLK_HDR_SIZE + blk_size)))
+            HGOTO_DONE(NULL)
+        blk->size = blk_size;
+        blk->used = 0;
+
+        /* Keep the current block at the head, if it has more free space
+         * left than the new block will */
+        if(arena->head && need > arena->block_size) {
+            blk->next = arena->head->next;
+            arena->head->next = blk;
+        } /* end if */
+        else {
+            blk->next = arena->head;
+            arena->head = blk;
+        } /* end else */
+    } /* end if */
+
+    ret_value = (uint8_t *)blk + H5T_VLEN_ARENA_BLK_HDR_SIZE + blk->used;
+    blk->used += need;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_vlen_arena_alloc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_free
+ *
+ * Purpose:	Free callback for VL data allocated from an arena.  Does
+ *		nothing, the memory is released with the arena.
+ *
+ * Return:	None
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T_vlen_arena_free(void UNUSED *mem, void UNUSED *info)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T_vlen_arena_free() */
+
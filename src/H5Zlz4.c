@@ -0,0 +1,493 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	A self-contained LZ4 compression filter.
+ *
+ *		Chunks are stored in the format of the registered LZ4
+ *		filter (ID 32004), so files can be read by either filter.
+ *		A chunk starts with its uncompressed size, as an 8-byte
+ *		big-endian integer, and the size of the blocks it is split
+ *		into, as a 4-byte big-endian integer (cd_values[0] if it is
+ *		set, 1GiB otherwise, but no more than the chunk).  Each
+ *		block follows as its stored size, as a 4-byte big-endian
+ *		integer, and its data.  A block whose stored size equals
+ *		its uncompressed size is stored as-is; any other block is
+ *		in the LZ4 block format: a run of sequences, each made up
+ *		of a token, a literal run and a back-reference of at least
+ *		H5Z_LZ4_MINMATCH bytes no further than 64KiB back.
+ *
+ *		The compressor is a greedy single-pass matcher over a hash
+ *		of the next four bytes, which trades compression ratio for
+ *		speed compared to the deflate filter.  Chunks that do not
+ *		shrink are left to the pipeline to store unfiltered.
+ */
+
+#define H5Z_PACKAGE		/*suppress error about including H5Zpkg	  */
+
+
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5Fprivate.h"         /* File access                          */
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5Zpkg.h"		/* Data filters				*/
+
+#ifdef H5_HAVE_FILTER_LZ4
+
+/* Local function prototypes */
+static size_t H5Z_filter_lz4(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+static size_t H5Z_lz4_compress(const uint8_t *src, size_t src_size,
+    uint8_t *dst, size_t dst_size, uint32_t *table);
+static herr_t H5Z_lz4_decompress(const uint8_t *src, size_t src_size,
+    uint8_t *dst, size_t dst_size);
+
+/* This message derives from H5Z */
+const H5Z_class2_t H5Z_LZ4[1] = {{
+    H5Z_CLASS_T_VERS,       /* H5Z_class_t version */
+    H5Z_FILTER_LZ4,		/* Filter id number		*/
+    1,              /* encoder_present flag (set to true) */
+    1,              /* decoder_present flag (set to true) */
+    "lz4",			/* Filter name for debugging	*/
+    NULL,                       /* The "can apply" callback     */
+    NULL,                       /* The "set local" callback     */
+    H5Z_filter_lz4,		/* The actual filter function	*/
+}};
+
+/* Size of the chunk header: the uncompressed size and the block size */
+#define H5Z_LZ4_HEADER_SIZE     12
+
+/* Size of the stored size in front of each block */
+#define H5Z_LZ4_BLOCK_HEADER_SIZE 4
+
+/* Block size when cd_values[0] isn't set */
+#define H5Z_LZ4_DEFAULT_BLOCK_SIZE ((size_t)1 << 30)
+
+/* Encode and decode the big-endian integers of the chunk format */
+#define H5Z_LZ4_ENCODE_BE(P, V, N) {                                          \
+    unsigned _i;                                                              \
+                                                                              \
+    for(_i = 0; _i < (N); _i++)                                               \
+        (P)[_i] = (uint8_t)((V) >> (8 * ((N) - 1 - _i)));                     \
+    (P) += (N);                                                               \
+}
+#define H5Z_LZ4_DECODE_BE(P, V, N) {                                          \
+    unsigned _i;                                                              \
+                                                                              \
+    (V) = 0;                                                                  \
+    for(_i = 0; _i < (N); _i++)                                               \
+        (V) = ((V) << 8) | *(P)++;                                            \
+}
+
+/* Parameters of the LZ4 block format */
+#define H5Z_LZ4_MINMATCH        4       /* Shortest back-reference */
+#define H5Z_LZ4_LASTLITERALS    5       /* Bytes at the end which are always literals */
+#define H5Z_LZ4_MFLIMIT         12      /* No match starts within this many bytes of the end */
+#define H5Z_LZ4_MAX_DISTANCE    65535   /* Furthest back-reference */
+#define H5Z_LZ4_RUN_MASK        15      /* Length nibble which continues in extra bytes */
+
+/* Match finder hash table */
+#define H5Z_LZ4_HASH_LOG        14
+#define H5Z_LZ4_HASH_SIZE       ((size_t)1 << H5Z_LZ4_HASH_LOG)
+#define H5Z_LZ4_HASH(V)         (((uint32_t)((V) * 2654435761U)) >> (32 - H5Z_LZ4_HASH_LOG))
+
+/* Step further after every 2^H5Z_LZ4_SKIP_TRIGGER failed searches */
+#define H5Z_LZ4_SKIP_TRIGGER    6
+
+/* Load four bytes for hashing and comparison */
+#define H5Z_LZ4_READ32(P, V)    HDmemcpy(&(V), (P), sizeof(uint32_t))
+
+/* Write the extra bytes of a literal or match length of at least H5Z_LZ4_RUN_MASK */
+#define H5Z_LZ4_PUT_LENGTH(OP, LEN) {                                         \
+    size_t _len = (LEN) - H5Z_LZ4_RUN_MASK;                                   \
+                                                                              \
+    while(_len >= 255) {                                                      \
+        *(OP)++ = 255;                                                        \
+        _len -= 255;                                                          \
+    }                                                                         \
+    *(OP)++ = (uint8_t)_len;                                                  \
+}
+
+/* Read the extra bytes of a length, failing if they run past the end of the block */
+#define H5Z_LZ4_GET_LENGTH(IP, IEND, LEN) {                                   \
+    unsigned _b;                                                              \
+                                                                              \
+    do {                                                                      \
+        if((IP) >= (IEND))                                                    \
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "truncated lz4 block") \
+        _b = *(IP)++;                                                         \
+        (LEN) += _b;                                                          \
+    } while(_b == 255);                                                       \
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_lz4_compress
+ *
+ * Purpose:	Compress SRC_SIZE bytes from SRC into an LZ4 block in DST.
+ *              TABLE is a zeroed hash table of H5Z_LZ4_HASH_SIZE entries
+ *              which maps four-byte sequences to their last position in
+ *              SRC.
+ *
+ * Return:	Success: Number of bytes written to DST
+ *		Failure: 0, if the block does not fit in DST_SIZE bytes
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_lz4_compress(const uint8_t *src, size_t src_size, uint8_t *dst,
+    size_t dst_size, uint32_t *table)
+{
+    const uint8_t *ip = src;            /* Current input position */
+    const uint8_t *anchor = src;        /* Start of pending literals */
+    const uint8_t *iend = src + src_size; /* End of input */
+    uint8_t *op = dst;                  /* Current output position */
+    uint8_t *token;                     /* Token of the current sequence */
+    size_t lit_len;                     /* Length of the literal run */
+    size_t ret_value;                   /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(src_size > H5Z_LZ4_MFLIMIT) {
+        const uint8_t *mflimit = iend - H5Z_LZ4_MFLIMIT;
+        const uint8_t *matchlimit = iend - H5Z_LZ4_LASTLITERALS;
+        unsigned searches = 1U << H5Z_LZ4_SKIP_TRIGGER;
+        uint32_t seq;
+
+        /* The first position is only ever a match candidate */
+        H5Z_LZ4_READ32(ip, seq);
+        table[H5Z_LZ4_HASH(seq)] = 0;
+        ip++;
+
+        while(ip < mflimit) {
+            const uint8_t *ref;         /* Candidate match */
+            const uint8_t *mp, *rp;     /* Ends of the match */
+            size_t match_len;           /* Length of the match beyond the minimum */
+            size_t offset;              /* Distance back to the match */
+            uint32_t h;                 /* Hash of the sequence at IP */
+            uint32_t ref_seq;           /* Sequence at REF */
+
+            H5Z_LZ4_READ32(ip, seq);
+            h = H5Z_LZ4_HASH(seq);
+            ref = src + table[h];
+            table[h] = (uint32_t)(ip - src);
+            H5Z_LZ4_READ32(ref, ref_seq);
+            if((size_t)(ip - ref) > H5Z_LZ4_MAX_DISTANCE || ref_seq != seq) {
+                /* Move faster through data that doesn't compress */
+                ip += searches++ >> H5Z_LZ4_SKIP_TRIGGER;
+                continue;
+            } /* end if */
+            searches = 1U << H5Z_LZ4_SKIP_TRIGGER;
+
+            /* Extend the match backwards into the pending literals */
+            while(ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            } /* end while */
+
+            /* Extend the match forwards */
+            mp = ip + H5Z_LZ4_MINMATCH;
+            rp = ref + H5Z_LZ4_MINMATCH;
+            while(mp < matchlimit && *mp == *rp) {
+                mp++;
+                rp++;
+            } /* end while */
+            lit_len = (size_t)(ip - anchor);
+            match_len = (size_t)(mp - ip) - H5Z_LZ4_MINMATCH;
+            offset = (size_t)(ip - ref);
+
+            /* Make certain the whole sequence fits */
+            if((size_t)((dst + dst_size) - op) < 1 + lit_len + lit_len / 255 + 1 + 2 + match_len / 255 + 1)
+                HGOTO_DONE(0)
+
+            /* Literal run */
+            token = op++;
+            if(lit_len >= H5Z_LZ4_RUN_MASK) {
+                *token = H5Z_LZ4_RUN_MASK << 4;
+                H5Z_LZ4_PUT_LENGTH(op, lit_len)
+            } /* end if */
+            else
+                *token = (uint8_t)(lit_len << 4);
+            HDmemcpy(op, anchor, lit_len);
+            op += lit_len;
+
+            /* Back-reference */
+            *op++ = (uint8_t)(offset & 0xff);
+            *op++ = (uint8_t)(offset >> 8);
+            if(match_len >= H5Z_LZ4_RUN_MASK) {
+                *token |= H5Z_LZ4_RUN_MASK;
+                H5Z_LZ4_PUT_LENGTH(op, match_len)
+            } /* end if */
+            else
+                *token |= (uint8_t)match_len;
+
+            anchor = ip = mp;
+
+            /* Remember a position inside the match as well */
+            if(ip < mflimit) {
+                H5Z_LZ4_READ32(ip - 2, seq);
+                table[H5Z_LZ4_HASH(seq)] = (uint32_t)((ip - 2) - src);
+            } /* end if */
+        } /* end while */
+    } /* end if */
+
+    /* The block ends with the remaining literals */
+    lit_len = (size_t)(iend - anchor);
+    if((size_t)((dst + dst_size) - op) < 1 + lit_len + lit_len / 255 + 1)
+        HGOTO_DONE(0)
+    token = op++;
+    if(lit_len >= H5Z_LZ4_RUN_MASK) {
+        *token = H5Z_LZ4_RUN_MASK << 4;
+        H5Z_LZ4_PUT_LENGTH(op, lit_len)
+    } /* end if */
+    else
+        *token = (uint8_t)(lit_len << 4);
+    HDmemcpy(op, anchor, lit_len);
+    op += lit_len;
+
+    ret_value = (size_t)(op - dst);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_lz4_compress() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_lz4_decompress
+ *
+ * Purpose:	Decompress the LZ4 block of SRC_SIZE bytes in SRC into
+ *              DST, which must come out to exactly DST_SIZE bytes.  Every
+ *              length and offset is checked against the buffers, so a
+ *              corrupt block fails instead of reading or writing outside
+ *              them.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_lz4_decompress(const uint8_t *src, size_t src_size, uint8_t *dst,
+    size_t dst_size)
+{
+    const uint8_t *ip = src;            /* Current input position */
+    const uint8_t *iend = src + src_size; /* End of input */
+    uint8_t *op = dst;                  /* Current output position */
+    uint8_t *oend = dst + dst_size;     /* End of output */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    while(ip < iend) {
+        const uint8_t *ref;             /* Start of the back-reference */
+        unsigned token = *ip++;         /* Token of the sequence */
+        size_t len;                     /* Literal or match length */
+        size_t offset;                  /* Distance back to the match */
+
+        /* Literal run */
+        len = token >> 4;
+        if(len == H5Z_LZ4_RUN_MASK)
+            H5Z_LZ4_GET_LENGTH(ip, iend, len)
+        if(len > (size_t)(iend - ip) || len > (size_t)(oend - op))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "lz4 literal run out of bounds")
+        HDmemcpy(op, ip, len);
+        ip += len;
+        op += len;
+
+        /* The last sequence has no back-reference */
+        if(ip == iend)
+            break;
+
+        /* Back-reference */
+        if((size_t)(iend - ip) < 2)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "truncated lz4 block")
+        offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if(offset == 0 || offset > (size_t)(op - dst))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "lz4 match offset out of bounds")
+        len = token & H5Z_LZ4_RUN_MASK;
+        if(len == H5Z_LZ4_RUN_MASK)
+            H5Z_LZ4_GET_LENGTH(ip, iend, len)
+        len += H5Z_LZ4_MINMATCH;
+        if(len > (size_t)(oend - op))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "lz4 match out of bounds")
+
+        /* An overlapping match repeats the last OFFSET bytes, so copy it
+         * in pieces which double in size, none of which overlap */
+        ref = op - offset;
+        while(len > 0) {
+            size_t piece = MIN((size_t)(op - ref), len);
+
+            HDmemcpy(op, ref, piece);
+            op += piece;
+            len -= piece;
+        } /* end while */
+    } /* end while */
+
+    if(op != oend)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "lz4 block has wrong uncompressed size")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_lz4_decompress() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_filter_lz4
+ *
+ * Purpose:	Implement an I/O filter around the LZ4 block format
+ *
+ * Return:	Success: Size of buffer filtered
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_filter_lz4(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
+    size_t nbytes, size_t *buf_size, void **buf)
+{
+    void        *outbuf = NULL;         /* Pointer to new buffer */
+    uint32_t    *table = NULL;          /* Match finder hash table */
+    size_t      ret_value;              /* Return value */
+
+    FUNC_ENTER_NOAPI(0)
+
+    /* Sanity check */
+    HDassert(*buf_size > 0);
+    HDassert(buf);
+    HDassert(*buf);
+
+    if(flags & H5Z_FLAG_REVERSE) {
+        /* Input; uncompress */
+        const uint8_t *src = (const uint8_t *)*buf;
+        const uint8_t *src_end = src + nbytes;
+        uint64_t    orig_size;          /* Uncompressed size of the chunk */
+        uint32_t    block_size;         /* Uncompressed size of the blocks */
+        size_t      nalloc;             /* Size of the output buffer */
+        size_t      done_size;          /* Uncompressed bytes so far */
+
+        if(nbytes < H5Z_LZ4_HEADER_SIZE)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "lz4 compressed data too short")
+        H5Z_LZ4_DECODE_BE(src, orig_size, 8)
+        H5Z_LZ4_DECODE_BE(src, block_size, 4)
+        if(orig_size != (uint64_t)(size_t)orig_size)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "lz4 uncompressed size too large")
+        if(block_size == 0 && orig_size > 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "lz4 block size is zero")
+        nalloc = MAX((size_t)orig_size, 1);
+
+        if(NULL == (outbuf = H5MM_malloc(nalloc)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for lz4 uncompression")
+
+        /* Uncompress each block */
+        for(done_size = 0; done_size < (size_t)orig_size; ) {
+            size_t this_size = MIN((size_t)block_size, (size_t)orig_size - done_size);
+            uint32_t stored_size;       /* Stored size of the block */
+
+            if((size_t)(src_end - src) < H5Z_LZ4_BLOCK_HEADER_SIZE)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "truncated lz4 compressed data")
+            H5Z_LZ4_DECODE_BE(src, stored_size, 4)
+            if((size_t)stored_size > (size_t)(src_end - src))
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "truncated lz4 compressed data")
+
+            if((size_t)stored_size == this_size)
+                HDmemcpy((uint8_t *)outbuf + done_size, src, this_size);
+            else if(H5Z_lz4_decompress(src, (size_t)stored_size, (uint8_t *)outbuf + done_size, this_size) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "lz4 uncompression failed")
+            src += stored_size;
+            done_size += this_size;
+        } /* end for */
+
+        /* Free the input buffer */
+        H5MM_xfree(*buf);
+
+        /* Set return values */
+        *buf = outbuf;
+        outbuf = NULL;
+        *buf_size = nalloc;
+        ret_value = (size_t)orig_size;
+    } /* end if */
+    else {
+        /*
+         * Output; compress but fail if the result would not be smaller
+         * than the input, which the pipeline treats as a reason to store
+         * the chunk unfiltered.
+         */
+        const uint8_t *src = (const uint8_t *)*buf;
+        uint8_t     *dst;               /* Current output position */
+        uint8_t     *dst_end;           /* End of the output buffer */
+        size_t      block_size = H5Z_LZ4_DEFAULT_BLOCK_SIZE; /* Uncompressed size of the blocks */
+        size_t      done_size;          /* Bytes compressed so far */
+
+        if(cd_nelmts > 0 && cd_values[0] > 0)
+            block_size = (size_t)cd_values[0];
+        if(block_size > nbytes)
+            block_size = nbytes;
+        if(nbytes <= H5Z_LZ4_HEADER_SIZE + H5Z_LZ4_BLOCK_HEADER_SIZE)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "overflow")
+
+        /* Allocate output (compressed) buffer and the hash table */
+        if(NULL == (outbuf = H5MM_malloc(nbytes)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate lz4 destination buffer")
+        if(NULL == (table = (uint32_t *)H5MM_malloc(H5Z_LZ4_HASH_SIZE * sizeof(uint32_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate lz4 hash table")
+
+        dst = (uint8_t *)outbuf;
+        dst_end = dst + nbytes;
+        H5Z_LZ4_ENCODE_BE(dst, (uint64_t)nbytes, 8)
+        H5Z_LZ4_ENCODE_BE(dst, (uint32_t)block_size, 4)
+
+        /* Compress each block, storing blocks which don't shrink as-is */
+        for(done_size = 0; done_size < nbytes; done_size += block_size) {
+            size_t this_size = MIN(block_size, nbytes - done_size);
+            size_t stored_size;         /* Stored size of the block */
+            size_t avail;               /* Space left for the block */
+
+            if((size_t)(dst_end - dst) <= H5Z_LZ4_BLOCK_HEADER_SIZE)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "overflow")
+            avail = (size_t)(dst_end - dst) - H5Z_LZ4_BLOCK_HEADER_SIZE;
+
+            /* A compressed block must be smaller than the raw one */
+            HDmemset(table, 0, H5Z_LZ4_HASH_SIZE * sizeof(uint32_t));
+            if(0 == (stored_size = H5Z_lz4_compress(src + done_size, this_size, dst + H5Z_LZ4_BLOCK_HEADER_SIZE, MIN(avail, this_size - 1), table))) {
+                if(this_size > avail)
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "overflow")
+                HDmemcpy(dst + H5Z_LZ4_BLOCK_HEADER_SIZE, src + done_size, this_size);
+                stored_size = this_size;
+            } /* end if */
+            H5Z_LZ4_ENCODE_BE(dst, (uint32_t)stored_size, 4)
+            dst += stored_size;
+        } /* end for */
+        if(dst == dst_end)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "overflow")
+
+        /* Free the input buffer */
+        H5MM_xfree(*buf);
+
+        /* Set return values */
+        ret_value = (size_t)(dst - (uint8_t *)outbuf);
+        *buf = outbuf;
+        outbuf = NULL;
+        *buf_size = nbytes;
+    } /* end else */
+
+done:
+    if(outbuf)
+        H5MM_xfree(outbuf);
+    if(table)
+        H5MM_xfree(table);
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_filter_lz4() */
+#endif /* H5_HAVE_FILTER_LZ4 */
+
@@ -76,6 +76,12 @@ static void H5Z_nbit_compress_one_array(unsigned char *data, size_t data_offset,
          unsigned char *buffer, size_t *j, int *buf_len, const unsigned parms[]);
 static void H5Z_nbit_compress_one_compound(unsigned char *data, size_t data_offset,
             unsigned char *buffer, size_t *j, int *buf_len, const unsigned parms[]);
+static uint64_t H5Z_nbit_get_value(const unsigned char *data, parms_atomic p);
+static void H5Z_nbit_set_value(unsigned char *data, parms_atomic p, uint64_t val);
+static void H5Z_nbit_decompress_atomic_words(unsigned char *data, unsigned d_nelmts,
+                                unsigned char *buffer, parms_atomic p);
+static void H5Z_nbit_compress_atomic_words(const unsigned char *data, unsigned d_nelmts,
+                                unsigned char *buffer, size_t *j, parms_atomic p);
 static void H5Z_nbit_compress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
                               size_t *buffer_size, const unsigned parms[]);
 
@@ -1163,9 +1169,12 @@ H5Z_nbit_decompress(unsigned char *data, unsigned d_nelmts, unsigned char *buffe
            p.order = parms[5];
            p.precision = parms[6];
            p.offset = parms[7];
-           for(i = 0; i < d_nelmts; i++) {
-              H5Z_nbit_decompress_one_atomic(data, i*p.size, buffer, &j, &buf_len, p);
-           }
+           if(p.size <= sizeof(uint64_t))
+              H5Z_nbit_decompress_atomic_words(data, d_nelmts, buffer, p);
+           else
+              for(i = 0; i < d_nelmts; i++) {
+                 H5Z_nbit_decompress_one_atomic(data, i*p.size, buffer, &j, &buf_len, p);
+              }
            break;
       case H5Z_NBIT_ARRAY:
            size = parms[4];
@@ -1372,6 +1381,133 @@ static void H5Z_nbit_compress_one_compound(unsigned char *data, size_t data_offs
    }
 }
 
+/* Append the low N (at most 32) bits of VAL to the packed bits in BUFFER,
+ * most significant bit first.  ACC holds the NACC (less than 8) bits which
+ * haven't been stored in BUFFER[J] yet.
+ */
+#define H5Z_nbit_put_bits(buffer, j, acc, nacc, val, n) \
+{                                                       \
+   acc = (acc << (n)) | (val);                          \
+   nacc += (n);                                         \
+   while(nacc >= 8) {                                   \
+      nacc -= 8;                                        \
+      buffer[j++] = (unsigned char)(acc >> nacc);       \
+   }                                                    \
+}
+
+/* Remove the next N (at most 32) bits from the packed bits in BUFFER into
+ * VAL.  ACC holds the NACC bits read from BUFFER but not used yet.
+ */
+#define H5Z_nbit_get_bits(buffer, j, acc, nacc, val, n) \
+{                                                       \
+   while(nacc < (n)) {                                  \
+      acc = (acc << 8) | buffer[j++];                   \
+      nacc += 8;                                        \
+   }                                                    \
+   nacc -= (n);                                         \
+   val = (acc >> nacc) & (((uint64_t)1 << (n)) - 1);    \
+}
+
+/* read an atomic value of p.size bytes in byte order p.order */
+static uint64_t
+H5Z_nbit_get_value(const unsigned char *data, parms_atomic p)
+{
+   uint64_t val = 0;
+   size_t k;
+
+   if(p.order == H5Z_NBIT_ORDER_LE)
+      for(k = p.size; k > 0; k--)
+         val = (val << 8) | data[k - 1];
+   else
+      for(k = 0; k < p.size; k++)
+         val = (val << 8) | data[k];
+
+   return val;
+}
+
+/* store an atomic value of p.size bytes in byte order p.order */
+static void
+H5Z_nbit_set_value(unsigned char *data, parms_atomic p, uint64_t val)
+{
+   size_t k;
+
+   if(p.order == H5Z_NBIT_ORDER_LE)
+      for(k = 0; k < p.size; k++, val >>= 8)
+         data[k] = (unsigned char)val;
+   else
+      for(k = p.size; k > 0; k--, val >>= 8)
+         data[k - 1] = (unsigned char)val;
+}
+
+/* decompress a buffer of atomic values a whole value at a time, instead of
+ * byte by byte; gives the same result as H5Z_nbit_decompress_one_atomic for
+ * values up to the size of uint64_t
+ */
+static void
+H5Z_nbit_decompress_atomic_words(unsigned char *data, unsigned d_nelmts,
+                                unsigned char *buffer, parms_atomic p)
+{
+   uint64_t acc = 0;    /* bits read from the buffer, not used yet */
+   uint64_t val, lo;    /* value being decompressed */
+   unsigned nacc = 0;   /* number of bits in acc */
+   unsigned prec = (unsigned)p.precision;
+   size_t i, j = 0;     /* index of data, index of buffer */
+
+   HDassert(p.precision > 0 && p.precision + p.offset <= (int)(p.size * 8));
+   HDassert(p.size <= sizeof(uint64_t));
+
+   for(i = 0; i < d_nelmts; i++) {
+      if(prec > 32) {
+         H5Z_nbit_get_bits(buffer, j, acc, nacc, val, prec - 32)
+         H5Z_nbit_get_bits(buffer, j, acc, nacc, lo, 32)
+         val = (val << 32) | lo;
+      } /* end if */
+      else
+         H5Z_nbit_get_bits(buffer, j, acc, nacc, val, prec)
+
+      H5Z_nbit_set_value(data + i * p.size, p, val << p.offset);
+   } /* end for */
+}
+
+/* compress a buffer of atomic values a whole value at a time, instead of
+ * byte by byte; gives the same result as H5Z_nbit_compress_one_atomic for
+ * values up to the size of uint64_t.  *j is set to the index of the last
+ * byte of the buffer used, as it is by the byte at a time functions.
+ */
+static void
+H5Z_nbit_compress_atomic_words(const unsigned char *data, unsigned d_nelmts,
+                              unsigned char *buffer, size_t *j, parms_atomic p)
+{
+   uint64_t acc = 0;    /* bits not stored in the buffer yet */
+   uint64_t val;        /* value being compressed */
+   uint64_t mask;       /* mask for the precision bits of a value */
+   unsigned nacc = 0;   /* number of bits in acc */
+   unsigned prec = (unsigned)p.precision;
+   size_t i, k = 0;     /* index of data, index of buffer */
+
+   HDassert(p.precision > 0 && p.precision + p.offset <= (int)(p.size * 8));
+   HDassert(p.size <= sizeof(uint64_t));
+
+   mask = prec < 64 ? ((uint64_t)1 << prec) - 1 : ~(uint64_t)0;
+
+   for(i = 0; i < d_nelmts; i++) {
+      val = (H5Z_nbit_get_value(data + i * p.size, p) >> p.offset) & mask;
+
+      if(prec > 32) {
+         H5Z_nbit_put_bits(buffer, k, acc, nacc, val >> 32, prec - 32)
+         H5Z_nbit_put_bits(buffer, k, acc, nacc, val & 0xffffffff, 32)
+      } /* end if */
+      else
+         H5Z_nbit_put_bits(buffer, k, acc, nacc, val, prec)
+   } /* end for */
+
+   /* store the bits left over in the last (zeroed) byte */
+   if(nacc > 0)
+      buffer[k] = (unsigned char)(acc << (8 - nacc));
+
+   *j = k;
+}
+
 static void H5Z_nbit_compress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
                               size_t *buffer_size, const unsigned parms[])
 {
@@ -1396,9 +1532,12 @@ static void H5Z_nbit_compress(unsigned char *data, unsigned d_nelmts, unsigned c
            p.precision = parms[6];
            p.offset = parms[7];
 
-           for(i = 0; i < d_nelmts; i++) {
-              H5Z_nbit_compress_one_atomic(data, i*p.size, buffer, &new_size, &buf_len, p);
-           }
+           if(p.size <= sizeof(uint64_t))
+              H5Z_nbit_compress_atomic_words(data, d_nelmts, buffer, &new_size, p);
+           else
+              for(i = 0; i < d_nelmts; i++) {
+                 H5Z_nbit_compress_one_atomic(data, i*p.size, buffer, &new_size, &buf_len, p);
+              }
            break;
       case H5Z_NBIT_ARRAY:
            size = parms[4];
@@ -66,5 +66,12 @@ H5_DLLVAR H5Z_class2_t H5Z_NBIT[1];
 H5_DLLVAR H5Z_class2_t H5Z_SCALEOFFSET[1];
 #endif /* H5_HAVE_FILTER_SCALEOFFSET */
 
+#ifdef H5_HAVE_FILTER_LZ4
+/*
+ * LZ4 filter
+ */
+H5_DLLVAR const H5Z_class2_t H5Z_LZ4[1];
+#endif /* H5_HAVE_FILTER_LZ4 */
+
 #endif /* _H5Zpkg_H */
 
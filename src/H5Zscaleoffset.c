@@ -79,6 +79,14 @@ static void H5Z_scaleoffset_decompress(unsigned char *data, unsigned d_nelmts,
     unsigned char *buffer, parms_atomic p);
 static void H5Z_scaleoffset_compress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
     size_t buffer_size, parms_atomic p);
+static uint64_t H5Z_scaleoffset_get_value(const unsigned char *data,
+    size_t size, unsigned order);
+static void H5Z_scaleoffset_set_value(unsigned char *data, size_t size,
+    unsigned order, uint64_t val);
+static void H5Z_scaleoffset_decompress_words(unsigned char *data, unsigned d_nelmts,
+    const unsigned char *buffer, parms_atomic p);
+static void H5Z_scaleoffset_compress_words(const unsigned char *data, unsigned d_nelmts,
+    unsigned char *buffer, size_t buffer_size, parms_atomic p);
 
 /* This message derives from H5Z */
 H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
@@ -344,13 +352,45 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
    }                                                         \
 }
 
+/* Find maximum and minimum values of a buffer with fill value undefined for
+ * integer type, keeping four independent maximums and minimums so the
+ * comparisons don't depend on each other and can be vectorized; MAX1-MAX3
+ * and MIN1-MIN3 are scratch variables of the buffer's type
+ */
+#define H5Z_scaleoffset_max_min_i(i, d_nelmts, buf, max, min, max1, max2, max3, min1, min2, min3) \
+{                                                                  \
+   min = min1 = min2 = min3 = max = max1 = max2 = max3 = buf[0];   \
+   for(i = 0; i + 4 <= d_nelmts; i += 4) {                         \
+      if(buf[i] > max) max = buf[i];                               \
+      if(buf[i] < min) min = buf[i];                               \
+      if(buf[i + 1] > max1) max1 = buf[i + 1];                     \
+      if(buf[i + 1] < min1) min1 = buf[i + 1];                     \
+      if(buf[i + 2] > max2) max2 = buf[i + 2];                     \
+      if(buf[i + 2] < min2) min2 = buf[i + 2];                     \
+      if(buf[i + 3] > max3) max3 = buf[i + 3];                     \
+      if(buf[i + 3] < min3) min3 = buf[i + 3];                     \
+   }                                                               \
+   for(; i < d_nelmts; i++) {                                      \
+      if(buf[i] > max) max = buf[i];                               \
+      if(buf[i] < min) min = buf[i];                               \
+   }                                                               \
+   if(max1 > max) max = max1;                                      \
+   if(max2 > max) max = max2;                                      \
+   if(max3 > max) max = max3;                                      \
+   if(min1 < min) min = min1;                                      \
+   if(min2 < min) min = min2;                                      \
+   if(min3 < min) min = min3;                                      \
+}
+
 /* Find maximum and minimum values of a buffer with fill value defined for floating-point type */
 #define H5Z_scaleoffset_max_min_3(i, d_nelmts, buf, filval, max, min, D_val)      \
 {                                                                                 \
-   i = 0; while(i < d_nelmts && HDfabs(buf[i] - filval) < HDpow(10.0f, -D_val)) i++; \
+   double fill_tol = HDpow(10.0f, -D_val); /* Tolerance for fill values */        \
+                                                                                  \
+   i = 0; while(i < d_nelmts && HDfabs(buf[i] - filval) < fill_tol) i++;          \
    if(i < d_nelmts) min = max = buf[i];                                           \
    for(; i < d_nelmts; i++) {                                                     \
-      if(HDfabs(buf[i] - filval) < HDpow(10.0f, -D_val))                          \
+      if(HDfabs(buf[i] - filval) < fill_tol)                                      \
          continue; /* ignore fill value */                                        \
       if(buf[i] > max) max = buf[i];                                              \
       if(buf[i] < min) min = buf[i];                                              \
@@ -415,7 +455,8 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 /* Precompress for unsigned integer type */
 #define H5Z_scaleoffset_precompress_1(type, data, d_nelmts, filavail, cd_values, minbits, minval)\
 {                                                                                          \
-    type *buf = (type *)data, min = 0, max = 0, span, filval = 0;                          \
+    type *buf = (type *)data, min = 0, max = 0, span, filval = 0,                          \
+         max1, max2, max3, min1, min2, min3;                                               \
     unsigned i;                                                                            \
                                                                                            \
     if(filavail == H5Z_SCALEOFFSET_FILL_DEFINED) { /* fill value defined */                \
@@ -432,7 +473,7 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
                 buf[i] = (type)((buf[i] == filval) ? (((type)1 << *minbits) - 1) : (buf[i] - min)); \
     } else { /* fill value undefined */                                                    \
         if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT ) { /* minbits not set yet, calculate max, min, and minbits */ \
-            H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)                          \
+            H5Z_scaleoffset_max_min_i(i, d_nelmts, buf, max, min, max1, max2, max3, min1, min2, min3) \
             H5Z_scaleoffset_check_1(type, max, min, minbits)                               \
             span = (type)(max - min + 1);                                                  \
             *minbits = H5Z_scaleoffset_log2((unsigned long long)span);                     \
@@ -448,7 +489,8 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 /* Precompress for signed integer type */
 #define H5Z_scaleoffset_precompress_2(type, data, d_nelmts, filavail, cd_values, minbits, minval)\
 {                                                                                            \
-   type *buf = (type *)data, min = 0, max = 0, filval = 0;                                   \
+   type *buf = (type *)data, min = 0, max = 0, filval = 0,                                   \
+        max1, max2, max3, min1, min2, min3;                                                  \
    unsigned type span; unsigned i;                                                           \
                                                                                              \
    if(filavail == H5Z_SCALEOFFSET_FILL_DEFINED) { /* fill value defined */                   \
@@ -465,7 +507,7 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
             buf[i] = (type)((buf[i] == filval) ? (type)(((unsigned type)1 << *minbits) - 1) : (buf[i] - min)); \
    } else { /* fill value undefined */                                                       \
       if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT ) { /* minbits not set yet, calculate max, min, and minbits */\
-         H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)                               \
+         H5Z_scaleoffset_max_min_i(i, d_nelmts, buf, max, min, max1, max2, max3, min1, min2, min3) \
          H5Z_scaleoffset_check_2(type, max, min, minbits)                                    \
          span = (unsigned type)(max - min + 1);                                              \
          *minbits = H5Z_scaleoffset_log2((unsigned long long)span);                          \
@@ -481,29 +523,29 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 /* Modify values of data in precompression if fill value defined for floating-point type */
 #define H5Z_scaleoffset_modify_1(i, type, buf, d_nelmts, filval, minbits, min, D_val) \
 {                                                                                     \
+   double fill_tol = HDpow(10.0f, -D_val); /* Tolerance for fill values */            \
+   double scale = HDpow(10.0f, D_val);     /* Decimal scale */                        \
+                                                                                      \
    if(sizeof(type)==sizeof(int))                                                      \
       for(i = 0; i < d_nelmts; i++) {                                                 \
-         if(HDfabs(buf[i] - filval) < HDpow(10.0f, -D_val))                           \
+         if(HDfabs(buf[i] - filval) < fill_tol)                                       \
             *(int *)&buf[i] = (int)(((unsigned int)1 << *minbits) - 1);               \
          else                                                                         \
-            *(int *)&buf[i] = H5Z_scaleoffset_rnd(                                    \
-                              buf[i]*HDpow(10.0f, D_val) - min*HDpow(10.0f, D_val));  \
+            *(int *)&buf[i] = H5Z_scaleoffset_rnd(buf[i]*scale - min*scale);          \
       }                                                                               \
    else if(sizeof(type)==sizeof(long))                                                \
       for(i = 0; i < d_nelmts; i++) {                                                 \
-         if(HDfabs(buf[i] - filval) < HDpow(10.0f, -D_val))                           \
+         if(HDfabs(buf[i] - filval) < fill_tol)                                       \
             *(long *)&buf[i] = (long)(((unsigned long)1 << *minbits) - 1);            \
          else                                                                         \
-            *(long *)&buf[i] = H5Z_scaleoffset_rnd(                                   \
-                               buf[i]*HDpow(10.0f, D_val) - min*HDpow(10.0f, D_val)); \
+            *(long *)&buf[i] = H5Z_scaleoffset_rnd(buf[i]*scale - min*scale);         \
       }                                                                               \
    else if(sizeof(type)==sizeof(long long))                                           \
       for(i = 0; i < d_nelmts; i++) {                                                 \
-         if(HDfabs(buf[i] - filval) < HDpow(10.0f, -D_val))                           \
+         if(HDfabs(buf[i] - filval) < fill_tol)                                       \
             *(long long *)&buf[i] = (long long)(((unsigned long long)1 << *minbits) - 1); \
          else                                                                         \
-            *(long long *)&buf[i] = H5Z_scaleoffset_rnd(                              \
-                                    buf[i]*HDpow(10.0f, D_val) - min*HDpow(10.0f, D_val)); \
+            *(long long *)&buf[i] = H5Z_scaleoffset_rnd(buf[i]*scale - min*scale);    \
       }                                                                               \
    else                                                                               \
       HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype")\
@@ -512,18 +554,17 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 /* Modify values of data in precompression if fill value undefined for floating-point type */
 #define H5Z_scaleoffset_modify_2(i, type, buf, d_nelmts, min, D_val)                  \
 {                                                                                     \
+   double scale = HDpow(10.0f, D_val);     /* Decimal scale */                        \
+                                                                                      \
    if(sizeof(type)==sizeof(int))                                                      \
       for(i = 0; i < d_nelmts; i++)                                                   \
-         *(int *)&buf[i] = H5Z_scaleoffset_rnd(                                       \
-                           buf[i]*HDpow(10.0f, D_val) - min*HDpow(10.0f, D_val));     \
+         *(int *)&buf[i] = H5Z_scaleoffset_rnd(buf[i]*scale - min*scale);             \
    else if(sizeof(type)==sizeof(long))                                                \
       for(i = 0; i < d_nelmts; i++)                                                   \
-         *(long *)&buf[i] = H5Z_scaleoffset_rnd(                                      \
-                            buf[i]*HDpow(10.0f, D_val) - min*HDpow(10.0f, D_val));    \
+         *(long *)&buf[i] = H5Z_scaleoffset_rnd(buf[i]*scale - min*scale);            \
    else if(sizeof(type)==sizeof(long long))                                           \
       for(i = 0; i < d_nelmts; i++)                                                   \
-         *(long long *)&buf[i] = H5Z_scaleoffset_rnd(                                 \
-                                 buf[i]*HDpow(10.0f, D_val) - min*HDpow(10.0f, D_val)); \
+         *(long long *)&buf[i] = H5Z_scaleoffset_rnd(buf[i]*scale - min*scale);       \
    else                                                                               \
       HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype")\
 }
@@ -625,18 +666,20 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 /* Modify values of data in postdecompression if fill value defined for floating-point type */
 #define H5Z_scaleoffset_modify_3(i, type, buf, d_nelmts, filval, minbits, min, D_val)     \
 {                                                                                         \
+   double scale = HDpow(10.0f, D_val);     /* Decimal scale */                            \
+                                                                                          \
    if(sizeof(type)==sizeof(int))                                                          \
       for(i = 0; i < d_nelmts; i++)                                                       \
          buf[i] = (type)((*(int *)&buf[i] == (int)(((unsigned int)1 << minbits) - 1)) ?   \
-                  filval : (double)(*(int *)&buf[i]) / HDpow(10.0f, D_val) + min);        \
+                  filval : (double)(*(int *)&buf[i]) / scale + min);                      \
    else if(sizeof(type)==sizeof(long))                                                    \
       for(i = 0; i < d_nelmts; i++)                                                       \
          buf[i] = (type)((*(long *)&buf[i] == (long)(((unsigned long)1 << minbits) - 1)) ? \
-                  filval : (double)(*(long *)&buf[i]) / HDpow(10.0f, D_val) + min);       \
+                  filval : (double)(*(long *)&buf[i]) / scale + min);                     \
    else if(sizeof(type)==sizeof(long long))                                               \
       for(i = 0; i < d_nelmts; i++)                                                       \
          buf[i] = (type)((*(long long *)&buf[i] == (long long)(((unsigned long long)1 << minbits) - 1)) ? \
-                  filval : (double)(*(long long *)&buf[i]) / HDpow(10.0f, D_val) + min);  \
+                  filval : (double)(*(long long *)&buf[i]) / scale + min);                \
    else                                                                                   \
       HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype")    \
 }
@@ -644,15 +687,17 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 /* Modify values of data in postdecompression if fill value undefined for floating-point type */
 #define H5Z_scaleoffset_modify_4(i, type, buf, d_nelmts, min, D_val)                   \
 {                                                                                      \
+   double scale = HDpow(10.0f, D_val);     /* Decimal scale */                         \
+                                                                                       \
    if(sizeof(type)==sizeof(int))                                                       \
       for(i = 0; i < d_nelmts; i++)                                                    \
-         buf[i] = (type)((double)(*(int *)&buf[i]) / HDpow(10.0f, D_val) + min);       \
+         buf[i] = (type)((double)(*(int *)&buf[i]) / scale + min);                     \
    else if(sizeof(type)==sizeof(long))                                                 \
       for(i = 0; i < d_nelmts; i++)                                                    \
-         buf[i] = (type)((double)(*(long *)&buf[i]) / HDpow(10.0f, D_val) + min);      \
+         buf[i] = (type)((double)(*(long *)&buf[i]) / scale + min);                    \
    else if(sizeof(type)==sizeof(long long))                                            \
       for(i = 0; i < d_nelmts; i++)                                                    \
-         buf[i] = (type)((double)(*(long long *)&buf[i]) / HDpow(10.0f, D_val) + min); \
+         buf[i] = (type)((double)(*(long long *)&buf[i]) / scale + min);               \
    else                                                                                \
       HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype") \
 }
@@ -1190,8 +1235,12 @@ H5Z_filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_value
         }
 
         /* decompress the buffer if minbits not equal to zero */
-        if(minbits != 0)
-            H5Z_scaleoffset_decompress(outbuf, d_nelmts, (unsigned char*)(*buf)+buf_offset, p);
+        if(minbits != 0) {
+            if(p.size <= sizeof(uint64_t))
+                H5Z_scaleoffset_decompress_words(outbuf, d_nelmts, (unsigned char*)(*buf)+buf_offset, p);
+            else
+                H5Z_scaleoffset_decompress(outbuf, d_nelmts, (unsigned char*)(*buf)+buf_offset, p);
+        } /* end if */
         else {
             /* fill value is not defined and all data elements have the same value */
             for(i = 0; i < size_out; i++) outbuf[i] = 0;
@@ -1288,8 +1337,12 @@ H5Z_filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_value
          * minbits equal to zero only when fill value is not defined and
          * all data elements have the same value
          */
-        if(minbits != 0)
-            H5Z_scaleoffset_compress((unsigned char *)*buf, d_nelmts, outbuf + buf_offset, size_out - buf_offset, p);
+        if(minbits != 0) {
+            if(p.size <= sizeof(uint64_t))
+                H5Z_scaleoffset_compress_words((unsigned char *)*buf, d_nelmts, outbuf + buf_offset, size_out - buf_offset, p);
+            else
+                H5Z_scaleoffset_compress((unsigned char *)*buf, d_nelmts, outbuf + buf_offset, size_out - buf_offset, p);
+        } /* end if */
     }
 
     /* free the input buffer */
@@ -1722,5 +1775,130 @@ H5Z_scaleoffset_compress(unsigned char *data, unsigned d_nelmts,
    for(i = 0; i < d_nelmts; i++)
        H5Z_scaleoffset_compress_one_atomic(data, i * p.size, buffer, &j, &buf_len, p);
 }
+
+/* Append the low N (at most 32) bits of VAL to the packed bits in BUFFER,
+ * most significant bit first.  ACC holds the NACC (less than 8) bits which
+ * haven't been stored in BUFFER[J] yet.
+ */
+#define H5Z_scaleoffset_put_bits(buffer, j, acc, nacc, val, n)  \
+{                                                               \
+   acc = (acc << (n)) | (val);                                  \
+   nacc += (n);                                                 \
+   while(nacc >= 8) {                                           \
+      nacc -= 8;                                                \
+      buffer[j++] = (unsigned char)(acc >> nacc);               \
+   }                                                            \
+}
+
+/* Remove the next N (at most 32) bits from the packed bits in BUFFER into
+ * VAL.  ACC holds the NACC bits read from BUFFER but not used yet.
+ */
+#define H5Z_scaleoffset_get_bits(buffer, j, acc, nacc, val, n)  \
+{                                                               \
+   while(nacc < (n)) {                                          \
+      acc = (acc << 8) | buffer[j++];                           \
+      nacc += 8;                                                \
+   }                                                            \
+   nacc -= (n);                                                 \
+   val = (acc >> nacc) & (((uint64_t)1 << (n)) - 1);            \
+}
+
+/* read an atomic value of SIZE bytes in byte order ORDER */
+static uint64_t
+H5Z_scaleoffset_get_value(const unsigned char *data, size_t size, unsigned order)
+{
+   uint64_t val = 0;
+   size_t k;
+
+   if(order == H5Z_SCALEOFFSET_ORDER_LE)
+      for(k = size; k > 0; k--)
+         val = (val << 8) | data[k - 1];
+   else
+      for(k = 0; k < size; k++)
+         val = (val << 8) | data[k];
+
+   return val;
+}
+
+/* store an atomic value of SIZE bytes in byte order ORDER */
+static void
+H5Z_scaleoffset_set_value(unsigned char *data, size_t size, unsigned order,
+    uint64_t val)
+{
+   size_t k;
+
+   if(order == H5Z_SCALEOFFSET_ORDER_LE)
+      for(k = 0; k < size; k++, val >>= 8)
+         data[k] = (unsigned char)val;
+   else
+      for(k = size; k > 0; k--, val >>= 8)
+         data[k - 1] = (unsigned char)val;
+}
+
+/* decompress the packed bits a whole value at a time, instead of byte by
+ * byte; gives the same result as H5Z_scaleoffset_decompress for values up
+ * to 64 bits
+ */
+static void
+H5Z_scaleoffset_decompress_words(unsigned char *data, unsigned d_nelmts,
+    const unsigned char *buffer, parms_atomic p)
+{
+   uint64_t acc = 0;            /* bits read from the buffer, not used yet */
+   uint64_t val, lo;            /* value being decompressed */
+   unsigned nacc = 0;           /* number of bits in acc */
+   size_t i, j = 0;             /* index of data, index of buffer */
+
+   HDassert(p.minbits > 0 && p.minbits < p.size * 8);
+   HDassert(p.size <= sizeof(uint64_t));
+
+   for(i = 0; i < d_nelmts; i++) {
+      if(p.minbits > 32) {
+         H5Z_scaleoffset_get_bits(buffer, j, acc, nacc, val, p.minbits - 32)
+         H5Z_scaleoffset_get_bits(buffer, j, acc, nacc, lo, 32)
+         val = (val << 32) | lo;
+      } /* end if */
+      else
+         H5Z_scaleoffset_get_bits(buffer, j, acc, nacc, val, p.minbits)
+
+      H5Z_scaleoffset_set_value(data + i * p.size, p.size, p.mem_order, val);
+   } /* end for */
+}
+
+/* compress the values into packed bits a whole value at a time, instead of
+ * byte by byte; gives the same result as H5Z_scaleoffset_compress for
+ * values up to 64 bits
+ */
+static void
+H5Z_scaleoffset_compress_words(const unsigned char *data, unsigned d_nelmts,
+    unsigned char *buffer, size_t buffer_size, parms_atomic p)
+{
+   uint64_t acc = 0;            /* bits not stored in the buffer yet */
+   uint64_t val;                /* value being compressed */
+   uint64_t mask;               /* mask for the minbits low bits of a value */
+   unsigned nacc = 0;           /* number of bits in acc */
+   size_t i, j = 0;             /* index of data, index of buffer */
+
+   HDassert(p.minbits > 0 && p.minbits < p.size * 8);
+   HDassert(p.size <= sizeof(uint64_t));
+
+   mask = ((uint64_t)1 << p.minbits) - 1;
+
+   for(i = 0; i < d_nelmts; i++) {
+      val = H5Z_scaleoffset_get_value(data + i * p.size, p.size, p.mem_order) & mask;
+
+      if(p.minbits > 32) {
+         H5Z_scaleoffset_put_bits(buffer, j, acc, nacc, val >> 32, p.minbits - 32)
+         H5Z_scaleoffset_put_bits(buffer, j, acc, nacc, val & 0xffffffff, 32)
+      } /* end if */
+      else
+         H5Z_scaleoffset_put_bits(buffer, j, acc, nacc, val, p.minbits)
+   } /* end for */
+
+   /* store the bits left over, then zero the rest of the buffer */
+   if(nacc > 0)
+      buffer[j++] = (unsigned char)(acc << (8 - nacc));
+   HDassert(j <= buffer_size);
+   HDmemset(buffer + j, 0, buffer_size - j);
+}
 #endif /* H5_HAVE_FILTER_SCALEOFFSET */
 
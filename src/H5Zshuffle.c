@@ -26,10 +26,37 @@
 
 #ifdef H5_HAVE_FILTER_SHUFFLE
 
+/* [Un]shuffle 2, 4 & 8 byte elements with SSE2 instructions on x86
+ * processors, or AVX2 instructions when the processor running the library
+ * has them.  (Compilers which can't generate AVX2 code for single functions
+ * only get the SSE2 versions.)
+ */
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define H5Z_SHUFFLE_SSE2
+#include <emmintrin.h>
+#if (defined(__clang__) && __clang_major__ >= 4) || \
+        (!defined(__clang__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#define H5Z_SHUFFLE_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
 /* Local function prototypes */
 static herr_t H5Z_set_local_shuffle(hid_t dcpl_id, hid_t type_id, hid_t space_id);
 static size_t H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts,
     const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+#ifdef H5Z_SHUFFLE_SSE2
+static size_t H5Z_shuffle_sse2(const unsigned char *src, unsigned char *dest,
+    unsigned bytesoftype, size_t numofelements);
+static size_t H5Z_unshuffle_sse2(const unsigned char *src, unsigned char *dest,
+    unsigned bytesoftype, size_t numofelements);
+#endif /* H5Z_SHUFFLE_SSE2 */
+#ifdef H5Z_SHUFFLE_AVX2
+static size_t H5Z_shuffle_avx2(const unsigned char *src, unsigned char *dest,
+    unsigned bytesoftype, size_t numofelements) __attribute__((target("avx2")));
+static size_t H5Z_unshuffle_avx2(const unsigned char *src, unsigned char *dest,
+    unsigned bytesoftype, size_t numofelements) __attribute__((target("avx2")));
+#endif /* H5Z_SHUFFLE_AVX2 */
 
 /* This message derives from H5Z */
 const H5Z_class2_t H5Z_SHUFFLE[1] = {{
@@ -46,6 +73,12 @@ const H5Z_class2_t H5Z_SHUFFLE[1] = {{
 /* Local macros */
 #define H5Z_SHUFFLE_PARM_SIZE      0       /* "Local" parameter for shuffling size */
 
+/* Largest element size [un]shuffled with SIMD instructions */
+#define H5Z_SHUFFLE_SIMD_MAX_SIZE  8
+
+/* Whether elements of a given size are [un]shuffled with SIMD instructions */
+#define H5Z_SHUFFLE_SIMD_SIZE(S)   ((S) == 2 || (S) == 4 || (S) == 8)
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Z_set_local_shuffle
@@ -132,6 +165,8 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
     unsigned char *_dest=NULL;  /* Alias for destination buffer */
     unsigned bytesoftype;       /* Number of bytes per element */
     size_t numofelements;       /* Number of elements in buffer */
+    size_t done = 0;            /* Number of elements [un]shuffled with SIMD instructions */
+    size_t count;               /* Number of elements left to [un]shuffle */
     size_t i;                   /* Local index variables */
 #ifdef NO_DUFFS_DEVICE
     size_t j;                   /* Local index variable */
@@ -161,17 +196,28 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for shuffle buffer")
 
         if(flags & H5Z_FLAG_REVERSE) {
-            /* Get the pointer to the source buffer */
-            _src =(unsigned char *)(*buf);
-
-            /* Input; unshuffle */
-            for(i=0; i<bytesoftype; i++) {
-                _dest=((unsigned char *)dest)+i;
+#ifdef H5Z_SHUFFLE_SSE2
+            /* Unshuffle as many elements as possible with SIMD instructions */
+            if(H5Z_SHUFFLE_SIMD_SIZE(bytesoftype)) {
+#ifdef H5Z_SHUFFLE_AVX2
+                if(__builtin_cpu_supports("avx2"))
+                    done = H5Z_unshuffle_avx2((const unsigned char *)*buf, (unsigned char *)dest, bytesoftype, numofelements);
+                else
+#endif /* H5Z_SHUFFLE_AVX2 */
+                    done = H5Z_unshuffle_sse2((const unsigned char *)*buf, (unsigned char *)dest, bytesoftype, numofelements);
+            } /* end if */
+#endif /* H5Z_SHUFFLE_SSE2 */
+            count = numofelements - done;
+
+            /* Input; unshuffle the rest of the elements */
+            for(i=0; i<bytesoftype && count>0; i++) {
+                _src=((unsigned char *)(*buf))+i*numofelements+done;
+                _dest=((unsigned char *)dest)+done*bytesoftype+i;
 #define DUFF_GUTS							    \
     *_dest=*_src++;                             \
     _dest+=bytesoftype;
 #ifdef NO_DUFFS_DEVICE
-                j = numofelements;
+                j = count;
                 while(j > 0) {
                     DUFF_GUTS;
 
@@ -181,8 +227,8 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
             {
                 size_t duffs_index; /* Counting index for Duff's device */
 
-                duffs_index = (numofelements + 7) / 8;
-                switch (numofelements % 8) {
+                duffs_index = (count + 7) / 8;
+                switch (count % 8) {
                     default:
                         HDassert(0 && "This Should never be executed!");
                         break;
@@ -210,26 +256,30 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
 #endif /* NO_DUFFS_DEVICE */
 #undef DUFF_GUTS
             } /* end for */
-
-            /* Add leftover to the end of data */
-            if(leftover>0) {
-                /* Adjust back to end of shuffled bytes */
-                _dest -= (bytesoftype - 1);     /*lint !e794 _dest is initialized */
-                HDmemcpy((void*)_dest, (void*)_src, leftover);
-            }
         } /* end if */
         else {
-            /* Get the pointer to the destination buffer */
-            _dest =(unsigned char *)dest;
-
-            /* Output; shuffle */
-            for(i=0; i<bytesoftype; i++) {
-                _src=((unsigned char *)(*buf))+i;
+#ifdef H5Z_SHUFFLE_SSE2
+            /* Shuffle as many elements as possible with SIMD instructions */
+            if(H5Z_SHUFFLE_SIMD_SIZE(bytesoftype)) {
+#ifdef H5Z_SHUFFLE_AVX2
+                if(__builtin_cpu_supports("avx2"))
+                    done = H5Z_shuffle_avx2((const unsigned char *)*buf, (unsigned char *)dest, bytesoftype, numofelements);
+                else
+#endif /* H5Z_SHUFFLE_AVX2 */
+                    done = H5Z_shuffle_sse2((const unsigned char *)*buf, (unsigned char *)dest, bytesoftype, numofelements);
+            } /* end if */
+#endif /* H5Z_SHUFFLE_SSE2 */
+            count = numofelements - done;
+
+            /* Output; shuffle the rest of the elements */
+            for(i=0; i<bytesoftype && count>0; i++) {
+                _src=((unsigned char *)(*buf))+done*bytesoftype+i;
+                _dest=((unsigned char *)dest)+i*numofelements+done;
 #define DUFF_GUTS							    \
     *_dest++=*_src;                             \
     _src+=bytesoftype;
 #ifdef NO_DUFFS_DEVICE
-                j = numofelements;
+                j = count;
                 while(j > 0) {
                     DUFF_GUTS;
 
@@ -239,8 +289,8 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
             {
                 size_t duffs_index; /* Counting index for Duff's device */
 
-                duffs_index = (numofelements + 7) / 8;
-                switch (numofelements % 8) {
+                duffs_index = (count + 7) / 8;
+                switch (count % 8) {
                     default:
                         HDassert(0 && "This Should never be executed!");
                         break;
@@ -268,15 +318,12 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
 #endif /* NO_DUFFS_DEVICE */
 #undef DUFF_GUTS
             } /* end for */
-
-            /* Add leftover to the end of data */
-            if(leftover>0) {
-                /* Adjust back to end of shuffled bytes */
-                _src -= (bytesoftype - 1);      /*lint !e794 _src is initialized */
-                HDmemcpy((void*)_dest, (void*)_src, leftover);
-            }
         } /* end else */
 
+        /* Add leftover to the end of data */
+        if(leftover>0)
+            HDmemcpy((unsigned char *)dest + (nbytes - leftover), (unsigned char *)(*buf) + (nbytes - leftover), leftover);
+
         /* Free the input buffer */
         H5MM_xfree(*buf);
 
@@ -291,5 +338,212 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 }
+
+#ifdef H5Z_SHUFFLE_SSE2
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_shuffle_sse2
+ *
+ * Purpose:	Shuffle blocks of 16 2, 4 or 8-byte elements with SSE2
+ *              instructions, by repeatedly splitting the even & odd bytes
+ *              of the block apart.  The result is identical to the
+ *              scalar shuffle in H5Z_filter_shuffle.
+ *
+ * Return:	Number of elements shuffled (a multiple of 16)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_shuffle_sse2(const unsigned char *src, unsigned char *dest,
+    unsigned bytesoftype, size_t numofelements)
+{
+    const __m128i mask = _mm_set1_epi16(0x00ff);   /* Mask for even bytes */
+    __m128i v[H5Z_SHUFFLE_SIMD_MAX_SIZE];   /* Block being shuffled */
+    __m128i t[H5Z_SHUFFLE_SIMD_MAX_SIZE];   /* Result of each round */
+    size_t nblocks = numofelements / 16;    /* Number of blocks to shuffle */
+    unsigned half = bytesoftype / 2;        /* Half the element size */
+    unsigned n, u;                          /* Local index variables */
+    size_t b;                               /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(H5Z_SHUFFLE_SIMD_SIZE(bytesoftype));
+
+    for(b = 0; b < nblocks; b++) {
+        for(u = 0; u < bytesoftype; u++)
+            v[u] = _mm_loadu_si128((const __m128i *)(src + (b * bytesoftype + u) * 16));
+
+        /* Split the even & odd bytes apart, log2(bytesoftype) times */
+        for(n = 1; n < bytesoftype; n *= 2) {
+            for(u = 0; u < half; u++) {
+                t[u] = _mm_packus_epi16(_mm_and_si128(v[2 * u], mask), _mm_and_si128(v[2 * u + 1], mask));
+                t[half + u] = _mm_packus_epi16(_mm_srli_epi16(v[2 * u], 8), _mm_srli_epi16(v[2 * u + 1], 8));
+            } /* end for */
+            for(u = 0; u < bytesoftype; u++)
+                v[u] = t[u];
+        } /* end for */
+
+        for(u = 0; u < bytesoftype; u++)
+            _mm_storeu_si128((__m128i *)(dest + u * numofelements + b * 16), v[u]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nblocks * 16)
+} /* end H5Z_shuffle_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_unshuffle_sse2
+ *
+ * Purpose:	Unshuffle blocks of 16 2, 4 or 8-byte elements with SSE2
+ *              instructions, by repeatedly interleaving the bytes of
+ *              pairs of byte planes.  The inverse of H5Z_shuffle_sse2.
+ *
+ * Return:	Number of elements unshuffled (a multiple of 16)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_unshuffle_sse2(const unsigned char *src, unsigned char *dest,
+    unsigned bytesoftype, size_t numofelements)
+{
+    __m128i v[H5Z_SHUFFLE_SIMD_MAX_SIZE];   /* Block being unshuffled */
+    __m128i t[H5Z_SHUFFLE_SIMD_MAX_SIZE];   /* Result of each round */
+    size_t nblocks = numofelements / 16;    /* Number of blocks to unshuffle */
+    unsigned half = bytesoftype / 2;        /* Half the element size */
+    unsigned n, u;                          /* Local index variables */
+    size_t b;                               /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(H5Z_SHUFFLE_SIMD_SIZE(bytesoftype));
+
+    for(b = 0; b < nblocks; b++) {
+        for(u = 0; u < bytesoftype; u++)
+            v[u] = _mm_loadu_si128((const __m128i *)(src + u * numofelements + b * 16));
+
+        /* Interleave the bytes of pairs of planes, log2(bytesoftype) times */
+        for(n = 1; n < bytesoftype; n *= 2) {
+            for(u = 0; u < half; u++) {
+                t[2 * u] = _mm_unpacklo_epi8(v[u], v[half + u]);
+                t[2 * u + 1] = _mm_unpackhi_epi8(v[u], v[half + u]);
+            } /* end for */
+            for(u = 0; u < bytesoftype; u++)
+                v[u] = t[u];
+        } /* end for */
+
+        for(u = 0; u < bytesoftype; u++)
+            _mm_storeu_si128((__m128i *)(dest + (b * bytesoftype + u) * 16), v[u]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nblocks * 16)
+} /* end H5Z_unshuffle_sse2() */
+#endif /* H5Z_SHUFFLE_SSE2 */
+
+#ifdef H5Z_SHUFFLE_AVX2
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_shuffle_avx2
+ *
+ * Purpose:	Shuffle blocks of 32 2, 4 or 8-byte elements with AVX2
+ *              instructions.  The same as H5Z_shuffle_sse2, except the
+ *              64-bit quarters of each packed vector must be put back in
+ *              order, since AVX2 packs each 128-bit lane separately.
+ *
+ * Return:	Number of elements shuffled (a multiple of 32)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_shuffle_avx2(const unsigned char *src, unsigned char *dest,
+    unsigned bytesoftype, size_t numofelements)
+{
+    const __m256i mask = _mm256_set1_epi16(0x00ff);    /* Mask for even bytes */
+    __m256i v[H5Z_SHUFFLE_SIMD_MAX_SIZE];   /* Block being shuffled */
+    __m256i t[H5Z_SHUFFLE_SIMD_MAX_SIZE];   /* Result of each round */
+    size_t nblocks = numofelements / 32;    /* Number of blocks to shuffle */
+    unsigned half = bytesoftype / 2;        /* Half the element size */
+    unsigned n, u;                          /* Local index variables */
+    size_t b;                               /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(H5Z_SHUFFLE_SIMD_SIZE(bytesoftype));
+
+    for(b = 0; b < nblocks; b++) {
+        for(u = 0; u < bytesoftype; u++)
+            v[u] = _mm256_loadu_si256((const __m256i *)(src + (b * bytesoftype + u) * 32));
+
+        /* Split the even & odd bytes apart, log2(bytesoftype) times */
+        for(n = 1; n < bytesoftype; n *= 2) {
+            for(u = 0; u < half; u++) {
+                t[u] = _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_and_si256(v[2 * u], mask), _mm256_and_si256(v[2 * u + 1], mask)), 0xD8);
+                t[half + u] = _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_srli_epi16(v[2 * u], 8), _mm256_srli_epi16(v[2 * u + 1], 8)), 0xD8);
+            } /* end for */
+            for(u = 0; u < bytesoftype; u++)
+                v[u] = t[u];
+        } /* end for */
+
+        for(u = 0; u < bytesoftype; u++)
+            _mm256_storeu_si256((__m256i *)(dest + u * numofelements + b * 32), v[u]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nblocks * 32)
+} /* end H5Z_shuffle_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_unshuffle_avx2
+ *
+ * Purpose:	Unshuffle blocks of 32 2, 4 or 8-byte elements with AVX2
+ *              instructions.  The inverse of H5Z_shuffle_avx2.
+ *
+ * Return:	Number of elements unshuffled (a multiple of 32)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_unshuffle_avx2(const unsigned char *src, unsigned char *dest,
+    unsigned bytesoftype, size_t numofelements)
+{
+    __m256i v[H5Z_SHUFFLE_SIMD_MAX_SIZE];   /* Block being unshuffled */
+    __m256i t[H5Z_SHUFFLE_SIMD_MAX_SIZE];   /* Result of each round */
+    size_t nblocks = numofelements / 32;    /* Number of blocks to unshuffle */
+    unsigned half = bytesoftype / 2;        /* Half the element size */
+    unsigned n, u;                          /* Local index variables */
+    size_t b;                               /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(H5Z_SHUFFLE_SIMD_SIZE(bytesoftype));
+
+    for(b = 0; b < nblocks; b++) {
+        for(u = 0; u < bytesoftype; u++)
+            v[u] = _mm256_loadu_si256((const __m256i *)(src + u * numofelements + b * 32));
+
+        /* Interleave the bytes of pairs of planes, log2(bytesoftype) times.
+         * (AVX2 interleaves each 128-bit lane separately, so the 64-bit
+         * quarters of the planes are reordered first.)
+         */
+        for(n = 1; n < bytesoftype; n *= 2) {
+            for(u = 0; u < half; u++) {
+                __m256i lo = _mm256_permute4x64_epi64(v[u], 0xD8);
+                __m256i hi = _mm256_permute4x64_epi64(v[half + u], 0xD8);
+
+                t[2 * u] = _mm256_unpacklo_epi8(lo, hi);
+                t[2 * u + 1] = _mm256_unpackhi_epi8(lo, hi);
+            } /* end for */
+            for(u = 0; u < bytesoftype; u++)
+                v[u] = t[u];
+        } /* end for */
+
+        for(u = 0; u < bytesoftype; u++)
+            _mm256_storeu_si256((__m256i *)(dest + (b * bytesoftype + u) * 32), v[u]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nblocks * 32)
+} /* end H5Z_unshuffle_avx2() */
+#endif /* H5Z_SHUFFLE_AVX2 */
 #endif /*H5_HAVE_FILTER_SHUFFLE */
 
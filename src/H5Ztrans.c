@@ -60,17 +60,39 @@ typedef struct H5Z_node {
     H5Z_num_val         value;
 } H5Z_node;
 
+/* Kinds of operands in a compiled transform */
+typedef enum {
+    H5Z_XFORM_ARG_DATA,         /* The data being transformed */
+    H5Z_XFORM_ARG_CONST,        /* A number from the expression */
+    H5Z_XFORM_ARG_TEMP          /* The result of an earlier instruction */
+} H5Z_xform_arg_type_t;
+
+/* An operand of an instruction */
+typedef struct {
+    H5Z_xform_arg_type_t type;  /* Kind of operand */
+    unsigned    temp;           /* Temporary result, for H5Z_XFORM_ARG_TEMP */
+    double      value;          /* Number, for H5Z_XFORM_ARG_CONST */
+} H5Z_xform_arg_t;
+
+/* An instruction of a compiled transform: the operator at one node of
+ * the parse tree, applied to a block of elements */
+typedef struct {
+    H5Z_token_type      op;     /* H5Z_XFORM_PLUS, _MINUS, _MULT or _DIVIDE */
+    H5Z_xform_arg_t     left;   /* Left operand */
+    H5Z_xform_arg_t     right;  /* Right operand */
+    unsigned            dst;    /* Temporary result to store into */
+} H5Z_xform_inst_t;
+
 struct H5Z_data_xform_t {
     char*       xform_exp;
     H5Z_node*       parse_root;
     H5Z_datval_ptrs*	dat_val_pointers;
+    H5Z_xform_inst_t   *insts;  /* Parse tree compiled in postfix order */
+    size_t      ninsts;         /* Number of instructions */
+    size_t      ninsts_alloc;   /* Number of instructions allocated */
+    unsigned    ntemps;         /* Number of temporary results used */
 };
 
-typedef struct result {
-    H5Z_token_type type;
-    H5Z_num_val    value;
-} H5Z_result;
-
 
 /* The token */
 typedef struct {
@@ -97,7 +119,8 @@ static void H5Z_do_op(H5Z_node* tree);
 static hbool_t H5Z_op_is_numbs(H5Z_node* _tree);
 static hbool_t H5Z_op_is_numbs2(H5Z_node* _tree);
 static hid_t H5Z_xform_find_type(const H5T_t* type);
-static herr_t H5Z_xform_eval_full(H5Z_node *tree, const size_t array_size, const hid_t array_type, H5Z_result* res);
+static herr_t H5Z_xform_compile(H5Z_data_xform_t *data_xform_prop);
+static herr_t H5Z_xform_compile_node(H5Z_data_xform_t *data_xform_prop, const H5Z_node *tree, unsigned depth, H5Z_xform_arg_t *arg);
 static void H5Z_xform_destroy_parse_tree(H5Z_node *tree);
 static void* H5Z_xform_parse(const char *expression, H5Z_datval_ptrs* dat_val_pointers);
 static void* H5Z_xform_copy_tree(H5Z_node* tree, H5Z_datval_ptrs* dat_val_pointers, H5Z_datval_ptrs* new_dat_val_pointers);
@@ -107,57 +130,82 @@ static void H5Z_XFORM_DEBUG(H5Z_node *tree);
 static void H5Z_print(H5Z_node *tree, FILE *stream);
 #endif  /* H5Z_XFORM_DEBUG */
 
-/* PGCC (11.8-0) has trouble with the command *p++ = *p OP tree_val. It increments P first before 
- * doing the operation.  So I break down the command into two lines:
- *     *p = *p OP tree_val; p++;
- * Actually, the behavior of *p++ = *p OP tree_val is undefined. (SLU - 2012/3/19) 
+/* Number of elements a compiled transform is applied to at a time.  Each
+ * temporary result holds this many elements, so that the temporaries and
+ * the block of data being transformed stay in the cache while every
+ * instruction is applied to them.
+ */
+#define H5Z_XFORM_BLOCK_NELMTS  1024
+
+/* Apply one instruction of a compiled transform to N elements.  The
+ * result of each operation is converted to TYPE, as if it were stored in
+ * the buffer being transformed.  Operations with a number are done in
+ * double precision (or in long double for long double data); operations
+ * between two values derived from the data (e.g. "x*x") are done in TYPE
+ * itself, so integer data gets integer arithmetic.
  */
-#define H5Z_XFORM_DO_OP1(RESL,RESR,TYPE,OP,SIZE)                            \
-{   								  	    \
-    size_t u;                                                               \
+#define H5Z_XFORM_DO_INST(TYPE, OP, INST, DST, LEFT, RIGHT, N)              \
+{                                                                           \
+    size_t _u;                                                              \
                                                                             \
-    if(((RESL).type == H5Z_XFORM_SYMBOL) && ((RESR).type != H5Z_XFORM_SYMBOL)) \
-    {   								    \
-	TYPE* p;                                                            \
-	double tree_val;                                                    \
-		                                                            \
-	tree_val = ((RESR).type==H5Z_XFORM_INTEGER ? (double)(RESR).value.int_val : (RESR).value.float_val); \
-	p = (TYPE*)(RESL).value.dat_val;                                    \
+    if((INST)->left.type == H5Z_XFORM_ARG_CONST) {                          \
+        const double _val = (INST)->left.value;                             \
                                                                             \
-	for(u=0; u<(SIZE); u++) {                                           \
-	    *p = *p OP tree_val;                                            \
-            p++;                                                            \
-        }                                                                   \
-    }									    \
-    else if(((RESR).type == H5Z_XFORM_SYMBOL) && ((RESL).type != H5Z_XFORM_SYMBOL)) \
-    {   								    \
-	TYPE* p;                                                            \
-	double tree_val;                                                    \
-		                                                            \
-        /* The case that the left operand is nothing, like -x or +x */      \
-	if((RESL).type == H5Z_XFORM_ERROR)                                  \
-            tree_val = 0;                                                   \
-	else                                                                \
-	    tree_val = ((RESL).type==H5Z_XFORM_INTEGER ? (double)(RESL).value.int_val : (RESL).value.float_val); \
+        for(_u = 0; _u < (N); _u++)                                         \
+            (DST)[_u] = (TYPE)(_val OP (RIGHT)[_u]);                        \
+    }                                                                       \
+    else if((INST)->right.type == H5Z_XFORM_ARG_CONST) {                    \
+        const double _val = (INST)->right.value;                            \
                                                                             \
-	p = (TYPE*)(RESR).value.dat_val;                                    \
-	for(u=0; u<(SIZE); u++) {                                           \
-	    *p = tree_val OP *p;                                            \
-            p++;                                                            \
-        }                                                                   \
-    }									    \
-    else if( ((RESL).type == H5Z_XFORM_SYMBOL) && ((RESR).type==H5Z_XFORM_SYMBOL))  \
-    {										\
-	TYPE* pl = (TYPE*)(RESL).value.dat_val;                             	\
-	TYPE* pr = (TYPE*)(RESR).value.dat_val;                             	\
-										\
-	for(u=0; u<(SIZE); u++) {                                            	\
-	    *pl = *pl OP *pr;                                           	\
-            pl++; pr++;                                                         \
-        }                                                                       \
-    }										\
-    else									\
-        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Unexpected type conversion operation")	\
+        for(_u = 0; _u < (N); _u++)                                         \
+            (DST)[_u] = (TYPE)((LEFT)[_u] OP _val);                         \
+    }                                                                       \
+    else                                                                    \
+        for(_u = 0; _u < (N); _u++)                                         \
+            (DST)[_u] = (TYPE)((LEFT)[_u] OP (RIGHT)[_u]);                  \
+}
+
+/* Run the compiled transform over ARRAY, a block at a time.  The last
+ * instruction stores its result straight into the block, since each
+ * element is only read before the result for it is written.
+ */
+#define H5Z_XFORM_DO_PROG(TYPE, XFORM, ARRAY, SIZE, TEMPS)                  \
+{                                                                           \
+    TYPE *_temps = (TYPE *)(TEMPS);                                         \
+    size_t _start;                                                          \
+                                                                            \
+    for(_start = 0; _start < (SIZE); _start += H5Z_XFORM_BLOCK_NELMTS) {    \
+        TYPE *_data = (TYPE *)(ARRAY) + _start;                             \
+        size_t _n = MIN((SIZE) - _start, H5Z_XFORM_BLOCK_NELMTS);           \
+        size_t _i;                                                          \
+                                                                            \
+        for(_i = 0; _i < (XFORM)->ninsts; _i++) {                           \
+            const H5Z_xform_inst_t *_inst = &(XFORM)->insts[_i];            \
+            const TYPE *_left = _inst->left.type == H5Z_XFORM_ARG_TEMP ?    \
+                    _temps + _inst->left.temp * H5Z_XFORM_BLOCK_NELMTS : _data; \
+            const TYPE *_right = _inst->right.type == H5Z_XFORM_ARG_TEMP ?  \
+                    _temps + _inst->right.temp * H5Z_XFORM_BLOCK_NELMTS : _data; \
+            TYPE *_dst = (_i + 1) == (XFORM)->ninsts ? _data :              \
+                    _temps + _inst->dst * H5Z_XFORM_BLOCK_NELMTS;           \
+                                                                            \
+            switch(_inst->op) {                                             \
+                case H5Z_XFORM_PLUS:                                        \
+                    H5Z_XFORM_DO_INST(TYPE, +, _inst, _dst, _left, _right, _n) \
+                    break;                                                  \
+                case H5Z_XFORM_MINUS:                                       \
+                    H5Z_XFORM_DO_INST(TYPE, -, _inst, _dst, _left, _right, _n) \
+                    break;                                                  \
+                case H5Z_XFORM_MULT:                                        \
+                    H5Z_XFORM_DO_INST(TYPE, *, _inst, _dst, _left, _right, _n) \
+                    break;                                                  \
+                case H5Z_XFORM_DIVIDE:                                      \
+                    H5Z_XFORM_DO_INST(TYPE, /, _inst, _dst, _left, _right, _n) \
+                    break;                                                  \
+                default:                                                    \
+                    HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid expression tree") \
+            } /* end switch */                                              \
+        } /* end for */                                                     \
+    } /* end for */                                                         \
 }
 
 /* Due to the undefined nature of embedding macros/conditionals within macros, we employ
@@ -168,90 +216,27 @@ static void H5Z_print(H5Z_node *tree, FILE *stream);
 
 
 #ifndef H5_ULLONG_TO_FP_CAST_WORKS
-#define H5Z_XFORM_ULL_DO_OP1(RESL,RESR,TYPE,OP,SIZE)                    \
+#define H5Z_XFORM_ULL_DO_PROG(TYPE,XFORM,ARRAY,SIZE,TEMPS)                  \
 {									\
     HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Cannot convert from unsigned long long to double: required for data transform") \
 }
 #else
-#define H5Z_XFORM_ULL_DO_OP1(RESL,RESR,TYPE,OP,SIZE)                    \
-    H5Z_XFORM_DO_OP1(RESL,RESR,TYPE,OP,SIZE)
+#define H5Z_XFORM_ULL_DO_PROG(TYPE,XFORM,ARRAY,SIZE,TEMPS)                  \
+    H5Z_XFORM_DO_PROG(TYPE,XFORM,ARRAY,SIZE,TEMPS)
 #endif
 
 /* Windows Intel 8.1 compiler has error converting long long to double.
  * Hard code it in.
  */
 #ifndef H5_LLONG_TO_FP_CAST_WORKS
-#define H5Z_XFORM_LL_DO_OP1(RESL,RESR,TYPE,OP,SIZE)                     \
+#define H5Z_XFORM_LL_DO_PROG(TYPE,XFORM,ARRAY,SIZE,TEMPS)                   \
 {									\
     HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Cannot convert from long long to double: required for data transform") \
 }
 #else
-#define H5Z_XFORM_LL_DO_OP1(RESL,RESR,TYPE,OP,SIZE)                     \
-    H5Z_XFORM_DO_OP1(RESL,RESR,TYPE,OP,SIZE)
+#define H5Z_XFORM_LL_DO_PROG(TYPE,XFORM,ARRAY,SIZE,TEMPS)                   \
+    H5Z_XFORM_DO_PROG(TYPE,XFORM,ARRAY,SIZE,TEMPS)
 #endif
-#if H5_SIZEOF_LONG_DOUBLE !=0
-#define H5Z_XFORM_TYPE_OP(RESL,RESR,TYPE,OP,SIZE)			\
-{									\
-    if((TYPE) == H5T_NATIVE_CHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), char, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_UCHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned char, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_SCHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), signed char, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_SHORT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), short, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_USHORT)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned short, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_INT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), int, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_UINT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned int, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_ULONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned long, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LLONG)					\
-	H5Z_XFORM_LL_DO_OP1((RESL), (RESR), long long, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_ULLONG)				\
-	H5Z_XFORM_ULL_DO_OP1((RESL), (RESR), unsigned long long, OP, (SIZE)) \
-    else if((TYPE) == H5T_NATIVE_FLOAT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), float, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_DOUBLE)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), double, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_LDOUBLE)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long double, OP, (SIZE))	\
-}
-#else
-#define H5Z_XFORM_TYPE_OP(RESL,RESR,TYPE,OP,SIZE)			\
-{									\
-    if((TYPE) == H5T_NATIVE_CHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), char, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_UCHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned char, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_SCHAR)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), signed char, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_SHORT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), short, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_USHORT)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned short, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_INT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), int, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_UINT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned int, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), long, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_ULONG)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), unsigned long, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_LLONG)					\
-	H5Z_XFORM_LL_DO_OP1((RESL), (RESR), long long, OP, (SIZE))	\
-    else if((TYPE) == H5T_NATIVE_ULLONG)				\
-	H5Z_XFORM_ULL_DO_OP1((RESL), (RESR), unsigned long long, OP, (SIZE)) \
-    else if((TYPE) == H5T_NATIVE_FLOAT)					\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), float, OP, (SIZE))		\
-    else if((TYPE) == H5T_NATIVE_DOUBLE)				\
-	H5Z_XFORM_DO_OP1((RESL), (RESR), double, OP, (SIZE))		\
-}
-#endif /*H5_SIZEOF_LONG_DOUBLE */
 
 #define H5Z_XFORM_DO_OP3(OP)                                                                                                                    \
 {                                                                                                                                               \
@@ -951,8 +936,8 @@ done:
 /*-------------------------------------------------------------------------
  * Function:    H5Z_xform_eval
  * Purpose: 	If the transform is trivial, this function applies it.
- * 		Otherwise, it calls H5Z_xform_eval_full to do the full
- * 		transform.
+ * 		Otherwise, it runs the transform compiled by
+ * 		H5Z_xform_compile over the array, a block at a time.
  * Return:      SUCCEED if transform applied succesfully, FAIL otherwise
  * Programmer:  Leon Arber
  * 		5/1/04
@@ -965,8 +950,7 @@ H5Z_xform_eval(H5Z_data_xform_t *data_xform_prop, void* array, size_t array_size
 {
     H5Z_node *tree;
     hid_t array_type;
-    H5Z_result res;
-    size_t i;
+    void *temps = NULL;                 /* Temporary results of the transform */
     herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
@@ -1017,142 +1001,51 @@ H5Z_xform_eval(H5Z_data_xform_t *data_xform_prop, void* array, size_t array_size
 #endif
 
     } /* end if */
-    /* Otherwise, do the full data transform */
-    else {
-	/* Optimization for linear transform: */
-	if(data_xform_prop->dat_val_pointers->num_ptrs == 1)
-	    data_xform_prop->dat_val_pointers->ptr_dat_val[0] = array;
-
-	/* If it's a quadratic transform, we have no choice but to store multiple copies of the data */
-	else {
-	    for(i = 0; i < data_xform_prop->dat_val_pointers->num_ptrs; i++) {
-		if(NULL == (data_xform_prop->dat_val_pointers->ptr_dat_val[i] = (void*)H5MM_malloc(array_size * H5T_get_size((H5T_t *)H5I_object(array_type)))))
-		    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "Ran out of memory trying to allocate space for data in data transform")
-
-                HDmemcpy(data_xform_prop->dat_val_pointers->ptr_dat_val[i], array, array_size * H5T_get_size((H5T_t *)H5I_object(array_type)));
-	    } /* end for */
-	} /* end else */
-
-	if(H5Z_xform_eval_full(tree, array_size, array_type, &res) < 0)
-	    HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "error while performing data transform")
-
-	if(data_xform_prop->dat_val_pointers->num_ptrs > 1)
-	    HDmemcpy(array, res.value.dat_val, array_size * H5T_get_size((H5T_t *)H5I_object(array_type)));
-
-        /* Free the temporary arrays we used */
-        if(data_xform_prop->dat_val_pointers->num_ptrs > 1)
-            for(i=0; i<data_xform_prop->dat_val_pointers->num_ptrs; i++)
-                HDfree(data_xform_prop->dat_val_pointers->ptr_dat_val[i]);
-    } /* end else */
-
-done:
-    if(ret_value < 0) {
-	/* If we ran out of memory above copying the array for temp storage (which we easily can for
-	 * polynomial transforms of high order) we free those arrays which we already allocated */
-	if(data_xform_prop->dat_val_pointers->num_ptrs > 1)
-	    for(i = 0; i < data_xform_prop->dat_val_pointers->num_ptrs; i++)
-		if(data_xform_prop->dat_val_pointers->ptr_dat_val[i])
-		    HDfree(data_xform_prop->dat_val_pointers->ptr_dat_val[i]);
-    } /* end if */
-
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5Z_xform_eval() */
+    /* Otherwise, run the compiled transform */
+    else if(data_xform_prop->ninsts > 0) {
+        /* Allocate the temporary results for one block */
+        if(data_xform_prop->ninsts > 1)
+            if(NULL == (temps = H5MM_malloc(data_xform_prop->ntemps * H5Z_XFORM_BLOCK_NELMTS * H5T_get_size(buf_type))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "Ran out of memory trying to allocate space for data in data transform")
 
-
-/*-------------------------------------------------------------------------
- * Function:    H5Z_xform_eval_full
- * Purpose: 	Does a full evaluation of the parse tree contained in tree
- * 		and applies this transform to array.
- * Return:      Nothing
- * Programmer:  Leon Arber
- * 		5/1/04
- * Modifications:
- *
- *
- * Notes:   In the case of a polynomial data transform (ie, the left and right subtree
- * are both of type H5Z_XFORM_SYMBOL), the convention is that the left hand side
- * will accumulate changes and, at the end, the new data will be copied from the lhs.
- *-------------------------------------------------------------------------
- */
-static herr_t
-H5Z_xform_eval_full(H5Z_node *tree, const size_t array_size,  const hid_t array_type, H5Z_result *res)
-{
-    H5Z_result resl, resr;
-    herr_t ret_value = SUCCEED;         /* Return value */
-
-    FUNC_ENTER_NOAPI_NOINIT
-
-    /* check args */
-    HDassert(tree);
-
-    HDmemset(&resl, 0, sizeof(H5Z_result));
-    HDmemset(&resr, 0, sizeof(H5Z_result));
-
-    if (tree->type == H5Z_XFORM_INTEGER) {
-	res->type = H5Z_XFORM_INTEGER;
-	res->value.int_val = tree->value.int_val;
-    } /* end if */
-    else if (tree->type == H5Z_XFORM_FLOAT) {
-	res->type = H5Z_XFORM_FLOAT;
-	res->value.float_val = tree->value.float_val;
-    } /* end if */
-    else if (tree->type == H5Z_XFORM_SYMBOL) {
-	res->type = H5Z_XFORM_SYMBOL;
-
-	/*since dat_val stores the address of the array which is really stored in the dat_val_pointers,
-	 * here we make dat_val store a pointer to the array itself instead of the address of it so that the
-	 * rest of the code below works normally. */
-	res->value.dat_val = *((void**)(tree->value.dat_val));
+        if(array_type == H5T_NATIVE_CHAR)
+            H5Z_XFORM_DO_PROG(char, data_xform_prop, array, array_size, temps)
+        else if(array_type ==  H5T_NATIVE_UCHAR)
+            H5Z_XFORM_DO_PROG(unsigned char, data_xform_prop, array, array_size, temps)
+        else if(array_type == H5T_NATIVE_SCHAR)
+            H5Z_XFORM_DO_PROG(signed char, data_xform_prop, array, array_size, temps)
+        else if(array_type == H5T_NATIVE_SHORT)
+            H5Z_XFORM_DO_PROG(short, data_xform_prop, array, array_size, temps)
+        else if(array_type == H5T_NATIVE_USHORT)
+            H5Z_XFORM_DO_PROG(unsigned short, data_xform_prop, array, array_size, temps)
+        else if(array_type == H5T_NATIVE_INT)
+            H5Z_XFORM_DO_PROG(int, data_xform_prop, array, array_size, temps)
+        else if(array_type ==  H5T_NATIVE_UINT)
+            H5Z_XFORM_DO_PROG(unsigned int, data_xform_prop, array, array_size, temps)
+        else if(array_type == H5T_NATIVE_LONG)
+            H5Z_XFORM_DO_PROG(long, data_xform_prop, array, array_size, temps)
+        else if(array_type == H5T_NATIVE_ULONG)
+            H5Z_XFORM_DO_PROG(unsigned long, data_xform_prop, array, array_size, temps)
+        else if(array_type == H5T_NATIVE_LLONG)
+            H5Z_XFORM_LL_DO_PROG(long long, data_xform_prop, array, array_size, temps)
+        else if(array_type == H5T_NATIVE_ULLONG)
+            H5Z_XFORM_ULL_DO_PROG(unsigned long long, data_xform_prop, array, array_size, temps)
+        else if(array_type == H5T_NATIVE_FLOAT)
+            H5Z_XFORM_DO_PROG(float, data_xform_prop, array, array_size, temps)
+	else if(array_type == H5T_NATIVE_DOUBLE)
+            H5Z_XFORM_DO_PROG(double, data_xform_prop, array, array_size, temps)
+#if H5_SIZEOF_LONG_DOUBLE !=0
+	else if(array_type == H5T_NATIVE_LDOUBLE)
+            H5Z_XFORM_DO_PROG(long double, data_xform_prop, array, array_size, temps)
+#endif
     } /* end if */
-    else {
-	if(tree->lchild && H5Z_xform_eval_full(tree->lchild, array_size, array_type, &resl) < 0)
-	    HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "error while performing data transform")
-	if(H5Z_xform_eval_full(tree->rchild, array_size, array_type, &resr) < 0)
-	    HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "error while performing data transform")
-
-	res->type = H5Z_XFORM_SYMBOL;
-
-	/* For each type of operation:
-	 * 1.  See if "x" is on left hand side, right hand side, or if both sides are "x"
-	 * 2.  Figure out what type of data we're going to be manipulating
-	 * 3.  Do the operation on the data. */
-
-
-	switch (tree->type) {
-	    case H5Z_XFORM_PLUS:
-	 	H5Z_XFORM_TYPE_OP(resl, resr, array_type, +, array_size)
-		break;
-
-	    case H5Z_XFORM_MINUS:
-	 	H5Z_XFORM_TYPE_OP(resl, resr, array_type, -, array_size)
-		break;
-
-	    case H5Z_XFORM_MULT:
-		H5Z_XFORM_TYPE_OP(resl, resr, array_type, *, array_size)
-		break;
-
-	    case H5Z_XFORM_DIVIDE:
-	 	H5Z_XFORM_TYPE_OP(resl, resr, array_type, /, array_size)
-		break;
-
-	    default:
-		HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid expression tree")
-	} /* end switch */
-
-	/* The result stores a pointer to the new data */
-	/* So, if the left hand side got its data modified, the result stores a pointers
-	 * to the left hand side's data, ditto for rhs */
-	if(resl.type ==  H5Z_XFORM_SYMBOL)
-	    res->value.dat_val = resl.value.dat_val;
-	else if(resr.type == H5Z_XFORM_SYMBOL)
-	    res->value.dat_val = resr.value.dat_val;
-	else
-	    HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "error during transform evaluation")
-    } /* end else */
 
 done:
+    if(temps)
+        H5MM_xfree(temps);
+
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5Z_xform_eval_full() */
+} /* end H5Z_xform_eval() */
 
 
 /*-------------------------------------------------------------------------
@@ -1239,6 +1132,132 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5Z_xform_find_type() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z_xform_compile
+ * Purpose:     Compiles the parse tree of a transform into a list of
+ *              instructions in postfix order, which H5Z_xform_eval
+ *              applies to each block of the data in turn.  The result of
+ *              each instruction goes into a temporary block, which are
+ *              numbered by the depth of the instruction's operands on an
+ *              evaluation stack, so a transform with N operators needs at
+ *              most N temporaries.
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_xform_compile(H5Z_data_xform_t *data_xform_prop)
+{
+    H5Z_xform_arg_t result;             /* Result of the whole transform */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(data_xform_prop);
+    HDassert(data_xform_prop->parse_root);
+
+    data_xform_prop->ninsts = 0;
+    data_xform_prop->ntemps = 0;
+
+    /* Numbers are applied directly by H5Z_xform_eval, and don't need a program */
+    if(data_xform_prop->parse_root->type != H5Z_XFORM_INTEGER
+            && data_xform_prop->parse_root->type != H5Z_XFORM_FLOAT)
+        if(H5Z_xform_compile_node(data_xform_prop, data_xform_prop->parse_root, 0, &result) < 0)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "unable to compile data transform")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_xform_compile() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z_xform_compile_node
+ * Purpose:     Compiles the subtree at TREE, appending the instructions
+ *              for any operators to the transform, and returns the
+ *              operand which holds the subtree's value in ARG.  DEPTH is
+ *              the first temporary result the subtree may use.
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_xform_compile_node(H5Z_data_xform_t *data_xform_prop, const H5Z_node *tree,
+    unsigned depth, H5Z_xform_arg_t *arg)
+{
+    H5Z_xform_arg_t left, right;        /* Operands of an operator */
+    H5Z_xform_inst_t *inst;             /* Instruction for an operator */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(tree);
+
+    switch(tree->type) {
+        case H5Z_XFORM_INTEGER:
+            arg->type = H5Z_XFORM_ARG_CONST;
+            arg->value = (double)tree->value.int_val;
+            break;
+
+        case H5Z_XFORM_FLOAT:
+            arg->type = H5Z_XFORM_ARG_CONST;
+            arg->value = tree->value.float_val;
+            break;
+
+        case H5Z_XFORM_SYMBOL:
+            arg->type = H5Z_XFORM_ARG_DATA;
+            break;
+
+        case H5Z_XFORM_PLUS:
+        case H5Z_XFORM_MINUS:
+        case H5Z_XFORM_MULT:
+        case H5Z_XFORM_DIVIDE:
+            /* The left operand is missing for unary operators, like -x or +x */
+            if(tree->lchild) {
+                if(H5Z_xform_compile_node(data_xform_prop, tree->lchild, depth, &left) < 0)
+                    HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "unable to compile data transform")
+            } /* end if */
+            else {
+                left.type = H5Z_XFORM_ARG_CONST;
+                left.value = 0;
+            } /* end else */
+
+            /* Keep the left operand while computing the right one */
+            if(H5Z_xform_compile_node(data_xform_prop, tree->rchild, left.type == H5Z_XFORM_ARG_TEMP ? depth + 1 : depth, &right) < 0)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "unable to compile data transform")
+            if(left.type == H5Z_XFORM_ARG_CONST && right.type == H5Z_XFORM_ARG_CONST)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Unexpected type conversion operation")
+
+            /* Append the instruction */
+            if(data_xform_prop->ninsts == data_xform_prop->ninsts_alloc) {
+                size_t n = MAX(8, 2 * data_xform_prop->ninsts_alloc);
+                H5Z_xform_inst_t *x;
+
+                if(NULL == (x = (H5Z_xform_inst_t *)H5MM_realloc(data_xform_prop->insts, n * sizeof(H5Z_xform_inst_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate memory for data transform instructions")
+                data_xform_prop->insts = x;
+                data_xform_prop->ninsts_alloc = n;
+            } /* end if */
+            inst = &data_xform_prop->insts[data_xform_prop->ninsts++];
+            inst->op = tree->type;
+            inst->left = left;
+            inst->right = right;
+            inst->dst = depth;
+
+            /* The result replaces the operands on the stack */
+            data_xform_prop->ntemps = MAX(data_xform_prop->ntemps, depth + 1);
+            arg->type = H5Z_XFORM_ARG_TEMP;
+            arg->temp = depth;
+            break;
+
+        default:
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid expression tree")
+    } /* end switch */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_xform_compile_node() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Z_xform_copy_tree
@@ -1532,6 +1551,10 @@ H5Z_xform_create(const char *expr)
     if(count != data_xform_prop->dat_val_pointers->num_ptrs)
          HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "error copying the parse tree, did not find correct number of \"variables\"")
 
+    /* Compile the parse tree, so it isn't walked for every buffer transformed */
+    if(H5Z_xform_compile(data_xform_prop) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "unable to compile data transform")
+
     /* Assign return value */
     ret_value=data_xform_prop;
 
@@ -1542,6 +1565,8 @@ done:
         if(data_xform_prop) {
             if(data_xform_prop->parse_root)
                 H5Z_xform_destroy_parse_tree(data_xform_prop->parse_root);
+            if(data_xform_prop->insts)
+                H5MM_xfree(data_xform_prop->insts);
             if(data_xform_prop->xform_exp)
                 H5MM_xfree(data_xform_prop->xform_exp);
 	    if(count > 0 && data_xform_prop->dat_val_pointers->ptr_dat_val)
@@ -1584,6 +1609,10 @@ H5Z_xform_destroy(H5Z_data_xform_t *data_xform_prop)
 	/* Destroy the parse tree */
         H5Z_xform_destroy_parse_tree(data_xform_prop->parse_root);
 
+        /* Free the compiled transform */
+        if(data_xform_prop->insts)
+            H5MM_xfree(data_xform_prop->insts);
+
         /* Free the expression */
         H5MM_xfree(data_xform_prop->xform_exp);
 
@@ -1666,6 +1695,10 @@ H5Z_xform_copy(H5Z_data_xform_t **data_xform_prop)
 	if(count != new_data_xform_prop->dat_val_pointers->num_ptrs)
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "error copying the parse tree, did not find correct number of \"variables\"")
 
+        /* Compile the copy of the parse tree */
+        if(H5Z_xform_compile(new_data_xform_prop) < 0)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "unable to compile data transform")
+
         /* Copy new information on top of old information */
         *data_xform_prop=new_data_xform_prop;
     } /* end if */
@@ -1676,6 +1709,8 @@ done:
         if(new_data_xform_prop) {
             if(new_data_xform_prop->parse_root)
                 H5Z_xform_destroy_parse_tree(new_data_xform_prop->parse_root);
+            if(new_data_xform_prop->insts)
+                H5MM_xfree(new_data_xform_prop->insts);
             if(new_data_xform_prop->xform_exp)
                 H5MM_xfree(new_data_xform_prop->xform_exp);
             H5MM_xfree(new_data_xform_prop);
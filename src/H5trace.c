@@ -452,6 +452,10 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                                     fprintf(out, "H5FD_MPIO_CHUNK_MULTI_IO");
                                     break;
 
+                                case H5FD_MPIO_CHUNK_OWNER_IO:
+                                    fprintf(out, "H5FD_MPIO_CHUNK_OWNER_IO");
+                                    break;
+
                                 default:
                                     fprintf(out, "%ld", (long)opt);
                                     break;
@@ -1267,6 +1271,10 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                                 fprintf(out, "%ld (err stack)", (long)obj);
                                 break;
 
+                            case H5I_REQUEST:
+                                fprintf(out, "%ld (request)", (long)obj);
+                                break;
+
                             case H5I_NTYPES:
                                 fprintf (out, "%ld (ntypes - error)", (long)obj);
                                 break;
@@ -1448,6 +1456,10 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                                     fprintf(out, "H5I_ERROR_STACK");
                                     break;
 
+                                case H5I_REQUEST:
+                                    fprintf(out, "H5I_REQUEST");
+                                    break;
+
                                 case H5I_NTYPES:
                                     fprintf(out, "H5I_NTYPES");
                                     break;
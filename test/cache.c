@@ -178,6 +178,7 @@ static void check_move_entry__run_test(H5F_t * file_ptr, int test_num,
 static unsigned check_pin_protected_entry(void);
 static unsigned check_resize_entry(void);
 static unsigned check_evictions_enabled(void);
+static unsigned check_rp_policy_hit_rate(void);
 static unsigned check_destroy_pinned_err(void);
 static unsigned check_destroy_protected_err(void);
 static unsigned check_duplicate_insert_err(void);
@@ -16451,6 +16452,176 @@ check_evictions_enabled(void)
 
 } /* check_evictions_enabled() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	check_rp_policy_hit_rate__run_trace()
+ *
+ * Purpose:	Replay a synthetic access trace against a new cache using
+ *		the specified replacement policy, and return the hit rate.
+ *
+ *		Each round of the trace touches the same small set of
+ *		"hot" entries twice, and then scans a run of entries
+ *		never seen before which is as large as the cache.
+ *
+ * Return:	The hit rate, or a negative value on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#define RP_TEST_CACHE_SIZE	(size_t)(64 * 1024)
+#define RP_TEST_HOT_ENTRIES	32
+#define RP_TEST_SCAN_ENTRIES	64
+#define RP_TEST_ROUNDS		16
+
+static double
+check_rp_policy_hit_rate__run_trace(enum H5C_cache_rp_policy policy)
+{
+    int		   round;
+    int		   pass_num;
+    int		   i;
+    int32_t	   scan_idx = RP_TEST_HOT_ENTRIES;
+    double	   hit_rate = -1.0f;
+    H5F_t *        file_ptr = NULL;
+    H5C_t *        cache_ptr = NULL;
+
+    if ( pass ) {
+
+        reset_entries();
+
+        file_ptr = setup_cache(RP_TEST_CACHE_SIZE, RP_TEST_CACHE_SIZE / 4);
+
+        if ( file_ptr == NULL ) {
+
+            pass = FALSE;
+            failure_mssg = "file_ptr NULL from setup_cache.";
+
+        } else {
+
+            cache_ptr = file_ptr->shared->cache;
+        }
+    }
+
+    if ( pass ) {
+
+        if ( H5C_set_rp_policy(cache_ptr, policy) != SUCCEED ) {
+
+            pass = FALSE;
+            failure_mssg = "H5C_set_rp_policy() failed.";
+
+        } else if ( H5C_reset_cache_hit_rate_stats(cache_ptr) != SUCCEED ) {
+
+            pass = FALSE;
+            failure_mssg = "H5C_reset_cache_hit_rate_stats() failed.";
+        }
+    }
+
+    for ( round = 0; ( pass ) && ( round < RP_TEST_ROUNDS ); round++ )
+    {
+        for ( pass_num = 0; ( pass ) && ( pass_num < 2 ); pass_num++ )
+        {
+            for ( i = 0; ( pass ) && ( i < RP_TEST_HOT_ENTRIES ); i++ )
+            {
+                protect_entry(file_ptr, MEDIUM_ENTRY_TYPE, i);
+                unprotect_entry(file_ptr, MEDIUM_ENTRY_TYPE, i,
+                                H5C__NO_FLAGS_SET);
+            }
+        }
+
+        for ( i = 0; ( pass ) && ( i < RP_TEST_SCAN_ENTRIES ); i++ )
+        {
+            protect_entry(file_ptr, MEDIUM_ENTRY_TYPE, scan_idx);
+            unprotect_entry(file_ptr, MEDIUM_ENTRY_TYPE, scan_idx,
+                            H5C__NO_FLAGS_SET);
+            scan_idx++;
+        }
+    }
+
+    if ( pass ) {
+
+        if ( H5C_get_cache_hit_rate(cache_ptr, &hit_rate) != SUCCEED ) {
+
+            pass = FALSE;
+            failure_mssg = "H5C_get_cache_hit_rate() failed.";
+
+        } else if ( ( cache_ptr->index_size > RP_TEST_CACHE_SIZE ) ||
+                    ( cache_ptr->LRU_list_size != cache_ptr->index_size ) ||
+                    ( cache_ptr->rp_cold_size > cache_ptr->LRU_list_size ) ||
+                    ( ( policy == H5C_rp__lru ) &&
+                      ( cache_ptr->rp_cold_len != 0 ) ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected cache status after trace.";
+        }
+    }
+
+    if ( file_ptr != NULL ) {
+
+        takedown_cache(file_ptr, FALSE, FALSE);
+    }
+
+    return(hit_rate);
+
+} /* check_rp_policy_hit_rate__run_trace() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	check_rp_policy_hit_rate()
+ *
+ * Purpose:	Replay the same access trace under each of the supported
+ *		replacement policies, and verify that the 2Q policy keeps
+ *		a repeatedly accessed working set resident across scans
+ *		which the LRU policy does not.
+ *
+ *		The hit rate of each policy is reported if show_progress
+ *		is set.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static unsigned
+check_rp_policy_hit_rate(void)
+{
+    const char *   fcn_name = "check_rp_policy_hit_rate";
+    hbool_t	   show_progress = FALSE;
+    double	   lru_hit_rate;
+    double	   twoq_hit_rate;
+
+    TESTING("replacement policy hit rates under a replayed trace");
+
+    pass = TRUE;
+
+    lru_hit_rate = check_rp_policy_hit_rate__run_trace(H5C_rp__lru);
+    twoq_hit_rate = check_rp_policy_hit_rate__run_trace(H5C_rp__2q);
+
+    if ( show_progress )
+        HDfprintf(stdout, "\n%s(): LRU hit rate = %f, 2Q hit rate = %f\n",
+                  fcn_name, lru_hit_rate, twoq_hit_rate);
+
+    /* Under LRU, each scan flushes the hot entries out of the cache, so
+     * only the second touch of each hot entry in a round hits.  Under
+     * 2Q, the hot entries survive the scans after the first round.
+     */
+    if ( ( pass ) && ( twoq_hit_rate <= lru_hit_rate ) ) {
+
+        pass = FALSE;
+        failure_mssg = "2Q hit rate not better than LRU.";
+    }
+
+    if ( pass ) { PASSED(); } else { H5_FAILED(); }
+
+    if ( ! pass ) {
+
+        HDfprintf(stdout, "%s(): failure_mssg = \"%s\".\n",
+                  fcn_name, failure_mssg);
+    }
+
+    return (unsigned)!pass;
+
+} /* check_rp_policy_hit_rate() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	check_flush_protected_err()
@@ -33746,6 +33917,7 @@ main(void)
     nerrs += check_pin_protected_entry();
     nerrs += check_resize_entry();
     nerrs += check_evictions_enabled();
+    nerrs += check_rp_policy_hit_rate();
     nerrs += check_flush_protected_err();
     nerrs += check_destroy_pinned_err();
     nerrs += check_destroy_protected_err();
@@ -42,6 +42,10 @@ static void check_fapl_mdc_api_errs(void);
 
 static void check_file_mdc_api_errs(void);
 
+static void check_mdc_background_flush(void);
+
+static void check_mdc_config_version_1(void);
+
 
 /**************************************************************************/
 /**************************************************************************/
@@ -112,7 +116,9 @@ check_fapl_mdc_api_calls(void)
       /* double      empty_reserve          = */ 0.05f,
       /* int         dirty_bytes_threshold  = */ (256 * 1024),
       /* int	    metadata_write_strategy = */
-					H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+					H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+      /* enum H5C_cache_rp_policy             */
+      /*                 replacement_policy = */ H5C_rp__2q
     };
     H5AC_cache_config_t scratch;
     H5C_auto_size_ctl_t default_auto_size_ctl;
@@ -142,7 +148,7 @@ check_fapl_mdc_api_calls(void)
 
     if ( pass ) {
 
-        scratch.version = H5C__CURR_AUTO_SIZE_CTL_VER;
+        scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
 
         result = H5Pget_mdc_config(fapl_id, &scratch);
 
@@ -176,7 +182,7 @@ check_fapl_mdc_api_calls(void)
 
     if ( pass ) {
 
-        scratch.version = H5C__CURR_AUTO_SIZE_CTL_VER;
+        scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
 
         result = H5Pget_mdc_config(fapl_id, &scratch);
 
@@ -288,7 +294,7 @@ check_fapl_mdc_api_calls(void)
      */
     if ( pass ) {
 
-        scratch.version = H5C__CURR_AUTO_SIZE_CTL_VER;
+        scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
 
         result = H5Pget_mdc_config(fapl_id, &scratch);
 
@@ -437,7 +443,7 @@ check_fapl_mdc_api_calls(void)
      */
     if ( pass ) {
 
-        scratch.version = H5C__CURR_AUTO_SIZE_CTL_VER;
+        scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
 
         result = H5Pget_mdc_config(test_fapl_id, &scratch);
 
@@ -530,7 +536,7 @@ check_file_mdc_api_calls(void)
     H5AC_cache_config_t default_config = H5AC__DEFAULT_CACHE_CONFIG;
     H5AC_cache_config_t mod_config_1 =
     {
-      /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+      /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
       /* hbool_t     rpt_fcn_enabled        = */ FALSE,
       /* hbool_t     open_trace_file        = */ FALSE,
       /* hbool_t     close_trace_file       = */ FALSE,
@@ -561,11 +567,13 @@ check_file_mdc_api_calls(void)
       /* double      empty_reserve          = */ 0.05f,
       /* int         dirty_bytes_threshold  = */ (256 * 1024),
       /* int	    metadata_write_strategy = */
-					H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+					H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+      /* enum H5C_cache_rp_policy             */
+      /*                 replacement_policy = */ H5C_rp__2q
     };
     H5AC_cache_config_t mod_config_2 =
     {
-      /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+      /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
       /* hbool_t     rpt_fcn_enabled        = */ TRUE,
       /* hbool_t     open_trace_file        = */ FALSE,
       /* hbool_t     close_trace_file       = */ FALSE,
@@ -596,11 +604,13 @@ check_file_mdc_api_calls(void)
       /* double      empty_reserve          = */ 0.05f,
       /* int         dirty_bytes_threshold  = */ (256 * 1024),
       /* int	    metadata_write_strategy = */
-					H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+					H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+      /* enum H5C_cache_rp_policy             */
+      /*                 replacement_policy = */ H5C_rp__lru
     };
     H5AC_cache_config_t mod_config_3 =
     {
-      /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+      /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
       /* hbool_t     rpt_fcn_enabled        = */ FALSE,
       /* hbool_t     open_trace_file        = */ FALSE,
       /* hbool_t     close_trace_file       = */ FALSE,
@@ -631,11 +641,13 @@ check_file_mdc_api_calls(void)
       /* double      empty_reserve          = */ 0.05f,
       /* int         dirty_bytes_threshold  = */ (256 * 1024),
       /* int	    metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+      /* enum H5C_cache_rp_policy             */
+      /*                 replacement_policy = */ H5C_rp__lru
     };
     H5AC_cache_config_t mod_config_4 =
     {
-      /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+      /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
       /* hbool_t     rpt_fcn_enabled        = */ FALSE,
       /* hbool_t     open_trace_file        = */ FALSE,
       /* hbool_t     close_trace_file       = */ FALSE,
@@ -667,7 +679,9 @@ check_file_mdc_api_calls(void)
       /* double      empty_reserve          = */ 0.1f,
       /* int         dirty_bytes_threshold  = */ (256 * 1024),
       /* int	    metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+      /* enum H5C_cache_rp_policy             */
+      /*                 replacement_policy = */ H5C_rp__lru
     };
 
     TESTING("MDC/FILE related API calls");
@@ -892,7 +906,7 @@ mdc_api_call_smoke_check(int express_test)
     H5AC_cache_config_t default_config = H5AC__DEFAULT_CACHE_CONFIG;
     H5AC_cache_config_t mod_config_1 =
     {
-      /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+      /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
       /* hbool_t     rpt_fcn_enabled        = */ FALSE,
       /* hbool_t     open_trace_file        = */ FALSE,
       /* hbool_t     close_trace_file       = */ FALSE,
@@ -923,11 +937,13 @@ mdc_api_call_smoke_check(int express_test)
       /* double      empty_reserve          = */ 0.05f,
       /* int         dirty_bytes_threshold  = */ (256 * 1024),
       /* int	    metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+      /* enum H5C_cache_rp_policy             */
+      /*                 replacement_policy = */ H5C_rp__lru
     };
     H5AC_cache_config_t mod_config_2 =
     {
-      /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+      /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
       /* hbool_t     rpt_fcn_enabled        = */ FALSE,
       /* hbool_t     open_trace_file        = */ FALSE,
       /* hbool_t     close_trace_file       = */ FALSE,
@@ -958,11 +974,13 @@ mdc_api_call_smoke_check(int express_test)
       /* double      empty_reserve          = */ 0.05f,
       /* int         dirty_bytes_threshold  = */ (256 * 1024),
       /* int	    metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+      /* enum H5C_cache_rp_policy             */
+      /*                 replacement_policy = */ H5C_rp__lru
     };
     H5AC_cache_config_t mod_config_3 =
     {
-      /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+      /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
       /* hbool_t     rpt_fcn_enabled        = */ FALSE,
       /* hbool_t     open_trace_file        = */ FALSE,
       /* hbool_t     close_trace_file       = */ FALSE,
@@ -993,7 +1011,9 @@ mdc_api_call_smoke_check(int express_test)
       /* double      empty_reserve          = */ 0.05f,
       /* int         dirty_bytes_threshold  = */ (256 * 1024),
       /* int	    metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+      /* enum H5C_cache_rp_policy             */
+      /*                 replacement_policy = */ H5C_rp__lru
     };
 
     TESTING("MDC API smoke check");
@@ -1560,11 +1580,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 1 -- bad rpt_fcn_enabled */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ (hbool_t)-1,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -1595,11 +1617,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 2 -- bad open_trace_file */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ (hbool_t)-1,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -1630,11 +1654,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 3 -- bad close_trace_file */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ (hbool_t)-1,
@@ -1665,11 +1691,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 4 -- open_trace_file == TRUE and empty trace_file_name */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ TRUE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -1700,11 +1728,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 5 -- bad set_initial_size */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -1735,11 +1765,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 6 -- max_size too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -1770,11 +1802,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 7 -- min_size too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -1805,11 +1839,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 8 -- min_size > max_size */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -1840,11 +1876,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 9 -- initial size out of range (too big) */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -1875,11 +1913,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 10 -- initial_size out of range (too small) */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -1910,11 +1950,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 11 -- min_clean_fraction too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -1945,11 +1987,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 12 -- min_clean_fraction too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -1980,11 +2024,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 13 -- epoch_length too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2015,11 +2061,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 14 -- epoch_length too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2050,11 +2098,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 15 -- invalid incr_mode */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2085,11 +2135,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 16 -- lower_hr_threshold too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2120,11 +2172,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 17 -- lower_hr_threshold too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2155,11 +2209,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 18 -- increment too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2190,11 +2246,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 19 -- bad apply_max_increment */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2225,11 +2283,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 20 -- invalid flash_incr_mode */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2260,11 +2320,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 21 -- flash_multiple too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2295,11 +2357,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 22 -- flash_multiple too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2330,11 +2394,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 23 -- flash_threshold too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2365,11 +2431,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 24 -- flash_threshold too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2400,11 +2468,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 25 -- bad decr_mode */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2435,11 +2505,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 26 -- upper_hr_threshold too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2470,11 +2542,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 27 -- decrement too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2505,11 +2579,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 28 -- decrement too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2540,11 +2616,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 29 -- epochs_before_eviction too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2575,11 +2653,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 30 -- epochs_before_eviction too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2610,11 +2690,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 31 -- invalid apply_empty_reserve */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2645,11 +2727,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 32 -- empty_reserve too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2680,11 +2764,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ -0.0000000001f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 33 -- empty_reserve too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2715,11 +2801,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 1.00000000001,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 34 -- upper_hr_threshold too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2750,11 +2838,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 35 -- upper_hr_threshold too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2785,11 +2875,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 36 -- upper_hr_threshold <= lower_hr_threshold */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2820,11 +2912,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 37 -- dirty_bytes_threshold too small */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2855,11 +2949,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (H5C__MIN_MAX_CACHE_SIZE / 2) - 1,
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 38 -- dirty_bytes_threshold too big */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2890,11 +2986,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (H5C__MAX_MAX_CACHE_SIZE / 4) + 1,
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 39 -- attempt to disable evictions when auto incr enabled */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2925,11 +3023,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 40 -- attempt to disable evictions when auto decr enabled */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2960,11 +3060,13 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
     /* int	  metadata_write_strategy = */
-				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY
+				      H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   },
   {
     /* 41 -- unknown metadata write strategy */
-    /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
+    /* int         version                = */ H5AC__CURR_CACHE_CONFIG_VERSION,
     /* hbool_t     rpt_fcn_enabled        = */ FALSE,
     /* hbool_t     open_trace_file        = */ FALSE,
     /* hbool_t     close_trace_file       = */ FALSE,
@@ -2994,7 +3096,9 @@ H5AC_cache_config_t invalid_configs[NUM_INVALID_CONFIGS] =
     /* hbool_t     apply_empty_reserve    = */ TRUE,
     /* double      empty_reserve          = */ 0.1f,
     /* int         dirty_bytes_threshold  = */ (256 * 1024),
-    /* int	  metadata_write_strategy = */ -1
+    /* int	  metadata_write_strategy = */ -1,
+    /* enum H5C_cache_rp_policy             */
+    /*                 replacement_policy = */ H5C_rp__lru
   }
 };
 
@@ -3034,7 +3138,7 @@ check_fapl_mdc_api_errs(void)
     /* first test H5Pget_mdc_config().
      */
 
-    scratch.version = H5C__CURR_AUTO_SIZE_CTL_VER;
+    scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
     if  ( pass ) {
 
         H5E_BEGIN_TRY {
@@ -3063,7 +3167,7 @@ check_fapl_mdc_api_errs(void)
         }
     }
 
-    scratch.version = H5C__CURR_AUTO_SIZE_CTL_VER;
+    scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
     if ( ( pass ) &&
          ( ( H5Pget_mdc_config(fapl_id, &scratch) < 0 ) ||
            ( !CACHE_CONFIGS_EQUAL(default_config, scratch, TRUE, TRUE) ) ) ) {
@@ -3105,7 +3209,7 @@ check_fapl_mdc_api_errs(void)
     /* now test H5Pset_mdc_config()
      */
 
-    scratch.version = H5C__CURR_AUTO_SIZE_CTL_VER;
+    scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
     if ( pass ) {
 
         H5E_BEGIN_TRY {
@@ -3152,7 +3256,7 @@ check_fapl_mdc_api_errs(void)
     /* verify that none of the above calls to H5Pset_mdc_config() changed
      * the configuration in the FAPL.
      */
-    scratch.version = H5C__CURR_AUTO_SIZE_CTL_VER;
+    scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
     if ( ( pass ) &&
          ( ( H5Pget_mdc_config(fapl_id, &scratch) < 0 ) ||
            ( !CACHE_CONFIGS_EQUAL(default_config, scratch, TRUE, TRUE) ) ) ) {
@@ -3249,7 +3353,7 @@ check_file_mdc_api_errs(void)
 
     /* test H5Fget_mdc_config().  */
 
-    scratch.version = H5C__CURR_AUTO_SIZE_CTL_VER;
+    scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
     if  ( pass ) {
 
 	if ( show_progress ) {
@@ -3308,7 +3412,7 @@ check_file_mdc_api_errs(void)
 
     /* test H5Fset_mdc_config() */
 
-    scratch.version = H5C__CURR_AUTO_SIZE_CTL_VER;
+    scratch.version = H5AC__CURR_CACHE_CONFIG_VERSION;
     if ( pass ) {
 
 	if ( show_progress ) {
@@ -3506,6 +3610,489 @@ check_file_mdc_api_errs(void)
 
 } /* check_file_mdc_api_errs() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:	check_mdc_background_flush()
+ *
+ * Purpose:	Verify that the metadata cache background flush threshold
+ *		can be set on a FAPL, that dirty entries are written ahead
+ *		of need once more of the cache than that is dirty, and
+ *		that the file is intact afterwards.
+ *
+ *		In a thread-safe build, the entries are written by a
+ *		background thread, so wait a while for it to run.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#define BG_FLUSH_NUM_GROUPS	500
+#define BG_FLUSH_THRESHOLD	0.1f
+
+static void
+check_mdc_background_flush(void)
+{
+    const char * fcn_name = "check_mdc_background_flush()";
+    char filename[512];
+    char group_name[32];
+    herr_t result;
+    hid_t fapl_id = -1;
+    hid_t file_id = -1;
+    hid_t group_id = -1;
+    int i;
+    size_t trigger = 0;
+    double threshold = -1.0f;
+    H5F_t * file_ptr = NULL;
+    H5C_t * cache_ptr = NULL;
+    H5AC_cache_config_t config;
+
+    TESTING("MDC background flush");
+
+    pass = TRUE;
+
+    /* create a FAPL, and verify that background flushing is disabled
+     * by default.
+     */
+    if ( pass ) {
+
+        fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+
+        if ( fapl_id < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Pcreate(H5P_FILE_ACCESS) failed.\n";
+
+        } else if ( ( H5Pget_mdc_background_flush(fapl_id, &threshold) < 0 ) ||
+                    ( threshold != 0.0f ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected default background flush threshold.\n";
+        }
+    }
+
+    /* verify that thresholds outside [0.0, 1.0] are rejected */
+    if ( pass ) {
+
+        H5E_BEGIN_TRY {
+            result = H5Pset_mdc_background_flush(fapl_id, -0.5f);
+        } H5E_END_TRY;
+
+        if ( result >= 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Pset_mdc_background_flush() accepted -0.5.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        H5E_BEGIN_TRY {
+            result = H5Pset_mdc_background_flush(fapl_id, 1.5f);
+        } H5E_END_TRY;
+
+        if ( result >= 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Pset_mdc_background_flush() accepted 1.5.\n";
+        }
+    }
+
+    /* set the threshold, and read it back */
+    if ( pass ) {
+
+        if ( ( H5Pset_mdc_background_flush(fapl_id, BG_FLUSH_THRESHOLD) < 0 ) ||
+             ( H5Pget_mdc_background_flush(fapl_id, &threshold) < 0 ) ||
+             ( threshold != BG_FLUSH_THRESHOLD ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Can't set background flush threshold.\n";
+        }
+    }
+
+    /* use a small cache of fixed size, so that the groups created below
+     * dirty much more of it than the threshold allows.
+     */
+    if ( pass ) {
+
+        config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+
+        if ( H5Pget_mdc_config(fapl_id, &config) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Pget_mdc_config() failed.\n";
+
+        } else {
+
+            config.set_initial_size = TRUE;
+            config.initial_size = 512 * 1024;
+            config.min_size = 512 * 1024;
+            config.max_size = 512 * 1024;
+            config.incr_mode = H5C_incr__off;
+            config.flash_incr_mode = H5C_flash_incr__off;
+            config.decr_mode = H5C_decr__off;
+
+            if ( H5Pset_mdc_config(fapl_id, &config) < 0 ) {
+
+                pass = FALSE;
+                failure_mssg = "H5Pset_mdc_config() failed.\n";
+            }
+        }
+    }
+
+    /* setup the file name */
+    if ( pass ) {
+
+        if ( h5_fixname(FILENAME[1], H5P_DEFAULT, filename, sizeof(filename))
+            == NULL ) {
+
+            pass = FALSE;
+            failure_mssg = "h5_fixname() failed.\n";
+        }
+    }
+
+    /* create the file, and get a pointer to its cache */
+    if ( pass ) {
+
+        file_id = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id);
+
+        if ( file_id < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fcreate() failed.\n";
+
+        } else if ( NULL == (file_ptr = (H5F_t *)H5I_object_verify(file_id,
+                                                             H5I_FILE)) ) {
+
+            pass = FALSE;
+            failure_mssg = "Can't get file_ptr.\n";
+
+        } else {
+
+            cache_ptr = file_ptr->shared->cache;
+            trigger = (size_t)(((double)(cache_ptr->max_cache_size)) *
+                               BG_FLUSH_THRESHOLD);
+
+            if ( ( cache_ptr->bg_flush_threshold != BG_FLUSH_THRESHOLD ) ||
+                 ( cache_ptr->bg_flushes != 0 ) ) {
+
+                pass = FALSE;
+                failure_mssg = "Unexpected initial background flush state.\n";
+            }
+        }
+    }
+
+    /* dirty the cache by creating lots of groups */
+    for ( i = 0; ( pass ) && ( i < BG_FLUSH_NUM_GROUPS ); i++ ) {
+
+        HDsnprintf(group_name, sizeof(group_name), "group %d", i);
+
+        group_id = H5Gcreate2(file_id, group_name, H5P_DEFAULT, H5P_DEFAULT,
+                              H5P_DEFAULT);
+
+        if ( ( group_id < 0 ) || ( H5Gclose(group_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Can't create group.\n";
+        }
+    }
+
+#ifdef H5_HAVE_THREADSAFE
+    /* give the background thread some time to catch up */
+    for ( i = 0; ( pass ) && ( i < 10 ) &&
+                 ( cache_ptr->dirty_index_size > trigger ); i++ ) {
+
+        HDsleep(1);
+    }
+#endif /* H5_HAVE_THREADSAFE */
+
+    /* verify that entries were written ahead of need, and that the
+     * dirty part of the cache was kept under the threshold.
+     */
+    if ( pass ) {
+
+        if ( cache_ptr->bg_flushes <= 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "No entries were written ahead of need.\n";
+
+        } else if ( cache_ptr->dirty_index_size > trigger ) {
+
+            pass = FALSE;
+            failure_mssg = "Too much of the cache is dirty.\n";
+        }
+    }
+
+    /* close the file, reopen it, and verify that all the groups are there */
+    if ( pass ) {
+
+        if ( H5Fclose(file_id) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fclose() failed.\n";
+
+        } else if ( ( file_id = H5Fopen(filename, H5F_ACC_RDONLY,
+                                        H5P_DEFAULT) ) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fopen() failed.\n";
+        }
+    }
+
+    for ( i = 0; ( pass ) && ( i < BG_FLUSH_NUM_GROUPS ); i++ ) {
+
+        HDsnprintf(group_name, sizeof(group_name), "group %d", i);
+
+        group_id = H5Gopen2(file_id, group_name, H5P_DEFAULT);
+
+        if ( ( group_id < 0 ) || ( H5Gclose(group_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Can't open group.\n";
+        }
+    }
+
+    /* close the file and delete it */
+    if ( pass ) {
+
+	if ( H5Fclose(file_id) < 0  ) {
+
+            pass = FALSE;
+	    failure_mssg = "H5Fclose() failed.\n";
+
+        } else if ( HDremove(filename) < 0 ) {
+
+            pass = FALSE;
+	    failure_mssg = "HDremove() failed.\n";
+        }
+    }
+
+    if ( fapl_id >= 0 ) {
+
+        if ( H5Pclose(fapl_id) < 0 ) {
+
+            pass = FALSE;
+	    failure_mssg = "H5Pclose() failed.\n";
+        }
+    }
+
+    if ( pass ) { PASSED(); } else { H5_FAILED(); }
+
+    if ( ! pass )
+        HDfprintf(stdout, "%s: failure_mssg = \"%s\".\n",
+                  fcn_name, failure_mssg);
+
+} /* check_mdc_background_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	check_mdc_config_version_1()
+ *
+ * Purpose:	Verify that version 1 instances of H5AC_cache_config_t,
+ *		which predate the replacement_policy field, are still
+ *		accepted by H5P[s|g]et_mdc_config() and
+ *		H5F[s|g]et_mdc_config(), that the cache uses the LRU
+ *		policy for them, and that their replacement_policy field
+ *		is neither read nor written.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static void
+check_mdc_config_version_1(void)
+{
+    const char * fcn_name = "check_mdc_config_version_1()";
+    char filename[512];
+    hid_t fapl_id = -1;
+    hid_t file_id = -1;
+    H5F_t * file_ptr = NULL;
+    H5AC_cache_config_t config;
+    H5AC_cache_config_t v1_config;
+
+    TESTING("MDC version 1 configurations");
+
+    pass = TRUE;
+
+    /* create a FAPL, and select the 2Q policy on it */
+    if ( pass ) {
+
+        config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+
+        if ( ( fapl_id = H5Pcreate(H5P_FILE_ACCESS) ) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Pcreate(H5P_FILE_ACCESS) failed.\n";
+
+        } else if ( H5Pget_mdc_config(fapl_id, &config) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Pget_mdc_config() failed.\n";
+
+        } else {
+
+            config.replacement_policy = H5C_rp__2q;
+
+            if ( H5Pset_mdc_config(fapl_id, &config) < 0 ) {
+
+                pass = FALSE;
+                failure_mssg = "H5Pset_mdc_config() failed.\n";
+            }
+        }
+    }
+
+    /* get the configuration into a version 1 structure, and verify that
+     * its replacement_policy field is left alone.
+     */
+    if ( pass ) {
+
+        HDmemset(&v1_config, 0, sizeof(v1_config));
+        v1_config.version = H5AC__CACHE_CONFIG_VERSION_1;
+        v1_config.replacement_policy = H5C_rp__lru;
+
+        if ( H5Pget_mdc_config(fapl_id, &v1_config) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Pget_mdc_config() failed on version 1.\n";
+
+        } else if ( ( v1_config.version != H5AC__CACHE_CONFIG_VERSION_1 ) ||
+                    ( v1_config.replacement_policy != H5C_rp__lru ) ||
+                    ( v1_config.max_size != config.max_size ) ||
+                    ( v1_config.metadata_write_strategy !=
+                      config.metadata_write_strategy ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected version 1 config from FAPL.\n";
+        }
+    }
+
+    /* set the version 1 structure, with a replacement_policy field which
+     * must be ignored, and verify that the FAPL now selects LRU.
+     */
+    if ( pass ) {
+
+        v1_config.replacement_policy = H5C_rp__2q;
+        config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+
+        if ( H5Pset_mdc_config(fapl_id, &v1_config) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Pset_mdc_config() failed on version 1.\n";
+
+        } else if ( H5Pget_mdc_config(fapl_id, &config) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Pget_mdc_config() failed.\n";
+
+        } else if ( ( config.version != H5AC__CURR_CACHE_CONFIG_VERSION ) ||
+                    ( config.replacement_policy != H5C_rp__lru ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Version 1 config didn't select LRU on FAPL.\n";
+        }
+    }
+
+    /* setup the file name */
+    if ( pass ) {
+
+        if ( h5_fixname(FILENAME[1], H5P_DEFAULT, filename, sizeof(filename))
+            == NULL ) {
+
+            pass = FALSE;
+            failure_mssg = "h5_fixname() failed.\n";
+        }
+    }
+
+    /* create the file, and select the 2Q policy on its cache */
+    if ( pass ) {
+
+        config.replacement_policy = H5C_rp__2q;
+
+        if ( ( file_id = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT,
+                                   fapl_id) ) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fcreate() failed.\n";
+
+        } else if ( NULL == (file_ptr = (H5F_t *)H5I_object_verify(file_id,
+                                                             H5I_FILE)) ) {
+
+            pass = FALSE;
+            failure_mssg = "Can't get file_ptr.\n";
+
+        } else if ( H5Fset_mdc_config(file_id, &config) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fset_mdc_config() failed.\n";
+
+        } else if ( file_ptr->shared->cache->rp_policy != H5C_rp__2q ) {
+
+            pass = FALSE;
+            failure_mssg = "Cache didn't select 2Q.\n";
+        }
+    }
+
+    /* get the file's configuration into a version 1 structure, then set
+     * it back, and verify that the cache now uses LRU.
+     */
+    if ( pass ) {
+
+        v1_config.replacement_policy = H5C_rp__lru;
+
+        if ( H5Fget_mdc_config(file_id, &v1_config) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fget_mdc_config() failed on version 1.\n";
+
+        } else if ( ( v1_config.version != H5AC__CACHE_CONFIG_VERSION_1 ) ||
+                    ( v1_config.replacement_policy != H5C_rp__lru ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected version 1 config from file.\n";
+
+        } else if ( H5Fset_mdc_config(file_id, &v1_config) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fset_mdc_config() failed on version 1.\n";
+
+        } else if ( file_ptr->shared->cache->rp_policy != H5C_rp__lru ) {
+
+            pass = FALSE;
+            failure_mssg = "Version 1 config didn't select LRU on file.\n";
+        }
+    }
+
+    /* close the file and delete it */
+    if ( file_id >= 0 ) {
+
+        if ( H5Fclose(file_id) < 0  ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fclose() failed.\n";
+
+        } else if ( HDremove(filename) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "HDremove() failed.\n";
+        }
+    }
+
+    if ( ( fapl_id >= 0 ) && ( H5Pclose(fapl_id) < 0 ) ) {
+
+        pass = FALSE;
+        failure_mssg = "H5Pclose() failed.\n";
+    }
+
+    if ( pass ) { PASSED(); } else { H5_FAILED(); }
+
+    if ( ! pass )
+        HDfprintf(stdout, "%s: failure_mssg = \"%s\".\n",
+                  fcn_name, failure_mssg);
+
+} /* check_mdc_config_version_1() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	main
@@ -3548,6 +4135,12 @@ main(void)
 #if 1
     check_file_mdc_api_errs();
 #endif
+#if 1
+    check_mdc_background_flush();
+#endif
+#if 1
+    check_mdc_config_version_1();
+#endif
 
     return(0);
 
@@ -445,7 +445,8 @@ if ( ( (cache_ptr) == NULL ) ||                                        \
     ( (a).apply_empty_reserve     == (b).apply_empty_reserve ) &&     \
     ( (a).empty_reserve           == (b).empty_reserve ) &&           \
     ( (a).dirty_bytes_threshold   == (b).dirty_bytes_threshold ) &&   \
-    ( (a).metadata_write_strategy == (b).metadata_write_strategy ) )
+    ( (a).metadata_write_strategy == (b).metadata_write_strategy ) && \
+    ( (a).replacement_policy      == (b).replacement_policy ) )
 
 #define XLATE_EXT_TO_INT_MDC_CONFIG(i, e)                           \
 {                                                                   \
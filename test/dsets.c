@@ -51,6 +51,9 @@ const char *FILENAME[] = {
     "copy_dcpl_newfile",
     "layout_extend",
     "zero_chunk",
+    "async_io",
+    "multi_io",
+    "create_multi",
     NULL
 };
 #define FILENAME_BUF_SIZE       1024
@@ -83,6 +86,8 @@ const char *FILENAME[] = {
 #define DSET_SHUF_SZIP_FLET_NAME	"shuffle+szip+fletcher32"
 #define DSET_SHUF_SZIP_FLET_NAME_2	"shuffle+szip+fletcher32_2"
 #endif /* defined H5_HAVE_FILTER_SZIP && defined H5_HAVE_FILTER_SHUFFLE && defined H5_HAVE_FILTER_FLETCHER32 */
+#define DSET_LZ4_NAME		"lz4"
+#define DSET_SHUF_LZ4_FLET_NAME	"shuffle+lz4+fletcher32"
 
 #define DSET_BOGUS_NAME		"bogus"
 #define DSET_MISSING_NAME	"missing"
@@ -94,6 +99,8 @@ const char *FILENAME[] = {
 #define DSET_SET_LOCAL_NAME	"set_local"
 #define DSET_SET_LOCAL_NAME_2	"set_local_2"
 #define DSET_ONEBYTE_SHUF_NAME	"onebyte_shuffle"
+#define DSET_MULTIBYTE_SHUF_NAME	"multibyte_shuffle"
+#define DSET_LZ4_DATA_NAME	"lz4_data"
 #define DSET_NBIT_INT_NAME             "nbit_int"
 #define DSET_NBIT_FLOAT_NAME           "nbit_float"
 #define DSET_NBIT_DOUBLE_NAME          "nbit_double"
@@ -105,6 +112,7 @@ const char *FILENAME[] = {
 #define DSET_NBIT_FLT_SIZE_NAME        "nbit_flt_size"
 #define DSET_SCALEOFFSET_INT_NAME      "scaleoffset_int"
 #define DSET_SCALEOFFSET_INT_NAME_2    "scaleoffset_int_2"
+#define DSET_SCALEOFFSET_LLONG_NAME    "scaleoffset_llong"
 #define DSET_SCALEOFFSET_FLOAT_NAME    "scaleoffset_float"
 #define DSET_SCALEOFFSET_FLOAT_NAME_2  "scaleoffset_float_2"
 #define DSET_SCALEOFFSET_DOUBLE_NAME   "scaleoffset_double"
@@ -130,6 +138,7 @@ const char *FILENAME[] = {
 #define H5Z_FILTER_DEPREC       309
 #define H5Z_FILTER_EXPAND	310
 #define H5Z_FILTER_CAN_APPLY_TEST2	311
+#define H5Z_FILTER_SHUFFLE_CHECK	312
 
 /* Flags for testing filters */
 #define DISABLE_FLETCHER32      0
@@ -198,11 +207,25 @@ const char *FILENAME[] = {
 #define BYPASS_CHUNK_DIM         500
 #define BYPASS_FILL_VALUE        7
 
+/* Parameters for multi-byte shuffle test */
+#define MULTIBYTE_SHUF_NELMTS       1001
+#define MULTIBYTE_SHUF_MAX_SIZE     16
+
+/* Parameters for LZ4 test */
+#define LZ4_NELMTS              100000
+#define LZ4_SMALL_NELMTS        3
+#define LZ4_BLOCK_SIZE          4096
+
+/* Number of elements for scaleoffset long long test */
+#define SCALEOFFSET_LLONG_NELMTS    1001
+
 /* Shared global arrays */
 #define DSET_DIM1       100
 #define DSET_DIM2       200
 int	points[DSET_DIM1][DSET_DIM2], check[DSET_DIM1][DSET_DIM2];
 double	points_dbl[DSET_DIM1][DSET_DIM2], check_dbl[DSET_DIM1][DSET_DIM2];
+unsigned char shuffle_check_buf[MULTIBYTE_SHUF_NELMTS * MULTIBYTE_SHUF_MAX_SIZE];
+size_t shuffle_check_nbytes;
 
 /* Local prototypes for filter functions */
 static size_t filter_bogus(unsigned int flags, size_t cd_nelmts,
@@ -217,6 +240,8 @@ static size_t filter_corrupt(unsigned int flags, size_t cd_nelmts,
     const unsigned int *cd_values, size_t nbytes, size_t *buf_size, void **buf);
 static size_t filter_expand(unsigned int flags, size_t cd_nelmts,
     const unsigned int *cd_values, size_t nbytes, size_t *buf_size, void **buf);
+static size_t filter_shuffle_check(unsigned int flags, size_t cd_nelmts,
+    const unsigned int *cd_values, size_t nbytes, size_t *buf_size, void **buf);
 
 
 /*-------------------------------------------------------------------------
@@ -2102,7 +2127,11 @@ UNUSED
     hsize_t     shuffle_size;       /* Size of dataset with shuffle filter */
 #endif /* H5_HAVE_FILTER_SHUFFLE */
 
-#if(defined H5_HAVE_FILTER_DEFLATE | defined H5_HAVE_FILTER_SZIP) && defined H5_HAVE_FILTER_SHUFFLE && defined H5_HAVE_FILTER_FLETCHER32
+#ifdef H5_HAVE_FILTER_LZ4
+    hsize_t     lz4_size;       /* Size of dataset with LZ4 filter */
+#endif /* H5_HAVE_FILTER_LZ4 */
+
+#if(defined H5_HAVE_FILTER_DEFLATE | defined H5_HAVE_FILTER_SZIP | defined H5_HAVE_FILTER_LZ4) && defined H5_HAVE_FILTER_SHUFFLE && defined H5_HAVE_FILTER_FLETCHER32
     hsize_t     combo_size;     /* Size of dataset with shuffle+deflate filter */
 #endif /* H5_HAVE_FILTER_DEFLATE && H5_HAVE_FILTER_SHUFFLE && H5_HAVE_FILTER_FLETCHER32 */
 
@@ -2344,6 +2373,52 @@ UNUSED
     SKIPPED();
     puts("    Szip, shuffle, or fletcher32 checksum filter not enabled");
 #endif /* H5_HAVE_FILTER_SZIP && H5_HAVE_FILTER_SHUFFLE && H5_HAVE_FILTER_FLETCHER32 */
+
+    /*----------------------------------------------------------
+     * STEP 7: Test LZ4 compression by itself.
+     *----------------------------------------------------------
+     */
+#ifdef H5_HAVE_FILTER_LZ4
+    puts("Testing lz4 filter");
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+    if(H5Pset_chunk (dc, 2, chunk_size) < 0) goto error;
+    if(H5Pset_lz4 (dc) < 0) goto error;
+
+    if(test_filter_internal(file,DSET_LZ4_NAME,dc,DISABLE_FLETCHER32,DATA_NOT_CORRUPTED,&lz4_size) < 0) goto error;
+    /* Clean up objects used for this test */
+    if(H5Pclose (dc) < 0) goto error;
+#else /* H5_HAVE_FILTER_LZ4 */
+    TESTING("lz4 filter");
+    SKIPPED();
+    puts("    LZ4 filter not enabled");
+#endif /* H5_HAVE_FILTER_LZ4 */
+
+    /*----------------------------------------------------------
+     * STEP 8: Test shuffle + LZ4 + checksum.
+     *----------------------------------------------------------
+     */
+#if defined H5_HAVE_FILTER_LZ4 && defined H5_HAVE_FILTER_SHUFFLE && defined H5_HAVE_FILTER_FLETCHER32
+    puts("Testing shuffle+lz4+checksum filters");
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+    if(H5Pset_chunk (dc, 2, chunk_size) < 0) goto error;
+    if(H5Pset_shuffle (dc) < 0) goto error;
+    if(H5Pset_lz4 (dc) < 0) goto error;
+    if(H5Pset_fletcher32 (dc) < 0) goto error;
+
+    if(test_filter_internal(file,DSET_SHUF_LZ4_FLET_NAME,dc,ENABLE_FLETCHER32,DATA_NOT_CORRUPTED,&combo_size) < 0) goto error;
+    if(combo_size>=null_size) {
+        H5_FAILED();
+        puts("    Shuffled and compressed size not smaller than uncompressed size.");
+        goto error;
+    } /* end if */
+
+    /* Clean up objects used for this test */
+    if(H5Pclose (dc) < 0) goto error;
+#else /* H5_HAVE_FILTER_LZ4 && H5_HAVE_FILTER_SHUFFLE && H5_HAVE_FILTER_FLETCHER32 */
+    TESTING("shuffle+lz4+fletcher32 filters");
+    SKIPPED();
+    puts("    LZ4, shuffle, or fletcher32 checksum filter not enabled");
+#endif /* H5_HAVE_FILTER_LZ4 && H5_HAVE_FILTER_SHUFFLE && H5_HAVE_FILTER_FLETCHER32 */
     return 0;
 
 error:
@@ -2708,6 +2783,381 @@ error:
     return -1;
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	filter_shuffle_check
+ *
+ * Purpose:	A filter which doesn't change the data, but saves a copy of
+ *              the (already shuffled) data it's given when writing, so the
+ *              shuffle filter's output can be checked.
+ *
+ * Return:	Success:	Data chunk size
+ *
+ *		Failure:	0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+filter_shuffle_check(unsigned int flags, size_t UNUSED cd_nelmts,
+      const unsigned int UNUSED *cd_values, size_t nbytes,
+      size_t UNUSED *buf_size, void **buf)
+{
+    if(!(flags & H5Z_FLAG_REVERSE) && nbytes <= sizeof(shuffle_check_buf)) {
+        HDmemcpy(shuffle_check_buf, *buf, nbytes);
+        shuffle_check_nbytes = nbytes;
+    } /* end if */
+
+    return nbytes;
+}
+
+/* This message derives from H5Z */
+const H5Z_class2_t H5Z_SHUFFLE_CHECK[1] = {{
+    H5Z_CLASS_T_VERS,           /* H5Z_class_t version */
+    H5Z_FILTER_SHUFFLE_CHECK,   /* Filter id number		*/
+    1, 1,                       /* Encoding and decoding enabled */
+    "shuffle_check",            /* Filter name for debugging	*/
+    NULL,                       /* The "can apply" callback     */
+    NULL,                       /* The "set local" callback     */
+    filter_shuffle_check,       /* The actual filter function	*/
+}};
+
+
+/*-------------------------------------------------------------------------
+ * Function:	test_multibyte_shuffle
+ *
+ * Purpose:	Tests shuffling elements of 2, 3, 4, 8 & 16 bytes, in a
+ *              chunk whose number of elements isn't a multiple of the
+ *              number [un]shuffled at once with SIMD instructions.  The
+ *              shuffled bytes must be exactly those of the byte-by-byte
+ *              algorithm, and the data must read back unchanged.
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_multibyte_shuffle(hid_t file)
+{
+#ifdef H5_HAVE_FILTER_SHUFFLE
+    hid_t		dataset = -1, space = -1, dc = -1, tid = -1;
+    const hsize_t	size[1] = {MULTIBYTE_SHUF_NELMTS};
+    const size_t        type_size[] = {2, 3, 4, 8, 16};
+    unsigned char       *orig_data = NULL;
+    unsigned char       *new_data = NULL;
+    char                name[32];
+    size_t		i, j, u;
+#else /* H5_HAVE_FILTER_SHUFFLE */
+    const char		*not_supported= "    Data shuffling is not enabled.";
+#endif /* H5_HAVE_FILTER_SHUFFLE */
+
+    TESTING("multi-byte shuffling");
+
+#ifdef H5_HAVE_FILTER_SHUFFLE
+    if(NULL == (orig_data = (unsigned char *)HDmalloc(MULTIBYTE_SHUF_NELMTS * MULTIBYTE_SHUF_MAX_SIZE))) TEST_ERROR
+    if(NULL == (new_data = (unsigned char *)HDmalloc(MULTIBYTE_SHUF_NELMTS * MULTIBYTE_SHUF_MAX_SIZE))) TEST_ERROR
+
+    if(H5Zregister(H5Z_SHUFFLE_CHECK) < 0) FAIL_STACK_ERROR
+
+    /* Create the data space */
+    if((space = H5Screate_simple(1, size, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* Use a single chunk, shuffled and then checked */
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dc, 1, size) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dc) < 0) FAIL_STACK_ERROR
+    if(H5Pset_filter(dc, H5Z_FILTER_SHUFFLE_CHECK, 0, (size_t)0, NULL) < 0) FAIL_STACK_ERROR
+
+    for(u = 0; u < NELMTS(type_size); u++) {
+        size_t nbytes = MULTIBYTE_SHUF_NELMTS * type_size[u];
+
+        for(i = 0; i < nbytes; i++)
+            orig_data[i] = (unsigned char)HDrandom();
+
+        if((tid = H5Tcreate(H5T_OPAQUE, type_size[u])) < 0) FAIL_STACK_ERROR
+        if(H5Tset_tag(tid, "shuffle test") < 0) FAIL_STACK_ERROR
+
+        /* Create the dataset & write the data */
+        HDsnprintf(name, sizeof(name), "%s_%lu", DSET_MULTIBYTE_SHUF_NAME, (unsigned long)type_size[u]);
+        if((dataset = H5Dcreate2(file, name, tid, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        shuffle_check_nbytes = 0;
+        if(H5Dwrite(dataset, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0) FAIL_STACK_ERROR
+
+        /* Check the shuffled bytes against shuffling them one at a time */
+        if(shuffle_check_nbytes != nbytes) TEST_ERROR
+        for(i = 0; i < MULTIBYTE_SHUF_NELMTS; i++)
+            for(j = 0; j < type_size[u]; j++)
+                if(shuffle_check_buf[j * MULTIBYTE_SHUF_NELMTS + i] != orig_data[i * type_size[u] + j]) {
+                    H5_FAILED();
+                    printf("    Wrong shuffled byte for %lu-byte elements.\n", (unsigned long)type_size[u]);
+                    printf("    At element %lu, byte %lu\n", (unsigned long)i, (unsigned long)j);
+                    goto error;
+                } /* end if */
+
+        /* Read the dataset back & check the values are the same as written */
+        if(H5Dclose(dataset) < 0) FAIL_STACK_ERROR
+        if((dataset = H5Dopen2(file, name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dataset, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0) FAIL_STACK_ERROR
+        if(HDmemcmp(orig_data, new_data, nbytes)) {
+            H5_FAILED();
+            printf("    Read different values than written for %lu-byte elements.\n", (unsigned long)type_size[u]);
+            goto error;
+        } /* end if */
+
+        if(H5Dclose(dataset) < 0) FAIL_STACK_ERROR
+        if(H5Tclose(tid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Cleanup */
+    if(H5Pclose(dc) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(space) < 0) FAIL_STACK_ERROR
+    if(H5Zunregister(H5Z_FILTER_SHUFFLE_CHECK) < 0) FAIL_STACK_ERROR
+    HDfree(orig_data);
+    HDfree(new_data);
+
+    PASSED();
+#else
+    SKIPPED();
+    puts(not_supported);
+#endif
+
+    return 0;
+
+#ifdef H5_HAVE_FILTER_SHUFFLE
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Tclose(tid);
+        H5Pclose(dc);
+        H5Sclose(space);
+        H5Zunregister(H5Z_FILTER_SHUFFLE_CHECK);
+    } H5E_END_TRY;
+    if(orig_data)
+        HDfree(orig_data);
+    if(new_data)
+        HDfree(new_data);
+
+    return -1;
+#endif /* H5_HAVE_FILTER_SHUFFLE */
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	test_lz4
+ *
+ * Purpose:	Tests the LZ4 filter with data which compresses well,
+ *              including long runs and overlapping matches, with
+ *              random data which doesn't compress at all, and with a
+ *              chunk too small to compress.  The data must read back
+ *              unchanged, and only the compressible data may shrink.
+ *
+ *              Then checks that a chunk split into blocks is stored in
+ *              the format of the registered LZ4 filter (ID 32004): the
+ *              big-endian uncompressed and block sizes, then each block
+ *              after its big-endian stored size, with a block which
+ *              doesn't compress stored as-is.
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_lz4(hid_t file)
+{
+#ifdef H5_HAVE_FILTER_LZ4
+    hid_t		dataset = -1, space = -1, dc = -1;
+    hid_t               mem_fapl = -1, mem_file = -1;
+    const size_t        nelmts[] = {LZ4_NELMTS, LZ4_NELMTS, LZ4_NELMTS, LZ4_SMALL_NELMTS};
+    const unsigned      block_size = LZ4_BLOCK_SIZE;
+    unsigned char       header[12];
+    unsigned char       *orig_data = NULL;
+    unsigned char       *new_data = NULL;
+    unsigned char       *image = NULL;
+    const unsigned char *chunk, *p;
+    ssize_t             image_size;
+    hsize_t             size[1];
+    hsize_t             storage_size;
+    char                name[32];
+    size_t		i;
+    unsigned            u;
+#else /* H5_HAVE_FILTER_LZ4 */
+    const char		*not_supported= "    LZ4 compression is not enabled.";
+#endif /* H5_HAVE_FILTER_LZ4 */
+
+    TESTING("lz4 compression");
+
+#ifdef H5_HAVE_FILTER_LZ4
+    if(NULL == (orig_data = (unsigned char *)HDmalloc(LZ4_NELMTS))) TEST_ERROR
+    if(NULL == (new_data = (unsigned char *)HDmalloc(LZ4_NELMTS))) TEST_ERROR
+
+    for(u = 0; u < NELMTS(nelmts); u++) {
+        /* Set up the data for each case */
+        switch(u) {
+            case 0:
+                /* Repeated phrases, with a change every so often */
+                for(i = 0; i < nelmts[u]; i++)
+                    orig_data[i] = (unsigned char)((i % 4099) == 0 ? HDrandom() : "lz4 test data "[i % 14]);
+                break;
+
+            case 1:
+                /* Long runs of a single byte, which are overlapping matches */
+                for(i = 0; i < nelmts[u]; i++)
+                    orig_data[i] = (unsigned char)(i / 10000);
+                break;
+
+            case 2:
+            case 3:
+            default:
+                /* Data that won't compress */
+                for(i = 0; i < nelmts[u]; i++)
+                    orig_data[i] = (unsigned char)HDrandom();
+                break;
+        } /* end switch */
+
+        /* Use a single chunk for each dataset */
+        size[0] = nelmts[u];
+        if((space = H5Screate_simple(1, size, NULL)) < 0) FAIL_STACK_ERROR
+        if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+        if(H5Pset_chunk(dc, 1, size) < 0) FAIL_STACK_ERROR
+        if(H5Pset_lz4(dc) < 0) FAIL_STACK_ERROR
+
+        /* Create the dataset & write the data */
+        HDsnprintf(name, sizeof(name), "%s_%u", DSET_LZ4_DATA_NAME, u);
+        if((dataset = H5Dcreate2(file, name, H5T_NATIVE_UCHAR, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dataset, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0) FAIL_STACK_ERROR
+
+        /* Only data which compresses may be stored with the filter */
+        if(H5Dclose(dataset) < 0) FAIL_STACK_ERROR
+        if((dataset = H5Dopen2(file, name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        storage_size = H5Dget_storage_size(dataset);
+        if(u < 2 ? storage_size >= nelmts[u] / 4 : storage_size != nelmts[u]) {
+            H5_FAILED();
+            printf("    Wrong storage size %lu for case %u.\n", (unsigned long)storage_size, u);
+            goto error;
+        } /* end if */
+
+        /* Read the dataset back & check the values are the same as written */
+        if(H5Dread(dataset, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0) FAIL_STACK_ERROR
+        if(HDmemcmp(orig_data, new_data, nelmts[u])) {
+            H5_FAILED();
+            printf("    Read different values than written for case %u.\n", u);
+            goto error;
+        } /* end if */
+
+        if(H5Dclose(dataset) < 0) FAIL_STACK_ERROR
+        if(H5Pclose(dc) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(space) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Write compressible data in blocks, with one block which doesn't
+     * compress, to an in-memory file */
+    for(i = 0; i < LZ4_NELMTS; i++)
+        orig_data[i] = (unsigned char)(i / LZ4_BLOCK_SIZE == 1 ? HDrandom() : "lz4 test data "[i % 14]);
+    size[0] = LZ4_NELMTS;
+    if((mem_fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fapl_core(mem_fapl, (size_t)(1024 * 1024), FALSE) < 0) FAIL_STACK_ERROR
+    if((mem_file = H5Fcreate("lz4_image", H5F_ACC_TRUNC, H5P_DEFAULT, mem_fapl)) < 0) FAIL_STACK_ERROR
+    if((space = H5Screate_simple(1, size, NULL)) < 0) FAIL_STACK_ERROR
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dc, 1, size) < 0) FAIL_STACK_ERROR
+    if(H5Pset_filter(dc, H5Z_FILTER_LZ4, H5Z_FLAG_OPTIONAL, (size_t)1, &block_size) < 0) FAIL_STACK_ERROR
+    if((dataset = H5Dcreate2(mem_file, DSET_LZ4_DATA_NAME, H5T_NATIVE_UCHAR, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dataset, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0) FAIL_STACK_ERROR
+    if(H5Fflush(mem_file, H5F_SCOPE_GLOBAL) < 0) FAIL_STACK_ERROR
+    storage_size = H5Dget_storage_size(dataset);
+
+    /* Find the chunk in the file image, by its header */
+    if((image_size = H5Fget_file_image(mem_file, NULL, (size_t)0)) < 0) FAIL_STACK_ERROR
+    if(NULL == (image = (unsigned char *)HDmalloc((size_t)image_size))) TEST_ERROR
+    if(H5Fget_file_image(mem_file, image, (size_t)image_size) != image_size) FAIL_STACK_ERROR
+    for(i = 0; i < 8; i++)
+        header[i] = (unsigned char)((uint64_t)LZ4_NELMTS >> (8 * (7 - i)));
+    for(i = 0; i < 4; i++)
+        header[8 + i] = (unsigned char)(LZ4_BLOCK_SIZE >> (8 * (3 - i)));
+    for(chunk = image; chunk + sizeof(header) <= image + image_size; chunk++)
+        if(0 == HDmemcmp(chunk, header, sizeof(header)))
+            break;
+    if(chunk + sizeof(header) > image + image_size) {
+        H5_FAILED();
+        puts("    Chunk header not found in file image.");
+        goto error;
+    } /* end if */
+
+    /* Walk the blocks: each may be no larger than its uncompressed size,
+     * and the block which doesn't compress is stored as-is */
+    p = chunk + sizeof(header);
+    for(i = 0; i < LZ4_NELMTS; i += LZ4_BLOCK_SIZE) {
+        size_t this_size = MIN(LZ4_BLOCK_SIZE, LZ4_NELMTS - i);
+        size_t stored_size = ((size_t)p[0] << 24) | ((size_t)p[1] << 16) | ((size_t)p[2] << 8) | (size_t)p[3];
+
+        if(stored_size > this_size || (i / LZ4_BLOCK_SIZE == 1) != (stored_size == this_size)) {
+            H5_FAILED();
+            printf("    Wrong stored size %lu for block at %lu.\n", (unsigned long)stored_size, (unsigned long)i);
+            goto error;
+        } /* end if */
+        if(i / LZ4_BLOCK_SIZE == 1 && HDmemcmp(p + 4, orig_data + i, this_size)) {
+            H5_FAILED();
+            puts("    Uncompressed block not stored as-is.");
+            goto error;
+        } /* end if */
+        p += 4 + stored_size;
+    } /* end for */
+    if((hsize_t)(p - chunk) != storage_size) {
+        H5_FAILED();
+        printf("    Blocks don't add up to storage size %lu.\n", (unsigned long)storage_size);
+        goto error;
+    } /* end if */
+
+    /* Read the dataset back & check the values are the same as written */
+    if(H5Dread(dataset, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(orig_data, new_data, (size_t)LZ4_NELMTS)) {
+        H5_FAILED();
+        puts("    Read different values than written in blocks.");
+        goto error;
+    } /* end if */
+
+    if(H5Dclose(dataset) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dc) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(space) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(mem_file) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(mem_fapl) < 0) FAIL_STACK_ERROR
+
+    /* Cleanup */
+    HDfree(orig_data);
+    HDfree(new_data);
+    HDfree(image);
+
+    PASSED();
+#else
+    SKIPPED();
+    puts(not_supported);
+#endif
+
+    return 0;
+
+#ifdef H5_HAVE_FILTER_LZ4
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Pclose(dc);
+        H5Sclose(space);
+        H5Fclose(mem_file);
+        H5Pclose(mem_fapl);
+    } H5E_END_TRY;
+    if(orig_data)
+        HDfree(orig_data);
+    if(new_data)
+        HDfree(new_data);
+    if(image)
+        HDfree(image);
+
+    return -1;
+#endif /* H5_HAVE_FILTER_LZ4 */
+}
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_nbit_int
@@ -4596,6 +5046,94 @@ error:
     return -1;
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_scaleoffset_long_long
+ *
+ * Purpose:     Tests the long long datatype for scaleoffset filter, with
+ *              values spread so widely that more than 32 bits are needed
+ *              for each of them
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_scaleoffset_long_long(hid_t file)
+{
+#ifdef H5_HAVE_FILTER_SCALEOFFSET
+    hid_t               dataset, datatype, space, dc;
+    const hsize_t       size[1] = {SCALEOFFSET_LLONG_NELMTS};
+    long long           orig_data[SCALEOFFSET_LLONG_NELMTS];
+    long long           new_data[SCALEOFFSET_LLONG_NELMTS];
+    size_t              i;
+#else /* H5_HAVE_FILTER_SCALEOFFSET */
+    const char          *not_supported= "    Scaleoffset is not enabled.";
+#endif /* H5_HAVE_FILTER_SCALEOFFSET */
+
+    TESTING("    scaleoffset long long with more than 32 bits");
+#ifdef H5_HAVE_FILTER_SCALEOFFSET
+    datatype = H5Tcopy(H5T_NATIVE_LLONG);
+
+    /* Set order of dataset datatype */
+    if(H5Tset_order(datatype, H5T_ORDER_BE) < 0) goto error;
+
+    /* Create the data space */
+    if((space = H5Screate_simple(1, size, NULL)) < 0) goto error;
+
+    /* Set up to use scaleoffset filter, let library calculate minbits */
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+    if(H5Pset_fill_value(dc, datatype, NULL) < 0) goto error;
+    if(H5Pset_chunk(dc, 1, size) < 0) goto error;
+    if(H5Pset_scaleoffset(dc, H5Z_SO_INT, H5Z_SO_INT_MINBITS_DEFAULT) < 0) goto error;
+
+    /* Create the dataset */
+    if((dataset = H5Dcreate2(file, DSET_SCALEOFFSET_LLONG_NAME, datatype,
+                             space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0) goto error;
+
+    /* Initialize data, between about -2^40 and 2^40 */
+    for(i = 0; i < (size_t)size[0]; i++) {
+        orig_data[i] = ((long long)HDrandom() << 20) ^ (long long)HDrandom();
+        orig_data[i] %= (long long)1 << 40;
+        if(i % 2)
+            orig_data[i] = -orig_data[i];
+    }
+
+    if(H5Dwrite(dataset, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                 orig_data) < 0) goto error;
+
+    /* Read the dataset back */
+    if(H5Dclose(dataset) < 0) goto error;
+    if((dataset = H5Dopen2(file, DSET_SCALEOFFSET_LLONG_NAME, H5P_DEFAULT)) < 0) goto error;
+    if(H5Dread(dataset, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                new_data) < 0) goto error;
+
+    /* Check that the values read are the same as the values written */
+    for(i = 0; i < (size_t)size[0]; i++)
+        if(new_data[i] != orig_data[i]) {
+            H5_FAILED();
+            printf("    Read different values than written.\n");
+            printf("    At index %lu\n", (unsigned long)i);
+            goto error;
+        }
+
+    if(H5Tclose(datatype) < 0) goto error;
+    if(H5Pclose(dc) < 0) goto error;
+    if(H5Sclose(space) < 0) goto error;
+    if(H5Dclose(dataset) < 0) goto error;
+
+    PASSED();
+#else
+    SKIPPED();
+    puts(not_supported);
+#endif
+    return 0;
+error:
+    return -1;
+}
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_scaleoffset_float
@@ -8265,6 +8803,629 @@ error:
     return -1;
 } /* end test_zero_dim_dset() */
 
+
+/*-------------------------------------------------------------------------
+ * Function: test_async_io
+ *
+ * Purpose:     Tests asynchronous dataset I/O requests: the dataspaces
+ *              and transfer property list are captured when a request is
+ *              made, requests complete in order, synchronous reads see
+ *              the writes requested before them, and the request status
+ *              routines behave.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define ASYNC_IO_NBLOCKS        8
+#define ASYNC_IO_BLOCK          16
+static herr_t
+test_async_io(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       sid = -1;       /* File dataspace ID */
+    hid_t       msid = -1;      /* Memory dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hid_t       req[ASYNC_IO_NBLOCKS];  /* Request IDs */
+    hid_t       bad_req;        /* Request ID expected to be invalid */
+    H5D_request_status_t status;        /* Request status */
+    hsize_t     dim, chunk_dim; /* Dataset and chunk dimensions */
+    hsize_t     start, count;   /* Hyperslab parameters */
+    int         wbuf[ASYNC_IO_NBLOCKS][ASYNC_IO_BLOCK];
+    int         rbuf[ASYNC_IO_NBLOCKS * ASYNC_IO_BLOCK];
+    herr_t      ret;
+    unsigned    u, v;
+
+    TESTING("asynchronous dataset I/O");
+
+    for(u = 0; u < ASYNC_IO_NBLOCKS; u++)
+        req[u] = -1;
+    for(u = 0; u < ASYNC_IO_NBLOCKS; u++)
+        for(v = 0; v < ASYNC_IO_BLOCK; v++)
+            wbuf[u][v] = (int)(u * ASYNC_IO_BLOCK + v);
+
+    h5_fixname(FILENAME[14], fapl, filename, sizeof filename);
+
+    /* Create file */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+
+    /* Create chunked dataset, one chunk per block */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    chunk_dim = ASYNC_IO_BLOCK;
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    dim = ASYNC_IO_NBLOCKS * ASYNC_IO_BLOCK;
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    count = ASYNC_IO_BLOCK;
+    if((msid = H5Screate_simple(1, &count, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* Write each block, moving the file selection before the previous
+     * requests have necessarily run */
+    for(u = 0; u < ASYNC_IO_NBLOCKS; u++) {
+        start = u * ASYNC_IO_BLOCK;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+        if((req[u] = H5Dwrite_async(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf[u])) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Overwrite the first block; it must land after the first write */
+    if(H5Drequest_wait(req[0], &status) < 0) FAIL_STACK_ERROR
+    if(status != H5D_REQUEST_SUCCEEDED) TEST_ERROR
+    if(H5Drequest_close(req[0]) < 0) FAIL_STACK_ERROR
+    start = 0;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+    if((req[0] = H5Dwrite_async(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf[ASYNC_IO_NBLOCKS - 1])) < 0)
+        FAIL_STACK_ERROR
+
+    /* Wait for all the writes */
+    for(u = 0; u < ASYNC_IO_NBLOCKS; u++) {
+        if(H5Drequest_wait(req[u], &status) < 0) FAIL_STACK_ERROR
+        if(status != H5D_REQUEST_SUCCEEDED) TEST_ERROR
+        if(H5Drequest_test(req[u], &status) < 0) FAIL_STACK_ERROR
+        if(status != H5D_REQUEST_SUCCEEDED) TEST_ERROR
+
+        /* Completed requests can't be canceled */
+        if(H5Drequest_cancel(req[u], &status) < 0) FAIL_STACK_ERROR
+        if(status != H5D_REQUEST_SUCCEEDED) TEST_ERROR
+        if(H5Drequest_close(req[u]) < 0) FAIL_STACK_ERROR
+        req[u] = -1;
+    } /* end for */
+
+    /* Read the whole dataset back, closing the dataset while the request
+     * may still be pending */
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if((req[0] = H5Dread_async(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+    if(H5Drequest_wait(req[0], NULL) < 0) FAIL_STACK_ERROR
+    if(H5Drequest_close(req[0]) < 0) FAIL_STACK_ERROR
+    req[0] = -1;
+
+    /* Verify the data */
+    for(v = 0; v < ASYNC_IO_BLOCK; v++)
+        if(rbuf[v] != wbuf[ASYNC_IO_NBLOCKS - 1][v]) TEST_ERROR
+    for(u = 1; u < ASYNC_IO_NBLOCKS; u++)
+        for(v = 0; v < ASYNC_IO_BLOCK; v++)
+            if(rbuf[u * ASYNC_IO_BLOCK + v] != wbuf[u][v]) TEST_ERROR
+
+    /* A failing request reports its failure through the status */
+    if((dsid = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    start = ASYNC_IO_NBLOCKS * ASYNC_IO_BLOCK - 1;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        bad_req = H5Dread_async(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf);
+    } H5E_END_TRY;
+    if(bad_req >= 0) {
+        H5_FAILED();
+        printf("    Line %d: Request with invalid selection was accepted\n", __LINE__);
+        goto error;
+    } /* end if */
+    if((req[0] = H5Dread_async(dsid, H5T_NATIVE_INT, msid, H5S_ALL, H5P_DEFAULT, rbuf)) < 0)
+        FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Drequest_wait(req[0], &status);
+    } H5E_END_TRY;
+    if(ret >= 0 || status != H5D_REQUEST_FAILED) TEST_ERROR
+    if(H5Drequest_close(req[0]) < 0) FAIL_STACK_ERROR
+    req[0] = -1;
+
+    /* A synchronous read sees the writes requested before it */
+    for(u = 0; u < ASYNC_IO_NBLOCKS; u++) {
+        for(v = 0; v < ASYNC_IO_BLOCK; v++)
+            wbuf[u][v] = -wbuf[u][v] - 1;
+        start = u * ASYNC_IO_BLOCK;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+        if((req[u] = H5Dwrite_async(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf[u])) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < ASYNC_IO_NBLOCKS; u++)
+        for(v = 0; v < ASYNC_IO_BLOCK; v++)
+            if(rbuf[u * ASYNC_IO_BLOCK + v] != wbuf[u][v]) TEST_ERROR
+    for(u = 0; u < ASYNC_IO_NBLOCKS; u++) {
+        if(H5Drequest_test(req[u], &status) < 0) FAIL_STACK_ERROR
+        if(status != H5D_REQUEST_SUCCEEDED) TEST_ERROR
+        if(H5Drequest_close(req[u]) < 0) FAIL_STACK_ERROR
+        req[u] = -1;
+    } /* end for */
+
+    /* Close everything */
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        for(u = 0; u < ASYNC_IO_NBLOCKS; u++)
+            if(req[u] >= 0) {
+                H5Drequest_wait(req[u], NULL);
+                H5Drequest_close(req[u]);
+            } /* end if */
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_async_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_multi_io
+ *
+ * Purpose: Tests reading and writing several datasets with one call,
+ *          mixing datasets whose transfers are combined (contiguous,
+ *          no conversion) with ones transferred on their own (chunked,
+ *          converted, unallocated).
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *-------------------------------------------------------------------------
+ */
+#define MULTI_IO_NDSETS         5
+#define MULTI_IO_DIM            64
+static herr_t
+test_multi_io(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       hsid = -1;      /* Dataspace ID with strided selection */
+    hid_t       msid = -1;      /* Memory dataspace ID for strided selection */
+    hid_t       dsid[MULTI_IO_NDSETS];  /* Dataset IDs */
+    hid_t       mtid[MULTI_IO_NDSETS];  /* Memory datatype IDs */
+    hid_t       mem_sid[MULTI_IO_NDSETS];       /* Memory dataspace IDs */
+    hid_t       file_sid[MULTI_IO_NDSETS];      /* File dataspace IDs */
+    hid_t       odsid[3];       /* Dataset IDs for overlapping writes */
+    hid_t       omtid[3];       /* Memory datatype IDs for overlapping writes */
+    const void  *wbufs[MULTI_IO_NDSETS];        /* Write buffers */
+    void        *rbufs[MULTI_IO_NDSETS];        /* Read buffers */
+    hsize_t     dim, chunk_dim; /* Dataset and chunk dimensions */
+    hsize_t     start, stride, count;   /* Hyperslab parameters */
+    int         fill = 7;       /* Fill value */
+    int         wbuf[3][MULTI_IO_DIM];
+    int         rbuf[MULTI_IO_NDSETS][MULTI_IO_DIM];
+    short       swbuf[MULTI_IO_DIM];
+    short       srbuf[MULTI_IO_DIM];
+    herr_t      ret;
+    unsigned    u, v;
+
+    TESTING("multi-dataset I/O");
+
+    for(u = 0; u < MULTI_IO_NDSETS; u++)
+        dsid[u] = -1;
+    for(u = 0; u < 3; u++)
+        for(v = 0; v < MULTI_IO_DIM; v++)
+            wbuf[u][v] = (int)(u * 1000 + v);
+    for(v = 0; v < MULTI_IO_DIM; v++)
+        swbuf[v] = (short)(v * 3);
+
+    h5_fixname(FILENAME[15], fapl, filename, sizeof filename);
+
+    /* Create file */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+
+    /* Create the datasets: three contiguous, one chunked and one contiguous
+     * with a fill value which is never written */
+    dim = MULTI_IO_DIM;
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+    if((dsid[0] = H5Dcreate2(fid, "contig0", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if((dsid[1] = H5Dcreate2(fid, "contig1", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if((dsid[2] = H5Dcreate2(fid, "contig2", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if((dsid[4] = H5Dcreate2(fid, "unwritten", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    chunk_dim = MULTI_IO_DIM / 4;
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if((dsid[3] = H5Dcreate2(fid, "chunked", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+
+    /* Every other element of "contig1" comes from the front of the buffer */
+    if((hsid = H5Scopy(sid)) < 0) FAIL_STACK_ERROR
+    start = 0;
+    stride = 2;
+    count = MULTI_IO_DIM / 2;
+    if(H5Sselect_hyperslab(hsid, H5S_SELECT_SET, &start, &stride, &count, NULL) < 0) FAIL_STACK_ERROR
+    if((msid = H5Scopy(sid)) < 0) FAIL_STACK_ERROR
+    if(H5Sselect_hyperslab(msid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+
+    /* Write the first four datasets, "contig2" from shorts */
+    for(u = 0; u < MULTI_IO_NDSETS; u++) {
+        mtid[u] = H5T_NATIVE_INT;
+        mem_sid[u] = H5S_ALL;
+        file_sid[u] = H5S_ALL;
+    } /* end for */
+    mem_sid[1] = msid;
+    file_sid[1] = hsid;
+    mtid[2] = H5T_NATIVE_SHORT;
+    wbufs[0] = wbuf[0];
+    wbufs[1] = wbuf[1];
+    wbufs[2] = swbuf;
+    wbufs[3] = wbuf[2];
+    if(H5Dwrite_multi((size_t)4, dsid, mtid, mem_sid, file_sid, H5P_DEFAULT, wbufs) < 0)
+        FAIL_STACK_ERROR
+
+    /* Write "contig0" three times in one call, once through a type
+     * conversion; the writes take effect in array order, so the last wins */
+    for(u = 0; u < 3; u++)
+        odsid[u] = dsid[0];
+    omtid[0] = H5T_NATIVE_INT;
+    omtid[1] = H5T_NATIVE_SHORT;
+    omtid[2] = H5T_NATIVE_INT;
+    wbufs[0] = wbuf[2];
+    wbufs[1] = swbuf;
+    wbufs[2] = wbuf[0];
+    if(H5Dwrite_multi((size_t)3, odsid, omtid, mem_sid, file_sid, H5P_DEFAULT, wbufs) < 0)
+        FAIL_STACK_ERROR
+
+    /* Close and reopen the file, to read from storage */
+    for(u = 0; u < MULTI_IO_NDSETS; u++) {
+        if(H5Dclose(dsid[u]) < 0) FAIL_STACK_ERROR
+        dsid[u] = -1;
+    } /* end for */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    if((dsid[0] = H5Dopen2(fid, "contig0", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if((dsid[1] = H5Dopen2(fid, "contig1", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if((dsid[2] = H5Dopen2(fid, "contig2", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if((dsid[3] = H5Dopen2(fid, "chunked", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if((dsid[4] = H5Dopen2(fid, "unwritten", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+
+    /* Read all the datasets, in a different order than the file's */
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    HDmemset(srbuf, 0, sizeof(srbuf));
+    mem_sid[1] = H5S_ALL;
+    file_sid[1] = H5S_ALL;
+    for(u = 0; u < MULTI_IO_NDSETS; u++)
+        rbufs[u] = rbuf[u];
+    rbufs[2] = srbuf;
+    if(H5Dread_multi((size_t)MULTI_IO_NDSETS, dsid, mtid, mem_sid, file_sid, H5P_DEFAULT, rbufs) < 0)
+        FAIL_STACK_ERROR
+
+    /* Verify the data */
+    for(v = 0; v < MULTI_IO_DIM; v++) {
+        if(rbuf[0][v] != wbuf[0][v]) TEST_ERROR
+        if(rbuf[1][v] != ((v % 2) ? fill : wbuf[1][v / 2])) TEST_ERROR
+        if(srbuf[v] != swbuf[v]) TEST_ERROR
+        if(rbuf[3][v] != wbuf[2][v]) TEST_ERROR
+        if(rbuf[4][v] != fill) TEST_ERROR
+    } /* end for */
+
+    /* Read the strided selection back into the front of the buffer */
+    HDmemset(rbuf[1], 0, sizeof(rbuf[1]));
+    mem_sid[0] = msid;
+    file_sid[0] = hsid;
+    rbufs[0] = rbuf[1];
+    if(H5Dread_multi((size_t)1, &dsid[1], mtid, mem_sid, file_sid, H5P_DEFAULT, rbufs) < 0)
+        FAIL_STACK_ERROR
+    for(v = 0; v < MULTI_IO_DIM / 2; v++)
+        if(rbuf[1][v] != wbuf[1][v]) TEST_ERROR
+    for(; v < MULTI_IO_DIM; v++)
+        if(rbuf[1][v] != 0) TEST_ERROR
+
+    /* An empty transfer does nothing, a missing array is an error */
+    if(H5Dread_multi((size_t)0, NULL, NULL, NULL, NULL, H5P_DEFAULT, NULL) < 0) FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dread_multi((size_t)1, dsid, mtid, NULL, file_sid, H5P_DEFAULT, rbufs);
+    } H5E_END_TRY;
+    if(ret >= 0) {
+        H5_FAILED();
+        printf("    Line %d: Read with no memory dataspace array succeeded\n", __LINE__);
+        goto error;
+    } /* end if */
+
+    /* Close everything */
+    for(u = 0; u < MULTI_IO_NDSETS; u++)
+        if(H5Dclose(dsid[u]) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(hsid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        for(u = 0; u < MULTI_IO_NDSETS; u++)
+            H5Dclose(dsid[u]);
+        H5Pclose(dcpl);
+        H5Sclose(msid);
+        H5Sclose(hsid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_multi_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_create_multi
+ *
+ * Purpose: Tests creating many datasets like each other with one call,
+ *          in batches from a template dataset, and with paths, compact
+ *          storage, a committed datatype or shared messages.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *-------------------------------------------------------------------------
+ */
+#define CREATE_MULTI_NDSETS     300
+#define CREATE_MULTI_DIM        20
+static herr_t
+test_create_multi(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       fcpl = -1;      /* File creation property list ID */
+    hid_t       gid = -1;       /* Group ID */
+    hid_t       tid = -1;       /* Committed datatype ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dcpl2 = -1;     /* Dataset creation property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hid_t       dsids[4];       /* Dataset IDs */
+    char        name_buf[CREATE_MULTI_NDSETS][8];       /* Buffers for dataset names */
+    const char  *names[CREATE_MULTI_NDSETS];    /* Dataset names */
+    char        path[32];       /* Path of dataset */
+    H5G_info_t  ginfo;          /* Group info */
+    H5O_info_t  oinfo;          /* Object info */
+    hsize_t     dim, chunk_dim; /* Dataset and chunk dimensions */
+    int         fill = 42;      /* Fill value */
+    int         fill_out;       /* Fill value read back */
+    int         wbuf[CREATE_MULTI_DIM];
+    int         rbuf[CREATE_MULTI_DIM];
+    herr_t      ret;
+    unsigned    u, v;
+
+    TESTING("creating many datasets at once");
+
+    for(u = 0; u < 4; u++)
+        dsids[u] = -1;
+    for(v = 0; v < CREATE_MULTI_DIM; v++)
+        wbuf[v] = (int)(v * 3);
+
+    h5_fixname(FILENAME[16], fapl, filename, sizeof filename);
+
+    /* Create file */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+
+    dim = CREATE_MULTI_DIM;
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    chunk_dim = CREATE_MULTI_DIM / 4;
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+
+    /* Create enough chunked datasets in a group for more than one batch,
+     * with the names in reverse order, without opening them */
+    if((gid = H5Gcreate2(fid, "many", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < CREATE_MULTI_NDSETS; u++) {
+        HDsnprintf(name_buf[u], sizeof(name_buf[u]), "d%03u", CREATE_MULTI_NDSETS - 1 - u);
+        names[u] = name_buf[u];
+    } /* end for */
+    if(H5Dcreate_multi(gid, (size_t)CREATE_MULTI_NDSETS, names, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT, NULL) < 0)
+        FAIL_STACK_ERROR
+
+    /* An empty list does nothing */
+    if(H5Dcreate_multi(gid, (size_t)0, NULL, H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT, NULL) < 0)
+        FAIL_STACK_ERROR
+
+    /* Duplicate names are an error, and nothing is created */
+    names[0] = "x0";
+    names[1] = "x1";
+    names[2] = "x0";
+    H5E_BEGIN_TRY {
+        ret = H5Dcreate_multi(gid, (size_t)3, names, H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT, NULL);
+    } H5E_END_TRY;
+    if(ret >= 0) {
+        H5_FAILED();
+        printf("    Line %d: Creating datasets with duplicate names succeeded\n", __LINE__);
+        goto error;
+    } /* end if */
+    if(H5Lexists(gid, "x0", H5P_DEFAULT) != FALSE) TEST_ERROR
+    if(H5Lexists(gid, "x1", H5P_DEFAULT) != FALSE) TEST_ERROR
+
+    /* An existing name is an error, and none of the datasets is created */
+    names[0] = "a0";
+    names[1] = "a1";
+    names[2] = "d150";
+    H5E_BEGIN_TRY {
+        ret = H5Dcreate_multi(gid, (size_t)3, names, H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT, NULL);
+    } H5E_END_TRY;
+    if(ret >= 0) {
+        H5_FAILED();
+        printf("    Line %d: Creating datasets with an existing name succeeded\n", __LINE__);
+        goto error;
+    } /* end if */
+    if(H5Lexists(gid, "a0", H5P_DEFAULT) != FALSE) TEST_ERROR
+    if(H5Lexists(gid, "a1", H5P_DEFAULT) != FALSE) TEST_ERROR
+    if(H5Gclose(gid) < 0) FAIL_STACK_ERROR
+    gid = -1;
+
+    /* Create datasets with compact storage, with a committed datatype and
+     * with one named by a path, and get their IDs back */
+    if((tid = H5Tcopy(H5T_NATIVE_INT)) < 0) FAIL_STACK_ERROR
+    if(H5Tcommit2(fid, "type", tid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    if((dcpl2 = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_layout(dcpl2, H5D_COMPACT) < 0) FAIL_STACK_ERROR
+    names[0] = "c2";
+    names[1] = "c0";
+    names[2] = "c1";
+    if(H5Dcreate_multi(fid, (size_t)3, names, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl2, H5P_DEFAULT, dsids) < 0)
+        FAIL_STACK_ERROR
+    for(u = 0; u < 3; u++) {
+        if(H5Iget_name(dsids[u], path, sizeof(path)) < 0) FAIL_STACK_ERROR
+        if(HDstrcmp(path + 1, names[u])) TEST_ERROR
+        if(H5Dclose(dsids[u]) < 0) FAIL_STACK_ERROR
+        dsids[u] = -1;
+    } /* end for */
+    names[0] = "t1";
+    names[1] = "many/t3";
+    names[2] = "t2";
+    names[3] = "t0";
+    if(H5Dcreate_multi(fid, (size_t)4, names, tid, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT, dsids) < 0)
+        FAIL_STACK_ERROR
+    for(u = 0; u < 4; u++) {
+        if(H5Iget_name(dsids[u], path, sizeof(path)) < 0) FAIL_STACK_ERROR
+        if(HDstrcmp(path + 1, names[u])) TEST_ERROR
+    } /* end for */
+    if(H5Dwrite(dsids[2], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < 4; u++) {
+        if(H5Dclose(dsids[u]) < 0) FAIL_STACK_ERROR
+        dsids[u] = -1;
+    } /* end for */
+    if(H5Oget_info(tid, &oinfo) < 0) FAIL_STACK_ERROR
+    if(oinfo.rc != 5) TEST_ERROR
+    if(H5Tclose(tid) < 0) FAIL_STACK_ERROR
+    tid = -1;
+
+    /* Close and reopen the file, to check the datasets in storage */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+
+    if(H5Gget_info_by_name(fid, "many", &ginfo, H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    if(ginfo.nlinks != CREATE_MULTI_NDSETS + 1) TEST_ERROR
+    for(u = 0; u < CREATE_MULTI_NDSETS; u++) {
+        HDsnprintf(path, sizeof(path), "many/d%03u", u);
+        if((dsid = H5Dopen2(fid, path, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Oget_info(dsid, &oinfo) < 0) FAIL_STACK_ERROR
+        if(oinfo.rc != 1) TEST_ERROR
+        if(H5Pclose(dcpl2) < 0) FAIL_STACK_ERROR
+        if((dcpl2 = H5Dget_create_plist(dsid)) < 0) FAIL_STACK_ERROR
+        if(H5Pget_layout(dcpl2) != H5D_CHUNKED) TEST_ERROR
+        if(H5Pget_fill_value(dcpl2, H5T_NATIVE_INT, &fill_out) < 0) FAIL_STACK_ERROR
+        if(fill_out != fill) TEST_ERROR
+        if(u % 50 == 0) {
+            HDmemset(rbuf, 0, sizeof(rbuf));
+            if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            for(v = 0; v < CREATE_MULTI_DIM; v++)
+                if(rbuf[v] != fill) TEST_ERROR
+        } /* end if */
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+    } /* end for */
+    if(H5Lexists(fid, "many/a0", H5P_DEFAULT) != FALSE) TEST_ERROR
+    if(H5Lexists(fid, "many/a1", H5P_DEFAULT) != FALSE) TEST_ERROR
+
+    for(u = 0; u < 3; u++) {
+        HDsnprintf(path, sizeof(path), "c%u", u);
+        if((dsid = H5Dopen2(fid, path, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Pclose(dcpl2) < 0) FAIL_STACK_ERROR
+        if((dcpl2 = H5Dget_create_plist(dsid)) < 0) FAIL_STACK_ERROR
+        if(H5Pget_layout(dcpl2) != H5D_COMPACT) TEST_ERROR
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+    } /* end for */
+
+    if((dsid = H5Dopen2(fid, "t2", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if((tid = H5Dget_type(dsid)) < 0) FAIL_STACK_ERROR
+    if(H5Tcommitted(tid) != TRUE) TEST_ERROR
+    if(H5Tclose(tid) < 0) FAIL_STACK_ERROR
+    tid = -1;
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(v = 0; v < CREATE_MULTI_DIM; v++)
+        if(rbuf[v] != wbuf[v]) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+    if(H5Oget_info_by_name(fid, "type", &oinfo, H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    if(oinfo.rc != 5) TEST_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Create datasets whose messages are shared in a new file, then delete
+     * all but one of them, to check the shared messages' reference counts */
+    if((fcpl = H5Pcreate(H5P_FILE_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shared_mesg_nindexes(fcpl, 1) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shared_mesg_index(fcpl, 0, H5O_SHMESG_ALL_FLAG, 0) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, fcpl, fapl)) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < 10; u++) {
+        HDsnprintf(name_buf[u], sizeof(name_buf[u]), "s%u", u);
+        names[u] = name_buf[u];
+    } /* end for */
+    if(H5Dcreate_multi(fid, (size_t)10, names, H5T_STD_I32BE, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT, NULL) < 0)
+        FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fopen(filename, H5F_ACC_RDWR, fapl)) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < 9; u++)
+        if(H5Ldelete(fid, names[u], H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, names[9], H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(v = 0; v < CREATE_MULTI_DIM; v++)
+        if(rbuf[v] != fill) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+
+    /* Close everything */
+    if(H5Pclose(fcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl2) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        for(u = 0; u < 4; u++)
+            H5Dclose(dsids[u]);
+        H5Dclose(dsid);
+        H5Tclose(tid);
+        H5Pclose(dcpl2);
+        H5Pclose(dcpl);
+        H5Pclose(fcpl);
+        H5Sclose(sid);
+        H5Gclose(gid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_create_multi() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_scatter
@@ -9376,6 +10537,8 @@ main(void)
         nerrors += (test_tconv(file) < 0			? 1 : 0);
         nerrors += (test_filters(file, my_fapl) < 0		? 1 : 0);
         nerrors += (test_onebyte_shuffle(file) < 0 		? 1 : 0);
+        nerrors += (test_multibyte_shuffle(file) < 0 	? 1 : 0);
+        nerrors += (test_lz4(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_int(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_float(file) < 0         	? 1 : 0);
         nerrors += (test_nbit_double(file) < 0         	? 1 : 0);
@@ -9387,6 +10550,7 @@ main(void)
         nerrors += (test_nbit_flt_size(file) < 0 		? 1 : 0);
         nerrors += (test_scaleoffset_int(file) < 0 		? 1 : 0);
         nerrors += (test_scaleoffset_int_2(file) < 0 	? 1 : 0);
+        nerrors += (test_scaleoffset_long_long(file) < 0 	? 1 : 0);
         nerrors += (test_scaleoffset_float(file) < 0 	? 1 : 0);
         nerrors += (test_scaleoffset_float_2(file) < 0 	? 1 : 0);
         nerrors += (test_scaleoffset_double(file) < 0 	? 1 : 0);
@@ -9416,6 +10580,9 @@ main(void)
 	nerrors += (test_layout_extend(my_fapl) < 0		? 1 : 0);
 	nerrors += (test_large_chunk_shrink(my_fapl) < 0        ? 1 : 0);
 	nerrors += (test_zero_dim_dset(my_fapl) < 0             ? 1 : 0);
+	nerrors += (test_async_io(my_fapl) < 0                  ? 1 : 0);
+	nerrors += (test_multi_io(my_fapl) < 0                  ? 1 : 0);
+	nerrors += (test_create_multi(my_fapl) < 0              ? 1 : 0);
 
         if(H5Fclose(file) < 0)
             goto error;
@@ -18,12 +18,14 @@
 #define ROWS    12
 #define COLS    18
 #define FLOAT_TOL 0.0001
+#define LONG_NELMTS 5000
 
 static int init_test(hid_t file_id);
 static int test_copy(const hid_t dxpl_id_c_to_f_copy, const hid_t dxpl_id_polynomial_copy);
 static int test_trivial(const hid_t dxpl_id_simple);
 static int test_poly(const hid_t dxpl_id_polynomial);
 static int test_specials(hid_t file);
+static int test_long(hid_t file);
 static int test_set(void);
 static int test_getset(const hid_t dxpl_id_simple);
 
@@ -350,6 +352,7 @@ int main(void)
     if(test_poly(dxpl_id_polynomial) < 0) TEST_ERROR;
     if(test_getset(dxpl_id_c_to_f) < 0) TEST_ERROR;
     if(test_specials(file_id) < 0) TEST_ERROR;
+    if(test_long(file_id) < 0) TEST_ERROR;
 
     /* Close the objects we opened/created */
     if(H5Dclose(dset_id_int) < 0) TEST_ERROR;
@@ -673,6 +676,66 @@ error:
      return -1;
 }
 
+static int
+test_long(hid_t file)
+{
+    hid_t dxpl_id = -1, dset_id = -1, dataspace = -1;
+    hsize_t dim[1] = { LONG_NELMTS };
+    int *orig = NULL, *read_buf = NULL;
+    int i;
+    const char* expr = "(x*x+2*x+1)/(x+1) - (x-3)*(2-x)";
+
+    TESTING("data transform spanning several blocks of elements")
+
+    if(NULL == (orig = (int *)HDmalloc(LONG_NELMTS * sizeof(int)))) TEST_ERROR
+    if(NULL == (read_buf = (int *)HDmalloc(LONG_NELMTS * sizeof(int)))) TEST_ERROR
+    for(i = 0; i < LONG_NELMTS; i++)
+        orig[i] = i;
+
+    if((dataspace = H5Screate_simple(1, dim, NULL)) < 0) TEST_ERROR
+    if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0) TEST_ERROR
+    if(H5Pset_data_transform(dxpl_id, expr) < 0) TEST_ERROR
+
+    if((dset_id = H5Dcreate2(file, "/long", H5T_NATIVE_INT,
+            dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if(H5Dwrite(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL,
+            H5P_DEFAULT, orig) < 0)
+        TEST_ERROR
+    if(H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL,
+            dxpl_id, read_buf) < 0)
+        TEST_ERROR
+
+    /* Every element, including the ones in the last partial block, must be transformed */
+    for(i = 0; i < LONG_NELMTS; i++)
+        if(read_buf[i] != (i + 1) - (i - 3) * (2 - i)) {
+            H5_FAILED();
+            printf("    element %d: expected %d, got %d\n", i, (i + 1) - (i - 3) * (2 - i), read_buf[i]);
+            goto error;
+        } /* end if */
+
+    if(H5Dclose(dset_id) < 0) TEST_ERROR
+    if(H5Pclose(dxpl_id) < 0) TEST_ERROR
+    if(H5Sclose(dataspace) < 0) TEST_ERROR
+    HDfree(orig);
+    HDfree(read_buf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dset_id);
+        H5Pclose(dxpl_id);
+        H5Sclose(dataspace);
+    } H5E_END_TRY
+    if(orig)
+        HDfree(orig);
+    if(read_buf)
+        HDfree(read_buf);
+    return -1;
+}
+
 static int
 test_copy(const hid_t dxpl_id_c_to_f_copy, const hid_t dxpl_id_polynomial_copy)
 {
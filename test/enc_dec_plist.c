@@ -116,7 +116,8 @@ main(void)
         FALSE,
         0.2f,
         (256 * 2048),
-        H5AC__DEFAULT_METADATA_WRITE_STRATEGY};
+        H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+        H5C_rp__lru};
 
     if(VERBOSE_MED)
 	printf("Encode/Decode DCPLs\n");
@@ -84,7 +84,8 @@ main(void)
         0 /*FALSE*/,
         0.2f,
         (256 * 2048),
-        H5AC_METADATA_WRITE_STRATEGY__PROCESS_0_ONLY};
+        H5AC_METADATA_WRITE_STRATEGY__PROCESS_0_ONLY,
+        H5C_rp__lru};
 
     /* check endianess */
     {
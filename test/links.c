@@ -7381,6 +7381,7 @@ done:
             case H5I_ERROR_CLASS:
             case H5I_ERROR_MSG:
             case H5I_ERROR_STACK:
+            case H5I_REQUEST:
             case H5I_NTYPES:
             default:
               return -1;
@@ -7468,6 +7469,7 @@ done:
             case H5I_ERROR_CLASS:
             case H5I_ERROR_MSG:
             case H5I_ERROR_STACK:
+            case H5I_REQUEST:
             case H5I_NTYPES:
             default:
                 return -1;
@@ -78,6 +78,7 @@ const char *FILENAME[] = {
 #define NAME_DATASET_COMPOUND 	"dataset_compound"
 #define NAME_DATASET_CHUNKED 	"dataset_chunked"
 #define NAME_DATASET_CHUNKED2 	"dataset_chunked2"
+#define NAME_DATASET_CHUNKED3 	"dataset_chunked3"
 #define NAME_DATASET_COMPACT 	"dataset_compact"
 #define NAME_DATASET_EXTERNAL 	"dataset_ext"
 #define NAME_DATASET_NAMED_DTYPE 	"dataset_named_dtype"
@@ -123,6 +124,10 @@ const char *FILENAME[] = {
 #define DIM_SIZE_2  6
 #define CHUNK_SIZE_1 5          /* Not an even fraction of dimension sizes, so we test copying partial chunks */
 #define CHUNK_SIZE_2 5
+#define DIM_SIZE_MANY 2000      /* Enough chunks to need several batches when copying */
+#define CHUNK_SIZE_MANY 3
+#define DIM_SIZE_BIG (3 * 300000)       /* Chunks larger than a copy batch */
+#define CHUNK_SIZE_BIG 300000
 #define NUM_SUB_GROUPS  20
 #define NUM_WIDE_LOOP_GROUPS  10
 #define NUM_DATASETS  10
@@ -2588,6 +2593,137 @@ error:
     return 1;
 } /* end test_copy_dataset_chunked */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_copy_dataset_chunked_many
+ *
+ * Purpose:     Create chunked datasets with many small chunks and with a few
+ *              large chunks in SRC file and copy them to DST file
+ *              (Note: the raw chunks are copied in batches)
+ *
+ * Return:      Success:        0
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_copy_dataset_chunked_many(hid_t fcpl_src, hid_t fcpl_dst, hid_t src_fapl, hid_t dst_fapl)
+{
+    hid_t fid_src = -1, fid_dst = -1;           /* File IDs */
+    hid_t sid = -1;                             /* Dataspace ID */
+    hid_t pid = -1;                             /* Dataset creation property list ID */
+    hid_t did = -1, did2 = -1;                  /* Dataset IDs */
+    hsize_t dim1d[1];                           /* Dataset dimensions */
+    hsize_t chunk_dim1d[1];                     /* Chunk dimensions */
+    int *buf = NULL;                            /* Buffer for writing data */
+    const char *dset_name[2] = {NAME_DATASET_CHUNKED, NAME_DATASET_CHUNKED3};
+    hsize_t dset_dim[2] = {DIM_SIZE_MANY, DIM_SIZE_BIG};
+    hsize_t dset_chunk[2] = {CHUNK_SIZE_MANY, CHUNK_SIZE_BIG};
+    int i, n;                                   /* Local index variables */
+    char src_filename[NAME_BUF_SIZE];
+    char dst_filename[NAME_BUF_SIZE];
+
+    TESTING("H5Ocopy(): chunked dataset with many chunks");
+
+    /* set initial data values */
+    if(NULL == (buf = (int *)HDmalloc(DIM_SIZE_BIG * sizeof(int)))) TEST_ERROR
+    for(i = 0; i < DIM_SIZE_BIG; i++)
+        buf[i] = i;
+
+    /* Initialize the filenames */
+    h5_fixname(FILENAME[0], src_fapl, src_filename, sizeof src_filename);
+    h5_fixname(FILENAME[1], dst_fapl, dst_filename, sizeof dst_filename);
+
+    /* Reset file address checking info */
+    addr_reset();
+
+    /* create source file */
+    if((fid_src = H5Fcreate(src_filename, H5F_ACC_TRUNC, fcpl_src, src_fapl)) < 0) TEST_ERROR
+
+    for(n = 0; n < 2; n++) {
+        /* create 1-D dataspace */
+        dim1d[0] = dset_dim[n];
+        if((sid = H5Screate_simple(1, dim1d, NULL)) < 0) TEST_ERROR
+
+        /* create and set chunk plist */
+        chunk_dim1d[0] = dset_chunk[n];
+        if((pid = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+        if(H5Pset_chunk(pid, 1, chunk_dim1d) < 0) TEST_ERROR
+
+        /* create dataset */
+        if((did = H5Dcreate2(fid_src, dset_name[n], H5T_NATIVE_INT, sid, H5P_DEFAULT, pid, H5P_DEFAULT)) < 0) TEST_ERROR
+
+        /* close chunk plist */
+        if(H5Pclose(pid) < 0) TEST_ERROR
+
+        /* write data into file */
+        if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) TEST_ERROR
+
+        /* close dataspace */
+        if(H5Sclose(sid) < 0) TEST_ERROR
+
+        /* close the dataset */
+        if(H5Dclose(did) < 0) TEST_ERROR
+    } /* end for */
+
+    /* close the SRC file */
+    if(H5Fclose(fid_src) < 0) TEST_ERROR
+
+
+    /* open the source file with read-only */
+    if((fid_src = H5Fopen(src_filename, H5F_ACC_RDONLY, src_fapl)) < 0) TEST_ERROR
+
+    /* create destination file */
+    if((fid_dst = H5Fcreate(dst_filename, H5F_ACC_TRUNC, fcpl_dst, dst_fapl)) < 0) TEST_ERROR
+
+    /* Create an uncopied object in destination file so that addresses in source and destination files aren't the same */
+    if(H5Gclose(H5Gcreate2(fid_dst, NAME_GROUP_UNCOPIED, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) TEST_ERROR
+
+    for(n = 0; n < 2; n++) {
+        /* copy the dataset from SRC to DST */
+        if(H5Ocopy(fid_src, dset_name[n], fid_dst, dset_name[n], H5P_DEFAULT, H5P_DEFAULT) < 0) TEST_ERROR
+
+        /* open the dataset for copy */
+        if((did = H5Dopen2(fid_src, dset_name[n], H5P_DEFAULT)) < 0) TEST_ERROR
+
+        /* open the destination dataset */
+        if((did2 = H5Dopen2(fid_dst, dset_name[n], H5P_DEFAULT)) < 0) TEST_ERROR
+
+        /* Check if the datasets are equal */
+        if(compare_datasets(did, did2, H5P_DEFAULT, buf) != TRUE) TEST_ERROR
+
+        /* close the destination dataset */
+        if(H5Dclose(did2) < 0) TEST_ERROR
+
+        /* close the source dataset */
+        if(H5Dclose(did) < 0) TEST_ERROR
+    } /* end for */
+
+    /* close the SRC file */
+    if(H5Fclose(fid_src) < 0) TEST_ERROR
+
+    /* close the DST file */
+    if(H5Fclose(fid_dst) < 0) TEST_ERROR
+
+    HDfree(buf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+    	H5Dclose(did2);
+    	H5Dclose(did);
+    	H5Pclose(pid);
+    	H5Sclose(sid);
+    	H5Fclose(fid_dst);
+    	H5Fclose(fid_src);
+    } H5E_END_TRY;
+    if(buf)
+        HDfree(buf);
+    return 1;
+} /* end test_copy_dataset_chunked_many */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_copy_dataset_chunked_empty
@@ -12261,6 +12397,7 @@ main(void)
         nerrors += test_copy_dataset_simple_empty(fcpl_src, fcpl_dst, src_fapl, dst_fapl);
         nerrors += test_copy_dataset_compound(fcpl_src, fcpl_dst, src_fapl, dst_fapl);
         nerrors += test_copy_dataset_chunked(fcpl_src, fcpl_dst, src_fapl, dst_fapl);
+        nerrors += test_copy_dataset_chunked_many(fcpl_src, fcpl_dst, src_fapl, dst_fapl);
         nerrors += test_copy_dataset_chunked_empty(fcpl_src, fcpl_dst, src_fapl, dst_fapl);
         nerrors += test_copy_dataset_chunked_sparse(fcpl_src, fcpl_dst, src_fapl, dst_fapl);
         nerrors += test_copy_dataset_compressed(fcpl_src, fcpl_dst, src_fapl, dst_fapl);
@@ -133,6 +133,12 @@ float attr_data5=(float)-5.123;        /* Test data for 5th attribute */
 #define NATTR_MANY_OLD  350
 #define NATTR_MANY_NEW  35000
 
+/* Number of attributes for "open all" test */
+#define NATTR_OPEN_ALL  20
+
+/* Number of missing attribute names looked up in the "open all" test */
+#define NATTR_OPEN_ALL_MISSING  2500
+
 #define BUG2_NATTR  100
 #define BUG2_NATTR2 16
 
@@ -8005,6 +8011,230 @@ test_attr_create_by_name(hbool_t new_format, hid_t fcpl, hid_t fapl)
     CHECK(ret, FAIL, "H5Sclose");
 }   /* test_attr_create_by_name() */
 
+/****************************************************************
+**
+**  test_attr_open_all(): Test basic H5A (attribute) code.
+**      Tests opening all the attributes of an object at once, and
+**      looking attributes up by name while they are created,
+**      renamed, written and deleted
+**
+****************************************************************/
+static void
+test_attr_open_all(hbool_t new_format, hid_t fcpl, hid_t fapl)
+{
+    hid_t	fid;		/* HDF5 File ID			*/
+    hid_t	gid;	        /* Group ID			*/
+    hid_t	sid;	        /* Dataspace ID			*/
+    hid_t	aid;	        /* Attribute ID			*/
+    hid_t	attr_ids[NATTR_OPEN_ALL];       /* Attribute IDs opened at once */
+    char	attrname[NAME_BUF_SIZE];        /* Name of attribute */
+    char	newname[NAME_BUF_SIZE];         /* New name of attribute */
+    ssize_t     nopened;        /* Number of attributes opened */
+    htri_t      exists;         /* Whether the attribute exists or not */
+    unsigned    value;          /* Attribute value */
+    unsigned    u, v;           /* Local index variables */
+    herr_t	ret;		/* Generic return value		*/
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing Opening All Attributes of an Object (%s format)\n", new_format ? "new" : "old"));
+
+    /* Create file */
+    fid = H5Fcreate(FILENAME, H5F_ACC_TRUNC, fcpl, fapl);
+    CHECK(fid, FAIL, "H5Fcreate");
+
+    /* Create dataspace for attribute */
+    sid = H5Screate(H5S_SCALAR);
+    CHECK(sid, FAIL, "H5Screate");
+
+    /* Create group for attributes */
+    gid = H5Gcreate2(fid, GROUP1_NAME, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(gid, FAIL, "H5Gcreate2");
+
+    /* Create attributes, going from compact to dense storage in the new format */
+    for(u = 0; u < NATTR_OPEN_ALL; u++) {
+        sprintf(attrname, "attr %02u", u);
+        aid = H5Acreate2(gid, attrname, H5T_NATIVE_UINT, sid, H5P_DEFAULT, H5P_DEFAULT);
+        CHECK(aid, FAIL, "H5Acreate2");
+        ret = H5Awrite(aid, H5T_NATIVE_UINT, &u);
+        CHECK(ret, FAIL, "H5Awrite");
+        ret = H5Aclose(aid);
+        CHECK(ret, FAIL, "H5Aclose");
+
+        /* Open all the attributes so far at once, in name order */
+        nopened = H5Aopen_all(gid, H5_INDEX_NAME, H5_ITER_INC, (size_t)NATTR_OPEN_ALL, attr_ids, H5P_DEFAULT);
+        VERIFY(nopened, (ssize_t)(u + 1), "H5Aopen_all");
+        for(v = 0; v <= u; v++) {
+            ret = H5Aread(attr_ids[v], H5T_NATIVE_UINT, &value);
+            CHECK(ret, FAIL, "H5Aread");
+            VERIFY(value, v, "H5Aread");
+            ret = H5Aclose(attr_ids[v]);
+            CHECK(ret, FAIL, "H5Aclose");
+        } /* end for */
+
+        /* Look the attributes up by name */
+        for(v = 0; v <= u; v++) {
+            sprintf(attrname, "attr %02u", v);
+            exists = H5Aexists(gid, attrname);
+            VERIFY(exists, TRUE, "H5Aexists");
+            aid = H5Aopen(gid, attrname, H5P_DEFAULT);
+            CHECK(aid, FAIL, "H5Aopen");
+            ret = H5Aread(aid, H5T_NATIVE_UINT, &value);
+            CHECK(ret, FAIL, "H5Aread");
+            VERIFY(value, v, "H5Aread");
+            ret = H5Aclose(aid);
+            CHECK(ret, FAIL, "H5Aclose");
+        } /* end for */
+        sprintf(attrname, "attr %02u", u + 1);
+        exists = H5Aexists(gid, attrname);
+        VERIFY(exists, FALSE, "H5Aexists");
+    } /* end for */
+
+    /* Rename the odd attributes and rewrite the even ones */
+    for(u = 0; u < NATTR_OPEN_ALL; u++) {
+        sprintf(attrname, "attr %02u", u);
+        if(u % 2) {
+            sprintf(newname, "renamed %02u", u);
+            ret = H5Arename(gid, attrname, newname);
+            CHECK(ret, FAIL, "H5Arename");
+        } /* end if */
+        else {
+            value = u + 100;
+            aid = H5Aopen(gid, attrname, H5P_DEFAULT);
+            CHECK(aid, FAIL, "H5Aopen");
+            ret = H5Awrite(aid, H5T_NATIVE_UINT, &value);
+            CHECK(ret, FAIL, "H5Awrite");
+            ret = H5Aclose(aid);
+            CHECK(ret, FAIL, "H5Aclose");
+        } /* end else */
+    } /* end for */
+
+    /* Check the attributes by their old & new names */
+    for(u = 0; u < NATTR_OPEN_ALL; u++) {
+        sprintf(attrname, "attr %02u", u);
+        sprintf(newname, "renamed %02u", u);
+        exists = H5Aexists(gid, attrname);
+        VERIFY(exists, (u % 2) ? FALSE : TRUE, "H5Aexists");
+        exists = H5Aexists(gid, newname);
+        VERIFY(exists, (u % 2) ? TRUE : FALSE, "H5Aexists");
+
+        aid = H5Aopen(gid, (u % 2) ? newname : attrname, H5P_DEFAULT);
+        CHECK(aid, FAIL, "H5Aopen");
+        ret = H5Aread(aid, H5T_NATIVE_UINT, &value);
+        CHECK(ret, FAIL, "H5Aread");
+        VERIFY(value, (u % 2) ? u : u + 100, "H5Aread");
+        ret = H5Aclose(aid);
+        CHECK(ret, FAIL, "H5Aclose");
+    } /* end for */
+
+    /* Open a few attributes at once, while one of them is already open */
+    aid = H5Aopen(gid, "attr 00", H5P_DEFAULT);
+    CHECK(aid, FAIL, "H5Aopen");
+    nopened = H5Aopen_all(gid, H5_INDEX_NAME, H5_ITER_INC, (size_t)3, attr_ids, H5P_DEFAULT);
+    VERIFY(nopened, 3, "H5Aopen_all");
+    value = 7;
+    ret = H5Awrite(aid, H5T_NATIVE_UINT, &value);
+    CHECK(ret, FAIL, "H5Awrite");
+    ret = H5Aread(attr_ids[0], H5T_NATIVE_UINT, &value);
+    CHECK(ret, FAIL, "H5Aread");
+    VERIFY(value, 7, "H5Aread");
+    ret = H5Aread(attr_ids[2], H5T_NATIVE_UINT, &value);
+    CHECK(ret, FAIL, "H5Aread");
+    VERIFY(value, 104, "H5Aread");
+    for(v = 0; v < 3; v++) {
+        ret = H5Aclose(attr_ids[v]);
+        CHECK(ret, FAIL, "H5Aclose");
+    } /* end for */
+    ret = H5Aclose(aid);
+    CHECK(ret, FAIL, "H5Aclose");
+
+    /* Delete all but the last two attributes, going back to compact storage */
+    for(u = 0; u < NATTR_OPEN_ALL - 2; u++) {
+        if(u % 2)
+            sprintf(attrname, "renamed %02u", u);
+        else
+            sprintf(attrname, "attr %02u", u);
+        ret = H5Adelete(gid, attrname);
+        CHECK(ret, FAIL, "H5Adelete");
+        exists = H5Aexists(gid, attrname);
+        VERIFY(exists, FALSE, "H5Aexists");
+
+        sprintf(newname, "renamed %02u", NATTR_OPEN_ALL - 1);
+        aid = H5Aopen(gid, newname, H5P_DEFAULT);
+        CHECK(aid, FAIL, "H5Aopen");
+        ret = H5Aread(aid, H5T_NATIVE_UINT, &value);
+        CHECK(ret, FAIL, "H5Aread");
+        VERIFY(value, NATTR_OPEN_ALL - 1, "H5Aread");
+        ret = H5Aclose(aid);
+        CHECK(ret, FAIL, "H5Aclose");
+    } /* end for */
+
+    /* Look up more missing names than the object's name index holds, and
+     * check that the remaining attributes are still found */
+    for(u = 0; u < NATTR_OPEN_ALL_MISSING; u++) {
+        sprintf(attrname, "missing %04u", u);
+        exists = H5Aexists(gid, attrname);
+        VERIFY(exists, FALSE, "H5Aexists");
+
+        if(u % 250 == 0) {
+            sprintf(newname, "renamed %02u", NATTR_OPEN_ALL - 1);
+            exists = H5Aexists(gid, newname);
+            VERIFY(exists, TRUE, "H5Aexists");
+            aid = H5Aopen(gid, newname, H5P_DEFAULT);
+            CHECK(aid, FAIL, "H5Aopen");
+            ret = H5Aread(aid, H5T_NATIVE_UINT, &value);
+            CHECK(ret, FAIL, "H5Aread");
+            VERIFY(value, NATTR_OPEN_ALL - 1, "H5Aread");
+            ret = H5Aclose(aid);
+            CHECK(ret, FAIL, "H5Aclose");
+        } /* end if */
+    } /* end for */
+
+    /* Close group */
+    ret = H5Gclose(gid);
+    CHECK(ret, FAIL, "H5Gclose");
+
+    /* Close file */
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+
+
+    /* Re-open the file and check on the attributes */
+    fid = H5Fopen(FILENAME, H5F_ACC_RDONLY, fapl);
+    CHECK(fid, FAIL, "H5Fopen");
+    gid = H5Gopen2(fid, GROUP1_NAME, H5P_DEFAULT);
+    CHECK(gid, FAIL, "H5Gopen2");
+
+    /* Opening no attributes is allowed */
+    nopened = H5Aopen_all(gid, H5_INDEX_NAME, H5_ITER_INC, (size_t)0, NULL, H5P_DEFAULT);
+    VERIFY(nopened, 0, "H5Aopen_all");
+
+    /* Open the remaining attributes, in decreasing name order */
+    nopened = H5Aopen_all(gid, H5_INDEX_NAME, H5_ITER_DEC, (size_t)NATTR_OPEN_ALL, attr_ids, H5P_DEFAULT);
+    VERIFY(nopened, 2, "H5Aopen_all");
+    ret = H5Aread(attr_ids[0], H5T_NATIVE_UINT, &value);
+    CHECK(ret, FAIL, "H5Aread");
+    VERIFY(value, NATTR_OPEN_ALL - 1, "H5Aread");
+    ret = H5Aread(attr_ids[1], H5T_NATIVE_UINT, &value);
+    CHECK(ret, FAIL, "H5Aread");
+    VERIFY(value, NATTR_OPEN_ALL - 2 + 100, "H5Aread");
+    for(v = 0; v < 2; v++) {
+        ret = H5Aclose(attr_ids[v]);
+        CHECK(ret, FAIL, "H5Aclose");
+    } /* end for */
+
+    /* Close group */
+    ret = H5Gclose(gid);
+    CHECK(ret, FAIL, "H5Gclose");
+
+    /* Close file */
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    /* Close dataspace */
+    ret = H5Sclose(sid);
+    CHECK(ret, FAIL, "H5Sclose");
+}   /* test_attr_open_all() */
+
 /****************************************************************
 **
 **  test_attr_shared_write(): Test basic H5A (attribute) code.
@@ -10688,6 +10918,7 @@ test_attr(void)
                 test_attr_open_by_idx(new_format, my_fcpl, my_fapl);    /* Test opening attributes by index */
                 test_attr_open_by_name(new_format, my_fcpl, my_fapl);   /* Test opening attributes by name */
                 test_attr_create_by_name(new_format, my_fcpl, my_fapl); /* Test creating attributes by name */
+                test_attr_open_all(new_format, my_fcpl, my_fapl);       /* Test opening all attributes at once */
 
                 /* More complex tests with both "new format" and "shared" attributes */
                 if(use_shared == TRUE) {
@@ -10722,6 +10953,7 @@ test_attr(void)
             test_attr_open_by_idx(new_format, fcpl, my_fapl);   /* Test opening attributes by index */
             test_attr_open_by_name(new_format, fcpl, my_fapl);  /* Test opening attributes by name */
             test_attr_create_by_name(new_format, fcpl, my_fapl); /* Test creating attributes by name */
+            test_attr_open_all(new_format, fcpl, my_fapl);      /* Test opening all attributes at once */
 
             /* Tests that address specific bugs */
             test_attr_bug1(fcpl, my_fapl);                      /* Test odd allocation operations */
@@ -3966,6 +3966,184 @@ test_sohm_external_dtype(void)
     HDfree(orig);
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_sohm_reshare_helper
+ *
+ * Purpose:     Tests sharing a message again after it has been deleted
+ *              and another message shared in the heap in its place.
+ *              Heap IDs of shared messages are remembered in memory, so
+ *              this checks that a message's heap ID is forgotten when the
+ *              message is deleted.
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+test_sohm_reshare_helper(hid_t fcpl_id)
+{
+    hid_t file_id;
+    hid_t tid_a, tid_b;
+    hid_t space_id;
+    hid_t dset_id;
+    hid_t dtid;
+    char name[NAME_BUF_SIZE];
+    size_t dmsg_count;
+    int x;
+    herr_t ret;
+
+    /* Create two different compound datatypes */
+    tid_a = H5Tcreate(H5T_COMPOUND, 3 * sizeof(int));
+    CHECK_I(tid_a, "H5Tcreate");
+    ret = H5Tinsert(tid_a, "first", 0, H5T_NATIVE_INT);
+    CHECK_I(ret, "H5Tinsert");
+    ret = H5Tinsert(tid_a, "second", sizeof(int), H5T_NATIVE_INT);
+    CHECK_I(ret, "H5Tinsert");
+    ret = H5Tinsert(tid_a, "third", 2 * sizeof(int), H5T_NATIVE_INT);
+    CHECK_I(ret, "H5Tinsert");
+    tid_b = H5Tcreate(H5T_COMPOUND, 2 * sizeof(double));
+    CHECK_I(tid_b, "H5Tcreate");
+    ret = H5Tinsert(tid_b, "alpha", 0, H5T_NATIVE_DOUBLE);
+    CHECK_I(ret, "H5Tinsert");
+    ret = H5Tinsert(tid_b, "beta", sizeof(double), H5T_NATIVE_DOUBLE);
+    CHECK_I(ret, "H5Tinsert");
+
+    space_id = H5Screate(H5S_SCALAR);
+    CHECK_I(space_id, "H5Screate");
+
+    file_id = H5Fcreate(FILENAME, H5F_ACC_TRUNC, fcpl_id, H5P_DEFAULT);
+    CHECK_I(file_id, "H5Fcreate");
+
+    /* Share the first datatype in the heap, then delete it */
+    for(x = 0; x < 3; x++) {
+        HDsnprintf(name, sizeof(name), "a%d", x);
+        dset_id = H5Dcreate2(file_id, name, tid_a, space_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        CHECK_I(dset_id, "H5Dcreate2");
+        ret = H5Dclose(dset_id);
+        CHECK_I(ret, "H5Dclose");
+    } /* end for */
+    ret = H5F_get_sohm_mesg_count_test(file_id, H5O_DTYPE_ID, &dmsg_count);
+    CHECK(ret, FAIL, "H5F_get_sohm_mesg_count_test");
+    VERIFY(dmsg_count, 1, "H5F_get_sohm_mesg_count_test");
+    for(x = 0; x < 3; x++) {
+        HDsnprintf(name, sizeof(name), "a%d", x);
+        ret = H5Ldelete(file_id, name, H5P_DEFAULT);
+        CHECK_I(ret, "H5Ldelete");
+    } /* end for */
+    ret = H5F_get_sohm_mesg_count_test(file_id, H5O_DTYPE_ID, &dmsg_count);
+    CHECK(ret, FAIL, "H5F_get_sohm_mesg_count_test");
+    VERIFY(dmsg_count, 0, "H5F_get_sohm_mesg_count_test");
+
+    /* Share the second datatype in the heap, possibly with the same heap ID */
+    for(x = 0; x < 3; x++) {
+        HDsnprintf(name, sizeof(name), "b%d", x);
+        dset_id = H5Dcreate2(file_id, name, tid_b, space_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        CHECK_I(dset_id, "H5Dcreate2");
+        ret = H5Dclose(dset_id);
+        CHECK_I(ret, "H5Dclose");
+    } /* end for */
+
+    /* Share the first datatype again; it must be added as a new message */
+    for(x = 3; x < 6; x++) {
+        HDsnprintf(name, sizeof(name), "a%d", x);
+        dset_id = H5Dcreate2(file_id, name, tid_a, space_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        CHECK_I(dset_id, "H5Dcreate2");
+        ret = H5Dclose(dset_id);
+        CHECK_I(ret, "H5Dclose");
+    } /* end for */
+    ret = H5F_get_sohm_mesg_count_test(file_id, H5O_DTYPE_ID, &dmsg_count);
+    CHECK(ret, FAIL, "H5F_get_sohm_mesg_count_test");
+    VERIFY(dmsg_count, 2, "H5F_get_sohm_mesg_count_test");
+
+    /* Delete the second datatype's datasets and share the first again */
+    for(x = 0; x < 3; x++) {
+        HDsnprintf(name, sizeof(name), "b%d", x);
+        ret = H5Ldelete(file_id, name, H5P_DEFAULT);
+        CHECK_I(ret, "H5Ldelete");
+    } /* end for */
+    dset_id = H5Dcreate2(file_id, "a6", tid_a, space_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK_I(dset_id, "H5Dcreate2");
+    ret = H5Dclose(dset_id);
+    CHECK_I(ret, "H5Dclose");
+    ret = H5F_get_sohm_mesg_count_test(file_id, H5O_DTYPE_ID, &dmsg_count);
+    CHECK(ret, FAIL, "H5F_get_sohm_mesg_count_test");
+    VERIFY(dmsg_count, 1, "H5F_get_sohm_mesg_count_test");
+
+    ret = H5Fclose(file_id);
+    CHECK_I(ret, "H5Fclose");
+
+    /* Check the datasets' datatypes after reopening the file */
+    file_id = H5Fopen(FILENAME, H5F_ACC_RDWR, H5P_DEFAULT);
+    CHECK_I(file_id, "H5Fopen");
+    for(x = 3; x < 7; x++) {
+        HDsnprintf(name, sizeof(name), "a%d", x);
+        dset_id = H5Dopen2(file_id, name, H5P_DEFAULT);
+        CHECK_I(dset_id, "H5Dopen2");
+        dtid = H5Dget_type(dset_id);
+        CHECK_I(dtid, "H5Dget_type");
+        VERIFY(H5Tequal(dtid, tid_a), TRUE, "H5Tequal");
+        ret = H5Tclose(dtid);
+        CHECK_I(ret, "H5Tclose");
+        ret = H5Dclose(dset_id);
+        CHECK_I(ret, "H5Dclose");
+    } /* end for */
+
+    /* Deleting all the datasets should leave no shared datatypes */
+    for(x = 3; x < 7; x++) {
+        HDsnprintf(name, sizeof(name), "a%d", x);
+        ret = H5Ldelete(file_id, name, H5P_DEFAULT);
+        CHECK_I(ret, "H5Ldelete");
+    } /* end for */
+    ret = H5F_get_sohm_mesg_count_test(file_id, H5O_DTYPE_ID, &dmsg_count);
+    CHECK(ret, FAIL, "H5F_get_sohm_mesg_count_test");
+    VERIFY(dmsg_count, 0, "H5F_get_sohm_mesg_count_test");
+
+    ret = H5Fclose(file_id);
+    CHECK_I(ret, "H5Fclose");
+    ret = H5Sclose(space_id);
+    CHECK_I(ret, "H5Sclose");
+    ret = H5Tclose(tid_b);
+    CHECK_I(ret, "H5Tclose");
+    ret = H5Tclose(tid_a);
+    CHECK_I(ret, "H5Tclose");
+} /* test_sohm_reshare_helper() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_sohm_reshare
+ *
+ * Purpose:     Tests sharing messages again after they have been deleted,
+ *              with list and B-tree indexes.
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+test_sohm_reshare(void)
+{
+    hid_t fcpl_id;
+    herr_t ret;
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing sharing deleted messages again\n"));
+
+    fcpl_id = H5Pcreate(H5P_FILE_CREATE);
+    CHECK_I(fcpl_id, "H5Pcreate");
+    ret = H5Pset_shared_mesg_nindexes(fcpl_id, 1);
+    CHECK_I(ret, "H5Pset_shared_mesg_nindexes");
+    ret = H5Pset_shared_mesg_index(fcpl_id, 0, H5O_SHMESG_ALL_FLAG, 16);
+    CHECK_I(ret, "H5Pset_shared_mesg_index");
+
+    /* Index as a list */
+    test_sohm_reshare_helper(fcpl_id);
+
+    /* Index as a B-tree */
+    ret = H5Pset_shared_mesg_phase_change(fcpl_id, 0, 0);
+    CHECK_I(ret, "H5Pset_shared_mesg_phase_change");
+    test_sohm_reshare_helper(fcpl_id);
+
+    ret = H5Pclose(fcpl_id);
+    CHECK_I(ret, "H5Pclose");
+} /* test_sohm_reshare() */
+
 
 /****************************************************************
 **
@@ -3995,6 +4173,7 @@ test_sohm(void)
 
     test_sohm_extend_dset();    /* Test extending shared datasets */
     test_sohm_external_dtype(); /* Test using datatype in another file */
+    test_sohm_reshare();        /* Test sharing deleted messages again */
 } /* test_sohm() */
 
 
@@ -44,6 +44,11 @@
 #define SPACE4_DIM_SMALL     128
 #define SPACE4_DIM_LARGE     (H5D_TEMP_BUF_SIZE / 64)
 
+/* 1-D chunked dataset with fixed dimensions */
+#define SPACE5_RANK	1
+#define SPACE5_DIM1     20000
+#define SPACE5_CHUNK_DIM1     4096
+
 void *test_vltypes_alloc_custom(size_t size, void *info);
 void test_vltypes_free_custom(void *mem, void *info);
 
@@ -696,6 +701,297 @@ rewrite_vltypes_vlen_atomic(void)
 
 
 
+/****************************************************************
+**
+**  test_vltypes_vlen_chunked_many(): Test writing and reading
+**      many VL sequences of atomic datatypes, including "nil"
+**      ones, to a chunked dataset, with and without converting
+**      the sequences' values.  The sequences written in one call
+**      don't all fit in one global heap collection.
+**
+****************************************************************/
+static void
+test_vltypes_vlen_chunked_many(void)
+{
+    hvl_t *wdata;               /* Information to write */
+    hvl_t *rdata;               /* Information read in */
+    hid_t fid1;		/* HDF5 File IDs		*/
+    hid_t dataset;	/* Dataset ID			*/
+    hid_t sid1;         /* Dataspace ID			*/
+    hid_t tid1, tid2;   /* Datatype IDs			*/
+    hid_t dcpl_pid;     /* Dataset creation property list ID */
+    hsize_t dims1[] = {SPACE5_DIM1};
+    hsize_t chunk_dims[] = {SPACE5_CHUNK_DIM1};
+    unsigned i,j;       /* counting variables */
+    herr_t ret;		/* Generic return value		*/
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing Many VL Sequences in a Chunked Dataset\n"));
+
+    wdata = (hvl_t *)HDmalloc(SPACE5_DIM1 * sizeof(hvl_t));
+    CHECK(wdata, NULL, "HDmalloc");
+    rdata = (hvl_t *)HDmalloc(SPACE5_DIM1 * sizeof(hvl_t));
+    CHECK(rdata, NULL, "HDmalloc");
+
+    /* Allocate and initialize VL data to write, with every fifth
+     * sequence "nil" */
+    for(i = 0; i < SPACE5_DIM1; i++) {
+        wdata[i].len = i % 5;
+        wdata[i].p = wdata[i].len ? HDmalloc(wdata[i].len * sizeof(unsigned int)) : NULL;
+        for(j = 0; j < wdata[i].len; j++)
+            ((unsigned int *)wdata[i].p)[j] = i * 10 + j;
+    } /* end for */
+
+    /* Create file */
+    fid1 = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fcreate");
+
+    /* Create dataspace for datasets */
+    sid1 = H5Screate_simple(SPACE5_RANK, dims1, NULL);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+
+    /* Create a datatype to refer to */
+    tid1 = H5Tvlen_create(H5T_NATIVE_UINT);
+    CHECK(tid1, FAIL, "H5Tvlen_create");
+
+    dcpl_pid = H5Pcreate(H5P_DATASET_CREATE);
+    CHECK(dcpl_pid, FAIL, "H5Pcreate");
+
+    ret = H5Pset_chunk(dcpl_pid, SPACE5_RANK, chunk_dims);
+    CHECK(ret, FAIL, "H5Pset_chunk");
+
+    /* Create a dataset */
+    dataset = H5Dcreate2(fid1, "Dataset1", tid1, sid1, H5P_DEFAULT, dcpl_pid, H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dcreate2");
+
+    /* Write dataset to disk */
+    ret = H5Dwrite(dataset, tid1, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata);
+    CHECK(ret, FAIL, "H5Dwrite");
+
+    /* Close everything and re-open the file, so that the sequences are
+     * read back from disk */
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    fid1 = H5Fopen(FILENAME, H5F_ACC_RDONLY, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fopen");
+
+    dataset = H5Dopen2(fid1, "Dataset1", H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dopen2");
+
+    /* Read dataset from disk */
+    ret = H5Dread(dataset, tid1, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+
+    /* Compare data read in */
+    for(i = 0; i < SPACE5_DIM1; i++) {
+        if(wdata[i].len != rdata[i].len) {
+            TestErrPrintf("%d: VL data lengths don't match!, wdata[%d].len=%d, rdata[%d].len=%d\n",__LINE__,(int)i,(int)wdata[i].len,(int)i,(int)rdata[i].len);
+            break;
+        } /* end if */
+        for(j = 0; j < rdata[i].len; j++)
+            if(((unsigned int *)wdata[i].p)[j] != ((unsigned int *)rdata[i].p)[j]) {
+                TestErrPrintf("VL data values don't match!, wdata[%d].p[%d]=%d, rdata[%d].p[%d]=%d\n",(int)i,(int)j, (int)((unsigned int *)wdata[i].p)[j], (int)i,(int)j, (int)((unsigned int *)rdata[i].p)[j]);
+                break;
+            } /* end if */
+    } /* end for */
+
+    /* Reclaim the read VL data */
+    ret = H5Dvlen_reclaim(tid1, sid1, H5P_DEFAULT, rdata);
+    CHECK(ret, FAIL, "H5Dvlen_reclaim");
+
+    /* Read dataset from disk again, converting the sequences' values */
+    tid2 = H5Tvlen_create(H5T_NATIVE_UINT64);
+    CHECK(tid2, FAIL, "H5Tvlen_create");
+
+    ret = H5Dread(dataset, tid2, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+
+    /* Compare data read in */
+    for(i = 0; i < SPACE5_DIM1; i++) {
+        if(wdata[i].len != rdata[i].len) {
+            TestErrPrintf("%d: VL data lengths don't match!, wdata[%d].len=%d, rdata[%d].len=%d\n",__LINE__,(int)i,(int)wdata[i].len,(int)i,(int)rdata[i].len);
+            break;
+        } /* end if */
+        for(j = 0; j < rdata[i].len; j++)
+            if(((unsigned int *)wdata[i].p)[j] != ((uint64_t *)rdata[i].p)[j]) {
+                TestErrPrintf("VL data values don't match!, wdata[%d].p[%d]=%d, rdata[%d].p[%d]=%d\n",(int)i,(int)j, (int)((unsigned int *)wdata[i].p)[j], (int)i,(int)j, (int)((uint64_t *)rdata[i].p)[j]);
+                break;
+            } /* end if */
+    } /* end for */
+
+    /* Reclaim the read VL data */
+    ret = H5Dvlen_reclaim(tid2, sid1, H5P_DEFAULT, rdata);
+    CHECK(ret, FAIL, "H5Dvlen_reclaim");
+
+    /* Reclaim the write VL data */
+    ret = H5Dvlen_reclaim(tid1, sid1, H5P_DEFAULT, wdata);
+    CHECK(ret, FAIL, "H5Dvlen_reclaim");
+
+    /* Close everything */
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Tclose(tid2);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Pclose(dcpl_pid);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Tclose(tid1);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    HDfree(wdata);
+    HDfree(rdata);
+} /* end test_vltypes_vlen_chunked_many() */
+
+/****************************************************************
+**
+**  test_vltypes_vlen_arena(): Test reading VL data into memory
+**      allocated from an arena, and reclaiming it all at once.
+**
+****************************************************************/
+static void
+test_vltypes_vlen_arena(void)
+{
+    hvl_t wdata[SPACE1_DIM1];   /* Information to write */
+    hvl_t rdata[SPACE1_DIM1];   /* Information read in */
+    hid_t fid1;		/* HDF5 File IDs		*/
+    hid_t dataset;	/* Dataset ID			*/
+    hid_t sid1;         /* Dataspace ID			*/
+    hid_t tid1;         /* Datatype ID			*/
+    hid_t xfer_pid, xfer_pid2;  /* Dataset transfer property list IDs */
+    hsize_t dims1[] = {SPACE1_DIM1};
+    size_t block_size;  /* Block size of arena */
+    size_t mem_used = 0; /* Memory used by the custom allocation routines */
+    unsigned i,j;       /* counting variables */
+    htri_t tri_ret;     /* Generic boolean return value */
+    herr_t ret;		/* Generic return value		*/
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing Reading VL Data into an Arena\n"));
+
+    /* Allocate and initialize VL data to write, with sequences both
+     * smaller and larger than the arena's blocks */
+    for(i = 0; i < SPACE1_DIM1; i++) {
+        wdata[i].p = HDmalloc((i * 100 + 1) * sizeof(unsigned int));
+        wdata[i].len = i * 100 + 1;
+        for(j = 0; j < wdata[i].len; j++)
+            ((unsigned int *)wdata[i].p)[j] = i * 10 + j;
+    } /* end for */
+
+    /* Create file */
+    fid1 = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fcreate");
+
+    /* Create dataspace for datasets */
+    sid1 = H5Screate_simple(SPACE1_RANK, dims1, NULL);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+
+    /* Create a datatype to refer to */
+    tid1 = H5Tvlen_create(H5T_NATIVE_UINT);
+    CHECK(tid1, FAIL, "H5Tvlen_create");
+
+    /* Create a dataset */
+    dataset = H5Dcreate2(fid1, "Dataset1", tid1, sid1, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dcreate2");
+
+    /* Write dataset to disk */
+    ret = H5Dwrite(dataset, tid1, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata);
+    CHECK(ret, FAIL, "H5Dwrite");
+
+    /* Change to the custom memory allocation routines and an arena for
+     * reading VL data, the arena should be used */
+    xfer_pid = H5Pcreate(H5P_DATASET_XFER);
+    CHECK(xfer_pid, FAIL, "H5Pcreate");
+
+    ret = H5Pset_vlen_mem_manager(xfer_pid, test_vltypes_alloc_custom, &mem_used, test_vltypes_free_custom, &mem_used);
+    CHECK(ret, FAIL, "H5Pset_vlen_mem_manager");
+
+    ret = H5Pset_vlen_mem_arena(xfer_pid, (size_t)256);
+    CHECK(ret, FAIL, "H5Pset_vlen_mem_arena");
+
+    ret = H5Pget_vlen_mem_arena(xfer_pid, &block_size);
+    CHECK(ret, FAIL, "H5Pget_vlen_mem_arena");
+    VERIFY(block_size, 256, "H5Pget_vlen_mem_arena");
+
+    /* Read dataset from disk */
+    ret = H5Dread(dataset, tid1, H5S_ALL, H5S_ALL, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+
+    /* Make certain the custom allocation routines weren't used */
+    VERIFY(mem_used, 0, "H5Dread");
+
+    /* A copy of the property list shares the arena, so the data read
+     * stays valid when the original property list is closed */
+    xfer_pid2 = H5Pcopy(xfer_pid);
+    CHECK(xfer_pid2, FAIL, "H5Pcopy");
+
+    tri_ret = H5Pequal(xfer_pid, xfer_pid2);
+    VERIFY(tri_ret, TRUE, "H5Pequal");
+
+    ret = H5Pclose(xfer_pid);
+    CHECK(ret, FAIL, "H5Pclose");
+
+    /* Compare data read in */
+    for(i = 0; i < SPACE1_DIM1; i++) {
+        if(wdata[i].len != rdata[i].len) {
+            TestErrPrintf("%d: VL data lengths don't match!, wdata[%d].len=%d, rdata[%d].len=%d\n",__LINE__,(int)i,(int)wdata[i].len,(int)i,(int)rdata[i].len);
+            continue;
+        } /* end if */
+        for(j = 0; j < rdata[i].len; j++)
+            if(((unsigned int *)wdata[i].p)[j] != ((unsigned int *)rdata[i].p)[j]) {
+                TestErrPrintf("VL data values don't match!, wdata[%d].p[%d]=%d, rdata[%d].p[%d]=%d\n",(int)i,(int)j, (int)((unsigned int *)wdata[i].p)[j], (int)i,(int)j, (int)((unsigned int *)rdata[i].p)[j]);
+                break;
+            } /* end if */
+    } /* end for */
+
+    /* Reclaim the read VL data, all at once */
+    ret = H5Dvlen_reclaim(tid1, sid1, xfer_pid2, rdata);
+    CHECK(ret, FAIL, "H5Dvlen_reclaim");
+
+    /* Stop using an arena */
+    ret = H5Pset_vlen_mem_arena(xfer_pid2, (size_t)0);
+    CHECK(ret, FAIL, "H5Pset_vlen_mem_arena");
+
+    ret = H5Pget_vlen_mem_arena(xfer_pid2, &block_size);
+    CHECK(ret, FAIL, "H5Pget_vlen_mem_arena");
+    VERIFY(block_size, 0, "H5Pget_vlen_mem_arena");
+
+    /* Read dataset from disk again, with the custom allocation routines */
+    ret = H5Dread(dataset, tid1, H5S_ALL, H5S_ALL, xfer_pid2, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+
+    /* Make certain the correct amount of memory has been used */
+    VERIFY(mem_used, (1 + 101 + 201 + 301) * sizeof(unsigned int), "H5Dread");
+
+    /* Reclaim the read VL data */
+    ret = H5Dvlen_reclaim(tid1, sid1, xfer_pid2, rdata);
+    CHECK(ret, FAIL, "H5Dvlen_reclaim");
+
+    /* Make certain the VL memory has been freed */
+    VERIFY(mem_used, 0, "H5Dvlen_reclaim");
+
+    /* Reclaim the write VL data */
+    ret = H5Dvlen_reclaim(tid1, sid1, H5P_DEFAULT, wdata);
+    CHECK(ret, FAIL, "H5Dvlen_reclaim");
+
+    /* Close everything */
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Tclose(tid1);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Pclose(xfer_pid2);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+} /* end test_vltypes_vlen_arena() */
+
 /****************************************************************
 **
 **  test_vltypes_vlen_compound(): Test basic VL datatype code.
@@ -3151,6 +3447,8 @@ test_vltypes(void)
     test_vltypes_funcs();             /* Test functions with VL types */
     test_vltypes_vlen_atomic();       /* Test VL atomic datatypes */
     rewrite_vltypes_vlen_atomic();    /* Check VL memory leak	  */
+    test_vltypes_vlen_chunked_many(); /* Test many VL sequences in a chunked dataset */
+    test_vltypes_vlen_arena();        /* Test reading VL data into an arena */
     test_vltypes_vlen_compound();     /* Test VL compound datatypes */
     rewrite_vltypes_vlen_compound();  /* Check VL memory leak	  */
     test_vltypes_compound_vlen_atomic(); /* Test compound datatypes with VL atomic components */
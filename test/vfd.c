@@ -59,6 +59,7 @@ const char *FILENAME[] = {
 };
 
 #define LOG_FILENAME "log_vfd_out.log"
+#define LOG_TRACE_FILENAME "log_vfd_out.log" H5FD_LOG_TRACE_SUFFIX
 
 #define COMPAT_BASENAME "family_v16_"
 #define MULTI_COMPAT_BASENAME "multi_file_v16"
@@ -1402,6 +1403,136 @@ error:
     return -1;
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_log_trace
+ *
+ * Purpose:     Tests the binary trace output of the log driver
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_log_trace(void)
+{
+    hid_t        file            = -1;
+    hid_t        fapl            = -1;
+    hid_t        space           = -1;
+    hid_t        dset            = -1;
+    char         filename[1024];
+    FILE         *tracefp        = NULL;
+    unsigned char hdr[H5FD_LOG_TRACE_HDR_SIZE];
+    unsigned char rec[H5FD_LOG_TRACE_REC_SIZE];
+    unsigned     nreads          = 0;
+    unsigned     nwrites         = 0;
+    unsigned     ntagged         = 0;
+    hsize_t      dims[1]         = {DSET1_DIM1};
+    int          buf[DSET1_DIM1];
+    int          i;
+
+    TESTING("LOG file driver binary trace");
+
+    /* A trace requires a log file name */
+    fapl = h5_fileaccess();
+    if(H5Pset_fapl_log(fapl, NULL, H5FD_LOG_TRACE, (size_t)0) < 0)
+        TEST_ERROR;
+    h5_fixname(FILENAME[6], fapl, filename, sizeof filename);
+    H5E_BEGIN_TRY {
+        file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    } H5E_END_TRY;
+    if(file >= 0)
+        TEST_ERROR;
+
+    /* Create a file with a dataset, then re-open it and read the data */
+    if(H5Pset_fapl_log(fapl, LOG_FILENAME, H5FD_LOG_TRACE, (size_t)0) < 0)
+        TEST_ERROR;
+    for(i = 0; i < DSET1_DIM1; i++)
+        buf[i] = i;
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR;
+    if((space = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR;
+    if((dset = H5Dcreate2(file, DSET1_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if(H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0)
+        TEST_ERROR;
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR;
+    if(H5Sclose(space) < 0)
+        TEST_ERROR;
+    if(H5Fclose(file) < 0)
+        TEST_ERROR;
+
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR;
+    if((dset = H5Dopen2(file, DSET1_NAME, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0)
+        TEST_ERROR;
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR;
+    if(H5Fclose(file) < 0)
+        TEST_ERROR;
+
+    /* Check the trace from the re-open: a valid header followed by records */
+    if(NULL == (tracefp = HDfopen(LOG_TRACE_FILENAME, "rb")))
+        TEST_ERROR;
+    if(HDfread(hdr, sizeof(hdr), (size_t)1, tracefp) != 1)
+        TEST_ERROR;
+    if(HDmemcmp(hdr, H5FD_LOG_TRACE_SIGNATURE, (size_t)H5FD_LOG_TRACE_SIGNATURE_LEN))
+        TEST_ERROR;
+    if(hdr[H5FD_LOG_TRACE_SIGNATURE_LEN] != H5FD_LOG_TRACE_VERSION)
+        TEST_ERROR;
+    if(hdr[8] != H5FD_LOG_TRACE_REC_SIZE || hdr[9] || hdr[10] || hdr[11])
+        TEST_ERROR;
+    while(HDfread(rec, sizeof(rec), (size_t)1, tracefp) == 1) {
+        if(rec[0] == H5FD_LOG_TRACE_OP_READ)
+            nreads++;
+        else if(rec[0] == H5FD_LOG_TRACE_OP_WRITE)
+            nwrites++;
+        else if(rec[0] != H5FD_LOG_TRACE_OP_EOA && rec[0] != H5FD_LOG_TRACE_OP_TRUNCATE)
+            TEST_ERROR;
+        if(rec[1] >= H5FD_MEM_NTYPES)
+            TEST_ERROR;
+
+        /* Count the object header reads attributed to an object */
+        if(rec[0] == H5FD_LOG_TRACE_OP_READ && rec[1] == H5FD_MEM_OHDR) {
+            for(i = 24; i < 32; i++)
+                if(rec[i])
+                    break;
+            if(i < 32)
+                ntagged++;
+        } /* end if */
+    } /* end while */
+    if(HDfclose(tracefp) != 0)
+        TEST_ERROR;
+    tracefp = NULL;
+
+    /* The file was opened read-only, so only reads should be recorded */
+    if(0 == nreads || nwrites != 0)
+        TEST_ERROR;
+    if(0 == ntagged)
+        TEST_ERROR;
+
+    HDremove(LOG_TRACE_FILENAME);
+    h5_cleanup(FILENAME, fapl);
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dset);
+        H5Sclose(space);
+        H5Pclose(fapl);
+        H5Fclose(file);
+    } H5E_END_TRY;
+    if(tracefp)
+        HDfclose(tracefp);
+    return -1;
+}
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_stdio
@@ -1604,6 +1735,7 @@ main(void)
     nerrors += test_multi_compat() < 0   ? 1 : 0;
     nerrors += test_direct() < 0         ? 1 : 0;
     nerrors += test_log() < 0            ? 1 : 0;
+    nerrors += test_log_trace() < 0      ? 1 : 0;
     nerrors += test_stdio() < 0          ? 1 : 0;
     nerrors += test_windows() < 0        ? 1 : 0;
 
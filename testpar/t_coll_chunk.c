@@ -564,6 +564,212 @@ coll_chunk10(void)
 }
 
 
+/*-------------------------------------------------------------------------
+ * Function:	coll_chunk_owner
+ *
+ * Purpose:	Test collective chunk writes where each chunk is written by
+ *		a single owning process (H5FD_MPIO_CHUNK_OWNER_IO).
+ *
+ *		The first write interleaves the columns of all processes,
+ *		so every chunk, including the partial edge chunks, is shared
+ *		by every process.  The second write gives each process a
+ *		band of rows which does not line up with the chunk boundaries
+ *		and only partially covers the chunks it touches; the last
+ *		process selects nothing.  The whole dataset is read back
+ *		after each write and checked.
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define OWNER_DIM1      13
+#define OWNER_CHUNK1    5
+#define OWNER_CHUNK2    4
+#define OWNER_BAND      3
+
+static void
+coll_chunk_owner_check(hid_t dataset, const int *expected, hsize_t nelmts)
+{
+    int *check;                 /* Whole dataset read back */
+    hsize_t u;                  /* Local index variable */
+    int mismatches = 0;         /* Number of wrong values */
+    int mpi_rank;
+    herr_t ret;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+
+    check = (int *)HDmalloc((size_t)nelmts * sizeof(int));
+    VRFY((check != NULL), "HDmalloc succeeded");
+
+    ret = H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, check);
+    VRFY((ret >= 0), "H5Dread succeeded");
+
+    for(u = 0; u < nelmts; u++)
+        if(check[u] != expected[u]) {
+            if(mismatches++ < MAX_ERR_REPORT && VERBOSE_MED)
+                printf("Dataset Verify failed at [%lu]: expect %d, got %d\n",
+                        (unsigned long)u, expected[u], check[u]);
+        } /* end if */
+    VRFY((mismatches == 0), "dataset values verified");
+
+    HDfree(check);
+}
+
+void
+coll_chunk_owner(void)
+{
+    const char *filename = GetTestParameters();
+    hid_t file, dataset;                /* HDF5 IDs */
+    hid_t fapl, dcpl, dxpl;             /* Property list IDs */
+    hid_t file_space, mem_space;        /* Dataspace IDs */
+    hsize_t dims[2];                    /* Dataset dimensions */
+    hsize_t chunk_dims[2] = {OWNER_CHUNK1, OWNER_CHUNK2};
+    hsize_t start[2], stride[2], count[2], block[2];
+    hsize_t mem_dims[1];
+    hsize_t i, j;                       /* Local index variables */
+    H5D_mpio_actual_chunk_opt_mode_t actual_chunk_opt_mode;
+    H5D_mpio_actual_io_mode_t actual_io_mode;
+    int *expected;                      /* Expected dataset values */
+    int *wbuf;                          /* Write buffer */
+    size_t n;                           /* Number of elements written */
+    int mpi_rank, mpi_size;
+    herr_t ret;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+
+    /* Make the column count a non-multiple of the chunk size */
+    dims[0] = OWNER_DIM1;
+    dims[1] = (hsize_t)(OWNER_CHUNK2 * mpi_size + 3);
+
+    expected = (int *)HDcalloc((size_t)(dims[0] * dims[1]), sizeof(int));
+    VRFY((expected != NULL), "HDcalloc succeeded");
+    wbuf = (int *)HDmalloc((size_t)(dims[0] * dims[1]) * sizeof(int));
+    VRFY((wbuf != NULL), "HDmalloc succeeded");
+
+    fapl = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+    VRFY((fapl >= 0), "create_faccess_plist succeeded");
+    file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    VRFY((file >= 0), "H5Fcreate succeeded");
+
+    dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    VRFY((dcpl >= 0), "H5Pcreate succeeded");
+    ret = H5Pset_chunk(dcpl, 2, chunk_dims);
+    VRFY((ret >= 0), "H5Pset_chunk succeeded");
+
+    file_space = H5Screate_simple(2, dims, NULL);
+    VRFY((file_space >= 0), "H5Screate_simple succeeded");
+    dataset = H5Dcreate2(file, DSET_COLLECTIVE_CHUNK_NAME, H5T_NATIVE_INT,
+            file_space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    VRFY((dataset >= 0), "H5Dcreate2 succeeded");
+
+    dxpl = H5Pcreate(H5P_DATASET_XFER);
+    VRFY((dxpl >= 0), "H5Pcreate succeeded");
+    ret = H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+    VRFY((ret >= 0), "H5Pset_dxpl_mpio succeeded");
+    ret = H5Pset_dxpl_mpio_chunk_opt(dxpl, H5FD_MPIO_CHUNK_OWNER_IO);
+    VRFY((ret >= 0), "H5Pset_dxpl_mpio_chunk_opt succeeded");
+
+    /* First write: interleaved columns, every chunk shared by all processes */
+    start[0] = 0;
+    start[1] = (hsize_t)mpi_rank;
+    stride[0] = 1;
+    stride[1] = (hsize_t)mpi_size;
+    count[0] = dims[0];
+    count[1] = (dims[1] - (hsize_t)mpi_rank + (hsize_t)mpi_size - 1) / (hsize_t)mpi_size;
+    block[0] = block[1] = 1;
+    ret = H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, stride, count, block);
+    VRFY((ret >= 0), "H5Sselect_hyperslab succeeded");
+
+    n = 0;
+    for(i = 0; i < dims[0]; i++)
+        for(j = (hsize_t)mpi_rank; j < dims[1]; j += (hsize_t)mpi_size)
+            wbuf[n++] = (int)(i * 1000 + j + 1);
+    for(i = 0; i < dims[0]; i++)
+        for(j = 0; j < dims[1]; j++)
+            expected[i * dims[1] + j] = (int)(i * 1000 + j + 1);
+
+    mem_dims[0] = (hsize_t)n;
+    mem_space = H5Screate_simple(1, mem_dims, NULL);
+    VRFY((mem_space >= 0), "H5Screate_simple succeeded");
+
+    ret = H5Dwrite(dataset, H5T_NATIVE_INT, mem_space, file_space, dxpl, wbuf);
+    VRFY((ret >= 0), "H5Dwrite succeeded");
+    ret = H5Sclose(mem_space);
+    VRFY((ret >= 0), "H5Sclose succeeded");
+
+    ret = H5Pget_mpio_actual_chunk_opt_mode(dxpl, &actual_chunk_opt_mode);
+    VRFY((ret >= 0), "H5Pget_mpio_actual_chunk_opt_mode succeeded");
+    VRFY((actual_chunk_opt_mode == H5D_MPIO_LINK_CHUNK), "actual chunk optimization mode is link chunk");
+    ret = H5Pget_mpio_actual_io_mode(dxpl, &actual_io_mode);
+    VRFY((ret >= 0), "H5Pget_mpio_actual_io_mode succeeded");
+    VRFY((actual_io_mode == H5D_MPIO_CHUNK_COLLECTIVE), "actual I/O mode is chunk collective");
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    coll_chunk_owner_check(dataset, expected, dims[0] * dims[1]);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    /* Second write: bands of rows across chunk boundaries, last process
+     * selects nothing */
+    n = 0;
+    if(mpi_rank < mpi_size - 1) {
+        start[0] = (hsize_t)(1 + mpi_rank * OWNER_BAND);
+        start[1] = 1;
+        count[0] = OWNER_BAND;
+        count[1] = dims[1] - 2;
+        ret = H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
+        VRFY((ret >= 0), "H5Sselect_hyperslab succeeded");
+
+        for(i = start[0]; i < start[0] + count[0]; i++)
+            for(j = start[1]; j < start[1] + count[1]; j++) {
+                wbuf[n] = -(int)(i * 1000 + j + 1);
+                n++;
+            } /* end for */
+    } /* end if */
+    else {
+        ret = H5Sselect_none(file_space);
+        VRFY((ret >= 0), "H5Sselect_none succeeded");
+    } /* end else */
+    for(i = 1; i < (hsize_t)(1 + (mpi_size - 1) * OWNER_BAND) && i < dims[0]; i++)
+        for(j = 1; j < dims[1] - 1; j++)
+            expected[i * dims[1] + j] = -(int)(i * 1000 + j + 1);
+
+    mem_dims[0] = (hsize_t)n;
+    mem_space = H5Screate_simple(1, mem_dims, NULL);
+    VRFY((mem_space >= 0), "H5Screate_simple succeeded");
+    if(n == 0) {
+        ret = H5Sselect_none(mem_space);
+        VRFY((ret >= 0), "H5Sselect_none succeeded");
+    } /* end if */
+
+    ret = H5Dwrite(dataset, H5T_NATIVE_INT, mem_space, file_space, dxpl, wbuf);
+    VRFY((ret >= 0), "H5Dwrite succeeded");
+    ret = H5Sclose(mem_space);
+    VRFY((ret >= 0), "H5Sclose succeeded");
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    coll_chunk_owner_check(dataset, expected, dims[0] * dims[1]);
+
+    ret = H5Dclose(dataset);
+    VRFY((ret >= 0), "H5Dclose succeeded");
+    ret = H5Sclose(file_space);
+    VRFY((ret >= 0), "H5Sclose succeeded");
+    ret = H5Pclose(dxpl);
+    VRFY((ret >= 0), "H5Pclose succeeded");
+    ret = H5Pclose(dcpl);
+    VRFY((ret >= 0), "H5Pclose succeeded");
+    ret = H5Pclose(fapl);
+    VRFY((ret >= 0), "H5Pclose succeeded");
+    ret = H5Fclose(file);
+    VRFY((ret >= 0), "H5Fclose succeeded");
+
+    HDfree(wbuf);
+    HDfree(expected);
+}
+
+
 /*-------------------------------------------------------------------------
  * Function:	coll_chunktest
  *
@@ -2638,11 +2638,21 @@ compress_readAll(void)
                 nerrors++;
             }
 
-        /* Writing to the compressed, chunked dataset in parallel should fail */
-        H5E_BEGIN_TRY {
-            ret = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_read);
-        } H5E_END_TRY;
-        VRFY((ret < 0), "H5Dwrite failed");
+        /* Writing to the compressed, chunked dataset collectively should succeed */
+        for(u=0; u<dim; u++)
+            data_orig[u]=(int)(dim-u);
+        ret = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_orig);
+        VRFY((ret >= 0), "H5Dwrite succeeded");
+
+        /* Verify data written */
+        ret = H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_read);
+        VRFY((ret >= 0), "H5Dread succeeded");
+        for(u=0; u<dim; u++)
+            if(data_orig[u]!=data_read[u]) {
+                printf("Line #%d: written!=retrieved: data_orig[%u]=%d, data_read[%u]=%d\n",__LINE__,
+                    (unsigned)u,data_orig[u],(unsigned)u,data_read[u]);
+                nerrors++;
+            }
 
         ret = H5Pclose(xfer_plist);
         VRFY((ret >= 0), "H5Pclose succeeded");
@@ -95,3 +95,137 @@ test_split_comm_access(void)
 }
 
 
+
+/*
+ * Test collective metadata reads.  The file is created and populated with
+ * a group and a dataset, then re-opened with H5Pset_coll_metadata_read(),
+ * so that the metadata read by H5Fopen, H5Gopen2 and H5Dopen2 is read by
+ * process 0 and broadcast.  All processes must see the same, correct
+ * objects and data, including for objects whose metadata only some of
+ * the processes have in their caches.
+ */
+#define COLL_MD_READ_NELMTS     64
+void
+test_coll_md_read(void)
+{
+    int mpi_size, mpi_rank;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Info info = MPI_INFO_NULL;
+    hid_t fid, gid, did, sid;   /* HDF5 IDs */
+    H5O_info_t oinfo;           /* Object info */
+    hid_t acc_tpl;              /* File access properties */
+    hbool_t is_coll;            /* Collective metadata read setting */
+    int wbuf[COLL_MD_READ_NELMTS], rbuf[COLL_MD_READ_NELMTS];
+    hsize_t dims[1] = {COLL_MD_READ_NELMTS};
+    int i;
+    herr_t ret;                 /* generic return value */
+    const char *filename;
+
+    filename = (const char *)GetTestParameters();
+    if (VERBOSE_MED)
+	printf("Collective metadata read test on file %s\n", filename);
+
+    MPI_Comm_size(comm, &mpi_size);
+    MPI_Comm_rank(comm, &mpi_rank);
+
+    for(i = 0; i < COLL_MD_READ_NELMTS; i++)
+        wbuf[i] = i * 3 + 1;
+
+    /* Create the file and its objects */
+    acc_tpl = create_faccess_plist(comm, info, facc_type);
+    VRFY((acc_tpl >= 0), "");
+
+    /* The default is to read metadata independently */
+    ret = H5Pget_coll_metadata_read(acc_tpl, &is_coll);
+    VRFY((ret >= 0), "H5Pget_coll_metadata_read succeeded");
+    VRFY((is_coll == FALSE), "collective metadata reads are off by default");
+
+    fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, acc_tpl);
+    VRFY((fid >= 0), "H5Fcreate succeeded");
+    gid = H5Gcreate2(fid, "group", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    VRFY((gid >= 0), "H5Gcreate2 succeeded");
+    sid = H5Screate_simple(1, dims, NULL);
+    VRFY((sid >= 0), "H5Screate_simple succeeded");
+    did = H5Dcreate2(gid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    VRFY((did >= 0), "H5Dcreate2 succeeded");
+    ret = H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf);
+    VRFY((ret >= 0), "H5Dwrite succeeded");
+    ret = H5Dclose(did);
+    VRFY((ret >= 0), "");
+    ret = H5Gclose(gid);
+    VRFY((ret >= 0), "");
+    gid = H5Gcreate2(fid, "group2", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    VRFY((gid >= 0), "H5Gcreate2 succeeded");
+    did = H5Dcreate2(gid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    VRFY((did >= 0), "H5Dcreate2 succeeded");
+    ret = H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf);
+    VRFY((ret >= 0), "H5Dwrite succeeded");
+    ret = H5Dclose(did);
+    VRFY((ret >= 0), "");
+    ret = H5Sclose(sid);
+    VRFY((ret >= 0), "");
+    ret = H5Gclose(gid);
+    VRFY((ret >= 0), "");
+    ret = H5Fclose(fid);
+    VRFY((ret >= 0), "");
+
+    /* Re-open the file with collective metadata reads */
+    ret = H5Pset_coll_metadata_read(acc_tpl, TRUE);
+    VRFY((ret >= 0), "H5Pset_coll_metadata_read succeeded");
+    ret = H5Pget_coll_metadata_read(acc_tpl, &is_coll);
+    VRFY((ret >= 0), "H5Pget_coll_metadata_read succeeded");
+    VRFY((is_coll == TRUE), "collective metadata reads enabled");
+
+    fid = H5Fopen(filename, H5F_ACC_RDONLY, acc_tpl);
+    VRFY((fid >= 0), "H5Fopen succeeded");
+    gid = H5Gopen2(fid, "group", H5P_DEFAULT);
+    VRFY((gid >= 0), "H5Gopen2 succeeded");
+    did = H5Dopen2(gid, "dset", H5P_DEFAULT);
+    VRFY((did >= 0), "H5Dopen2 succeeded");
+
+    /* A failed lookup must fail on all processes alike */
+    H5E_BEGIN_TRY {
+        hid_t bad_did = H5Dopen2(gid, "no_such_dset", H5P_DEFAULT);
+
+        VRFY((bad_did < 0), "H5Dopen2 of missing dataset failed");
+    } H5E_END_TRY;
+
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    ret = H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf);
+    VRFY((ret >= 0), "H5Dread succeeded");
+    for(i = 0; i < COLL_MD_READ_NELMTS; i++)
+        VRFY((rbuf[i] == wbuf[i]), "data read back is correct");
+
+    ret = H5Dclose(did);
+    VRFY((ret >= 0), "");
+    ret = H5Gclose(gid);
+    VRFY((ret >= 0), "");
+
+    /* Load the second group's metadata into process 0's cache only, then
+     * open its objects collectively: the other processes must not wait
+     * for a broadcast from process 0, which doesn't read the metadata
+     */
+    if(mpi_rank == 0) {
+        ret = H5Oget_info_by_name(fid, "group2/dset", &oinfo, H5P_DEFAULT);
+        VRFY((ret >= 0), "H5Oget_info_by_name succeeded");
+    } /* end if */
+    gid = H5Gopen2(fid, "group2", H5P_DEFAULT);
+    VRFY((gid >= 0), "H5Gopen2 succeeded");
+    did = H5Dopen2(gid, "dset", H5P_DEFAULT);
+    VRFY((did >= 0), "H5Dopen2 succeeded");
+
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    ret = H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf);
+    VRFY((ret >= 0), "H5Dread succeeded");
+    for(i = 0; i < COLL_MD_READ_NELMTS; i++)
+        VRFY((rbuf[i] == wbuf[i]), "data read back is correct");
+
+    ret = H5Dclose(did);
+    VRFY((ret >= 0), "");
+    ret = H5Gclose(gid);
+    VRFY((ret >= 0), "");
+    ret = H5Fclose(fid);
+    VRFY((ret >= 0), "");
+    ret = H5Pclose(acc_tpl);
+    VRFY((ret >= 0), "");
+}
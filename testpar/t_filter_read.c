@@ -15,7 +15,8 @@
 
 /*
  * This verifies the correctness of parallel reading of a dataset that has been
- * written serially using filters.
+ * written serially using filters, and of collective writing to a dataset that
+ * uses filters.
  *
  * Created by: Christian Chilan
  * Date: 2007/05/15
@@ -192,6 +193,209 @@ filter_read_internal(const char *filename, hid_t dcpl,
     MPI_Barrier(MPI_COMM_WORLD);
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	filter_write_internal
+ *
+ * Purpose:     Tests collective writing of a 2D dataset using filters.  The
+ *              dataset is first written in vertical hyperslabs that don't
+ *              line up with the chunks, so several processes write to the
+ *              same chunks.  Then every process overwrites a few rows of
+ *              its neighbor's hyperslab, so the chunks touched must be
+ *              read, merged and filtered again.  Last, every process
+ *              writes the same part of two chunks, so that the selections
+ *              overlap.  The dataset is read back and compared with the
+ *              expected values.
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+filter_write_internal(const char *filename, hid_t dcpl)
+{
+    hid_t		file, dataset;        /* HDF5 IDs */
+    hid_t		access_plist;         /* Access property list ID */
+    hid_t		xfer_plist;           /* Transfer property list ID */
+    hid_t		sid, memspace;        /* Dataspace IDs */
+    hsize_t	        size[2];           /* Dataspace dimensions */
+    hsize_t	        hs_offset[2]; /* Hyperslab offset */
+    hsize_t	        hs_size[2];   /* Hyperslab size */
+    size_t		i, j;        /* Local index variables */
+    char                name[32] = "dataset";
+    herr_t              hrc;         /* Error status */
+    int                 *points = NULL; /* Expected values for entire dataset */
+    int                 *buf = NULL; /* Writing buffer for selected hyperslab */
+    int                 *check = NULL; /* Reading buffer for entire dataset */
+
+    /* set up MPI parameters */
+    MPI_Comm_size(MPI_COMM_WORLD,&mpi_size);
+    MPI_Comm_rank(MPI_COMM_WORLD,&mpi_rank);
+
+    /* set sizes for dataset and hyperslabs */
+    hs_size[0] = size[0] = HS_DIM1;
+    hs_size[1] = HS_DIM2;
+
+    size[1] = hs_size[1] * mpi_size;
+
+    hs_offset[0] = 0;
+    hs_offset[1] = hs_size[1] * mpi_rank;
+
+    /* Create the data space */
+    sid = H5Screate_simple(2, size, NULL);
+    VRFY(sid>=0, "H5Screate_simple");
+
+    memspace = H5Screate_simple(2, hs_size, NULL);
+    VRFY(memspace>=0, "H5Screate_simple");
+
+    /* Create buffers */
+    points = (int *)HDmalloc(size[0] * size[1] * sizeof(int));
+    VRFY(points!=NULL, "HDmalloc");
+
+    buf = (int *)HDmalloc(hs_size[0] * hs_size[1] * sizeof(int));
+    VRFY(buf!=NULL, "HDmalloc");
+
+    check = (int *)HDmalloc(size[0] * size[1] * sizeof(int));
+    VRFY(check!=NULL, "HDmalloc");
+
+    /* Initialize expected values & this process's part of them */
+    for(i = 0; i < size[0]; i++)
+        for(j = 0; j < size[1]; j++)
+            points[i * size[1]+j] = (int)(i+j+7);
+    for(i = 0; i < hs_size[0]; i++)
+        for(j = 0; j < hs_size[1]; j++)
+            buf[i * hs_size[1]+j] = points[i * size[1]+(size_t)hs_offset[1]+j];
+
+    VRFY(H5Pall_filters_avail(dcpl), "Incorrect filter availability");
+
+    /* Set up MPIO file access & collective transfer property lists */
+    access_plist = H5Pcreate(H5P_FILE_ACCESS);
+    VRFY((access_plist >= 0), "H5Pcreate");
+
+    hrc = H5Pset_fapl_mpio(access_plist, MPI_COMM_WORLD, MPI_INFO_NULL);
+    VRFY((hrc >= 0), "H5Pset_fapl_mpio");
+
+    xfer_plist = H5Pcreate(H5P_DATASET_XFER);
+    VRFY((xfer_plist >= 0), "H5Pcreate");
+
+    hrc = H5Pset_dxpl_mpio(xfer_plist, H5FD_MPIO_COLLECTIVE);
+    VRFY((hrc >= 0), "H5Pset_dxpl_mpio");
+
+    /* Create the file & dataset */
+    file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, access_plist);
+    VRFY((file >= 0), "H5Fcreate");
+
+    dataset = H5Dcreate2(file, name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    VRFY((dataset >= 0), "H5Dcreate2");
+
+    /* Write vertical hyperslabs */
+    hrc = H5Sselect_hyperslab(sid, H5S_SELECT_SET, hs_offset, NULL, hs_size, NULL);
+    VRFY(hrc>=0, "H5Sselect_hyperslab");
+
+    hrc = H5Dwrite(dataset, H5T_NATIVE_INT, memspace, sid, xfer_plist, buf);
+    VRFY(hrc>=0, "H5Dwrite");
+
+    /* Overwrite the first rows of the next process's hyperslab */
+    hs_size[0] = CHUNK_DIM1 + 2;
+    hs_offset[1] = hs_size[1] * (hsize_t)((mpi_rank + 1) % mpi_size);
+    for(i = 0; i < hs_size[0]; i++)
+        for(j = 0; j < hs_size[1]; j++) {
+            points[i * size[1]+(size_t)hs_offset[1]+j] = -(int)(i+j+(size_t)mpi_rank);
+            buf[i * hs_size[1]+j] = points[i * size[1]+(size_t)hs_offset[1]+j];
+        } /* end for */
+
+    hrc = H5Sselect_hyperslab(sid, H5S_SELECT_SET, hs_offset, NULL, hs_size, NULL);
+    VRFY(hrc>=0, "H5Sselect_hyperslab");
+
+    hrc = H5Sset_extent_simple(memspace, 2, hs_size, NULL);
+    VRFY(hrc>=0, "H5Sset_extent_simple");
+
+    hrc = H5Dwrite(dataset, H5T_NATIVE_INT, memspace, sid, xfer_plist, buf);
+    VRFY(hrc>=0, "H5Dwrite");
+
+    /* The other processes' overwrites are expected as well */
+    for(i = 0; i < hs_size[0]; i++)
+        for(j = 0; j < size[1]; j++)
+            points[i * size[1]+j] = -(int)(i+(j%HS_DIM2)+(size_t)((j/HS_DIM2+mpi_size-1)%mpi_size));
+
+    /* Have every process write the same values to all but the last row
+     *  of two chunks, so that the elements selected add up to more than
+     *  a chunk while the last row must be kept.
+     */
+    hs_offset[0] = CHUNK_DIM1 * 10;
+    hs_offset[1] = CHUNK_DIM2;
+    hs_size[0] = CHUNK_DIM1 - 1;
+    hs_size[1] = CHUNK_DIM2 * 2;
+    for(i = 0; i < hs_size[0]; i++)
+        for(j = 0; j < hs_size[1]; j++) {
+            points[(i+(size_t)hs_offset[0]) * size[1]+(size_t)hs_offset[1]+j] = (int)(i+j+1000);
+            buf[i * hs_size[1]+j] = points[(i+(size_t)hs_offset[0]) * size[1]+(size_t)hs_offset[1]+j];
+        } /* end for */
+
+    hrc = H5Sselect_hyperslab(sid, H5S_SELECT_SET, hs_offset, NULL, hs_size, NULL);
+    VRFY(hrc>=0, "H5Sselect_hyperslab");
+
+    hrc = H5Sset_extent_simple(memspace, 2, hs_size, NULL);
+    VRFY(hrc>=0, "H5Sset_extent_simple");
+
+    hrc = H5Dwrite(dataset, H5T_NATIVE_INT, memspace, sid, xfer_plist, buf);
+    VRFY(hrc>=0, "H5Dwrite");
+
+    hrc = H5Dclose(dataset);
+    VRFY(hrc>=0, "H5Dclose");
+
+    hrc = H5Fclose(file);
+    VRFY(hrc>=0, "H5Fclose");
+
+    /* Read back the whole dataset & check it */
+    file = H5Fopen(filename, H5F_ACC_RDONLY, access_plist);
+    VRFY((file >= 0), "H5Fopen");
+
+    dataset = H5Dopen2(file, name, H5P_DEFAULT);
+    VRFY((dataset >= 0), "H5Dopen2");
+
+    hrc = H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, check);
+    VRFY(hrc>=0, "H5Dread");
+
+    for(i = 0; i < size[0]; i++) {
+        for(j = 0; j < size[1]; j++) {
+            if(points[i*size[1]+j] != check[i*size[1]+j]) {
+		  fprintf(stderr,"    Read different values than written.\n");
+		  fprintf(stderr,"    At index %lu,%lu\n",
+		         (unsigned long)(i), (unsigned long)(j));
+		  fprintf(stderr,"    At original: %d\n",
+		         (int)points[i*size[1]+j]);
+		  fprintf(stderr,"    At returned: %d\n",
+		         (int)check[i*size[1]+j]);
+                  VRFY(FALSE, "");
+	    }
+	}
+    }
+
+    /* Clean up objects used for this test */
+    hrc = H5Dclose (dataset);
+    VRFY(hrc>=0, "H5Dclose");
+
+    hrc = H5Sclose (sid);
+    VRFY(hrc>=0, "H5Sclose");
+
+    hrc = H5Sclose (memspace);
+    VRFY(hrc>=0, "H5Sclose");
+
+    hrc = H5Pclose (access_plist);
+    VRFY(hrc>=0, "H5Pclose");
+
+    hrc = H5Pclose (xfer_plist);
+    VRFY(hrc>=0, "H5Pclose");
+
+    hrc = H5Fclose (file);
+    VRFY(hrc>=0, "H5Fclose");
+
+    HDfree(points);
+    HDfree(buf);
+    HDfree(check);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_filter_read
@@ -461,3 +665,95 @@ test_filter_read(void)
 #endif /* H5_HAVE_FILTER_SZIP && H5_HAVE_FILTER_SHUFFLE && H5_HAVE_FILTER_FLETCHER32 */
 }
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_filter_write
+ *
+ * Purpose:	Tests collective writing of datasets using several
+ *              (combinations of) filters.
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+test_filter_write(void)
+{
+    hid_t	dc;                 /* HDF5 IDs */
+    const hsize_t chunk_size[2] = {CHUNK_DIM1, CHUNK_DIM2};  /* Chunk dimensions */
+    herr_t      hrc;
+    const char *filename;
+
+    filename = GetTestParameters();
+
+    if(VERBOSE_MED)
+        printf("Collective writing of dataset with filters %s\n", filename);
+
+    /*----------------------------------------------------------
+     * STEP 1: Test Fletcher32 Checksum by itself.
+     *----------------------------------------------------------
+     */
+#ifdef H5_HAVE_FILTER_FLETCHER32
+    dc = H5Pcreate(H5P_DATASET_CREATE);
+    VRFY(dc>=0, "H5Pcreate");
+
+    hrc = H5Pset_chunk (dc, 2, chunk_size);
+    VRFY(hrc>=0, "H5Pset_chunk");
+
+    hrc = H5Pset_fletcher32 (dc);
+    VRFY(hrc>=0, "H5Pset_fletcher32");
+
+    filter_write_internal(filename,dc);
+
+    /* Clean up objects used for this test */
+    hrc = H5Pclose (dc);
+    VRFY(hrc>=0, "H5Pclose");
+#endif /* H5_HAVE_FILTER_FLETCHER32 */
+
+    /*----------------------------------------------------------
+     * STEP 2: Test deflation by itself.
+     *----------------------------------------------------------
+     */
+#ifdef H5_HAVE_FILTER_DEFLATE
+    dc = H5Pcreate(H5P_DATASET_CREATE);
+    VRFY(dc>=0, "H5Pcreate");
+
+    hrc = H5Pset_chunk (dc, 2, chunk_size);
+    VRFY(hrc>=0, "H5Pset_chunk");
+
+    hrc = H5Pset_deflate (dc, 6);
+    VRFY(hrc>=0, "H5Pset_deflate");
+
+    filter_write_internal(filename,dc);
+
+    /* Clean up objects used for this test */
+    hrc = H5Pclose (dc);
+    VRFY(hrc>=0, "H5Pclose");
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+    /*----------------------------------------------------------
+     * STEP 3: Test shuffle + deflate + checksum.
+     *----------------------------------------------------------
+     */
+#if defined H5_HAVE_FILTER_DEFLATE && defined H5_HAVE_FILTER_SHUFFLE && defined H5_HAVE_FILTER_FLETCHER32
+    dc = H5Pcreate(H5P_DATASET_CREATE);
+    VRFY(dc>=0, "H5Pcreate");
+
+    hrc = H5Pset_chunk (dc, 2, chunk_size);
+    VRFY(hrc>=0, "H5Pset_chunk");
+
+    hrc = H5Pset_shuffle (dc);
+    VRFY(hrc>=0, "H5Pset_shuffle");
+
+    hrc = H5Pset_deflate (dc, 6);
+    VRFY(hrc>=0, "H5Pset_deflate");
+
+    hrc = H5Pset_fletcher32 (dc);
+    VRFY(hrc>=0, "H5Pset_fletcher32");
+
+    filter_write_internal(filename,dc);
+
+    /* Clean up objects used for this test */
+    hrc = H5Pclose (dc);
+    VRFY(hrc>=0, "H5Pclose");
+#endif /* H5_HAVE_FILTER_DEFLATE && H5_HAVE_FILTER_SHUFFLE && H5_HAVE_FILTER_FLETCHER32 */
+}
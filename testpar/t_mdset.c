@@ -220,6 +220,125 @@ void multiple_dset_write(void)
 }
 
 
+/*
+ * Example of using H5Dwrite_multi() and H5Dread_multi() to transfer
+ * several datasets with one collective call.  The contiguous datasets are
+ * combined into one MPI-IO operation, the chunked one is transferred on
+ * its own.  The last read names the first dataset twice, so the combined
+ * pieces overlap.
+ */
+void multi_dset_io(void)
+{
+    int mpi_size, mpi_rank;
+    hid_t fid, acc_tpl, xfer_plist, dcpl;
+    hid_t filespace, memspace;
+    hid_t dsets[NDATASET + 1], mem_types[NDATASET + 1];
+    hid_t mem_spaces[NDATASET + 1], file_spaces[NDATASET + 1];
+    const void *wbufs[NDATASET];
+    void *rbufs[NDATASET + 1];
+    hsize_t dims[1], start[1], count[1], chunk_dims[1];
+    int *wbuf = NULL, *rbuf = NULL;
+    char dname[100];
+    int i, n;
+    herr_t ret;
+    const char *filename;
+
+    filename = GetTestParameters();
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+
+    wbuf = (int *)HDmalloc(NDATASET * SIZE * sizeof(int));
+    VRFY((wbuf != NULL), "HDmalloc succeeded for wbuf");
+    rbuf = (int *)HDmalloc((NDATASET + 1) * (size_t)mpi_size * SIZE * sizeof(int));
+    VRFY((rbuf != NULL), "HDmalloc succeeded for rbuf");
+
+    acc_tpl = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+    VRFY((acc_tpl >= 0), "create_faccess_plist succeeded");
+    fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, acc_tpl);
+    VRFY((fid >= 0), "H5Fcreate succeeded");
+    ret = H5Pclose(acc_tpl);
+    VRFY((ret >= 0), "H5Pclose succeeded");
+
+    /* Each process writes its own block of every dataset */
+    dims[0] = (hsize_t)mpi_size * SIZE;
+    filespace = H5Screate_simple(1, dims, NULL);
+    VRFY((filespace >= 0), "H5Screate_simple succeeded");
+    start[0] = (hsize_t)mpi_rank * SIZE;
+    count[0] = SIZE;
+    ret = H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start, NULL, count, NULL);
+    VRFY((ret >= 0), "H5Sselect_hyperslab succeeded");
+    memspace = H5Screate_simple(1, count, NULL);
+    VRFY((memspace >= 0), "H5Screate_simple succeeded");
+
+    dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    VRFY((dcpl >= 0), "H5Pcreate succeeded");
+    chunk_dims[0] = SIZE;
+    ret = H5Pset_chunk(dcpl, 1, chunk_dims);
+    VRFY((ret >= 0), "H5Pset_chunk succeeded");
+
+    for(n = 0; n < NDATASET; n++) {
+        sprintf(dname, "dataset %d", n);
+        dsets[n] = H5Dcreate2(fid, dname, H5T_NATIVE_INT, filespace, H5P_DEFAULT,
+                (n == NDATASET - 1 ? dcpl : H5P_DEFAULT), H5P_DEFAULT);
+        VRFY((dsets[n] >= 0), "H5Dcreate2 succeeded");
+
+        for(i = 0; i < SIZE; i++)
+            wbuf[n * SIZE + i] = n * 100000 + mpi_rank * SIZE + i;
+        mem_types[n] = H5T_NATIVE_INT;
+        mem_spaces[n] = memspace;
+        file_spaces[n] = filespace;
+        wbufs[n] = wbuf + n * SIZE;
+    }
+
+    xfer_plist = H5Pcreate(H5P_DATASET_XFER);
+    VRFY((xfer_plist >= 0), "H5Pcreate xfer succeeded");
+    ret = H5Pset_dxpl_mpio(xfer_plist, H5FD_MPIO_COLLECTIVE);
+    VRFY((ret >= 0), "H5Pset_dxpl_mpio succeeded");
+    if(dxfer_coll_type == DXFER_INDEPENDENT_IO) {
+        ret = H5Pset_dxpl_mpio_collective_opt(xfer_plist, H5FD_MPIO_INDIVIDUAL_IO);
+        VRFY((ret >= 0), "set independent IO collectively succeeded");
+    }
+
+    ret = H5Dwrite_multi((size_t)NDATASET, dsets, mem_types, mem_spaces, file_spaces, xfer_plist, wbufs);
+    VRFY((ret >= 0), "H5Dwrite_multi succeeded");
+
+    ret = H5Fflush(fid, H5F_SCOPE_GLOBAL);
+    VRFY((ret >= 0), "H5Fflush succeeded");
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    /* Every process reads all of every dataset, and the first one twice */
+    dsets[NDATASET] = dsets[0];
+    mem_types[NDATASET] = H5T_NATIVE_INT;
+    for(n = 0; n <= NDATASET; n++) {
+        mem_spaces[n] = H5S_ALL;
+        file_spaces[n] = H5S_ALL;
+        rbufs[n] = rbuf + n * mpi_size * SIZE;
+    }
+    HDmemset(rbuf, 0, (NDATASET + 1) * (size_t)mpi_size * SIZE * sizeof(int));
+
+    ret = H5Dread_multi((size_t)(NDATASET + 1), dsets, mem_types, mem_spaces, file_spaces, xfer_plist, rbufs);
+    VRFY((ret >= 0), "H5Dread_multi succeeded");
+
+    for(n = 0; n <= NDATASET; n++)
+        for(i = 0; i < mpi_size * SIZE; i++)
+            VRFY((rbuf[n * mpi_size * SIZE + i] == (n % NDATASET) * 100000 + i), "data read matches data written");
+
+    for(n = 0; n < NDATASET; n++) {
+        ret = H5Dclose(dsets[n]);
+        VRFY((ret >= 0), "H5Dclose succeeded");
+    }
+    H5Pclose(xfer_plist);
+    H5Pclose(dcpl);
+    H5Sclose(memspace);
+    H5Sclose(filespace);
+    H5Fclose(fid);
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+}
+
+
 /* Example of using PHDF5 to create, write, and read compact dataset.
  *
  * Changes:	Updated function to use a dynamically calculated size,
@@ -2608,6 +2727,126 @@ void rr_obj_hdr_flush_confusion_reader(MPI_Comm comm)
 #undef Writer_Root
 #undef Reader_Root
 
+/*
+ * Test the metadata writes done at metadata cache sync points, where the
+ * entries flushed by all processes are written with one collective write.
+ * A small dirty bytes threshold makes sync points frequent, with long
+ * candidate lists while objects are created; changing one attribute at a
+ * time and flushing then gives candidate lists shorter than the number of
+ * processes, so some processes have nothing to write.  The file is reopened
+ * with the default cache configuration to check what reached it.
+ */
+#define MDWAGG_NGROUPS          64
+#define MDWAGG_DIRTY_BYTES      4096
+
+void md_write_aggregation(void)
+{
+    int mpi_rank;
+    int i, val;
+    char gname[32];
+    hid_t fapl, fid, gid, sid, aid;
+    H5AC_cache_config_t mdc_config;
+    H5G_info_t ginfo;
+    herr_t ret;
+    const char *filename;
+
+    filename = (const char *)GetTestParameters();
+    HDassert(filename != NULL);
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+
+    fapl = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+    VRFY((fapl >= 0), "create_faccess_plist succeeded");
+
+    mdc_config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    ret = H5Pget_mdc_config(fapl, &mdc_config);
+    VRFY((ret >= 0), "H5Pget_mdc_config succeeded");
+    mdc_config.dirty_bytes_threshold = MDWAGG_DIRTY_BYTES;
+    mdc_config.metadata_write_strategy = H5AC_METADATA_WRITE_STRATEGY__DISTRIBUTED;
+    ret = H5Pset_mdc_config(fapl, &mdc_config);
+    VRFY((ret >= 0), "H5Pset_mdc_config succeeded");
+
+    fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    VRFY((fid >= 0), "H5Fcreate succeeded");
+
+    sid = H5Screate(H5S_SCALAR);
+    VRFY((sid >= 0), "H5Screate succeeded");
+
+    /* many new objects: long candidate lists, spread over all processes */
+    for(i = 0; i < MDWAGG_NGROUPS; i++) {
+        sprintf(gname, "group%d", i);
+        gid = H5Gcreate2(fid, gname, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        VRFY((gid >= 0), "H5Gcreate2 succeeded");
+        aid = H5Acreate2(gid, "value", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT);
+        VRFY((aid >= 0), "H5Acreate2 succeeded");
+        val = i;
+        ret = H5Awrite(aid, H5T_NATIVE_INT, &val);
+        VRFY((ret >= 0), "H5Awrite succeeded");
+        ret = H5Aclose(aid);
+        VRFY((ret >= 0), "H5Aclose succeeded");
+        ret = H5Gclose(gid);
+        VRFY((ret >= 0), "H5Gclose succeeded");
+    }
+
+    /* one change per flush: short candidate lists */
+    for(i = 0; i < MDWAGG_NGROUPS; i++) {
+        sprintf(gname, "group%d", i);
+        gid = H5Gopen2(fid, gname, H5P_DEFAULT);
+        VRFY((gid >= 0), "H5Gopen2 succeeded");
+        aid = H5Aopen(gid, "value", H5P_DEFAULT);
+        VRFY((aid >= 0), "H5Aopen succeeded");
+        val = 2 * i;
+        ret = H5Awrite(aid, H5T_NATIVE_INT, &val);
+        VRFY((ret >= 0), "H5Awrite succeeded");
+        ret = H5Aclose(aid);
+        VRFY((ret >= 0), "H5Aclose succeeded");
+        ret = H5Gclose(gid);
+        VRFY((ret >= 0), "H5Gclose succeeded");
+        ret = H5Fflush(fid, H5F_SCOPE_GLOBAL);
+        VRFY((ret >= 0), "H5Fflush succeeded");
+    }
+
+    ret = H5Sclose(sid);
+    VRFY((ret >= 0), "H5Sclose succeeded");
+    ret = H5Fclose(fid);
+    VRFY((ret >= 0), "H5Fclose succeeded");
+    ret = H5Pclose(fapl);
+    VRFY((ret >= 0), "H5Pclose succeeded");
+
+    /* reopen with the default cache configuration and check everything */
+    fapl = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+    VRFY((fapl >= 0), "create_faccess_plist succeeded");
+    fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl);
+    VRFY((fid >= 0), "H5Fopen succeeded");
+
+    ret = H5Gget_info(fid, &ginfo);
+    VRFY((ret >= 0), "H5Gget_info succeeded");
+    VRFY((ginfo.nlinks == MDWAGG_NGROUPS), "all the groups are in the file");
+
+    for(i = 0; i < MDWAGG_NGROUPS; i++) {
+        sprintf(gname, "group%d", i);
+        gid = H5Gopen2(fid, gname, H5P_DEFAULT);
+        VRFY((gid >= 0), "H5Gopen2 succeeded");
+        aid = H5Aopen(gid, "value", H5P_DEFAULT);
+        VRFY((aid >= 0), "H5Aopen succeeded");
+        ret = H5Aread(aid, H5T_NATIVE_INT, &val);
+        VRFY((ret >= 0), "H5Aread succeeded");
+        VRFY((val == 2 * i), "attribute value is the last one written");
+        ret = H5Aclose(aid);
+        VRFY((ret >= 0), "H5Aclose succeeded");
+        ret = H5Gclose(gid);
+        VRFY((ret >= 0), "H5Gclose succeeded");
+    }
+
+    ret = H5Fclose(fid);
+    VRFY((ret >= 0), "H5Fclose succeeded");
+    ret = H5Pclose(fapl);
+    VRFY((ret >= 0), "H5Pclose succeeded");
+} /* md_write_aggregation() */
+
+#undef MDWAGG_NGROUPS
+#undef MDWAGG_DIRTY_BYTES
+
 /*=============================================================================
  *                         End of t_mdset.c
  *===========================================================================*/
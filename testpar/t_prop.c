@@ -138,7 +138,8 @@ test_plist_ed(void)
         FALSE,
         0.2f,
         (256 * 2048),
-        H5AC__DEFAULT_METADATA_WRITE_STRATEGY};
+        H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+        H5C_rp__lru};
 
     herr_t ret;         	/* Generic return value */
 
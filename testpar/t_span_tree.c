@@ -2858,3 +2858,225 @@ link_chunk_collective_io_test(void)
 
 } /* link_chunk_collective_io_test() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:	coll_irregular_reuse_test
+ *
+ * Purpose:	Issue repeated collective writes and reads through the same
+ *		irregular hyperslab selection, then change the selection
+ *		and its offset between writes, and finally repeat the first
+ *		selection through dataspaces created afresh for each write.
+ *		The MPI derived datatype built for a selection is cached and
+ *		reused for any dataspace with the same selection, so this
+ *		checks both the reused datatype and that a changed selection
+ *		is not served a stale one.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#define COLL_REUSE_REGION       16      /* Elements of the dataset owned by each process */
+#define COLL_REUSE_NELMTS       8       /* Elements selected by each process */
+#define COLL_REUSE_NITERS       4       /* Number of writes with an unchanged selection */
+
+static void
+coll_irregular_reuse_select(hid_t sid, hsize_t base, const hsize_t *starts,
+    const hsize_t *blocks, int nblocks)
+{
+    hsize_t start[1];
+    hsize_t count[1] = {1};
+    int     b;
+    int     mpi_rank;
+    herr_t  ret;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+
+    for(b = 0; b < nblocks; b++) {
+        start[0] = base + starts[b];
+        ret = H5Sselect_hyperslab(sid, (b == 0 ? H5S_SELECT_SET : H5S_SELECT_OR),
+                                  start, NULL, count, &blocks[b]);
+        VRFY((ret >= 0), "H5Sselect_hyperslab succeeded");
+    }
+}
+
+static void
+coll_irregular_reuse_check(hid_t dset_id, const int *expected, int *rbuf,
+    hsize_t nelmts)
+{
+    hsize_t u;
+    int     mismatches = 0;
+    int     mpi_rank;
+    herr_t  ret;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+
+    /* Wait for every process' write to complete */
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    /* Read the whole dataset independently and compare with the model */
+    ret = H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf);
+    VRFY((ret >= 0), "H5Dread of whole dataset succeeded");
+
+    for(u = 0; u < nelmts; u++)
+        if(rbuf[u] != expected[u])
+            mismatches++;
+    VRFY((mismatches == 0), "dataset contents match");
+}
+
+void
+coll_irregular_reuse_test(void)
+{
+    const char *filename;
+    /* Selection A: [0,3) and [5,10) of each region */
+    const hsize_t a_starts[2] = {0, 5};
+    const hsize_t a_blocks[2] = {3, 5};
+    /* Selection B: [1,2), [3,5) and [11,16) of each region */
+    const hsize_t b_starts[3] = {1, 3, 11};
+    const hsize_t b_blocks[3] = {1, 2, 5};
+    /* Selection C: the regular block [0,8) of each region */
+    const hsize_t c_starts[1] = {0};
+    const hsize_t c_blocks[1] = {8};
+    hssize_t   offset[1];
+    hsize_t    dims[1];
+    hsize_t    mdims[1] = {COLL_REUSE_NELMTS};
+    hsize_t    base;
+    hsize_t    coords[COLL_REUSE_NELMTS];
+    hsize_t    u;
+    int        wbuf[COLL_REUSE_NELMTS];
+    int        rbuf[COLL_REUSE_NELMTS];
+    int       *expected = NULL;
+    int       *whole = NULL;
+    int        mpi_rank, mpi_size;
+    int        iter, r, i;
+    int        mismatches;
+    hid_t      file_id, dset_id, fsid, msid, acc_tpl, dxpl;
+    herr_t     ret;
+
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+
+    filename = (const char *)GetTestParameters();
+    HDassert(filename != NULL);
+
+    dims[0] = (hsize_t)mpi_size * COLL_REUSE_REGION;
+    expected = (int *)HDcalloc((size_t)dims[0], sizeof(int));
+    whole = (int *)HDmalloc((size_t)dims[0] * sizeof(int));
+    VRFY((expected != NULL && whole != NULL), "buffer allocation succeeded");
+
+    acc_tpl = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+    VRFY((acc_tpl >= 0), "create_faccess_plist() succeeded");
+
+    file_id = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, acc_tpl);
+    VRFY((file_id >= 0), "H5Fcreate succeeded");
+
+    ret = H5Pclose(acc_tpl);
+    VRFY((ret >= 0), "H5Pclose(acc_tpl) succeeded");
+
+    fsid = H5Screate_simple(1, dims, NULL);
+    VRFY((fsid >= 0), "H5Screate_simple(fsid) succeeded");
+
+    msid = H5Screate_simple(1, mdims, NULL);
+    VRFY((msid >= 0), "H5Screate_simple(msid) succeeded");
+
+    dset_id = H5Dcreate2(file_id, "reuse", H5T_NATIVE_INT, fsid, H5P_DEFAULT,
+                         H5P_DEFAULT, H5P_DEFAULT);
+    VRFY((dset_id >= 0), "H5Dcreate2 succeeded");
+
+    /* Zero the dataset, so unselected elements have known contents */
+    ret = H5Dwrite(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, expected);
+    VRFY((ret >= 0), "H5Dwrite of zeros succeeded");
+
+    dxpl = H5Pcreate(H5P_DATASET_XFER);
+    VRFY((dxpl >= 0), "H5Pcreate(H5P_DATASET_XFER) succeeded");
+    ret = H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+    VRFY((ret >= 0), "H5Pset_dxpl_mpio succeeded");
+
+    base = (hsize_t)mpi_rank * COLL_REUSE_REGION;
+
+    /* Five phases: irregular selection A repeatedly, irregular selection
+     * B, regular selection C, selection C shifted by an offset of 6
+     * elements (to [6,14)), then selection A again through new dataspaces.
+     */
+    for(iter = 0; iter < COLL_REUSE_NITERS + 5; iter++) {
+        const hsize_t *starts = a_starts;
+        const hsize_t *blocks = a_blocks;
+        int nblocks = 2;
+        hsize_t shift = 0;
+
+        if(iter == COLL_REUSE_NITERS) {
+            starts = b_starts; blocks = b_blocks; nblocks = 3;
+        }
+        else if(iter > COLL_REUSE_NITERS && iter < COLL_REUSE_NITERS + 3) {
+            starts = c_starts; blocks = c_blocks; nblocks = 1;
+            if(iter == COLL_REUSE_NITERS + 2)
+                shift = 6;
+        }
+        else if(iter >= COLL_REUSE_NITERS + 3) {
+            /* Replace the file dataspace, closing the one used so far */
+            ret = H5Sclose(fsid);
+            VRFY((ret >= 0), "H5Sclose(fsid) succeeded");
+            fsid = H5Screate_simple(1, dims, NULL);
+            VRFY((fsid >= 0), "H5Screate_simple(fsid) succeeded");
+        }
+
+        /* Only change the selection when entering a new phase, or on a new
+         * dataspace */
+        if(iter == 0 || iter == COLL_REUSE_NITERS || iter == COLL_REUSE_NITERS + 1
+                || iter >= COLL_REUSE_NITERS + 3)
+            coll_irregular_reuse_select(fsid, base, starts, blocks, nblocks);
+        offset[0] = (hssize_t)shift;
+        ret = H5Soffset_simple(fsid, offset);
+        VRFY((ret >= 0), "H5Soffset_simple succeeded");
+
+        for(i = 0; i < COLL_REUSE_NELMTS; i++)
+            wbuf[i] = (iter + 1) * 1000 + mpi_rank * 100 + i;
+
+        ret = H5Dwrite(dset_id, H5T_NATIVE_INT, msid, fsid, dxpl, wbuf);
+        VRFY((ret >= 0), "collective H5Dwrite succeeded");
+
+        /* Read the selection back collectively, through the same dataspaces */
+        HDmemset(rbuf, 0, sizeof(rbuf));
+        ret = H5Dread(dset_id, H5T_NATIVE_INT, msid, fsid, dxpl, rbuf);
+        VRFY((ret >= 0), "collective H5Dread succeeded");
+        mismatches = 0;
+        for(i = 0; i < COLL_REUSE_NELMTS; i++)
+            if(rbuf[i] != wbuf[i])
+                mismatches++;
+        VRFY((mismatches == 0), "collective read matches write");
+
+        /* Update the model with every process' write: each process writes
+         * its buffer to its selected elements in increasing file order.
+         */
+        for(r = 0; r < mpi_size; r++) {
+            int b, n = 0;
+
+            /* Collect the coordinates in file order (the blocks don't overlap) */
+            for(u = 0; u < COLL_REUSE_REGION; u++)
+                for(b = 0; b < nblocks; b++)
+                    if(u >= starts[b] && u < starts[b] + blocks[b])
+                        coords[n++] = (hsize_t)r * COLL_REUSE_REGION + u + shift;
+            HDassert(n == COLL_REUSE_NELMTS);
+
+            for(i = 0; i < COLL_REUSE_NELMTS; i++)
+                expected[coords[i]] = (iter + 1) * 1000 + r * 100 + i;
+        }
+
+        coll_irregular_reuse_check(dset_id, expected, whole, dims[0]);
+    }
+
+    ret = H5Pclose(dxpl);
+    VRFY((ret >= 0), "H5Pclose(dxpl) succeeded");
+    ret = H5Sclose(msid);
+    VRFY((ret >= 0), "H5Sclose(msid) succeeded");
+    ret = H5Sclose(fsid);
+    VRFY((ret >= 0), "H5Sclose(fsid) succeeded");
+    ret = H5Dclose(dset_id);
+    VRFY((ret >= 0), "H5Dclose succeeded");
+    ret = H5Fclose(file_id);
+    VRFY((ret >= 0), "H5Fclose succeeded");
+
+    HDfree(expected);
+    HDfree(whole);
+} /* coll_irregular_reuse_test() */
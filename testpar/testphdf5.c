@@ -347,6 +347,9 @@ int main(int argc, char **argv)
     AddTest("split", test_split_comm_access, NULL,
 	    "dataset using split communicators", PARATESTFILE);
 
+    AddTest("collmdread", test_coll_md_read, NULL,
+	    "collective metadata reads", PARATESTFILE);
+
     AddTest("idsetw", dataset_writeInd, NULL,
 	    "dataset independent write", PARATESTFILE);
     AddTest("idsetr", dataset_readInd, NULL,
@@ -373,6 +376,8 @@ int main(int argc, char **argv)
             "parallel extend Chunked allocation on serial file", PARATESTFILE);
     AddTest("fltread", test_filter_read, NULL,
 	    "parallel read of dataset written serially with filters", PARATESTFILE);
+    AddTest("fltwrite", test_filter_write, NULL,
+	    "collective write of dataset with filters", PARATESTFILE);
 
 #ifdef H5_HAVE_FILTER_DEFLATE
     AddTest("cmpdsetr", compress_readAll, NULL,
@@ -386,6 +391,8 @@ int main(int argc, char **argv)
     ndsets_params.count = ndatasets;
     AddTest("ndsetw", multiple_dset_write, NULL,
 	    "multiple datasets write", &ndsets_params);
+    AddTest("mdsetio", multi_dset_io, NULL,
+	    "multi-dataset read and write calls", PARATESTFILE);
 
     ngroups_params.name = PARATESTFILE;
     ngroups_params.count = ngroups;
@@ -444,6 +451,9 @@ int main(int argc, char **argv)
     AddTest((mpi_size < 3)? "-cchunk10" : "cchunk10",
 	coll_chunk10,NULL,
 	"multiple chunk collective IO transferring to independent IO",PARATESTFILE);
+    AddTest("cchunkown",
+	coll_chunk_owner,NULL,
+	"collective chunk IO with single-owner chunk writes",PARATESTFILE);
 
 
 
@@ -499,6 +509,11 @@ int main(int argc, char **argv)
             "test mpi derived type management", 
             PARATESTFILE);
 
+    AddTest("ccreuse",
+            coll_irregular_reuse_test, NULL,
+            "test mpi derived type reuse for unchanged selections",
+            PARATESTFILE);
+
     AddTest("actualio", actual_io_mode_tests, NULL,
             "test actual io mode proprerty",
             PARATESTFILE);
@@ -532,6 +547,9 @@ int main(int argc, char **argv)
     AddTest("denseattr", test_dense_attr, NULL,
 	    "Store Dense Attributes", PARATESTFILE);
 
+    AddTest("mdwagg", md_write_aggregation, NULL,
+	    "metadata writes aggregated at sync points", PARATESTFILE);
+
 
     /* Display testing information */
     TestInfo(argv[0]);
@@ -239,12 +239,14 @@ extern int dxfer_coll_type;
 void test_plist_ed(void);
 void zero_dim_dset(void);
 void multiple_dset_write(void);
+void multi_dset_io(void);
 void multiple_group_write(void);
 void multiple_group_read(void);
 void collective_group_write(void);
 void independent_group_read(void);
 void test_fapl_mpio_dup(void);
 void test_split_comm_access(void);
+void test_coll_md_read(void);
 void dataset_atomicity(void);
 void dataset_writeInd(void);
 void dataset_writeAll(void);
@@ -260,6 +262,7 @@ void actual_io_mode_tests(void);
 void no_collective_cause_tests(void);
 void test_chunk_alloc(void);
 void test_filter_read(void);
+void test_filter_write(void);
 void compact_dataset(void);
 void null_dataset(void);
 void big_dataset(void);
@@ -274,6 +277,7 @@ void coll_chunk7(void);
 void coll_chunk8(void);
 void coll_chunk9(void);
 void coll_chunk10(void);
+void coll_chunk_owner(void);
 void coll_irregular_cont_read(void);
 void coll_irregular_cont_write(void);
 void coll_irregular_simple_chunk_read(void);
@@ -284,8 +288,10 @@ void io_mode_confusion(void);
 void rr_obj_hdr_flush_confusion(void);
 void rr_obj_hdr_flush_confusion_reader(MPI_Comm comm);
 void rr_obj_hdr_flush_confusion_writer(MPI_Comm comm);
+void md_write_aggregation(void);
 void lower_dim_size_comp_test(void);
 void link_chunk_collective_io_test(void);
+void coll_irregular_reuse_test(void);
 void contig_hyperslab_dr_pio_test(ShapeSameTestMethods sstest_type);
 void checker_board_hyperslab_dr_pio_test(ShapeSameTestMethods sstest_type);
 void file_image_daisy_chain_test(void);
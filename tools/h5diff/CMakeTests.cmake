@@ -50,6 +50,8 @@
       ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/compounds_array_vlen2.h5
       ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/non_comparables1.h5
       ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/non_comparables2.h5
+      ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/h5diff_blocks1.h5
+      ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/h5diff_blocks2.h5
   )
 
   set (LIST_OTHER_TEST_FILES
@@ -217,6 +219,9 @@
       ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/h5diff_644.txt
       ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/h5diff_645.txt
       ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/h5diff_646.txt
+      ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/h5diff_650.txt
+      ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/h5diff_651.txt
+      ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/h5diff_652.txt
       ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/h5diff_70.txt
       ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/h5diff_700.txt
       ${HDF5_TOOLS_H5DIFF_SOURCE_DIR}/testfiles/h5diff_701.txt
@@ -447,6 +452,9 @@
   # attrs with verbose option level
   set (ATTR_VERBOSE_LEVEL_FILE1 h5diff_attr_v_level1.h5)
   set (ATTR_VERBOSE_LEVEL_FILE2 h5diff_attr_v_level2.h5)
+  # datasets larger than the blocks compared as raw bytes
+  set (BLOCKS_FILE1 h5diff_blocks1.h5)
+  set (BLOCKS_FILE2 h5diff_blocks2.h5)
 
   if (HDF5_ENABLE_USING_MEMCHECKER)
     # Remove any output file left over from previous test run
@@ -772,6 +780,12 @@
           h5diff_645.out.err
           h5diff_646.out
           h5diff_646.out.err
+          h5diff_650.out
+          h5diff_650.out.err
+          h5diff_651.out
+          h5diff_651.out.err
+          h5diff_652.out
+          h5diff_652.out.err
           h5diff_70.out
           h5diff_70.out.err
           h5diff_700.out
@@ -1375,3 +1389,13 @@ ADD_H5_TEST (h5diff_643 1 -v -d 5 --use-system-epsilon ${FILE1} ${FILE2} /g1/dse
 ADD_H5_TEST (h5diff_644 1 -v --use-system-epsilon -d 5 ${FILE1} ${FILE2} /g1/dset3 /g1/dset4)
 ADD_H5_TEST (h5diff_645 1 -v -p 0.05 --use-system-epsilon ${FILE1} ${FILE2} /g1/dset3 /g1/dset4)
 ADD_H5_TEST (h5diff_646 1 -v --use-system-epsilon -p 0.05 ${FILE1} ${FILE2} /g1/dset3 /g1/dset4)
+
+# ##############################################################################
+# # Datasets larger than the blocks compared as raw bytes before the
+# # element by element comparison; differences in the first, a middle and
+# # the last block
+# ##############################################################################
+ADD_H5_TEST (h5diff_650 1 -v ${BLOCKS_FILE1} ${BLOCKS_FILE2} /int /int)
+# the count limit covers all the blocks
+ADD_H5_TEST (h5diff_651 1 -v -n 2 ${BLOCKS_FILE1} ${BLOCKS_FILE2} /int /int)
+ADD_H5_TEST (h5diff_652 1 -v ${BLOCKS_FILE1} ${BLOCKS_FILE2} /compound /compound)
@@ -93,6 +93,9 @@ hsize_t H5TOOLS_MALLOCSIZE = (128 * 1024 * 1024);
 /* non-comparable dataset and attribute */
 #define NON_COMPARBLES1 "non_comparables1.h5"
 #define NON_COMPARBLES2 "non_comparables2.h5"
+/* datasets larger than the blocks h5diff compares with memcmp() */
+#define BLOCKS_FILE1    "h5diff_blocks1.h5"
+#define BLOCKS_FILE2    "h5diff_blocks2.h5"
 
 #define UIMAX    4294967295u /*Maximum value for a variable of type unsigned int */
 #define STR_SIZE 3
@@ -136,6 +139,7 @@ static int test_datatypes(const char *fname);
 static int test_attributes(const char *fname,int make_diffs);
 static int test_datasets(const char *fname,int make_diffs);
 static int test_special_datasets(const char *fname,int make_diffs);
+static int test_blocks(const char *fname,int make_diffs);
 static int test_hyperslab(const char *fname,int make_diffs);
 static int test_link_name(const char *fname1);
 static int test_soft_links(const char *fname1);
@@ -257,6 +261,11 @@ int main(void)
     /* common objects (same name) with different object types. HDFFV-7644 */
     test_objs_nocomparables(NON_COMPARBLES1, NON_COMPARBLES2);
 
+    /* differences spread over several of the 64 KB blocks that h5diff
+     * compares with memcmp() before comparing elements */
+    test_blocks(BLOCKS_FILE1,0);
+    test_blocks(BLOCKS_FILE2,1);
+
     return 0;
 }
 
@@ -1397,6 +1406,80 @@ int test_special_datasets(const char *file,
     return status;
 }
 
+/*-------------------------------------------------------------------------
+* Function: test_blocks
+*
+* Purpose: Create an integer and a compound dataset that span several of the
+*  64 KB blocks compared with memcmp() in diff_array(); with MAKE_DIFFS a few
+*  elements differ, in the first, a middle and the last block
+*
+*-------------------------------------------------------------------------
+*/
+#define BLOCKS_NINT   40000
+#define BLOCKS_NCMPD  10000
+
+static
+int test_blocks(const char *file,
+                int make_diffs /* flag to modify data buffers */)
+{
+    typedef struct cmpd_t
+    {
+        int    a;
+        double b;
+    } cmpd_t;
+
+    hid_t   fid;
+    hid_t   tid;
+    hsize_t dims[1];
+    int     *ibuf;
+    cmpd_t  *cbuf;
+    int     i;
+    herr_t  status;
+
+    ibuf = (int *)HDmalloc(BLOCKS_NINT * sizeof(int));
+    cbuf = (cmpd_t *)HDmalloc(BLOCKS_NCMPD * sizeof(cmpd_t));
+
+    for(i = 0; i < BLOCKS_NINT; i++)
+        ibuf[i] = i;
+    for(i = 0; i < BLOCKS_NCMPD; i++) {
+        cbuf[i].a = i;
+        cbuf[i].b = (double)i / 2;
+    }
+
+    if(make_diffs) {
+        ibuf[3] = -1;
+        ibuf[20000] = -1;
+        ibuf[BLOCKS_NINT - 1] = -1;
+
+        cbuf[1].a = -1;
+        cbuf[5000].b = -1;
+        cbuf[BLOCKS_NCMPD - 1].a = -1;
+    }
+
+    /* Create a file  */
+    if((fid = H5Fcreate(file, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        return -1;
+
+    dims[0] = BLOCKS_NINT;
+    write_dset(fid, 1, dims, "int", H5T_NATIVE_INT, ibuf);
+
+    tid = H5Tcreate(H5T_COMPOUND, sizeof(cmpd_t));
+    H5Tinsert(tid, "a", HOFFSET(cmpd_t, a), H5T_NATIVE_INT);
+    H5Tinsert(tid, "b", HOFFSET(cmpd_t, b), H5T_NATIVE_DOUBLE);
+    dims[0] = BLOCKS_NCMPD;
+    write_dset(fid, 1, dims, "compound", tid, cbuf);
+    status = H5Tclose(tid);
+    assert(status >= 0);
+
+    /* close file */
+    status = H5Fclose(fid);
+    assert(status >= 0);
+
+    HDfree(ibuf);
+    HDfree(cbuf);
+    return status;
+}
+
 /*-------------------------------------------------------------------------
 *
 * Purpose: Create test files to compare links, one has longer name than
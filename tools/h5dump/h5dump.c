@@ -1358,6 +1358,12 @@ main(int argc, const char *argv[])
     /* Disable tools error reporting */
     H5Eget_auto2(H5tools_ERR_STACK_g, &tools_func, &tools_edata);
     H5Eset_auto2(H5tools_ERR_STACK_g, NULL, NULL);
+
+    /* update hyperslab buffer size from H5TOOLS_BUFSIZE env if exist */
+    if (h5tools_getenv_update_hyperslab_bufsize() < 0) {
+        h5tools_setstatus(EXIT_FAILURE);
+        goto done;
+    }
     
     if((hand = parse_command_line(argc, argv))==NULL) {
         goto done;
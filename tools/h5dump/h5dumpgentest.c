@@ -110,6 +110,7 @@
 #define FILE78  "tscalarintattrsize.h5"
 #define FILE79  "tintsattrs.h5"
 #define FILE80  "tbitnopaque.h5"
+#define FILE81  "tbinchunk.h5"
 
 /*-------------------------------------------------------------------------
  * prototypes
@@ -9735,6 +9736,49 @@ static void gent_bitnopaquefields(void)
  *-------------------------------------------------------------------------
  */
 
+/*-------------------------------------------------------------------------
+ * Function:    gent_binary_chunk
+ *
+ * Purpose:     Generate a chunked dataset whose rows are longer than the
+ *              1 MB strip mine used when H5TOOLS_BUFSIZE=1, and whose chunks
+ *              span two rows, for the binary output order test
+ *
+ *-------------------------------------------------------------------------
+ */
+#define BINCHUNK_DIM0   4
+#define BINCHUNK_DIM1   (512 * 1024)
+
+static void
+gent_binary_chunk(void)
+{
+    hid_t    fid, sid, did, dcpl;
+    hsize_t  dims[2] = {BINCHUNK_DIM0, BINCHUNK_DIM1};
+    hsize_t  chunk_dims[2] = {2, 64 * 1024};
+    int      *buf;
+    size_t   i;
+
+    buf = (int *)HDmalloc(BINCHUNK_DIM0 * BINCHUNK_DIM1 * sizeof(int));
+    for(i = 0; i < BINCHUNK_DIM0 * BINCHUNK_DIM1; i++)
+        buf[i] = (int)i;
+
+    fid = H5Fcreate(FILE81, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    sid = H5Screate_simple(2, dims, NULL);
+    dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(dcpl, 2, chunk_dims);
+    H5Pset_shuffle(dcpl);
+    H5Pset_deflate(dcpl, 9);
+
+    did = H5Dcreate2(fid, "integer", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf);
+    H5Dclose(did);
+
+    H5Pclose(dcpl);
+    H5Sclose(sid);
+    H5Fclose(fid);
+
+    HDfree(buf);
+}
+
 int main(void)
 {
     gent_group();
@@ -9819,6 +9863,7 @@ int main(void)
     gent_intattrscalars();
     gent_intsattrs();
     gent_bitnopaquefields();
+    gent_binary_chunk();
 
     return 0;
 }
@@ -58,6 +58,7 @@ static int Get_hyperslab(hid_t dcpl_id, int rank_dset, hsize_t dims_dset[],
 static void print_dataset_info(hid_t dcpl_id, char *objname, double per, int pr);
 static int do_copy_objects(hid_t fidin, hid_t fidout, trav_table_t *travt,
 		pack_opt_t *options);
+static int copy_dataset_raw(hid_t fidin, hid_t fidout, const char *name);
 static int copy_user_block(const char *infile, const char *outfile,
 		hsize_t size);
 #if defined (H5REPACK_DEBUG_USER_BLOCK)
@@ -662,6 +663,10 @@ out:
  *  November 2006:  Use H5Ocopy in the copy of objects. The logic for using
  *   H5Ocopy or not is if a change of filters or layout is requested by the user
  *   then use read/write else use H5Ocopy.
+ *   The request must be for the object itself (or for all objects); the
+ *   objects that are not named in a per-object request are still copied with
+ *   H5Ocopy, so their chunks are copied without being decompressed and
+ *   recompressed.
  *
  * May, 1, 2008: Add a printing of the compression ratio of old size / new size
  *
@@ -729,6 +734,7 @@ int do_copy_objects(hid_t fidin, hid_t fidout, trav_table_t *travt,
 	int is_ref = 0;
 	htri_t is_named;
 	hbool_t limit_maxdims;
+	hbool_t copy_raw; /* the output dataset is the same as the input one */
 	hsize_t size_dset;
 
 	/*-------------------------------------------------------------------------
@@ -746,6 +752,7 @@ int do_copy_objects(hid_t fidin, hid_t fidout, trav_table_t *travt,
 		/* init variables per obj */
 		buf = NULL;
 		limit_maxdims = FALSE;
+		copy_raw = FALSE;
 
 		switch (travt->objs[i].type) {
 
@@ -885,12 +892,18 @@ int do_copy_objects(hid_t fidin, hid_t fidout, trav_table_t *travt,
 
 			/*-------------------------------------------------------------------------
 			 * check if we should use H5Ocopy or not
-			 * if there is a request for filters/layout, we read/write the object
-			 * otherwise we do a copy using H5Ocopy
+			 * if there is a request for filters/layout for this object, we
+			 * read/write the object; otherwise we do a copy using H5Ocopy, which
+			 * copies the raw (still filtered) chunks without running them
+			 * through the filter pipeline.
+			 * Note that a request for other objects doesn't affect this one,
+			 * unless a native type was also requested.
 			 *-------------------------------------------------------------------------
 			 */
-			if (options->op_tbl->nelems || options->all_filter == 1
-					|| options->all_layout == 1 || is_ref || is_named) {
+			if (options->all_filter == 1 || options->all_layout == 1
+					|| is_ref || is_named
+					|| (options->op_tbl->nelems && (options->use_native == 1
+							|| options_get_object(travt->objs[i].name, options->op_tbl)))) {
 
 				int j;
 
@@ -1004,37 +1017,59 @@ int do_copy_objects(hid_t fidin, hid_t fidout, trav_table_t *travt,
 							}
 
 						/*-------------------------------------------------------------------------
-						 * create the output dataset;
-						 * disable error checking in case the dataset cannot be created with the
-						 * modified dcpl; in that case use the original instead
+						 * if the request leaves the type, the dataspace and the creation
+						 * properties (layout, chunk size, filters) as they were, copy the
+						 * dataset with H5Ocopy: its chunks are copied as they are stored,
+						 * without being decompressed and compressed again
 						 *-------------------------------------------------------------------------
 						 */
-						H5E_BEGIN_TRY
-							{
-								dset_out = H5Dcreate2(fidout,
-										travt->objs[i].name, wtype_id,
-										f_space_id, H5P_DEFAULT, dcpl_out,
-										H5P_DEFAULT);
-							}H5E_END_TRY;
-
-						if (dset_out == FAIL) {
-							if (options->verbose)
-								printf(
-										" warning: could not create dataset <%s>. Applying original settings\n",
-										travt->objs[i].name);
+						if (!is_named && !limit_maxdims
+								&& H5Tequal(wtype_id, ftype_id) > 0
+								&& H5Pequal(dcpl_in, dcpl_out) > 0)
+							copy_raw = TRUE;
 
-							if ((dset_out = H5Dcreate2(fidout,
-									travt->objs[i].name, wtype_id, f_space_id,
-									H5P_DEFAULT, dcpl_in, H5P_DEFAULT)) < 0)
+						if (copy_raw) {
+							if (copy_dataset_raw(fidin, fidout, travt->objs[i].name) < 0)
+								goto error;
+							if ((dset_out = H5Dopen2(fidout, travt->objs[i].name,
+									H5P_DEFAULT)) < 0)
 								goto error;
-							apply_f = 0;
+						}
+						else {
+							/*-------------------------------------------------------------------------
+							 * create the output dataset;
+							 * disable error checking in case the dataset cannot be created with the
+							 * modified dcpl; in that case use the original instead
+							 *-------------------------------------------------------------------------
+							 */
+							H5E_BEGIN_TRY
+								{
+									dset_out = H5Dcreate2(fidout,
+											travt->objs[i].name, wtype_id,
+											f_space_id, H5P_DEFAULT, dcpl_out,
+											H5P_DEFAULT);
+								}H5E_END_TRY;
+
+							if (dset_out == FAIL) {
+								if (options->verbose)
+									printf(
+											" warning: could not create dataset <%s>. Applying original settings\n",
+											travt->objs[i].name);
+
+								if ((dset_out = H5Dcreate2(fidout,
+										travt->objs[i].name, wtype_id, f_space_id,
+										H5P_DEFAULT, dcpl_in, H5P_DEFAULT)) < 0)
+									goto error;
+								apply_f = 0;
+							}
 						}
 
 						/*-------------------------------------------------------------------------
 						 * read/write
 						 *-------------------------------------------------------------------------
 						 */
-						if (nelmts > 0 && space_status != H5D_SPACE_STATUS_NOT_ALLOCATED) {
+						if (!copy_raw && nelmts > 0
+								&& space_status != H5D_SPACE_STATUS_NOT_ALLOCATED) {
 							size_t need = (size_t)(nelmts * msize); /* bytes needed */
 
 							/* have to read the whole dataset if there is only one element in the dataset */
@@ -1250,31 +1285,11 @@ int do_copy_objects(hid_t fidin, hid_t fidout, trav_table_t *travt,
 			 *-------------------------------------------------------------------------
 			 */
 			else {
-				hid_t pid;
-
-				/* create property to pass copy options */
-				if ((pid = H5Pcreate(H5P_OBJECT_COPY)) < 0)
-					goto error;
-
-				/* set options for object copy */
-				if (H5Pset_copy_object(pid, H5O_COPY_WITHOUT_ATTR_FLAG) < 0)
-					goto error;
-
 				/*-------------------------------------------------------------------------
 				 * do the copy
 				 *-------------------------------------------------------------------------
 				 */
-
-				if (H5Ocopy(fidin, /* Source file or group identifier */
-				travt->objs[i].name, /* Name of the source object to be copied */
-				fidout, /* Destination file or group identifier  */
-				travt->objs[i].name, /* Name of the destination object  */
-				pid, /* Properties which apply to the copy   */
-				H5P_DEFAULT) < 0) /* Properties which apply to the new hard link */
-					goto error;
-
-				/* close property */
-				if (H5Pclose(pid) < 0)
+				if (copy_dataset_raw(fidin, fidout, travt->objs[i].name) < 0)
 					goto error;
 
 				/*-------------------------------------------------------------------------
@@ -1407,6 +1422,49 @@ error:
 	return -1;
 }
 
+/*-------------------------------------------------------------------------
+ * Function: copy_dataset_raw
+ *
+ * Purpose: copy the dataset NAME with H5Ocopy, without its attributes
+ *  (they are copied afterwards with copy_attr()); the raw data is copied as
+ *  it is stored, so chunks are not run through the filter pipeline
+ *
+ * Return: 0, ok, -1 no
+ *
+ *-------------------------------------------------------------------------
+ */
+static int copy_dataset_raw(hid_t fidin, hid_t fidout, const char *name) {
+	hid_t pid = -1;
+
+	/* create property to pass copy options */
+	if ((pid = H5Pcreate(H5P_OBJECT_COPY)) < 0)
+		goto error;
+
+	/* set options for object copy */
+	if (H5Pset_copy_object(pid, H5O_COPY_WITHOUT_ATTR_FLAG) < 0)
+		goto error;
+
+	if (H5Ocopy(fidin, /* Source file or group identifier */
+	name, /* Name of the source object to be copied */
+	fidout, /* Destination file or group identifier  */
+	name, /* Name of the destination object  */
+	pid, /* Properties which apply to the copy   */
+	H5P_DEFAULT) < 0) /* Properties which apply to the new hard link */
+		goto error;
+
+	/* close property */
+	if (H5Pclose(pid) < 0)
+		goto error;
+
+	return 0;
+
+error:
+	H5E_BEGIN_TRY {
+		H5Pclose(pid);
+	} H5E_END_TRY;
+	return -1;
+}
+
 /*-------------------------------------------------------------------------
  * Function: print_dataset_info
  *
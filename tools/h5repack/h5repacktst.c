@@ -150,6 +150,8 @@ static int make_userblock_file(void);
 static int make_named_dtype(hid_t loc_id);
 static int make_references(hid_t loc_id);
 static int make_complex_attr_references(hid_t loc_id);
+static int get_nfilters(const char *fname, const char *dset_name);
+static hsize_t get_storage_size(const char *fname, const char *dset_name);
 
 
 /*-------------------------------------------------------------------------
@@ -1314,6 +1316,40 @@ int main (void)
 #endif
 
 
+    /*-------------------------------------------------------------------------
+    * a filter request for one dataset leaves the others as they were
+    * (they are copied with H5Ocopy)
+    *-------------------------------------------------------------------------
+    */
+
+    TESTING("    copy of datasets not in the request");
+
+#if defined (H5_HAVE_FILTER_DEFLATE) && defined (H5_HAVE_FILTER_SHUFFLE)
+    if (h5repack_init (&pack_options, 0, fs_type, fs_size) < 0)
+        GOERROR;
+    if (h5repack_addfilter("dset_deflate:NONE",&pack_options) < 0)
+        GOERROR;
+    if (h5repack(FNAME11,FNAME11OUT,&pack_options) < 0)
+        GOERROR;
+    if (h5diff(FNAME11,FNAME11OUT,NULL,NULL,&diff_options) >0)
+        GOERROR;
+    if (h5repack_verify(FNAME11, FNAME11OUT,&pack_options)<=0)
+        GOERROR;
+    if (get_nfilters(FNAME11OUT, "dset_deflate") != 0)
+        GOERROR;
+    if (get_nfilters(FNAME11OUT, "dset_shuffle") != get_nfilters(FNAME11, "dset_shuffle"))
+        GOERROR;
+    if (get_nfilters(FNAME11OUT, "dset_all") != get_nfilters(FNAME11, "dset_all"))
+        GOERROR;
+    if (h5repack_end (&pack_options) < 0)
+        GOERROR;
+
+    PASSED();
+#else
+    SKIPPED();
+#endif
+
+
     /*-------------------------------------------------------------------------
     * test the NONE global option
     *-------------------------------------------------------------------------
@@ -1360,6 +1396,29 @@ int main (void)
         GOERROR;
     PASSED();
 
+    /*-------------------------------------------------------------------------
+    * a layout request that matches the dataset's layout copies the stored
+    * chunks as they are, instead of writing every chunk of the dataset
+    *-------------------------------------------------------------------------
+    */
+    TESTING("    layout request for the same layout");
+
+    if (h5repack_init (&pack_options, 0, fs_type, fs_size) < 0)
+        GOERROR;
+    if (h5repack_addlayout("dset:CHUNK=1024",&pack_options) < 0)
+        GOERROR;
+    if (h5repack(FNAME14,FNAME14OUT,&pack_options) < 0)
+        GOERROR;
+    if (h5diff(FNAME14,FNAME14OUT,NULL,NULL,&diff_options) >0)
+        GOERROR;
+    if (h5repack_verify(FNAME14, FNAME14OUT,&pack_options)<=0)
+        GOERROR;
+    if (get_storage_size(FNAME14OUT, "dset") != get_storage_size(FNAME14, "dset"))
+        GOERROR;
+    if (h5repack_end (&pack_options) < 0)
+        GOERROR;
+    PASSED();
+
     /*-------------------------------------------------------------------------
     * test external dataset
     *-------------------------------------------------------------------------
@@ -3421,6 +3480,82 @@ out:
 
 }
 
+/*-------------------------------------------------------------------------
+* Function: get_nfilters
+*
+* Purpose: return the number of filters of a dataset, or -1 on error
+*
+*-------------------------------------------------------------------------
+*/
+static int
+get_nfilters(const char *fname, const char *dset_name)
+{
+    hid_t fid = -1;
+    hid_t did = -1;
+    hid_t dcpl = -1;
+    int   nfilters;
+
+    if((fid = H5Fopen(fname, H5F_ACC_RDONLY, H5P_DEFAULT)) < 0)
+        goto out;
+    if((did = H5Dopen2(fid, dset_name, H5P_DEFAULT)) < 0)
+        goto out;
+    if((dcpl = H5Dget_create_plist(did)) < 0)
+        goto out;
+    if((nfilters = H5Pget_nfilters(dcpl)) < 0)
+        goto out;
+    if(H5Pclose(dcpl) < 0)
+        goto out;
+    if(H5Dclose(did) < 0)
+        goto out;
+    if(H5Fclose(fid) < 0)
+        goto out;
+
+    return nfilters;
+
+out:
+    H5E_BEGIN_TRY {
+        H5Pclose(dcpl);
+        H5Dclose(did);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+}
+
+/*-------------------------------------------------------------------------
+* Function: get_storage_size
+*
+* Purpose: return the storage size of a dataset, or 0 on error
+*
+*-------------------------------------------------------------------------
+*/
+static hsize_t
+get_storage_size(const char *fname, const char *dset_name)
+{
+    hid_t   fid = -1;
+    hid_t   did = -1;
+    hsize_t size;
+
+    if((fid = H5Fopen(fname, H5F_ACC_RDONLY, H5P_DEFAULT)) < 0)
+        goto out;
+    if((did = H5Dopen2(fid, dset_name, H5P_DEFAULT)) < 0)
+        goto out;
+    size = H5Dget_storage_size(did);
+    if(H5Dclose(did) < 0)
+        goto out;
+    if(H5Fclose(fid) < 0)
+        goto out;
+
+    return size;
+
+out:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return 0;
+}
+
+
 /*-------------------------------------------------------------------------
 * Function: make_userblock
 *
@@ -130,6 +130,10 @@ static hbool_t not_comparable;
 
 #define PDIFF(a,b)    (((b) > (a)) ? ((b) - (a)) : ((a) -(b)))
 
+/* Size of the blocks compared with memcmp() before the element by element
+ * comparison is done; blocks whose bytes match are skipped */
+#define DIFF_BLOCK_SIZE  (64 * 1024)
+
 typedef struct mcomp_t
 {
     unsigned        n;      /* number of members */
@@ -138,12 +142,19 @@ typedef struct mcomp_t
     struct mcomp_t  **m;     /* members */
 }mcomp_t;
 
+/* Signature shared by the integer and float comparison routines */
+typedef hsize_t (*diff_atomic_func_t)(unsigned char *mem1, unsigned char *mem2,
+    hsize_t nelmts, hsize_t hyper_start, int rank, hsize_t *dims, hsize_t *acc,
+    hsize_t *pos, diff_opt_t *options, const char *obj1, const char *obj2,
+    int *ph);
+
 
 /*-------------------------------------------------------------------------
  * local prototypes
  *-------------------------------------------------------------------------
  */
 static hsize_t diff_region(hid_t obj1_id, hid_t obj2_id,hid_t region1_id, hid_t region2_id, diff_opt_t *options);
+static hsize_t diff_atomic_blocks(diff_atomic_func_t diff_func, unsigned char *mem1, unsigned char *mem2, size_t size, hsize_t nelmts, hsize_t hyper_start, int rank, hsize_t *dims, hsize_t *acc, hsize_t *pos, diff_opt_t *options, const char *obj1, const char *obj2, int *ph);
 static hbool_t all_zero(const void *_mem, size_t size);
 static int     ull2float(unsigned long long ull_value, float *f_value);
 static hsize_t character_compare(char *mem1,char *mem2,hsize_t i,unsigned u,int rank,hsize_t *dims,hsize_t *acc,hsize_t *pos,diff_opt_t *options,const char *obj1,const char *obj2,int *ph);
@@ -402,6 +413,9 @@ hsize_t diff_array( void *_mem1,
     int           j;
     mcomp_t       members;
     H5T_class_t   type_class;
+    diff_atomic_func_t diff_atomic = NULL; /* routine for float and integer types */
+    hsize_t       block_nelmts;     /* elements in a block compared by memcmp() */
+    hbool_t       raw_equal_ok = FALSE; /* matching bytes mean matching elements */
 
     h5difftrace("diff_array start\n");
     /* get the size. */
@@ -447,37 +461,37 @@ hsize_t diff_array( void *_mem1,
 
     case H5T_FLOAT:
         if (H5Tequal(m_type, H5T_NATIVE_FLOAT))
-            nfound=diff_float(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_float;
         else if (H5Tequal(m_type, H5T_NATIVE_DOUBLE))
-            nfound=diff_double(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_double;
 #if H5_SIZEOF_LONG_DOUBLE !=0
         else if (H5Tequal(m_type, H5T_NATIVE_LDOUBLE))
-            nfound=diff_ldouble(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_ldouble;
 #endif
         break;
 
     case H5T_INTEGER:
 
         if (H5Tequal(m_type, H5T_NATIVE_SCHAR))
-            nfound=diff_schar(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_schar;
         else if (H5Tequal(m_type, H5T_NATIVE_UCHAR))
-            nfound=diff_uchar(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_uchar;
         else if (H5Tequal(m_type, H5T_NATIVE_SHORT))
-            nfound=diff_short(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_short;
         else if (H5Tequal(m_type, H5T_NATIVE_USHORT))
-            nfound=diff_ushort(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_ushort;
         else if (H5Tequal(m_type, H5T_NATIVE_INT))
-            nfound=diff_int(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_int;
         else if (H5Tequal(m_type, H5T_NATIVE_UINT))
-            nfound=diff_uint(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_uint;
         else if (H5Tequal(m_type, H5T_NATIVE_LONG))
-            nfound=diff_long(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_long;
         else if (H5Tequal(m_type, H5T_NATIVE_ULONG))
-            nfound=diff_ulong(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_ulong;
         else if (H5Tequal(m_type, H5T_NATIVE_LLONG))
-            nfound=diff_llong(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_llong;
         else if (H5Tequal(m_type, H5T_NATIVE_ULLONG))
-            nfound=diff_ullong(mem1,mem2,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
+            diff_atomic=diff_ullong;
 
         break;
 
@@ -494,10 +508,32 @@ hsize_t diff_array( void *_mem1,
     case H5T_ARRAY:
     case H5T_VLEN:
     case H5T_REFERENCE:
+        /* Elements with no strings, references or variable-length data
+         * are equal when their bytes are */
+        if (H5Tdetect_class(m_type, H5T_VLEN) == FALSE &&
+            H5Tdetect_class(m_type, H5T_REFERENCE) == FALSE &&
+            H5Tdetect_class(m_type, H5T_STRING) == FALSE)
+            raw_equal_ok = TRUE;
+        block_nelmts = DIFF_BLOCK_SIZE / size;
+        if (block_nelmts == 0)
+            block_nelmts = 1;
+
         HDmemset(&members, 0, sizeof (mcomp_t));
         get_member_types(m_type, &members);
         for ( i = 0; i < nelmts; i++)
         {
+            /* skip blocks of elements whose bytes match */
+            if (raw_equal_ok && (i % block_nelmts) == 0)
+            {
+                hsize_t n = MIN(block_nelmts, nelmts - i);
+
+                if (HDmemcmp(mem1 + i * size, mem2 + i * size, (size_t)n * size) == 0)
+                {
+                    i += n - 1;
+                    continue;
+                }
+            }
+
             nfound+=diff_datum(
                 mem1 + i * size,
                 mem2 + i * size, /* offset */
@@ -521,11 +557,70 @@ hsize_t diff_array( void *_mem1,
         } /* i */
         close_member_types(&members);
     } /* switch */
+
+    if (diff_atomic)
+        nfound=diff_atomic_blocks(diff_atomic,mem1,mem2,size,nelmts,hyper_start,rank,dims,acc,pos,options,name1,name2,&ph);
     h5difftrace("diff_array finish\n");
 
     return nfound;
 }
 
+/*-------------------------------------------------------------------------
+ * Function: diff_atomic_blocks
+ *
+ * Purpose: compare two buffers of integer or float elements block by block.
+ *  Blocks whose bytes match are skipped with a single memcmp(); the others
+ *  are handed to DIFF_FUNC, the element by element comparison for the type.
+ *
+ * Return: number of differences found
+ *
+ *-------------------------------------------------------------------------
+ */
+static hsize_t diff_atomic_blocks(diff_atomic_func_t diff_func,
+                   unsigned char *mem1,
+                   unsigned char *mem2,
+                   size_t        size,
+                   hsize_t       nelmts,
+                   hsize_t       hyper_start,
+                   int           rank,
+                   hsize_t       *dims,
+                   hsize_t       *acc,
+                   hsize_t       *pos,
+                   diff_opt_t    *options,
+                   const char    *obj1,
+                   const char    *obj2,
+                   int           *ph)
+{
+    hsize_t nfound=0;          /* number of differences found */
+    hsize_t block_nelmts;      /* elements in a block */
+    hsize_t count=options->count;
+    hsize_t i;
+
+    block_nelmts = DIFF_BLOCK_SIZE / size;
+    if (block_nelmts == 0)
+        block_nelmts = 1;
+
+    for ( i = 0; i < nelmts; i += block_nelmts)
+    {
+        hsize_t n = MIN(block_nelmts, nelmts - i);
+        size_t  offset = (size_t)i * size;
+
+        if (HDmemcmp(mem1 + offset, mem2 + offset, (size_t)n * size) == 0)
+            continue;
+
+        /* the type routines stop at options->count of their own differences */
+        if (options->n)
+            options->count = count - nfound;
+        nfound+=(*diff_func)(mem1 + offset,mem2 + offset,n,hyper_start + i,rank,dims,acc,pos,options,obj1,obj2,ph);
+        options->count = count;
+
+        if (options->n && nfound>=count)
+            break;
+    } /* i */
+
+    return nfound;
+}
+
 /*-------------------------------------------------------------------------
  * Function: diff_datum
  *
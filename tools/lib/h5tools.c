@@ -1334,13 +1334,16 @@ render_bin_output(FILE *stream, hid_t container, hid_t tid, void *_mem,  hsize_t
         case H5T_INTEGER:
         case H5T_FLOAT:
         case H5T_ENUM:
+        case H5T_BITFIELD:
+        case H5T_OPAQUE:
+            /* the elements are contiguous in memory, write the whole block at once */
             block_index = block_nelmts * size;
             while(block_index > 0) {
                 size_t bytes_in        = 0;    /* # of bytes to write  */
                 size_t bytes_wrote     = 0;    /* # of bytes written   */
 
-                if(block_index > sizeof(size_t))
-                    bytes_in = sizeof(size_t);
+                if(block_index > (hsize_t)H5TOOLS_BUFSIZE)
+                    bytes_in = (size_t)H5TOOLS_BUFSIZE;
                 else
                     bytes_in = (size_t)block_index;
 
@@ -1358,7 +1361,6 @@ render_bin_output(FILE *stream, hid_t container, hid_t tid, void *_mem,  hsize_t
                 unsigned int    i;
                 H5T_str_t       pad;
                 char           *s;
-                unsigned char   tempuchar;
 
                 pad = H5Tget_strpad(tid);
 
@@ -1375,11 +1377,10 @@ render_bin_output(FILE *stream, hid_t container, hid_t tid, void *_mem,  hsize_t
                     else {
                         s = (char *) mem;
                     }
-                    for (i = 0; i < size && (s[i] || pad != H5T_STR_NULLTERM); i++) {
-                        HDmemcpy(&tempuchar, &s[i], sizeof(unsigned char));
-                        if (1 != HDfwrite(&tempuchar, sizeof(unsigned char), 1, stream))
-                            H5E_THROW(FAIL, H5E_tools_min_id_g, "fwrite failed");
-                    } /* i */
+                    for (i = 0; i < size && (s[i] || pad != H5T_STR_NULLTERM); i++)
+                        ;
+                    if (i > 0 && (size_t)i != HDfwrite(s, sizeof(unsigned char), (size_t)i, stream))
+                        H5E_THROW(FAIL, H5E_tools_min_id_g, "fwrite failed");
                 } /* for (block_index = 0; block_index < block_nelmts; block_index++) */
             }
             break;
@@ -1418,6 +1419,7 @@ render_bin_output(FILE *stream, hid_t container, hid_t tid, void *_mem,  hsize_t
                 int     k, ndims;
                 hsize_t dims[H5S_MAX_RANK], temp_nelmts, nelmts;
                 hid_t   memb;
+                H5T_class_t memb_class;
 
                 /* get the array's base datatype for each element */
                 memb = H5Tget_super(tid);
@@ -1432,14 +1434,26 @@ render_bin_output(FILE *stream, hid_t container, hid_t tid, void *_mem,  hsize_t
                     nelmts = (size_t) temp_nelmts;
                 }
 
-                for (block_index = 0; block_index < block_nelmts; block_index++) {
-                    mem = ((unsigned char*)_mem) + block_index * size;
-                    /* dump the array element */
-                    if (render_bin_output(stream, container, memb, mem, nelmts) < 0) {
+                /* arrays of fixed-size atomic elements are dumped in one block */
+                memb_class = H5Tget_class(memb);
+                if (memb_class == H5T_INTEGER || memb_class == H5T_FLOAT ||
+                        memb_class == H5T_ENUM || memb_class == H5T_BITFIELD ||
+                        memb_class == H5T_OPAQUE) {
+                    if (render_bin_output(stream, container, memb, _mem, block_nelmts * nelmts) < 0) {
                         H5Tclose(memb);
                         H5E_THROW(FAIL, H5E_tools_min_id_g, "render_bin_output failed");
                     }
                 }
+                else {
+                    for (block_index = 0; block_index < block_nelmts; block_index++) {
+                        mem = ((unsigned char*)_mem) + block_index * size;
+                        /* dump the array element */
+                        if (render_bin_output(stream, container, memb, mem, nelmts) < 0) {
+                            H5Tclose(memb);
+                            H5E_THROW(FAIL, H5E_tools_min_id_g, "render_bin_output failed");
+                        }
+                    }
+                }
                 H5Tclose(memb);
             }
             break;
@@ -190,6 +190,9 @@ static int h5tools_print_region_data_blocks(hid_t region_id,
         h5tools_str_t *buffer/*string into which to render */, size_t ncols,
         unsigned ndims, hid_t type_id, hsize_t nblocks, hsize_t *ptdata);
 
+static hbool_t h5tools_align_chunk_stripmine(hid_t dset, unsigned ndims,
+        size_t type_size, const hsize_t *total_size, hsize_t *sm_size);
+
 hbool_t h5tools_dump_region_data_points(hid_t region_space, hid_t region_id,
                 FILE *stream, const h5tool_format_t *info,
                 h5tools_context_t *ctx/*in,out*/,
@@ -1480,6 +1483,65 @@ CATCH
     return ret_value;
 }
 
+/*-------------------------------------------------------------------------
+ * Audience:    Private
+ * Chapter:     H5Tools Library
+ * Purpose: Align a strip mine with the chunks of a chunked dataset.
+ * Description:
+ *      Each dimension of SM_SIZE that does not cover the whole extent
+ *      TOTAL_SIZE is rounded to whole chunks: down to a multiple of the chunk
+ *      size when it covers more than one chunk, up to one chunk when it
+ *      covers less.  A dimension is only widened when every dimension inside
+ *      it covers its whole extent; otherwise the strip mines would no longer
+ *      walk the dataset in row-major order.  A strip mine that would grow
+ *      past H5TOOLS_MALLOCSIZE bytes is left unchanged.
+ * Return:
+ *      TRUE if SM_SIZE was changed, FALSE otherwise.
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+h5tools_align_chunk_stripmine(hid_t dset, unsigned ndims, size_t type_size,
+        const hsize_t *total_size, hsize_t *sm_size)
+{
+    hid_t       dcpl;
+    hsize_t     chunk_dims[H5S_MAX_RANK];
+    hsize_t     new_size[H5S_MAX_RANK];
+    hsize_t     nbytes = type_size;
+    unsigned    i;
+    hbool_t     inner_full = TRUE;  /* dimensions inside i cover their extent */
+    hbool_t     changed = FALSE;
+
+    if ((dcpl = H5Dget_create_plist(dset)) < 0)
+        return FALSE;
+
+    if (H5Pget_layout(dcpl) == H5D_CHUNKED &&
+            H5Pget_chunk(dcpl, (int)ndims, chunk_dims) == (int)ndims) {
+        for (i = ndims; i > 0; --i) {
+            new_size[i - 1] = sm_size[i - 1];
+            if (inner_full && sm_size[i - 1] < total_size[i - 1]) {
+                if (sm_size[i - 1] < chunk_dims[i - 1])
+                    new_size[i - 1] = MIN(chunk_dims[i - 1], total_size[i - 1]);
+                else
+                    new_size[i - 1] -= sm_size[i - 1] % chunk_dims[i - 1];
+            }
+            if (new_size[i - 1] < total_size[i - 1])
+                inner_full = FALSE;
+            nbytes *= new_size[i - 1];
+        }
+
+        if (nbytes <= H5TOOLS_MALLOCSIZE)
+            for (i = 0; i < ndims; i++)
+                if (new_size[i] != sm_size[i]) {
+                    sm_size[i] = new_size[i];
+                    changed = TRUE;
+                }
+    }
+
+    H5Pclose(dcpl);
+
+    return changed;
+}
+
 /*-------------------------------------------------------------------------
  * Audience:    Public
  * Chapter:     H5Tools Library
@@ -1504,7 +1566,6 @@ h5tools_dump_simple_dset(FILE *stream, const h5tool_format_t *info, h5tools_cont
     hsize_t             elmtno;                   /* counter  */
     size_t              i;                        /* counter  */
     int                 carry;                    /* counter carry value */
-    hsize_t             zero[8];                  /* vector of zeros */
     unsigned int        flags;                    /* buffer extent flags */
     hsize_t             total_size[H5S_MAX_RANK]; /* total size of dataset*/
 
@@ -1579,6 +1640,14 @@ h5tools_dump_simple_dset(FILE *stream, const h5tool_format_t *info, h5tools_cont
             sm_nbytes *= sm_size[i - 1];
             HDassert(sm_nbytes > 0);
         }
+
+        /* Align the strip mine with the dataset's chunks, so that a chunk is
+         * not read (and decompressed) again by each strip mine it straddles */
+        if (h5tools_align_chunk_stripmine(dset, ctx->ndims, p_type_nbytes, total_size, sm_size) == TRUE) {
+            sm_nbytes = p_type_nbytes;
+            for (i = 0; i < ctx->ndims; i++)
+                sm_nbytes *= sm_size[i];
+        }
     }
 
     if(!sm_nbytes)
@@ -1595,7 +1664,6 @@ h5tools_dump_simple_dset(FILE *stream, const h5tool_format_t *info, h5tools_cont
 
     /* The stripmine loop */
     HDmemset(hs_offset, 0, sizeof hs_offset);
-    HDmemset(zero, 0, sizeof zero);
 
     for (elmtno = 0; elmtno < p_nelmts; elmtno += hs_nelmts) {
         /* Calculate the hyperslab size */
@@ -1607,7 +1675,11 @@ h5tools_dump_simple_dset(FILE *stream, const h5tool_format_t *info, h5tools_cont
             }
 
             H5Sselect_hyperslab(f_space, H5S_SELECT_SET, hs_offset, NULL, hs_size, NULL);
-            H5Sselect_hyperslab(sm_space, H5S_SELECT_SET, zero, NULL, &hs_nelmts, NULL);
+
+            /* Give the memory space the shape of the hyperslab, so the library
+             * maps it onto the file selection (and its chunks) block by block
+             * instead of element by element; the buffer layout is unchanged */
+            H5Sset_extent_simple(sm_space, (int)ctx->ndims, hs_size, NULL);
         }
         else {
             H5Sselect_all(f_space);
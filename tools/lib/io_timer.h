@@ -46,6 +46,8 @@ typedef enum timer_type_ {
     HDF5_GROSS_READ_FIXED_DIMS,
     HDF5_RAW_WRITE_FIXED_DIMS,
     HDF5_RAW_READ_FIXED_DIMS,
+    HDF5_METADATA_WRITE,
+    HDF5_METADATA_READ,
     NUM_TIMERS
 } timer_type;
 
@@ -0,0 +1,560 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:     Summarizes and replays the binary I/O trace written by the
+ *              log VFD when it is given the H5FD_LOG_TRACE flag.
+ *
+ *              The trace is aggregated per memory type and per metadata
+ *              cache tag (object header address).  Unless only a summary
+ *              is requested, every operation is then re-issued, in order,
+ *              against a new file opened with the chosen VFD, so that
+ *              driver and caching changes can be benchmarked offline
+ *              against a captured access pattern.
+ *
+ * Usage:       log_replay [-h] [-s] [-t N] [-d driver] trace [file]
+ */
+
+/* See H5private.h for how to include headers */
+#include "hdf5.h"
+#include "H5private.h"
+#include "h5tools.h"
+#include "h5tools_utils.h"
+
+#define DEFAULT_REPLAY_FILE     "log_replay.h5"
+#define DEFAULT_NTAGS           10
+#define FAMILY_MEMB_SIZE        ((hsize_t)1024 * 1024 * 1024)
+
+/* Name of tool */
+#define PROGRAMNAME "log_replay"
+
+/* Number of memory types */
+#define NTYPES                  ((int)H5FD_MEM_NTYPES)
+
+/* One decoded trace record */
+typedef struct trace_rec_t {
+    H5FD_log_trace_op_t op;         /* Operation */
+    H5FD_mem_t  type;               /* Memory type */
+    double      elapsed;            /* Recorded duration (s) */
+    haddr_t     addr;               /* Address, or new EOA */
+    hsize_t     size;               /* Size of I/O */
+    haddr_t     tag;                /* Metadata cache tag */
+} trace_rec_t;
+
+/* Per memory type statistics */
+typedef struct type_stats_t {
+    hsize_t     nreads;             /* # of reads */
+    hsize_t     nwrites;            /* # of writes */
+    hsize_t     read_bytes;         /* Bytes read */
+    hsize_t     write_bytes;        /* Bytes written */
+    double      read_time;          /* Recorded time in reads (s) */
+    double      write_time;         /* Recorded time in writes (s) */
+} type_stats_t;
+
+/* Per tag statistics */
+typedef struct tag_stats_t {
+    haddr_t     tag;                /* Metadata cache tag */
+    hsize_t     nops;               /* # of reads & writes */
+    hsize_t     bytes;              /* Bytes read & written */
+} tag_stats_t;
+
+/* Names of the memory types, indexed by H5FD_mem_t */
+static const char *type_names[] = {
+    "default",
+    "super",
+    "btree",
+    "draw",
+    "gheap",
+    "lheap",
+    "ohdr"
+};
+
+static const char *s_opts = "hsd:t:";
+static struct long_options l_opts[] = {
+    { "help", no_arg, 'h' },
+    { "summary", no_arg, 's' },
+    { "driver", require_arg, 'd' },
+    { "tags", require_arg, 't' },
+    { NULL, 0, '\0' }
+};
+
+
+/*-------------------------------------------------------------------------
+ * Function:    usage
+ *
+ * Purpose:     Print the usage message
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+usage(void)
+{
+    HDfprintf(stdout, "usage: %s [OPTIONS] TRACE [FILE]\n", PROGRAMNAME);
+    HDfprintf(stdout, "  Summarize the binary trace TRACE written by the log VFD (H5FD_LOG_TRACE)\n");
+    HDfprintf(stdout, "  and replay its operations against FILE (default: %s)\n", DEFAULT_REPLAY_FILE);
+    HDfprintf(stdout, "  OPTIONS\n");
+    HDfprintf(stdout, "     -h, --help          Print this usage message and exit\n");
+    HDfprintf(stdout, "     -s, --summary       Only summarize the trace, don't replay it\n");
+    HDfprintf(stdout, "     -d D, --driver=D    VFD to replay with: sec2 (default), stdio,\n");
+    HDfprintf(stdout, "                         core, family or multi\n");
+    HDfprintf(stdout, "     -t N, --tags=N      Number of busiest metadata tags to list (default: %d)\n", DEFAULT_NTAGS);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    decode_u32 / decode_u64
+ *
+ * Purpose:     Decode little-endian values from the trace
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned long
+decode_u32(const unsigned char *p)
+{
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8) |
+            ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
+
+static hsize_t
+decode_u64(const unsigned char *p)
+{
+    hsize_t ret_value = 0;
+    int i;
+
+    for(i = 7; i >= 0; i--)
+        ret_value = (ret_value << 8) | (hsize_t)p[i];
+
+    return ret_value;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    read_trace
+ *
+ * Purpose:     Read & decode all the records in a trace file
+ *
+ * Return:      Success:    Array of records (caller frees)
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static trace_rec_t *
+read_trace(const char *name, size_t *nrecs)
+{
+    FILE *fp;
+    unsigned char hdr[H5FD_LOG_TRACE_HDR_SIZE];
+    unsigned char *raw = NULL;
+    trace_rec_t *recs = NULL;
+    size_t rec_size, nalloc = 0, n = 0;
+
+    if(NULL == (fp = HDfopen(name, "rb"))) {
+        error_msg("unable to open trace file \"%s\"\n", name);
+        return NULL;
+    } /* end if */
+
+    /* Check the header */
+    if(HDfread(hdr, sizeof(hdr), (size_t)1, fp) != 1 ||
+            HDmemcmp(hdr, H5FD_LOG_TRACE_SIGNATURE, (size_t)H5FD_LOG_TRACE_SIGNATURE_LEN)) {
+        error_msg("\"%s\" is not a log VFD trace file\n", name);
+        goto error;
+    } /* end if */
+    if(hdr[H5FD_LOG_TRACE_SIGNATURE_LEN] != H5FD_LOG_TRACE_VERSION) {
+        error_msg("unknown trace file version %u\n", (unsigned)hdr[H5FD_LOG_TRACE_SIGNATURE_LEN]);
+        goto error;
+    } /* end if */
+    rec_size = (size_t)decode_u32(hdr + 8);
+    if(rec_size < H5FD_LOG_TRACE_REC_SIZE) {
+        error_msg("bad trace record size %lu\n", (unsigned long)rec_size);
+        goto error;
+    } /* end if */
+    if(NULL == (raw = (unsigned char *)HDmalloc(rec_size)))
+        goto error;
+
+    /* Decode the records */
+    while(HDfread(raw, rec_size, (size_t)1, fp) == 1) {
+        trace_rec_t *rec;
+        unsigned long elapsed_us;
+
+        if(n == nalloc) {
+            trace_rec_t *tmp;
+
+            nalloc = nalloc ? nalloc * 2 : 1024;
+            if(NULL == (tmp = (trace_rec_t *)HDrealloc(recs, nalloc * sizeof(trace_rec_t)))) {
+                error_msg("unable to allocate memory for trace\n");
+                goto error;
+            } /* end if */
+            recs = tmp;
+        } /* end if */
+
+        rec = &recs[n++];
+        rec->op = (H5FD_log_trace_op_t)raw[0];
+        rec->type = (H5FD_mem_t)raw[1];
+        if(rec->type < H5FD_MEM_DEFAULT || rec->type >= H5FD_MEM_NTYPES)
+            rec->type = H5FD_MEM_DEFAULT;
+        elapsed_us = decode_u32(raw + 4);
+        rec->elapsed = (double)elapsed_us / 1000000.0;
+        rec->addr = (haddr_t)decode_u64(raw + 8);
+        rec->size = (hsize_t)decode_u64(raw + 16);
+        rec->tag = (haddr_t)decode_u64(raw + 24);
+    } /* end while */
+
+    HDfree(raw);
+    HDfclose(fp);
+    *nrecs = n;
+    if(NULL == recs)
+        recs = (trace_rec_t *)HDmalloc(sizeof(trace_rec_t));
+    return recs;
+
+error:
+    if(raw)
+        HDfree(raw);
+    if(recs)
+        HDfree(recs);
+    HDfclose(fp);
+    return NULL;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    cmp_tag / cmp_tag_bytes
+ *
+ * Purpose:     qsort() callbacks for sorting tag statistics by tag address
+ *              and by decreasing number of bytes
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+cmp_tag(const void *_a, const void *_b)
+{
+    const tag_stats_t *a = (const tag_stats_t *)_a;
+    const tag_stats_t *b = (const tag_stats_t *)_b;
+
+    return (a->tag > b->tag) - (a->tag < b->tag);
+}
+
+static int
+cmp_tag_bytes(const void *_a, const void *_b)
+{
+    const tag_stats_t *a = (const tag_stats_t *)_a;
+    const tag_stats_t *b = (const tag_stats_t *)_b;
+
+    return (a->bytes < b->bytes) - (a->bytes > b->bytes);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    summarize
+ *
+ * Purpose:     Print the per memory type and per tag statistics for a trace
+ *
+ * Return:      Success:    0
+ *              Failure:    -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+summarize(const trace_rec_t *recs, size_t nrecs, size_t ntags)
+{
+    type_stats_t stats[H5FD_MEM_NTYPES];
+    tag_stats_t *tags = NULL;
+    size_t nio = 0, ndistinct = 0;
+    size_t u;
+    int i;
+
+    HDmemset(stats, 0, sizeof(stats));
+    if(NULL == (tags = (tag_stats_t *)HDcalloc(nrecs + 1, sizeof(tag_stats_t))))
+        return -1;
+
+    for(u = 0; u < nrecs; u++) {
+        const trace_rec_t *rec = &recs[u];
+
+        if(rec->op == H5FD_LOG_TRACE_OP_READ) {
+            stats[rec->type].nreads++;
+            stats[rec->type].read_bytes += rec->size;
+            stats[rec->type].read_time += rec->elapsed;
+        } /* end if */
+        else if(rec->op == H5FD_LOG_TRACE_OP_WRITE) {
+            stats[rec->type].nwrites++;
+            stats[rec->type].write_bytes += rec->size;
+            stats[rec->type].write_time += rec->elapsed;
+        } /* end if */
+        else
+            continue;
+
+        tags[nio].tag = rec->tag;
+        tags[nio].nops = 1;
+        tags[nio].bytes = rec->size;
+        nio++;
+    } /* end for */
+
+    HDfprintf(stdout, "%-8s %12s %14s %10s %12s %14s %10s\n", "type",
+            "reads", "bytes read", "time (s)", "writes", "bytes written", "time (s)");
+    for(i = 0; i < NTYPES; i++)
+        if(stats[i].nreads || stats[i].nwrites)
+            HDfprintf(stdout, "%-8s %12Hu %14Hu %10.6f %12Hu %14Hu %10.6f\n",
+                    type_names[i], stats[i].nreads, stats[i].read_bytes, stats[i].read_time,
+                    stats[i].nwrites, stats[i].write_bytes, stats[i].write_time);
+
+    /* Aggregate the I/O by tag */
+    if(nio > 0 && ntags > 0) {
+        HDqsort(tags, nio, sizeof(tag_stats_t), cmp_tag);
+        for(u = 1; u < nio; u++) {
+            if(tags[u].tag == tags[ndistinct].tag) {
+                tags[ndistinct].nops += tags[u].nops;
+                tags[ndistinct].bytes += tags[u].bytes;
+            } /* end if */
+            else
+                tags[++ndistinct] = tags[u];
+        } /* end for */
+        ndistinct++;
+        HDqsort(tags, ndistinct, sizeof(tag_stats_t), cmp_tag_bytes);
+
+        HDfprintf(stdout, "\n%lu distinct metadata tags, busiest:\n", (unsigned long)ndistinct);
+        HDfprintf(stdout, "%20s %12s %14s\n", "tag", "operations", "bytes");
+        for(u = 0; u < ndistinct && u < ntags; u++)
+            HDfprintf(stdout, "%20a %12Hu %14Hu\n", tags[u].tag, tags[u].nops, tags[u].bytes);
+    } /* end if */
+
+    HDfree(tags);
+    return 0;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    replay_fapl
+ *
+ * Purpose:     Create a FAPL for the named driver
+ *
+ * Return:      Success:    FAPL ID
+ *              Failure:    -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static hid_t
+replay_fapl(const char *driver)
+{
+    hid_t fapl;
+    herr_t status = -1;
+
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        return -1;
+
+    if(!HDstrcmp(driver, "sec2"))
+        status = H5Pset_fapl_sec2(fapl);
+    else if(!HDstrcmp(driver, "stdio"))
+        status = H5Pset_fapl_stdio(fapl);
+    else if(!HDstrcmp(driver, "core"))
+        status = H5Pset_fapl_core(fapl, (size_t)1024 * 1024, FALSE);
+    else if(!HDstrcmp(driver, "family"))
+        status = H5Pset_fapl_family(fapl, FAMILY_MEMB_SIZE, H5P_DEFAULT);
+    else if(!HDstrcmp(driver, "multi"))
+        status = H5Pset_fapl_multi(fapl, NULL, NULL, NULL, NULL, TRUE);
+    else
+        error_msg("unknown driver \"%s\"\n", driver);
+
+    if(status < 0) {
+        H5Pclose(fapl);
+        return -1;
+    } /* end if */
+
+    return fapl;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    replay
+ *
+ * Purpose:     Re-issue the operations in a trace against a new file
+ *
+ * Return:      Success:    0
+ *              Failure:    -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+replay(const trace_rec_t *recs, size_t nrecs, const char *filename, const char *driver)
+{
+    H5FD_t *file = NULL;
+    hid_t fapl = -1;
+    unsigned char *buf = NULL;
+    size_t buf_size = 0;
+    hsize_t nbytes = 0;
+#ifdef H5_HAVE_GETTIMEOFDAY
+    struct timeval t_start, t_stop;
+    double elapsed;
+#endif /* H5_HAVE_GETTIMEOFDAY */
+    size_t u;
+
+    if((fapl = replay_fapl(driver)) < 0)
+        goto error;
+    if(NULL == (file = H5FDopen(filename, H5F_ACC_RDWR | H5F_ACC_CREAT | H5F_ACC_TRUNC, fapl, HADDR_UNDEF))) {
+        error_msg("unable to create \"%s\"\n", filename);
+        goto error;
+    } /* end if */
+
+#ifdef H5_HAVE_GETTIMEOFDAY
+    HDgettimeofday(&t_start, NULL);
+#endif /* H5_HAVE_GETTIMEOFDAY */
+    for(u = 0; u < nrecs; u++) {
+        const trace_rec_t *rec = &recs[u];
+        H5FD_mem_t type = rec->type;
+
+        switch(rec->op) {
+            case H5FD_LOG_TRACE_OP_READ:
+            case H5FD_LOG_TRACE_OP_WRITE:
+                if(0 == rec->size)
+                    break;
+                if(rec->size > buf_size) {
+                    unsigned char *tmp;
+
+                    H5_ASSIGN_OVERFLOW(buf_size, rec->size, hsize_t, size_t);
+                    if(NULL == (tmp = (unsigned char *)HDrealloc(buf, buf_size))) {
+                        error_msg("unable to allocate I/O buffer\n");
+                        goto error;
+                    } /* end if */
+                    buf = tmp;
+                    HDmemset(buf, 0xaa, buf_size);
+                } /* end if */
+
+                /* Make certain the region is addressable by the driver */
+                if(rec->addr + rec->size > H5FDget_eoa(file, type))
+                    if(H5FDset_eoa(file, type, rec->addr + rec->size) < 0)
+                        goto error;
+
+                if(rec->op == H5FD_LOG_TRACE_OP_READ) {
+                    if(H5FDread(file, type, H5P_DEFAULT, rec->addr, (size_t)rec->size, buf) < 0)
+                        goto error;
+                } /* end if */
+                else {
+                    if(H5FDwrite(file, type, H5P_DEFAULT, rec->addr, (size_t)rec->size, buf) < 0)
+                        goto error;
+                } /* end else */
+                nbytes += rec->size;
+                break;
+
+            case H5FD_LOG_TRACE_OP_EOA:
+                if(H5FDset_eoa(file, type, rec->addr) < 0)
+                    goto error;
+                break;
+
+            case H5FD_LOG_TRACE_OP_TRUNCATE:
+                if(H5FDtruncate(file, H5P_DEFAULT, FALSE) < 0)
+                    goto error;
+                break;
+
+            default:
+                error_msg("unknown trace operation %d, record %lu\n", (int)rec->op, (unsigned long)u);
+                goto error;
+        } /* end switch */
+    } /* end for */
+    if(H5FDclose(file) < 0)
+        goto error;
+    file = NULL;
+#ifdef H5_HAVE_GETTIMEOFDAY
+    HDgettimeofday(&t_stop, NULL);
+#endif /* H5_HAVE_GETTIMEOFDAY */
+
+    HDfprintf(stdout, "\nReplayed %lu operations (%Hu bytes) with the %s driver",
+            (unsigned long)nrecs, nbytes, driver);
+#ifdef H5_HAVE_GETTIMEOFDAY
+    elapsed = (double)(t_stop.tv_sec - t_start.tv_sec) +
+            (double)(t_stop.tv_usec - t_start.tv_usec) / 1000000.0;
+    HDfprintf(stdout, " in %f s", elapsed);
+    if(elapsed > 0.0)
+        HDfprintf(stdout, " (%.2f MB/s)", ((double)nbytes / (1024.0 * 1024.0)) / elapsed);
+#endif /* H5_HAVE_GETTIMEOFDAY */
+    HDfprintf(stdout, "\n");
+
+    HDfree(buf);
+    H5Pclose(fapl);
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        if(file)
+            H5FDclose(file);
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    if(buf)
+        HDfree(buf);
+    return -1;
+}
+
+
+int
+main(int argc, const char *argv[])
+{
+    const char *driver = "sec2";
+    const char *trace_name, *replay_name = DEFAULT_REPLAY_FILE;
+    hbool_t summary_only = FALSE;
+    size_t ntags = DEFAULT_NTAGS;
+    trace_rec_t *recs;
+    size_t nrecs = 0;
+    int opt, ret_value = EXIT_SUCCESS;
+
+    h5tools_setprogname(PROGRAMNAME);
+    h5tools_setstatus(EXIT_SUCCESS);
+    h5tools_init();
+
+    while((opt = get_option(argc, argv, s_opts, l_opts)) != EOF) {
+        switch((char)opt) {
+            case 'h':
+                usage();
+                h5tools_close();
+                return EXIT_SUCCESS;
+            case 's':
+                summary_only = TRUE;
+                break;
+            case 'd':
+                driver = opt_arg;
+                break;
+            case 't':
+                ntags = (size_t)HDatol(opt_arg);
+                break;
+            default:
+                usage();
+                h5tools_close();
+                return EXIT_FAILURE;
+        } /* end switch */
+    } /* end while */
+
+    if(opt_ind >= argc) {
+        usage();
+        h5tools_close();
+        return EXIT_FAILURE;
+    } /* end if */
+    trace_name = argv[opt_ind++];
+    if(opt_ind < argc)
+        replay_name = argv[opt_ind];
+
+    if(NULL == (recs = read_trace(trace_name, &nrecs))) {
+        h5tools_close();
+        return EXIT_FAILURE;
+    } /* end if */
+
+    HDfprintf(stdout, "Trace \"%s\": %lu records\n\n", trace_name, (unsigned long)nrecs);
+    if(summarize(recs, nrecs, ntags) < 0)
+        ret_value = EXIT_FAILURE;
+    else if(!summary_only)
+        if(replay(recs, nrecs, replay_name, driver) < 0)
+            ret_value = EXIT_FAILURE;
+
+    HDfree(recs);
+    h5tools_close();
+
+    return ret_value;
+}
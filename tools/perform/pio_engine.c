@@ -44,9 +44,17 @@
 #if H5_VERS_MAJOR == 1 && H5_VERS_MINOR == 6
 #    define H5DCREATE(fd, name, type, space, dcpl)    H5Dcreate(fd, name, type, space, dcpl)
 #    define H5DOPEN(fd, name)                         H5Dopen(fd, name)
+#    define H5GCREATE(fd, name)                       H5Gcreate(fd, name, 0)
+#    define H5GOPEN(fd, name)                         H5Gopen(fd, name)
+#    define H5ACREATE(obj, name, type, space)         H5Acreate(obj, name, type, space, H5P_DEFAULT)
+#    define H5AOPEN(obj, name)                        H5Aopen_name(obj, name)
 #else
 #    define H5DCREATE(fd, name, type, space, dcpl)    H5Dcreate2(fd, name, type, space, H5P_DEFAULT, dcpl, H5P_DEFAULT)
 #    define H5DOPEN(fd, name)                         H5Dopen2(fd, name, H5P_DEFAULT)
+#    define H5GCREATE(fd, name)                       H5Gcreate2(fd, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)
+#    define H5GOPEN(fd, name)                         H5Gopen2(fd, name, H5P_DEFAULT)
+#    define H5ACREATE(obj, name, type, space)         H5Acreate2(obj, name, type, space, H5P_DEFAULT, H5P_DEFAULT)
+#    define H5AOPEN(obj, name)                        H5Aopen(obj, name, H5P_DEFAULT)
 #endif
 
 /* sizes of various items. these sizes won't change during program execution */
@@ -55,6 +63,10 @@
 #define ELMT_MPI_TYPE       MPI_BYTE
 #define ELMT_H5_TYPE        H5T_NATIVE_UCHAR
 
+/* settings of the filtered and attribute scenarios */
+#define PIO_DEFLATE_LEVEL   1       /* compression level of the filtered scenario */
+#define PIO_ATTR_NELMTS     16      /* number of integers in each attribute */
+
 #define GOTOERROR(errcode)  { ret_code = errcode; goto done; }
 #define GOTODONE        { goto done; }
 #define ERRMSG(mesg) {                                                  \
@@ -129,6 +141,8 @@ static herr_t do_fopen(parameters *param, char *fname, file_descr *fd /*out*/,
     int flags);
 static herr_t do_fclose(iotype iot, file_descr *fd);
 static void do_cleanupfile(iotype iot, char *fname);
+static herr_t do_objects(file_descr *fd, parameters *parms, int flags);
+static herr_t do_attrs(hid_t h5ds_id, parameters *parms, int flags);
 
 /*
  * Function:        do_pio
@@ -276,6 +290,15 @@ do_pio(parameters param)
     GOTOERROR(FAIL);
     }
 
+    /* Give the filtered scenario data which compresses the same way
+     * every time */
+    if (param.h5_scenario == SCENARIO_FILTERED) {
+        size_t u;
+
+        for (u = 0; u < bsize; u++)
+            buffer[u] = (char)(u % 251);
+    }
+
     if (pio_debug_level >= 4) {
     int myrank;
 
@@ -860,6 +883,15 @@ do_write(results *res, file_descr *fd, parameters *parms, long ndsets,
         break;
     } /* end switch */
 
+    /* Create the groups of the objects scenario */
+    if (parms->io_type == PHDF5 && parms->h5_scenario == SCENARIO_OBJECTS) {
+        set_time(res->timers, HDF5_METADATA_WRITE, TSTART);
+        hrc = do_objects(fd, parms, PIO_CREATE);
+        set_time(res->timers, HDF5_METADATA_WRITE, TSTOP);
+        if (hrc < 0)
+            GOTOERROR(FAIL);
+    } /* end if */
+
     for (ndset = 1; ndset <= ndsets; ++ndset) {
 
     /* Calculate dataset offset within a file */
@@ -873,6 +905,9 @@ do_write(results *res, file_descr *fd, parameters *parms, long ndsets,
             break;
 
         case PHDF5:
+            /* Start "metadata" write timer */
+            set_time(res->timers, HDF5_METADATA_WRITE, TSTART);
+
             h5dcpl = H5Pcreate(H5P_DATASET_CREATE);
             if (h5dcpl < 0) {
                 fprintf(stderr, "HDF5 Property List Create failed\n");
@@ -905,6 +940,15 @@ do_write(results *res, file_descr *fd, parameters *parms, long ndsets,
                 } /* end if */
             }/* end else */
 
+            /* Compress the chunks of the filtered scenario */
+            if (parms->h5_scenario == SCENARIO_FILTERED) {
+                hrc = H5Pset_deflate(h5dcpl, PIO_DEFLATE_LEVEL);
+                if (hrc < 0) {
+                    fprintf(stderr, "HDF5 Property List Set failed\n");
+                    GOTOERROR(FAIL);
+                } /* end if */
+            } /* end if */
+
             sprintf(dname, "Dataset_%ld", ndset);
             h5ds_id = H5DCREATE(fd->h5fd, dname, ELMT_H5_TYPE,
                 h5dset_space_id, h5dcpl);
@@ -920,6 +964,16 @@ do_write(results *res, file_descr *fd, parameters *parms, long ndsets,
                 fprintf(stderr, "HDF5 Property List Close failed\n");
                 GOTOERROR(FAIL);
             }
+
+            /* Attach the attributes of the attribute scenario */
+            if (parms->h5_scenario == SCENARIO_ATTRS) {
+                hrc = do_attrs(h5ds_id, parms, PIO_CREATE);
+                if (hrc < 0)
+                    GOTOERROR(FAIL);
+            } /* end if */
+
+            /* Stop "metadata" write timer */
+            set_time(res->timers, HDF5_METADATA_WRITE, TSTOP);
             break;
     }
 
@@ -1387,7 +1441,9 @@ do_write(results *res, file_descr *fd, parameters *parms, long ndsets,
 
     /* Close dataset. Only HDF5 needs to do an explicit close. */
     if (parms->io_type == PHDF5) {
+        set_time(res->timers, HDF5_METADATA_WRITE, TSTART);
         hrc = H5Dclose(h5ds_id);
+        set_time(res->timers, HDF5_METADATA_WRITE, TSTOP);
 
         if (hrc < 0) {
         fprintf(stderr, "HDF5 Dataset Close failed\n");
@@ -1831,6 +1887,15 @@ do_read(results *res, file_descr *fd, parameters *parms, long ndsets,
         break;
     } /* end switch */
 
+    /* Open the groups of the objects scenario */
+    if (parms->io_type == PHDF5 && parms->h5_scenario == SCENARIO_OBJECTS) {
+        set_time(res->timers, HDF5_METADATA_READ, TSTART);
+        hrc = do_objects(fd, parms, PIO_READ);
+        set_time(res->timers, HDF5_METADATA_READ, TSTOP);
+        if (hrc < 0)
+            GOTOERROR(FAIL);
+    } /* end if */
+
     for (ndset = 1; ndset <= ndsets; ++ndset) {
 
     /* Calculate dataset offset within a file */
@@ -1844,6 +1909,9 @@ do_read(results *res, file_descr *fd, parameters *parms, long ndsets,
         break;
 
         case PHDF5:
+        /* Start "metadata" read timer */
+        set_time(res->timers, HDF5_METADATA_READ, TSTART);
+
         sprintf(dname, "Dataset_%ld", ndset);
         h5ds_id = H5DOPEN(fd->h5fd, dname);
         if (h5ds_id < 0) {
@@ -1851,6 +1919,15 @@ do_read(results *res, file_descr *fd, parameters *parms, long ndsets,
             GOTOERROR(FAIL);
         }
 
+        /* Read back the attributes of the attribute scenario */
+        if (parms->h5_scenario == SCENARIO_ATTRS) {
+            hrc = do_attrs(h5ds_id, parms, PIO_READ);
+            if (hrc < 0)
+                GOTOERROR(FAIL);
+        } /* end if */
+
+        /* Stop "metadata" read timer */
+        set_time(res->timers, HDF5_METADATA_READ, TSTOP);
         break;
     }
 
@@ -2342,7 +2419,9 @@ do_read(results *res, file_descr *fd, parameters *parms, long ndsets,
 
     /* Close dataset. Only HDF5 needs to do an explicit close. */
     if (parms->io_type == PHDF5) {
+        set_time(res->timers, HDF5_METADATA_READ, TSTART);
         hrc = H5Dclose(h5ds_id);
+        set_time(res->timers, HDF5_METADATA_READ, TSTOP);
 
         if (hrc < 0) {
         fprintf(stderr, "HDF5 Dataset Close failed\n");
@@ -2623,6 +2702,132 @@ do_cleanupfile(iotype iot, char *fname)
     }
 }
 
+/*
+ * Function:    do_objects
+ * Purpose:     Create (PIO_CREATE) or open (PIO_READ) the groups of the
+ *              objects scenario, to measure the cost of many small
+ *              metadata operations on a file.
+ * Return:      SUCCESS or FAIL
+ */
+    static herr_t
+do_objects(file_descr *fd, parameters *parms, int flags)
+{
+    int         ret_code = SUCCESS;
+    long        nobj;
+    char        gname[64];
+    hid_t       h5grp_id;       /*group handle                  */
+    herr_t      hrc;            /*HDF5 return code              */
+
+    for (nobj = 1; nobj <= parms->h5_num_objs; ++nobj) {
+        sprintf(gname, "Group_%ld", nobj);
+
+        if (flags & PIO_CREATE)
+            h5grp_id = H5GCREATE(fd->h5fd, gname);
+        else
+            h5grp_id = H5GOPEN(fd->h5fd, gname);
+        if (h5grp_id < 0) {
+            fprintf(stderr, "HDF5 Group %s failed\n",
+                ((flags & PIO_CREATE) ? "Create" : "Open"));
+            GOTOERROR(FAIL);
+        }
+
+        hrc = H5Gclose(h5grp_id);
+        if (hrc < 0) {
+            fprintf(stderr, "HDF5 Group Close failed\n");
+            GOTOERROR(FAIL);
+        }
+    }
+
+done:
+    return ret_code;
+}
+
+/*
+ * Function:    do_attrs
+ * Purpose:     Create and write (PIO_CREATE) or open and read (PIO_READ)
+ *              the attributes of a dataset in the attribute scenario.
+ *              Every process writes the same values, as attribute
+ *              writes are collective.
+ * Return:      SUCCESS or FAIL
+ */
+    static herr_t
+do_attrs(hid_t h5ds_id, parameters *parms, int flags)
+{
+    int         ret_code = SUCCESS;
+    long        nattr;
+    int         i;
+    char        aname[64];
+    int         attr_buf[PIO_ATTR_NELMTS];
+    hsize_t     h5dims[1] = {PIO_ATTR_NELMTS};
+    hid_t       h5attr_space_id = -1;   /*attribute space ID            */
+    hid_t       h5attr_id = -1;         /*attribute handle              */
+    herr_t      hrc;                    /*HDF5 return code              */
+
+    if (flags & PIO_CREATE) {
+        h5attr_space_id = H5Screate_simple(1, h5dims, NULL);
+        if (h5attr_space_id < 0) {
+            fprintf(stderr, "HDF5 Attribute Space Create failed\n");
+            GOTOERROR(FAIL);
+        }
+    }
+
+    for (nattr = 1; nattr <= parms->h5_num_objs; ++nattr) {
+        sprintf(aname, "Attribute_%ld", nattr);
+
+        if (flags & PIO_CREATE) {
+            for (i = 0; i < PIO_ATTR_NELMTS; i++)
+                attr_buf[i] = (int)nattr + i;
+
+            h5attr_id = H5ACREATE(h5ds_id, aname, H5T_NATIVE_INT,
+                h5attr_space_id);
+            if (h5attr_id < 0) {
+                fprintf(stderr, "HDF5 Attribute Create failed\n");
+                GOTOERROR(FAIL);
+            }
+
+            hrc = H5Awrite(h5attr_id, H5T_NATIVE_INT, attr_buf);
+            if (hrc < 0) {
+                fprintf(stderr, "HDF5 Attribute Write failed\n");
+                GOTOERROR(FAIL);
+            }
+        } else {
+            h5attr_id = H5AOPEN(h5ds_id, aname);
+            if (h5attr_id < 0) {
+                fprintf(stderr, "HDF5 Attribute Open failed\n");
+                GOTOERROR(FAIL);
+            }
+
+            hrc = H5Aread(h5attr_id, H5T_NATIVE_INT, attr_buf);
+            if (hrc < 0) {
+                fprintf(stderr, "HDF5 Attribute Read failed\n");
+                GOTOERROR(FAIL);
+            }
+
+            if (parms->verify)
+                for (i = 0; i < PIO_ATTR_NELMTS; i++)
+                    if (attr_buf[i] != (int)nattr + i) {
+                        fprintf(stderr, "Attribute %s verify failed\n", aname);
+                        GOTOERROR(FAIL);
+                    }
+        }
+
+        hrc = H5Aclose(h5attr_id);
+        h5attr_id = -1;
+        if (hrc < 0) {
+            fprintf(stderr, "HDF5 Attribute Close failed\n");
+            GOTOERROR(FAIL);
+        }
+    }
+
+done:
+    if (h5attr_id != -1)
+        H5Aclose(h5attr_id);
+    if (h5attr_space_id != -1)
+        H5Sclose(h5attr_space_id);
+
+    return ret_code;
+}
+
 #ifdef TIME_MPI
 /* instrument the MPI_File_wrirte_xxx and read_xxx calls to measure
  * pure time spent in MPI_File code.
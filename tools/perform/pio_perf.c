@@ -110,6 +110,7 @@ int         pio_debug_level = 0;/* The debug level:
 
 /* local variables */
 static const char  *progname = "h5perf";
+static FILE        *machine_output = NULL; /* machine-readable results file */
 
 /*
  * Command-line options: The user can specify short or long-named
@@ -117,9 +118,9 @@ static const char  *progname = "h5perf";
  * adding more, make sure that they don't clash with each other.
  */
 #if 1
-static const char *s_opts = "a:A:B:cCd:D:e:F:ghi:Imno:p:P:stT:wx:X:";
+static const char *s_opts = "a:A:B:cCd:D:e:F:ghi:Im:n:o:p:P:sS:tT:wx:X:";
 #else
-static const char *s_opts = "a:A:bB:cCd:D:e:F:ghi:Imno:p:P:stT:wx:X:";
+static const char *s_opts = "a:A:bB:cCd:D:e:F:ghi:Im:n:o:p:P:sS:tT:wx:X:";
 #endif  /* 1 */
 static struct long_options l_opts[] = {
     { "align", require_arg, 'a' },
@@ -172,6 +173,19 @@ static struct long_options l_opts[] = {
     { "help", no_arg, 'h' },
     { "hel", no_arg, 'h' },
     { "he", no_arg, 'h' },
+    { "machine-readable", require_arg, 'm' },
+    { "machine-readabl", require_arg, 'm' },
+    { "machine-readab", require_arg, 'm' },
+    { "machine-reada", require_arg, 'm' },
+    { "machine-read", require_arg, 'm' },
+    { "machine-rea", require_arg, 'm' },
+    { "machine-re", require_arg, 'm' },
+    { "machine-r", require_arg, 'm' },
+    { "machine", require_arg, 'm' },
+    { "machin", require_arg, 'm' },
+    { "machi", require_arg, 'm' },
+    { "mach", require_arg, 'm' },
+    { "mac", require_arg, 'm' },
     { "interleaved", require_arg, 'I' },
     { "interleave", require_arg, 'I' },
     { "interleav", require_arg, 'I' },
@@ -231,6 +245,13 @@ static struct long_options l_opts[] = {
     { "num-fil", require_arg, 'F' },
     { "num-fi", require_arg, 'F' },
     { "num-f", require_arg, 'F' },
+    { "num-objects", require_arg, 'n' },
+    { "num-object", require_arg, 'n' },
+    { "num-objec", require_arg, 'n' },
+    { "num-obje", require_arg, 'n' },
+    { "num-obj", require_arg, 'n' },
+    { "num-ob", require_arg, 'n' },
+    { "num-o", require_arg, 'n' },
     { "num-iterations", require_arg, 'i' },
     { "num-iteration", require_arg, 'i' },
     { "num-iteratio", require_arg, 'i' },
@@ -246,6 +267,13 @@ static struct long_options l_opts[] = {
     { "outp", require_arg, 'o' },
     { "out", require_arg, 'o' },
     { "ou", require_arg, 'o' },
+    { "scenario", require_arg, 'S' },
+    { "scenari", require_arg, 'S' },
+    { "scenar", require_arg, 'S' },
+    { "scena", require_arg, 'S' },
+    { "scen", require_arg, 'S' },
+    { "sce", require_arg, 'S' },
+    { "sc", require_arg, 'S' },
     { "threshold", require_arg, 'T' },
     { "threshol", require_arg, 'T' },
     { "thresho", require_arg, 'T' },
@@ -287,6 +315,9 @@ struct options {
     int h5_use_chunks;     	/* Make HDF5 dataset chunked            */
     int h5_write_only;        	/* Perform the write tests only         */
     int verify;        		/* Verify data correctness              */
+    scenario h5_scenario;       /* Kind of HDF5 workload to run         */
+    long h5_num_objs;           /* Number of groups or attributes       */
+    const char *machine_file;   /* file to print machine-readable results */
 };
 
 typedef struct _minmax {
@@ -310,6 +341,10 @@ static void output_results(const struct options *options, const char *name,
                            minmax *table, int table_size, off_t data_size);
 static void output_times(const struct options *options, const char *name,
                            minmax *table, int table_size);
+static void output_machine(const struct options *options, const parameters *parms,
+                           const char *api, const char *op, const char *phase,
+                           minmax *table, off_t data_size);
+static const char *scenario_name(scenario s);
 static void output_report(const char *fmt, ...);
 static void print_indent(register int indent);
 static void usage(const char *prog);
@@ -385,12 +420,28 @@ main(int argc, char **argv)
         }
     }
 
+    /* Only process 0 reports the machine-readable results */
+    if (opts->machine_file && comm_world_rank_g == 0) {
+        if ((machine_output = fopen(opts->machine_file, "w")) == NULL) {
+            fprintf(stderr, "%s: cannot open machine-readable output file\n", progname);
+            perror(opts->machine_file);
+            exit_value = EXIT_FAILURE;
+            goto finish;
+        }
+
+        fprintf(machine_output, "api,scenario,procs,files,dsets,objects,"
+                "xfer_size,operation,phase,iterations,min_time,avg_time,"
+                "max_time,avg_mbps\n");
+    }
+
     if ((pio_debug_level == 0 && comm_world_rank_g == 0) || pio_debug_level > 0)
         report_parameters(opts);
 
     run_test_loop(opts);
 
 finish:
+    if (machine_output)
+        fclose(machine_output);
     MPI_Finalize();
     free(opts);
     return exit_value;
@@ -436,6 +487,8 @@ run_test_loop(struct options *opts)
     parms.h5_use_chunks = opts->h5_use_chunks;
     parms.h5_write_only = opts->h5_write_only;
     parms.verify = opts->verify;
+    parms.h5_scenario = opts->h5_scenario;
+    parms.h5_num_objs = opts->h5_num_objs;
 
     /* start with max_num_procs and decrement it by half for each loop. */
     /* if performance needs restart, fewer processes may be needed. */
@@ -533,6 +586,8 @@ run_test(iotype iot, parameters parms, struct options *opts)
     minmax         *read_close_mm_table=NULL;
     minmax         *write_open_mm_table=NULL;
     minmax         *write_close_mm_table=NULL;
+    minmax         *write_meta_mm_table=NULL;
+    minmax         *read_meta_mm_table=NULL;
     minmax          write_mpi_mm = {0.0, 0.0, 0.0, 0};
     minmax          write_mm = {0.0, 0.0, 0.0, 0};
     minmax          write_gross_mm = {0.0, 0.0, 0.0, 0};
@@ -545,6 +600,9 @@ run_test(iotype iot, parameters parms, struct options *opts)
     minmax          read_close_mm = {0.0, 0.0, 0.0, 0};
     minmax          write_open_mm = {0.0, 0.0, 0.0, 0};
     minmax          write_close_mm = {0.0, 0.0, 0.0, 0};
+    minmax          write_meta_mm = {0.0, 0.0, 0.0, 0};
+    minmax          read_meta_mm = {0.0, 0.0, 0.0, 0};
+    const char     *api = NULL;
 
     raw_size = parms.num_files * (off_t)parms.num_dsets * (off_t)parms.num_bytes;
     parms.io_type = iot;
@@ -554,12 +612,15 @@ run_test(iotype iot, parameters parms, struct options *opts)
     switch (iot) {
         case POSIXIO:
             output_report("POSIX\n");
+            api = "posix";
             break;
         case MPIO:
             output_report("MPIO\n");
+            api = "mpiio";
             break;
         case PHDF5:
             output_report("PHDF5 (w/MPI-IO driver)\n");
+            api = "phdf5";
             break;
     }
 
@@ -573,6 +634,7 @@ run_test(iotype iot, parameters parms, struct options *opts)
     write_raw_mm_table = calloc((size_t)parms.num_iters , sizeof(minmax));
     write_open_mm_table = calloc((size_t)parms.num_iters , sizeof(minmax));
     write_close_mm_table = calloc((size_t)parms.num_iters , sizeof(minmax));
+    write_meta_mm_table = calloc((size_t)parms.num_iters , sizeof(minmax));
     if (!parms.h5_write_only) {
         read_mpi_mm_table = calloc((size_t)parms.num_iters , sizeof(minmax));
         read_mm_table = calloc((size_t)parms.num_iters , sizeof(minmax));
@@ -580,6 +642,7 @@ run_test(iotype iot, parameters parms, struct options *opts)
         read_raw_mm_table = calloc((size_t)parms.num_iters , sizeof(minmax));
         read_open_mm_table = calloc((size_t)parms.num_iters , sizeof(minmax));
         read_close_mm_table = calloc((size_t)parms.num_iters , sizeof(minmax));
+        read_meta_mm_table = calloc((size_t)parms.num_iters , sizeof(minmax));
     }
 
     /* Do IO iteration times, collecting statistics each time */
@@ -625,6 +688,12 @@ run_test(iotype iot, parameters parms, struct options *opts)
 
         write_close_mm_table[i] = write_close_mm;
 
+        /* gather all of the metadata times (object create, attribute write, ...) */
+        t = get_time(res.timers, HDF5_METADATA_WRITE);
+        get_minmax(&write_meta_mm, t);
+
+        write_meta_mm_table[i] = write_meta_mm;
+
         if (!parms.h5_write_only) {
             /* gather all of the "mpi read" times */
             t = get_time(res.timers, HDF5_MPI_READ);
@@ -662,6 +731,11 @@ run_test(iotype iot, parameters parms, struct options *opts)
 
             read_close_mm_table[i] = read_close_mm;
 
+            /* gather all of the metadata times (object open, attribute read, ...) */
+            t = get_time(res.timers, HDF5_METADATA_READ);
+            get_minmax(&read_meta_mm, t);
+
+            read_meta_mm_table[i] = read_meta_mm;
          }
 
          io_time_destroy(res.timers);
@@ -719,6 +793,16 @@ run_test(iotype iot, parameters parms, struct options *opts)
         output_times(opts,"Write File Close",write_close_mm_table,parms.num_iters);
     }
 
+    /* The metadata scenarios are all about the metadata time */
+    if (iot == PHDF5 && (opts->print_times || parms.h5_scenario != SCENARIO_DATA))
+        output_times(opts,"Write Metadata",write_meta_mm_table,parms.num_iters);
+
+    output_machine(opts, &parms, api, "write", "open", write_open_mm_table, (off_t)0);
+    output_machine(opts, &parms, api, "write", "metadata", write_meta_mm_table, (off_t)0);
+    output_machine(opts, &parms, api, "write", "raw", write_raw_mm_table, raw_size);
+    output_machine(opts, &parms, api, "write", "close", write_close_mm_table, (off_t)0);
+    output_machine(opts, &parms, api, "write", "total", write_gross_mm_table, raw_size);
+
     /* Print out time from open to first write */
     if (pio_debug_level >= 3) {
        /* output all of the times for all iterations */
@@ -786,6 +870,15 @@ run_test(iotype iot, parameters parms, struct options *opts)
             output_times(opts,"Read File Close",read_close_mm_table,parms.num_iters);
         }
 
+        if (iot == PHDF5 && (opts->print_times || parms.h5_scenario != SCENARIO_DATA))
+            output_times(opts,"Read Metadata",read_meta_mm_table,parms.num_iters);
+
+        output_machine(opts, &parms, api, "read", "open", read_open_mm_table, (off_t)0);
+        output_machine(opts, &parms, api, "read", "metadata", read_meta_mm_table, (off_t)0);
+        output_machine(opts, &parms, api, "read", "raw", read_raw_mm_table, raw_size);
+        output_machine(opts, &parms, api, "read", "close", read_close_mm_table, (off_t)0);
+        output_machine(opts, &parms, api, "read", "total", read_gross_mm_table, raw_size);
+
         /* Print out time from open to first read */
         if (pio_debug_level >= 3) {
             /* output all of the times for all iterations */
@@ -811,6 +904,7 @@ run_test(iotype iot, parameters parms, struct options *opts)
     free(write_raw_mm_table);
     free(write_open_mm_table);
     free(write_close_mm_table);
+    free(write_meta_mm_table);
 
     if (!parms.h5_write_only) {
         free(read_mpi_mm_table);
@@ -819,6 +913,7 @@ run_test(iotype iot, parameters parms, struct options *opts)
         free(read_raw_mm_table);
         free(read_open_mm_table);
         free(read_close_mm_table);
+        free(read_meta_mm_table);
     }
 
     return ret_value;
@@ -1051,6 +1146,59 @@ output_times(const struct options *opts, const char *name, minmax *table,
         output_report("Maximum Accumulated Time using %d file(s): %7.5f s\n", opts->num_files,(total_mm.max));
 }
 
+/*
+ * Function:    output_machine
+ * Purpose:     Print one phase of a test as a line of comma-separated
+ *              values to the machine-readable results file, if there is
+ *              one.  The bandwidth is only meaningful for phases moving
+ *              raw data; pass a DATA_SIZE of 0 for the others.
+ * Return:      Nothing
+ * Modifications:
+ */
+static void
+output_machine(const struct options *opts, const parameters *parms,
+    const char *api, const char *op, const char *phase, minmax *table,
+    off_t data_size)
+{
+    minmax          total_mm;
+    double          avg;
+
+    if (!machine_output)
+        return;
+
+    total_mm = accumulate_minmax_stuff(table, parms->num_iters);
+    avg = total_mm.sum / total_mm.num;
+
+    HDfprintf(machine_output, "%s,%s,%d,%ld,%ld,%ld,%zu,%s,%s,%d,%.6f,%.6f,%.6f,%.2f\n",
+              api, scenario_name(opts->h5_scenario), parms->num_procs,
+              parms->num_files, parms->num_dsets, parms->h5_num_objs,
+              parms->buf_size, op, phase, parms->num_iters,
+              total_mm.min, avg, total_mm.max,
+              (data_size > 0 ? MB_PER_SEC(data_size, avg) : 0.0));
+}
+
+/*
+ * Function:    scenario_name
+ * Purpose:     Return the command line name of a test scenario.
+ * Return:      The name
+ * Modifications:
+ */
+static const char *
+scenario_name(scenario s)
+{
+    switch (s) {
+        case SCENARIO_FILTERED:
+            return "filtered";
+        case SCENARIO_OBJECTS:
+            return "objects";
+        case SCENARIO_ATTRS:
+            return "attrs";
+        case SCENARIO_DATA:
+        default:
+            return "data";
+    }
+}
+
 /*
  * Function:    output_report
  * Purpose:     Print a line of the report. Only do so if I'm the 0 process.
@@ -1227,6 +1375,15 @@ report_parameters(struct options *opts)
     else
         HDfprintf(output, "Contiguous\n");
 
+    HDfprintf(output, "rank %d: HDF5 scenario=%s\n", rank,
+              scenario_name(opts->h5_scenario));
+    if(opts->h5_scenario == SCENARIO_OBJECTS)
+        HDfprintf(output, "rank %d: Number of groups per file=%ld\n", rank,
+                  opts->h5_num_objs);
+    else if(opts->h5_scenario == SCENARIO_ATTRS)
+        HDfprintf(output, "rank %d: Number of attributes per dataset=%ld\n", rank,
+                  opts->h5_num_objs);
+
     {
         char *prefix = getenv("HDF5_PARAPREFIX");
 
@@ -1279,6 +1436,9 @@ parse_command_line(int argc, char *argv[])
     cl_opts->h5_use_chunks = FALSE; /* Don't chunk the HDF5 dataset by default */
     cl_opts->h5_write_only = FALSE; /* Do both read and write by default */
     cl_opts->verify = FALSE;        /* No Verify data correctness by default */
+    cl_opts->h5_scenario = SCENARIO_DATA; /* Raw data throughput by default */
+    cl_opts->h5_num_objs = 100;     /* 100 groups or attributes by default */
+    cl_opts->machine_file = NULL;   /* No machine-readable results by default */
 
     while ((opt = get_option(argc, (const char **)argv, s_opts, l_opts)) != EOF) {
         switch ((char)opt) {
@@ -1410,6 +1570,12 @@ parse_command_line(int argc, char *argv[])
         case 'I':
             cl_opts->interleaved = 1;
             break;
+        case 'm':
+            cl_opts->machine_file = opt_arg;
+            break;
+        case 'n':
+            cl_opts->h5_num_objs = atol(opt_arg);
+            break;
         case 'o':
             cl_opts->output_file = opt_arg;
             break;
@@ -1419,6 +1585,21 @@ parse_command_line(int argc, char *argv[])
         case 'P':
             cl_opts->max_num_procs = atoi(opt_arg);
             break;
+        case 'S':
+            if (!HDstrcasecmp(opt_arg, "data")) {
+                cl_opts->h5_scenario = SCENARIO_DATA;
+            } else if (!HDstrcasecmp(opt_arg, "filtered")) {
+                cl_opts->h5_scenario = SCENARIO_FILTERED;
+            } else if (!HDstrcasecmp(opt_arg, "objects")) {
+                cl_opts->h5_scenario = SCENARIO_OBJECTS;
+            } else if (!HDstrcasecmp(opt_arg, "attrs")) {
+                cl_opts->h5_scenario = SCENARIO_ATTRS;
+            } else {
+                fprintf(stderr, "pio_perf: invalid --scenario option %s\n",
+                        opt_arg);
+                exit(EXIT_FAILURE);
+            }
+            break;
         case 'T':
             cl_opts->h5_threshold = parse_size_directive(opt_arg);
             break;
@@ -1458,6 +1639,32 @@ parse_command_line(int argc, char *argv[])
         cl_opts->blk_size = (cl_opts->num_bpp)/2;
 
 
+    /* The scenarios other than raw data throughput only apply to HDF5 */
+    if (cl_opts->h5_scenario != SCENARIO_DATA) {
+        if (cl_opts->io_types & ~PIO_HDF5) {
+            fprintf(stderr, "pio_perf: the %s scenario only applies to the phdf5 API\n",
+                    scenario_name(cl_opts->h5_scenario));
+            exit(EXIT_FAILURE);
+        }
+        cl_opts->io_types = PIO_HDF5;
+    }
+
+    /* Writes to filtered datasets must be collective and chunked */
+    if (cl_opts->h5_scenario == SCENARIO_FILTERED) {
+        if (!cl_opts->collective) {
+            fprintf(stderr, "pio_perf: the filtered scenario requires collective I/O (--collective)\n");
+            exit(EXIT_FAILURE);
+        }
+        if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0) {
+            fprintf(stderr, "pio_perf: the filtered scenario requires the deflate filter\n");
+            exit(EXIT_FAILURE);
+        }
+        cl_opts->h5_use_chunks = TRUE;
+    }
+
+    if (cl_opts->h5_num_objs < 0)
+        cl_opts->h5_num_objs = 0;
+
     /* set default if none specified yet */
     if (!cl_opts->io_types)
     cl_opts->io_types = PIO_HDF5 | PIO_MPI | PIO_POSIX; /* run all API */
@@ -1582,10 +1789,18 @@ usage(const char *prog)
         printf("     -I, --interleaved           Interleaved access pattern\n");
         printf("                                 (see below for example)\n");
         printf("                                 [default: Contiguous access pattern]\n");
+        printf("     -m F, --machine-readable=F  Write results as comma-separated values,\n");
+        printf("                                 one line per test phase, into file F\n");
+        printf("                                 [default: none]\n");
+        printf("     -n N, --num-objects=N       Number of groups per file or attributes per\n");
+        printf("                                 dataset for the objects and attrs scenarios\n");
+        printf("                                 [default: 100]\n");
         printf("     -o F, --output=F            Output raw data into file F [default: none]\n");
         printf("     -p N, --min-num-processes=N Minimum number of processes to use [default: 1]\n");
         printf("     -P N, --max-num-processes=N Maximum number of processes to use\n");
         printf("                                 [default: all MPI_COMM_WORLD processes ]\n");
+        printf("     -S W, --scenario=W          HDF5 workload to run (see below)\n");
+        printf("                                 [default: data]\n");
         printf("     -T S, --threshold=S         Threshold for alignment of objects in HDF5 file\n");
         printf("                                 [default: 1]\n");
         printf("     -w, --write-only            Perform write tests not the read tests\n");
@@ -1613,6 +1828,20 @@ usage(const char *prog)
         printf("\n");
         printf("      Example: --api=mpiio,phdf5\n");
         printf("\n");
+        printf("  W  - is a scenario. Scenarios other than data only run the phdf5 API.\n");
+        printf("      Valid values are:\n");
+        printf("          data     - Raw data throughput\n");
+        printf("          filtered - Raw data throughput to chunked datasets compressed\n");
+        printf("                     with the deflate filter; requires --collective\n");
+        printf("          objects  - Also create, then open, num-objects groups per file\n");
+        printf("          attrs    - Also write, then read, num-objects small attributes\n");
+        printf("                     per dataset\n");
+        printf("\n");
+        printf("      Each test is timed in phases: open (file open), metadata (dataset,\n");
+        printf("      group and attribute operations), raw (raw data transfer) and close\n");
+        printf("      (file close).  The metadata times are printed for scenarios other than\n");
+        printf("      data, or with --debug=t.\n");
+        printf("\n");
         printf("  Dataset size:\n");
         printf("      Depending on the selected geometry, each test dataset is either a linear\n");
         printf("      array of size bytes-per-process * num-processes, or a square array of size\n");
@@ -1716,6 +1945,12 @@ void debug_start_stop_time(io_time_t *pt, timer_type t, int start_stop)
             case HDF5_RAW_READ_FIXED_DIMS:
                 msg = "Raw Read";
                 break;
+            case HDF5_METADATA_WRITE:
+                msg = "Metadata Write";
+                break;
+            case HDF5_METADATA_READ:
+                msg = "Metadata Read";
+                break;
             default:
                 msg = "Unknown Timer";
                 break;
@@ -38,6 +38,14 @@ typedef enum iotype_ {
     /*NUM_TYPES*/
 } iotype;
 
+/* The kind of workload to run through the PHDF5 API */
+typedef enum scenario_ {
+    SCENARIO_DATA,      /* Raw data throughput (the default)    */
+    SCENARIO_FILTERED,  /* Raw data through a compression filter */
+    SCENARIO_OBJECTS,   /* Create/open many groups per file     */
+    SCENARIO_ATTRS      /* Create/read many attributes per dset */
+} scenario;
+
 typedef struct parameters_ {
     iotype	io_type;        /* The type of IO test to perform       */
     int		num_procs;      /* Maximum number of processes to use   */
@@ -55,6 +63,8 @@ typedef struct parameters_ {
     int 	h5_use_chunks;  /* Make HDF5 dataset chunked            */
     int    	h5_write_only;  /* Perform the write tests only         */
     int 	verify;    	/* Verify data correctness              */
+    scenario    h5_scenario;    /* Kind of HDF5 workload to run         */
+    long        h5_num_objs;    /* Number of groups or attributes       */
 } parameters;
 
 typedef struct results_ {
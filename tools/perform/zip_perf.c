@@ -66,7 +66,7 @@ static const char *option_prefix=NULL;
 static char *filename=NULL;
 static int compress_percent = 0;
 static int compress_level = Z_DEFAULT_COMPRESSION;
-static int output, random_test = FALSE;
+static int output, random_test = FALSE, filter_test = FALSE;
 static int report_once_flag;
 static double compression_time;
 
@@ -76,7 +76,7 @@ static void compress_buffer(Bytef *dest, uLongf *destLen, const Bytef *source,
                             uLong sourceLen);
 
 /* commandline options : long and short form */
-static const char *s_opts = "hB:b:c:p:rs:0123456789";
+static const char *s_opts = "hB:b:c:Fp:rs:0123456789";
 static struct long_options l_opts[] = {
     { "help", no_arg, 'h' },
     { "compressability", require_arg, 'c' },
@@ -136,6 +136,11 @@ static struct long_options l_opts[] = {
     { "rand", no_arg, 'r' },
     { "ran", no_arg, 'r' },
     { "ra", no_arg, 'r' },
+    { "filter-test", no_arg, 'F' },
+    { "filter-tes", no_arg, 'F' },
+    { "filter-te", no_arg, 'F' },
+    { "filter-t", no_arg, 'F' },
+    { "filter", no_arg, 'F' },
     { NULL, 0, '\0' }
 };
 
@@ -340,6 +345,11 @@ usage(void)
     HDfprintf(stdout, "     -p D, --prefix=D           The directory prefix to place the file\n");
     HDfprintf(stdout, "     -r, --random-test          Use random data to write to the file\n");
     HDfprintf(stdout, "                                [default: no]\n");
+    HDfprintf(stdout, "     -F, --filter-test          Also report the write & read throughput of\n");
+    HDfprintf(stdout, "                                the HDF5 shuffle, deflate, lz4 &\n");
+    HDfprintf(stdout, "                                fletcher32 filters, using an in-memory\n");
+    HDfprintf(stdout, "                                file and chunks of the maximum buffer\n");
+    HDfprintf(stdout, "                                size\n");
     HDfprintf(stdout, "\n");
     HDfprintf(stdout, "  D  - a directory which exists\n");
     HDfprintf(stdout, "  P  - a number between 0 and 100\n");
@@ -553,6 +563,143 @@ do_write_test(unsigned long file_size, unsigned long min_buf_size,
     }
 }
 
+/*
+ * Function:    do_filter_test
+ * Purpose:     Time writing & reading a chunked dataset in an in-memory
+ *              file through each of several filter pipelines, to measure
+ *              the throughput of the filters themselves.
+ * Return:      Nothing
+ * Modifications:
+ */
+static void
+do_filter_test(unsigned long file_size, unsigned long chunk_size)
+{
+    static const struct {
+        const char *name;       /* Name of the pipeline */
+        int shuffle;            /* Whether to shuffle */
+        int deflate;            /* Whether to deflate */
+        int fletcher32;         /* Whether to checksum */
+        int lz4;                /* Whether to compress with LZ4 */
+    } pipelines[] = {
+        { "No filters", FALSE, FALSE, FALSE, FALSE },
+        { "Shuffle", TRUE, FALSE, FALSE, FALSE },
+        { "Deflate", FALSE, TRUE, FALSE, FALSE },
+        { "Shuffle+Deflate", TRUE, TRUE, FALSE, FALSE },
+        { "LZ4", FALSE, FALSE, FALSE, TRUE },
+        { "Shuffle+LZ4", TRUE, FALSE, FALSE, TRUE },
+        { "Fletcher32", FALSE, FALSE, TRUE, FALSE }
+    };
+    struct timeval timer_start, timer_stop;
+    double total_time;
+    hsize_t dims[1], chunk_dims[1];
+    hid_t fapl, file, space, dcpl, dset;
+    unsigned long nelmts, u;
+    unsigned *buf;
+    size_t n;
+
+    nelmts = file_size / sizeof(unsigned);
+    dims[0] = nelmts;
+    chunk_dims[0] = MAX(chunk_size / sizeof(unsigned), 1);
+    if (chunk_dims[0] > dims[0])
+        chunk_dims[0] = dims[0];
+
+    if (nelmts == 0)
+        error("file size too small for filter test");
+
+    buf = (unsigned *)HDmalloc(nelmts * sizeof(unsigned));
+
+    if (!buf) {
+        cleanup();
+        error("out of memory");
+    }
+
+    /* Use random data, or slowly changing values which shuffle & deflate well */
+    if (random_test)
+        fill_with_random_data((Bytef *)buf, (uLongf)(nelmts * sizeof(unsigned)));
+    else
+        for (u = 0; u < nelmts; ++u)
+            buf[u] = (unsigned)(u / 8);
+
+    HDfprintf(stdout, "Filter Test: Chunk size == %lu bytes\n",
+              (unsigned long)(chunk_dims[0] * sizeof(unsigned)));
+
+    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0 ||
+            H5Pset_fapl_core(fapl, (size_t)ONE_MB, FALSE) < 0 ||
+            (space = H5Screate_simple(1, dims, NULL)) < 0)
+        error("unable to set up filter test");
+
+    for (n = 0; n < NELMTS(pipelines); ++n) {
+        /* The LZ4 filter may have been configured out of the library */
+        if (pipelines[n].lz4 && H5Zfilter_avail(H5Z_FILTER_LZ4) <= 0)
+            continue;
+
+        if ((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0 ||
+                (dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0 ||
+                H5Pset_chunk(dcpl, 1, chunk_dims) < 0)
+            error("unable to set up filter test");
+
+        if (pipelines[n].shuffle && H5Pset_shuffle(dcpl) < 0)
+            error("unable to set shuffle filter");
+        if (pipelines[n].deflate && H5Pset_deflate(dcpl,
+                (unsigned)(compress_level == Z_DEFAULT_COMPRESSION ? 6 : compress_level)) < 0)
+            error("unable to set deflate filter");
+        if (pipelines[n].lz4 && H5Pset_lz4(dcpl) < 0)
+            error("unable to set lz4 filter");
+        if (pipelines[n].fletcher32 && H5Pset_fletcher32(dcpl) < 0)
+            error("unable to set fletcher32 filter");
+
+        if ((dset = H5Dcreate2(file, "filter_test", H5T_NATIVE_UINT, space,
+                H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            error("unable to create dataset");
+
+        HDgettimeofday(&timer_start, NULL);
+
+        if (H5Dwrite(dset, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0 ||
+                H5Fflush(file, H5F_SCOPE_LOCAL) < 0)
+            error("unable to write dataset");
+
+        HDgettimeofday(&timer_stop, NULL);
+
+        total_time = ((double)timer_stop.tv_sec +
+                            ((double)timer_stop.tv_usec) / MICROSECOND) -
+                     ((double)timer_start.tv_sec +
+                            ((double)timer_start.tv_usec) / MICROSECOND);
+
+        HDfprintf(stdout, "\t%s Write Throughput: %.2fMB/s\n",
+                  pipelines[n].name, MB_PER_SEC(file_size, total_time));
+        HDfprintf(stdout, "\t%s Compression Ratio: %.2f\n", pipelines[n].name,
+                  (double)(nelmts * sizeof(unsigned)) /
+                        (double)MAX(H5Dget_storage_size(dset), 1));
+
+        /* Close & reopen the dataset, so the chunks aren't cached */
+        if (H5Dclose(dset) < 0 ||
+                (dset = H5Dopen2(file, "filter_test", H5P_DEFAULT)) < 0)
+            error("unable to reopen dataset");
+
+        HDgettimeofday(&timer_start, NULL);
+
+        if (H5Dread(dset, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0)
+            error("unable to read dataset");
+
+        HDgettimeofday(&timer_stop, NULL);
+
+        total_time = ((double)timer_stop.tv_sec +
+                            ((double)timer_stop.tv_usec) / MICROSECOND) -
+                     ((double)timer_start.tv_sec +
+                            ((double)timer_start.tv_usec) / MICROSECOND);
+
+        HDfprintf(stdout, "\t%s Read Throughput: %.2fMB/s\n",
+                  pipelines[n].name, MB_PER_SEC(file_size, total_time));
+
+        if (H5Dclose(dset) < 0 || H5Pclose(dcpl) < 0 || H5Fclose(file) < 0)
+            error("unable to close filter test objects");
+    }
+
+    H5Sclose(space);
+    H5Pclose(fapl);
+    HDfree(buf);
+}
+
 /*
  * Function:    main
  * Purpose:     Run the program
@@ -594,6 +741,9 @@ main(int argc, char **argv)
             else if (compress_percent > 100)
                 compress_percent = 100;
 
+            break;
+        case 'F':
+            filter_test = TRUE;
             break;
         case 'p':
             option_prefix = opt_arg;
@@ -629,6 +779,8 @@ main(int argc, char **argv)
 
     get_unique_name();
     do_write_test(file_size, min_buf_size, max_buf_size);
+    if (filter_test)
+        do_filter_test(file_size, max_buf_size);
     cleanup();
     return EXIT_SUCCESS;
 }